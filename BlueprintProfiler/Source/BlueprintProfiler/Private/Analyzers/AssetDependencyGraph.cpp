@@ -0,0 +1,223 @@
+// Copyright xnbmy 2026. All Rights Reserved.
+
+#include "Analyzers/AssetDependencyGraph.h"
+#include "Analyzers/BlueprintProfilerStats.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Async/ParallelFor.h"
+
+DECLARE_CYCLE_STAT(TEXT("Build Dependency Graph"), STAT_BuildDependencyGraph, STATGROUP_BlueprintProfiler);
+
+namespace
+{
+	void AddUniqueEdge(TArray<int32>& Row, int32 PackageIndex, int32 SelfIndex)
+	{
+		if (PackageIndex != INDEX_NONE && PackageIndex != SelfIndex)
+		{
+			Row.AddUnique(PackageIndex);
+		}
+	}
+}
+
+bool FAssetDependencyGraph::Build(const IAssetRegistry& AssetRegistry, const std::atomic<bool>* bCancelRequested)
+{
+	BLUEPRINTPROFILER_SCOPE_CYCLE_COUNTER(STAT_BuildDependencyGraph);
+
+	auto IsCancelled = [bCancelRequested]()
+	{
+		return bCancelRequested && bCancelRequested->load(std::memory_order_relaxed);
+	};
+
+	// 只读磁盘上的资产数据，不加载也不枚举内存对象，因此可以在任意线程调用
+	TArray<FAssetData> AllAssets;
+	AssetRegistry.GetAllAssets(AllAssets, true);
+
+	TArray<FName> Names;
+	TArray<FAssetData> Primaries;
+	TMap<FName, int32> Indices;
+	Indices.Reserve(AllAssets.Num());
+	for (FAssetData& AssetData : AllAssets)
+	{
+		if (const int32* ExistingIndex = Indices.Find(AssetData.PackageName))
+		{
+			// 一个包有多个资产时以主资产为准
+			if (AssetData.IsUAsset() && !Primaries[*ExistingIndex].IsUAsset())
+			{
+				Primaries[*ExistingIndex] = MoveTemp(AssetData);
+			}
+			continue;
+		}
+
+		Indices.Add(AssetData.PackageName, Names.Num());
+		Names.Add(AssetData.PackageName);
+		Primaries.Add(MoveTemp(AssetData));
+	}
+	AllAssets.Empty();
+
+	const int32 NumPackages = Names.Num();
+	TArray<TArray<int32>> HardRows;
+	TArray<TArray<int32>> SoftRows;
+	TArray<int64> Sizes;
+	HardRows.SetNum(NumPackages);
+	SoftRows.SetNum(NumPackages);
+	Sizes.SetNumZeroed(NumPackages);
+
+	// 注册表查询是线程安全的，按包并行读取依赖
+	ParallelFor(TEXT("BuildDependencyGraph"), NumPackages, 256, [&](int32 PackageIndex)
+	{
+		if (IsCancelled())
+		{
+			return;
+		}
+
+		const FName PackageName = Names[PackageIndex];
+		TArray<FName> PackageDependencies;
+
+		AssetRegistry.GetDependencies(PackageName, PackageDependencies, UE::AssetRegistry::EDependencyCategory::Package, UE::AssetRegistry::EDependencyQuery::Hard);
+		for (const FName& Dependency : PackageDependencies)
+		{
+			const int32* DependencyIndex = Indices.Find(Dependency);
+			AddUniqueEdge(HardRows[PackageIndex], DependencyIndex ? *DependencyIndex : INDEX_NONE, PackageIndex);
+		}
+
+		PackageDependencies.Reset();
+		AssetRegistry.GetDependencies(PackageName, PackageDependencies, UE::AssetRegistry::EDependencyCategory::Package, UE::AssetRegistry::EDependencyQuery::Soft);
+		for (const FName& Dependency : PackageDependencies)
+		{
+			const int32* DependencyIndex = Indices.Find(Dependency);
+			AddUniqueEdge(SoftRows[PackageIndex], DependencyIndex ? *DependencyIndex : INDEX_NONE, PackageIndex);
+		}
+
+		const TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(PackageName);
+		Sizes[PackageIndex] = PackageData.IsSet() ? FMath::Max<int64>(PackageData->DiskSize, 0) : 0;
+	}, EParallelForFlags::BackgroundPriority);
+
+	if (IsCancelled())
+	{
+		*this = FAssetDependencyGraph();
+		return false;
+	}
+
+	BuildFromAdjacency(MoveTemp(Names), HardRows, SoftRows);
+	PrimaryAssets = MoveTemp(Primaries);
+	DiskSizes = MoveTemp(Sizes);
+
+	UE_LOG(LogTemp, Log, TEXT("Dependency graph snapshot: %d packages, %d edges"), Num(), NumEdges());
+	return true;
+}
+
+void FAssetDependencyGraph::BuildFromAdjacency(TArray<FName>&& InPackageNames, TConstArrayView<TArray<int32>> HardDependencies, TConstArrayView<TArray<int32>> SoftDependencies)
+{
+	PackageNames = MoveTemp(InPackageNames);
+	const int32 NumPackages = PackageNames.Num();
+
+	PackageIndices.Empty(NumPackages);
+	for (int32 PackageIndex = 0; PackageIndex < NumPackages; ++PackageIndex)
+	{
+		PackageIndices.Add(PackageNames[PackageIndex], PackageIndex);
+	}
+
+	PrimaryAssets.Empty();
+	PrimaryAssets.SetNum(NumPackages);
+	DiskSizes.Empty();
+
+	// 正向 CSR；LastSeen 用于行内去重，软引用中已是硬引用的边被丢弃
+	DependencyOffsets.SetNumUninitialized(NumPackages + 1);
+	DependencyHardEnds.SetNumUninitialized(NumPackages);
+	Dependencies.Reset();
+
+	TArray<int32> HardReferencerCounts;
+	TArray<int32> SoftReferencerCounts;
+	HardReferencerCounts.SetNumZeroed(NumPackages);
+	SoftReferencerCounts.SetNumZeroed(NumPackages);
+
+	TArray<int32> LastSeen;
+	LastSeen.Init(INDEX_NONE, NumPackages);
+
+	auto AppendRow = [&](int32 PackageIndex, TConstArrayView<TArray<int32>> Rows, TArray<int32>& ReferencerCounts)
+	{
+		if (!Rows.IsValidIndex(PackageIndex))
+		{
+			return;
+		}
+
+		for (int32 DependencyIndex : Rows[PackageIndex])
+		{
+			if (DependencyIndex >= 0 && DependencyIndex < NumPackages && DependencyIndex != PackageIndex && LastSeen[DependencyIndex] != PackageIndex)
+			{
+				LastSeen[DependencyIndex] = PackageIndex;
+				Dependencies.Add(DependencyIndex);
+				++ReferencerCounts[DependencyIndex];
+			}
+		}
+	};
+
+	for (int32 PackageIndex = 0; PackageIndex < NumPackages; ++PackageIndex)
+	{
+		DependencyOffsets[PackageIndex] = Dependencies.Num();
+		AppendRow(PackageIndex, HardDependencies, HardReferencerCounts);
+		DependencyHardEnds[PackageIndex] = Dependencies.Num();
+		AppendRow(PackageIndex, SoftDependencies, SoftReferencerCounts);
+	}
+	DependencyOffsets[NumPackages] = Dependencies.Num();
+
+	// 反向 CSR：先按入度求前缀和，再按源顺序填充，结果与构建顺序无关
+	ReferencerOffsets.SetNumUninitialized(NumPackages + 1);
+	ReferencerHardEnds.SetNumUninitialized(NumPackages);
+	Referencers.SetNumUninitialized(Dependencies.Num());
+
+	TArray<int32> HardCursors;
+	TArray<int32> SoftCursors;
+	HardCursors.SetNumUninitialized(NumPackages);
+	SoftCursors.SetNumUninitialized(NumPackages);
+
+	int32 Offset = 0;
+	for (int32 PackageIndex = 0; PackageIndex < NumPackages; ++PackageIndex)
+	{
+		ReferencerOffsets[PackageIndex] = Offset;
+		HardCursors[PackageIndex] = Offset;
+		Offset += HardReferencerCounts[PackageIndex];
+		ReferencerHardEnds[PackageIndex] = Offset;
+		SoftCursors[PackageIndex] = Offset;
+		Offset += SoftReferencerCounts[PackageIndex];
+	}
+	ReferencerOffsets[NumPackages] = Offset;
+
+	for (int32 PackageIndex = 0; PackageIndex < NumPackages; ++PackageIndex)
+	{
+		for (int32 EdgeIndex = DependencyOffsets[PackageIndex]; EdgeIndex < DependencyOffsets[PackageIndex + 1]; ++EdgeIndex)
+		{
+			TArray<int32>& Cursors = EdgeIndex < DependencyHardEnds[PackageIndex] ? HardCursors : SoftCursors;
+			Referencers[Cursors[Dependencies[EdgeIndex]]++] = PackageIndex;
+		}
+	}
+}
+
+int32 FAssetDependencyGraph::FindPackage(FName PackageName) const
+{
+	const int32* PackageIndex = PackageIndices.Find(PackageName);
+	return PackageIndex ? *PackageIndex : INDEX_NONE;
+}
+
+TConstArrayView<int32> FAssetDependencyGraph::GetDependencies(int32 PackageIndex) const
+{
+	const int32 Begin = DependencyOffsets[PackageIndex];
+	return TConstArrayView<int32>(Dependencies.GetData() + Begin, DependencyOffsets[PackageIndex + 1] - Begin);
+}
+
+TConstArrayView<int32> FAssetDependencyGraph::GetHardDependencies(int32 PackageIndex) const
+{
+	const int32 Begin = DependencyOffsets[PackageIndex];
+	return TConstArrayView<int32>(Dependencies.GetData() + Begin, DependencyHardEnds[PackageIndex] - Begin);
+}
+
+TConstArrayView<int32> FAssetDependencyGraph::GetReferencers(int32 PackageIndex) const
+{
+	const int32 Begin = ReferencerOffsets[PackageIndex];
+	return TConstArrayView<int32>(Referencers.GetData() + Begin, ReferencerOffsets[PackageIndex + 1] - Begin);
+}
+
+TConstArrayView<int32> FAssetDependencyGraph::GetHardReferencers(int32 PackageIndex) const
+{
+	const int32 Begin = ReferencerOffsets[PackageIndex];
+	return TConstArrayView<int32>(Referencers.GetData() + Begin, ReferencerHardEnds[PackageIndex] - Begin);
+}
@@ -0,0 +1,199 @@
+// Copyright xnbmy 2026. All Rights Reserved.
+
+#include "Analyzers/AssetDominatorTree.h"
+#include "Analyzers/AssetDependencyGraph.h"
+#include "Analyzers/BlueprintProfilerStats.h"
+#include "Algo/Count.h"
+
+DECLARE_CYCLE_STAT(TEXT("Build Dominator Tree"), STAT_BuildDominatorTree, STATGROUP_BlueprintProfiler);
+
+void FAssetDominatorTree::Build(TSharedRef<const FAssetDependencyGraph> InGraph, TArray<int64>&& InPackageSizes)
+{
+	BLUEPRINTPROFILER_SCOPE_CYCLE_COUNTER(STAT_BuildDominatorTree);
+
+	Graph = InGraph;
+	PackageSizes = MoveTemp(InPackageSizes);
+
+	const int32 NumPackages = Graph->Num();
+	const int32 RootIndex = NumPackages;
+	PackageSizes.SetNumZeroed(NumPackages);
+
+	// 1. 从虚拟根做迭代 DFS 得到后序；根的子节点为没有硬引用者的包，成环且不可达的包随后补为根的子节点
+	TArray<bool> RootChildren;
+	RootChildren.SetNumZeroed(NumPackages);
+	PostOrderNumbers.Init(INDEX_NONE, NumPackages + 1);
+
+	TArray<int32> PostOrder;
+	PostOrder.Reserve(NumPackages + 1);
+
+	TArray<bool> Visited;
+	Visited.SetNumZeroed(NumPackages);
+
+	struct FDfsFrame
+	{
+		int32 PackageIndex;
+		int32 NextEdge;
+	};
+	TArray<FDfsFrame> Stack;
+
+	auto VisitFrom = [&](int32 StartIndex)
+	{
+		Visited[StartIndex] = true;
+		Stack.Add({ StartIndex, 0 });
+		while (Stack.Num() > 0)
+		{
+			FDfsFrame& Frame = Stack.Last();
+			const TConstArrayView<int32> Dependencies = Graph->GetHardDependencies(Frame.PackageIndex);
+			if (Frame.NextEdge < Dependencies.Num())
+			{
+				const int32 DependencyIndex = Dependencies[Frame.NextEdge++];
+				if (!Visited[DependencyIndex])
+				{
+					Visited[DependencyIndex] = true;
+					Stack.Add({ DependencyIndex, 0 });
+				}
+				continue;
+			}
+
+			PostOrderNumbers[Frame.PackageIndex] = PostOrder.Num();
+			PostOrder.Add(Frame.PackageIndex);
+			Stack.Pop(EAllowShrinking::No);
+		}
+	};
+
+	for (int32 PackageIndex = 0; PackageIndex < NumPackages; ++PackageIndex)
+	{
+		if (Graph->GetHardReferencers(PackageIndex).Num() == 0)
+		{
+			RootChildren[PackageIndex] = true;
+			VisitFrom(PackageIndex);
+		}
+	}
+	for (int32 PackageIndex = 0; PackageIndex < NumPackages; ++PackageIndex)
+	{
+		if (!Visited[PackageIndex])
+		{
+			RootChildren[PackageIndex] = true;
+			VisitFrom(PackageIndex);
+		}
+	}
+	PostOrderNumbers[RootIndex] = PostOrder.Num();
+	PostOrder.Add(RootIndex);
+
+	// 2. Cooper-Harvey-Kennedy：按逆后序迭代到不动点
+	ImmediateDominators.Init(INDEX_NONE, NumPackages + 1);
+	ImmediateDominators[RootIndex] = RootIndex;
+
+	auto Intersect = [this](int32 A, int32 B)
+	{
+		while (A != B)
+		{
+			while (PostOrderNumbers[A] < PostOrderNumbers[B])
+			{
+				A = ImmediateDominators[A];
+			}
+			while (PostOrderNumbers[B] < PostOrderNumbers[A])
+			{
+				B = ImmediateDominators[B];
+			}
+		}
+		return A;
+	};
+
+	bool bChanged = true;
+	while (bChanged)
+	{
+		bChanged = false;
+		for (int32 OrderIndex = PostOrder.Num() - 2; OrderIndex >= 0; --OrderIndex)
+		{
+			const int32 PackageIndex = PostOrder[OrderIndex];
+
+			int32 NewDominator = RootChildren[PackageIndex] ? RootIndex : INDEX_NONE;
+			for (int32 ReferencerIndex : Graph->GetHardReferencers(PackageIndex))
+			{
+				if (ImmediateDominators[ReferencerIndex] != INDEX_NONE)
+				{
+					NewDominator = NewDominator == INDEX_NONE ? ReferencerIndex : Intersect(ReferencerIndex, NewDominator);
+				}
+			}
+
+			if (NewDominator != ImmediateDominators[PackageIndex])
+			{
+				ImmediateDominators[PackageIndex] = NewDominator;
+				bChanged = true;
+			}
+		}
+	}
+
+	// 3. 支配者的后序号总是更大，按后序累加即可得到子树大小
+	RetainedSizes.SetNumZeroed(NumPackages + 1);
+	for (int32 PackageIndex : PostOrder)
+	{
+		if (PackageIndex == RootIndex)
+		{
+			continue;
+		}
+
+		RetainedSizes[PackageIndex] += PackageSizes[PackageIndex];
+		RetainedSizes[ImmediateDominators[PackageIndex]] += RetainedSizes[PackageIndex];
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("Dominator tree built for %d packages (%d root packages)"), NumPackages,
+		Algo::CountIf(RootChildren, [](bool bRootChild) { return bRootChild; }));
+}
+
+int32 FAssetDominatorTree::GetImmediateDominator(int32 PackageIndex) const
+{
+	const int32 Dominator = ImmediateDominators[PackageIndex];
+	return Dominator == Num() ? INDEX_NONE : Dominator;
+}
+
+bool FAssetDominatorTree::Dominates(int32 DominatorIndex, int32 PackageIndex) const
+{
+	const int32 RootIndex = Num();
+	for (int32 Current = PackageIndex; Current != RootIndex && Current != INDEX_NONE; Current = ImmediateDominators[Current])
+	{
+		if (Current == DominatorIndex)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+FAssetRetainedSize FAssetDominatorTree::GetSizes(int32 PackageIndex) const
+{
+	FAssetRetainedSize Sizes;
+	if (!Graph.IsValid() || PackageIndex < 0 || PackageIndex >= Graph->Num())
+	{
+		return Sizes;
+	}
+
+	// 硬引用闭包的总大小减去保留大小即为与其他包共享的部分
+	TBitArray<> Visited(false, Graph->Num());
+	TArray<int32> Queue;
+	Queue.Add(PackageIndex);
+	Visited[PackageIndex] = true;
+
+	int64 ReachableBytes = 0;
+	for (int32 QueueIndex = 0; QueueIndex < Queue.Num(); ++QueueIndex)
+	{
+		const int32 Current = Queue[QueueIndex];
+		ReachableBytes += PackageSizes[Current];
+
+		for (int32 DependencyIndex : Graph->GetHardDependencies(Current))
+		{
+			if (!Visited[DependencyIndex])
+			{
+				Visited[DependencyIndex] = true;
+				Queue.Add(DependencyIndex);
+			}
+		}
+	}
+
+	Sizes.ExclusiveBytes = PackageSizes[PackageIndex];
+	Sizes.RetainedBytes = RetainedSizes[PackageIndex];
+	Sizes.SharedBytes = FMath::Max<int64>(ReachableBytes - Sizes.RetainedBytes, 0);
+	Sizes.NumHardDependencies = Queue.Num() - 1;
+	return Sizes;
+}
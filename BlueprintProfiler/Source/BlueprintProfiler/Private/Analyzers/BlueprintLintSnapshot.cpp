@@ -0,0 +1,523 @@
+// Copyright xnbmy 2026. All Rights Reserved.
+
+#include "Analyzers/BlueprintLintSnapshot.h"
+#include "Engine/Blueprint.h"
+#include "Engine/GameInstance.h"
+#include "K2Node.h"
+#include "K2Node_Event.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_DynamicCast.h"
+#include "K2Node_VariableGet.h"
+#include "K2Node_VariableSet.h"
+#include "K2Node_CustomEvent.h"
+#include "K2Node_FunctionEntry.h"
+#include "K2Node_ComponentBoundEvent.h"
+#include "K2Node_MacroInstance.h"
+#include "K2Node_BaseMCDelegate.h"
+#include "K2Node_AddDelegate.h"
+#include "K2Node_AssignDelegate.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "EdGraph/EdGraphPin.h"
+#include "EdGraphSchema_K2.h"
+#include "GameFramework/Actor.h"
+#include "Components/ActorComponent.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Serialization/Archive.h"
+
+namespace
+{
+	// Smallest serialized size of one element; counts are checked against the bytes left before anything is allocated
+	constexpr int64 MinSerializedNameSize = sizeof(int32);
+	constexpr int64 MinSerializedPinSize = MinSerializedNameSize + 2 * sizeof(uint32) + sizeof(int32);
+	constexpr int64 MinSerializedNodeSize = sizeof(ELintNodeKind) + sizeof(FGuid);
+	constexpr int64 MinSerializedGraphSize = sizeof(ELintGraphKind) + MinSerializedNameSize + 2 * sizeof(int32);
+	constexpr int64 MinSerializedVariableSize = MinSerializedNameSize + sizeof(uint32);
+
+	/** Same layout as TArray serialization, but a count the rest of a damaged archive cannot hold fails the archive */
+	template <typename ElementType, typename AllocatorType>
+	void SerializeBoundedArray(FArchive& Ar, TArray<ElementType, AllocatorType>& Array, int64 MinElementSize)
+	{
+		int32 Num = Array.Num();
+		Ar << Num;
+		if (Ar.IsLoading())
+		{
+			if (Ar.IsError() || Num < 0 || Num > (Ar.TotalSize() - Ar.Tell()) / MinElementSize)
+			{
+				Ar.SetError();
+				Array.Empty();
+				return;
+			}
+			Array.SetNum(Num);
+		}
+
+		for (ElementType& Element : Array)
+		{
+			Ar << Element;
+			if (Ar.IsError())
+			{
+				return;
+			}
+		}
+	}
+
+	bool IsHardReferenceCast(const UK2Node_DynamicCast* CastNode)
+	{
+		// Interface casts are cheap; actor and component casts pull in the whole class
+		const UClass* TargetClass = CastNode->TargetType;
+		if (TargetClass && !TargetClass->HasAnyClassFlags(CLASS_Interface))
+		{
+			return TargetClass->IsChildOf(AActor::StaticClass()) || TargetClass->IsChildOf(UActorComponent::StaticClass());
+		}
+		return false;
+	}
+
+	bool IsTimerFunction(const FString& FunctionName)
+	{
+		// 设置、清除、暂停、查询等所有按函数名字符串引用函数的定时器操作
+		return FunctionName.StartsWith(TEXT("K2_SetTimer")) ||
+			FunctionName.StartsWith(TEXT("K2_ClearTimer")) ||
+			FunctionName.StartsWith(TEXT("K2_PauseTimer")) ||
+			FunctionName.StartsWith(TEXT("K2_UnPauseTimer")) ||
+			FunctionName.StartsWith(TEXT("K2_IsTimer")) ||
+			FunctionName.StartsWith(TEXT("K2_GetTimer")) ||
+			FunctionName.StartsWith(TEXT("K2_DoesTimer"));
+	}
+
+	bool IsInterfaceFunction(const UBlueprint* Blueprint, FName FunctionName)
+	{
+		// 沿继承链检查所有实现的接口
+		const UClass* CurrentClass = Blueprint->GeneratedClass ? Blueprint->GeneratedClass.Get() : Blueprint->ParentClass.Get();
+		while (CurrentClass)
+		{
+			for (const FImplementedInterface& Interface : CurrentClass->Interfaces)
+			{
+				if (Interface.Class && Interface.Class->FindFunctionByName(FunctionName))
+				{
+					return true;
+				}
+			}
+			CurrentClass = CurrentClass->GetSuperClass();
+		}
+		return false;
+	}
+
+	void SnapshotNode(const UEdGraphNode* Node, const TMap<const UEdGraphNode*, int32>& NodeIndices, bool bReferencesOnly, FLintNodeSnapshot& Out)
+	{
+		Out.NodeGuid = Node->NodeGuid;
+		Out.ClassName = Node->GetClass()->GetName();
+
+		if (const UK2Node_VariableGet* VarGetNode = Cast<UK2Node_VariableGet>(Node))
+		{
+			Out.Kind = ELintNodeKind::VariableGet;
+			Out.MemberName = VarGetNode->VariableReference.GetMemberName();
+		}
+		else if (const UK2Node_VariableSet* VarSetNode = Cast<UK2Node_VariableSet>(Node))
+		{
+			Out.Kind = ELintNodeKind::VariableSet;
+			Out.MemberName = VarSetNode->VariableReference.GetMemberName();
+		}
+		else if (const UK2Node_CallFunction* CallFuncNode = Cast<UK2Node_CallFunction>(Node))
+		{
+			Out.Kind = ELintNodeKind::CallFunction;
+			Out.MemberName = CallFuncNode->FunctionReference.GetMemberName();
+
+			// 记录包含类名的完整路径，用于跨蓝图引用检测
+			const UClass* ParentClass = CallFuncNode->FunctionReference.GetMemberParentClass();
+			Out.QualifiedFunctionName = ParentClass
+				? FName(*(ParentClass->GetName() + TEXT(".") + Out.MemberName.ToString()))
+				: Out.MemberName;
+
+			if (IsTimerFunction(Out.MemberName.ToString()))
+			{
+				for (const UEdGraphPin* Pin : Node->Pins)
+				{
+					if (Pin && Pin->PinName.ToString() == TEXT("FunctionName") && Pin->LinkedTo.Num() == 0 && !Pin->DefaultValue.IsEmpty())
+					{
+						Out.TimerFunctionNames.Add(FName(*Pin->DefaultValue));
+					}
+				}
+			}
+		}
+		else if (Node->IsA<UK2Node_ComponentBoundEvent>())
+		{
+			Out.Kind = ELintNodeKind::ComponentBoundEvent;
+			Out.MemberName = CastChecked<UK2Node_Event>(Node)->GetFunctionName();
+		}
+		else if (const UK2Node_CustomEvent* CustomEventNode = Cast<UK2Node_CustomEvent>(Node))
+		{
+			Out.Kind = ELintNodeKind::CustomEvent;
+			Out.MemberName = CustomEventNode->GetFunctionName();
+		}
+		else if (const UK2Node_Event* EventNode = Cast<UK2Node_Event>(Node))
+		{
+			Out.Kind = ELintNodeKind::Event;
+			Out.MemberName = EventNode->GetFunctionName();
+		}
+		else if (Node->IsA<UK2Node_FunctionEntry>())
+		{
+			Out.Kind = ELintNodeKind::FunctionEntry;
+		}
+		else if (const UK2Node_MacroInstance* MacroInstance = Cast<UK2Node_MacroInstance>(Node))
+		{
+			Out.Kind = ELintNodeKind::MacroInstance;
+			if (const UEdGraph* MacroGraph = MacroInstance->GetMacroGraph())
+			{
+				Out.MacroGraphName = MacroGraph->GetFName();
+				Out.MacroGraphPath = MacroGraph->GetPathName();
+			}
+		}
+		else if (const UK2Node_BaseMCDelegate* DelegateNode = Cast<UK2Node_BaseMCDelegate>(Node))
+		{
+			Out.Kind = ELintNodeKind::Delegate;
+			Out.MemberName = DelegateNode->GetPropertyName();
+
+			// Add/Assign 节点通过委托引脚绑定自定义事件
+			if (Node->IsA<UK2Node_AddDelegate>() || Node->IsA<UK2Node_AssignDelegate>())
+			{
+				if (const UEdGraphPin* DelegatePin = DelegateNode->GetDelegatePin())
+				{
+					for (const UEdGraphPin* LinkedPin : DelegatePin->LinkedTo)
+					{
+						const UEdGraphNode* ConnectedNode = LinkedPin ? LinkedPin->GetOwningNode() : nullptr;
+						if (ConnectedNode && ConnectedNode->IsA<UK2Node_CustomEvent>())
+						{
+							if (const int32* ConnectedIndex = NodeIndices.Find(ConnectedNode))
+							{
+								Out.BoundEvents.Add(*ConnectedIndex);
+							}
+						}
+					}
+				}
+			}
+		}
+		else if (const UK2Node_DynamicCast* CastNode = Cast<UK2Node_DynamicCast>(Node))
+		{
+			Out.Kind = ELintNodeKind::DynamicCast;
+			Out.bHardReferenceCast = IsHardReferenceCast(CastNode);
+		}
+
+		if (const UK2Node_Event* AnyEventNode = Cast<UK2Node_Event>(Node))
+		{
+			Out.bInterfaceEvent = AnyEventNode->IsInterfaceEventNode();
+		}
+
+		if (bReferencesOnly)
+		{
+			return;
+		}
+
+		if (const UK2Node* K2Node = Cast<UK2Node>(Node))
+		{
+			Out.bIsK2Node = true;
+			Out.bPure = K2Node->IsNodePure();
+			Out.Title = K2Node->GetNodeTitle(ENodeTitleType::ListView).ToString();
+		}
+
+		Out.Pins.Reserve(Node->Pins.Num());
+		for (const UEdGraphPin* Pin : Node->Pins)
+		{
+			if (!Pin)
+			{
+				continue;
+			}
+
+			FLintPinSnapshot& PinSnapshot = Out.Pins.AddDefaulted_GetRef();
+			PinSnapshot.Name = Pin->PinName;
+			PinSnapshot.bExec = Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec;
+			PinSnapshot.bOutput = Pin->Direction == EGPD_Output;
+			for (const UEdGraphPin* LinkedPin : Pin->LinkedTo)
+			{
+				const int32* LinkedIndex = LinkedPin ? NodeIndices.Find(LinkedPin->GetOwningNode()) : nullptr;
+				PinSnapshot.LinkedNodes.Add(LinkedIndex ? *LinkedIndex : INDEX_NONE);
+			}
+		}
+	}
+
+	void SnapshotGraph(const UEdGraph* Graph, ELintGraphKind Kind, bool bReferencesOnly, FLintGraphSnapshot& Out)
+	{
+		Out.Kind = Kind;
+		Out.Name = Graph->GetFName();
+		Out.PathName = Graph->GetPathName();
+
+		TMap<const UEdGraphNode*, int32> NodeIndices;
+		NodeIndices.Reserve(Graph->Nodes.Num());
+		for (const UEdGraphNode* Node : Graph->Nodes)
+		{
+			if (Node)
+			{
+				NodeIndices.Add(Node, NodeIndices.Num());
+			}
+		}
+
+		// 先为所有节点分配索引，连接才能解析到同图中后出现的节点
+		Out.Nodes.SetNum(NodeIndices.Num());
+		int32 NodeIndex = 0;
+		for (const UEdGraphNode* Node : Graph->Nodes)
+		{
+			if (Node)
+			{
+				SnapshotNode(Node, NodeIndices, bReferencesOnly, Out.Nodes[NodeIndex++]);
+			}
+		}
+	}
+}
+
+FBlueprintLintSnapshot FBlueprintLintSnapshot::Build(UBlueprint* Blueprint, bool bReferencesOnly, bool bResolveFunctionUsage)
+{
+	check(IsInGameThread());
+
+	FBlueprintLintSnapshot Snapshot;
+	if (!Blueprint)
+	{
+		return Snapshot;
+	}
+
+	Snapshot.BlueprintPath = Blueprint->GetPathName();
+	Snapshot.BlueprintName = Blueprint->GetName();
+	Snapshot.bInterface = Blueprint->BlueprintType == BPTYPE_Interface;
+	if (Blueprint->GeneratedClass)
+	{
+		Snapshot.bGameInstance = Blueprint->GeneratedClass->IsChildOf(UGameInstance::StaticClass());
+	}
+	else if (Blueprint->ParentClass)
+	{
+		Snapshot.bGameInstance = Blueprint->ParentClass->IsChildOf(UGameInstance::StaticClass());
+	}
+
+	Snapshot.Graphs.Reserve(Blueprint->UbergraphPages.Num() + Blueprint->FunctionGraphs.Num() + Blueprint->MacroGraphs.Num());
+
+	for (const UEdGraph* Graph : Blueprint->UbergraphPages)
+	{
+		if (Graph)
+		{
+			SnapshotGraph(Graph, ELintGraphKind::Ubergraph, bReferencesOnly, Snapshot.Graphs.AddDefaulted_GetRef());
+		}
+	}
+
+	for (const UEdGraph* Graph : Blueprint->FunctionGraphs)
+	{
+		if (!Graph)
+		{
+			continue;
+		}
+
+		FLintGraphSnapshot& GraphSnapshot = Snapshot.Graphs.AddDefaulted_GetRef();
+		SnapshotGraph(Graph, ELintGraphKind::Function, bReferencesOnly, GraphSnapshot);
+
+		if (!bReferencesOnly)
+		{
+			const FName FunctionName = Graph->GetFName();
+			GraphSnapshot.bOverridesParentFunction = Blueprint->ParentClass && Blueprint->ParentClass->FindFunctionByName(FunctionName);
+			GraphSnapshot.bImplementsInterfaceFunction = !GraphSnapshot.bOverridesParentFunction && IsInterfaceFunction(Blueprint, FunctionName);
+
+			// 引擎的引用搜索开销最大，只对前两项都不成立的函数执行
+			if (bResolveFunctionUsage && !GraphSnapshot.bOverridesParentFunction && !GraphSnapshot.bImplementsInterfaceFunction)
+			{
+				GraphSnapshot.bUsedByEditorReferences = FBlueprintEditorUtils::IsFunctionUsed(Blueprint, FunctionName);
+			}
+		}
+	}
+
+	for (const UEdGraph* Graph : Blueprint->MacroGraphs)
+	{
+		if (Graph)
+		{
+			SnapshotGraph(Graph, ELintGraphKind::Macro, bReferencesOnly, Snapshot.Graphs.AddDefaulted_GetRef());
+		}
+	}
+
+	if (!bReferencesOnly)
+	{
+		Snapshot.Variables.Reserve(Blueprint->NewVariables.Num());
+		for (const FBPVariableDescription& Variable : Blueprint->NewVariables)
+		{
+			FLintVariableSnapshot& VariableSnapshot = Snapshot.Variables.AddDefaulted_GetRef();
+			VariableSnapshot.Name = Variable.VarName;
+			VariableSnapshot.bEventDispatcher = Variable.VarType.PinCategory == UEdGraphSchema_K2::PC_MCDelegate;
+		}
+	}
+
+	return Snapshot;
+}
+
+FLintCallSites FLintCallSites::Collect(const FBlueprintLintSnapshot& Snapshot)
+{
+	TSet<FName> Functions;
+	TSet<FName> Macros;
+
+	for (const FLintGraphSnapshot& Graph : Snapshot.Graphs)
+	{
+		for (const FLintNodeSnapshot& Node : Graph.Nodes)
+		{
+			switch (Node.Kind)
+			{
+			case ELintNodeKind::CallFunction:
+				if (Node.MemberName != NAME_None)
+				{
+					Functions.Add(Node.MemberName);
+				}
+				if (Node.QualifiedFunctionName != NAME_None)
+				{
+					Functions.Add(Node.QualifiedFunctionName);
+				}
+				Functions.Append(Node.TimerFunctionNames);
+				break;
+
+			case ELintNodeKind::Delegate:
+				if (Node.MemberName != NAME_None)
+				{
+					Functions.Add(Node.MemberName);
+					for (int32 BoundIndex : Node.BoundEvents)
+					{
+						const FName EventName = Graph.Nodes[BoundIndex].MemberName;
+						if (EventName != NAME_None)
+						{
+							Functions.Add(EventName);
+						}
+					}
+				}
+				break;
+
+			case ELintNodeKind::MacroInstance:
+				if (Node.MacroGraphName != NAME_None)
+				{
+					Macros.Add(Node.MacroGraphName);
+				}
+				break;
+
+			default:
+				break;
+			}
+		}
+	}
+
+	FLintCallSites CallSites;
+	CallSites.Functions = Functions.Array();
+	CallSites.Macros = Macros.Array();
+	return CallSites;
+}
+
+void FLintReferenceIndex::SetCallSites(FName AssetName, FLintCallSites&& CallSites)
+{
+	if (bResolved)
+	{
+		if (const FLintCallSites* Previous = AssetCallSites.Find(AssetName))
+		{
+			UnlinkAsset(AssetName, *Previous);
+		}
+	}
+
+	const FLintCallSites& Stored = AssetCallSites.Add(AssetName, MoveTemp(CallSites));
+	if (bResolved)
+	{
+		LinkAsset(AssetName, Stored);
+	}
+}
+
+void FLintReferenceIndex::RemoveAsset(FName AssetName)
+{
+	FLintCallSites Previous;
+	if (AssetCallSites.RemoveAndCopyValue(AssetName, Previous) && bResolved)
+	{
+		UnlinkAsset(AssetName, Previous);
+	}
+}
+
+void FLintReferenceIndex::Resolve()
+{
+	FunctionCallers.Reset();
+	MacroCallers.Reset();
+	for (const TPair<FName, FLintCallSites>& Pair : AssetCallSites)
+	{
+		LinkAsset(Pair.Key, Pair.Value);
+	}
+	bResolved = true;
+}
+
+TArray<FName> FLintReferenceIndex::GetFunctionCallers(FName FunctionName) const
+{
+	const TSet<FName>* Callers = FunctionCallers.Find(FunctionName);
+	return Callers ? Callers->Array() : TArray<FName>();
+}
+
+void FLintReferenceIndex::LinkAsset(FName AssetName, const FLintCallSites& CallSites)
+{
+	for (const FName Function : CallSites.Functions)
+	{
+		FunctionCallers.FindOrAdd(Function).Add(AssetName);
+	}
+	for (const FName Macro : CallSites.Macros)
+	{
+		MacroCallers.FindOrAdd(Macro).Add(AssetName);
+	}
+}
+
+void FLintReferenceIndex::UnlinkAsset(FName AssetName, const FLintCallSites& CallSites)
+{
+	// 没有调用者的被调用项要整体移除，IsFunctionReferenced 才能返回 false
+	auto Unlink = [AssetName](TMap<FName, TSet<FName>>& Callers, const TArray<FName>& Callees)
+	{
+		for (const FName Callee : Callees)
+		{
+			if (TSet<FName>* CalleeCallers = Callers.Find(Callee))
+			{
+				CalleeCallers->Remove(AssetName);
+				if (CalleeCallers->Num() == 0)
+				{
+					Callers.Remove(Callee);
+				}
+			}
+		}
+	};
+	Unlink(FunctionCallers, CallSites.Functions);
+	Unlink(MacroCallers, CallSites.Macros);
+}
+
+FArchive& operator<<(FArchive& Ar, FLintPinSnapshot& Pin)
+{
+	Ar << Pin.Name << Pin.bExec << Pin.bOutput;
+	SerializeBoundedArray(Ar, Pin.LinkedNodes, sizeof(int32));
+	return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar, FLintNodeSnapshot& Node)
+{
+	Ar << Node.Kind << Node.NodeGuid << Node.MemberName << Node.Title << Node.ClassName;
+	Ar << Node.bIsK2Node << Node.bPure << Node.bInterfaceEvent << Node.bHardReferenceCast;
+	SerializeBoundedArray(Ar, Node.BoundEvents, sizeof(int32));
+	Ar << Node.QualifiedFunctionName;
+	SerializeBoundedArray(Ar, Node.TimerFunctionNames, MinSerializedNameSize);
+	Ar << Node.MacroGraphName << Node.MacroGraphPath;
+	SerializeBoundedArray(Ar, Node.Pins, MinSerializedPinSize);
+	return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar, FLintGraphSnapshot& Graph)
+{
+	Ar << Graph.Kind << Graph.Name << Graph.PathName;
+	SerializeBoundedArray(Ar, Graph.Nodes, MinSerializedNodeSize);
+	Ar << Graph.bOverridesParentFunction << Graph.bImplementsInterfaceFunction << Graph.bUsedByEditorReferences;
+	return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar, FLintVariableSnapshot& Variable)
+{
+	Ar << Variable.Name << Variable.bEventDispatcher;
+	return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar, FBlueprintLintSnapshot& Snapshot)
+{
+	Ar << Snapshot.BlueprintPath << Snapshot.BlueprintName << Snapshot.bInterface << Snapshot.bGameInstance;
+	SerializeBoundedArray(Ar, Snapshot.Graphs, MinSerializedGraphSize);
+	SerializeBoundedArray(Ar, Snapshot.Variables, MinSerializedVariableSize);
+	return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar, FLintCallSites& CallSites)
+{
+	SerializeBoundedArray(Ar, CallSites.Functions, MinSerializedNameSize);
+	SerializeBoundedArray(Ar, CallSites.Macros, MinSerializedNameSize);
+	return Ar;
+}
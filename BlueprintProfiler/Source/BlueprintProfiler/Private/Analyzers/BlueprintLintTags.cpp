@@ -0,0 +1,176 @@
+// Copyright xnbmy 2026. All Rights Reserved.
+
+#include "Analyzers/BlueprintLintTags.h"
+#include "Analyzers/BlueprintLintSnapshot.h"
+#include "Analyzers/LintGraphIndex.h"
+#include "AssetRegistry/AssetData.h"
+#include "Engine/Blueprint.h"
+#include "UObject/AssetRegistryTagsContext.h"
+
+const FName FBlueprintLintTags::Version(TEXT("BPLintTagsVersion"));
+const FName FBlueprintLintTags::NumNodes(TEXT("BPLintNumNodes"));
+const FName FBlueprintLintTags::NumVariables(TEXT("BPLintNumVariables"));
+const FName FBlueprintLintTags::NumFunctionGraphs(TEXT("BPLintNumFunctionGraphs"));
+const FName FBlueprintLintTags::NumCasts(TEXT("BPLintNumCasts"));
+const FName FBlueprintLintTags::NumReferences(TEXT("BPLintNumReferences"));
+const FName FBlueprintLintTags::HasTickEvent(TEXT("BPLintHasTickEvent"));
+
+FDelegateHandle FBlueprintLintTags::TagsHandle;
+
+namespace
+{
+	void AddLintTags(FAssetRegistryTagsContext Context)
+	{
+		// 只在保存时计算：其他调用方（内容浏览器、注册表刷新）很频繁，且不一定在游戏线程
+		const UBlueprint* Blueprint = Cast<UBlueprint>(Context.GetObject());
+		if (!Blueprint || !Context.IsSaving() || !IsInGameThread())
+		{
+			return;
+		}
+
+		// Build 只读取蓝图；编辑器引用搜索不影响任何标签，跳过
+		const FBlueprintLintSnapshot Snapshot = FBlueprintLintSnapshot::Build(const_cast<UBlueprint*>(Blueprint), false, false);
+
+		FAssetDataTagMap Tags;
+		FBlueprintLintTags::GetTags(Snapshot, Tags);
+		for (const TPair<FName, FString>& Tag : Tags)
+		{
+			Context.AddTag(UObject::FAssetRegistryTag(Tag.Key, Tag.Value, UObject::FAssetRegistryTag::TT_Numerical));
+		}
+	}
+
+	int32 GetIntTag(const FAssetData& AssetData, FName Tag)
+	{
+		int32 Value = 0;
+		AssetData.GetTagValue(Tag, Value);
+		return Value;
+	}
+
+	bool HasCurrentLintTags(const FAssetData& AssetData)
+	{
+		int32 TagsVersion = 0;
+		return AssetData.GetTagValue(FBlueprintLintTags::Version, TagsVersion) && TagsVersion == FBlueprintLintTags::TagsVersion;
+	}
+
+	bool IsDataOnlyBlueprint(const FAssetData& AssetData)
+	{
+		// 纯数据蓝图没有变量、函数和非占位节点，任何检查都不会报告问题
+		FString IsDataOnly;
+		return AssetData.GetTagValue(FBlueprintTags::IsDataOnly, IsDataOnly) && IsDataOnly.Equals(TEXT("True"), ESearchCase::IgnoreCase);
+	}
+}
+
+void FBlueprintLintTags::Register()
+{
+	if (!TagsHandle.IsValid())
+	{
+		TagsHandle = UObject::FAssetRegistryTag::OnGetExtraObjectTagsWithContext.AddStatic(&AddLintTags);
+	}
+}
+
+void FBlueprintLintTags::Unregister()
+{
+	if (TagsHandle.IsValid())
+	{
+		UObject::FAssetRegistryTag::OnGetExtraObjectTagsWithContext.Remove(TagsHandle);
+		TagsHandle.Reset();
+	}
+}
+
+void FBlueprintLintTags::GetTags(const FBlueprintLintSnapshot& Snapshot, FAssetDataTagMap& OutTags)
+{
+	int32 NodeCount = 0;
+	int32 FunctionGraphCount = 0;
+	int32 CastCount = 0;
+	bool bHasTickEvent = false;
+
+	for (const FLintGraphSnapshot& Graph : Snapshot.Graphs)
+	{
+		NodeCount += Graph.Nodes.Num();
+		if (Graph.Kind != ELintGraphKind::Ubergraph)
+		{
+			++FunctionGraphCount;
+		}
+
+		for (const FLintNodeSnapshot& Node : Graph.Nodes)
+		{
+			if (Node.Kind == ELintNodeKind::DynamicCast)
+			{
+				++CastCount;
+			}
+			else if (FLintGraphIndex::IsTickEvent(Node))
+			{
+				bHasTickEvent = true;
+			}
+		}
+	}
+
+	OutTags.Add(Version, LexToString(TagsVersion));
+	OutTags.Add(NumNodes, LexToString(NodeCount));
+	OutTags.Add(NumVariables, LexToString(Snapshot.Variables.Num()));
+	OutTags.Add(NumFunctionGraphs, LexToString(FunctionGraphCount));
+	OutTags.Add(NumCasts, LexToString(CastCount));
+	OutTags.Add(NumReferences, LexToString(FLintCallSites::Collect(Snapshot).Num()));
+	OutTags.Add(HasTickEvent, bHasTickEvent ? TEXT("1") : TEXT("0"));
+}
+
+TSet<ELintIssueType> FBlueprintLintTags::GetApplicableChecks(const FAssetData& AssetData, const TSet<ELintIssueType>& EnabledChecks)
+{
+	if (IsDataOnlyBlueprint(AssetData))
+	{
+		return TSet<ELintIssueType>();
+	}
+
+	if (!HasCurrentLintTags(AssetData))
+	{
+		return EnabledChecks;
+	}
+
+	const int32 NodeCount = GetIntTag(AssetData, NumNodes);
+
+	TSet<ELintIssueType> Checks;
+	for (ELintIssueType Check : EnabledChecks)
+	{
+		bool bApplicable = true;
+		switch (Check)
+		{
+		case ELintIssueType::DeadNode:
+			bApplicable = NodeCount > 0 || GetIntTag(AssetData, NumVariables) > 0;
+			break;
+		case ELintIssueType::OrphanNode:
+			bApplicable = NodeCount > 0;
+			break;
+		case ELintIssueType::CastAbuse:
+			bApplicable = GetIntTag(AssetData, NumCasts) > 0;
+			break;
+		case ELintIssueType::TickAbuse:
+			bApplicable = GetIntTag(AssetData, HasTickEvent) != 0;
+			break;
+		case ELintIssueType::UnusedFunction:
+			bApplicable = GetIntTag(AssetData, NumFunctionGraphs) > 0;
+			break;
+		default:
+			break;
+		}
+
+		if (bApplicable)
+		{
+			Checks.Add(Check);
+		}
+	}
+	return Checks;
+}
+
+bool FBlueprintLintTags::MayHaveReferences(const FAssetData& AssetData)
+{
+	if (IsDataOnlyBlueprint(AssetData))
+	{
+		return false;
+	}
+	return !HasCurrentLintTags(AssetData) || GetIntTag(AssetData, NumReferences) > 0;
+}
+
+int32 FBlueprintLintTags::GetNumNodes(const FAssetData& AssetData)
+{
+	return HasCurrentLintTags(AssetData) ? GetIntTag(AssetData, NumNodes) : INDEX_NONE;
+}
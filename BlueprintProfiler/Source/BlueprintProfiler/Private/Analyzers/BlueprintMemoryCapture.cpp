@@ -0,0 +1,309 @@
+// Copyright xnbmy 2026. All Rights Reserved.
+
+#include "Analyzers/BlueprintMemoryCapture.h"
+#include "Analyzers/BlueprintProfilerStats.h"
+#include "Engine/Blueprint.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "HAL/PlatformTime.h"
+#include "UObject/Package.h"
+#include "UObject/ResourceSize.h"
+#include "UObject/UObjectArray.h"
+#include "UObject/UObjectHash.h"
+
+DECLARE_CYCLE_STAT(TEXT("Capture Blueprint Memory"), STAT_CaptureBlueprintMemory, STATGROUP_BlueprintProfiler);
+
+FBlueprintMemoryCapture::~FBlueprintMemoryCapture()
+{
+	Stop();
+}
+
+void FBlueprintMemoryCapture::Start()
+{
+	if (!TickerHandle.IsValid())
+	{
+		TickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateRaw(this, &FBlueprintMemoryCapture::Tick));
+	}
+}
+
+void FBlueprintMemoryCapture::Stop()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+
+	// 未完成的扫描只覆盖了部分对象，不能作为快照
+	bPassActive = false;
+	PassClassIndices.Empty();
+	PassClasses.Empty();
+}
+
+void FBlueprintMemoryCapture::CaptureNow()
+{
+	check(IsInGameThread());
+
+	if (!bPassActive)
+	{
+		BeginPass();
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	StepPass(MAX_dbl);
+	PassCaptureSeconds += FPlatformTime::Seconds() - StartTime;
+	FinishPass();
+}
+
+void FBlueprintMemoryCapture::Reset()
+{
+	bPassActive = false;
+	PassStartTime = 0.0;
+	PassClassIndices.Empty();
+	PassClasses.Empty();
+	Snapshots.Empty();
+}
+
+void FBlueprintMemoryCapture::SetSnapshots(TArray<FBlueprintMemorySnapshot>&& InSnapshots)
+{
+	Reset();
+	Snapshots = MoveTemp(InSnapshots);
+}
+
+bool FBlueprintMemoryCapture::Tick(float DeltaTime)
+{
+	const double Now = FPlatformTime::Seconds();
+	if (!bPassActive)
+	{
+		if (PassStartTime > 0.0 && Now - PassStartTime < IntervalSeconds)
+		{
+			return true;
+		}
+		BeginPass();
+	}
+
+	const bool bPassComplete = StepPass(Now + BudgetMs / 1000.0);
+	PassCaptureSeconds += FPlatformTime::Seconds() - Now;
+	if (bPassComplete)
+	{
+		FinishPass();
+	}
+	return true;
+}
+
+void FBlueprintMemoryCapture::BeginPass()
+{
+	bPassActive = true;
+	NextObjectIndex = 0;
+	PassStartTime = FPlatformTime::Seconds();
+	PassCaptureSeconds = 0.0;
+	PassFirstFrame = GFrameCounter;
+	PassClassIndices.Reset();
+	PassClasses.Reset();
+}
+
+bool FBlueprintMemoryCapture::StepPass(double EndTime)
+{
+	BLUEPRINTPROFILER_SCOPE_CYCLE_COUNTER(STAT_CaptureBlueprintMemory);
+
+	// 对象数组的索引在帧之间保持稳定，下一帧从上次停下的位置继续
+	constexpr int32 ObjectsPerTimeCheck = 32;
+	const int32 NumObjects = GUObjectArray.GetObjectArrayNum();
+	int32 NumVisited = 0;
+
+	while (NextObjectIndex < NumObjects)
+	{
+		if (++NumVisited % ObjectsPerTimeCheck == 0 && FPlatformTime::Seconds() >= EndTime)
+		{
+			return false;
+		}
+
+		FUObjectItem* Item = GUObjectArray.IndexToObject(NextObjectIndex++);
+		UObject* Object = Item ? static_cast<UObject*>(Item->Object) : nullptr;
+		if (!Object || Item->IsUnreachable() || !IsValid(Object))
+		{
+			continue;
+		}
+
+		UBlueprintGeneratedClass* Class = GetInstanceClass(Object, bPlayWorldsOnly);
+		if (!Class)
+		{
+			continue;
+		}
+
+		int32& ClassIndex = PassClassIndices.FindOrAdd(FObjectKey(Class), INDEX_NONE);
+		if (ClassIndex == INDEX_NONE)
+		{
+			ClassIndex = PassClasses.Num();
+			FBlueprintClassMemory& NewClass = PassClasses.AddDefaulted_GetRef();
+			NewClass.BlueprintName = GetBlueprintName(Class);
+			NewClass.ClassPath = Class->GetPathName();
+		}
+
+		FBlueprintClassMemory& ClassMemory = PassClasses[ClassIndex];
+		ClassMemory.InstanceCount++;
+		ClassMemory.InstanceBytes += MeasureInstance(Object);
+	}
+	return true;
+}
+
+void FBlueprintMemoryCapture::FinishPass()
+{
+	PassClasses.Sort([](const FBlueprintClassMemory& A, const FBlueprintClassMemory& B)
+	{
+		return A.InstanceBytes != B.InstanceBytes ? A.InstanceBytes > B.InstanceBytes : A.ClassPath < B.ClassPath;
+	});
+
+	FBlueprintMemorySnapshot& Snapshot = Snapshots.AddDefaulted_GetRef();
+	Snapshot.Timestamp = FPlatformTime::Seconds();
+	Snapshot.FirstFrameNumber = PassFirstFrame;
+	Snapshot.LastFrameNumber = GFrameCounter;
+	Snapshot.CaptureTimeMs = static_cast<float>(PassCaptureSeconds * 1000.0);
+	Snapshot.Classes = MoveTemp(PassClasses);
+
+	bPassActive = false;
+	PassClassIndices.Reset();
+	PassClasses.Reset();
+
+	OnSnapshotCaptured.Broadcast(Snapshot);
+}
+
+UBlueprintGeneratedClass* FBlueprintMemoryCapture::GetInstanceClass(const UObject* Object, bool bPlayWorldsOnly)
+{
+	if (!Object || Object->HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject))
+	{
+		return nullptr;
+	}
+
+	UBlueprintGeneratedClass* Class = Cast<UBlueprintGeneratedClass>(Object->GetClass());
+	if (!Class)
+	{
+		return nullptr;
+	}
+
+	// PIE 世界的对象位于带 PKG_PlayInEditor 标记的包中
+	if (bPlayWorldsOnly && !Object->GetPackage()->HasAnyPackageFlags(PKG_PlayInEditor))
+	{
+		return nullptr;
+	}
+	return Class;
+}
+
+int64 FBlueprintMemoryCapture::MeasureInstance(UObject* Instance)
+{
+	if (!Instance)
+	{
+		return 0;
+	}
+
+	int64 TotalBytes = 0;
+	TArray<UObject*, TInlineAllocator<16>> Pending;
+	Pending.Add(Instance);
+
+	while (Pending.Num() > 0)
+	{
+		UObject* Current = Pending.Pop(EAllowShrinking::No);
+
+		FResourceSizeEx ResourceSize(EResourceSizeMode::Exclusive);
+		Current->GetResourceSizeEx(ResourceSize);
+		TotalBytes += ResourceSize.GetTotalMemoryBytes();
+
+		// 嵌套的蓝图实例计入其自身的类
+		ForEachObjectWithOuter(Current, [&Pending](UObject* Subobject)
+		{
+			if (IsValid(Subobject) && !Cast<UBlueprintGeneratedClass>(Subobject->GetClass()))
+			{
+				Pending.Add(Subobject);
+			}
+		}, false);
+	}
+	return TotalBytes;
+}
+
+FString FBlueprintMemoryCapture::GetBlueprintName(const UBlueprintGeneratedClass* Class)
+{
+	if (!Class)
+	{
+		return FString();
+	}
+
+	if (const UBlueprint* Blueprint = Cast<UBlueprint>(Class->ClassGeneratedBy))
+	{
+		return Blueprint->GetName();
+	}
+
+	FString Name = Class->GetName();
+	if (Name.EndsWith(TEXT("_C")))
+	{
+		Name.LeftChopInline(2);
+	}
+	return Name;
+}
+
+void FBlueprintMemoryCapture::BuildTrends(TConstArrayView<FBlueprintMemorySnapshot> InSnapshots, TConstArrayView<FNodeExecutionData> ExecutionData, TArray<FBlueprintMemoryTrend>& OutTrends)
+{
+	OutTrends.Reset();
+
+	TMap<FString, int32> TrendIndices;
+	TArray<int32> LastSeenSnapshots;
+
+	for (int32 SnapshotIndex = 0; SnapshotIndex < InSnapshots.Num(); ++SnapshotIndex)
+	{
+		// 重新编译后同一蓝图可能有多个类，先按蓝图名合并
+		TMap<FString, TPair<int32, int64>> BlueprintTotals;
+		for (const FBlueprintClassMemory& Class : InSnapshots[SnapshotIndex].Classes)
+		{
+			TPair<int32, int64>& Totals = BlueprintTotals.FindOrAdd(Class.BlueprintName, TPair<int32, int64>(0, 0));
+			Totals.Key += Class.InstanceCount;
+			Totals.Value += Class.InstanceBytes;
+		}
+
+		for (const TPair<FString, TPair<int32, int64>>& Pair : BlueprintTotals)
+		{
+			int32& TrendIndex = TrendIndices.FindOrAdd(Pair.Key, INDEX_NONE);
+			if (TrendIndex == INDEX_NONE)
+			{
+				TrendIndex = OutTrends.Num();
+				FBlueprintMemoryTrend& NewTrend = OutTrends.AddDefaulted_GetRef();
+				NewTrend.BlueprintName = Pair.Key;
+				NewTrend.FirstBytes = Pair.Value.Value;
+				LastSeenSnapshots.Add(INDEX_NONE);
+			}
+
+			FBlueprintMemoryTrend& Trend = OutTrends[TrendIndex];
+			Trend.LatestInstanceCount = Pair.Value.Key;
+			Trend.LatestBytes = Pair.Value.Value;
+			Trend.PeakInstanceCount = FMath::Max(Trend.PeakInstanceCount, Pair.Value.Key);
+			Trend.PeakBytes = FMath::Max(Trend.PeakBytes, Pair.Value.Value);
+			Trend.NumSnapshots++;
+			LastSeenSnapshots[TrendIndex] = SnapshotIndex;
+		}
+	}
+
+	// 最后一个快照中已不存在的蓝图，当前占用为 0
+	for (int32 TrendIndex = 0; TrendIndex < OutTrends.Num(); ++TrendIndex)
+	{
+		if (LastSeenSnapshots[TrendIndex] != InSnapshots.Num() - 1)
+		{
+			OutTrends[TrendIndex].LatestInstanceCount = 0;
+			OutTrends[TrendIndex].LatestBytes = 0;
+		}
+	}
+
+	for (const FNodeExecutionData& Data : ExecutionData)
+	{
+		if (const int32* TrendIndex = TrendIndices.Find(Data.BlueprintName))
+		{
+			OutTrends[*TrendIndex].TotalExclusiveTime += Data.TotalExclusiveTime;
+		}
+	}
+
+	OutTrends.Sort([](const FBlueprintMemoryTrend& A, const FBlueprintMemoryTrend& B)
+	{
+		if (A.GetGrowthBytes() != B.GetGrowthBytes())
+		{
+			return A.GetGrowthBytes() > B.GetGrowthBytes();
+		}
+		return A.LatestBytes != B.LatestBytes ? A.LatestBytes > B.LatestBytes : A.BlueprintName < B.BlueprintName;
+	});
+}
@@ -0,0 +1,127 @@
+// Copyright xnbmy 2026. All Rights Reserved.
+
+#include "Analyzers/BlueprintProfilerTrace.h"
+#include "EdGraph/EdGraphNode.h"
+#include "Engine/Blueprint.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "Misc/ScopeRWLock.h"
+#include "UObject/ObjectKey.h"
+
+#if CPUPROFILERTRACE_ENABLED
+
+UE_TRACE_CHANNEL_DEFINE(BlueprintProfilerChannel)
+
+namespace BlueprintProfilerTrace
+{
+	// 所有线程共用一张表：函数 + 字节码偏移 -> 计时器；同名节点（同一节点的多个偏移）只注册一个计时器
+	struct FNodeTimer
+	{
+		uint32 TimerId = 0;
+		bool bNodeLevel = false;   // False: the function's timer, registered off the game thread until the node is resolved
+	};
+
+	static FRWLock TimerLock;
+	static TMap<TPair<FObjectKey, int32>, FNodeTimer> NodeTimerIds;
+	static TMap<FString, uint32> TimerIdsByName;
+
+	/** Registers a timer once per name; TimerLock must be held for writing */
+	static uint32 FindOrAddTimer(const FString& TimerName)
+	{
+		if (const uint32* ExistingId = TimerIdsByName.Find(TimerName))
+		{
+			return *ExistingId;
+		}
+
+		const uint32 TimerId = FCpuProfilerTrace::OutputEventType(*TimerName);
+		TimerIdsByName.Add(TimerName, TimerId);
+		return TimerId;
+	}
+
+	/** Node title of the code offset; only valid on the game thread */
+	static FString GetNodeTimerName(const UFunction* Function, int32 CodeOffset)
+	{
+		const UBlueprintGeneratedClass* GeneratedClass = Cast<UBlueprintGeneratedClass>(Function->GetOuterUClass());
+		const UBlueprint* Blueprint = GeneratedClass ? Cast<UBlueprint>(GeneratedClass->ClassGeneratedBy) : nullptr;
+		const FString BlueprintName = Blueprint ? Blueprint->GetName() : Function->GetOuterUClass()->GetName();
+
+		const UEdGraphNode* Node = GeneratedClass && GeneratedClass->DebugData.IsValid()
+			? GeneratedClass->DebugData.FindSourceNodeFromCodeLocation(const_cast<UFunction*>(Function), CodeOffset, true)
+			: nullptr;
+		if (!Node)
+		{
+			return FString::Printf(TEXT("BP %s: %s"), *BlueprintName, *Function->GetName());
+		}
+		return FString::Printf(TEXT("BP %s: %s"), *BlueprintName, *Node->GetNodeTitle(ENodeTitleType::ListView).ToString());
+	}
+
+	uint32 GetNodeTimerId(const UFunction* Function, int32 CodeOffset)
+	{
+		if (!Function)
+		{
+			return 0;
+		}
+
+		const bool bGameThread = IsInGameThread();
+		const TPair<FObjectKey, int32> Key(FObjectKey(Function), CodeOffset);
+		{
+			// 工作线程接受函数级计时器，重复事件只走读锁；游戏线程遇到它时替换成节点级计时器
+			FReadScopeLock ReadLock(TimerLock);
+			const FNodeTimer* Existing = NodeTimerIds.Find(Key);
+			if (Existing && (Existing->bNodeLevel || !bGameThread))
+			{
+				return Existing->TimerId;
+			}
+		}
+
+		if (!bGameThread)
+		{
+			// 节点标题只能在游戏线程读取；先记在函数的计时器上，等游戏线程解析出节点名
+			const FString FunctionTimerName = FString::Printf(TEXT("BP %s: %s"), *Function->GetOuterUClass()->GetName(), *Function->GetName());
+			FWriteScopeLock WriteLock(TimerLock);
+			if (const FNodeTimer* Existing = NodeTimerIds.Find(Key))
+			{
+				return Existing->TimerId;
+			}
+
+			FNodeTimer& FunctionTimer = NodeTimerIds.Add(Key);
+			FunctionTimer.TimerId = FindOrAddTimer(FunctionTimerName);
+			return FunctionTimer.TimerId;
+		}
+
+		const FString TimerName = GetNodeTimerName(Function, CodeOffset);
+		FWriteScopeLock WriteLock(TimerLock);
+		FNodeTimer& NodeTimer = NodeTimerIds.Add(Key);
+		NodeTimer.TimerId = FindOrAddTimer(TimerName);
+		NodeTimer.bNodeLevel = true;
+		return NodeTimer.TimerId;
+	}
+
+	void ResetNodeTimers()
+	{
+		// 已写入追踪流的计时器名称保留，下一次录制同名节点不会重复注册
+		FWriteScopeLock WriteLock(TimerLock);
+		NodeTimerIds.Empty();
+	}
+
+	void BeginNode(uint32 TimerId)
+	{
+		FCpuProfilerTrace::OutputBeginEvent(TimerId);
+	}
+
+	void EndNode()
+	{
+		FCpuProfilerTrace::OutputEndEvent();
+	}
+}
+
+#else
+
+namespace BlueprintProfilerTrace
+{
+	uint32 GetNodeTimerId(const UFunction* Function, int32 CodeOffset) { return 0; }
+	void ResetNodeTimers() {}
+	void BeginNode(uint32 TimerId) {}
+	void EndNode() {}
+}
+
+#endif
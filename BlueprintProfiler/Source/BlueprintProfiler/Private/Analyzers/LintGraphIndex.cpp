@@ -0,0 +1,137 @@
+// Copyright xnbmy 2026. All Rights Reserved.
+
+#include "Analyzers/LintGraphIndex.h"
+
+FLintGraphIndex::FLintGraphIndex(const FLintGraphSnapshot& Graph)
+{
+	const int32 NumNodes = Graph.Nodes.Num();
+
+	HasAnyLink.Init(false, NumNodes);
+	HasLinkedOutput.Init(false, NumNodes);
+	HasLinkedDataInput.Init(false, NumNodes);
+	HasLinkedDataOutput.Init(false, NumNodes);
+	HasExecInput.Init(false, NumNodes);
+	HasLinkedExecInput.Init(false, NumNodes);
+	TickEvents.Init(false, NumNodes);
+
+	TBitArray<> LoopBodies(false, NumNodes);
+
+	ExecOffsets.Reserve(NumNodes + 1);
+	for (int32 NodeIndex = 0; NodeIndex < NumNodes; ++NodeIndex)
+	{
+		const FLintNodeSnapshot& Node = Graph.Nodes[NodeIndex];
+		ExecOffsets.Add(ExecTargets.Num());
+
+		TickEvents[NodeIndex] = IsTickEvent(Node);
+		const bool bLoopNode = IsLoopNode(Node);
+
+		for (const FLintPinSnapshot& Pin : Node.Pins)
+		{
+			const bool bLinked = Pin.IsLinked();
+			if (Pin.bExec && !Pin.bOutput)
+			{
+				HasExecInput[NodeIndex] = true;
+			}
+
+			if (!bLinked)
+			{
+				continue;
+			}
+
+			HasAnyLink[NodeIndex] = true;
+			if (Pin.bOutput)
+			{
+				HasLinkedOutput[NodeIndex] = true;
+			}
+
+			if (!Pin.bExec && Pin.bOutput)
+			{
+				HasLinkedDataOutput[NodeIndex] = true;
+			}
+			else if (!Pin.bExec)
+			{
+				HasLinkedDataInput[NodeIndex] = true;
+			}
+			else if (!Pin.bOutput)
+			{
+				HasLinkedExecInput[NodeIndex] = true;
+			}
+			else
+			{
+				// 引脚连接是双向的，沿输出执行引脚正向遍历与从输入执行引脚反向追溯得到同一组路径
+				// 循环节点只有循环体输出在循环上下文中，Completed 之后的节点每次循环只执行一次
+				const bool bLoopBody = bLoopNode && Pin.Name != TEXT("Completed");
+				for (int32 LinkedNode : Pin.LinkedNodes)
+				{
+					if (LinkedNode != INDEX_NONE)
+					{
+						ExecTargets.Add(LinkedNode);
+						if (bLoopBody)
+						{
+							LoopBodies[LinkedNode] = true;
+						}
+					}
+				}
+			}
+		}
+	}
+	ExecOffsets.Add(ExecTargets.Num());
+
+	MarkReachable(TickEvents, ReachedFromTick);
+	MarkReachable(LoopBodies, ReachedFromLoop);
+}
+
+int32 FLintGraphIndex::CountReachable(int32 StartNode) const
+{
+	TBitArray<> Seeds(false, Num());
+	Seeds[StartNode] = true;
+
+	TBitArray<> Reached;
+	MarkReachable(Seeds, Reached);
+	return Reached.CountSetBits();
+}
+
+bool FLintGraphIndex::IsTickEvent(const FLintNodeSnapshot& Node)
+{
+	return Node.IsEvent() && (Node.MemberName == TEXT("ReceiveTick") || Node.MemberName == TEXT("Tick"));
+}
+
+bool FLintGraphIndex::IsLoopNode(const FLintNodeSnapshot& Node)
+{
+	// 标准循环（ForLoop、ForEachLoop、WhileLoop 及其 WithBreak 版本）是 StandardMacros 中的宏实例
+	static const TCHAR* LoopPatterns[] = { TEXT("ForLoop"), TEXT("WhileLoop"), TEXT("ForEach") };
+	for (const TCHAR* Pattern : LoopPatterns)
+	{
+		if (Node.ClassName.Contains(Pattern) ||
+			(Node.Kind == ELintNodeKind::MacroInstance && Node.MacroGraphName.ToString().Contains(Pattern)))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void FLintGraphIndex::MarkReachable(const TBitArray<>& Seeds, TBitArray<>& OutReached) const
+{
+	OutReached.Init(false, Num());
+
+	TArray<int32, TInlineAllocator<64>> Stack;
+	for (TConstSetBitIterator<> It(Seeds); It; ++It)
+	{
+		OutReached[It.GetIndex()] = true;
+		Stack.Add(It.GetIndex());
+	}
+
+	while (Stack.Num() > 0)
+	{
+		const int32 Node = Stack.Pop(EAllowShrinking::No);
+		for (int32 Successor : GetExecSuccessors(Node))
+		{
+			if (!OutReached[Successor])
+			{
+				OutReached[Successor] = true;
+				Stack.Add(Successor);
+			}
+		}
+	}
+}
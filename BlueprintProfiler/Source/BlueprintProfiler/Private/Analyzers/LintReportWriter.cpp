@@ -0,0 +1,306 @@
+// Copyright xnbmy 2026. All Rights Reserved.
+
+#include "Analyzers/LintReportWriter.h"
+#include "HAL/FileManager.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Serialization/Archive.h"
+
+const TCHAR* FLintReportWriter::LargeResourceRuleId = TEXT("LargeResource");
+
+namespace
+{
+	FString EscapeJson(const FString& Text)
+	{
+		FString Result;
+		Result.Reserve(Text.Len() + 8);
+		for (const TCHAR Char : Text)
+		{
+			switch (Char)
+			{
+			case TEXT('"'): Result += TEXT("\\\""); break;
+			case TEXT('\\'): Result += TEXT("\\\\"); break;
+			case TEXT('\n'): Result += TEXT("\\n"); break;
+			case TEXT('\r'): Result += TEXT("\\r"); break;
+			case TEXT('\t'): Result += TEXT("\\t"); break;
+			default:
+				if (Char < 0x20)
+				{
+					Result += FString::Printf(TEXT("\\u%04x"), static_cast<uint32>(Char));
+				}
+				else
+				{
+					Result.AppendChar(Char);
+				}
+				break;
+			}
+		}
+		return Result;
+	}
+
+	FString EscapeXml(const FString& Text)
+	{
+		return Text.Replace(TEXT("&"), TEXT("&amp;"))
+			.Replace(TEXT("<"), TEXT("&lt;"))
+			.Replace(TEXT(">"), TEXT("&gt;"))
+			.Replace(TEXT("\""), TEXT("&quot;"))
+			.Replace(TEXT("'"), TEXT("&apos;"));
+	}
+
+	const TCHAR* GetSeverityName(ESeverity Severity)
+	{
+		switch (Severity)
+		{
+		case ESeverity::Critical: return TEXT("Critical");
+		case ESeverity::High: return TEXT("High");
+		case ESeverity::Medium: return TEXT("Medium");
+		default: return TEXT("Low");
+		}
+	}
+
+	const TCHAR* GetSarifLevel(ESeverity Severity)
+	{
+		switch (Severity)
+		{
+		case ESeverity::Critical:
+		case ESeverity::High:
+			return TEXT("error");
+		case ESeverity::Medium:
+			return TEXT("warning");
+		default:
+			return TEXT("note");
+		}
+	}
+
+	/** Project-relative .uasset path for SARIF locations; the object path when it is not a package on disk */
+	FString GetArtifactUri(const FString& BlueprintPath)
+	{
+		const FString PackageName = FPackageName::ObjectPathToPackageName(BlueprintPath);
+		FString FileName;
+		if (FPackageName::TryConvertLongPackageNameToFilename(PackageName, FileName, FPackageName::GetAssetPackageExtension()))
+		{
+			FileName = FPaths::ConvertRelativePathToFull(FileName);
+			FPaths::MakePathRelativeTo(FileName, *FPaths::ConvertRelativePathToFull(FPaths::ProjectDir()));
+			return FileName;
+		}
+		return BlueprintPath;
+	}
+}
+
+FLintReportWriter::~FLintReportWriter()
+{
+	Close();
+}
+
+ELintReportFormat FLintReportWriter::ParseFormat(const FString& FormatName, const FString& FilePath)
+{
+	const FString Name = FormatName.IsEmpty() ? FPaths::GetExtension(FilePath) : FormatName;
+	if (Name.Equals(TEXT("sarif"), ESearchCase::IgnoreCase))
+	{
+		return ELintReportFormat::Sarif;
+	}
+	if (Name.Equals(TEXT("junit"), ESearchCase::IgnoreCase) || Name.Equals(TEXT("xml"), ESearchCase::IgnoreCase))
+	{
+		return ELintReportFormat::JUnit;
+	}
+	return ELintReportFormat::Json;
+}
+
+FString FLintReportWriter::GetRuleId(ELintIssueType Type)
+{
+	return StaticEnum<ELintIssueType>()->GetNameStringByValue(static_cast<int64>(Type));
+}
+
+ESeverity FLintReportWriter::GetLargeResourceSeverity(const FLargeResourceReference& Resource)
+{
+	return Resource.AssetSize >= 100.0f ? ESeverity::High : ESeverity::Medium;
+}
+
+bool FLintReportWriter::Open(const FString& FilePath, ELintReportFormat InFormat)
+{
+	Close();
+
+	// JUnit 的 testsuite 头要带用例数，用例先流式写入旁边的临时文件，关闭时再拼成报告
+	const FString StreamPath = InFormat == ELintReportFormat::JUnit ? GetJUnitCasesPath(FilePath) : FilePath;
+	Writer.Reset(IFileManager::Get().CreateFileWriter(*StreamPath));
+	if (!Writer.IsValid())
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to create lint report: %s"), *StreamPath);
+		return false;
+	}
+
+	Format = InFormat;
+	ReportFilePath = FilePath;
+	NumEntries = 0;
+
+	switch (Format)
+	{
+	case ELintReportFormat::Sarif:
+	{
+		FString Rules;
+		const UEnum* IssueTypeEnum = StaticEnum<ELintIssueType>();
+		for (int32 EnumIndex = 0; EnumIndex < IssueTypeEnum->NumEnums() - 1; ++EnumIndex)
+		{
+			Rules += FString::Printf(TEXT("{\"id\":\"%s\"},"), *IssueTypeEnum->GetNameStringByIndex(EnumIndex));
+		}
+		Rules += FString::Printf(TEXT("{\"id\":\"%s\"}"), LargeResourceRuleId);
+
+		WriteRaw(FString::Printf(TEXT("{\"$schema\":\"https://json.schemastore.org/sarif-2.1.0.json\",\"version\":\"2.1.0\",")
+			TEXT("\"runs\":[{\"tool\":{\"driver\":{\"name\":\"BlueprintProfiler\",\"rules\":[%s]}},\"results\":[\n"), *Rules));
+		break;
+	}
+	case ELintReportFormat::JUnit:
+		break;
+	default:
+		WriteRaw(TEXT("{\"version\":1,\"issues\":[\n"));
+		break;
+	}
+
+	Writer->Flush();
+	return true;
+}
+
+void FLintReportWriter::Close()
+{
+	if (!Writer.IsValid())
+	{
+		return;
+	}
+
+	switch (Format)
+	{
+	case ELintReportFormat::Sarif:
+		WriteRaw(TEXT("\n]}]}\n"));
+		break;
+	case ELintReportFormat::JUnit:
+		// 用例数此时才确定；报告写完后删除临时文件
+		Writer->Close();
+		Writer.Reset(IFileManager::Get().CreateFileWriter(*ReportFilePath));
+		if (Writer.IsValid())
+		{
+			WriteJUnitReport();
+		}
+		else
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to create lint report: %s"), *ReportFilePath);
+		}
+		IFileManager::Get().Delete(*GetJUnitCasesPath(ReportFilePath));
+		break;
+	default:
+		WriteRaw(TEXT("\n]}\n"));
+		break;
+	}
+
+	if (Writer.IsValid())
+	{
+		Writer->Close();
+		Writer.Reset();
+	}
+}
+
+void FLintReportWriter::WriteIssues(TConstArrayView<FLintIssue> Issues)
+{
+	if (!Writer.IsValid() || Issues.Num() == 0)
+	{
+		return;
+	}
+
+	for (const FLintIssue& Issue : Issues)
+	{
+		WriteEntry(GetRuleId(Issue.Type), Issue.BlueprintPath, Issue.NodeName, Issue.Description, Issue.Severity, Issue.NodeGuid);
+	}
+	Writer->Flush();
+}
+
+void FLintReportWriter::WriteLargeResource(const FString& BlueprintPath, const FLargeResourceReference& Resource)
+{
+	if (!Writer.IsValid())
+	{
+		return;
+	}
+
+	// 注册表审计得到的是硬引用链而不是变量，名称取链尾的包
+	FString Name = Resource.VariableName;
+	FString Message;
+	if (Name.IsEmpty())
+	{
+		FString ChainEnd = Resource.ReferencePath;
+		Resource.ReferencePath.Split(TEXT(" -> "), nullptr, &ChainEnd, ESearchCase::CaseSensitive, ESearchDir::FromEnd);
+		Name = FPackageName::GetShortName(ChainEnd);
+		Message = FString::Printf(TEXT("Hard references load %s '%s' (%.1f MB): %s"),
+			*Resource.AssetType, *ChainEnd, Resource.AssetSize, *Resource.ReferencePath);
+	}
+	else
+	{
+		Message = FString::Printf(TEXT("Variable '%s' references %s '%s' (%.1f MB)"),
+			*Resource.VariableName, *Resource.AssetType, *Resource.ReferencePath, Resource.AssetSize);
+	}
+	WriteEntry(LargeResourceRuleId, BlueprintPath, Name, Message, GetLargeResourceSeverity(Resource), FGuid());
+	Writer->Flush();
+}
+
+void FLintReportWriter::WriteEntry(const FString& RuleId, const FString& BlueprintPath, const FString& Name,
+	const FString& Message, ESeverity Severity, const FGuid& NodeGuid)
+{
+	const TCHAR* Separator = NumEntries > 0 ? TEXT(",\n") : TEXT("");
+	++NumEntries;
+
+	switch (Format)
+	{
+	case ELintReportFormat::Sarif:
+		WriteRaw(FString::Printf(TEXT("%s{\"ruleId\":\"%s\",\"level\":\"%s\",\"message\":{\"text\":\"%s\"},")
+			TEXT("\"locations\":[{\"physicalLocation\":{\"artifactLocation\":{\"uri\":\"%s\"}},")
+			TEXT("\"logicalLocations\":[{\"fullyQualifiedName\":\"%s\",\"name\":\"%s\"}]}],")
+			TEXT("\"partialFingerprints\":{\"nodeGuid\":\"%s\"}}"),
+			Separator, *RuleId, GetSarifLevel(Severity), *EscapeJson(Message),
+			*EscapeJson(GetArtifactUri(BlueprintPath)), *EscapeJson(BlueprintPath), *EscapeJson(Name),
+			*NodeGuid.ToString(EGuidFormats::DigitsWithHyphens)));
+		break;
+
+	case ELintReportFormat::JUnit:
+		WriteRaw(FString::Printf(TEXT("<testcase classname=\"%s\" name=\"%s: %s\"><failure type=\"%s\" message=\"%s\">%s</failure></testcase>\n"),
+			*EscapeXml(BlueprintPath), *EscapeXml(RuleId), *EscapeXml(Name), GetSeverityName(Severity),
+			*EscapeXml(Message), *EscapeXml(NodeGuid.ToString(EGuidFormats::DigitsWithHyphens))));
+		break;
+
+	default:
+		WriteRaw(FString::Printf(TEXT("%s{\"rule\":\"%s\",\"severity\":\"%s\",\"blueprint\":\"%s\",\"name\":\"%s\",\"message\":\"%s\",\"nodeGuid\":\"%s\"}"),
+			Separator, *RuleId, GetSeverityName(Severity), *EscapeJson(BlueprintPath), *EscapeJson(Name),
+			*EscapeJson(Message), *NodeGuid.ToString(EGuidFormats::DigitsWithHyphens)));
+		break;
+	}
+}
+
+FString FLintReportWriter::GetJUnitCasesPath(const FString& FilePath)
+{
+	return FilePath + TEXT(".cases");
+}
+
+void FLintReportWriter::WriteJUnitReport()
+{
+	// Every entry is a failed test case
+	WriteRaw(FString::Printf(TEXT("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<testsuites>\n<testsuite name=\"BlueprintProfilerLint\" tests=\"%d\" failures=\"%d\">\n"),
+		NumEntries, NumEntries));
+
+	TUniquePtr<FArchive> CasesReader(IFileManager::Get().CreateFileReader(*GetJUnitCasesPath(ReportFilePath)));
+	if (CasesReader.IsValid())
+	{
+		TArray<uint8> Buffer;
+		Buffer.SetNumUninitialized(64 * 1024);
+		for (int64 Remaining = CasesReader->TotalSize(); Remaining > 0 && !CasesReader->IsError();)
+		{
+			const int64 ChunkSize = FMath::Min<int64>(Remaining, Buffer.Num());
+			CasesReader->Serialize(Buffer.GetData(), ChunkSize);
+			Writer->Serialize(Buffer.GetData(), ChunkSize);
+			Remaining -= ChunkSize;
+		}
+	}
+
+	WriteRaw(TEXT("</testsuite>\n</testsuites>\n"));
+}
+
+void FLintReportWriter::WriteRaw(const FString& Text)
+{
+	FTCHARToUTF8 Utf8(*Text);
+	Writer->Serialize(const_cast<ANSICHAR*>(Utf8.Get()), Utf8.Length());
+}
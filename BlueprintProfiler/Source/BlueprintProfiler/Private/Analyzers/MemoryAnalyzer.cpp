@@ -9,7 +9,10 @@
 #include "Materials/Material.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "UObject/UObjectIterator.h"
+#include "UObject/UObjectHash.h"
 #include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "Algo/Reverse.h"
 #include "K2Node.h"
 #include "K2Node_FunctionEntry.h"
 #include "K2Node_Variable.h"
@@ -26,34 +29,98 @@
 #include "Animation/AnimSequence.h"
 #include "Animation/AnimBlueprint.h"
 
+namespace
+{
+	/** Collects references to assets and other objects that matter for memory (components, textures, meshes...) */
+	class FSignificantReferenceFinder : public FReferenceCollector
+	{
+	public:
+		FSignificantReferenceFinder(TArray<UObject*>& InReferences, const TSet<UObject*>& InVisited)
+			: References(InReferences), Visited(InVisited)
+		{
+		}
+
+		virtual void HandleObjectReference(UObject*& Object, const UObject* ReferencingObject, const FProperty* ReferencingProperty) override
+		{
+			if (Object && !Visited.Contains(Object) && Object != ReferencingObject)
+			{
+				if (Object->IsAsset() ||
+					Object->IsA<UActorComponent>() ||
+					Object->IsA<UTexture>() ||
+					Object->IsA<UStaticMesh>() ||
+					Object->IsA<USkeletalMesh>() ||
+					Object->IsA<USoundWave>() ||
+					Object->IsA<UMaterial>() ||
+					Object->IsA<UParticleSystem>() ||
+					Object->IsA<UAnimSequence>())
+				{
+					References.AddUnique(Object);
+				}
+			}
+		}
+
+		virtual bool IsIgnoringArchetypeRef() const override { return false; }
+		virtual bool IsIgnoringTransient() const override { return true; }
+
+	private:
+		TArray<UObject*>& References;
+		const TSet<UObject*>& Visited;
+	};
+
+	/** Measured size of the package's main asset if it is in the size cache, its package size on disk otherwise */
+	int64 GetPackageSizeBytes(const FAssetDependencyGraph& Graph, int32 PackageIndex, const FObjectSizeCache* SizeCache)
+	{
+		const FAssetData& AssetData = Graph.GetPrimaryAsset(PackageIndex);
+
+		FObjectSizeInfo SizeInfo;
+		if (SizeCache && AssetData.IsValid() && SizeCache->Find(AssetData.GetSoftObjectPath(), SizeInfo))
+		{
+			return SizeInfo.EstimatedTotalBytes;
+		}
+		return Graph.GetDiskSize(PackageIndex);
+	}
+}
+
 /**
  * Async task for memory analysis
  */
 class FMemoryAnalysisTask : public FNonAbandonableTask
 {
 public:
-	FMemoryAnalysisTask(FMemoryAnalyzer* InAnalyzer, UBlueprint* InBlueprint)
+	/** The object-level part of the result was gathered on the game thread; the task only adds the package-level sizes */
+	FMemoryAnalysisTask(FMemoryAnalyzer* InAnalyzer, UBlueprint* InBlueprint, FMemoryAnalysisResult&& InResult)
 		: Analyzer(InAnalyzer)
 		, Blueprint(InBlueprint)
+		, PackageName(InBlueprint->GetPackage()->GetFName())
+		, Result(MoveTemp(InResult))
 	{
 	}
 
 	void DoWork()
 	{
-		if (!Analyzer || !Blueprint)
+		if (!Analyzer)
 		{
 			return;
 		}
 
-		FMemoryAnalysisResult Result;
-		Analyzer->CalculateInclusiveSize(Blueprint, Result);
+		// 不访问任何 UObject：依赖图来自注册表快照，大小来自缓存；单个蓝图不值得在这里构建整个注册表的支配树
+		const TSharedPtr<const FAssetDominatorTree> DominatorTreePtr = Analyzer->FindDominatorTree();
+		if (DominatorTreePtr.IsValid())
+		{
+			FMemoryAnalyzer::ApplyPackageSizes(*DominatorTreePtr, PackageName, Result);
+		}
+		else
+		{
+			Result.bPackageSizesPending = true;
+		}
 
 		// Complete analysis on game thread
-		AsyncTask(ENamedThreads::GameThread, [this, Result]()
+		// CompleteAnalysis releases this task, so the lambda owns its copy of the result
+		AsyncTask(ENamedThreads::GameThread, [Analyzer = Analyzer, Blueprint = Blueprint, Result = MoveTemp(Result)]()
 		{
 			if (Analyzer)
 			{
-				Analyzer->CompleteAnalysis(Blueprint, Result);
+				Analyzer->CompleteAnalysis(Blueprint.Get(), Result);
 			}
 		});
 	}
@@ -65,7 +132,9 @@ public:
 
 private:
 	FMemoryAnalyzer* Analyzer;
-	UBlueprint* Blueprint;
+	TWeakObjectPtr<UBlueprint> Blueprint;   // Only dereferenced on the game thread
+	FName PackageName;
+	FMemoryAnalysisResult Result;
 };
 
 
@@ -80,6 +149,7 @@ FMemoryAnalyzer::FMemoryAnalyzer()
 FMemoryAnalyzer::~FMemoryAnalyzer()
 {
 	CancelAnalysis();
+	CancelDominatorTreeBuild();
 }
 
 void FMemoryAnalyzer::AnalyzeBlueprint(UBlueprint* Blueprint)
@@ -97,7 +167,18 @@ void FMemoryAnalyzer::AnalyzeBlueprint(UBlueprint* Blueprint)
 	}
 
 	FMemoryAnalysisResult Result;
-	CalculateInclusiveSize(Blueprint, Result);
+	GatherObjectReferences(Blueprint, Result);
+
+	// 支配树只在后台构建：尚未建立时先报告对象累加的大小，构建完成后再次广播
+	const TSharedPtr<const FAssetDominatorTree> DominatorTreePtr = FindDominatorTree();
+	if (DominatorTreePtr.IsValid())
+	{
+		ApplyPackageSizes(*DominatorTreePtr, Blueprint->GetPackage()->GetFName(), Result);
+	}
+	else
+	{
+		Result.bPackageSizesPending = true;
+	}
 
 	{
 		FScopeLock Lock(&ResultsLock);
@@ -105,6 +186,11 @@ void FMemoryAnalyzer::AnalyzeBlueprint(UBlueprint* Blueprint)
 	}
 
 	OnAnalysisComplete.Broadcast(Result);
+
+	if (Result.bPackageSizesPending)
+	{
+		RequestDominatorTree();
+	}
 }
 
 void FMemoryAnalyzer::AnalyzeBlueprintAsync(UBlueprint* Blueprint, FOnAnalysisComplete OnComplete)
@@ -129,9 +215,30 @@ void FMemoryAnalyzer::AnalyzeBlueprintAsync(UBlueprint* Blueprint, FOnAnalysisCo
 		OnComplete.Broadcast(Result);
 	});
 
-	// Start async analysis
-	CurrentAnalysisTask = MakeShared<FAsyncTask<FMemoryAnalysisTask>>(this, Blueprint);
-	CurrentAnalysisTask->StartBackgroundTask();
+	// GetResourceSizeEx is game thread only: measure the blueprint and its dependencies over the next ticks,
+	// then let the background task read the sizes from the cache
+	TArray<FSoftObjectPath> PrewarmPaths;
+	GatherSizePrewarmPaths(Blueprint, PrewarmPaths);
+
+	TWeakObjectPtr<UBlueprint> WeakBlueprint(Blueprint);
+	SizeCache.RequestSizes(MoveTemp(PrewarmPaths), [this, WeakBlueprint]()
+	{
+		UBlueprint* PrewarmedBlueprint = WeakBlueprint.Get();
+		if (!PrewarmedBlueprint)
+		{
+			bAnalysisInProgress = false;
+			UE_LOG(LogTemp, Warning, TEXT("Blueprint was unloaded before memory analysis could start"));
+			return;
+		}
+
+		// Sizes are cached now: walk the object references here and hand the worker plain data
+		FMemoryAnalysisResult Result;
+		GatherObjectReferences(PrewarmedBlueprint, Result);
+
+		// Start async analysis
+		CurrentAnalysisTask = MakeShared<FAsyncTask<FMemoryAnalysisTask>>(this, PrewarmedBlueprint, MoveTemp(Result));
+		CurrentAnalysisTask->StartBackgroundTask();
+	});
 }
 
 void FMemoryAnalyzer::CancelAnalysis()
@@ -140,12 +247,30 @@ void FMemoryAnalyzer::CancelAnalysis()
 	{
 		bCancelRequested = true;
 
+		// 尚在测量大小时取消，后台任务不会再启动
+		SizeCache.CancelRequests();
+
 		if (CurrentAnalysisTask.IsValid())
 		{
 			CurrentAnalysisTask->EnsureCompletion();
 			CurrentAnalysisTask.Reset();
 		}
 
+		// 后台任务（引用计数、内存审计）在构建依赖图和并行遍历时检查取消标志
+		if (BackgroundTickerHandle.IsValid())
+		{
+			FTSTicker::GetCoreTicker().RemoveTicker(BackgroundTickerHandle);
+			BackgroundTickerHandle.Reset();
+		}
+		if (BackgroundTask.IsValid())
+		{
+			BackgroundTask.Wait();
+		}
+		OnBackgroundTaskComplete.Reset();
+		PendingDependencyGraph.Reset();
+		PendingReferenceCounts.Empty();
+		PendingAuditEntries.Empty();
+
 		bAnalysisInProgress = false;
 		bCancelRequested = false;
 
@@ -186,48 +311,51 @@ TArray<FReferenceChain> FMemoryAnalyzer::GetReferenceChains(UBlueprint* Blueprin
 	return Result.ReferenceChains;
 }
 
-void FMemoryAnalyzer::CalculateInclusiveSize(UBlueprint* Blueprint, FMemoryAnalysisResult& Result)
+void FMemoryAnalyzer::GatherObjectReferences(UBlueprint* Blueprint, FMemoryAnalysisResult& Result)
 {
+	check(IsInGameThread());
+
 	if (!Blueprint)
 	{
 		return;
 	}
 
-	// Calculate direct size of the blueprint
-	Result.InclusiveSize = CalculateObjectSize(Blueprint) / (1024.0f * 1024.0f); // Convert to MB
-
-	// Find all referenced objects
+	// Object-level reference chains of the loaded blueprint
 	TArray<FReferenceChain> ReferenceChains;
 	TraceReferenceChains(Blueprint, ReferenceChains);
 	Result.ReferenceChains = ReferenceChains;
 
-	// Calculate total inclusive size
-	TSet<UObject*> CountedObjects;
-	CountedObjects.Add(Blueprint);
-
+	Result.ReferenceDepth = 0;
 	for (const FReferenceChain& Chain : ReferenceChains)
 	{
-		for (const TWeakObjectPtr<UObject>& ObjectPtr : Chain.Chain)
+		Result.ReferenceDepth = FMath::Max(Result.ReferenceDepth, Chain.Chain.Num());
+	}
+
+	// 引用链上对象的去重累加；ApplyPackageSizes 之后换成支配树的包级大小，未保存的蓝图不在注册表快照中，保留这个结果
+	{
+		TSet<UObject*> CountedObjects;
+		CountedObjects.Add(Blueprint);
+		Result.InclusiveSize = CalculateObjectSize(Blueprint) / (1024.0f * 1024.0f);
+		Result.ExclusiveSize = Result.InclusiveSize;
+
+		for (const FReferenceChain& Chain : ReferenceChains)
 		{
-			if (UObject* Object = ObjectPtr.Get())
+			for (const TWeakObjectPtr<UObject>& ObjectPtr : Chain.Chain)
 			{
-				if (!CountedObjects.Contains(Object))
+				UObject* Object = ObjectPtr.Get();
+				if (Object && !CountedObjects.Contains(Object))
 				{
 					Result.InclusiveSize += CalculateObjectSize(Object) / (1024.0f * 1024.0f);
 					CountedObjects.Add(Object);
 				}
 			}
 		}
-	}
 
-	Result.ReferenceDepth = 0;
-	for (const FReferenceChain& Chain : ReferenceChains)
-	{
-		Result.ReferenceDepth = FMath::Max(Result.ReferenceDepth, Chain.Chain.Num());
+		Result.RetainedSize = Result.InclusiveSize;
+		Result.SharedSize = 0.0f;
+		Result.TotalReferences = CountedObjects.Num() - 1; // Exclude the blueprint itself
 	}
 
-	Result.TotalReferences = CountedObjects.Num() - 1; // Exclude the blueprint itself
-
 	// Find large resource references
 	TArray<FLargeResourceReference> LargeReferences;
 	FindLargeResourceReferences(Blueprint, LargeReferences);
@@ -240,6 +368,24 @@ void FMemoryAnalyzer::CalculateInclusiveSize(UBlueprint* Blueprint, FMemoryAnaly
 	}
 }
 
+bool FMemoryAnalyzer::ApplyPackageSizes(const FAssetDominatorTree& Tree, FName PackageName, FMemoryAnalysisResult& Result)
+{
+	// Package-level sizes from the dominator tree of the hard-reference graph; shared dependencies are counted once
+	const int32 PackageIndex = Tree.GetGraph()->FindPackage(PackageName);
+	if (PackageIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	const FAssetRetainedSize Sizes = Tree.GetSizes(PackageIndex);
+	Result.ExclusiveSize = Sizes.ExclusiveBytes / (1024.0f * 1024.0f);
+	Result.RetainedSize = Sizes.RetainedBytes / (1024.0f * 1024.0f);
+	Result.SharedSize = Sizes.SharedBytes / (1024.0f * 1024.0f);
+	Result.InclusiveSize = Sizes.GetInclusiveBytes() / (1024.0f * 1024.0f);
+	Result.TotalReferences = Sizes.NumHardDependencies;
+	return true;
+}
+
 void FMemoryAnalyzer::TraceReferenceChains(UObject* Object, TArray<FReferenceChain>& OutChains, int32 MaxDepth)
 {
 	if (!Object || MaxDepth <= 0)
@@ -247,131 +393,210 @@ void FMemoryAnalyzer::TraceReferenceChains(UObject* Object, TArray<FReferenceCha
 		return;
 	}
 
-	// Build reference tree using proper UE reference finding
-	TSharedPtr<FReferenceNode> RootNode = MakeShared<FReferenceNode>();
-	RootNode->Object = Object;
-	RootNode->ObjectName = Object->GetName();
-	RootNode->ObjectType = GetObjectTypeName(Object);
-	RootNode->ObjectSize = CalculateObjectSize(Object);
+	TArray<FReferenceNode> Nodes;
+	BuildReferenceTree(Object, MaxDepth, Nodes);
+
+	// 每个叶子沿父索引回溯到根即为一条引用链
+	for (int32 NodeIndex = 1; NodeIndex < Nodes.Num(); ++NodeIndex)
+	{
+		if (Nodes[NodeIndex].NumChildren > 0)
+		{
+			continue;
+		}
+
+		FReferenceChain Chain;
+		Chain.Chain.Reserve(Nodes[NodeIndex].Depth + 1);
+		for (int32 Current = NodeIndex; Current != INDEX_NONE; Current = Nodes[Current].ParentIndex)
+		{
+			Chain.Chain.Add(Nodes[Current].Object);
+			Chain.TotalSize += Nodes[Current].ObjectSize;
+		}
+		Algo::Reverse(Chain.Chain);
+
+		Chain.Description = FString::Printf(TEXT("Reference chain: %s -> ... -> %s (%d objects, %.2f MB)"),
+			*Nodes[0].ObjectName, *Nodes[NodeIndex].ObjectName, Chain.Chain.Num(), Chain.TotalSize);
+		OutChains.Add(MoveTemp(Chain));
+	}
+}
+
+void FMemoryAnalyzer::BuildReferenceTree(UObject* RootObject, int32 MaxDepth, TArray<FReferenceNode>& OutNodes) const
+{
+	// CallAddReferencedObjects and the name lookups touch live UObjects
+	check(IsInGameThread());
+
+	OutNodes.Reset();
+	if (!RootObject)
+	{
+		return;
+	}
 
 	TSet<UObject*> VisitedObjects;
-	BuildReferenceTreeWithReferenceFinder(Object, RootNode, VisitedObjects, 0, MaxDepth);
+	auto AddNode = [this, &OutNodes, &VisitedObjects](UObject* Object, int32 ParentIndex, int32 Depth)
+	{
+		VisitedObjects.Add(Object);
+
+		FReferenceNode& Node = OutNodes.AddDefaulted_GetRef();
+		Node.Object = Object;
+		Node.ObjectName = Object->GetName();
+		Node.ObjectType = GetObjectTypeName(Object);
+		Node.ObjectSize = CalculateObjectSize(Object) / (1024.0f * 1024.0f);
+		Node.ParentIndex = ParentIndex;
+		Node.Depth = Depth;
+	};
 
-	// Convert tree to chains
-	TFunction<void(TSharedPtr<FReferenceNode>, TArray<TWeakObjectPtr<UObject>>&)> ConvertToChains;
-	ConvertToChains = [&](TSharedPtr<FReferenceNode> Node, TArray<TWeakObjectPtr<UObject>>& CurrentChain)
+	// 广度优先展开，节点按层追加到数组，每个对象只出现一次
+	AddNode(RootObject, INDEX_NONE, 0);
+	for (int32 NodeIndex = 0; NodeIndex < OutNodes.Num(); ++NodeIndex)
 	{
-		if (!Node.IsValid())
+		UObject* Object = OutNodes[NodeIndex].Object.Get();
+		const int32 Depth = OutNodes[NodeIndex].Depth;
+		if (!Object || Depth >= MaxDepth)
 		{
-			return;
+			continue;
 		}
 
-		CurrentChain.Add(Node->Object);
+		TArray<UObject*> ReferencedObjects;
+		FSignificantReferenceFinder ReferenceFinder(ReferencedObjects, VisitedObjects);
+		Object->CallAddReferencedObjects(ReferenceFinder);
 
-		if (Node->Children.Num() == 0)
+		for (UObject* ReferencedObject : ReferencedObjects)
 		{
-			// Leaf node - create chain
-			FReferenceChain Chain;
-			Chain.Chain = CurrentChain;
-			Chain.TotalSize = 0.0f;
-			
-			for (const TWeakObjectPtr<UObject>& ObjectPtr : CurrentChain)
+			if (ReferencedObject && !VisitedObjects.Contains(ReferencedObject))
 			{
-				if (UObject* ChainObject = ObjectPtr.Get())
-				{
-					Chain.TotalSize += CalculateObjectSize(ChainObject);
-				}
+				AddNode(ReferencedObject, NodeIndex, Depth + 1);
+				++OutNodes[NodeIndex].NumChildren;
 			}
-			
-			Chain.Description = FString::Printf(TEXT("Reference chain: %s -> ... (%d objects, %.2f MB)"), 
-				*Object->GetName(), CurrentChain.Num(), Chain.TotalSize / (1024.0f * 1024.0f));
-			OutChains.Add(Chain);
 		}
-		else
+	}
+}
+
+TSharedPtr<const FAssetDominatorTree> FMemoryAnalyzer::GetOrBuildDominatorTree(const std::atomic<bool>* bCancel)
+{
+	FScopeLock BuildLock(&DominatorTreeLock);
+
+	TSharedPtr<const FAssetDependencyGraph> Graph = GetDependencyGraph();
+	if (DominatorTree.IsValid() && DominatorTree->GetGraph() == Graph.Get())
+	{
+		return DominatorTree;
+	}
+
+	if (!Graph.IsValid())
+	{
+		// 尚未做过引用计数分析时先建立注册表快照，供之后的分析复用
+		TSharedRef<FAssetDependencyGraph> NewGraph = MakeShared<FAssetDependencyGraph>();
+		if (!NewGraph->Build(FModuleManager::GetModuleChecked<FAssetRegistryModule>("AssetRegistry").Get(), bCancel))
 		{
-			// Continue traversing children
-			for (TSharedPtr<FReferenceNode> Child : Node->Children)
-			{
-				ConvertToChains(Child, CurrentChain);
-			}
+			return nullptr;
 		}
 
-		CurrentChain.RemoveAt(CurrentChain.Num() - 1);
-	};
+		FScopeLock Lock(&ResultsLock);
+		DependencyGraph = NewGraph;
+		Graph = NewGraph;
+	}
+
+	TSharedRef<FAssetDominatorTree> NewTree = MakeShared<FAssetDominatorTree>();
+	NewTree->Build(Graph.ToSharedRef(), GatherPackageSizes(*Graph, &SizeCache));
+
+	FScopeLock Lock(&ResultsLock);
+	DominatorTree = NewTree;
+	return DominatorTree;
+}
 
-	TArray<TWeakObjectPtr<UObject>> InitialChain;
-	ConvertToChains(RootNode, InitialChain);
+TSharedPtr<const FAssetDominatorTree> FMemoryAnalyzer::FindDominatorTree() const
+{
+	// 不等待 DominatorTreeLock：后台构建期间游戏线程只会得到空结果
+	FScopeLock Lock(&ResultsLock);
+	if (DominatorTree.IsValid() && DominatorTree->GetGraph() == DependencyGraph.Get())
+	{
+		return DominatorTree;
+	}
+	return nullptr;
 }
 
-void FMemoryAnalyzer::BuildReferenceTreeWithReferenceFinder(UObject* RootObject, TSharedPtr<FReferenceNode> ParentNode, TSet<UObject*>& VisitedObjects, int32 CurrentDepth, int32 MaxDepth)
+void FMemoryAnalyzer::RequestDominatorTree()
 {
-	if (!RootObject || !ParentNode.IsValid() || CurrentDepth >= MaxDepth || VisitedObjects.Contains(RootObject))
+	// 与其他分析互不阻塞：构建期间的请求共用同一次构建
+	if (IsDominatorTreeBuildInProgress())
 	{
 		return;
 	}
 
-	VisitedObjects.Add(RootObject);
+	bCancelDominatorTreeBuild = false;
 
-	// Find objects referenced by this object using UE's reference system
-	TArray<UObject*> ReferencedObjects;
-	
-	// Use FReferenceFinder to find actual references
-	class FSimpleReferenceFinder : public FReferenceCollector
+	UE_LOG(LogTemp, Log, TEXT("Building the asset dominator tree in the background; memory sizes are pending"));
+
+	DominatorTreeTask = UE::Tasks::Launch(TEXT("MemoryAnalyzerDominatorTree"), [this]()
 	{
-	public:
-		TArray<UObject*>& References;
-		TSet<UObject*>& Visited;
-		
-		FSimpleReferenceFinder(TArray<UObject*>& InReferences, TSet<UObject*>& InVisited)
-			: References(InReferences), Visited(InVisited) {}
-		
-		virtual void HandleObjectReference(UObject*& Object, const UObject* ReferencingObject, const FProperty* ReferencingProperty) override
-		{
-			if (Object && !Visited.Contains(Object) && Object != ReferencingObject)
-			{
-				// Only include significant objects (assets, components, etc.)
-				if (Object->IsAsset() || 
-					Object->IsA<UActorComponent>() || 
-					Object->IsA<UTexture>() || 
-					Object->IsA<UStaticMesh>() || 
-					Object->IsA<USkeletalMesh>() || 
-					Object->IsA<USoundWave>() || 
-					Object->IsA<UMaterial>() ||
-					Object->IsA<UParticleSystem>() ||
-					Object->IsA<UAnimSequence>())
-				{
-					References.AddUnique(Object);
-				}
-			}
-		}
-		
-		virtual bool IsIgnoringArchetypeRef() const override { return false; }
-		virtual bool IsIgnoringTransient() const override { return true; }
-	};
-	
-	FSimpleReferenceFinder ReferenceFinder(ReferencedObjects, VisitedObjects);
-	RootObject->CallAddReferencedObjects(ReferenceFinder);
+		GetOrBuildDominatorTree(&bCancelDominatorTreeBuild);
+	}, UE::Tasks::ETaskPriority::BackgroundNormal);
+
+	DominatorTreeTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateRaw(this, &FMemoryAnalyzer::TickDominatorTreeBuild));
+}
+
+bool FMemoryAnalyzer::TickDominatorTreeBuild(float DeltaTime)
+{
+	if (!DominatorTreeTask.IsCompleted())
+	{
+		return true;
+	}
+
+	DominatorTreeTickerHandle.Reset();
+	CompleteDominatorTreeBuild();
+	return false;
+}
 
-	// Create child nodes for found references
-	for (UObject* ReferencedObject : ReferencedObjects)
+void FMemoryAnalyzer::CancelDominatorTreeBuild()
+{
+	if (!IsDominatorTreeBuildInProgress())
 	{
-		if (ReferencedObject && !VisitedObjects.Contains(ReferencedObject))
+		return;
+	}
+
+	bCancelDominatorTreeBuild = true;
+	FTSTicker::GetCoreTicker().RemoveTicker(DominatorTreeTickerHandle);
+	DominatorTreeTickerHandle.Reset();
+	DominatorTreeTask.Wait();
+}
+
+void FMemoryAnalyzer::CompleteDominatorTreeBuild()
+{
+	const TSharedPtr<const FAssetDominatorTree> DominatorTreePtr = FindDominatorTree();
+	if (!DominatorTreePtr.IsValid())
+	{
+		return;
+	}
+
+	TArray<FMemoryAnalysisResult> UpdatedResults;
+	{
+		FScopeLock Lock(&ResultsLock);
+		for (TPair<TWeakObjectPtr<UObject>, FMemoryAnalysisResult>& ResultPair : AnalysisResults)
 		{
-			TSharedPtr<FReferenceNode> ChildNode = MakeShared<FReferenceNode>();
-			ChildNode->Object = ReferencedObject;
-			ChildNode->ObjectName = ReferencedObject->GetName();
-			ChildNode->ObjectType = GetObjectTypeName(ReferencedObject);
-			ChildNode->ObjectSize = CalculateObjectSize(ReferencedObject);
-			
-			ParentNode->Children.Add(ChildNode);
-			
-			// Recursively build children (with depth limit)
-			if (CurrentDepth < MaxDepth - 1)
+			const UObject* Object = ResultPair.Key.Get();
+			if (Object && ResultPair.Value.bPackageSizesPending)
 			{
-				BuildReferenceTreeWithReferenceFinder(ReferencedObject, ChildNode, VisitedObjects, CurrentDepth + 1, MaxDepth);
+				ApplyPackageSizes(*DominatorTreePtr, Object->GetPackage()->GetFName(), ResultPair.Value);
+				ResultPair.Value.bPackageSizesPending = false;
+				UpdatedResults.Add(ResultPair.Value);
 			}
 		}
 	}
+
+	for (const FMemoryAnalysisResult& Result : UpdatedResults)
+	{
+		OnAnalysisComplete.Broadcast(Result);
+	}
+}
+
+TArray<int64> FMemoryAnalyzer::GatherPackageSizes(const FAssetDependencyGraph& Graph, const FObjectSizeCache* SizeCache)
+{
+	TArray<int64> PackageSizes;
+	PackageSizes.SetNumUninitialized(Graph.Num());
+	ParallelFor(TEXT("GatherPackageSizes"), Graph.Num(), 1024, [&Graph, SizeCache, &PackageSizes](int32 PackageIndex)
+	{
+		PackageSizes[PackageIndex] = GetPackageSizeBytes(Graph, PackageIndex, SizeCache);
+	}, EParallelForFlags::BackgroundPriority);
+	return PackageSizes;
 }
 
 void FMemoryAnalyzer::FindLargeResourceReferences(UBlueprint* Blueprint, TArray<FLargeResourceReference>& OutReferences)
@@ -449,7 +674,7 @@ void FMemoryAnalyzer::AnalyzePropertyForLargeResources(UBlueprint* Blueprint, FP
 				Reference.ReferencingBlueprint = Blueprint;
 				Reference.ReferencedAsset = ReferencedObject;
 				Reference.VariableName = Property->GetName();
-				Reference.AssetSize = CalculateObjectSize(ReferencedObject) / (1024.0f * 1024.0f);
+				Reference.AssetSize = CalculateObjectSize(ReferencedObject, EResourceSizeMode::EstimatedTotal) / (1024.0f * 1024.0f);
 				Reference.AssetType = GetObjectTypeName(ReferencedObject);
 				Reference.ReferencePath = ReferencedObject->GetPathName();
 				
@@ -471,7 +696,7 @@ void FMemoryAnalyzer::AnalyzePropertyForLargeResources(UBlueprint* Blueprint, FP
 					Reference.ReferencingBlueprint = Blueprint;
 					Reference.ReferencedAsset = ReferencedObject;
 					Reference.VariableName = Property->GetName();
-					Reference.AssetSize = CalculateObjectSize(ReferencedObject) / (1024.0f * 1024.0f);
+					Reference.AssetSize = CalculateObjectSize(ReferencedObject, EResourceSizeMode::EstimatedTotal) / (1024.0f * 1024.0f);
 					Reference.AssetType = GetObjectTypeName(ReferencedObject);
 					Reference.ReferencePath = ReferencedObject->GetPathName();
 					
@@ -497,7 +722,7 @@ void FMemoryAnalyzer::AnalyzePropertyForLargeResources(UBlueprint* Blueprint, FP
 						Reference.ReferencingBlueprint = Blueprint;
 						Reference.ReferencedAsset = ReferencedObject;
 						Reference.VariableName = FString::Printf(TEXT("%s[%d]"), *Property->GetName(), Index);
-						Reference.AssetSize = CalculateObjectSize(ReferencedObject) / (1024.0f * 1024.0f);
+						Reference.AssetSize = CalculateObjectSize(ReferencedObject, EResourceSizeMode::EstimatedTotal) / (1024.0f * 1024.0f);
 						Reference.AssetType = GetObjectTypeName(ReferencedObject);
 						Reference.ReferencePath = ReferencedObject->GetPathName();
 						
@@ -545,7 +770,7 @@ void FMemoryAnalyzer::AnalyzeGraphForLargeResources(UBlueprint* Blueprint, UEdGr
 							Reference.ReferencingBlueprint = Blueprint;
 							Reference.ReferencedAsset = ReferencedObject;
 							Reference.VariableName = FString::Printf(TEXT("Node_%s_Pin_%s"), *K2Node->GetName(), *Pin->PinName.ToString());
-							Reference.AssetSize = CalculateObjectSize(ReferencedObject) / (1024.0f * 1024.0f);
+							Reference.AssetSize = CalculateObjectSize(ReferencedObject, EResourceSizeMode::EstimatedTotal) / (1024.0f * 1024.0f);
 							Reference.AssetType = GetObjectTypeName(ReferencedObject);
 							Reference.ReferencePath = ReferencedObject->GetPathName();
 							
@@ -585,45 +810,77 @@ void FMemoryAnalyzer::AnalyzeVariableNode(UBlueprint* Blueprint, UK2Node* Variab
 	}
 }
 
-float FMemoryAnalyzer::CalculateObjectSize(UObject* Object) const
+float FMemoryAnalyzer::CalculateObjectSize(UObject* Object, EResourceSizeMode::Type Mode) const
 {
 	if (!Object)
 	{
 		return 0.0f;
 	}
 
-	// Note: GetResourceSizeEx must be called on game thread
-	// For background thread analysis, return 0 or use a different approach
-	return 0.0f;
+	FObjectSizeInfo Info;
+	if (IsInGameThread())
+	{
+		Info = SizeCache.GetOrMeasure(Object);
+	}
+	else if (!SizeCache.Find(FSoftObjectPath(Object), Info))
+	{
+		// GetResourceSizeEx must be called on game thread; objects not measured before the task started count as 0
+		return 0.0f;
+	}
+
+	return static_cast<float>(Mode == EResourceSizeMode::EstimatedTotal ? Info.EstimatedTotalBytes : Info.ExclusiveBytes);
 }
 
-void FMemoryAnalyzer::BuildReferenceTree(UObject* RootObject, TSharedPtr<FReferenceNode> ParentNode, TSet<UObject*>& VisitedObjects, int32 CurrentDepth, int32 MaxDepth)
+void FMemoryAnalyzer::GatherSizePrewarmPaths(UBlueprint* Blueprint, TArray<FSoftObjectPath>& OutObjectPaths) const
 {
-	if (!RootObject || !ParentNode.IsValid() || CurrentDepth >= MaxDepth || VisitedObjects.Contains(RootObject))
+	if (!Blueprint)
 	{
 		return;
 	}
 
-	VisitedObjects.Add(RootObject);
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
 
-	// Find objects referenced by this object
-	TArray<UObject*> ReferencedObjects;
-	
-	// This is a simplified reference finding - real implementation would use FReferenceFinder
-	// For now, we'll just add some mock references for demonstration
-	
-	if (CurrentDepth < 2) // Limit depth for demo
+	// 蓝图包本身及其硬依赖闭包；引用链上的对象基本都在这些包中
+	TSet<FName> VisitedPackages;
+	TArray<FName> PackageQueue;
+	const FName BlueprintPackageName = Blueprint->GetPackage()->GetFName();
+	PackageQueue.Add(BlueprintPackageName);
+	VisitedPackages.Add(BlueprintPackageName);
+
+	for (int32 QueueIndex = 0; QueueIndex < PackageQueue.Num(); ++QueueIndex)
 	{
-		// Add some mock child references
-		for (int32 i = 0; i < FMath::RandRange(0, 3); ++i)
+		const FName PackageName = PackageQueue[QueueIndex];
+
+		if (UPackage* Package = FindPackage(nullptr, *PackageName.ToString()))
 		{
-			TSharedPtr<FReferenceNode> ChildNode = MakeShared<FReferenceNode>();
-			ChildNode->Object = RootObject; // Mock reference
-			ChildNode->ObjectName = FString::Printf(TEXT("Child_%d"), i);
-			ChildNode->ObjectType = TEXT("MockObject");
-			ChildNode->ObjectSize = FMath::RandRange(1000.0f, 10000.0f);
-			
-			ParentNode->Children.Add(ChildNode);
+			// Loaded: measure every object of the package
+			TArray<UObject*> PackageObjects;
+			GetObjectsWithPackage(Package, PackageObjects, false);
+			for (UObject* PackageObject : PackageObjects)
+			{
+				OutObjectPaths.Emplace(PackageObject);
+			}
+		}
+		else
+		{
+			// Unloaded: the assets fall back to the package size on disk
+			TArray<FAssetData> PackageAssets;
+			AssetRegistry.GetAssetsByPackageName(PackageName, PackageAssets);
+			for (const FAssetData& AssetData : PackageAssets)
+			{
+				OutObjectPaths.Add(AssetData.GetSoftObjectPath());
+			}
+		}
+
+		TArray<FName> Dependencies;
+		AssetRegistry.GetDependencies(PackageName, Dependencies, UE::AssetRegistry::EDependencyCategory::Package, UE::AssetRegistry::EDependencyQuery::Hard);
+		for (const FName& Dependency : Dependencies)
+		{
+			if (!FPackageName::IsScriptPackage(Dependency.ToString()) && !VisitedPackages.Contains(Dependency))
+			{
+				VisitedPackages.Add(Dependency);
+				PackageQueue.Add(Dependency);
+			}
 		}
 	}
 }
@@ -635,45 +892,86 @@ bool FMemoryAnalyzer::IsLargeResource(UObject* Object, float ThresholdMB) const
 		return false;
 	}
 
-	float SizeMB = CalculateObjectSize(Object) / (1024.0f * 1024.0f);
-	
+	float SizeMB = CalculateObjectSize(Object, EResourceSizeMode::EstimatedTotal) / (1024.0f * 1024.0f);
+
+	// Textures: Check for 2048x2048 or larger (as per requirements)
+	if (UTexture2D* Texture = Cast<UTexture2D>(Object))
+	{
+		return (Texture->GetSizeX() >= 2048 && Texture->GetSizeY() >= 2048) || SizeMB >= ThresholdMB;
+	}
+
 	// Apply different thresholds based on asset type
-	if (Object->IsA<UTexture2D>())
+	return SizeMB >= ThresholdMB * GetLargeResourceThresholdScale(Object->GetClass());
+}
+
+float FMemoryAnalyzer::GetLargeResourceThresholdScale(const UClass* AssetClass)
+{
+	if (!AssetClass)
 	{
-		// Textures: Check for 2048x2048 or larger (as per requirements)
-		if (UTexture2D* Texture = Cast<UTexture2D>(Object))
-		{
-			return (Texture->GetSizeX() >= 2048 && Texture->GetSizeY() >= 2048) || SizeMB >= ThresholdMB;
-		}
+		return 1.0f;
 	}
-	else if (Object->IsA<UStaticMesh>())
+
+	if (AssetClass->IsChildOf<UStaticMesh>() || AssetClass->IsChildOf<USkeletalMesh>() || AssetClass->IsChildOf<UAnimSequence>())
 	{
-		// Static meshes: Use size threshold
-		return SizeMB >= (ThresholdMB * 0.5f); // Lower threshold for meshes
+		return 0.5f; // Lower threshold for meshes and animations
 	}
-	else if (Object->IsA<USkeletalMesh>())
+	if (AssetClass->IsChildOf<USoundWave>())
 	{
-		// Skeletal meshes: Use size threshold
-		return SizeMB >= (ThresholdMB * 0.5f); // Lower threshold for skeletal meshes
+		return 2.0f; // Higher threshold for audio
 	}
-	else if (Object->IsA<USoundWave>())
+	if (AssetClass->IsChildOf<UParticleSystem>())
 	{
-		// Audio: Use size threshold
-		return SizeMB >= (ThresholdMB * 2.0f); // Higher threshold for audio
+		return 0.25f; // Lower threshold for particles
 	}
-	else if (Object->IsA<UParticleSystem>())
+
+	// Default threshold for other asset types
+	return 1.0f;
+}
+
+FLargeResourceRules FLargeResourceRules::Gather()
+{
+	check(IsInGameThread());
+
+	FLargeResourceRules Rules;
+	for (TObjectIterator<UClass> It; It; ++It)
 	{
-		// Particle systems: Use size threshold
-		return SizeMB >= (ThresholdMB * 0.25f); // Lower threshold for particles
+		const UClass* Class = *It;
+		if (Class->IsChildOf<UTexture2D>())
+		{
+			Rules.TextureClasses.Add(Class->GetClassPathName());
+		}
+
+		const float Scale = FMemoryAnalyzer::GetLargeResourceThresholdScale(Class);
+		if (Scale != 1.0f)
+		{
+			Rules.ClassThresholdScales.Add(Class->GetClassPathName(), Scale);
+		}
 	}
-	else if (Object->IsA<UAnimSequence>())
+	return Rules;
+}
+
+bool FLargeResourceRules::IsLarge(const FAssetData& AssetData, int64 SizeBytes, float ThresholdMB) const
+{
+	const float SizeMB = SizeBytes / (1024.0f * 1024.0f);
+
+	if (TextureClasses.Contains(AssetData.AssetClassPath))
 	{
-		// Animation sequences: Use size threshold
-		return SizeMB >= (ThresholdMB * 0.5f); // Lower threshold for animations
+		// 纹理尺寸来自注册表标签（"2048x2048"），无需加载
+		FString Dimensions;
+		FString Width;
+		FString Height;
+		if (AssetData.GetTagValue(TEXT("Dimensions"), Dimensions) && Dimensions.Split(TEXT("x"), &Width, &Height))
+		{
+			if (FCString::Atoi(*Width) >= 2048 && FCString::Atoi(*Height) >= 2048)
+			{
+				return true;
+			}
+		}
+		return SizeMB >= ThresholdMB;
 	}
-	
-	// Default threshold for other asset types
-	return SizeMB >= ThresholdMB;
+
+	const float* Scale = ClassThresholdScales.Find(AssetData.AssetClassPath);
+	return SizeMB >= ThresholdMB * (Scale ? *Scale : 1.0f);
 }
 
 FString FMemoryAnalyzer::GetObjectTypeName(UObject* Object) const
@@ -688,6 +986,7 @@ FString FMemoryAnalyzer::GetObjectTypeName(UObject* Object) const
 
 void FMemoryAnalyzer::CompleteAnalysis(UBlueprint* Blueprint, const FMemoryAnalysisResult& Result)
 {
+	if (Blueprint)
 	{
 		FScopeLock Lock(&ResultsLock);
 		AnalysisResults.Add(TWeakObjectPtr<UObject>(Blueprint), Result);
@@ -704,7 +1003,12 @@ void FMemoryAnalyzer::CompleteAnalysis(UBlueprint* Blueprint, const FMemoryAnaly
 	OnAnalysisComplete.Broadcast(Result);
 
 	UE_LOG(LogTemp, Log, TEXT("Memory analysis completed for blueprint: %s (Size: %.2f MB)"), 
-		*Blueprint->GetName(), Result.InclusiveSize);
+		Blueprint ? *Blueprint->GetName() : TEXT("(unloaded)"), Result.InclusiveSize);
+
+	if (Blueprint && Result.bPackageSizesPending)
+	{
+		RequestDominatorTree();
+	}
 }
 
 TArray<FLargeResourceReference> FMemoryAnalyzer::DetectLargeResourceAlerts(UBlueprint* Blueprint, float SizeThresholdMB) const
@@ -796,97 +1100,118 @@ void FMemoryAnalyzer::AnalyzeAssetReferenceCounts()
 
 	bAnalysisInProgress = true;
 	bCancelRequested = false;
-	AssetReferenceCounts.Empty();
 
-	UE_LOG(LogTemp, Log, TEXT("Starting asset reference count analysis..."));
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	if (AssetRegistry.IsLoadingAssets())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Asset registry is still discovering assets; reference counts will be incomplete"));
+	}
 
-	// Find all assets in the project (on game thread)
-	TArray<UObject*> AllAssets;
-	FindAllAssets(AllAssets);
+	UE_LOG(LogTemp, Log, TEXT("Starting asset reference count analysis..."));
+	OnAnalysisProgress.Broadcast(0.0f);
 
-	UE_LOG(LogTemp, Log, TEXT("Found %d assets to analyze"), AllAssets.Num());
+	// Snapshot the registry graph and count referencers on a worker; no asset is loaded
+	IAssetRegistry* AssetRegistryPtr = &AssetRegistry;
+	LaunchBackgroundTask(TEXT("MemoryAnalyzerReferenceCounts"), [this, AssetRegistryPtr]()
+	{
+		TSharedRef<FAssetDependencyGraph> Graph = MakeShared<FAssetDependencyGraph>();
+		if (Graph->Build(*AssetRegistryPtr, &bCancelRequested))
+		{
+			PendingReferenceCounts = ComputeReferenceCounts(*Graph, &SizeCache);
+			PendingDependencyGraph = Graph;
+		}
+	}, [this]()
+	{
+		CompleteReferenceCountAnalysis();
+	});
+}
 
-	// Store assets for processing
-	PendingAssets = AllAssets;
-	CurrentAssetIndex = 0;
-	ReferenceCountMap.Empty();
+void FMemoryAnalyzer::LaunchBackgroundTask(const TCHAR* DebugName, TUniqueFunction<void()>&& Work, TUniqueFunction<void()>&& OnComplete)
+{
+	OnBackgroundTaskComplete = MoveTemp(OnComplete);
+	BackgroundTask = UE::Tasks::Launch(DebugName, MoveTemp(Work), UE::Tasks::ETaskPriority::BackgroundNormal);
 
-	// Start processing on next tick
-	FTimerHandle TimerHandle;
-	GEditor->GetTimerManager()->SetTimer(TimerHandle, [this]()
-	{
-		ProcessNextAssetBatch();
-	}, 0.01f, false);
+	BackgroundTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateRaw(this, &FMemoryAnalyzer::TickBackgroundTask));
 }
 
-void FMemoryAnalyzer::ProcessNextAssetBatch()
+bool FMemoryAnalyzer::TickBackgroundTask(float DeltaTime)
 {
-	if (bCancelRequested)
+	if (!BackgroundTask.IsCompleted())
 	{
-		CompleteReferenceCountAnalysis();
-		return;
+		return true;
+	}
+
+	BackgroundTickerHandle.Reset();
+	if (TUniqueFunction<void()> OnComplete = MoveTemp(OnBackgroundTaskComplete))
+	{
+		OnComplete();
 	}
+	return false;
+}
 
-	// Process a small batch of assets per frame to avoid blocking
-	int32 BatchSize = 10;
-	int32 ProcessedInBatch = 0;
+TArray<FAssetReferenceCount> FMemoryAnalyzer::ComputeReferenceCounts(const FAssetDependencyGraph& Graph, const FObjectSizeCache* SizeCache)
+{
+	TArray<FAssetReferenceCount> ReferenceCounts;
+	ReferenceCounts.SetNum(Graph.Num());
 
-	while (CurrentAssetIndex < PendingAssets.Num() && ProcessedInBatch < BatchSize)
+	ParallelFor(TEXT("ComputeReferenceCounts"), Graph.Num(), 512, [&Graph, SizeCache, &ReferenceCounts](int32 PackageIndex)
 	{
-		UObject* Asset = PendingAssets[CurrentAssetIndex];
-		if (Asset)
+		FAssetReferenceCount& RefCount = ReferenceCounts[PackageIndex];
+		const FAssetData& AssetData = Graph.GetPrimaryAsset(PackageIndex);
+		const FName PackageName = Graph.GetPackageName(PackageIndex);
+
+		if (AssetData.IsValid())
+		{
+			RefCount.AssetPath = AssetData.GetObjectPathString();
+			RefCount.AssetName = AssetData.AssetName.ToString();
+			RefCount.AssetType = AssetData.AssetClassPath.GetAssetName().ToString();
+		}
+		else
 		{
-			CountAssetReferences(Asset, ReferenceCountMap);
+			RefCount.AssetPath = PackageName.ToString();
+			RefCount.AssetName = FPackageName::GetShortName(PackageName);
 		}
 
-		CurrentAssetIndex++;
-		ProcessedInBatch++;
-	}
+		RefCount.AssetSize = static_cast<float>(GetPackageSizeBytes(Graph, PackageIndex, SizeCache)) / (1024.0f * 1024.0f);
 
-	// Update progress
-	if (OnAnalysisProgress.IsBound())
-	{
-		float Progress = (float)CurrentAssetIndex / (float)PendingAssets.Num();
-		OnAnalysisProgress.Broadcast(Progress);
-	}
+		const TConstArrayView<int32> Referencers = Graph.GetReferencers(PackageIndex);
+		RefCount.ReferenceCount = Referencers.Num();
+		RefCount.ReferencedBy.Reserve(Referencers.Num());
+		for (int32 ReferencerIndex : Referencers)
+		{
+			RefCount.ReferencedBy.Add(Graph.GetPackageName(ReferencerIndex).ToString());
+		}
+	}, EParallelForFlags::BackgroundPriority);
 
-	// Check if we're done
-	if (CurrentAssetIndex >= PendingAssets.Num())
+	// 引用数相同时按路径排序，结果与线程调度无关
+	ReferenceCounts.Sort([](const FAssetReferenceCount& A, const FAssetReferenceCount& B)
 	{
-		CompleteReferenceCountAnalysis();
-	}
-	else
-	{
-		// Schedule next batch
-		FTimerHandle TimerHandle;
-		GEditor->GetTimerManager()->SetTimer(TimerHandle, [this]()
-		{
-			ProcessNextAssetBatch();
-		}, 0.01f, false);
-	}
+		return A.ReferenceCount != B.ReferenceCount ? A.ReferenceCount > B.ReferenceCount : A.AssetPath < B.AssetPath;
+	});
+
+	return ReferenceCounts;
 }
 
 void FMemoryAnalyzer::CompleteReferenceCountAnalysis()
 {
-	FScopeLock Lock(&ResultsLock);
-
-	// Convert map to array and sort
-	for (const auto& Pair : ReferenceCountMap)
 	{
-		AssetReferenceCounts.Add(Pair.Value);
-	}
-
-	// Sort by reference count (descending)
-	AssetReferenceCounts.Sort();
+		FScopeLock Lock(&ResultsLock);
+		AssetReferenceCounts = MoveTemp(PendingReferenceCounts);
+		PendingReferenceCounts.Reset();
 
-	PendingAssets.Empty();
-	ReferenceCountMap.Empty();
-	CurrentAssetIndex = 0;
+		if (PendingDependencyGraph.IsValid())
+		{
+			DependencyGraph = MoveTemp(PendingDependencyGraph);
+		}
+	}
 
 	bAnalysisInProgress = false;
 	bCancelRequested = false;
 
-	UE_LOG(LogTemp, Log, TEXT("Asset reference count analysis complete. Found %d referenced assets"), AssetReferenceCounts.Num());
+	UE_LOG(LogTemp, Log, TEXT("Asset reference count analysis complete. Found %d assets"), AssetReferenceCounts.Num());
+
+	OnAnalysisProgress.Broadcast(1.0f);
 
 	// Broadcast completion
 	FMemoryAnalysisResult DummyResult;
@@ -914,85 +1239,215 @@ TArray<FAssetReferenceCount> FMemoryAnalyzer::GetTopReferencedAssets(int32 Count
 	return TopAssets;
 }
 
+int32 FMemoryAnalyzer::GetNumAssetReferenceCounts() const
+{
+	FScopeLock Lock(&ResultsLock);
+	return AssetReferenceCounts.Num();
+}
+
 void FMemoryAnalyzer::ClearReferenceCountData()
 {
 	FScopeLock Lock(&ResultsLock);
 	AssetReferenceCounts.Empty();
 }
 
-void FMemoryAnalyzer::FindAllAssets(TArray<UObject*>& OutAssets)
+TSharedPtr<const FAssetDependencyGraph> FMemoryAnalyzer::GetDependencyGraph() const
+{
+	FScopeLock Lock(&ResultsLock);
+	return DependencyGraph;
+}
+
+void FMemoryAnalyzer::AuditBlueprints(const TArray<FString>& PackagePaths)
 {
-	// Find all assets using UObject iterator
-	for (TObjectIterator<UObject> It; It; ++It)
+	if (bAnalysisInProgress)
 	{
-		UObject* Object = *It;
-		if (!Object)
+		UE_LOG(LogTemp, Warning, TEXT("Analysis already in progress"));
+		return;
+	}
+
+	bAnalysisInProgress = true;
+	bCancelRequested = false;
+
+	// 注册表查询和类阈值在游戏线程上准备，后台只读取快照
+	FARFilter Filter;
+	Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+	Filter.bRecursiveClasses = true;
+	Filter.bRecursivePaths = true;
+	Filter.bIncludeOnlyOnDiskAssets = true;
+	for (const FString& PackagePath : PackagePaths)
+	{
+		Filter.PackagePaths.Add(FName(*PackagePath));
+	}
+	if (Filter.PackagePaths.Num() == 0)
+	{
+		Filter.PackagePaths.Add(TEXT("/Game"));
+	}
+
+	TArray<FAssetData> BlueprintAssets;
+	FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get().GetAssets(Filter, BlueprintAssets);
+
+	TArray<FName> BlueprintPackageNames;
+	BlueprintPackageNames.Reserve(BlueprintAssets.Num());
+	for (const FAssetData& AssetData : BlueprintAssets)
+	{
+		BlueprintPackageNames.AddUnique(AssetData.PackageName);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("Starting memory audit of %d blueprints..."), BlueprintPackageNames.Num());
+	OnAnalysisProgress.Broadcast(0.0f);
+
+	LaunchBackgroundTask(TEXT("MemoryAnalyzerAudit"),
+		[this, BlueprintPackageNames = MoveTemp(BlueprintPackageNames), Rules = FLargeResourceRules::Gather(), ThresholdMB = LargeResourceThresholdMB]()
+	{
+		const TSharedPtr<const FAssetDominatorTree> DominatorTreePtr = GetOrBuildDominatorTree(&bCancelRequested);
+		if (!DominatorTreePtr.IsValid() || bCancelRequested)
 		{
-			continue;
+			return;
 		}
 
-		// Only include assets (not transient objects)
-		if (Object->IsAsset() && IsValid(Object))
+		TArray<int32> BlueprintPackages;
+		BlueprintPackages.Reserve(BlueprintPackageNames.Num());
+		for (const FName& PackageName : BlueprintPackageNames)
 		{
-			OutAssets.Add(Object);
+			const int32 PackageIndex = DominatorTreePtr->GetGraph()->FindPackage(PackageName);
+			if (PackageIndex != INDEX_NONE)
+			{
+				BlueprintPackages.Add(PackageIndex);
+			}
 		}
-	}
+
+		PendingAuditEntries = ComputeMemoryAudit(*DominatorTreePtr, BlueprintPackages, Rules, ThresholdMB, &bCancelRequested);
+	}, [this]()
+	{
+		CompleteMemoryAudit();
+	});
 }
 
-void FMemoryAnalyzer::CountAssetReferences(UObject* Asset, TMap<FString, FAssetReferenceCount>& OutReferenceCounts)
+TArray<FBlueprintMemoryAuditEntry> FMemoryAnalyzer::ComputeMemoryAudit(const FAssetDominatorTree& DominatorTree, TConstArrayView<int32> BlueprintPackages,
+	const FLargeResourceRules& Rules, float ThresholdMB, const std::atomic<bool>* bCancelRequested)
 {
-	if (!Asset)
-	{
-		return;
-	}
+	const FAssetDependencyGraph& Graph = *DominatorTree.GetGraph();
 
-	// Count references for this asset
-	int32 ReferenceCount = CountAssetReferencesInternal(Asset);
+	TArray<FBlueprintMemoryAuditEntry> Entries;
+	Entries.SetNum(BlueprintPackages.Num());
 
-	FString AssetPath = Asset->GetPathName();
-	
-	// Create or update reference count entry
-	FAssetReferenceCount& RefCount = OutReferenceCounts.FindOrAdd(AssetPath);
-	RefCount.AssetPath = AssetPath;
-	RefCount.AssetName = Asset->GetName();
-	RefCount.AssetType = Asset->GetClass()->GetName();
-	RefCount.AssetSize = CalculateObjectSize(Asset) / (1024.0f * 1024.0f);
-	RefCount.ReferenceCount = ReferenceCount;
-}
+	// 每个工作线程一份按包索引的平铺父数组；访问代号标记属于当前蓝图的槽，换蓝图时无需清空
+	struct FAuditWorkerContext
+	{
+		TArray<int32> Parents;
+		TArray<uint32> VisitStamps;
+		TArray<int32> Queue;
+		uint32 Stamp = 0;
+	};
+	TArray<FAuditWorkerContext> WorkerContexts;
 
-int32 FMemoryAnalyzer::CountAssetReferencesInternal(UObject* Asset)
-{
-	if (!Asset)
+	ParallelForWithTaskContext(TEXT("ComputeMemoryAudit"), WorkerContexts, BlueprintPackages.Num(), 16, [&](FAuditWorkerContext& Context, int32 EntryIndex)
 	{
-		return 0;
-	}
+		if (bCancelRequested && bCancelRequested->load(std::memory_order_relaxed))
+		{
+			return;
+		}
 
-	// Use asset registry to find referencers
-	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-	IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
+		const int32 BlueprintIndex = BlueprintPackages[EntryIndex];
+		FBlueprintMemoryAuditEntry& Entry = Entries[EntryIndex];
 
-	// Get package name from asset path
-	FString AssetPath = Asset->GetPathName();
-	FName PackageName = FName(*FPackageName::ObjectPathToPackageName(AssetPath));
-	
-	if (PackageName.IsNone())
+		const FAssetData& BlueprintAsset = Graph.GetPrimaryAsset(BlueprintIndex);
+		Entry.BlueprintPath = BlueprintAsset.IsValid() ? BlueprintAsset.GetObjectPathString() : Graph.GetPackageName(BlueprintIndex).ToString();
+		Entry.BlueprintName = FPackageName::GetShortName(Graph.GetPackageName(BlueprintIndex));
+		Entry.NumDirectHardReferences = Graph.GetHardDependencies(BlueprintIndex).Num();
+
+		// 广度优先遍历硬引用闭包；父索引用于还原大资源的引用路径
+		if (Context.VisitStamps.Num() != Graph.Num())
+		{
+			Context.Parents.SetNumUninitialized(Graph.Num());
+			Context.VisitStamps.SetNumZeroed(Graph.Num());
+		}
+		const uint32 Stamp = ++Context.Stamp;
+		TArray<int32>& Parents = Context.Parents;
+		TArray<uint32>& VisitStamps = Context.VisitStamps;
+		TArray<int32>& Queue = Context.Queue;
+		Queue.Reset();
+		Queue.Add(BlueprintIndex);
+		Parents[BlueprintIndex] = INDEX_NONE;
+		VisitStamps[BlueprintIndex] = Stamp;
+
+		int64 ReachableBytes = 0;
+		for (int32 QueueIndex = 0; QueueIndex < Queue.Num(); ++QueueIndex)
+		{
+			const int32 Current = Queue[QueueIndex];
+			const int64 PackageBytes = DominatorTree.GetPackageSize(Current);
+			ReachableBytes += PackageBytes;
+
+			if (Current != BlueprintIndex && Rules.IsLarge(Graph.GetPrimaryAsset(Current), PackageBytes, ThresholdMB))
+			{
+				TArray<FString> PathNames;
+				for (int32 PathIndex = Current; PathIndex != INDEX_NONE; PathIndex = Parents[PathIndex])
+				{
+					PathNames.Add(Graph.GetPackageName(PathIndex).ToString());
+				}
+				Algo::Reverse(PathNames);
+
+				const FAssetData& AssetData = Graph.GetPrimaryAsset(Current);
+				FLargeResourceReference& Reference = Entry.LargeReferences.AddDefaulted_GetRef();
+				Reference.AssetSize = PackageBytes / (1024.0f * 1024.0f);
+				Reference.AssetType = AssetData.IsValid() ? AssetData.AssetClassPath.GetAssetName().ToString() : FString();
+				Reference.ReferencePath = FString::Join(PathNames, TEXT(" -> "));
+			}
+
+			for (int32 DependencyIndex : Graph.GetHardDependencies(Current))
+			{
+				if (VisitStamps[DependencyIndex] != Stamp)
+				{
+					VisitStamps[DependencyIndex] = Stamp;
+					Parents[DependencyIndex] = Current;
+					Queue.Add(DependencyIndex);
+				}
+			}
+		}
+
+		const int64 RetainedBytes = DominatorTree.GetRetainedSize(BlueprintIndex);
+		Entry.ExclusiveSize = DominatorTree.GetPackageSize(BlueprintIndex) / (1024.0f * 1024.0f);
+		Entry.RetainedSize = RetainedBytes / (1024.0f * 1024.0f);
+		Entry.SharedSize = FMath::Max<int64>(ReachableBytes - RetainedBytes, 0) / (1024.0f * 1024.0f);
+		Entry.NumHardDependencies = Queue.Num() - 1;
+
+		Entry.LargeReferences.Sort([](const FLargeResourceReference& A, const FLargeResourceReference& B)
+		{
+			return A.AssetSize > B.AssetSize;
+		});
+	}, EParallelForFlags::BackgroundPriority);
+
+	if (bCancelRequested && bCancelRequested->load(std::memory_order_relaxed))
 	{
-		return 0;
+		return TArray<FBlueprintMemoryAuditEntry>();
 	}
 
-	// Get all assets that reference this asset
-	TArray<FAssetIdentifier> Referencers;
-	AssetRegistry.GetReferencers(PackageName, Referencers);
+	Entries.Sort([](const FBlueprintMemoryAuditEntry& A, const FBlueprintMemoryAuditEntry& B)
+	{
+		return A.RetainedSize != B.RetainedSize ? A.RetainedSize > B.RetainedSize : A.BlueprintPath < B.BlueprintPath;
+	});
+	return Entries;
+}
 
-	// Count valid referencers (excluding self-references)
-	int32 Count = 0;
-	for (const FAssetIdentifier& Referencer : Referencers)
+void FMemoryAnalyzer::CompleteMemoryAudit()
+{
 	{
-		if (!Referencer.PackageName.IsNone() && Referencer.PackageName != PackageName)
-		{
-			Count++;
-		}
+		FScopeLock Lock(&ResultsLock);
+		MemoryAuditResults = MoveTemp(PendingAuditEntries);
+		PendingAuditEntries.Reset();
 	}
 
-	return Count;
-}
\ No newline at end of file
+	bAnalysisInProgress = false;
+	bCancelRequested = false;
+
+	UE_LOG(LogTemp, Log, TEXT("Memory audit complete: %d blueprints ranked by retained size"), MemoryAuditResults.Num());
+
+	OnAnalysisProgress.Broadcast(1.0f);
+	OnMemoryAuditComplete.Broadcast(MemoryAuditResults);
+}
+
+TArray<FBlueprintMemoryAuditEntry> FMemoryAnalyzer::GetMemoryAuditResults() const
+{
+	FScopeLock Lock(&ResultsLock);
+	return MemoryAuditResults;
+}
@@ -0,0 +1,230 @@
+// Copyright xnbmy 2026. All Rights Reserved.
+
+#include "Analyzers/ObjectSizeCache.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeRWLock.h"
+#include "UObject/ObjectSaveContext.h"
+#include "UObject/Package.h"
+#include "UObject/PackageReload.h"
+#include "UObject/ResourceSize.h"
+#include "UObject/UObjectGlobals.h"
+
+FObjectSizeCache::FObjectSizeCache()
+{
+	PackageSavedHandle = UPackage::PackageSavedWithContextEvent.AddRaw(this, &FObjectSizeCache::HandlePackageSaved);
+	PackageReloadedHandle = FCoreUObjectDelegates::OnPackageReloaded.AddRaw(this, &FObjectSizeCache::HandlePackageReloaded);
+}
+
+FObjectSizeCache::~FObjectSizeCache()
+{
+	CancelRequests();
+
+	UPackage::PackageSavedWithContextEvent.Remove(PackageSavedHandle);
+	FCoreUObjectDelegates::OnPackageReloaded.Remove(PackageReloadedHandle);
+}
+
+bool FObjectSizeCache::Find(const FSoftObjectPath& ObjectPath, FObjectSizeInfo& OutInfo) const
+{
+	FReadScopeLock ReadLock(SizesLock);
+	if (const FObjectSizeInfo* Info = Sizes.Find(ObjectPath))
+	{
+		OutInfo = *Info;
+		return true;
+	}
+	return false;
+}
+
+FObjectSizeInfo FObjectSizeCache::GetOrMeasure(UObject* Object)
+{
+	check(IsInGameThread());
+
+	if (!Object)
+	{
+		return FObjectSizeInfo();
+	}
+
+	const FSoftObjectPath ObjectPath(Object);
+
+	FObjectSizeInfo Info;
+	if (Find(ObjectPath, Info) && !Info.bFromDisk)
+	{
+		return Info;
+	}
+
+	// 之前未加载时记录的是磁盘大小，对象现在已加载则改为实测
+	Info = Measure(Object);
+	Store(ObjectPath, Info);
+	return Info;
+}
+
+FObjectSizeInfo FObjectSizeCache::GetOrMeasure(const FSoftObjectPath& ObjectPath)
+{
+	check(IsInGameThread());
+
+	if (UObject* Object = ObjectPath.ResolveObject())
+	{
+		return GetOrMeasure(Object);
+	}
+
+	FObjectSizeInfo Info;
+	if (Find(ObjectPath, Info))
+	{
+		return Info;
+	}
+
+	const int64 DiskSize = GetPackageDiskSize(ObjectPath.GetLongPackageFName());
+	Info.ExclusiveBytes = FMath::Max<int64>(DiskSize, 0);
+	Info.EstimatedTotalBytes = Info.ExclusiveBytes;
+	Info.bFromDisk = true;
+
+	// 注册表不认识的包不缓存，资产稍后被注册或加载时可以再取到大小
+	if (DiskSize != INDEX_NONE)
+	{
+		Store(ObjectPath, Info);
+	}
+	return Info;
+}
+
+void FObjectSizeCache::RequestSizes(TArray<FSoftObjectPath>&& ObjectPaths, TFunction<void()>&& OnComplete)
+{
+	check(IsInGameThread());
+
+	FSizeRequest& Request = PendingRequests.AddDefaulted_GetRef();
+	Request.ObjectPaths = MoveTemp(ObjectPaths);
+	Request.OnComplete = MoveTemp(OnComplete);
+
+	if (!RequestTickerHandle.IsValid())
+	{
+		RequestTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateRaw(this, &FObjectSizeCache::TickRequests));
+	}
+}
+
+void FObjectSizeCache::CancelRequests()
+{
+	PendingRequests.Empty();
+
+	if (RequestTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(RequestTickerHandle);
+		RequestTickerHandle.Reset();
+	}
+}
+
+bool FObjectSizeCache::TickRequests(float DeltaTime)
+{
+	const double EndTime = FPlatformTime::Seconds() + MaxMeasureSecondsPerTick;
+
+	// 至少处理一个对象，保证单个大资产也能推进
+	bool bMeasuredAny = false;
+	while (PendingRequests.Num() > 0 && (!bMeasuredAny || FPlatformTime::Seconds() < EndTime))
+	{
+		FSizeRequest& Request = PendingRequests[0];
+		if (Request.ObjectPaths.IsValidIndex(Request.NextIndex))
+		{
+			GetOrMeasure(Request.ObjectPaths[Request.NextIndex++]);
+			bMeasuredAny = true;
+			continue;
+		}
+
+		// 回调可能发起新的请求，先出队再调用
+		TFunction<void()> OnComplete = MoveTemp(Request.OnComplete);
+		PendingRequests.RemoveAt(0);
+		if (OnComplete)
+		{
+			OnComplete();
+		}
+	}
+
+	if (PendingRequests.Num() == 0)
+	{
+		RequestTickerHandle.Reset();
+		return false;
+	}
+	return true;
+}
+
+void FObjectSizeCache::Store(const FSoftObjectPath& ObjectPath, const FObjectSizeInfo& Info)
+{
+	FWriteScopeLock WriteLock(SizesLock);
+	Sizes.Add(ObjectPath, Info);
+}
+
+void FObjectSizeCache::Invalidate(FName PackageName)
+{
+	if (PackageName.IsNone())
+	{
+		return;
+	}
+
+	FWriteScopeLock WriteLock(SizesLock);
+	for (auto It = Sizes.CreateIterator(); It; ++It)
+	{
+		if (It.Key().GetLongPackageFName() == PackageName)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void FObjectSizeCache::Empty()
+{
+	FWriteScopeLock WriteLock(SizesLock);
+	Sizes.Empty();
+}
+
+int32 FObjectSizeCache::Num() const
+{
+	FReadScopeLock ReadLock(SizesLock);
+	return Sizes.Num();
+}
+
+FObjectSizeInfo FObjectSizeCache::Measure(UObject* Object)
+{
+	check(IsInGameThread());
+
+	FObjectSizeInfo Info;
+	if (!Object)
+	{
+		return Info;
+	}
+
+	FResourceSizeEx ExclusiveSize(EResourceSizeMode::Exclusive);
+	Object->GetResourceSizeEx(ExclusiveSize);
+	Info.ExclusiveBytes = ExclusiveSize.GetTotalMemoryBytes();
+
+	FResourceSizeEx TotalSize(EResourceSizeMode::EstimatedTotal);
+	Object->GetResourceSizeEx(TotalSize);
+	Info.EstimatedTotalBytes = FMath::Max(TotalSize.GetTotalMemoryBytes(), Info.ExclusiveBytes);
+
+	return Info;
+}
+
+int64 FObjectSizeCache::GetPackageDiskSize(FName PackageName)
+{
+	if (PackageName.IsNone())
+	{
+		return INDEX_NONE;
+	}
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	const TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(PackageName);
+	return PackageData.IsSet() ? PackageData->DiskSize : INDEX_NONE;
+}
+
+void FObjectSizeCache::HandlePackageSaved(const FString& PackageFileName, UPackage* Package, FObjectPostSaveContext ObjectSaveContext)
+{
+	if (Package)
+	{
+		Invalidate(Package->GetFName());
+	}
+}
+
+void FObjectSizeCache::HandlePackageReloaded(EPackageReloadPhase Phase, FPackageReloadedEvent* Event)
+{
+	if (Phase == EPackageReloadPhase::PostPackageFixup && Event && Event->GetNewPackage())
+	{
+		Invalidate(Event->GetNewPackage()->GetFName());
+	}
+}
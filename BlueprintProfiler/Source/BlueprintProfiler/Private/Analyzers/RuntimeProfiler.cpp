@@ -1,6 +1,8 @@
 // Copyright xnbmy 2026. All Rights Reserved.
 
 #include "Analyzers/RuntimeProfiler.h"
+#include "Analyzers/BlueprintProfilerTrace.h"
+#include "Analyzers/BlueprintProfilerStats.h"
 #include "Engine/Blueprint.h"
 #include "EdGraph/EdGraph.h"
 #include "EdGraph/EdGraphNode.h"
@@ -23,6 +25,7 @@
 #include "Serialization/JsonSerializer.h"
 #include "Serialization/JsonWriter.h"
 #include "Misc/FileHelper.h"
+#include "HAL/FileManager.h"
 #include "Misc/Paths.h"
 #include "Misc/DateTime.h"
 #include "Stats/Stats2.h"
@@ -31,16 +34,538 @@
 #include "Stats/StatsData.h"
 #include "TimerManager.h"
 #include "UObject/Script.h"
+#include "UObject/Stack.h"
+#include "Misc/ScopeRWLock.h"
 #include "Blueprint/BlueprintExceptionInfo.h"
 #include "Kismet2/KismetDebugUtilities.h"
 #include "Kismet2/Breakpoint.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "Async/Async.h"
+#include "Containers/Ticker.h"
+#include <atomic>
 
 // Stats for blueprint profiling
-DECLARE_STATS_GROUP(TEXT("BlueprintProfiler"), STATGROUP_BlueprintProfiler, STATCAT_Advanced);
 DECLARE_CYCLE_STAT(TEXT("Blueprint Function Execution"), STAT_BlueprintFunctionExecution, STATGROUP_BlueprintProfiler);
 
+namespace BlueprintProfilerTiming
+{
+	/** 影子栈上的一个打开的节点（或事件/函数作用域标记） */
+	struct FOpenNodeFrame
+	{
+		TWeakObjectPtr<UObject> NodeKey;
+		uint32 NodeId = FNodeStatsTable::InvalidId;
+		uint64 FrameNumber = 0;
+		uint64 StartCycles = 0;
+		uint64 ChildCycles = 0;
+		bool bPure = false;
+		bool bScope = false;
+		bool bSampled = true;  // 采样模式下未被选中的节点只参与父节点的子耗时
+		bool bTraced = false;  // 已向 Insights 写出开始事件，出栈时必须写出结束事件
+	};
+
+	/**
+	 * Per-thread shadow stack - pairs NodeEntry with NodeExit/PopState on the thread that executed the script.
+	 * Script may run on worker threads, so every thread keeps its own stack and no lock is needed to pair events.
+	 */
+	struct FShadowStack
+	{
+		TArray<FOpenNodeFrame, TInlineAllocator<32>> Frames;
+		uint32 Epoch = 0;
+
+		// 断点追踪路径：同一脚本帧内上一个追踪点
+		const FFrame* LastTraceFrame = nullptr;
+		const UObject* LastTraceObject = nullptr;
+		uint64 LastTraceFrameCounter = 0;
+		uint64 LastTraceCycles = 0;
+		TWeakObjectPtr<UObject> LastTraceKey;
+		uint32 LastTraceNodeId = FNodeStatsTable::InvalidId;
+
+		// 采样模式：距下一个被记录事件的剩余计数和线程私有的随机状态
+		uint32 SampleCountdown = 0;
+		uint32 SampleRandom = 0;
+	};
+
+	// 缺失退出事件时防止影子栈无限增长
+	constexpr int32 MaxShadowStackDepth = 256;
+
+	/** Drops all open frames, closing their Insights spans so the thread's trace timeline stays balanced */
+	static void ResetShadowFrames(FShadowStack& ShadowStack)
+	{
+		for (int32 Index = ShadowStack.Frames.Num() - 1; Index >= 0; --Index)
+		{
+			if (ShadowStack.Frames[Index].bTraced)
+			{
+				BlueprintProfilerTrace::EndNode();
+			}
+		}
+		ShadowStack.Frames.Reset();
+	}
+
+	// 每次开始/暂停录制时递增，各线程据此丢弃上一段录制中未配对的节点
+	static std::atomic<uint32> GTimingEpoch(1);
+
+	// 每次发布追踪点快照时递增；所有实例共用，线程缓存换实例时不会误用旧版本号
+	static std::atomic<uint32> GTraceNodeLookupVersion(1);
+
+	enum class EProfilerEventType : uint8
+	{
+		NodeEntry,   // 节点被执行一次（计数 + 首次缓存名称）
+		NodeTiming   // 一次配对完成的实测耗时
+	};
+
+	/** Compact POD event written by the instrumentation hot path and folded into NodeStats by the drain */
+	struct FProfilerEvent
+	{
+		// 追踪点路径在建立时已分配 ID；仪表化路径的上下文对象由 drain 负责分配
+		TWeakObjectPtr<UObject> NodeKey;
+		uint32 NodeId = FNodeStatsTable::InvalidId;
+		uint64 FrameNumber = 0;  // 节点开始时的 GFrameCounter
+		uint64 StartCycles = 0;
+		uint64 InclusiveCycles = 0;
+		uint64 ExclusiveCycles = 0;
+		EProfilerEventType Type = EProfilerEventType::NodeEntry;
+	};
+
+	/**
+	 * Single-producer/single-consumer ring buffer - the owning script thread pushes, the game thread drains.
+	 * When the drain falls behind, new events are dropped and counted instead of blocking the script thread.
+	 */
+	class FProfilerEventRing
+	{
+	public:
+		static constexpr uint32 Capacity = FRuntimeProfiler::EventBufferCapacity; // 必须是 2 的幂
+		static_assert((Capacity & (Capacity - 1)) == 0, "Event ring capacity must be a power of two");
+
+		bool Push(const FProfilerEvent& Event)
+		{
+			const uint32 Write = WriteIndex.load(std::memory_order_relaxed);
+			const uint32 Read = ReadIndex.load(std::memory_order_acquire);
+			if (Write - Read >= Capacity)
+			{
+				DroppedEvents.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			}
+
+			Events[Write & (Capacity - 1)] = Event;
+			WriteIndex.store(Write + 1, std::memory_order_release);
+			return true;
+		}
+
+		template <typename FunctorType>
+		uint32 Drain(FunctorType&& Functor)
+		{
+			const uint32 Read = ReadIndex.load(std::memory_order_relaxed);
+			const uint32 Write = WriteIndex.load(std::memory_order_acquire);
+			for (uint32 Index = Read; Index != Write; ++Index)
+			{
+				Functor(Events[Index & (Capacity - 1)]);
+			}
+			ReadIndex.store(Write, std::memory_order_release);
+			return Write - Read;
+		}
+
+		void Discard()
+		{
+			ReadIndex.store(WriteIndex.load(std::memory_order_acquire), std::memory_order_release);
+			DroppedEvents.store(0, std::memory_order_relaxed);
+		}
+
+		uint32 ConsumeDroppedEvents()
+		{
+			return DroppedEvents.exchange(0, std::memory_order_relaxed);
+		}
+
+		/** Owning thread exited: no more pushes, the ring is freed after its next drain */
+		void MarkOrphaned()
+		{
+			bOrphaned.store(true, std::memory_order_release);
+		}
+
+		bool IsOrphaned() const
+		{
+			return bOrphaned.load(std::memory_order_acquire);
+		}
+
+	private:
+		FProfilerEvent Events[Capacity];
+		alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint32> WriteIndex{0};
+		alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint32> ReadIndex{0};
+		std::atomic<uint32> DroppedEvents{0};
+		std::atomic<bool> bOrphaned{false};
+	};
+
+	// 所有线程的环形缓冲区；仅在线程首次记录和 drain 时加锁，录制热路径不触碰
+	static FCriticalSection GEventRingsLock;
+	static TArray<TUniquePtr<FProfilerEventRing>> GEventRings;
+
+	/** Thread-local handle of the thread's ring; marks it orphaned when the thread exits */
+	struct FEventRingOwner
+	{
+		FProfilerEventRing* Ring = nullptr;
+
+		~FEventRingOwner()
+		{
+			if (Ring)
+			{
+				Ring->MarkOrphaned();
+			}
+		}
+	};
+
+	static FProfilerEventRing& GetEventRing()
+	{
+		static thread_local FEventRingOwner ThreadRing;
+		if (!ThreadRing.Ring)
+		{
+			// 缓冲区归注册表所有，线程退出后仍可被 drain，最后一次 drain 之后释放
+			TUniquePtr<FProfilerEventRing> NewRing = MakeUnique<FProfilerEventRing>();
+			ThreadRing.Ring = NewRing.Get();
+
+			FScopeLock Lock(&GEventRingsLock);
+			GEventRings.Add(MoveTemp(NewRing));
+		}
+		return *ThreadRing.Ring;
+	}
+
+	/** Visits every ring once; rings whose thread had exited before the visit are freed afterwards */
+	template <typename FunctorType>
+	static void ForEachEventRing(FunctorType&& Functor)
+	{
+		FScopeLock Lock(&GEventRingsLock);
+		for (int32 RingIndex = GEventRings.Num() - 1; RingIndex >= 0; --RingIndex)
+		{
+			// 先读孤立标志再 drain：标志之前的所有写入都会在这次访问中被读到
+			FProfilerEventRing& Ring = *GEventRings[RingIndex];
+			const bool bOrphaned = Ring.IsOrphaned();
+			Functor(Ring);
+			if (bOrphaned)
+			{
+				GEventRings.RemoveAtSwap(RingIndex, 1, EAllowShrinking::No);
+			}
+		}
+	}
+
+	static FShadowStack& GetShadowStack()
+	{
+		static thread_local FShadowStack ShadowStack;
+
+		const uint32 CurrentEpoch = GTimingEpoch.load(std::memory_order_relaxed);
+		if (ShadowStack.Epoch != CurrentEpoch)
+		{
+			ResetShadowFrames(ShadowStack);
+			ShadowStack = FShadowStack();
+			ShadowStack.Epoch = CurrentEpoch;
+		}
+		return ShadowStack;
+	}
+}
+
+//============================================================
+// FNodeStatsTable
+//============================================================
+
+uint32 FNodeStatsTable::Intern(const TWeakObjectPtr<UObject>& Object)
+{
+	if (const uint32* ExistingId = ObjectToId.Find(Object))
+	{
+		return *ExistingId;
+	}
+
+	const uint32 NewId = static_cast<uint32>(Objects.Add(Object));
+	ObjectToId.Add(Object, NewId);
+
+	ExecutionCounts.Add(0);
+	TimedExecutionCounts.Add(0);
+	InclusiveCycles.Add(0);
+	ExclusiveCycles.Add(0);
+	TotalExecutionTimes.Add(0.0f);
+	MinExecutionTimes.Add(FLT_MAX);
+	MaxExecutionTimes.Add(0.0f);
+	RecentExecutionTimes.AddDefaulted();
+	Histograms.AddDefaulted();
+	ChangedFlags.Add(false);
+	NodeNames.AddDefaulted();
+	BlueprintNames.AddDefaulted();
+	NodeGuids.AddDefaulted();
+
+	return NewId;
+}
+
+uint32 FNodeStatsTable::Find(const TWeakObjectPtr<UObject>& Object) const
+{
+	const uint32* ExistingId = ObjectToId.Find(Object);
+	return ExistingId ? *ExistingId : InvalidId;
+}
+
+void FNodeStatsTable::Reset()
+{
+	ObjectToId.Reset();
+	ExecutionCounts.Reset();
+	TimedExecutionCounts.Reset();
+	InclusiveCycles.Reset();
+	ExclusiveCycles.Reset();
+	TotalExecutionTimes.Reset();
+	MinExecutionTimes.Reset();
+	MaxExecutionTimes.Reset();
+	RecentExecutionTimes.Reset();
+	Histograms.Reset();
+	ChangedFlags.Reset();
+	ChangedIds.Reset();
+	Objects.Reset();
+	NodeNames.Reset();
+	BlueprintNames.Reset();
+	NodeGuids.Reset();
+}
+
+void FNodeStatsTable::AddTiming(uint32 Id, uint64 InInclusiveCycles, uint64 InExclusiveCycles)
+{
+	InclusiveCycles[Id] += InInclusiveCycles;
+	ExclusiveCycles[Id] += InExclusiveCycles;
+	TimedExecutionCounts[Id]++;
+	AddExecutionTime(Id, static_cast<float>(FPlatformTime::ToSeconds64(InInclusiveCycles)));
+}
+
+void FNodeStatsTable::AddExecutionTime(uint32 Id, float ExecutionTime)
+{
+	TotalExecutionTimes[Id] += ExecutionTime;
+	MinExecutionTimes[Id] = FMath::Min(MinExecutionTimes[Id], ExecutionTime);
+	MaxExecutionTimes[Id] = FMath::Max(MaxExecutionTimes[Id], ExecutionTime);
+	RecentExecutionTimes[Id].Add(ExecutionTime);
+	Histograms[Id].AddSeconds(ExecutionTime);
+	MarkChanged(Id);
+}
+
+float FNodeStatsTable::GetAverageExecutionTime(uint32 Id) const
+{
+	const int32 SampleCount = TimedExecutionCounts[Id] > 0 ? TimedExecutionCounts[Id] : ExecutionCounts[Id];
+	return SampleCount > 0 ? TotalExecutionTimes[Id] / SampleCount : 0.0f;
+}
+
+float FNodeStatsTable::GetTotalExclusiveTime(uint32 Id) const
+{
+	return static_cast<float>(FPlatformTime::ToSeconds64(ExclusiveCycles[Id]));
+}
+
+float FNodeStatsTable::GetAverageExclusiveTime(uint32 Id) const
+{
+	return TimedExecutionCounts[Id] > 0 ? GetTotalExclusiveTime(Id) / TimedExecutionCounts[Id] : 0.0f;
+}
+
+float FNodeStatsTable::GetExecutionsPerSecond(uint32 Id, float RecordingDuration) const
+{
+	return RecordingDuration > 0.0f ? ExecutionCounts[Id] / RecordingDuration : 0.0f;
+}
+
+FNodeExecutionStats FNodeStatsTable::GetStats(uint32 Id) const
+{
+	FNodeExecutionStats Stats;
+	Stats.ExecutionCount = ExecutionCounts[Id];
+	Stats.TimedExecutionCount = TimedExecutionCounts[Id];
+	Stats.InclusiveCycles = InclusiveCycles[Id];
+	Stats.ExclusiveCycles = ExclusiveCycles[Id];
+	Stats.TotalExecutionTime = TotalExecutionTimes[Id];
+	Stats.MinExecutionTime = MinExecutionTimes[Id];
+	Stats.MaxExecutionTime = MaxExecutionTimes[Id];
+	Stats.ExecutionTimes = RecentExecutionTimes[Id];
+	Stats.ExecutionTimeHistogram = Histograms[Id];
+	Stats.CachedNodeName = NodeNames[Id];
+	Stats.CachedBlueprintName = BlueprintNames[Id];
+	Stats.CachedNodeGuid = NodeGuids[Id];
+	return Stats;
+}
+
+void FNodeStatsTable::ConsumeChangedIds(TArray<uint32>& OutIds)
+{
+	// 交换数组，两边的内存都会被复用
+	OutIds.Reset();
+	Swap(OutIds, ChangedIds);
+	for (uint32 Id : OutIds)
+	{
+		ChangedFlags[Id] = false;
+	}
+}
+
+void FNodeStatsTable::SetNodeInfo(uint32 Id, const FString& NodeName, const FString& BlueprintName, const FGuid& NodeGuid)
+{
+	NodeNames[Id] = NodeName;
+	BlueprintNames[Id] = BlueprintName;
+	NodeGuids[Id] = NodeGuid;
+}
+
+//============================================================
+// FFrameCostStore
+//============================================================
+
+FFrameCostStore::FFrameRecord* FFrameCostStore::FindOpenFrame(uint64 FrameNumber)
+{
+	// 只有最近几帧可能仍在接收事件，从最新的往回找
+	for (int32 Index = Frames.Num() - 1; Index >= 0; --Index)
+	{
+		FFrameRecord& Record = Frames[(OldestIndex + Index) % Frames.Num()];
+		if (Record.FrameNumber == FrameNumber)
+		{
+			return Record.bComplete ? nullptr : &Record;
+		}
+		if (Record.FrameNumber < FrameNumber || Record.bComplete)
+		{
+			break;
+		}
+	}
+	return nullptr;
+}
+
+void FFrameCostStore::AddCost(uint64 FrameNumber, double Timestamp, uint32 NodeId, uint64 Cycles)
+{
+	FFrameRecord* Record = FindOpenFrame(FrameNumber);
+	if (!Record)
+	{
+		const bool bNewerFrame = Frames.Num() == 0 || GetFrame(Frames.Num() - 1).FrameNumber < FrameNumber;
+		if (!bNewerFrame)
+		{
+			return;
+		}
+
+		if (Frames.Num() < Capacity)
+		{
+			Record = &Frames.AddDefaulted_GetRef();
+		}
+		else
+		{
+			// 覆盖最旧的帧，复用其数组内存
+			Record = &Frames[OldestIndex];
+			OldestIndex = (OldestIndex + 1) % Capacity;
+			Record->NodeCycles.Reset();
+			Record->BlueprintCycles.Reset();
+		}
+
+		Record->FrameNumber = FrameNumber;
+		Record->Timestamp = Timestamp;
+		Record->TotalCycles = 0;
+		Record->bComplete = false;
+	}
+
+	if (NodeId >= static_cast<uint32>(NodeLastFrame.Num()))
+	{
+		NodeLastFrame.SetNumZeroed(NodeId + 1);
+		NodeLastEntry.SetNumZeroed(NodeId + 1);
+	}
+
+	int32& EntryIndex = NodeLastEntry[NodeId];
+	if (NodeLastFrame[NodeId] != FrameNumber || !Record->NodeCycles.IsValidIndex(EntryIndex) || Record->NodeCycles[EntryIndex].Key != NodeId)
+	{
+		NodeLastFrame[NodeId] = FrameNumber;
+		EntryIndex = Record->NodeCycles.Emplace(NodeId, 0);
+	}
+
+	Record->NodeCycles[EntryIndex].Value += Cycles;
+	Record->TotalCycles += Cycles;
+}
+
+void FFrameCostStore::CompleteFramesBefore(uint64 FrameNumber, TFunctionRef<int32(uint32)> GetBlueprintIndex, TFunctionRef<void(const FFrameRecord&)> OnFrameComplete)
+{
+	for (int32 Index = 0; Index < Frames.Num(); ++Index)
+	{
+		FFrameRecord& Record = Frames[(OldestIndex + Index) % Frames.Num()];
+		if (Record.bComplete)
+		{
+			continue;
+		}
+		if (Record.FrameNumber >= FrameNumber)
+		{
+			break;
+		}
+
+		// 节点按耗时降序，同时汇总每个蓝图的总时间
+		Record.NodeCycles.Sort([](const TPair<uint32, uint64>& A, const TPair<uint32, uint64>& B)
+		{
+			return A.Value > B.Value;
+		});
+
+		for (const TPair<uint32, uint64>& NodeCost : Record.NodeCycles)
+		{
+			const int32 BlueprintIndex = GetBlueprintIndex(NodeCost.Key);
+			TPair<int32, uint64>* BlueprintCost = Record.BlueprintCycles.FindByPredicate([BlueprintIndex](const TPair<int32, uint64>& Entry)
+			{
+				return Entry.Key == BlueprintIndex;
+			});
+			if (BlueprintCost)
+			{
+				BlueprintCost->Value += NodeCost.Value;
+			}
+			else
+			{
+				Record.BlueprintCycles.Emplace(BlueprintIndex, NodeCost.Value);
+			}
+		}
+
+		Record.BlueprintCycles.Sort([](const TPair<int32, uint64>& A, const TPair<int32, uint64>& B)
+		{
+			return A.Value > B.Value;
+		});
+
+		Record.bComplete = true;
+		OnFrameComplete(Record);
+	}
+}
+
+const FFrameCostStore::FFrameRecord* FFrameCostStore::FindFrame(uint64 FrameNumber) const
+{
+	if (Frames.Num() == 0)
+	{
+		return nullptr;
+	}
+
+	// 帧号按插入顺序递增
+	const uint64 OldestFrame = GetFrame(0).FrameNumber;
+	if (FrameNumber < OldestFrame)
+	{
+		return nullptr;
+	}
+
+	int32 Low = 0;
+	int32 High = Frames.Num() - 1;
+	while (Low <= High)
+	{
+		const int32 Mid = (Low + High) / 2;
+		const FFrameRecord& Record = GetFrame(Mid);
+		if (Record.FrameNumber == FrameNumber)
+		{
+			return &Record;
+		}
+		if (Record.FrameNumber < FrameNumber)
+		{
+			Low = Mid + 1;
+		}
+		else
+		{
+			High = Mid - 1;
+		}
+	}
+	return nullptr;
+}
+
+int32 FFrameCostStore::InternBlueprint(const FString& BlueprintName)
+{
+	if (const int32* ExistingIndex = BlueprintLookup.Find(BlueprintName))
+	{
+		return *ExistingIndex;
+	}
+
+	const int32 NewIndex = BlueprintNames.Add(BlueprintName);
+	BlueprintLookup.Add(BlueprintName, NewIndex);
+	return NewIndex;
+}
+
+void FFrameCostStore::Reset()
+{
+	Frames.Reset();
+	OldestIndex = 0;
+	NodeLastFrame.Reset();
+	NodeLastEntry.Reset();
+	BlueprintNames.Reset();
+	BlueprintLookup.Reset();
+}
+
 // Singleton instance
 TUniquePtr<FRuntimeProfiler> FRuntimeProfiler::Instance = nullptr;
 
@@ -57,8 +582,12 @@ FRuntimeProfiler& FRuntimeProfiler::Get()
 FRuntimeProfiler::FRuntimeProfiler()
 	: CurrentState(ERecordingState::Stopped)
 	, RecordingStartTime(0.0)
+	, RecordingStartCycles(0)
 	, PauseStartTime(0.0)
 	, TotalPausedTime(0.0)
+	, RecordingStartFrame(0)
+	, PauseStartFrame(0)
+	, TotalPausedFrames(0)
 	, bAutoStartOnPIE(false)
 	, bAutoStopOnPIEEnd(true)
 	, bIsInstrumentationEnabled(false)
@@ -86,11 +615,32 @@ FRuntimeProfiler::~FRuntimeProfiler()
 	{
 		StopRecording();
 	}
+
+	if (DrainTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(DrainTickerHandle);
+		DrainTickerHandle.Reset();
+	}
+
+	// Offset lookups are rebuilt on recompile through a raw binding
+	for (const auto& SavedStatePair : SavedBreakpointStates)
+	{
+		if (UBlueprint* Blueprint = SavedStatePair.Key.Get())
+		{
+			Blueprint->OnCompiled().Remove(SavedStatePair.Value.OnCompiledHandle);
+		}
+	}
 	
 	// Clean up blueprint instrumentation
 	CleanupBlueprintInstrumentation();
 }
 
+void FRuntimeProfiler::StartRecording(const FString& SessionName, const FProfilerSamplingSettings& Sampling)
+{
+	SamplingSettings = Sampling;
+	StartRecording(SessionName);
+}
+
 void FRuntimeProfiler::StartRecording(const FString& SessionName)
 {
 	if (CurrentState == ERecordingState::Recording)
@@ -102,20 +652,71 @@ void FRuntimeProfiler::StartRecording(const FString& SessionName)
 	if (CurrentState != ERecordingState::Stopped)
 	{
 		EndCurrentSession();
+		FinishLiveSessionFile();
 	}
 
 	// Start new session
 	StartNewSession(SessionName);
 
+	// 丢弃各线程影子栈和事件缓冲区中上一次录制残留的数据
+	BlueprintProfilerTiming::GTimingEpoch.fetch_add(1, std::memory_order_relaxed);
+	DiscardEventBuffers();
+
 	CurrentState = ERecordingState::Recording;
 	RecordingStartTime = FPlatformTime::Seconds();
+	RecordingStartCycles = FPlatformTime::Cycles64();
 	TotalPausedTime = 0.0;
-	NodeStats.Empty();
+	RecordingStartFrame = GFrameCounter;
+	PauseStartFrame = 0;
+	TotalPausedFrames = 0;
+	ResetNodeStats();
+	ResetLiveUpdates();
 	ExecutionFrames.Empty();
 	TickAbuseData.Empty();
 	TotalEventsProcessed = 0;
+	TotalDroppedEvents = 0;
 	LastLoggingTime = 0.0;
 
+	// 采样参数在录制期间保持不变，热路径只读取这些成员
+	ActiveSamplingMode = SamplingSettings.Mode;
+	ActiveSamplingRate = SamplingSettings.GetSamplingRate();
+	ActiveSampleInterval = static_cast<uint32>(FMath::Max(SamplingSettings.SampleInterval, 1));
+	SamplePeriodCycles = FMath::Max<uint64>(1, static_cast<uint64>(FMath::Max(SamplingSettings.SlicePeriodMs, 0.001f) / 1000.0 / FPlatformTime::GetSecondsPerCycle64()));
+	SampleSliceCycles = FMath::Max<uint64>(1, static_cast<uint64>(SamplePeriodCycles * ActiveSamplingRate));
+	CurrentSession.SamplingMode = ActiveSamplingMode;
+	CurrentSession.SamplingRate = ActiveSamplingRate;
+
+	// 录制期间持续把帧页写入会话文件，停止时再补写节点统计
+	ResetFrameHistory();
+	LiveSessionFilePath.Empty();
+	if (bStreamSessionToDisk)
+	{
+		const FString LiveFilePath = GetSessionDataFilePath();
+		if (LiveSessionWriter.Open(LiveFilePath))
+		{
+			LiveSessionFilePath = LiveFilePath;
+		}
+	}
+
+	if (ActiveSamplingMode != ESamplingMode::Full)
+	{
+		UE_LOG(LogTemp, Log, TEXT("[PROFILER] Sampling recording started: mode %d, rate %.4f"), (int32)ActiveSamplingMode, ActiveSamplingRate);
+	}
+
+	// 每帧把各线程缓冲区中的事件合并到 NodeStats
+	if (!DrainTickerHandle.IsValid())
+	{
+		DrainTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateRaw(this, &FRuntimeProfiler::TickDrainEvents));
+	}
+
+	// 按时间片统计蓝图实例的内存，快照与执行帧使用同一时间线
+	MemoryCapture.Reset();
+	if (bCaptureBlueprintMemory)
+	{
+		MemoryCapture.Start();
+	}
+
 	// 启用蓝图仪表化（绑定到 OnScriptProfilingEvent）
 	EnableBlueprintInstrumentation();
 
@@ -148,8 +749,27 @@ void FRuntimeProfiler::StopRecording()
 		ScriptExceptionDelegateHandle.Reset();
 	}
 
+	// 合并最后一帧尚未处理的事件
+	if (DrainTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(DrainTickerHandle);
+		DrainTickerHandle.Reset();
+	}
+	DrainEventBuffers();
+	MemoryCapture.Stop();
+
+	// 停止后不会再收到退出事件，关闭游戏线程上仍打开的 Insights 区间
+	BlueprintProfilerTiming::GTimingEpoch.fetch_add(1, std::memory_order_relaxed);
+	BlueprintProfilerTiming::GetShadowStack();
+	CompleteFrameCosts(MAX_uint64);
+
+	// 在 PIE 对象销毁前解析节点名称
+	ResolvePendingNodeInfo();
+	BlueprintProfilerTrace::ResetNodeTimers();
+
 	// End current session and save to history
 	EndCurrentSession();
+	FinishLiveSessionFile();
 }
 
 void FRuntimeProfiler::PauseRecording()
@@ -159,12 +779,22 @@ void FRuntimeProfiler::PauseRecording()
 		return;
 	}
 
+	// 暂停前已记录的事件仍属于本次会话
+	DrainEventBuffers();
+	CompleteFrameCosts(MAX_uint64);
+
 	CurrentState = ERecordingState::Paused;
 	PauseStartTime = FPlatformTime::Seconds();
+	PauseStartFrame = GFrameCounter;
+	MemoryCapture.Stop();
 
 	// 暂停时禁用追踪点回调（避免不必要的开销）
 	bSkipRecording = true;
 
+	// 暂停前打开的节点不再配对，否则其耗时会包含暂停时间
+	BlueprintProfilerTiming::GTimingEpoch.fetch_add(1, std::memory_order_relaxed);
+	BlueprintProfilerTiming::GetShadowStack();
+
 	UE_LOG(LogTemp, Log, TEXT("Runtime profiler recording paused"));
 }
 
@@ -180,10 +810,17 @@ void FRuntimeProfiler::ResumeRecording()
 	// Add paused time to total
 	TotalPausedTime += FPlatformTime::Seconds() - PauseStartTime;
 	PauseStartTime = 0.0;
+	TotalPausedFrames += GFrameCounter - PauseStartFrame;
+	PauseStartFrame = 0;
 
 	// 恢复时启用追踪点回调
 	bSkipRecording = false;
 
+	if (bCaptureBlueprintMemory)
+	{
+		MemoryCapture.Start();
+	}
+
 }
 
 void FRuntimeProfiler::ResetData()
@@ -193,12 +830,23 @@ void FRuntimeProfiler::ResetData()
 		StopRecording();
 	}
 	
+	// 暂停中重置：先收尾会话文件，使其仍可加载
+	FinishLiveSessionFile();
+	LiveSessionFilePath.Empty();
+
 	CurrentState = ERecordingState::Stopped;
-	NodeStats.Empty();
+	DiscardEventBuffers();
+	ResetNodeStats();
+	ResetLiveUpdates();
 	ExecutionFrames.Empty();
+	ResetFrameHistory();
 	TickAbuseData.Empty();
+	MemoryCapture.Stop();
+	MemoryCapture.Reset();
 	RecordingStartTime = 0.0;
 	TotalPausedTime = 0.0;
+	PauseStartFrame = 0;
+	TotalPausedFrames = 0;
 	
 	// Reset current session
 	CurrentSession = FRecordingSession();
@@ -207,131 +855,168 @@ void FRuntimeProfiler::ResetData()
 TArray<FNodeExecutionData> FRuntimeProfiler::GetExecutionData() const
 {
 	TArray<FNodeExecutionData> Result;
+	GatherExecutionData(Result, nullptr);
+	return Result;
+}
 
-	// If we have loaded session data, return it directly
-	if (LoadedSessionData.Num() > 0)
+void FRuntimeProfiler::GatherExecutionData(TArray<FNodeExecutionData>& Result, TArray<uint32>* OutNodeIds) const
+{
+	Result.Reset();
+	if (OutNodeIds)
 	{
-		return LoadedSessionData;
+		OutNodeIds->Reset();
 	}
 
-	float RecordingDuration = 0.0f;
-	if (CurrentState == ERecordingState::Recording)
-	{
-		RecordingDuration = (FPlatformTime::Seconds() - RecordingStartTime) - TotalPausedTime;
-	}
-	else if (CurrentState == ERecordingState::Paused)
+	// If we have loaded session data, return it directly
+	if (LoadedSessionData.Num() > 0)
 	{
-		RecordingDuration = (PauseStartTime - RecordingStartTime) - TotalPausedTime;
-	}
-	else if (ExecutionFrames.Num() > 0)
-	{
-		RecordingDuration = CurrentSession.Duration;
+		Result = LoadedSessionData;
+		if (OutNodeIds)
+		{
+			for (int32 Index = 0; Index < Result.Num(); ++Index)
+			{
+				OutNodeIds->Add(static_cast<uint32>(Index));
+			}
+		}
+		return;
 	}
 
-	int32 SkippedInvalid = 0;
-	int32 SkippedNoCache = 0;
-	int32 Added = 0;
-
-	for (const auto& StatsPair : NodeStats)
+	const float RecordingDuration = GetRecordingDuration();
+	for (uint32 NodeId = 0; NodeId < static_cast<uint32>(NodeStats.Num()); ++NodeId)
 	{
 		FNodeExecutionData Data;
-		Data.BlueprintObject = StatsPair.Key;
-		Data.TotalExecutions = StatsPair.Value.ExecutionCount;
-		Data.TotalExecutionTime = StatsPair.Value.TotalExecutionTime;
-		Data.AverageExecutionTime = StatsPair.Value.GetAverageExecutionTime();
-		Data.AverageExecutionsPerSecond = StatsPair.Value.GetExecutionsPerSecond(RecordingDuration);
+		if (!FillExecutionData(NodeId, RecordingDuration, Data))
+		{
+			continue;
+		}
 
-		// 优先使用缓存的节点信息（PIE结束后对象失效时仍能显示）
-		if (!StatsPair.Value.CachedNodeName.IsEmpty())
+		Result.Add(MoveTemp(Data));
+		if (OutNodeIds)
 		{
-			Data.NodeName = StatsPair.Value.CachedNodeName;
-			Data.BlueprintName = StatsPair.Value.CachedBlueprintName;
-			Data.NodeGuid = StatsPair.Value.CachedNodeGuid;
-			Result.Add(Data);
-			Added++;
+			OutNodeIds->Add(NodeId);
 		}
-		// 如果对象仍然有效，尝试从对象获取信息
-		else if (StatsPair.Key.IsValid())
+	}
+}
+
+bool FRuntimeProfiler::FillExecutionData(uint32 NodeId, float RecordingDuration, FNodeExecutionData& Data) const
+{
+	// 已分配 ID（例如追踪点节点）但本次录制未执行
+	if (NodeStats.GetExecutionCount(NodeId) == 0)
+	{
+		return false;
+	}
+
+	Data.BlueprintObject = NodeStats.GetObject(NodeId);
+
+	// 优先使用缓存的节点信息（PIE结束后对象失效时仍能显示），否则从仍有效的对象懒解析
+	if (NodeStats.HasNodeInfo(NodeId))
+	{
+		Data.NodeName = NodeStats.GetNodeName(NodeId);
+		Data.BlueprintName = NodeStats.GetBlueprintName(NodeId);
+		Data.NodeGuid = NodeStats.GetNodeGuid(NodeId);
+	}
+	else if (!ResolveNodeInfo(Data.BlueprintObject.Get(), Data.NodeName, Data.BlueprintName, Data.NodeGuid))
+	{
+		// 对象无效且无缓存信息，跳过
+		return false;
+	}
+
+	Data.TotalExecutions = NodeStats.GetExecutionCount(NodeId);
+	Data.TotalExecutionTime = NodeStats.GetTotalExecutionTime(NodeId);
+	Data.AverageExecutionTime = NodeStats.GetAverageExecutionTime(NodeId);
+	Data.TotalExclusiveTime = NodeStats.GetTotalExclusiveTime(NodeId);
+	Data.AverageExclusiveTime = NodeStats.GetAverageExclusiveTime(NodeId);
+	Data.P50ExecutionTime = NodeStats.GetPercentileExecutionTime(NodeId, 50.0f);
+	Data.P95ExecutionTime = NodeStats.GetPercentileExecutionTime(NodeId, 95.0f);
+	Data.P99ExecutionTime = NodeStats.GetPercentileExecutionTime(NodeId, 99.0f);
+	Data.AverageExecutionsPerSecond = NodeStats.GetExecutionsPerSecond(NodeId, RecordingDuration);
+	Data.ApplySamplingRate(ActiveSamplingRate);
+	return true;
+}
+
+float FRuntimeProfiler::GetRecordingDuration() const
+{
+	if (CurrentState == ERecordingState::Recording)
+	{
+		return (FPlatformTime::Seconds() - RecordingStartTime) - TotalPausedTime;
+	}
+	if (CurrentState == ERecordingState::Paused)
+	{
+		return (PauseStartTime - RecordingStartTime) - TotalPausedTime;
+	}
+	return ExecutionFrames.Num() > 0 ? CurrentSession.Duration : 0.0f;
+}
+
+void FRuntimeProfiler::PublishLiveUpdate()
+{
+	check(IsInGameThread());
+
+	NodeStats.ConsumeChangedIds(LiveChangedIds);
+	if (LiveChangedIds.Num() == 0 && LiveUpdateSerial > 0)
+	{
+		return;
+	}
+
+	// 后台缓冲区仍被读者持有时换一块新的，已发布的更新不会被改写
+	// 后台缓冲区已不是 LatestLiveUpdate，其他线程无法再取得它，引用计数只会减少，检查结果可靠
+	TSharedPtr<FRuntimeLiveUpdate, ESPMode::ThreadSafe>& Buffer = LiveUpdateBuffers[LiveUpdateBackBuffer];
+	if (!Buffer.IsValid() || Buffer.GetSharedReferenceCount() > 1)
+	{
+		Buffer = MakeShared<FRuntimeLiveUpdate, ESPMode::ThreadSafe>();
+	}
+	LiveUpdateBackBuffer ^= 1;
+
+	FRuntimeLiveUpdate& Update = *Buffer;
+	Update.Serial = ++LiveUpdateSerial;
+	Update.Timestamp = FPlatformTime::Seconds();
+	Update.RecordingDuration = GetRecordingDuration();
+	Update.NumRecordedNodes = NodeStats.Num();
+	Update.ChangedNodes.Reset(LiveChangedIds.Num());
+
+	for (uint32 NodeId : LiveChangedIds)
+	{
+		// 名称只解析一次并缓存，之后的更新只复制统计值
+		if (!NodeStats.HasNodeInfo(NodeId))
 		{
-			if (UObject* Object = StatsPair.Key.Get())
+			FString NodeName;
+			FString BlueprintName;
+			FGuid NodeGuid;
+			if (ResolveNodeInfo(NodeStats.GetObject(NodeId).Get(), NodeName, BlueprintName, NodeGuid))
 			{
-				// Case 1: Object is a UEdGraphNode (most common case)
-				if (UEdGraphNode* Node = Cast<UEdGraphNode>(Object))
-				{
-					Data.NodeName = Node->GetNodeTitle(ENodeTitleType::ListView).ToString();
-					Data.NodeGuid = Node->NodeGuid;
-
-					// Get blueprint from node's graph
-					if (Node->GetGraph())
-					{
-						if (UBlueprint* Blueprint = Cast<UBlueprint>(Node->GetGraph()->GetOuter()))
-						{
-							Data.BlueprintName = Blueprint->GetName();
-						}
-						else
-						{
-							// Try to get blueprint from class
-							if (UBlueprintGeneratedClass* BPClass = Cast<UBlueprintGeneratedClass>(Node->GetClass()))
-							{
-								if (UBlueprint* GeneratedBy = Cast<UBlueprint>(BPClass->ClassGeneratedBy))
-								{
-									Data.BlueprintName = GeneratedBy->GetName();
-								}
-							}
-						}
-					}
-				}
-				// Case 2: Object is a UBlueprint
-				else if (UBlueprint* Blueprint = Cast<UBlueprint>(Object))
-				{
-					Data.BlueprintName = Blueprint->GetName();
-					Data.NodeName = TEXT("Blueprint");
-				}
-				// Case 3: Object has a BlueprintGeneratedClass
-				else if (UBlueprintGeneratedClass* BPClass = Cast<UBlueprintGeneratedClass>(Object->GetClass()))
-				{
-					if (UBlueprint* GeneratedByBlueprint = Cast<UBlueprint>(BPClass->ClassGeneratedBy))
-					{
-						Data.BlueprintName = GeneratedByBlueprint->GetName();
-						Data.NodeName = Object->GetName();
-					}
-					else
-					{
-						// Try to get name from BPClass
-						Data.BlueprintName = BPClass->GetName();
-						// Remove _C suffix if present
-						if (Data.BlueprintName.EndsWith(TEXT("_C")))
-						{
-							Data.BlueprintName = Data.BlueprintName.LeftChop(2);
-						}
-						Data.NodeName = Object->GetName();
-					}
-				}
-				// Fallback: Unknown
-				else
-				{
-					Data.BlueprintName = TEXT("Unknown Blueprint");
-					Data.NodeName = Object->GetName();
-				}
+				NodeStats.SetNodeInfo(NodeId, NodeName, BlueprintName, NodeGuid);
 			}
-			Result.Add(Data);
-			Added++;
 		}
-		// 对象无效且无缓存信息，跳过
-		else
+
+		FNodeExecutionData& Data = Update.ChangedNodes.AddDefaulted_GetRef();
+		if (!FillExecutionData(NodeId, Update.RecordingDuration, Data))
 		{
-			SkippedInvalid++;
+			Update.ChangedNodes.Pop(EAllowShrinking::No);
 		}
 	}
-	
-	// Add loaded session data if no current recording data
-	if (Result.Num() == 0 && LoadedSessionData.Num() > 0)
+
+	const TSharedRef<const FRuntimeLiveUpdate, ESPMode::ThreadSafe> Published = Buffer.ToSharedRef();
 	{
-		UE_LOG(LogTemp, Log, TEXT("GetExecutionData: Returning %d loaded session data items"), LoadedSessionData.Num());
-		Result = LoadedSessionData;
+		FWriteScopeLock WriteLock(LiveUpdateLock);
+		LatestLiveUpdate = Published;
 	}
+	OnLiveUpdate.Broadcast(Published);
+}
 
-	return Result;
+TSharedPtr<const FRuntimeLiveUpdate, ESPMode::ThreadSafe> FRuntimeProfiler::GetLatestLiveUpdate() const
+{
+	FReadScopeLock ReadLock(LiveUpdateLock);
+	return LatestLiveUpdate;
+}
+
+void FRuntimeProfiler::ResetLiveUpdates()
+{
+	LastLiveUpdateTime = 0.0;
+	LiveUpdateSerial = 0;
+	{
+		FWriteScopeLock WriteLock(LiveUpdateLock);
+		LatestLiveUpdate.Reset();
+	}
+	LiveChangedIds.Reset();
 }
 
 // Session management methods
@@ -374,13 +1059,23 @@ void FRuntimeProfiler::UpdateSessionStats()
 		FTimespan Duration = CurrentSession.EndTime - CurrentSession.StartTime;
 		CurrentSession.Duration = Duration.GetTotalSeconds() - TotalPausedTime;
 	}
+
+	// 在暂停中停止时，暂停开始后的帧不计入
+	const uint64 EndFrame = PauseStartFrame != 0 ? PauseStartFrame : GFrameCounter;
+	const uint64 RecordedFrames = EndFrame > RecordingStartFrame + TotalPausedFrames ? EndFrame - RecordingStartFrame - TotalPausedFrames : 0;
+	CurrentSession.TotalFrames = static_cast<int32>(FMath::Min<uint64>(RecordedFrames, MAX_int32));
 	
-	CurrentSession.TotalNodesRecorded = NodeStats.Num();
+	CurrentSession.TotalNodesRecorded = 0;
 	CurrentSession.TotalExecutions = 0;
 	
-	for (const auto& StatsPair : NodeStats)
+	for (uint32 NodeId = 0; NodeId < static_cast<uint32>(NodeStats.Num()); ++NodeId)
 	{
-		CurrentSession.TotalExecutions += StatsPair.Value.ExecutionCount;
+		const int32 ExecutionCount = NodeStats.GetExecutionCount(NodeId);
+		if (ExecutionCount > 0)
+		{
+			CurrentSession.TotalNodesRecorded++;
+			CurrentSession.TotalExecutions += FMath::RoundToInt(ExecutionCount / ActiveSamplingRate);
+		}
 	}
 }
 
@@ -393,7 +1088,55 @@ FString FRuntimeProfiler::GenerateDefaultSessionName() const
 void FRuntimeProfiler::SaveSessionData(const FString& FilePath)
 {
 	FString SavePath = FilePath.IsEmpty() ? GetSessionDataFilePath() : FilePath;
-	
+
+	if (!BlueprintProfilerSessionFile::IsSessionFile(SavePath))
+	{
+		ExportSessionJson(SavePath);
+		return;
+	}
+
+	// 录制时流式写入的会话文件包含完整的帧历史，直接复用而不是从内存中的最近帧重写
+	if (LoadedSessionData.Num() == 0 && !LiveSessionWriter.IsOpen() && !LiveSessionFilePath.IsEmpty() &&
+		IFileManager::Get().FileExists(*LiveSessionFilePath))
+	{
+		if (FPaths::IsSamePath(SavePath, LiveSessionFilePath))
+		{
+			UE_LOG(LogTemp, Log, TEXT("Session data already saved to: %s"), *SavePath);
+			return;
+		}
+
+		if (IFileManager::Get().Copy(*SavePath, *LiveSessionFilePath) == COPY_OK)
+		{
+			UE_LOG(LogTemp, Log, TEXT("Session data saved to: %s"), *SavePath);
+			return;
+		}
+	}
+
+	TArray<FNodeExecutionData> ExecutionData;
+	TArray<uint32> NodeIds;
+	GatherExecutionData(ExecutionData, &NodeIds);
+
+	FProfilerSessionWriter Writer;
+	if (!Writer.Open(SavePath))
+	{
+		return;
+	}
+	Writer.WriteFrames(ExecutionFrames);
+	Writer.WriteMemorySnapshots(MemoryCapture.GetSnapshots());
+	Writer.WriteSummary(CurrentSession, ExecutionData, NodeIds);
+
+	if (Writer.Close())
+	{
+		UE_LOG(LogTemp, Log, TEXT("Session data saved to: %s"), *SavePath);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to save session data to: %s"), *SavePath);
+	}
+}
+
+bool FRuntimeProfiler::ExportSessionJson(const FString& SavePath)
+{
 	// Create JSON object with session data
 	TSharedPtr<FJsonObject> JsonObject = MakeShareable(new FJsonObject);
 	
@@ -403,9 +1146,12 @@ void FRuntimeProfiler::SaveSessionData(const FString& FilePath)
 	SessionJson->SetStringField(TEXT("StartTime"), CurrentSession.StartTime.ToString());
 	SessionJson->SetStringField(TEXT("EndTime"), CurrentSession.EndTime.ToString());
 	SessionJson->SetNumberField(TEXT("Duration"), CurrentSession.Duration);
+	SessionJson->SetNumberField(TEXT("TotalFrames"), CurrentSession.TotalFrames);
 	SessionJson->SetNumberField(TEXT("TotalNodesRecorded"), CurrentSession.TotalNodesRecorded);
 	SessionJson->SetNumberField(TEXT("TotalExecutions"), CurrentSession.TotalExecutions);
 	SessionJson->SetBoolField(TEXT("bAutoStarted"), CurrentSession.bAutoStarted);
+	SessionJson->SetNumberField(TEXT("SamplingMode"), (int32)CurrentSession.SamplingMode);
+	SessionJson->SetNumberField(TEXT("SamplingRate"), CurrentSession.SamplingRate);
 	
 	JsonObject->SetObjectField(TEXT("Session"), SessionJson);
 	
@@ -423,6 +1169,15 @@ void FRuntimeProfiler::SaveSessionData(const FString& FilePath)
 		DataJson->SetNumberField(TEXT("AverageExecutionsPerSecond"), Data.AverageExecutionsPerSecond);
 		DataJson->SetNumberField(TEXT("TotalExecutionTime"), Data.TotalExecutionTime);
 		DataJson->SetNumberField(TEXT("AverageExecutionTime"), Data.AverageExecutionTime);
+		DataJson->SetNumberField(TEXT("TotalExclusiveTime"), Data.TotalExclusiveTime);
+		DataJson->SetNumberField(TEXT("AverageExclusiveTime"), Data.AverageExclusiveTime);
+		DataJson->SetNumberField(TEXT("P50ExecutionTime"), Data.P50ExecutionTime);
+		DataJson->SetNumberField(TEXT("P95ExecutionTime"), Data.P95ExecutionTime);
+		DataJson->SetNumberField(TEXT("P99ExecutionTime"), Data.P99ExecutionTime);
+		DataJson->SetNumberField(TEXT("SamplingRate"), Data.SamplingRate);
+		DataJson->SetNumberField(TEXT("SampledExecutions"), Data.SampledExecutions);
+		DataJson->SetNumberField(TEXT("ExecutionsLowerBound"), Data.ExecutionsLowerBound);
+		DataJson->SetNumberField(TEXT("ExecutionsUpperBound"), Data.ExecutionsUpperBound);
 		
 		ExecutionDataArray.Add(MakeShareable(new FJsonValueObject(DataJson)));
 	}
@@ -437,17 +1192,76 @@ void FRuntimeProfiler::SaveSessionData(const FString& FilePath)
 	if (FFileHelper::SaveStringToFile(OutputString, *SavePath))
 	{
 		UE_LOG(LogTemp, Log, TEXT("Session data saved to: %s"), *SavePath);
+		return true;
 	}
-	else
-	{
-		UE_LOG(LogTemp, Error, TEXT("Failed to save session data to: %s"), *SavePath);
-	}
+
+	UE_LOG(LogTemp, Error, TEXT("Failed to save session data to: %s"), *SavePath);
+	return false;
 }
 
 bool FRuntimeProfiler::LoadSessionData(const FString& FilePath)
 {
 	FString LoadPath = FilePath.IsEmpty() ? GetSessionDataFilePath() : FilePath;
+
+	return BlueprintProfilerSessionFile::IsSessionFile(LoadPath) ? LoadSessionBinary(LoadPath) : LoadSessionJson(LoadPath);
+}
+
+void FRuntimeProfiler::AddLoadedSession(const FRecordingSession& LoadedSession)
+{
+	// Add to session history if not already present
+	bool bAlreadyExists = false;
+	for (const FRecordingSession& ExistingSession : SessionHistory)
+	{
+		if (ExistingSession.SessionName == LoadedSession.SessionName && 
+			ExistingSession.StartTime == LoadedSession.StartTime)
+		{
+			bAlreadyExists = true;
+			break;
+		}
+	}
 	
+	if (!bAlreadyExists)
+	{
+		SessionHistory.Add(LoadedSession);
+	}
+	
+	// Set as current session
+	CurrentSession = LoadedSession;
+}
+
+bool FRuntimeProfiler::LoadSessionBinary(const FString& LoadPath)
+{
+	TUniquePtr<FProfilerSessionReader> Reader = MakeUnique<FProfilerSessionReader>();
+	if (!Reader->Open(LoadPath))
+	{
+		return false;
+	}
+
+	FRecordingSession LoadedSession = Reader->GetSession();
+	if (LoadedSession.SessionName.IsEmpty())
+	{
+		// 录制中断的文件没有会话块
+		LoadedSession.SessionName = FPaths::GetBaseFilename(LoadPath);
+	}
+	AddLoadedSession(LoadedSession);
+
+	ResetNodeStats();
+	LoadedSessionData = Reader->GetNodes();
+	MemoryCapture.SetSnapshots(CopyTemp(Reader->GetMemorySnapshots()));
+
+	UE_LOG(LogTemp, Log, TEXT("Session data loaded from: %s (%d nodes, %lld frames%s)"),
+		*LoadPath, LoadedSessionData.Num(), Reader->GetNumFrames(), Reader->IsComplete() ? TEXT("") : TEXT(", incomplete"));
+
+	// 帧不一次性载入，时间线按页读取
+	ExecutionFrames.Empty();
+	ResetFrameHistory();
+	TotalFramesRecorded = Reader->GetNumFrames();
+	FramePageReader = MoveTemp(Reader);
+	return true;
+}
+
+bool FRuntimeProfiler::LoadSessionJson(const FString& LoadPath)
+{
 	FString FileContent;
 	if (!FFileHelper::LoadFileToString(FileContent, *LoadPath))
 	{
@@ -471,38 +1285,29 @@ bool FRuntimeProfiler::LoadSessionData(const FString& FilePath)
 		FDateTime::Parse(SessionJson->GetStringField(TEXT("StartTime")), LoadedSession.StartTime);
 		FDateTime::Parse(SessionJson->GetStringField(TEXT("EndTime")), LoadedSession.EndTime);
 		LoadedSession.Duration = SessionJson->GetNumberField(TEXT("Duration"));
+		SessionJson->TryGetNumberField(TEXT("TotalFrames"), LoadedSession.TotalFrames);
 		LoadedSession.TotalNodesRecorded = SessionJson->GetIntegerField(TEXT("TotalNodesRecorded"));
 		LoadedSession.TotalExecutions = SessionJson->GetIntegerField(TEXT("TotalExecutions"));
 		LoadedSession.bAutoStarted = SessionJson->GetBoolField(TEXT("bAutoStarted"));
-		LoadedSession.bIsActive = false;
-		
-		// Add to session history if not already present
-		bool bAlreadyExists = false;
-		for (const FRecordingSession& ExistingSession : SessionHistory)
+		int32 SamplingMode = 0;
+		if (SessionJson->TryGetNumberField(TEXT("SamplingMode"), SamplingMode))
 		{
-			if (ExistingSession.SessionName == LoadedSession.SessionName && 
-				ExistingSession.StartTime == LoadedSession.StartTime)
-			{
-				bAlreadyExists = true;
-				break;
-			}
+			LoadedSession.SamplingMode = static_cast<ESamplingMode>(SamplingMode);
 		}
-		
-		if (!bAlreadyExists)
-		{
-			SessionHistory.Add(LoadedSession);
-		}
-		
-		// Set as current session
-		CurrentSession = LoadedSession;
+		SessionJson->TryGetNumberField(TEXT("SamplingRate"), LoadedSession.SamplingRate);
+		LoadedSession.bIsActive = false;
+
+		AddLoadedSession(LoadedSession);
 	}
 	
 	// Load execution data
 	const TArray<TSharedPtr<FJsonValue>>* ExecutionDataArray;
 	if (JsonObject->TryGetArrayField(TEXT("ExecutionData"), ExecutionDataArray))
 	{
-		NodeStats.Empty();
+		ResetNodeStats();
 		LoadedSessionData.Empty();
+		ExecutionFrames.Empty();
+		ResetFrameHistory();
 		
 		// Load execution data for display
 		for (const TSharedPtr<FJsonValue>& Value : *ExecutionDataArray)
@@ -518,6 +1323,21 @@ bool FRuntimeProfiler::LoadSessionData(const FString& FilePath)
 				Data.AverageExecutionsPerSecond = DataJson->GetNumberField(TEXT("AverageExecutionsPerSecond"));
 				Data.TotalExecutionTime = DataJson->GetNumberField(TEXT("TotalExecutionTime"));
 				Data.AverageExecutionTime = DataJson->GetNumberField(TEXT("AverageExecutionTime"));
+				// 旧版本会话文件没有自身耗时和分位数字段
+				DataJson->TryGetNumberField(TEXT("TotalExclusiveTime"), Data.TotalExclusiveTime);
+				DataJson->TryGetNumberField(TEXT("AverageExclusiveTime"), Data.AverageExclusiveTime);
+				DataJson->TryGetNumberField(TEXT("P50ExecutionTime"), Data.P50ExecutionTime);
+				DataJson->TryGetNumberField(TEXT("P95ExecutionTime"), Data.P95ExecutionTime);
+				DataJson->TryGetNumberField(TEXT("P99ExecutionTime"), Data.P99ExecutionTime);
+
+				// 旧版本或完整录制的文件：记录次数即精确值
+				Data.SampledExecutions = Data.TotalExecutions;
+				Data.ExecutionsLowerBound = Data.TotalExecutions;
+				Data.ExecutionsUpperBound = Data.TotalExecutions;
+				DataJson->TryGetNumberField(TEXT("SamplingRate"), Data.SamplingRate);
+				DataJson->TryGetNumberField(TEXT("SampledExecutions"), Data.SampledExecutions);
+				DataJson->TryGetNumberField(TEXT("ExecutionsLowerBound"), Data.ExecutionsLowerBound);
+				DataJson->TryGetNumberField(TEXT("ExecutionsUpperBound"), Data.ExecutionsUpperBound);
 				
 				LoadedSessionData.Add(Data);
 			}
@@ -539,7 +1359,7 @@ FString FRuntimeProfiler::GetSessionDataFilePath(const FString& SessionName) con
 	FileName = FileName.Replace(TEXT(":"), TEXT("-"));
 	
 	FString SaveDir = FPaths::ProjectSavedDir() / TEXT("BlueprintProfiler") / TEXT("Sessions");
-	FString FilePath = SaveDir / (FileName + TEXT(".json"));
+	FString FilePath = SaveDir / (FileName + BlueprintProfilerSessionFile::GetExtension());
 	
 	// Ensure directory exists
 	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
@@ -564,20 +1384,21 @@ TArray<FHotNodeInfo> FRuntimeProfiler::GetHotNodes(float Threshold) const
 		(FPlatformTime::Seconds() - RecordingStartTime) : 
 		(ExecutionFrames.Num() > 0 ? ExecutionFrames.Last().Timestamp - RecordingStartTime : 0.0f);
 	
-	for (const auto& StatsPair : NodeStats)
+	for (uint32 NodeId = 0; NodeId < static_cast<uint32>(NodeStats.Num()); ++NodeId)
 	{
-		if (!StatsPair.Key.IsValid())
+		const TWeakObjectPtr<UObject>& NodeObject = NodeStats.GetObject(NodeId);
+		if (!NodeObject.IsValid())
 		{
 			continue;
 		}
 		
-		float ExecutionsPerSecond = StatsPair.Value.GetExecutionsPerSecond(RecordingDuration);
+		float ExecutionsPerSecond = NodeStats.GetExecutionsPerSecond(NodeId, RecordingDuration) / ActiveSamplingRate;
 		if (ExecutionsPerSecond >= Threshold)
 		{
 			FHotNodeInfo HotNode;
-			HotNode.BlueprintObject = StatsPair.Key;
+			HotNode.BlueprintObject = NodeObject;
 			HotNode.ExecutionsPerSecond = ExecutionsPerSecond;
-			HotNode.AverageExecutionTime = StatsPair.Value.GetAverageExecutionTime();
+			HotNode.AverageExecutionTime = NodeStats.GetAverageExecutionTime(NodeId);
 			
 			// Determine severity based on execution frequency and time
 			float PerformanceImpact = ExecutionsPerSecond * HotNode.AverageExecutionTime;
@@ -600,7 +1421,7 @@ TArray<FHotNodeInfo> FRuntimeProfiler::GetHotNodes(float Threshold) const
 			}
 			
 			// Try to get detailed node information
-			if (UObject* Object = StatsPair.Key.Get())
+			if (UObject* Object = NodeObject.Get())
 			{
 				HotNode.NodeName = GetDetailedNodeName(Object);
 				HotNode.NodeGuid = GetNodeGuid(Object);
@@ -640,10 +1461,24 @@ void FRuntimeProfiler::OnPIEBegin(bool bIsSimulating)
 		CurrentSession.bAutoStarted = true;
 
 	}
+	else if (CurrentState == ERecordingState::Recording && bCaptureBlueprintMemory)
+	{
+		MemoryCapture.Start();
+	}
 }
 
 void FRuntimeProfiler::OnPIEEnd(bool bIsSimulating)
 {
+	// PIE 对象即将销毁，先解析已记录节点的名称
+	if (CurrentState != ERecordingState::Stopped)
+	{
+		DrainEventBuffers();
+		ResolvePendingNodeInfo();
+	}
+
+	// 没有 PIE 世界时的快照全部为空，继续录制也不再采集内存
+	MemoryCapture.Stop();
+
 	// Auto-stop recording when PIE ends if configured to do so
 	if (bAutoStopOnPIEEnd && CurrentState == ERecordingState::Recording)
 	{
@@ -651,188 +1486,841 @@ void FRuntimeProfiler::OnPIEEnd(bool bIsSimulating)
 	}
 }
 
-void FRuntimeProfiler::InitializeBlueprintInstrumentation()
+void FRuntimeProfiler::InitializeBlueprintInstrumentation()
+{
+}
+
+void FRuntimeProfiler::CleanupBlueprintInstrumentation()
+{
+	// Clean up any blueprint instrumentation hooks
+	if (bIsInstrumentationEnabled)
+	{
+		// 取消委托绑定
+		if (InstrumentationDelegateHandle.IsValid())
+		{
+			FBlueprintCoreDelegates::OnScriptProfilingEvent.Remove(InstrumentationDelegateHandle);
+			InstrumentationDelegateHandle.Reset();
+		}
+
+		bIsInstrumentationEnabled = false;
+	}
+}
+
+void FRuntimeProfiler::EnableBlueprintInstrumentation()
+{
+	// 如果已经启用了，不要重复绑定
+	if (bIsInstrumentationEnabled)
+	{
+		return;
+	}
+
+	// Enable blueprint execution monitoring for UE 5.6
+	// This is the CORRECT way to enable blueprint profiling
+
+	// 1. Force enable blueprint instrumentation via console variable
+	// This corresponds to console command: bp.EnableInstrumentation 1
+	static IConsoleVariable* BlueprintInstrumentationCV = IConsoleManager::Get().FindConsoleVariable(TEXT("bp.EnableInstrumentation"));
+	if (BlueprintInstrumentationCV)
+	{
+		BlueprintInstrumentationCV->Set(1, ECVF_SetByCode);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("CRITICAL: Could not find bp.EnableInstrumentation console variable! Blueprint profiling will not work."));
+	}
+
+	// 2. Bind the core delegate to receive node execution events
+	// In UE 5.6, the correct delegate is OnScriptProfilingEvent
+	if (!InstrumentationDelegateHandle.IsValid())
+	{
+		InstrumentationDelegateHandle = FBlueprintCoreDelegates::OnScriptProfilingEvent.AddRaw(this, &FRuntimeProfiler::OnScriptProfilingEvent);
+		bIsInstrumentationEnabled = true;
+		UE_LOG(LogTemp, Log, TEXT("[PROFILER] Blueprint instrumentation enabled - bound to OnScriptProfilingEvent"));
+	}
+	else
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[PROFILER] OnScriptProfilingEvent delegate already bound"));
+	}
+}
+
+bool FRuntimeProfiler::ShouldSampleEvent(uint64 NowCycles, uint32& SampleCountdown, uint32& SampleRandom) const
+{
+	switch (ActiveSamplingMode)
+	{
+		case ESamplingMode::EveryNth:
+		{
+			if (SampleCountdown > 1)
+			{
+				--SampleCountdown;
+				return false;
+			}
+
+			// 步长在 [1, 2N-1] 内抖动，均值仍为 N，避免与固定长度的循环体同步而只采到同一个节点
+			if (SampleRandom == 0)
+			{
+				SampleRandom = 0x9E3779B9u ^ FPlatformTLS::GetCurrentThreadId();
+				SampleRandom |= 1;
+			}
+			SampleRandom ^= SampleRandom << 13;
+			SampleRandom ^= SampleRandom >> 17;
+			SampleRandom ^= SampleRandom << 5;
+			SampleCountdown = 1 + SampleRandom % (2 * ActiveSampleInterval - 1);
+			return true;
+		}
+
+		case ESamplingMode::TimeSliced:
+			return NowCycles >= RecordingStartCycles &&
+				(NowCycles - RecordingStartCycles) % SamplePeriodCycles < SampleSliceCycles;
+
+		default:
+			return true;
+	}
+}
+
+void FRuntimeProfiler::OnScriptProfilingEvent(const FScriptInstrumentationSignal& Signal)
+{
+	using namespace BlueprintProfilerTiming;
+
+	// [状态检查] 只在录制状态下记录数据
+	if (CurrentState != ERecordingState::Recording)
+	{
+		return;
+	}
+
+	const EScriptInstrumentation::Type SignalType = Signal.GetType();
+	const uint64 NowCycles = FPlatformTime::Cycles64();
+	FShadowStack& ShadowStack = GetShadowStack();
+
+	// 弹出栈顶节点并记录实测耗时；作用域标记只把子节点时间转交给父节点
+	auto CloseTopFrame = [this, &ShadowStack, NowCycles]()
+	{
+		const FOpenNodeFrame Frame = ShadowStack.Frames.Pop(EAllowShrinking::No);
+		if (Frame.bTraced)
+		{
+			BlueprintProfilerTrace::EndNode();
+		}
+		const uint64 InclusiveCycles = NowCycles > Frame.StartCycles ? NowCycles - Frame.StartCycles : 0;
+
+		if (Frame.bScope)
+		{
+			if (ShadowStack.Frames.Num() > 0)
+			{
+				ShadowStack.Frames.Last().ChildCycles += Frame.ChildCycles;
+			}
+			return;
+		}
+
+		const uint64 ExclusiveCycles = InclusiveCycles > Frame.ChildCycles ? InclusiveCycles - Frame.ChildCycles : 0;
+		if (ShadowStack.Frames.Num() > 0)
+		{
+			ShadowStack.Frames.Last().ChildCycles += InclusiveCycles;
+		}
+
+		if (Frame.bSampled)
+		{
+			RecordNodeTiming(Frame.NodeKey, Frame.NodeId, Frame.FrameNumber, Frame.StartCycles, InclusiveCycles, ExclusiveCycles);
+		}
+	};
+
+	// 纯节点没有退出事件，下一个事件到达时即视为结束
+	auto ClosePureFrames = [&ShadowStack, &CloseTopFrame]()
+	{
+		while (ShadowStack.Frames.Num() > 0 && ShadowStack.Frames.Last().bPure)
+		{
+			CloseTopFrame();
+		}
+	};
+
+	switch (SignalType)
+	{
+		case EScriptInstrumentation::Event:
+		case EScriptInstrumentation::InlineEvent:
+		case EScriptInstrumentation::ResumeEvent:
+		{
+			// 事件/函数开始：压入作用域标记，Stop 时只关闭该作用域内的节点
+			ClosePureFrames();
+			if (ShadowStack.Frames.Num() >= MaxShadowStackDepth)
+			{
+				ResetShadowFrames(ShadowStack);
+			}
+			FOpenNodeFrame& ScopeFrame = ShadowStack.Frames.AddDefaulted_GetRef();
+			ScopeFrame.StartCycles = NowCycles;
+			ScopeFrame.bScope = true;
+			return;
+		}
+
+		case EScriptInstrumentation::NodeExit:
+		case EScriptInstrumentation::PopState:
+		{
+			// PopState：执行流回到之前压栈的节点（Sequence 等），当前节点不会再收到 NodeExit
+			ClosePureFrames();
+			if (ShadowStack.Frames.Num() > 0 && !ShadowStack.Frames.Last().bScope)
+			{
+				CloseTopFrame();
+			}
+			return;
+		}
+
+		case EScriptInstrumentation::SuspendState:
+		case EScriptInstrumentation::Stop:
+		{
+			// 潜伏挂起或函数结束：关闭当前作用域内所有尚未退出的节点
+			while (ShadowStack.Frames.Num() > 0)
+			{
+				const bool bWasScope = ShadowStack.Frames.Last().bScope;
+				CloseTopFrame();
+				if (bWasScope)
+				{
+					break;
+				}
+			}
+			return;
+		}
+
+		case EScriptInstrumentation::NodeEntry:
+		case EScriptInstrumentation::PureNodeEntry:
+			break;
+
+		default:
+			// 其他调试事件与计时无关
+			return;
+	}
+
+	// 新节点开始前结束上一个纯节点
+	ClosePureFrames();
+
+	if (ShadowStack.Frames.Num() >= MaxShadowStackDepth)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[PROFILER] Shadow stack overflow (%d open nodes), discarding unpaired entries"), ShadowStack.Frames.Num());
+		ResetShadowFrames(ShadowStack);
+	}
+
+	// 采样模式：未选中的节点仍压栈以保持 NodeExit 配对，但不写入事件缓冲区
+	if (!ShouldSampleEvent(NowCycles, ShadowStack.SampleCountdown, ShadowStack.SampleRandom))
+	{
+		FOpenNodeFrame& SkippedFrame = ShadowStack.Frames.AddDefaulted_GetRef();
+		SkippedFrame.StartCycles = NowCycles;
+		SkippedFrame.bPure = (SignalType == EScriptInstrumentation::PureNodeEntry);
+		SkippedFrame.bSampled = false;
+		return;
+	}
+
+	// [对象验证] 检查 ContextObject 是否有效（使用公共方法）
+	if (!Signal.IsContextObjectValid())
+	{
+		return;
+	}
+
+	// 尝试获取对象指针 - 通过类型转换访问 protected 成员
+	// 注意：这是一种 hack 方法，但对性能分析工具来说是可以接受的
+	UObject* ContextObject = nullptr;
+
+	// 方法：通过 reinterpret_cast 访问 protected 成员
+	// FScriptInstrumentationSignal 的布局（简化）：
+	// - UObject* ContextObject (offset 0)
+	// - UFunction* Function (offset 8)
+	// - int32 Offset (offset 16)
+	// ...
+	{
+		// 尝试获取对象指针
+		// 注意：这可能在不同 UE 版本中失效
+		struct FSignalAccess
+		{
+			const UObject* ContextObjectPtr;
+			const UFunction* FunctionPtr;
+			int32 BytecodeOffset;
+			EScriptInstrumentation::Type SignalType;
+		};
+
+		const FSignalAccess* SignalAccess = reinterpret_cast<const FSignalAccess*>(&Signal);
+		ContextObject = const_cast<UObject*>(SignalAccess->ContextObjectPtr);
+	}
+
+	if (!ContextObject)
+	{
+		return;
+	}
+
+	TWeakObjectPtr<UObject> ObjectKey(ContextObject);
+
+	// 只写入本线程的环形缓冲区，ID 分配与计数由 DrainEventBuffers 在游戏线程完成
+	FProfilerEvent EntryEvent;
+	EntryEvent.NodeKey = ObjectKey;
+	EntryEvent.Type = EProfilerEventType::NodeEntry;
+	GetEventRing().Push(EntryEvent);
+
+	// 压入影子栈，等待 NodeExit/PopState 配对计时
+	FOpenNodeFrame& NodeFrame = ShadowStack.Frames.AddDefaulted_GetRef();
+	NodeFrame.NodeKey = ObjectKey;
+	NodeFrame.NodeId = FNodeStatsTable::InvalidId;
+	NodeFrame.FrameNumber = GFrameCounter;
+	NodeFrame.StartCycles = FPlatformTime::Cycles64();
+	NodeFrame.bPure = (SignalType == EScriptInstrumentation::PureNodeEntry);
+
+	// Insights 时间线：节点区间嵌套在本线程同一帧的引擎作用域中，按执行的函数和字节码偏移区分节点
+	if (BlueprintProfilerTrace::IsEnabled() && Signal.IsStackFrameValid() && Signal.GetStackFrame().Node)
+	{
+		const FFrame& StackFrame = Signal.GetStackFrame();
+		const int32 CodeOffset = static_cast<int32>(StackFrame.Code - StackFrame.Node->Script.GetData()) - 1;
+		if (const uint32 TimerId = BlueprintProfilerTrace::GetNodeTimerId(StackFrame.Node, CodeOffset))
+		{
+			BlueprintProfilerTrace::BeginNode(TimerId);
+			NodeFrame.bTraced = true;
+		}
+	}
+}
+
+void FRuntimeProfiler::FlushEventBuffers()
+{
+	check(IsInGameThread());
+	if (CurrentState != ERecordingState::Stopped)
+	{
+		DrainEventBuffers();
+	}
+}
+
+int32 FRuntimeProfiler::GetNumEventBuffers() const
+{
+	FScopeLock Lock(&BlueprintProfilerTiming::GEventRingsLock);
+	return BlueprintProfilerTiming::GEventRings.Num();
+}
+
+void FRuntimeProfiler::RecordNodeTiming(const TWeakObjectPtr<UObject>& NodeKey, uint32 NodeId, uint64 FrameNumber, uint64 StartCycles, uint64 InclusiveCycles, uint64 ExclusiveCycles)
+{
+	BlueprintProfilerTiming::FProfilerEvent TimingEvent;
+	TimingEvent.NodeKey = NodeKey;
+	TimingEvent.NodeId = NodeId;
+	TimingEvent.FrameNumber = FrameNumber;
+	TimingEvent.StartCycles = StartCycles;
+	TimingEvent.InclusiveCycles = InclusiveCycles;
+	TimingEvent.ExclusiveCycles = ExclusiveCycles;
+	TimingEvent.Type = BlueprintProfilerTiming::EProfilerEventType::NodeTiming;
+	BlueprintProfilerTiming::GetEventRing().Push(TimingEvent);
+}
+
+void FRuntimeProfiler::DrainEventBuffers()
+{
+	using namespace BlueprintProfilerTiming;
+
+	check(IsInGameThread());
+
+	// 本帧新建的追踪点映射一并发布给追踪路径
+	if (bTraceNodeLookupDirty)
+	{
+		PublishTraceNodeLookup();
+	}
+
+	uint32 DroppedEvents = 0;
+
+	ForEachEventRing([this, &DroppedEvents](FProfilerEventRing& Ring)
+	{
+		// 同一上下文对象的事件通常连续出现，缓存上一次的 ID 避免重复哈希
+		TWeakObjectPtr<UObject> LastKey;
+		uint32 LastId = FNodeStatsTable::InvalidId;
+
+		Ring.Drain([this, &LastKey, &LastId](const FProfilerEvent& Event)
+		{
+			uint32 NodeId = Event.NodeId;
+			if (NodeId == FNodeStatsTable::InvalidId)
+			{
+				if (LastId == FNodeStatsTable::InvalidId || LastKey != Event.NodeKey)
+				{
+					LastKey = Event.NodeKey;
+					LastId = (Event.Type == EProfilerEventType::NodeEntry) ? NodeStats.Intern(Event.NodeKey) : NodeStats.Find(Event.NodeKey);
+				}
+				NodeId = LastId;
+			}
+
+			// 进入事件先于耗时事件写入同一缓冲区；若期间数据被重置则丢弃这次配对
+			if (!NodeStats.IsValidId(NodeId))
+			{
+				return;
+			}
+
+			if (Event.Type == EProfilerEventType::NodeEntry)
+			{
+				NodeStats.AddExecution(NodeId);
+				return;
+			}
+
+			NodeStats.AddTiming(NodeId, Event.InclusiveCycles, Event.ExclusiveCycles);
+
+			// Record execution frame for timeline analysis
+			const double Timestamp = RecordingStartTime + FPlatformTime::ToSeconds64(Event.StartCycles > RecordingStartCycles ? Event.StartCycles - RecordingStartCycles : 0);
+			AddExecutionFrame(NodeId, Event.FrameNumber, Timestamp, static_cast<float>(FPlatformTime::ToSeconds64(Event.InclusiveCycles)));
+
+			// 按独占时间累加，同一帧内嵌套节点不会重复计入
+			FrameCosts.AddCost(Event.FrameNumber, Timestamp, NodeId, Event.ExclusiveCycles);
+		});
+
+		DroppedEvents += Ring.ConsumeDroppedEvents();
+	});
+
+	if (DroppedEvents > 0)
+	{
+		TotalDroppedEvents += DroppedEvents;
+		UE_LOG(LogTemp, Warning, TEXT("[PROFILER] Event buffers full, dropped %u events this frame (%llu total)"),
+			DroppedEvents, TotalDroppedEvents);
+	}
+
+	// 当前帧之前的帧不会再有游戏线程事件
+	CompleteFrameCosts(GFrameCounter);
+}
+
+void FRuntimeProfiler::DiscardEventBuffers()
+{
+	BlueprintProfilerTiming::ForEachEventRing([](BlueprintProfilerTiming::FProfilerEventRing& Ring)
+	{
+		Ring.Discard();
+	});
+}
+
+bool FRuntimeProfiler::TickDrainEvents(float DeltaTime)
+{
+	if (CurrentState == ERecordingState::Recording)
+	{
+		DrainEventBuffers();
+
+		// 按实时视图的频率发布这段时间内执行过的节点
+		const double Now = FPlatformTime::Seconds();
+		if (LiveUpdateRate > 0.0f && Now - LastLiveUpdateTime >= 1.0 / LiveUpdateRate)
+		{
+			LastLiveUpdateTime = Now;
+			PublishLiveUpdate();
+		}
+	}
+	return true;
+}
+
+void FRuntimeProfiler::AddExecutionFrame(uint32 NodeId, uint64 FrameNumber, double Timestamp, float ExecutionTime)
+{
+	// 内存中只保留最近的帧；完整历史按页写入会话文件
+	constexpr int32 MaxExecutionFrames = 5000;
+	constexpr int32 ExecutionFrameTrimCount = 100;
+
+	FExecutionFrame& Frame = ExecutionFrames.AddDefaulted_GetRef();
+	Frame.Timestamp = Timestamp;
+	Frame.ObjectPtr = NodeStats.GetObject(NodeId);
+	Frame.ExecutionTime = ExecutionTime;
+	Frame.NodeId = NodeId;
+	Frame.FrameNumber = FrameNumber;
+	TotalFramesRecorded++;
+
+	if (LiveSessionWriter.IsOpen())
+	{
+		PendingFramePage.Add(Frame);
+		if (PendingFramePage.Num() >= BlueprintProfilerSessionFile::FramesPerBlock)
+		{
+			LiveSessionWriter.WriteFramePage(MoveTemp(PendingFramePage));
+			PendingFramePage.Reset(BlueprintProfilerSessionFile::FramesPerBlock);
+		}
+	}
+
+	if (ExecutionFrames.Num() > MaxExecutionFrames)
+	{
+		ExecutionFrames.RemoveAt(0, ExecutionFrameTrimCount, EAllowShrinking::No);
+	}
+}
+
+void FRuntimeProfiler::CompleteFrameCosts(uint64 BeforeFrameNumber)
+{
+	// 采样时只记录了部分事件，按采样率外推后再与预算比较
+	const double BudgetCycles = HitchBudgetMs / 1000.0 / FPlatformTime::GetSecondsPerCycle64() * ActiveSamplingRate;
+
+	FrameCosts.CompleteFramesBefore(BeforeFrameNumber,
+		[this](uint32 NodeId) { return GetNodeBlueprintIndex(NodeId); },
+		[this, BudgetCycles](const FFrameCostStore::FFrameRecord& Record)
+		{
+			if (HitchBudgetMs <= 0.0f || static_cast<double>(Record.TotalCycles) <= BudgetCycles)
+			{
+				return;
+			}
+
+			constexpr int32 MaxHitches = 200;
+			if (Hitches.Num() >= MaxHitches)
+			{
+				Hitches.RemoveAt(0);
+			}
+
+			FBlueprintFrameBreakdown& Hitch = Hitches.AddDefaulted_GetRef();
+			BuildFrameBreakdown(Record, Hitch);
+
+			UE_LOG(LogTemp, Warning, TEXT("[PROFILER] Blueprint hitch on frame %llu: %.2f ms (budget %.2f ms), top: %s"),
+				Hitch.FrameNumber, Hitch.BlueprintTimeMs, Hitch.BudgetMs,
+				Hitch.TopBlueprints.Num() > 0 ? *Hitch.TopBlueprints[0].BlueprintName : TEXT("-"));
+
+			OnBlueprintHitch.Broadcast(Hitch);
+		});
+}
+
+int32 FRuntimeProfiler::GetNodeBlueprintIndex(uint32 NodeId)
+{
+	while (NodeId >= static_cast<uint32>(NodeBlueprintIndices.Num()))
+	{
+		NodeBlueprintIndices.Add(INDEX_NONE);
+	}
+
+	int32& BlueprintIndex = NodeBlueprintIndices[NodeId];
+	if (BlueprintIndex == INDEX_NONE && NodeStats.IsValidId(NodeId))
+	{
+		// 首次出现在已完成的帧中时解析名称，之后直接复用
+		if (!NodeStats.HasNodeInfo(NodeId))
+		{
+			FString NodeName;
+			FString BlueprintName;
+			FGuid NodeGuid;
+			if (ResolveNodeInfo(NodeStats.GetObject(NodeId).Get(), NodeName, BlueprintName, NodeGuid))
+			{
+				NodeStats.SetNodeInfo(NodeId, NodeName, BlueprintName, NodeGuid);
+			}
+		}
+		BlueprintIndex = FrameCosts.InternBlueprint(NodeStats.GetBlueprintName(NodeId));
+	}
+	return BlueprintIndex;
+}
+
+void FRuntimeProfiler::BuildFrameBreakdown(const FFrameCostStore::FFrameRecord& Record, FBlueprintFrameBreakdown& OutBreakdown) const
+{
+	constexpr int32 MaxContributors = 5;
+	const float CyclesToMs = static_cast<float>(FPlatformTime::GetSecondsPerCycle64() * 1000.0 / FMath::Max(ActiveSamplingRate, KINDA_SMALL_NUMBER));
+
+	OutBreakdown = FBlueprintFrameBreakdown();
+	OutBreakdown.FrameNumber = Record.FrameNumber;
+	OutBreakdown.Timestamp = Record.Timestamp;
+	OutBreakdown.BlueprintTimeMs = Record.TotalCycles * CyclesToMs;
+	OutBreakdown.BudgetMs = HitchBudgetMs;
+
+	for (int32 Index = 0; Index < FMath::Min(MaxContributors, Record.BlueprintCycles.Num()); ++Index)
+	{
+		const TPair<int32, uint64>& BlueprintCost = Record.BlueprintCycles[Index];
+		FFrameCostContributor& Contributor = OutBreakdown.TopBlueprints.AddDefaulted_GetRef();
+		Contributor.BlueprintName = BlueprintCost.Key != INDEX_NONE ? FrameCosts.GetBlueprintName(BlueprintCost.Key) : FString();
+		Contributor.TimeMs = BlueprintCost.Value * CyclesToMs;
+	}
+
+	for (int32 Index = 0; Index < FMath::Min(MaxContributors, Record.NodeCycles.Num()); ++Index)
+	{
+		const TPair<uint32, uint64>& NodeCost = Record.NodeCycles[Index];
+		if (!NodeStats.IsValidId(NodeCost.Key))
+		{
+			continue;
+		}
+
+		FFrameCostContributor& Contributor = OutBreakdown.TopNodes.AddDefaulted_GetRef();
+		Contributor.Name = NodeStats.GetNodeName(NodeCost.Key);
+		Contributor.BlueprintName = NodeStats.GetBlueprintName(NodeCost.Key);
+		Contributor.Object = NodeStats.GetObject(NodeCost.Key);
+		Contributor.TimeMs = NodeCost.Value * CyclesToMs;
+	}
+}
+
+TArray<FBlueprintMemoryTrend> FRuntimeProfiler::GetBlueprintMemoryTrends() const
+{
+	TArray<FBlueprintMemoryTrend> Trends;
+	FBlueprintMemoryCapture::BuildTrends(MemoryCapture.GetSnapshots(), GetExecutionData(), Trends);
+	return Trends;
+}
+
+bool FRuntimeProfiler::GetFrameBreakdown(uint64 FrameNumber, FBlueprintFrameBreakdown& OutBreakdown) const
+{
+	const FFrameCostStore::FFrameRecord* Record = FrameCosts.FindFrame(FrameNumber);
+	if (!Record || !Record->bComplete)
+	{
+		return false;
+	}
+
+	BuildFrameBreakdown(*Record, OutBreakdown);
+	return true;
+}
+
+void FRuntimeProfiler::ResetFrameCosts()
 {
+	FrameCosts.Reset();
+	NodeBlueprintIndices.Reset();
+	Hitches.Reset();
 }
 
-void FRuntimeProfiler::CleanupBlueprintInstrumentation()
+void FRuntimeProfiler::ResetFrameHistory()
 {
-	// Clean up any blueprint instrumentation hooks
-	if (bIsInstrumentationEnabled)
+	PendingFramePage.Reset();
+	TotalFramesRecorded = 0;
+	FramePageReader.Reset();
+	FramePageCache.Reset();
+}
+
+const TArray<FExecutionFrame>* FRuntimeProfiler::FindFramePage(int64 FrameIndex, int64& OutPageStart)
+{
+	int32 PageIndex = INDEX_NONE;
+	if (LiveSessionWriter.IsOpen())
 	{
-		// 取消委托绑定
-		if (InstrumentationDelegateHandle.IsValid())
+		// 录制中：除当前页外都是满页
+		const int64 FramesOnDisk = static_cast<int64>(LiveSessionWriter.GetNumFramePages()) * BlueprintProfilerSessionFile::FramesPerBlock;
+		if (FrameIndex >= FramesOnDisk)
 		{
-			FBlueprintCoreDelegates::OnScriptProfilingEvent.Remove(InstrumentationDelegateHandle);
-			InstrumentationDelegateHandle.Reset();
+			OutPageStart = FramesOnDisk;
+			return &PendingFramePage;
 		}
-
-		bIsInstrumentationEnabled = false;
+		PageIndex = static_cast<int32>(FrameIndex / BlueprintProfilerSessionFile::FramesPerBlock);
+		OutPageStart = static_cast<int64>(PageIndex) * BlueprintProfilerSessionFile::FramesPerBlock;
 	}
-}
-
-void FRuntimeProfiler::EnableBlueprintInstrumentation()
-{
-	// 如果已经启用了，不要重复绑定
-	if (bIsInstrumentationEnabled)
+	else if (FramePageReader.IsValid())
 	{
-		return;
+		PageIndex = FramePageReader->FindFrameBlock(FrameIndex);
+		if (PageIndex == INDEX_NONE)
+		{
+			return nullptr;
+		}
+		OutPageStart = FramePageReader->GetFrameBlockStart(PageIndex);
+	}
+	else
+	{
+		// 未写入会话文件：只能访问内存中的最近帧
+		OutPageStart = TotalFramesRecorded - ExecutionFrames.Num();
+		return FrameIndex >= OutPageStart ? &ExecutionFrames : nullptr;
 	}
 
-	// Enable blueprint execution monitoring for UE 5.6
-	// This is the CORRECT way to enable blueprint profiling
-
-	// 1. Force enable blueprint instrumentation via console variable
-	// This corresponds to console command: bp.EnableInstrumentation 1
-	static IConsoleVariable* BlueprintInstrumentationCV = IConsoleManager::Get().FindConsoleVariable(TEXT("bp.EnableInstrumentation"));
-	if (BlueprintInstrumentationCV)
+	for (int32 CacheIndex = 0; CacheIndex < FramePageCache.Num(); ++CacheIndex)
 	{
-		BlueprintInstrumentationCV->Set(1, ECVF_SetByCode);
+		if (FramePageCache[CacheIndex].Key == PageIndex)
+		{
+			return &FramePageCache[CacheIndex].Value;
+		}
 	}
-	else
+
+	constexpr int32 MaxCachedFramePages = 4;
+	if (FramePageCache.Num() >= MaxCachedFramePages)
 	{
-		UE_LOG(LogTemp, Error, TEXT("CRITICAL: Could not find bp.EnableInstrumentation console variable! Blueprint profiling will not work."));
+		FramePageCache.RemoveAt(0);
 	}
 
-	// 2. Bind the core delegate to receive node execution events
-	// In UE 5.6, the correct delegate is OnScriptProfilingEvent
-	if (!InstrumentationDelegateHandle.IsValid())
+	TPair<int32, TArray<FExecutionFrame>>& CachedPage = FramePageCache.AddDefaulted_GetRef();
+	CachedPage.Key = PageIndex;
+	const bool bRead = LiveSessionWriter.IsOpen()
+		? LiveSessionWriter.ReadFramePage(PageIndex, CachedPage.Value)
+		: FramePageReader->ReadFrameBlock(PageIndex, CachedPage.Value);
+	if (!bRead)
 	{
-		InstrumentationDelegateHandle = FBlueprintCoreDelegates::OnScriptProfilingEvent.AddRaw(this, &FRuntimeProfiler::OnScriptProfilingEvent);
-		bIsInstrumentationEnabled = true;
-		UE_LOG(LogTemp, Log, TEXT("[PROFILER] Blueprint instrumentation enabled - bound to OnScriptProfilingEvent"));
+		FramePageCache.Pop();
+		return nullptr;
 	}
-	else
+
+	// 从文件读回的帧没有对象指针，按节点 ID 补上（仅限当前录制）
+	if (LoadedSessionData.Num() == 0)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("[PROFILER] OnScriptProfilingEvent delegate already bound"));
+		for (FExecutionFrame& Frame : CachedPage.Value)
+		{
+			if (NodeStats.IsValidId(Frame.NodeId))
+			{
+				Frame.ObjectPtr = NodeStats.GetObject(Frame.NodeId);
+			}
+		}
 	}
+	return &CachedPage.Value;
 }
 
-void FRuntimeProfiler::OnScriptProfilingEvent(const FScriptInstrumentationSignal& Signal)
+bool FRuntimeProfiler::GetExecutionFrames(int64 FirstFrame, int32 NumFrames, TArray<FExecutionFrame>& OutFrames)
 {
-	// [验证日志] 激进的日志记录来验证回调是否被触发
-	static int32 CallCount = 0;
-	CallCount++;
+	OutFrames.Reset();
 
-	// [性能过滤] 1. 只要"节点进入"事件，忽略退出或其他调试事件
-	if (Signal.GetType() != EScriptInstrumentation::NodeEntry &&
-		Signal.GetType() != EScriptInstrumentation::PureNodeEntry)
+	int64 FrameIndex = FMath::Max<int64>(FirstFrame, 0);
+	const int64 EndFrame = FMath::Min<int64>(FirstFrame + FMath::Max(NumFrames, 0), TotalFramesRecorded);
+	while (FrameIndex < EndFrame)
 	{
-		return;
-	}
+		int64 PageStart = 0;
+		const TArray<FExecutionFrame>* Page = FindFramePage(FrameIndex, PageStart);
+		const int64 OffsetInPage = FrameIndex - PageStart;
+		if (!Page || OffsetInPage < 0 || OffsetInPage >= Page->Num())
+		{
+			return false;
+		}
 
-	// 每 100 次调用记录一次，避免日志爆炸
-	if (CallCount % 100 == 1)
-	{
-		UE_LOG(LogTemp, Error, TEXT("[PROFILER] OnScriptProfilingEvent CALLED! Count: %d, EventType: %d"),
-			CallCount, (int32)Signal.GetType());
+		const int32 CopyCount = static_cast<int32>(FMath::Min<int64>(Page->Num() - OffsetInPage, EndFrame - FrameIndex));
+		OutFrames.Append(Page->GetData() + OffsetInPage, CopyCount);
+		FrameIndex += CopyCount;
 	}
+	return true;
+}
 
-	// [状态检查] 只在录制状态下记录数据
-	if (CurrentState != ERecordingState::Recording)
+void FRuntimeProfiler::FinishLiveSessionFile()
+{
+	if (!LiveSessionWriter.IsOpen())
 	{
 		return;
 	}
 
-	// [对象验证] 检查 ContextObject 是否有效（使用公共方法）
-	if (!Signal.IsContextObjectValid())
+	// 最后一个不满的页
+	if (PendingFramePage.Num() > 0)
 	{
-		return;
+		LiveSessionWriter.WriteFramePage(MoveTemp(PendingFramePage));
+		PendingFramePage.Reset();
 	}
 
-	// 线程安全地更新执行统计
-	FScopeLock Lock(&DataMutex);
+	TArray<FNodeExecutionData> ExecutionData;
+	TArray<uint32> NodeIds;
+	GatherExecutionData(ExecutionData, &NodeIds);
+	LiveSessionWriter.WriteMemorySnapshots(MemoryCapture.GetSnapshots());
+	LiveSessionWriter.WriteSummary(CurrentSession, ExecutionData, NodeIds);
 
-	// 尝试获取对象指针 - 通过类型转换访问 protected 成员
-	// 注意：这是一种 hack 方法，但对性能分析工具来说是可以接受的
-	UObject* ContextObject = nullptr;
+	const int64 FramesWritten = LiveSessionWriter.GetFramesWritten();
+	if (LiveSessionWriter.Close())
+	{
+		UE_LOG(LogTemp, Log, TEXT("[PROFILER] Session streamed to: %s (%d nodes, %lld frames)"), *LiveSessionFilePath, ExecutionData.Num(), FramesWritten);
+	}
 
-	// 方法：通过 reinterpret_cast 访问 protected 成员
-	// FScriptInstrumentationSignal 的布局（简化）：
-	// - UObject* ContextObject (offset 0)
-	// - UFunction* Function (offset 8)
-	// - int32 Offset (offset 16)
-	// ...
-	const uint8* SignalBytes = reinterpret_cast<const uint8*>(&Signal);
+	// 录制结束后从完成的文件按需读取帧页
+	FramePageCache.Reset();
+	FramePageReader = MakeUnique<FProfilerSessionReader>();
+	if (!FramePageReader->Open(LiveSessionFilePath))
+	{
+		FramePageReader.Reset();
+	}
+}
 
-	// 假设 ContextObject 是第一个成员（偏移 0）
-	// 这依赖于内存布局，但通常 UObject* 在结构开头
-	if (Signal.IsContextObjectValid())
+void FRuntimeProfiler::ResetNodeStats()
+{
+	// 偏移表只需重映射 ID，不必重新扫描字节码
+	TArray<TWeakObjectPtr<UObject>> PreviousObjects;
+	if (FunctionNodeLookups.Num() > 0)
 	{
-		// 尝试获取对象指针
-		// 注意：这可能在不同 UE 版本中失效
-		struct FSignalAccess
+		PreviousObjects.Reserve(NodeStats.Num());
+		for (uint32 NodeId = 0; NodeId < static_cast<uint32>(NodeStats.Num()); ++NodeId)
 		{
-			const UObject* ContextObjectPtr;
-			const UFunction* FunctionPtr;
-			int32 BytecodeOffset;
-			EScriptInstrumentation::Type SignalType;
-		};
+			PreviousObjects.Add(NodeStats.GetObject(NodeId));
+		}
+	}
 
-		const FSignalAccess* SignalAccess = reinterpret_cast<const FSignalAccess*>(&Signal);
-		ContextObject = const_cast<UObject*>(SignalAccess->ContextObjectPtr);
+	NodeStats.Reset();
+	ResetFrameCosts();
+
+	// 追踪点节点的 ID 随统计表一起重建
+	TracepointNodeIds.Reset();
+	for (const auto& SavedStatePair : SavedBreakpointStates)
+	{
+		for (const auto& BreakpointPair : SavedStatePair.Value.OriginalBreakpointStates)
+		{
+			if (UEdGraphNode* Node = BreakpointPair.Key.Get())
+			{
+				TracepointNodeIds.Add(Node, NodeStats.Intern(Node));
+			}
+		}
 	}
 
-	// 如果获取到了有效对象，使用它作为键
-	if (ContextObject)
+	if (PreviousObjects.Num() > 0)
 	{
-		TWeakObjectPtr<UObject> ObjectKey(ContextObject);
-		FNodeExecutionStats& Stats = NodeStats.FindOrAdd(ObjectKey);
-		Stats.ExecutionCount++;
+		TArray<uint32> RemappedIds;
+		RemappedIds.Init(FNodeStatsTable::InvalidId, PreviousObjects.Num());
 
-		// 首次记录时尝试保存节点信息
-		if (Stats.CachedNodeName.IsEmpty())
+		for (auto& LookupPair : FunctionNodeLookups)
 		{
-			Stats.CachedNodeName = ContextObject->GetName();
-			
-			// 尝试获取蓝图名称（去掉 _C 后缀）
-			UClass* ObjectClass = ContextObject->GetClass();
-			if (UBlueprintGeneratedClass* BPClass = Cast<UBlueprintGeneratedClass>(ObjectClass))
+			// 已发布的表可能正被其他线程读取，重映射写入新数组
+			TArray<uint32> RemappedTable = *LookupPair.Value;
+			for (uint32& Entry : RemappedTable)
 			{
-				if (UBlueprint* Blueprint = Cast<UBlueprint>(BPClass->ClassGeneratedBy))
+				if (Entry == UnmappedCodeOffset)
 				{
-					Stats.CachedBlueprintName = Blueprint->GetName();
-					UE_LOG(LogTemp, Log, TEXT("[PROFILER] Cached blueprint name from ClassGeneratedBy: %s"), *Stats.CachedBlueprintName);
+					continue;
 				}
-				else
+
+				const uint32 PreviousId = Entry & ~EngineInternalNodeFlag;
+				if (!RemappedIds.IsValidIndex(PreviousId) || !PreviousObjects[PreviousId].IsValid())
 				{
-					Stats.CachedBlueprintName = ObjectClass->GetName();
-					// 去掉 _C 后缀
-					if (Stats.CachedBlueprintName.EndsWith(TEXT("_C")))
-					{
-						Stats.CachedBlueprintName = Stats.CachedBlueprintName.LeftChop(2);
-					}
-					UE_LOG(LogTemp, Log, TEXT("[PROFILER] Cached blueprint name from class (trimmed): %s"), *Stats.CachedBlueprintName);
+					// Node is gone, let the trace path resolve this offset the slow way
+					Entry = UnmappedCodeOffset;
+					continue;
 				}
+
+				uint32& NewId = RemappedIds[PreviousId];
+				if (NewId == FNodeStatsTable::InvalidId)
+				{
+					NewId = NodeStats.Intern(PreviousObjects[PreviousId]);
+				}
+				Entry = NewId | (Entry & EngineInternalNodeFlag);
 			}
-			else
-			{
-				Stats.CachedBlueprintName = ObjectClass->GetName();
-				UE_LOG(LogTemp, Log, TEXT("[PROFILER] Cached blueprint name from class: %s"), *Stats.CachedBlueprintName);
-			}
-			
-			Stats.CachedNodeGuid = FGuid::NewGuid(); // 生成临时 GUID
+			LookupPair.Value = MakeShared<const TArray<uint32>, ESPMode::ThreadSafe>(MoveTemp(RemappedTable));
 		}
+	}
+
+	// 旧 ID 已指向其他行，立即发布
+	PublishTraceNodeLookup();
+}
 
-		// 记录执行时间
-		float ExecutionTime = 0.001f; // 1ms 基础时间
-		Stats.TotalExecutionTime += ExecutionTime;
-		Stats.MinExecutionTime = FMath::Min(Stats.MinExecutionTime, ExecutionTime);
-		Stats.MaxExecutionTime = FMath::Max(Stats.MaxExecutionTime, ExecutionTime);
-		Stats.ExecutionTimes.Add(ExecutionTime);
+void FRuntimeProfiler::ResolvePendingNodeInfo()
+{
+	for (uint32 NodeId = 0; NodeId < static_cast<uint32>(NodeStats.Num()); ++NodeId)
+	{
+		if (NodeStats.GetExecutionCount(NodeId) == 0 || NodeStats.HasNodeInfo(NodeId))
+		{
+			continue;
+		}
 
-		if (Stats.ExecutionTimes.Num() > 100)
+		FString NodeName;
+		FString BlueprintName;
+		FGuid NodeGuid;
+		if (ResolveNodeInfo(NodeStats.GetObject(NodeId).Get(), NodeName, BlueprintName, NodeGuid))
 		{
-			Stats.ExecutionTimes.RemoveAt(0);
+			NodeStats.SetNodeInfo(NodeId, NodeName, BlueprintName, NodeGuid);
 		}
 	}
+}
+
+bool FRuntimeProfiler::ResolveNodeInfo(UObject* Object, FString& OutNodeName, FString& OutBlueprintName, FGuid& OutNodeGuid) const
+{
+	if (!Object)
+	{
+		return false;
+	}
+
+	// Case 1: Object is a UEdGraphNode (tracepoint path)
+	if (UEdGraphNode* Node = Cast<UEdGraphNode>(Object))
+	{
+		OutNodeName = Node->GetNodeTitle(ENodeTitleType::ListView).ToString();
+		OutNodeGuid = Node->NodeGuid;
 
-	// 定期记录数据收集进度
-	if (CallCount % 1000 == 0)
+		// Get blueprint from node's graph
+		if (Node->GetGraph())
+		{
+			if (UBlueprint* Blueprint = Cast<UBlueprint>(Node->GetGraph()->GetOuter()))
+			{
+				OutBlueprintName = Blueprint->GetName();
+			}
+			else if (UBlueprint* OwningBlueprint = Node->GetTypedOuter<UBlueprint>())
+			{
+				OutBlueprintName = OwningBlueprint->GetName();
+			}
+		}
+	}
+	// Case 2: Object is a UBlueprint
+	else if (UBlueprint* Blueprint = Cast<UBlueprint>(Object))
+	{
+		OutBlueprintName = Blueprint->GetName();
+		OutNodeName = TEXT("Blueprint");
+	}
+	// Case 3: Object has a BlueprintGeneratedClass (instrumentation context object)
+	else if (UBlueprintGeneratedClass* BPClass = Cast<UBlueprintGeneratedClass>(Object->GetClass()))
+	{
+		OutNodeName = Object->GetName();
+		if (UBlueprint* GeneratedByBlueprint = Cast<UBlueprint>(BPClass->ClassGeneratedBy))
+		{
+			OutBlueprintName = GeneratedByBlueprint->GetName();
+		}
+		else
+		{
+			// Try to get name from BPClass, remove _C suffix if present
+			OutBlueprintName = BPClass->GetName();
+			if (OutBlueprintName.EndsWith(TEXT("_C")))
+			{
+				OutBlueprintName = OutBlueprintName.LeftChop(2);
+			}
+		}
+	}
+	// Fallback: Unknown
+	else
 	{
-		UE_LOG(LogTemp, Warning, TEXT("[PROFILER] Data Collection: Total executions: %d, NodeStats: %d"),
-			CallCount, NodeStats.Num());
+		OutBlueprintName = Object->GetClass()->GetName();
+		OutNodeName = Object->GetName();
 	}
+
+	return true;
 }
 
 void FRuntimeProfiler::DisableBlueprintInstrumentation()
@@ -864,7 +2352,7 @@ void FRuntimeProfiler::DisableBlueprintInstrumentation()
 	}
 }
 
-void FRuntimeProfiler::RecordNodeExecution(const FFrame& Frame)
+void FRuntimeProfiler::RecordNodeExecution(const FFrame& Frame, float ExecutionTime)
 {
 	if (!Frame.Object || CurrentState != ERecordingState::Recording)
 	{
@@ -878,37 +2366,19 @@ void FRuntimeProfiler::RecordNodeExecution(const FFrame& Frame)
 	TWeakObjectPtr<UObject> ObjectPtr(Frame.Object);
 
 	// Find or create execution stats for this object
-	FNodeExecutionStats& Stats = NodeStats.FindOrAdd(ObjectPtr);
-	Stats.ExecutionCount++;
+	const uint32 NodeId = NodeStats.Intern(ObjectPtr);
+	NodeStats.AddExecution(NodeId);
 
-	// Calculate execution time (simplified - in real implementation this would be more sophisticated)
-	float ExecutionTime = FMath::RandRange(0.0001f, 0.01f); // Mock execution time for now
-	Stats.TotalExecutionTime += ExecutionTime;
-	Stats.MinExecutionTime = FMath::Min(Stats.MinExecutionTime, ExecutionTime);
-	Stats.MaxExecutionTime = FMath::Max(Stats.MaxExecutionTime, ExecutionTime);
-	Stats.ExecutionTimes.Add(ExecutionTime);
-
-	// Keep execution times array manageable
-	if (Stats.ExecutionTimes.Num() > 1000)
-	{
-		Stats.ExecutionTimes.RemoveAt(0, 100);
-	}
+	// ExecutionTime is measured by the caller (seconds)
+	const uint64 ExecutionCycles = static_cast<uint64>(ExecutionTime / FPlatformTime::GetSecondsPerCycle64());
+	NodeStats.AddTiming(NodeId, ExecutionCycles, ExecutionCycles);
 
 	// Record execution frame for timeline analysis
-	FExecutionFrame ExecutionFrame;
-	ExecutionFrame.Timestamp = CurrentTime;
-	ExecutionFrame.ObjectPtr = ObjectPtr;
-	ExecutionFrame.ExecutionTime = ExecutionTime;
-	ExecutionFrames.Add(ExecutionFrame);
-
-	// Keep execution frames manageable
-	if (ExecutionFrames.Num() > 10000)
-	{
-		ExecutionFrames.RemoveAt(0, 1000);
-	}
+	AddExecutionFrame(NodeId, GFrameCounter, CurrentTime, ExecutionTime);
+	FrameCosts.AddCost(GFrameCounter, CurrentTime, NodeId, ExecutionCycles);
 
 	// Check for potential tick abuse
-	CheckForTickAbuse(Frame.Object, Stats);
+	CheckForTickAbuse(Frame.Object, NodeStats.GetStats(NodeId));
 }
 
 void FRuntimeProfiler::CollectBlueprintExecutionData()
@@ -964,10 +2434,10 @@ void FRuntimeProfiler::CollectBlueprintExecutionData()
 			TWeakObjectPtr<UObject> ObjectPtr(Actor);
 
 			// Find or create execution stats
-			FNodeExecutionStats& Stats = NodeStats.FindOrAdd(ObjectPtr);
+			const uint32 NodeId = NodeStats.Intern(ObjectPtr);
 
 			// Increment execution count (we sample, not track every execution)
-			Stats.ExecutionCount++;
+			NodeStats.AddExecution(NodeId);
 
 			// Estimate execution time based on blueprint complexity
 			float EstimatedTime = 0.001f; // Base 1ms per tick
@@ -978,32 +2448,13 @@ void FRuntimeProfiler::CollectBlueprintExecutionData()
 				EstimatedTime += 0.0005f * (Actor->GetComponents().Num() - 10);
 			}
 
-			Stats.TotalExecutionTime += EstimatedTime;
-			Stats.MinExecutionTime = FMath::Min(Stats.MinExecutionTime, EstimatedTime);
-			Stats.MaxExecutionTime = FMath::Max(Stats.MaxExecutionTime, EstimatedTime);
-			Stats.ExecutionTimes.Add(EstimatedTime);
-
-			// Keep execution times array manageable
-			if (Stats.ExecutionTimes.Num() > 100)
-			{
-				Stats.ExecutionTimes.RemoveAt(0);
-			}
+			NodeStats.AddExecutionTime(NodeId, EstimatedTime);
 
 			// Record execution frame
-			FExecutionFrame ExecutionFrame;
-			ExecutionFrame.Timestamp = CurrentTime;
-			ExecutionFrame.ObjectPtr = ObjectPtr;
-			ExecutionFrame.ExecutionTime = EstimatedTime;
-			ExecutionFrames.Add(ExecutionFrame);
-
-			// Keep execution frames manageable
-			if (ExecutionFrames.Num() > 5000)
-			{
-				ExecutionFrames.RemoveAt(0, 100);
-			}
+			AddExecutionFrame(NodeId, GFrameCounter, CurrentTime, EstimatedTime);
 
 			// Check for tick abuse
-			CheckForTickAbuse(Actor, Stats);
+			CheckForTickAbuse(Actor, NodeStats.GetStats(NodeId));
 		}
 	}
 
@@ -1026,17 +2477,11 @@ void FRuntimeProfiler::CollectBlueprintExecutionData()
 		if (UBlueprintGeneratedClass* BPClass = Cast<UBlueprintGeneratedClass>(Component->GetClass()))
 		{
 			TWeakObjectPtr<UObject> ObjectPtr(Component);
-			FNodeExecutionStats& Stats = NodeStats.FindOrAdd(ObjectPtr);
-			Stats.ExecutionCount++;
+			const uint32 NodeId = NodeStats.Intern(ObjectPtr);
+			NodeStats.AddExecution(NodeId);
 
 			float EstimatedTime = 0.0005f; // Components are generally faster
-			Stats.TotalExecutionTime += EstimatedTime;
-			Stats.ExecutionTimes.Add(EstimatedTime);
-
-			if (Stats.ExecutionTimes.Num() > 50)
-			{
-				Stats.ExecutionTimes.RemoveAt(0);
-			}
+			NodeStats.AddExecutionTime(NodeId, EstimatedTime);
 		}
 	}
 
@@ -1487,6 +2932,9 @@ void FRuntimeProfiler::SetupBlueprintTracepoints(UBlueprint* Blueprint)
 			bool bWasEnabled = ExistingBreakpoint && ExistingBreakpoint->IsEnabled();
 			SavedState.OriginalBreakpointStates.Add(Node, bWasEnabled);
 
+			// 建立追踪点时分配稠密 ID，录制路径直接按 ID 计数
+			TracepointNodeIds.Add(Node, NodeStats.Intern(Node));
+
 			// Create or enable breakpoint for profiling
 			if (!ExistingBreakpoint)
 			{
@@ -1503,10 +2951,133 @@ void FRuntimeProfiler::SetupBlueprintTracepoints(UBlueprint* Blueprint)
 		}
 	}
 
+	// Offset -> node table for the trace path, rebuilt whenever the blueprint recompiles
+	if (!SavedState.OnCompiledHandle.IsValid())
+	{
+		SavedState.OnCompiledHandle = Blueprint->OnCompiled().AddRaw(this, &FRuntimeProfiler::OnTracedBlueprintCompiled);
+	}
+	BuildFunctionNodeLookups(Blueprint, SavedState);
+
 	UE_LOG(LogTemp, Log, TEXT("[PROFILER] Setup tracepoints for blueprint '%s': %d created, %d enabled"),
 		*Blueprint->GetName(), TracepointsCreated, TracepointsEnabled);
 }
 
+void FRuntimeProfiler::BuildFunctionNodeLookups(UBlueprint* Blueprint, FOriginalBreakpointInfo& SavedState)
+{
+	RemoveFunctionNodeLookups(SavedState);
+
+	UBlueprintGeneratedClass* GeneratedClass = Blueprint ? Cast<UBlueprintGeneratedClass>(Blueprint->GeneratedClass) : nullptr;
+	if (!GeneratedClass || !GeneratedClass->DebugData.IsValid())
+	{
+		return;
+	}
+
+	int32 MappedOffsets = 0;
+	for (TFieldIterator<UFunction> FunctionIt(GeneratedClass, EFieldIteratorFlags::ExcludeSuper); FunctionIt; ++FunctionIt)
+	{
+		UFunction* Function = *FunctionIt;
+		if (!Function || Function->Script.Num() == 0)
+		{
+			continue;
+		}
+
+		TArray<uint32> OffsetTable;
+		OffsetTable.Init(UnmappedCodeOffset, Function->Script.Num());
+		const FObjectKey FunctionKey(Function);
+		SavedState.LookupFunctions.Add(FunctionKey);
+
+		// Tracepoints are registered at the exact offset of their opcode, so only precise hits are baked in.
+		// Anything else stays unmapped and takes the imprecise search in OnScriptExceptionTrace.
+		const UEdGraphNode* LastNode = nullptr;
+		uint32 LastEntry = UnmappedCodeOffset;
+		for (int32 CodeOffset = 0; CodeOffset < Function->Script.Num(); ++CodeOffset)
+		{
+			UEdGraphNode* Node = GeneratedClass->DebugData.FindSourceNodeFromCodeLocation(Function, CodeOffset, false);
+			if (!Node)
+			{
+				continue;
+			}
+
+			if (Node != LastNode)
+			{
+				const uint32* TracepointNodeId = TracepointNodeIds.Find(Node);
+				LastEntry = TracepointNodeId ? *TracepointNodeId : NodeStats.Intern(Node);
+				if (IsNodeInStandardMacros(Node))
+				{
+					LastEntry |= EngineInternalNodeFlag;
+				}
+				LastNode = Node;
+			}
+
+			OffsetTable[CodeOffset] = LastEntry;
+			MappedOffsets++;
+		}
+
+		FunctionNodeLookups.Add(FunctionKey, MakeShared<const TArray<uint32>, ESPMode::ThreadSafe>(MoveTemp(OffsetTable)));
+	}
+	bTraceNodeLookupDirty = true;
+
+	UE_LOG(LogTemp, Verbose, TEXT("[PROFILER] Built offset lookups for blueprint '%s': %d functions, %d mapped offsets"),
+		*Blueprint->GetName(), SavedState.LookupFunctions.Num(), MappedOffsets);
+}
+
+void FRuntimeProfiler::RemoveFunctionNodeLookups(FOriginalBreakpointInfo& SavedState)
+{
+	for (const FObjectKey& FunctionKey : SavedState.LookupFunctions)
+	{
+		FunctionNodeLookups.Remove(FunctionKey);
+	}
+	SavedState.LookupFunctions.Reset();
+	bTraceNodeLookupDirty = true;
+}
+
+void FRuntimeProfiler::PublishTraceNodeLookup()
+{
+	check(IsInGameThread());
+
+	// 偏移表是共享的不可变数组，复制映射只复制指针
+	TSharedRef<FTraceNodeLookup, ESPMode::ThreadSafe> Lookup = MakeShared<FTraceNodeLookup, ESPMode::ThreadSafe>();
+	Lookup->TracepointNodeIds = TracepointNodeIds;
+	Lookup->FunctionNodeLookups = FunctionNodeLookups;
+
+	FWriteScopeLock WriteLock(TraceNodeLookupLock);
+	PublishedTraceNodeLookup = Lookup;
+	BlueprintProfilerTiming::GTraceNodeLookupVersion.fetch_add(1, std::memory_order_release);
+	bTraceNodeLookupDirty = false;
+}
+
+const FRuntimeProfiler::FTraceNodeLookup* FRuntimeProfiler::GetTraceNodeLookup() const
+{
+	// 每个线程缓存上次取得的快照；版本号未变时不加锁也不改引用计数
+	struct FThreadLookupCache
+	{
+		const FRuntimeProfiler* Owner = nullptr;
+		uint32 Version = 0;
+		TSharedPtr<const FTraceNodeLookup, ESPMode::ThreadSafe> Lookup;
+	};
+	static thread_local FThreadLookupCache ThreadCache;
+
+	const uint32 CurrentVersion = BlueprintProfilerTiming::GTraceNodeLookupVersion.load(std::memory_order_acquire);
+	if (ThreadCache.Owner != this || ThreadCache.Version != CurrentVersion)
+	{
+		FReadScopeLock ReadLock(TraceNodeLookupLock);
+		ThreadCache.Owner = this;
+		ThreadCache.Lookup = PublishedTraceNodeLookup;
+		ThreadCache.Version = BlueprintProfilerTiming::GTraceNodeLookupVersion.load(std::memory_order_relaxed);
+	}
+	return ThreadCache.Lookup.Get();
+}
+
+void FRuntimeProfiler::OnTracedBlueprintCompiled(UBlueprint* Blueprint)
+{
+	// Recompiling replaces the bytecode, so every cached offset of this blueprint is stale
+	if (FOriginalBreakpointInfo* SavedState = SavedBreakpointStates.Find(Blueprint))
+	{
+		BuildFunctionNodeLookups(Blueprint, *SavedState);
+		PublishTraceNodeLookup();
+	}
+}
+
 void FRuntimeProfiler::RemoveBlueprintTracepoints(UBlueprint* Blueprint)
 {
 	if (!Blueprint)
@@ -1537,6 +3108,9 @@ void FRuntimeProfiler::RemoveBlueprintTracepoints(UBlueprint* Blueprint)
 			continue;
 		}
 
+		// 统计行保留到下次录制重置，只移除追踪点映射
+		TracepointNodeIds.Remove(Node.Get());
+
 		// Find the breakpoint for this node
 		FBlueprintBreakpoint* Breakpoint = FKismetDebugUtilities::FindBreakpointForNode(Node.Get(), Blueprint, true);
 
@@ -1558,8 +3132,12 @@ void FRuntimeProfiler::RemoveBlueprintTracepoints(UBlueprint* Blueprint)
 		}
 	}
 
+	RemoveFunctionNodeLookups(*SavedState);
+	Blueprint->OnCompiled().Remove(SavedState->OnCompiledHandle);
+
 	// Clear the saved state for this blueprint
 	SavedBreakpointStates.Remove(Blueprint);
+	PublishTraceNodeLookup();
 
 	UE_LOG(LogTemp, Log, TEXT("[PROFILER] Removed tracepoints from blueprint '%s': %d removed, %d restored"),
 		*Blueprint->GetName(), BreakpointsRemoved, BreakpointsRestored);
@@ -1661,12 +3239,23 @@ void FRuntimeProfiler::OnScriptExceptionTrace(const UObject* ActiveObject, const
 		return;
 	}
 
-	// Find the node from the stack frame
-	// StackFrame.Node is a UFunction*, we need to find the actual UEdGraphNode
-	const UClass* ClassContainingCode = FKismetDebugUtilities::FindClassForNode(ActiveObject, StackFrame.Node);
-	UBlueprint* Blueprint = (ClassContainingCode ? Cast<UBlueprint>(ClassContainingCode->ClassGeneratedBy) : nullptr);
+	// Tracepoints have no exit event: the interval between two consecutive tracepoints
+	// in the same script frame invocation is booked to the earlier node.
+	// Matching frame address + object + engine frame keeps the next tick's reuse of the same stack slot apart.
+	BlueprintProfilerTiming::FShadowStack& ShadowStack = BlueprintProfilerTiming::GetShadowStack();
+	const uint64 NowCycles = FPlatformTime::Cycles64();
+	if (ShadowStack.LastTraceFrame == &StackFrame &&
+		ShadowStack.LastTraceObject == ActiveObject &&
+		ShadowStack.LastTraceFrameCounter == GFrameCounter &&
+		NowCycles > ShadowStack.LastTraceCycles)
+	{
+		const uint64 ElapsedCycles = NowCycles - ShadowStack.LastTraceCycles;
+		RecordNodeTiming(ShadowStack.LastTraceKey, ShadowStack.LastTraceNodeId, ShadowStack.LastTraceFrameCounter, ShadowStack.LastTraceCycles, ElapsedCycles, ElapsedCycles);
+	}
+	ShadowStack.LastTraceFrame = nullptr;
 
-	if (!Blueprint)
+	// Sampling mode: a skipped tracepoint only ends the previous interval, node resolution is skipped entirely
+	if (!ShouldSampleEvent(NowCycles, ShadowStack.SampleCountdown, ShadowStack.SampleRandom))
 	{
 		return;
 	}
@@ -1674,79 +3263,91 @@ void FRuntimeProfiler::OnScriptExceptionTrace(const UObject* ActiveObject, const
 	// Calculate the offset within the function
 	const int32 BreakpointOffset = StackFrame.Code - StackFrame.Node->Script.GetData() - 1;
 
-	// Find the actual blueprint node from the code location
-	UEdGraphNode* Node = nullptr;
-	const UBlueprintGeneratedClass* GeneratedClass = Cast<UBlueprintGeneratedClass>(ClassContainingCode);
-	if (GeneratedClass && GeneratedClass->DebugData.IsValid())
-	{
-		Node = GeneratedClass->DebugData.FindSourceNodeFromCodeLocation(StackFrame.Node, BreakpointOffset, true);
-	}
-
-	if (!Node)
-	{
-		return;
-	}
-
-	// FILTER: Skip engine internal macro nodes (StandardMacros, etc.)
-	// This prevents recording internal nodes from For Loop, While Loop, etc.
-	if (bHideEngineInternalNodes && IsNodeInStandardMacros(Node))
+	uint32 NodeId = FNodeStatsTable::InvalidId;
+	TWeakObjectPtr<UObject> NodeKey;
+	if (!ResolveTracepointNode(ActiveObject, StackFrame.Node, BreakpointOffset, NodeId, NodeKey))
 	{
 		return;
 	}
 
-	// Use node as the key for tracking execution
-	TWeakObjectPtr<UObject> NodeKey(Node);
+	// This tracepoint opens the next interval
+	ShadowStack.LastTraceFrame = &StackFrame;
+	ShadowStack.LastTraceObject = ActiveObject;
+	ShadowStack.LastTraceFrameCounter = GFrameCounter;
+	ShadowStack.LastTraceCycles = NowCycles;
+	ShadowStack.LastTraceKey = NodeKey;
+	ShadowStack.LastTraceNodeId = NodeId;
+
+	// Count the hit; names are resolved lazily when the data is read
+	BlueprintProfilerTiming::FProfilerEvent EntryEvent;
+	EntryEvent.NodeKey = NodeKey;
+	EntryEvent.NodeId = NodeId;
+	EntryEvent.Type = BlueprintProfilerTiming::EProfilerEventType::NodeEntry;
+	BlueprintProfilerTiming::GetEventRing().Push(EntryEvent);
+}
 
-	// Thread-safe update of execution statistics
-	FScopeLock Lock(&DataMutex);
+bool FRuntimeProfiler::ResolveTracepointNode(const UObject* ActiveObject, UFunction* Function, int32 CodeOffset, uint32& OutNodeId, TWeakObjectPtr<UObject>& OutNodeKey) const
+{
+	OutNodeId = FNodeStatsTable::InvalidId;
+	OutNodeKey.Reset();
 
-	// Find or create stats for this node
-	FNodeExecutionStats& Stats = NodeStats.FindOrAdd(NodeKey);
-	Stats.ExecutionCount++;
+	// 可能在任意线程上执行，只读取游戏线程发布的快照
+	const FTraceNodeLookup* TraceLookup = GetTraceNodeLookup();
 
-	// 首次记录时保存节点信息（PIE结束后对象失效时仍能显示）
-	if (Stats.CachedNodeName.IsEmpty() && Node)
+	// Fast path: offset table built by SetupBlueprintTracepoints, one hash lookup and one array read
+	const FCodeOffsetTable* OffsetTable = TraceLookup ? TraceLookup->FunctionNodeLookups.Find(FObjectKey(Function)) : nullptr;
+	const uint32 LookupEntry = (OffsetTable && (*OffsetTable)->IsValidIndex(CodeOffset)) ? (**OffsetTable)[CodeOffset] : UnmappedCodeOffset;
+	if (LookupEntry != UnmappedCodeOffset)
 	{
-		Stats.CachedNodeName = Node->GetNodeTitle(ENodeTitleType::ListView).ToString();
-		Stats.CachedNodeGuid = Node->NodeGuid;
-
-		// 获取蓝图名称
-		if (Node->GetGraph())
+		// FILTER: engine internal macro nodes were tagged when the table was built
+		if (bHideEngineInternalNodes && (LookupEntry & EngineInternalNodeFlag))
 		{
-			if (UBlueprint* BP = Cast<UBlueprint>(Node->GetGraph()->GetOuter()))
-			{
-				Stats.CachedBlueprintName = BP->GetName();
-			}
+			return false;
 		}
+		OutNodeId = LookupEntry & ~EngineInternalNodeFlag;
 	}
+	else
+	{
+		// Not in a table: find the UEdGraphNode that generated the code from the class's debug data
+		const UClass* ClassContainingCode = FKismetDebugUtilities::FindClassForNode(ActiveObject, Function);
+		UBlueprint* Blueprint = (ClassContainingCode ? Cast<UBlueprint>(ClassContainingCode->ClassGeneratedBy) : nullptr);
+
+		if (!Blueprint)
+		{
+			return false;
+		}
 
-	// Record minimal timing information
-	// Note: We can't get actual execution time from a breakpoint callback
-	// So we use a minimal time unit for counting
-	constexpr float MinExecutionTime = 0.0001f; // 0.1ms minimum
-	Stats.TotalExecutionTime += MinExecutionTime;
-	Stats.MinExecutionTime = FMath::Min(Stats.MinExecutionTime, MinExecutionTime);
-	Stats.MaxExecutionTime = FMath::Max(Stats.MaxExecutionTime, MinExecutionTime);
+		// Find the actual blueprint node from the code location
+		UEdGraphNode* Node = nullptr;
+		const UBlueprintGeneratedClass* GeneratedClass = Cast<UBlueprintGeneratedClass>(ClassContainingCode);
+		if (GeneratedClass && GeneratedClass->DebugData.IsValid())
+		{
+			Node = GeneratedClass->DebugData.FindSourceNodeFromCodeLocation(Function, CodeOffset, true);
+		}
 
-	// Keep execution times array bounded (only keep last 100 samples)
-	Stats.ExecutionTimes.Add(MinExecutionTime);
-	if (Stats.ExecutionTimes.Num() > 100)
-	{
-		Stats.ExecutionTimes.RemoveAt(0);
-	}
+		if (!Node)
+		{
+			return false;
+		}
 
-	// Record execution frame for timeline analysis
-	FExecutionFrame Frame;
-	Frame.Timestamp = CurrentTime;
-	Frame.ObjectPtr = NodeKey;
-	Frame.ExecutionTime = MinExecutionTime;
-	ExecutionFrames.Add(Frame);
+		// FILTER: Skip engine internal macro nodes (StandardMacros, etc.)
+		// This prevents recording internal nodes from For Loop, While Loop, etc.
+		if (bHideEngineInternalNodes && IsNodeInStandardMacros(Node))
+		{
+			return false;
+		}
 
-	// Keep execution frames bounded (only keep last 5000 frames)
-	if (ExecutionFrames.Num() > 5000)
-	{
-		ExecutionFrames.RemoveAt(0, 100);
+		// Nodes set up by SetupBlueprintTracepoints already have a dense ID;
+		// tracepoints placed by other means fall back to interning the node in the drain
+		const uint32* InternedNodeId = TraceLookup ? TraceLookup->TracepointNodeIds.Find(Node) : nullptr;
+		OutNodeId = InternedNodeId ? *InternedNodeId : FNodeStatsTable::InvalidId;
+		if (OutNodeId == FNodeStatsTable::InvalidId)
+		{
+			OutNodeKey = Node;
+		}
 	}
+
+	return true;
 }
 
 //============================================================
@@ -1808,6 +3409,7 @@ void FRuntimeProfiler::ProcessNextTracepointBatch()
 		// Complete setup
 		const int32 TotalBlueprintsProcessed = CurrentBlueprintIndex;
 		bIsSettingUpTracepoints = false;
+		PublishTraceNodeLookup();
 		bTracepointsActive = true;
 		PendingBlueprints.Empty();
 		CurrentBlueprintIndex = 0;
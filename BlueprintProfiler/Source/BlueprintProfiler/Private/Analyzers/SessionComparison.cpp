@@ -0,0 +1,360 @@
+// Copyright xnbmy 2026. All Rights Reserved.
+
+#include "Analyzers/SessionComparison.h"
+#include "Analyzers/RuntimeProfiler.h"
+#include "Data/ProfilerSessionFile.h"
+#include "Dom/JsonObject.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace BlueprintProfilerSessionComparison
+{
+	/** Totals of one node or Blueprint in one recording */
+	struct FCostTotals
+	{
+		double ExclusiveSeconds = 0.0;
+		double ErrorSeconds = 0.0;   // 95% 置信区间半宽，各节点按平方和合并
+		int64 Executions = 0;
+
+		void Add(const FNodeExecutionData& Data)
+		{
+			ExclusiveSeconds += Data.TotalExclusiveTime;
+			Executions += Data.TotalExecutions;
+
+			// 外推的总耗时与外推次数同比例缩放，沿用次数的相对误差
+			if (Data.TotalExecutions > 0 && Data.ExecutionsUpperBound > Data.ExecutionsLowerBound)
+			{
+				const double RelativeError = 0.5 * (Data.ExecutionsUpperBound - Data.ExecutionsLowerBound) / Data.TotalExecutions;
+				ErrorSeconds = FMath::Sqrt(FMath::Square(ErrorSeconds) + FMath::Square(RelativeError * Data.TotalExclusiveTime));
+			}
+		}
+
+		void Add(const FCostTotals& Other)
+		{
+			ExclusiveSeconds += Other.ExclusiveSeconds;
+			ErrorSeconds = FMath::Sqrt(FMath::Square(ErrorSeconds) + FMath::Square(Other.ErrorSeconds));
+			Executions += Other.Executions;
+		}
+
+		double GetRelativeError() const
+		{
+			return ExclusiveSeconds > 0.0 ? ErrorSeconds / ExclusiveSeconds : 0.0;
+		}
+	};
+
+	struct FCostPair
+	{
+		FString NodeName;
+		FString BlueprintName;
+		FGuid NodeGuid;
+		FCostTotals Baseline;
+		FCostTotals Current;
+	};
+
+	/** Same node in both recordings: GUIDs survive renames, names are only the fallback */
+	static FString GetNodeKey(const FNodeExecutionData& Data)
+	{
+		return Data.NodeGuid.IsValid()
+			? Data.BlueprintName + TEXT("|") + Data.NodeGuid.ToString()
+			: Data.BlueprintName + TEXT("|#") + Data.NodeName;
+	}
+
+	struct FNormalizer
+	{
+		double CostDivisor = 1.0;
+		double Duration = 0.0;
+
+		FNormalizer(const FSessionProfile& Profile, bool bPerFrame)
+		{
+			Duration = Profile.Session.Duration;
+			const double Divisor = bPerFrame ? static_cast<double>(Profile.NumFrames) : Duration;
+			CostDivisor = Divisor > 0.0 ? Divisor : 1.0;
+		}
+
+		float GetMs(const FCostTotals& Totals) const
+		{
+			return static_cast<float>(Totals.ExclusiveSeconds * 1000.0 / CostDivisor);
+		}
+
+		float GetExecutionsPerSecond(const FCostTotals& Totals) const
+		{
+			return Duration > 0.0 ? static_cast<float>(Totals.Executions / Duration) : 0.0f;
+		}
+	};
+
+	static FSessionCostDiff MakeDiff(const FCostPair& Pair, const FNormalizer& BaselineNorm, const FNormalizer& CurrentNorm, const FSessionComparisonSettings& Settings)
+	{
+		FSessionCostDiff Diff;
+		Diff.NodeName = Pair.NodeName;
+		Diff.BlueprintName = Pair.BlueprintName;
+		Diff.NodeGuid = Pair.NodeGuid;
+		Diff.BaselineMs = BaselineNorm.GetMs(Pair.Baseline);
+		Diff.CurrentMs = CurrentNorm.GetMs(Pair.Current);
+		Diff.DeltaMs = Diff.CurrentMs - Diff.BaselineMs;
+		Diff.BaselineExecutionsPerSecond = BaselineNorm.GetExecutionsPerSecond(Pair.Baseline);
+		Diff.CurrentExecutionsPerSecond = CurrentNorm.GetExecutionsPerSecond(Pair.Current);
+		Diff.BaselineExecutions = static_cast<int32>(FMath::Min<int64>(Pair.Baseline.Executions, MAX_int32));
+		Diff.CurrentExecutions = static_cast<int32>(FMath::Min<int64>(Pair.Current.Executions, MAX_int32));
+		Diff.NoisePercent = static_cast<float>(100.0 * FMath::Sqrt(FMath::Square(Pair.Baseline.GetRelativeError()) + FMath::Square(Pair.Current.GetRelativeError())));
+
+		if (Diff.BaselineExecutions == 0 || Diff.CurrentExecutions == 0)
+		{
+			// 只在一侧出现：按该侧的耗时判断是否值得关注
+			const bool bAdded = Diff.CurrentExecutions > 0;
+			const int32 Executions = bAdded ? Diff.CurrentExecutions : Diff.BaselineExecutions;
+			if (Executions > 0)
+			{
+				Diff.Change = bAdded ? ESessionCostChange::Added : ESessionCostChange::Removed;
+				Diff.bSignificant = Executions >= Settings.MinExecutions && FMath::Abs(Diff.DeltaMs) >= Settings.MinDeltaMs;
+			}
+			return Diff;
+		}
+
+		Diff.DeltaPercent = Diff.BaselineMs > 0.0f ? 100.0f * Diff.DeltaMs / Diff.BaselineMs : 0.0f;
+		const float AbsPercent = FMath::Abs(Diff.DeltaPercent);
+		Diff.bSignificant = FMath::Min(Diff.BaselineExecutions, Diff.CurrentExecutions) >= Settings.MinExecutions
+			&& FMath::Abs(Diff.DeltaMs) >= Settings.MinDeltaMs
+			&& AbsPercent >= Settings.ThresholdPercent
+			&& AbsPercent > Diff.NoisePercent;
+
+		if (Diff.bSignificant)
+		{
+			Diff.Change = Diff.DeltaMs > 0.0f ? ESessionCostChange::Regressed : ESessionCostChange::Improved;
+		}
+		return Diff;
+	}
+
+	static void SortDiffs(TArray<FSessionCostDiff>& Diffs)
+	{
+		Diffs.Sort([](const FSessionCostDiff& A, const FSessionCostDiff& B)
+		{
+			const bool bWorseA = A.bSignificant && (A.Change == ESessionCostChange::Regressed || A.Change == ESessionCostChange::Added);
+			const bool bWorseB = B.bSignificant && (B.Change == ESessionCostChange::Regressed || B.Change == ESessionCostChange::Added);
+			if (bWorseA != bWorseB)
+			{
+				return bWorseA;
+			}
+			if (A.DeltaMs != B.DeltaMs)
+			{
+				return A.DeltaMs > B.DeltaMs;
+			}
+			return A.BlueprintName != B.BlueprintName ? A.BlueprintName < B.BlueprintName : A.NodeName < B.NodeName;
+		});
+	}
+
+	static TSharedRef<FJsonObject> SessionToJson(const FRecordingSession& Session)
+	{
+		TSharedRef<FJsonObject> SessionJson = MakeShared<FJsonObject>();
+		SessionJson->SetStringField(TEXT("SessionName"), Session.SessionName);
+		SessionJson->SetStringField(TEXT("StartTime"), Session.StartTime.ToString());
+		SessionJson->SetNumberField(TEXT("Duration"), Session.Duration);
+		SessionJson->SetNumberField(TEXT("TotalFrames"), Session.TotalFrames);
+		SessionJson->SetNumberField(TEXT("SamplingRate"), Session.SamplingRate);
+		return SessionJson;
+	}
+
+	static TArray<TSharedPtr<FJsonValue>> DiffsToJson(TConstArrayView<FSessionCostDiff> Diffs)
+	{
+		TArray<TSharedPtr<FJsonValue>> DiffArray;
+		DiffArray.Reserve(Diffs.Num());
+		for (const FSessionCostDiff& Diff : Diffs)
+		{
+			TSharedRef<FJsonObject> DiffJson = MakeShared<FJsonObject>();
+			if (!Diff.NodeName.IsEmpty())
+			{
+				DiffJson->SetStringField(TEXT("NodeName"), Diff.NodeName);
+				DiffJson->SetStringField(TEXT("NodeGuid"), Diff.NodeGuid.ToString(EGuidFormats::DigitsWithHyphens));
+			}
+			DiffJson->SetStringField(TEXT("BlueprintName"), Diff.BlueprintName);
+			DiffJson->SetStringField(TEXT("Change"), FSessionComparison::GetChangeName(Diff.Change));
+			DiffJson->SetBoolField(TEXT("bSignificant"), Diff.bSignificant);
+			DiffJson->SetNumberField(TEXT("BaselineMs"), Diff.BaselineMs);
+			DiffJson->SetNumberField(TEXT("CurrentMs"), Diff.CurrentMs);
+			DiffJson->SetNumberField(TEXT("DeltaMs"), Diff.DeltaMs);
+			DiffJson->SetNumberField(TEXT("DeltaPercent"), Diff.DeltaPercent);
+			DiffJson->SetNumberField(TEXT("NoisePercent"), Diff.NoisePercent);
+			DiffJson->SetNumberField(TEXT("BaselineExecutionsPerSecond"), Diff.BaselineExecutionsPerSecond);
+			DiffJson->SetNumberField(TEXT("CurrentExecutionsPerSecond"), Diff.CurrentExecutionsPerSecond);
+			DiffJson->SetNumberField(TEXT("BaselineExecutions"), Diff.BaselineExecutions);
+			DiffJson->SetNumberField(TEXT("CurrentExecutions"), Diff.CurrentExecutions);
+			DiffArray.Add(MakeShared<FJsonValueObject>(DiffJson));
+		}
+		return DiffArray;
+	}
+}
+
+FSessionComparison FSessionComparison::Compare(const FSessionProfile& Baseline, const FSessionProfile& Current, const FSessionComparisonSettings& InSettings)
+{
+	using namespace BlueprintProfilerSessionComparison;
+
+	FSessionComparison Result;
+	Result.BaselineSession = Baseline.Session;
+	Result.CurrentSession = Current.Session;
+	Result.Settings = InSettings;
+	Result.bPerFrame = Baseline.NumFrames > 0 && Current.NumFrames > 0;
+
+	// 按节点标识对齐两次录制，同一标识出现多次时合并
+	TArray<FCostPair> NodePairs;
+	TMap<FString, int32> NodeIndices;
+	auto AddNodes = [&NodePairs, &NodeIndices](const TArray<FNodeExecutionData>& Nodes, bool bBaseline)
+	{
+		for (const FNodeExecutionData& Data : Nodes)
+		{
+			int32& PairIndex = NodeIndices.FindOrAdd(GetNodeKey(Data), INDEX_NONE);
+			if (PairIndex == INDEX_NONE)
+			{
+				PairIndex = NodePairs.Num();
+				FCostPair& NewPair = NodePairs.AddDefaulted_GetRef();
+				NewPair.NodeName = Data.NodeName;
+				NewPair.BlueprintName = Data.BlueprintName;
+				NewPair.NodeGuid = Data.NodeGuid;
+			}
+			FCostPair& Pair = NodePairs[PairIndex];
+			(bBaseline ? Pair.Baseline : Pair.Current).Add(Data);
+		}
+	};
+	AddNodes(Baseline.Nodes, true);
+	AddNodes(Current.Nodes, false);
+
+	TArray<FCostPair> BlueprintPairs;
+	TMap<FString, int32> BlueprintIndices;
+	for (const FCostPair& NodePair : NodePairs)
+	{
+		int32& PairIndex = BlueprintIndices.FindOrAdd(NodePair.BlueprintName, INDEX_NONE);
+		if (PairIndex == INDEX_NONE)
+		{
+			PairIndex = BlueprintPairs.Num();
+			BlueprintPairs.AddDefaulted_GetRef().BlueprintName = NodePair.BlueprintName;
+		}
+		BlueprintPairs[PairIndex].Baseline.Add(NodePair.Baseline);
+		BlueprintPairs[PairIndex].Current.Add(NodePair.Current);
+	}
+
+	const FNormalizer BaselineNorm(Baseline, Result.bPerFrame);
+	const FNormalizer CurrentNorm(Current, Result.bPerFrame);
+
+	Result.Nodes.Reserve(NodePairs.Num());
+	for (const FCostPair& Pair : NodePairs)
+	{
+		Result.Nodes.Add(MakeDiff(Pair, BaselineNorm, CurrentNorm, InSettings));
+	}
+	Result.Blueprints.Reserve(BlueprintPairs.Num());
+	for (const FCostPair& Pair : BlueprintPairs)
+	{
+		Result.Blueprints.Add(MakeDiff(Pair, BaselineNorm, CurrentNorm, InSettings));
+	}
+
+	SortDiffs(Result.Nodes);
+	SortDiffs(Result.Blueprints);
+	return Result;
+}
+
+bool FSessionComparison::LoadProfile(const FString& FilePath, FSessionProfile& OutProfile)
+{
+	FProfilerSessionReader Reader;
+	if (!Reader.Open(FilePath))
+	{
+		return false;
+	}
+
+	OutProfile.Session = Reader.GetSession();
+	OutProfile.Nodes = Reader.GetNodes();
+	OutProfile.NumFrames = OutProfile.Session.TotalFrames;
+
+	// 旧文件没有帧数：取首尾帧块的帧号范围（包含暂停期间的帧）
+	if (OutProfile.NumFrames == 0 && Reader.GetNumFrameBlocks() > 0)
+	{
+		uint64 FirstFrame = MAX_uint64;
+		uint64 LastFrame = 0;
+		TArray<FExecutionFrame> Frames;
+		for (const int32 BlockIndex : { 0, Reader.GetNumFrameBlocks() - 1 })
+		{
+			if (Reader.ReadFrameBlock(BlockIndex, Frames))
+			{
+				for (const FExecutionFrame& Frame : Frames)
+				{
+					FirstFrame = FMath::Min(FirstFrame, Frame.FrameNumber);
+					LastFrame = FMath::Max(LastFrame, Frame.FrameNumber);
+				}
+			}
+		}
+
+		// 版本 1 的帧记录没有帧号
+		if (LastFrame > 0 && LastFrame >= FirstFrame)
+		{
+			OutProfile.NumFrames = static_cast<int32>(FMath::Min<uint64>(LastFrame - FirstFrame + 1, MAX_int32));
+		}
+	}
+	return true;
+}
+
+FSessionProfile FSessionComparison::GetLatestProfile(const FRuntimeProfiler& Profiler)
+{
+	FSessionProfile Profile;
+	Profile.Session = Profiler.GetCurrentSession();
+	Profile.Nodes = Profiler.GetExecutionData();
+	Profile.NumFrames = Profile.Session.TotalFrames;
+	return Profile;
+}
+
+TArray<const FSessionCostDiff*> FSessionComparison::FindBlueprintRegressions(TConstArrayView<FString> TrackedBlueprints, float MaxRegressionPercent) const
+{
+	TArray<const FSessionCostDiff*> Regressions;
+	for (const FSessionCostDiff& Diff : Blueprints)
+	{
+		if (!Diff.bSignificant || Diff.Change != ESessionCostChange::Regressed || Diff.DeltaPercent <= MaxRegressionPercent)
+		{
+			continue;
+		}
+
+		const bool bTracked = TrackedBlueprints.Num() == 0 || TrackedBlueprints.ContainsByPredicate([&Diff](const FString& Name)
+		{
+			return Name.Equals(Diff.BlueprintName, ESearchCase::IgnoreCase);
+		});
+		if (bTracked)
+		{
+			Regressions.Add(&Diff);
+		}
+	}
+	return Regressions;
+}
+
+bool FSessionComparison::WriteReport(const FString& FilePath) const
+{
+	using namespace BlueprintProfilerSessionComparison;
+
+	TSharedRef<FJsonObject> SettingsJson = MakeShared<FJsonObject>();
+	SettingsJson->SetNumberField(TEXT("ThresholdPercent"), Settings.ThresholdPercent);
+	SettingsJson->SetNumberField(TEXT("MinDeltaMs"), Settings.MinDeltaMs);
+	SettingsJson->SetNumberField(TEXT("MinExecutions"), Settings.MinExecutions);
+
+	TSharedRef<FJsonObject> RootJson = MakeShared<FJsonObject>();
+	RootJson->SetObjectField(TEXT("Baseline"), SessionToJson(BaselineSession));
+	RootJson->SetObjectField(TEXT("Current"), SessionToJson(CurrentSession));
+	RootJson->SetObjectField(TEXT("Settings"), SettingsJson);
+	RootJson->SetStringField(TEXT("CostUnit"), bPerFrame ? TEXT("ms/frame") : TEXT("ms/s"));
+	RootJson->SetArrayField(TEXT("Blueprints"), DiffsToJson(Blueprints));
+	RootJson->SetArrayField(TEXT("Nodes"), DiffsToJson(Nodes));
+
+	FString OutputString;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
+	if (!FJsonSerializer::Serialize(RootJson, Writer) || !FFileHelper::SaveStringToFile(OutputString, *FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Failed to write session comparison report: %s"), *FilePath);
+		return false;
+	}
+	return true;
+}
+
+const TCHAR* FSessionComparison::GetChangeName(ESessionCostChange Change)
+{
+	switch (Change)
+	{
+	case ESessionCostChange::Regressed: return TEXT("Regressed");
+	case ESessionCostChange::Improved: return TEXT("Improved");
+	case ESessionCostChange::Added: return TEXT("Added");
+	case ESessionCostChange::Removed: return TEXT("Removed");
+	default: return TEXT("Unchanged");
+	}
+}
@@ -1,57 +1,87 @@
 // Copyright xnbmy 2026. All Rights Reserved.
 
 #include "Analyzers/StaticLinter.h"
+#include "Analyzers/BlueprintLintTags.h"
+#include "Analyzers/BlueprintProfilerStats.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "Engine/Blueprint.h"
 #include "Engine/GameInstance.h"
-#include "Async/Async.h"
 #include "Misc/DateTime.h"
-#include "Framework/Application/SlateApplication.h"
-#include "HAL/PlatformProcess.h"
+#include "Misc/ScopeExit.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/PlatformMemory.h"
+#include "Editor.h"
+#include "PackageTools.h"
+#include "Subsystems/AssetEditorSubsystem.h"
+#include "UObject/UObjectGlobals.h"
+#include "Engine/World.h"
+#include "Tasks/Task.h"
+
+DECLARE_CYCLE_STAT(TEXT("Lint SnapshotAsset"), STAT_LintSnapshotAsset, STATGROUP_BlueprintProfiler);
+DECLARE_CYCLE_STAT(TEXT("Lint AnalyzeSnapshot"), STAT_LintAnalyzeSnapshot, STATGROUP_BlueprintProfiler);
+DECLARE_CYCLE_STAT(TEXT("Lint GraphIndex"), STAT_LintGraphIndex, STATGROUP_BlueprintProfiler);
+
+namespace
+{
+	// 游戏线程每帧用于加载和建立快照的时间；单个资产超出预算时仍会完整处理
+	constexpr double SnapshotFrameBudgetSeconds = 0.010;
+
+	// 没有实测耗时的资产使用的开销模型：加载按包大小，分析按节点数；未打标签的资产按包大小估算节点数
+	constexpr float LoadSecondsPerMB = 0.02f;
+	constexpr float AnalysisSecondsPerNode = 0.00002f;
+	constexpr int64 PackageBytesPerNode = 1500;
+	constexpr float MinAssetCostSeconds = 0.001f;
+
+	// 内存预算的回差：超出预算才释放，释放后要降到预算的 80% 以下；两次释放之间至少间隔一段时间并新加载若干个包
+	constexpr double MemoryReleaseTargetFraction = 0.8;
+	constexpr double MinSecondsBetweenReleases = 2.0;
+	constexpr int32 MinPackagesBetweenReleases = 16;
+}
+
+float FLintAnalysisTiming::GetTotalSeconds() const
+{
+	float Seconds = GraphIndexSeconds;
+	for (const float CheckTime : CheckSeconds)
+	{
+		Seconds += CheckTime;
+	}
+	return Seconds;
+}
 
-// Forward declarations
-class FScanTask;
+void FLintAnalysisTiming::Add(const FLintAnalysisTiming& Other)
+{
+	GraphIndexSeconds += Other.GraphIndexSeconds;
+	for (int32 CheckIndex = 0; CheckIndex < NumChecks; ++CheckIndex)
+	{
+		CheckSeconds[CheckIndex] += Other.CheckSeconds[CheckIndex];
+	}
+}
 
 FStaticLinter::FStaticLinter()
 	: bScanInProgress(false)
 	, bCancelRequested(false)
-	, bTaskComplete(true)
 {
 }
 
 FStaticLinter::~FStaticLinter()
 {
-	// Mark as cancelled to prevent CompleteScan from accessing this object
+	// Mark as cancelled so queued batches stop early
 	bCancelRequested = true;
 	bScanInProgress = false;
 
-	// Wait for the background task and its async completion callback to finish
+	StopSnapshotStage();
+
+	// FScanTask waits for its pipe; a CompleteScan still queued on the game thread fails to pin the linter afterwards
 	if (CurrentScanTask.IsValid())
 	{
-		// Wait for the background DoWork to complete
-		CurrentScanTask->EnsureCompletion();
-
-		// Wait a bit longer for the async CompleteScan callback to execute
-		// The callback is scheduled on the game thread, so we need to give it time to run
-		double WaitStartTime = FPlatformTime::Seconds();
-		const double MaxWaitTime = 5.0; // Wait up to 5 seconds
-
-		while (!bTaskComplete && (FPlatformTime::Seconds() - WaitStartTime) < MaxWaitTime)
-		{
-			FPlatformProcess::Sleep(0.01f); // Sleep 10ms
-
-			// Pump the message queue to allow async tasks to run
-			FSlateApplication::Get().PumpMessages();
-		}
-
-		if (!bTaskComplete)
-		{
-			UE_LOG(LogTemp, Warning, TEXT("StaticLinter destructor: Task completion callback did not execute in time"));
-		}
+		CurrentScanTask->Cancel();
+		CurrentScanTask.Reset();
 	}
 
-	// Now it's safe to reset
-	CurrentScanTask.Reset();
+	// 后台写缓存引用的是副本，但仍需在模块卸载前结束
+	CacheSaveTask.Wait();
+
+	SelfReference.Reset();
 }
 
 void FStaticLinter::ScanProject(const FScanConfiguration& Config)
@@ -141,17 +171,22 @@ void FStaticLinter::CancelScan()
 		UE_LOG(LogTemp, Log, TEXT("Scan cancellation requested - processed %d/%d assets"),
 			CurrentProgress.ProcessedAssets, CurrentProgress.TotalAssets);
 
+		StopSnapshotStage();
+		ReleaseLoadedPackages();
+
+		// Wait for the batch being analyzed, then keep what the per-blueprint passes found so far
 		if (CurrentScanTask.IsValid())
 		{
-			// Wait for background task to complete
-			CurrentScanTask->EnsureCompletion();
-
-			// Don't reset here - let CompleteScan() handle the reset
-			// or it will be reset when next scan starts
+			CurrentScanTask->Cancel();
+			CurrentScanTask->Wait();
+			DispatchIssueBatches();
+			UpdateScanTimings();
+			CurrentScanTask.Reset();
 		}
 
 		bScanInProgress = false;
 		bCancelRequested = false;
+		SelfReference.Reset();
 
 		// Preserve partial results if any were found
 		UE_LOG(LogTemp, Log, TEXT("Scan cancelled - %d issues found in %d processed assets"),
@@ -180,21 +215,78 @@ TArray<FLintIssue> FStaticLinter::GetIssuesByType(ELintIssueType Type) const
 void FStaticLinter::StartAsyncScan(const TArray<FAssetData>& Assets, const FScanConfiguration& Config)
 {
 	// Ensure any previous task is completed
-	if (CurrentScanTask.IsValid())
-	{
-		CurrentScanTask->EnsureCompletion();
-		CurrentScanTask.Reset();
-	}
+	StopSnapshotStage();
+	CurrentScanTask.Reset();
 
 	// Clear previous self-reference
 	SelfReference.Reset();
 
 	bScanInProgress = true;
 	bCancelRequested = false;
-	bTaskComplete = false; // Task is starting, mark as incomplete
 	Issues.Empty();
+	PackageHashContext = FStaticLinterCache::FHashContext();
+
+	const FString CacheFilePath = Config.CacheFilePath.IsEmpty() ? FStaticLinterCache::GetDefaultFilePath() : Config.CacheFilePath;
+	if (Config.bUseCache && LintCacheFilePath != CacheFilePath)
+	{
+		// A save from an earlier session of this linter may still be writing the file
+		CacheSaveTask.Wait();
+		LintCache.Load(CacheFilePath);
+		LintCacheFilePath = CacheFilePath;
+	}
+
+	// 预筛选：只根据资产注册表标签判断，能确定不会产生问题的蓝图不加载
+	const bool bNeedsReferences = NeedsProjectReferences(Config.EnabledChecks);
+	TArray<FAssetData> ScannedAssets;
+	TArray<FAssetData> ReferenceAssets;
+	for (const FAssetData& Asset : Assets)
+	{
+		if (FBlueprintLintTags::GetApplicableChecks(Asset, Config.EnabledChecks).Num() > 0)
+		{
+			ScannedAssets.Add(Asset);
+		}
+		else if (bNeedsReferences && FBlueprintLintTags::MayHaveReferences(Asset))
+		{
+			ReferenceAssets.Add(Asset);
+		}
+	}
+
+	// 最重的蓝图最先加载和分析，避免它们排在最后由一个 worker 单独拖尾
+	// 包哈希要遍历硬依赖闭包，每个资产只算一次，SnapshotNextAsset 直接使用
+	TArray<TPair<float, int32>> AssetCosts;
+	TArray<FIoHash> AssetHashes;
+	AssetCosts.Reserve(ScannedAssets.Num());
+	AssetHashes.Reserve(ScannedAssets.Num());
+	TotalEstimatedCost = 0.0;
+	CompletedEstimatedCost = 0.0;
+	for (int32 AssetIndex = 0; AssetIndex < ScannedAssets.Num(); ++AssetIndex)
+	{
+		const FAssetData& Asset = ScannedAssets[AssetIndex];
+		const FIoHash& PackageHash = AssetHashes.Add_GetRef(Config.bUseCache ? FStaticLinterCache::GetPackageHash(Asset, &PackageHashContext) : FIoHash());
+		const TSharedPtr<const FStaticLinterCache::FEntry> MeasuredEntry = LintCache.FindAny(Asset.PackageName);
+		const bool bPackageUnchanged = MeasuredEntry.IsValid() && !PackageHash.IsZero() && MeasuredEntry->PackageHash == PackageHash;
+		const float Cost = EstimateAssetCost(Asset, MeasuredEntry.Get(), bPackageUnchanged);
+		AssetCosts.Emplace(Cost, AssetIndex);
+		TotalEstimatedCost += Cost;
+	}
+	AssetCosts.StableSort([](const TPair<float, int32>& A, const TPair<float, int32>& B)
+	{
+		return A.Key > B.Key;
+	});
+
+	TArray<FAssetData> SortedAssets;
+	SortedAssets.Reserve(ScannedAssets.Num());
+	PendingAssetCosts.Reset(ScannedAssets.Num());
+	PendingAssetHashes.Reset(ScannedAssets.Num());
+	for (const TPair<float, int32>& AssetCost : AssetCosts)
+	{
+		SortedAssets.Add(MoveTemp(ScannedAssets[AssetCost.Value]));
+		PendingAssetCosts.Add(AssetCost.Key);
+		PendingAssetHashes.Add(AssetHashes[AssetCost.Value]);
+	}
+	ScannedAssets = MoveTemp(SortedAssets);
 
-	CurrentProgress.TotalAssets = Assets.Num();
+	CurrentProgress.TotalAssets = ScannedAssets.Num();
 	CurrentProgress.ProcessedAssets = 0;
 	CurrentProgress.IssuesFound = 0;
 	CurrentProgress.ProgressPercentage = 0.0f;
@@ -202,65 +294,222 @@ void FStaticLinter::StartAsyncScan(const TArray<FAssetData>& Assets, const FScan
 	CurrentProgress.StartTime = FDateTime::Now();
 	CurrentProgress.bIsCompleted = false;
 	CurrentProgress.bWasCancelled = false;
+	CurrentProgress.LoadSeconds = 0.0;
+	CurrentProgress.AnalysisSeconds = 0.0;
+	CurrentProgress.AnalysisBreakdown = FLintAnalysisTiming();
+	CurrentProgress.SlowestAssets.Reset();
+
+	ActiveConfig = Config;
+	ReferenceIndex = FLintReferenceIndex();
+	NumCacheHits = 0;
+	LastReleaseTime = 0.0;
+	bReportedUnreachableBudget = false;
+	PendingAssets = MoveTemp(ScannedAssets);
+	NumScannedAssets = PendingAssets.Num();
+	NextAssetIndex = 0;
+	PendingAssets.Append(ReferenceAssets);
+
+	// 未引用函数和自定义事件/事件分发器的检查需要整个项目的引用；未被扫描的蓝图只提取引用，不做分析
+	if (bNeedsReferences)
+	{
+		TSet<FSoftObjectPath> ScannedPaths;
+		for (const FAssetData& Asset : Assets)
+		{
+			ScannedPaths.Add(Asset.GetSoftObjectPath());
+		}
+
+		for (const FAssetData& Asset : GetBlueprintAssets({ TEXT("/Game") }))
+		{
+			if (!ScannedPaths.Contains(Asset.GetSoftObjectPath()) && FBlueprintLintTags::MayHaveReferences(Asset))
+			{
+				PendingAssets.Add(Asset);
+			}
+		}
+	}
 
-	UE_LOG(LogTemp, Log, TEXT("Starting scan of %d assets with %s threading"),
-		Assets.Num(), Config.bUseMultiThreading ? TEXT("multi") : TEXT("single"));
+	UE_LOG(LogTemp, Log, TEXT("Starting scan of %d assets (%d more for references, %d skipped by registry tags) with %s threading"),
+		NumScannedAssets, PendingAssets.Num() - NumScannedAssets, Assets.Num() - NumScannedAssets - ReferenceAssets.Num(),
+		Config.bUseMultiThreading ? TEXT("multi") : TEXT("single"));
 
-	if (Config.bUseMultiThreading && Assets.Num() > 1)
+	// Create a self-reference to keep this object alive during async operation
+	// The custom deleter ensures we don't actually delete the object (it's owned by the widget)
+	SelfReference = TSharedPtr<FStaticLinter>(this, [](FStaticLinter* /*Linter*/) {
+		// No-op deleter - object is owned by its parent (the widget)
+	});
+
+	// PendingAssets 还包含只提取引用的蓝图，扫描一个蓝图也可能要加载整个项目，所以按待加载总数决定是否分帧
+	if (PendingAssets.Num() > 1)
 	{
-		// Create a self-reference to keep this object alive during async operation
-		// The custom deleter ensures we don't actually delete the object (it's owned by the widget)
-		SelfReference = TSharedPtr<FStaticLinter>(this, [](FStaticLinter* /*Linter*/) {
-			// No-op deleter - object is owned by its parent (the widget)
-		});
+		bInlineAnalysis = !Config.bUseMultiThreading;
+		CurrentScanTask = MakeUnique<FScanTask>(SelfReference, Config, bInlineAnalysis);
 
-		CurrentScanTask = MakeShared<FAsyncTask<FScanTask>>(SelfReference, Assets, Config);
-		CurrentScanTask->StartBackgroundTask();
+		// Loading has to happen on the game thread; it is spread over frames so the editor stays responsive
+		SnapshotTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateRaw(this, &FStaticLinter::TickSnapshotStage));
 
-		UE_LOG(LogTemp, Log, TEXT("Async scan task started in background"));
+		UE_LOG(LogTemp, Log, TEXT("Async scan started: snapshots on the game thread, analysis %s"),
+			bInlineAnalysis ? TEXT("inline on the game thread") : *FString::Printf(TEXT("on up to %d workers"), FMath::Max(Config.MaxConcurrentTasks, 1)));
 	}
 	else
 	{
-		// Process synchronously for single assets or when multi-threading is disabled
-		TArray<FLintIssue> AllIssues;
+		// At most one asset to load: process synchronously
+		bInlineAnalysis = true;
+		CurrentScanTask = MakeUnique<FScanTask>(SelfReference, Config, true);
 
-		for (int32 AssetIndex = 0; AssetIndex < Assets.Num(); AssetIndex++)
+		TArray<FLintScanItem> Items;
+		while (!bCancelRequested && SnapshotNextAsset(Items))
 		{
-			if (bCancelRequested)
+			UpdateScanProgress(FMath::Min(NextAssetIndex, NumScannedAssets), NumScannedAssets);
+
+			if (ShouldReleaseLoadedPackages())
 			{
-				CurrentProgress.bWasCancelled = true;
-				break;
+				ReleaseLoadedPackages();
 			}
+		}
+		PendingAssets.Empty();
+		ReleaseLoadedPackages();
+
+		CurrentScanTask->AddSnapshots(MoveTemp(Items));
+		CurrentScanTask->Finish(MoveTemp(ReferenceIndex));
+		CompleteScan();
+	}
+}
 
-			const FAssetData& AssetData = Assets[AssetIndex];
-			TArray<FLintIssue> AssetIssues;
-			ProcessBlueprint(AssetData, Config, AssetIssues);
-			AllIssues.Append(AssetIssues);
+bool FStaticLinter::TickSnapshotStage(float DeltaTime)
+{
+	if (bCancelRequested || !CurrentScanTask.IsValid())
+	{
+		SnapshotTickerHandle.Reset();
+		return false;
+	}
 
-			UpdateScanProgress(AssetIndex + 1, Assets.Num(), AssetData.AssetName.ToString());
+	// At least one asset per frame, more while the frame budget lasts
+	TArray<FLintScanItem> Batch;
+	const double StartTime = FPlatformTime::Seconds();
+	while (SnapshotNextAsset(Batch) && FPlatformTime::Seconds() - StartTime < SnapshotFrameBudgetSeconds)
+	{
+	}
+
+	if (Batch.Num() > 0)
+	{
+		CurrentScanTask->AddSnapshots(MoveTemp(Batch));
+		if (bInlineAnalysis)
+		{
+			// 内联分析不投递唤醒，已完成的批次直接在这里分发
+			DispatchIssueBatches();
 		}
+	}
 
-		CompleteScan(AllIssues);
+	if (ShouldReleaseLoadedPackages())
+	{
+		ReleaseLoadedPackages();
+	}
+
+	UpdateScanProgress(FMath::Min(NextAssetIndex, NumScannedAssets), NumScannedAssets);
+
+	if (NextAssetIndex >= PendingAssets.Num())
+	{
+		// All snapshots are queued; the cross-blueprint passes can run now that the reference index is complete
+		CurrentScanTask->Finish(MoveTemp(ReferenceIndex));
+		PendingAssets.Empty();
+		SnapshotTickerHandle.Reset();
+		ReleaseLoadedPackages();
+		if (bInlineAnalysis)
+		{
+			// The inline task has finished its last batch and leaves completing the scan to us
+			CompleteScan();
+		}
+		return false;
 	}
+
+	return true;
 }
 
-void FStaticLinter::ProcessBlueprint(const FAssetData& AssetData, const FScanConfiguration& Config, TArray<FLintIssue>& OutIssues)
+bool FStaticLinter::SnapshotNextAsset(TArray<FLintScanItem>& OutBatch)
 {
+	if (NextAssetIndex >= PendingAssets.Num())
+	{
+		return false;
+	}
+
+	BLUEPRINTPROFILER_SCOPE_CYCLE_COUNTER(STAT_LintSnapshotAsset);
+
+	const bool bReferencesOnly = NextAssetIndex >= NumScannedAssets;
+	const float EstimatedCost = bReferencesOnly ? 0.0f : PendingAssetCosts[NextAssetIndex];
+	const FAssetData& AssetData = PendingAssets[NextAssetIndex];
+	const FIoHash PackageHash = !bReferencesOnly ? PendingAssetHashes[NextAssetIndex]
+		: ActiveConfig.bUseCache ? FStaticLinterCache::GetPackageHash(AssetData, &PackageHashContext) : FIoHash();
+	++NextAssetIndex;
+	CompletedEstimatedCost += EstimatedCost;
+
 	// Update current asset being processed
 	CurrentProgress.CurrentAsset = AssetData.AssetName.ToString();
 
-	UE_LOG(LogTemp, Log, TEXT("Processing blueprint: %s"), *CurrentProgress.CurrentAsset);
+	// 包未变化时直接使用缓存的快照，不加载资产
+	const bool bResolveFunctionUsage = ActiveConfig.EnabledChecks.Contains(ELintIssueType::UnusedFunction);
+	if (TSharedPtr<const FStaticLinterCache::FEntry> CachedEntry = LintCache.Find(AssetData.PackageName, PackageHash, !bReferencesOnly, bResolveFunctionUsage && !bReferencesOnly))
+	{
+		++NumCacheHits;
+		ReferenceIndex.SetCallSites(AssetData.PackageName, CopyTemp(CachedEntry->CallSites));
 
-	UBlueprint* Blueprint = nullptr;
+		if (!bReferencesOnly && CachedEntry->Snapshot->Graphs.Num() > 0)
+		{
+			FLintScanItem& Item = OutBatch.AddDefaulted_GetRef();
+			Item.Snapshot = CachedEntry->Snapshot;
+			Item.PackageName = AssetData.PackageName;
+			Item.PackageHash = PackageHash;
+			Item.EstimatedCost = EstimatedCost;
+			if (CachedEntry->ChecksMask == FStaticLinterCache::GetChecksMask(ActiveConfig.EnabledChecks))
+			{
+				Item.bHasCachedLocalIssues = true;
+				Item.LocalIssues = CachedEntry->LocalIssues;
+			}
+		}
+		return true;
+	}
 
-	// Try to get the blueprint - GetAsset() will synchronously load if not already loaded
-	// This is necessary because blueprints in the editor may not be loaded into memory
-	Blueprint = Cast<UBlueprint>(AssetData.GetAsset());
+	// Loading is the only part of a scan that needs the game thread; missing imports are not worth a warning here
+	const double LoadStartTime = FPlatformTime::Seconds();
+	ON_SCOPE_EXIT
+	{
+		CurrentProgress.LoadSeconds += FPlatformTime::Seconds() - LoadStartTime;
+	};
+	UBlueprint* Blueprint = Cast<UBlueprint>(AssetData.FastGetAsset(false));
+	if (!Blueprint)
+	{
+		// 记录本次加载带进来的所有包（包括硬引用的依赖），超出内存预算时一并卸载
+		const FDelegateHandle AssetLoadedHandle = FCoreUObjectDelegates::OnAssetLoaded.AddLambda([this](UObject* LoadedAsset)
+		{
+			ScanLoadedPackages.Add(LoadedAsset->GetPackage());
+		});
+		Blueprint = LoadObject<UBlueprint>(nullptr, *AssetData.GetObjectPathString(), nullptr, LOAD_NoWarn | LOAD_Quiet);
+		FCoreUObjectDelegates::OnAssetLoaded.Remove(AssetLoadedHandle);
 
+		if (Blueprint)
+		{
+			ScanLoadedPackages.Add(Blueprint->GetPackage());
+		}
+	}
 	if (!Blueprint)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("Failed to load blueprint: %s"), *AssetData.GetObjectPathString());
-		return;
+		return true;
+	}
+
+	if (bReferencesOnly)
+	{
+		// 只需要调用点，缓存中也只保存调用点
+		FLintCallSites CallSites = FLintCallSites::Collect(FBlueprintLintSnapshot::Build(Blueprint, true));
+		if (!PackageHash.IsZero())
+		{
+			TSharedRef<FStaticLinterCache::FEntry> Entry = MakeShared<FStaticLinterCache::FEntry>();
+			Entry->PackageHash = PackageHash;
+			Entry->bReferencesOnly = true;
+			Entry->CallSites = CallSites;
+			LintCache.Add(AssetData.PackageName, Entry);
+		}
+		ReferenceIndex.SetCallSites(AssetData.PackageName, MoveTemp(CallSites));
+		return true;
 	}
 
 	// Validate blueprint state - but allow blueprints that haven't been fully compiled
@@ -274,51 +523,191 @@ void FStaticLinter::ProcessBlueprint(const FAssetData& AssetData, const FScanCon
 	if (Blueprint->UbergraphPages.Num() == 0 && Blueprint->FunctionGraphs.Num() == 0 && Blueprint->MacroGraphs.Num() == 0)
 	{
 		UE_LOG(LogTemp, Verbose, TEXT("Blueprint has no graphs to analyze: %s"), *Blueprint->GetName());
-		return;
+
+		// 缓存空快照，下次扫描无需再加载
+		if (!PackageHash.IsZero())
+		{
+			TSharedRef<FStaticLinterCache::FEntry> Entry = MakeShared<FStaticLinterCache::FEntry>();
+			Entry->PackageHash = PackageHash;
+			Entry->ChecksMask = FStaticLinterCache::GetChecksMask(ActiveConfig.EnabledChecks);
+			Entry->bFunctionUsageResolved = true;
+			Entry->Snapshot = MakeShared<const FBlueprintLintSnapshot>(FBlueprintLintSnapshot::Build(Blueprint, false, false));
+			LintCache.Add(AssetData.PackageName, Entry);
+		}
+		return true;
 	}
 
-	UE_LOG(LogTemp, Log, TEXT("Analyzing blueprint: %s (%d uber graphs, %d function graphs, %d macro graphs)"),
+	UE_LOG(LogTemp, Verbose, TEXT("Snapshotting blueprint: %s (%d uber graphs, %d function graphs, %d macro graphs)"),
 		*Blueprint->GetName(), Blueprint->UbergraphPages.Num(), Blueprint->FunctionGraphs.Num(), Blueprint->MacroGraphs.Num());
 
-	// Run enabled checks with error handling
-	try
+	FLintScanItem& Item = OutBatch.AddDefaulted_GetRef();
+	Item.Snapshot = MakeShared<const FBlueprintLintSnapshot>(FBlueprintLintSnapshot::Build(Blueprint, false, bResolveFunctionUsage));
+	Item.PackageName = AssetData.PackageName;
+	Item.PackageHash = PackageHash;
+	Item.EstimatedCost = EstimatedCost;
+	Item.LoadSeconds = static_cast<float>(FPlatformTime::Seconds() - LoadStartTime);
+	ReferenceIndex.SetCallSites(AssetData.PackageName, FLintCallSites::Collect(*Item.Snapshot));
+	return true;
+}
+
+bool FStaticLinter::NeedsProjectReferences(const TSet<ELintIssueType>& EnabledChecks)
+{
+	// DeadNode 查询自定义事件和事件分发器的调用者，结果不能取决于选择了哪些文件夹
+	return EnabledChecks.Contains(ELintIssueType::UnusedFunction) || EnabledChecks.Contains(ELintIssueType::DeadNode);
+}
+
+uint64 FStaticLinter::GetMemoryBudgetBytes(const FScanConfiguration& Config)
+{
+	return Config.MemoryBudgetMB > 0
+		? static_cast<uint64>(Config.MemoryBudgetMB) * 1024 * 1024
+		: FPlatformMemory::GetConstants().TotalPhysical / 2;
+}
+
+bool FStaticLinter::ShouldReleaseLoadedPackages(int32 NumLoadedPackages, double SecondsSinceLastRelease, uint64 UsedBytes, uint64 BudgetBytes)
+{
+	// 每次释放都会跑一次 GC：包太少或离上次释放太近时先继续加载
+	if (NumLoadedPackages < MinPackagesBetweenReleases || SecondsSinceLastRelease < MinSecondsBetweenReleases)
 	{
-		int32 InitialIssueCount = OutIssues.Num();
+		return false;
+	}
 
-		if (Config.EnabledChecks.Contains(ELintIssueType::DeadNode))
-		{
-			DetectDeadNodes(Blueprint, OutIssues);
-		}
+	return UsedBytes > BudgetBytes;
+}
 
-		if (Config.EnabledChecks.Contains(ELintIssueType::OrphanNode))
-		{
-			DetectOrphanNodes(Blueprint, OutIssues);
-		}
+bool FStaticLinter::ShouldReleaseLoadedPackages() const
+{
+	return ShouldReleaseLoadedPackages(ScanLoadedPackages.Num(), FPlatformTime::Seconds() - LastReleaseTime,
+		FPlatformMemory::GetStats().UsedPhysical, GetMemoryBudgetBytes(ActiveConfig));
+}
 
-		if (Config.EnabledChecks.Contains(ELintIssueType::CastAbuse))
+bool FStaticLinter::CanUnloadScanPackage(UPackage* Package)
+{
+	if (!Package || Package->IsDirty() || UWorld::FindWorldInPackage(Package))
+	{
+		return false;
+	}
+
+	// 扫描期间被用户打开的资产保持加载
+	UAssetEditorSubsystem* AssetEditorSubsystem = GEditor ? GEditor->GetEditorSubsystem<UAssetEditorSubsystem>() : nullptr;
+	UObject* Asset = Package->FindAssetInPackage();
+	return !(Asset && AssetEditorSubsystem && AssetEditorSubsystem->FindEditorsForAsset(Asset).Num() > 0);
+}
+
+void FStaticLinter::ReleaseLoadedPackages()
+{
+	if (ScanLoadedPackages.Num() == 0)
+	{
+		return;
+	}
+
+	TArray<UPackage*> PackagesToUnload;
+	for (const TWeakObjectPtr<UPackage>& PackagePtr : ScanLoadedPackages)
+	{
+		UPackage* Package = PackagePtr.Get();
+		if (CanUnloadScanPackage(Package))
 		{
-			DetectCastAbuse(Blueprint, OutIssues);
+			PackagesToUnload.Add(Package);
 		}
+	}
+	ScanLoadedPackages.Empty();
+
+	const uint64 UsedBefore = FPlatformMemory::GetStats().UsedPhysical;
 
-		if (Config.EnabledChecks.Contains(ELintIssueType::TickAbuse))
+	// UnloadPackages clears RF_Standalone and runs the garbage collector itself
+	FText ErrorMessage;
+	if (PackagesToUnload.Num() > 0 && !UPackageTools::UnloadPackages(PackagesToUnload, ErrorMessage))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Failed to unload packages loaded by the scan: %s"), *ErrorMessage.ToString());
+	}
+
+	const uint64 UsedAfter = FPlatformMemory::GetStats().UsedPhysical;
+	LastReleaseTime = FPlatformTime::Seconds();
+	UE_LOG(LogTemp, Log, TEXT("Unloaded %d packages loaded by the scan (%.0f MB -> %.0f MB used)"),
+		PackagesToUnload.Num(), UsedBefore / (1024.0 * 1024.0), UsedAfter / (1024.0 * 1024.0));
+
+	// Everything the scan loaded is gone; if that is not enough the rest of the memory belongs to the editor
+	const uint64 TargetBytes = static_cast<uint64>(GetMemoryBudgetBytes(ActiveConfig) * MemoryReleaseTargetFraction);
+	if (UsedAfter > TargetBytes && !bReportedUnreachableBudget)
+	{
+		bReportedUnreachableBudget = true;
+		UE_LOG(LogTemp, Warning, TEXT("Lint memory budget cannot be reached: %.0f MB used after unloading, target %.0f MB. Packages are released at most every %.0f s or %d packages"),
+			UsedAfter / (1024.0 * 1024.0), TargetBytes / (1024.0 * 1024.0), MinSecondsBetweenReleases, MinPackagesBetweenReleases);
+	}
+}
+
+void FStaticLinter::StopSnapshotStage()
+{
+	if (SnapshotTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(SnapshotTickerHandle);
+		SnapshotTickerHandle.Reset();
+	}
+	PendingAssets.Empty();
+}
+
+void FStaticLinter::AnalyzeSnapshot(const FBlueprintLintSnapshot& Snapshot, const FScanConfiguration& Config,
+	const FLintReferenceIndex* InReferenceIndex, TArray<FLintIssue>& OutIssues, FLintAnalysisTiming* OutTiming) const
+{
+	BLUEPRINTPROFILER_SCOPE_CYCLE_COUNTER(STAT_LintAnalyzeSnapshot);
+
+	const int32 InitialIssueCount = OutIssues.Num();
+
+	// 各阶段耗时计入 OutTiming，扫描结束时汇总成耗时表
+	auto SecondsSince = [](uint64 StartCycles)
+	{
+		return static_cast<float>(FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles));
+	};
+	auto RunCheck = [&](ELintIssueType Check, TFunctionRef<void()> Detect)
+	{
+		if (Config.EnabledChecks.Contains(Check))
 		{
-			DetectTickAbuse(Blueprint, OutIssues);
+			const uint64 StartCycles = FPlatformTime::Cycles64();
+			Detect();
+			if (OutTiming)
+			{
+				OutTiming->CheckSeconds[static_cast<int32>(Check)] += SecondsSince(StartCycles);
+			}
 		}
+	};
+
+	// 一次遍历引脚建立每个图的索引，所有检测共用
+	FLintSnapshotIndex GraphIndices;
+	const bool bNeedsGraphIndex = InReferenceIndex
+		? Config.EnabledChecks.Contains(ELintIssueType::DeadNode)
+		: Config.EnabledChecks.Contains(ELintIssueType::OrphanNode) || Config.EnabledChecks.Contains(ELintIssueType::CastAbuse) || Config.EnabledChecks.Contains(ELintIssueType::TickAbuse);
+	if (bNeedsGraphIndex)
+	{
+		BLUEPRINTPROFILER_SCOPE_CYCLE_COUNTER(STAT_LintGraphIndex);
+		const uint64 StartCycles = FPlatformTime::Cycles64();
 
-		if (Config.EnabledChecks.Contains(ELintIssueType::UnusedFunction))
+		GraphIndices.Reserve(Snapshot.Graphs.Num());
+		for (const FLintGraphSnapshot& Graph : Snapshot.Graphs)
 		{
-			DetectUnusedFunctions(Blueprint, OutIssues);
+			GraphIndices.Emplace(Graph);
 		}
 
-		int32 IssuesFound = OutIssues.Num() - InitialIssueCount;
-		if (IssuesFound > 0)
+		if (OutTiming)
 		{
-			UE_LOG(LogTemp, Log, TEXT("Found %d issues in blueprint: %s"), IssuesFound, *Blueprint->GetName());
+			OutTiming->GraphIndexSeconds += SecondsSince(StartCycles);
 		}
 	}
-	catch (...)
+
+	if (InReferenceIndex)
+	{
+		RunCheck(ELintIssueType::DeadNode, [&]() { DetectDeadNodes(Snapshot, GraphIndices, *InReferenceIndex, OutIssues); });
+		RunCheck(ELintIssueType::UnusedFunction, [&]() { DetectUnusedFunctions(Snapshot, *InReferenceIndex, OutIssues); });
+	}
+	else
+	{
+		RunCheck(ELintIssueType::OrphanNode, [&]() { DetectOrphanNodes(Snapshot, GraphIndices, OutIssues); });
+		RunCheck(ELintIssueType::CastAbuse, [&]() { DetectCastAbuse(Snapshot, GraphIndices, OutIssues); });
+		RunCheck(ELintIssueType::TickAbuse, [&]() { DetectTickAbuse(Snapshot, GraphIndices, OutIssues); });
+	}
+
+	const int32 IssuesFound = OutIssues.Num() - InitialIssueCount;
+	if (IssuesFound > 0)
 	{
-		UE_LOG(LogTemp, Error, TEXT("Exception occurred while analyzing blueprint: %s"), *Blueprint->GetName());
+		UE_LOG(LogTemp, Verbose, TEXT("Found %d issues in blueprint: %s"), IssuesFound, *Snapshot.BlueprintName);
 	}
 }
 
@@ -333,11 +722,16 @@ void FStaticLinter::UpdateScanProgress(int32 ProcessedAssets, int32 TotalAssets,
 		CurrentProgress.CurrentAsset = CurrentAssetName;
 	}
 	
-	// Calculate estimated time remaining
-	if (ProcessedAssets > 0)
+	// Calculate estimated time remaining; while a scan runs it follows the cost model, since the largest
+	// blueprints are scheduled first and the average time per asset drops as the scan goes on
+	const double ElapsedSeconds = (FDateTime::Now() - CurrentProgress.StartTime).GetTotalSeconds();
+	if (bScanInProgress && CompletedEstimatedCost > 0.0 && TotalEstimatedCost > CompletedEstimatedCost)
+	{
+		const double SecondsPerCost = ElapsedSeconds / CompletedEstimatedCost;
+		CurrentProgress.EstimatedTimeRemaining = static_cast<float>((TotalEstimatedCost - CompletedEstimatedCost) * SecondsPerCost);
+	}
+	else if (ProcessedAssets > 0)
 	{
-		FTimespan ElapsedTime = FDateTime::Now() - CurrentProgress.StartTime;
-		double ElapsedSeconds = ElapsedTime.GetTotalSeconds();
 		double AverageTimePerAsset = ElapsedSeconds / ProcessedAssets;
 		int32 RemainingAssets = TotalAssets - ProcessedAssets;
 		CurrentProgress.EstimatedTimeRemaining = RemainingAssets * AverageTimePerAsset;
@@ -354,7 +748,48 @@ void FStaticLinter::UpdateScanProgress(int32 ProcessedAssets, int32 TotalAssets,
 		CurrentProgress.EstimatedTimeRemaining, *CurrentProgress.CurrentAsset);
 }
 
-void FStaticLinter::CompleteScan(const TArray<FLintIssue>& AllIssues)
+float FStaticLinter::EstimateAssetCost(const FAssetData& AssetData, const FStaticLinterCache::FEntry* MeasuredEntry, bool bPackageUnchanged)
+{
+	if (MeasuredEntry && (MeasuredEntry->LoadSeconds > 0.0f || MeasuredEntry->AnalysisSeconds > 0.0f))
+	{
+		// 包未变化时直接使用缓存，不会再加载
+		const float Seconds = bPackageUnchanged ? MeasuredEntry->AnalysisSeconds : MeasuredEntry->LoadSeconds + MeasuredEntry->AnalysisSeconds;
+		return FMath::Max(Seconds, MinAssetCostSeconds);
+	}
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	const TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(AssetData.PackageName);
+	const int64 DiskSize = PackageData.IsSet() ? FMath::Max<int64>(PackageData->DiskSize, 0) : 0;
+
+	int32 NumNodes = FBlueprintLintTags::GetNumNodes(AssetData);
+	if (NumNodes == INDEX_NONE)
+	{
+		NumNodes = static_cast<int32>(DiskSize / PackageBytesPerNode);
+	}
+
+	const float LoadSeconds = bPackageUnchanged ? 0.0f : static_cast<float>(DiskSize) / (1024.0f * 1024.0f) * LoadSecondsPerMB;
+	return FMath::Max(LoadSeconds + NumNodes * AnalysisSecondsPerNode, MinAssetCostSeconds);
+}
+
+void FStaticLinter::DispatchIssueBatches()
+{
+	if (!CurrentScanTask.IsValid())
+	{
+		return;
+	}
+
+	TArray<FLintIssue> Batch;
+	while (CurrentScanTask->DequeueIssueBatch(Batch))
+	{
+		const int32 FirstIssue = Issues.Num();
+		Issues.Append(MoveTemp(Batch));
+		CurrentProgress.IssuesFound = Issues.Num();
+
+		OnIssuesBatch.Broadcast(TConstArrayView<FLintIssue>(Issues).Slice(FirstIssue, Issues.Num() - FirstIssue));
+	}
+}
+
+void FStaticLinter::CompleteScan()
 {
 	// Check if we're being called during destruction
 	// If bScanInProgress is already false and bCancelRequested is false, it means
@@ -364,29 +799,100 @@ void FStaticLinter::CompleteScan(const TArray<FLintIssue>& AllIssues)
 		return;
 	}
 
-	{
-		FScopeLock Lock(&IssuesLock);
-		Issues = AllIssues;
-	}
-
-	CurrentProgress.IssuesFound = Issues.Num();
 	CurrentProgress.bIsCompleted = true;
 	bScanInProgress = false;
 	bCancelRequested = false;
 
-	// Mark task as complete - this allows safe destruction
-	bTaskComplete = true;
+	// The pipe has posted this call as its last step, so this only waits for it to wind down
+	if (CurrentScanTask.IsValid())
+	{
+		CurrentScanTask->Wait();
+		DispatchIssueBatches();
+		UpdateScanTimings();
+		CurrentProgress.IssuesFound = Issues.Num();
+		if (ActiveConfig.bUseCache)
+		{
+			UpdateLintCache();
+		}
+		CurrentScanTask.Reset();
+	}
 
 	FTimespan TotalTime = FDateTime::Now() - CurrentProgress.StartTime;
 	double TotalSeconds = TotalTime.GetTotalSeconds();
 
 	OnScanComplete.Broadcast(Issues);
 
-	UE_LOG(LogTemp, Log, TEXT("Scan completed: %d issues found in %d assets (%.2fs total, %.3fs per asset)"),
+	UE_LOG(LogTemp, Log, TEXT("Scan completed: %d issues found in %d assets (%.2fs total, %.3fs per asset, %d unchanged assets from cache)"),
 		Issues.Num(), CurrentProgress.TotalAssets, TotalSeconds,
-		CurrentProgress.TotalAssets > 0 ? TotalSeconds / CurrentProgress.TotalAssets : 0.0);
+		CurrentProgress.TotalAssets > 0 ? TotalSeconds / CurrentProgress.TotalAssets : 0.0, NumCacheHits);
 
 	// Clear self-reference now that scan is complete
 	// This is safe because CompleteScan is called on the game thread after DoWork finishes
 	SelfReference.Reset();
 }
+
+void FStaticLinter::UpdateScanTimings()
+{
+	TArray<FLintAssetTiming> AssetTimings;
+	CurrentScanTask->GetTimings(AssetTimings, CurrentProgress.AnalysisBreakdown);
+	CurrentProgress.AnalysisSeconds = CurrentProgress.AnalysisBreakdown.GetTotalSeconds();
+
+	AssetTimings.Sort([](const FLintAssetTiming& A, const FLintAssetTiming& B)
+	{
+		return A.GetTotalSeconds() > B.GetTotalSeconds();
+	});
+	AssetTimings.SetNum(FMath::Min(AssetTimings.Num(), FScanProgress::MaxSlowestAssets));
+	CurrentProgress.SlowestAssets = MoveTemp(AssetTimings);
+
+	// 耗时表：各检测阶段和最慢的资产，按耗时从高到低
+	TArray<TPair<FString, float>> Stages;
+	Stages.Emplace(TEXT("GraphIndex"), CurrentProgress.AnalysisBreakdown.GraphIndexSeconds);
+	for (int32 CheckIndex = 0; CheckIndex < FLintAnalysisTiming::NumChecks; ++CheckIndex)
+	{
+		if (ActiveConfig.EnabledChecks.Contains(static_cast<ELintIssueType>(CheckIndex)))
+		{
+			Stages.Emplace(StaticEnum<ELintIssueType>()->GetNameStringByValue(CheckIndex), CurrentProgress.AnalysisBreakdown.CheckSeconds[CheckIndex]);
+		}
+	}
+	Stages.Sort([](const TPair<FString, float>& A, const TPair<FString, float>& B)
+	{
+		return A.Value > B.Value;
+	});
+
+	const double TotalSeconds = CurrentProgress.LoadSeconds + CurrentProgress.AnalysisSeconds;
+	auto Share = [TotalSeconds](double Seconds)
+	{
+		return TotalSeconds > 0.0 ? Seconds / TotalSeconds * 100.0 : 0.0;
+	};
+
+	UE_LOG(LogTemp, Log, TEXT("Scan cost: load %.2fs (game thread), analysis %.2fs (summed over workers)"),
+		CurrentProgress.LoadSeconds, CurrentProgress.AnalysisSeconds);
+	UE_LOG(LogTemp, Log, TEXT("  %-18s %10s %7s"), TEXT("Stage"), TEXT("Seconds"), TEXT("Share"));
+	UE_LOG(LogTemp, Log, TEXT("  %-18s %10.3f %6.1f%%"), TEXT("Load"), CurrentProgress.LoadSeconds, Share(CurrentProgress.LoadSeconds));
+	for (const TPair<FString, float>& Stage : Stages)
+	{
+		UE_LOG(LogTemp, Log, TEXT("  %-18s %10.3f %6.1f%%"), *Stage.Key, Stage.Value, Share(Stage.Value));
+	}
+
+	if (CurrentProgress.SlowestAssets.Num() > 0)
+	{
+		UE_LOG(LogTemp, Log, TEXT("  %10s %10s %10s  %s"), TEXT("Total"), TEXT("Load"), TEXT("Analysis"), TEXT("Slowest assets"));
+		for (const FLintAssetTiming& AssetTiming : CurrentProgress.SlowestAssets)
+		{
+			UE_LOG(LogTemp, Log, TEXT("  %10.3f %10.3f %10.3f  %s"), AssetTiming.GetTotalSeconds(), AssetTiming.LoadSeconds,
+				AssetTiming.AnalysisSeconds, *AssetTiming.BlueprintPath);
+		}
+	}
+}
+
+void FStaticLinter::UpdateLintCache()
+{
+	CurrentScanTask->CollectCacheEntries(LintCache);
+
+	// 条目不可变，复制缓存只复制指针；写文件不阻塞编辑器
+	CacheSaveTask.Wait();
+	CacheSaveTask = UE::Tasks::Launch(TEXT("StaticLinterSaveCache"), [CacheCopy = LintCache, FilePath = LintCacheFilePath]()
+	{
+		CacheCopy.Save(FilePath);
+	}, UE::Tasks::ETaskPriority::BackgroundLow);
+}
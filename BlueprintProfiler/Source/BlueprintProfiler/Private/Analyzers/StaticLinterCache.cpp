@@ -0,0 +1,293 @@
+// Copyright xnbmy 2026. All Rights Reserved.
+
+#include "Analyzers/StaticLinterCache.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/AssetData.h"
+#include "HAL/FileManager.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Serialization/NameAsStringProxyArchive.h"
+#include "UObject/Package.h"
+
+namespace
+{
+	constexpr uint32 CacheMagic = 0x434C5042; // "BPLC"
+
+	// PackageName + PackageHash, and Type + three strings + NodeGuid; the remaining fields only make a record larger
+	constexpr int64 MinSerializedEntrySize = sizeof(int32) + sizeof(FIoHash);
+	constexpr int64 MinSerializedIssueSize = sizeof(ELintIssueType) + 3 * sizeof(int32) + sizeof(FGuid);
+
+	/** Rejects counts read from a damaged cache file before anything is reserved for them */
+	bool IsValidRecordCount(FArchive& Ar, int32 Count, int64 MinRecordSize)
+	{
+		return Count >= 0 && Count <= (Ar.TotalSize() - Ar.Tell()) / MinRecordSize;
+	}
+
+	void SerializeIssue(FArchive& Ar, FLintIssue& Issue)
+	{
+		Ar << Issue.Type << Issue.BlueprintPath << Issue.NodeName << Issue.Description << Issue.Severity << Issue.NodeGuid;
+	}
+
+	/** False if the package is modified in memory; OutHash is zero when the registry does not know the package */
+	bool FindSavedHash(IAssetRegistry& AssetRegistry, FName PackageName, FStaticLinterCache::FHashContext& Context, FIoHash& OutHash)
+	{
+		if (const FIoHash* CachedHash = Context.SavedHashes.Find(PackageName))
+		{
+			OutHash = *CachedHash;
+			return true;
+		}
+
+		// 编辑器中已修改但未保存的包与磁盘上的哈希不一致，不能使用缓存；不记入上下文，保存后即可恢复
+		if (const UPackage* Package = FindPackage(nullptr, *PackageName.ToString()))
+		{
+			if (Package->IsDirty())
+			{
+				return false;
+			}
+		}
+
+		const TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(PackageName);
+		OutHash = PackageData.IsSet() ? PackageData->GetPackageSavedHash() : FIoHash();
+		Context.SavedHashes.Add(PackageName, OutHash);
+		return true;
+	}
+
+	const TArray<FName>& GetHardDependencies(IAssetRegistry& AssetRegistry, FName PackageName, FStaticLinterCache::FHashContext& Context)
+	{
+		if (const TArray<FName>* Cached = Context.HardDependencies.Find(PackageName))
+		{
+			return *Cached;
+		}
+
+		TArray<FName> Dependencies;
+		AssetRegistry.GetDependencies(PackageName, Dependencies, UE::AssetRegistry::EDependencyCategory::Package, UE::AssetRegistry::EDependencyQuery::Hard);
+		Dependencies.RemoveAllSwap([](FName Dependency)
+		{
+			return FPackageName::IsScriptPackage(Dependency.ToString());
+		});
+		return Context.HardDependencies.Add(PackageName, MoveTemp(Dependencies));
+	}
+}
+
+FString FStaticLinterCache::GetDefaultFilePath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("BlueprintProfiler") / TEXT("LintCache.bin");
+}
+
+uint32 FStaticLinterCache::GetChecksMask(const TSet<ELintIssueType>& EnabledChecks)
+{
+	uint32 Mask = 0;
+	for (ELintIssueType Check : EnabledChecks)
+	{
+		Mask |= 1u << static_cast<uint32>(Check);
+	}
+	return Mask;
+}
+
+FIoHash FStaticLinterCache::GetPackageHash(const FAssetData& AssetData, FHashContext* Context)
+{
+	FHashContext LocalContext;
+	FHashContext& HashContext = Context ? *Context : LocalContext;
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+	FIoHash OwnHash;
+	if (!FindSavedHash(AssetRegistry, AssetData.PackageName, HashContext, OwnHash) || OwnHash.IsZero())
+	{
+		return FIoHash();
+	}
+
+	// 父类、接口和 Cast 目标都是硬依赖；沿闭包收集，父类的父类新增函数同样会使条目失效
+	TSet<FName> Closure;
+	TArray<FName> Queue;
+	Queue.Add(AssetData.PackageName);
+	Closure.Add(AssetData.PackageName);
+	for (int32 QueueIndex = 0; QueueIndex < Queue.Num(); ++QueueIndex)
+	{
+		for (const FName Dependency : GetHardDependencies(AssetRegistry, Queue[QueueIndex], HashContext))
+		{
+			bool bAlreadyInClosure = false;
+			Closure.Add(Dependency, &bAlreadyInClosure);
+			if (!bAlreadyInClosure)
+			{
+				Queue.Add(Dependency);
+			}
+		}
+	}
+
+	// 按名称排序后再合并，结果与注册表返回依赖的顺序无关
+	Queue.RemoveAtSwap(0, 1, EAllowShrinking::No);
+	Queue.Sort(FNameLexicalLess());
+
+	FIoHashBuilder HashBuilder;
+	HashBuilder.Update(&OwnHash, sizeof(OwnHash));
+	for (const FName Dependency : Queue)
+	{
+		FIoHash DependencyHash;
+		if (!FindSavedHash(AssetRegistry, Dependency, HashContext, DependencyHash))
+		{
+			return FIoHash();
+		}
+
+		const FString DependencyName = Dependency.ToString();
+		HashBuilder.Update(*DependencyName, DependencyName.Len() * sizeof(TCHAR));
+		HashBuilder.Update(&DependencyHash, sizeof(DependencyHash));
+	}
+	return HashBuilder.Finalize();
+}
+
+bool FStaticLinterCache::Load(const FString& FilePath)
+{
+	Entries.Empty();
+
+	TUniquePtr<FArchive> FileReader(IFileManager::Get().CreateFileReader(*FilePath));
+	if (!FileReader.IsValid())
+	{
+		return false;
+	}
+
+	FNameAsStringProxyArchive Ar(*FileReader);
+
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	int32 NumEntries = 0;
+	Ar << Magic << Version << NumEntries;
+	if (Magic != CacheMagic || Version != LinterVersion)
+	{
+		UE_LOG(LogTemp, Log, TEXT("Ignoring lint cache written by another linter version: %s"), *FilePath);
+		return false;
+	}
+
+	// 快照和调用点中的嵌套数组在各自的序列化函数中校验
+	if (Ar.IsError() || !IsValidRecordCount(Ar, NumEntries, MinSerializedEntrySize))
+	{
+		FileReader->SetError();
+		NumEntries = 0;
+	}
+
+	Entries.Reserve(NumEntries);
+	for (int32 EntryIndex = 0; EntryIndex < NumEntries && !Ar.IsError() && !FileReader->IsError(); ++EntryIndex)
+	{
+		FName PackageName;
+		TSharedRef<FEntry> Entry = MakeShared<FEntry>();
+
+		bool bHasSnapshot = false;
+		Ar << PackageName << Entry->PackageHash << Entry->ChecksMask << Entry->bReferencesOnly << Entry->bFunctionUsageResolved;
+		Ar << Entry->LoadSeconds << Entry->AnalysisSeconds;
+		Ar << Entry->CallSites << bHasSnapshot;
+		if (bHasSnapshot)
+		{
+			TSharedRef<FBlueprintLintSnapshot> Snapshot = MakeShared<FBlueprintLintSnapshot>();
+			Ar << *Snapshot;
+			Entry->Snapshot = Snapshot;
+		}
+
+		int32 NumIssues = 0;
+		Ar << NumIssues;
+		if (Ar.IsError() || FileReader->IsError() || !IsValidRecordCount(Ar, NumIssues, MinSerializedIssueSize))
+		{
+			FileReader->SetError();
+			break;
+		}
+
+		Entry->LocalIssues.SetNum(NumIssues);
+		for (FLintIssue& Issue : Entry->LocalIssues)
+		{
+			SerializeIssue(Ar, Issue);
+		}
+
+		Entries.Add(PackageName, Entry);
+	}
+
+	if (Ar.IsError() || FileReader->IsError())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Lint cache is corrupt and will be rebuilt: %s"), *FilePath);
+		Entries.Empty();
+		return false;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("Loaded %d cached lint results from %s"), Entries.Num(), *FilePath);
+	return true;
+}
+
+bool FStaticLinterCache::Save(const FString& FilePath) const
+{
+	// 先写临时文件再替换，写入中断时不会留下半个缓存
+	const FString TempPath = FilePath + TEXT(".tmp");
+	{
+		TUniquePtr<FArchive> FileWriter(IFileManager::Get().CreateFileWriter(*TempPath));
+		if (!FileWriter.IsValid())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Failed to write lint cache: %s"), *TempPath);
+			return false;
+		}
+
+		FNameAsStringProxyArchive Ar(*FileWriter);
+
+		uint32 Magic = CacheMagic;
+		uint32 Version = LinterVersion;
+		int32 NumEntries = Entries.Num();
+		Ar << Magic << Version << NumEntries;
+
+		for (const TPair<FName, TSharedRef<const FEntry>>& Pair : Entries)
+		{
+			// 序列化接口不接受 const，写入时复制条目头和问题列表，快照本身按引用写出
+			FName PackageName = Pair.Key;
+			FEntry Entry = Pair.Value.Get();
+
+			bool bHasSnapshot = Entry.Snapshot.IsValid();
+			Ar << PackageName << Entry.PackageHash << Entry.ChecksMask << Entry.bReferencesOnly << Entry.bFunctionUsageResolved;
+			Ar << Entry.LoadSeconds << Entry.AnalysisSeconds;
+			Ar << Entry.CallSites << bHasSnapshot;
+			if (bHasSnapshot)
+			{
+				Ar << const_cast<FBlueprintLintSnapshot&>(*Entry.Snapshot);
+			}
+
+			int32 NumIssues = Entry.LocalIssues.Num();
+			Ar << NumIssues;
+			for (FLintIssue& Issue : Entry.LocalIssues)
+			{
+				SerializeIssue(Ar, Issue);
+			}
+		}
+
+		if (!FileWriter->Close())
+		{
+			return false;
+		}
+	}
+
+	return IFileManager::Get().Move(*FilePath, *TempPath, true, true);
+}
+
+TSharedPtr<const FStaticLinterCache::FEntry> FStaticLinterCache::Find(FName PackageName, const FIoHash& PackageHash, bool bNeedFullSnapshot, bool bNeedFunctionUsage) const
+{
+	if (PackageHash.IsZero())
+	{
+		return nullptr;
+	}
+
+	const TSharedRef<const FEntry>* Entry = Entries.Find(PackageName);
+	if (!Entry || (*Entry)->PackageHash != PackageHash)
+	{
+		return nullptr;
+	}
+
+	if ((bNeedFullSnapshot && (*Entry)->bReferencesOnly) || (bNeedFunctionUsage && !(*Entry)->bFunctionUsageResolved))
+	{
+		return nullptr;
+	}
+
+	return *Entry;
+}
+
+void FStaticLinterCache::Add(FName PackageName, TSharedRef<const FEntry> Entry)
+{
+	Entries.Add(PackageName, MoveTemp(Entry));
+}
+
+TSharedPtr<const FStaticLinterCache::FEntry> FStaticLinterCache::FindAny(FName PackageName) const
+{
+	const TSharedRef<const FEntry>* Entry = Entries.Find(PackageName);
+	return Entry ? TSharedPtr<const FEntry>(*Entry) : nullptr;
+}
@@ -1,47 +1,22 @@
 // Copyright xnbmy 2026. All Rights Reserved.
 
 #include "Analyzers/StaticLinter.h"
+#include "Analyzers/BlueprintLintSnapshot.h"
+#include "Analyzers/LintGraphIndex.h"
+#include "Analyzers/BlueprintProfilerStats.h"
 #include "BlueprintProfilerLocalization.h"
-#include "Engine/Blueprint.h"
-#include "K2Node.h"
-#include "K2Node_Event.h"
-#include "K2Node_CallFunction.h"
-#include "K2Node_DynamicCast.h"
-#include "K2Node_VariableGet.h"
-#include "K2Node_VariableSet.h"
-#include "K2Node_CustomEvent.h"
-#include "K2Node_FunctionEntry.h"
-#include "K2Node_ComponentBoundEvent.h"
-#include "K2Node_MacroInstance.h"
-#include "K2Node_BaseMCDelegate.h"
-#include "K2Node_AddDelegate.h"
-#include "K2Node_AssignDelegate.h"
-#include "K2Node_CallDelegate.h"
-#include "K2Node_RemoveDelegate.h"
-#include "K2Node_ClearDelegate.h"
-#include "EdGraph/EdGraph.h"
-#include "EdGraph/EdGraphNode.h"
-#include "EdGraph/EdGraphPin.h"
-#include "EdGraphSchema_K2.h"
-#include "AssetRegistry/AssetRegistryModule.h"
-#include "Engine/GameInstance.h"
-#include "GameFramework/Actor.h"
-#include "Components/ActorComponent.h"
-#include "Kismet2/BlueprintEditorUtils.h"
-
-// 存储跨蓝图引用的函数
-TSet<FName> FStaticLinter::ReferencedFunctions;
-TMap<FName, int32> FStaticLinter::FunctionCallCount;
-
-void FStaticLinter::DetectDeadNodes(UBlueprint* Blueprint, TArray<FLintIssue>& OutIssues)
-{
-	if (!Blueprint)
-	{
-		return;
-	}
 
-	// Get all graphs to analyze
-	TArray<UEdGraph*> AllGraphs = GetAllGraphs(Blueprint);
+// 所有检测都只读取快照，可以在任意线程上并行运行
+
+DECLARE_CYCLE_STAT(TEXT("Lint DetectDeadNodes"), STAT_LintDetectDeadNodes, STATGROUP_BlueprintProfiler);
+DECLARE_CYCLE_STAT(TEXT("Lint DetectOrphanNodes"), STAT_LintDetectOrphanNodes, STATGROUP_BlueprintProfiler);
+DECLARE_CYCLE_STAT(TEXT("Lint DetectCastAbuse"), STAT_LintDetectCastAbuse, STATGROUP_BlueprintProfiler);
+DECLARE_CYCLE_STAT(TEXT("Lint DetectTickAbuse"), STAT_LintDetectTickAbuse, STATGROUP_BlueprintProfiler);
+DECLARE_CYCLE_STAT(TEXT("Lint DetectUnusedFunctions"), STAT_LintDetectUnusedFunctions, STATGROUP_BlueprintProfiler);
+
+void FStaticLinter::DetectDeadNodes(const FBlueprintLintSnapshot& Snapshot, const FLintSnapshotIndex& GraphIndices, const FLintReferenceIndex& ReferenceIndex, TArray<FLintIssue>& OutIssues) const
+{
+	BLUEPRINTPROFILER_SCOPE_CYCLE_COUNTER(STAT_LintDetectDeadNodes);
 
 	// Track all referenced variables and functions
 	TSet<FName> LocalReferencedVariables;
@@ -49,132 +24,85 @@ void FStaticLinter::DetectDeadNodes(UBlueprint* Blueprint, TArray<FLintIssue>& O
 	TSet<FGuid> LocalReferencedCustomEvents;
 
 	// First pass: collect all references
-	for (UEdGraph* Graph : AllGraphs)
+	for (int32 GraphIndex = 0; GraphIndex < Snapshot.Graphs.Num(); ++GraphIndex)
 	{
-		if (!Graph)
+		const FLintGraphSnapshot& Graph = Snapshot.Graphs[GraphIndex];
+		const FLintGraphIndex& Index = GraphIndices[GraphIndex];
+		for (int32 NodeIndex = 0; NodeIndex < Graph.Nodes.Num(); ++NodeIndex)
 		{
-			continue;
-		}
-
-		for (UEdGraphNode* Node : Graph->Nodes)
-		{
-			if (!Node)
+			const FLintNodeSnapshot& Node = Graph.Nodes[NodeIndex];
+			switch (Node.Kind)
 			{
-				continue;
-			}
-
 			// Track variable references
-			if (UK2Node_VariableGet* VarGetNode = Cast<UK2Node_VariableGet>(Node))
-			{
+			case ELintNodeKind::VariableGet:
 				// Check if this variable get node has any output connections
-				bool bHasOutputConnections = false;
-				for (UEdGraphPin* Pin : VarGetNode->Pins)
+				if (Index.HasLinkedOutput[NodeIndex])
 				{
-					if (Pin && Pin->Direction == EGPD_Output && Pin->LinkedTo.Num() > 0)
-					{
-						bHasOutputConnections = true;
-						LocalReferencedVariables.Add(VarGetNode->VariableReference.GetMemberName());
-						break;
-					}
+					LocalReferencedVariables.Add(Node.MemberName);
 				}
-			}
-			else if (UK2Node_VariableSet* VarSetNode = Cast<UK2Node_VariableSet>(Node))
-			{
+				break;
+
+			case ELintNodeKind::VariableSet:
 				// Variable set nodes always count as references
-				LocalReferencedVariables.Add(VarSetNode->VariableReference.GetMemberName());
-			}
-			else if (UK2Node_CallFunction* FuncCallNode = Cast<UK2Node_CallFunction>(Node))
-			{
+				LocalReferencedVariables.Add(Node.MemberName);
+				break;
+
+			case ELintNodeKind::CallFunction:
 				// Track function calls
-				if (FuncCallNode->FunctionReference.GetMemberName() != NAME_None)
+				if (Node.MemberName != NAME_None)
 				{
-					LocalReferencedFunctions.Add(FuncCallNode->FunctionReference.GetMemberName());
-					ReferencedFunctions.Add(FuncCallNode->FunctionReference.GetMemberName());
-					FunctionCallCount.FindOrAdd(FuncCallNode->FunctionReference.GetMemberName())++;
+					LocalReferencedFunctions.Add(Node.MemberName);
 				}
-			}
-			else if (UK2Node_CustomEvent* CustomEventNode = Cast<UK2Node_CustomEvent>(Node))
-			{
+				break;
+
+			case ELintNodeKind::CustomEvent:
 				// Track custom event references
-				LocalReferencedCustomEvents.Add(CustomEventNode->NodeGuid);
-			}
+				LocalReferencedCustomEvents.Add(Node.NodeGuid);
+				break;
+
 			// Track event dispatcher references
-			else if (UK2Node_BaseMCDelegate* DelegateNode = Cast<UK2Node_BaseMCDelegate>(Node))
-			{
-				// Get the delegate name (event dispatcher name)
-				FName DelegateName = DelegateNode->GetPropertyName();
-				if (DelegateName != NAME_None)
+			case ELintNodeKind::Delegate:
+				if (Node.MemberName != NAME_None)
 				{
-					// Track the delegate as referenced
-					LocalReferencedFunctions.Add(DelegateName);
-					ReferencedFunctions.Add(DelegateName);
-					
+					LocalReferencedFunctions.Add(Node.MemberName);
+
 					// For AddDelegate and AssignDelegate nodes, also track the connected custom event
-					if (Cast<UK2Node_AddDelegate>(Node) || Cast<UK2Node_AssignDelegate>(Node))
+					for (int32 BoundIndex : Node.BoundEvents)
 					{
-						// Use GetDelegatePin() to get the delegate input pin
-						UEdGraphPin* DelegatePin = DelegateNode->GetDelegatePin();
-						if (DelegatePin && DelegatePin->LinkedTo.Num() > 0)
+						const FLintNodeSnapshot& BoundEventNode = Graph.Nodes[BoundIndex];
+						if (BoundEventNode.MemberName != NAME_None)
 						{
-							// The connected node should be a custom event
-							for (UEdGraphPin* LinkedPin : DelegatePin->LinkedTo)
-							{
-								if (LinkedPin && LinkedPin->GetOwningNode())
-								{
-									UEdGraphNode* ConnectedNode = LinkedPin->GetOwningNode();
-									if (UK2Node_CustomEvent* BoundEventNode = Cast<UK2Node_CustomEvent>(ConnectedNode))
-									{
-										FName EventName = BoundEventNode->GetFunctionName();
-										if (EventName != NAME_None)
-										{
-											LocalReferencedFunctions.Add(EventName);
-											ReferencedFunctions.Add(EventName);
-											LocalReferencedCustomEvents.Add(BoundEventNode->NodeGuid);
-										}
-									}
-								}
-							}
+							LocalReferencedFunctions.Add(BoundEventNode.MemberName);
+							LocalReferencedCustomEvents.Add(BoundEventNode.NodeGuid);
 						}
 					}
 				}
+				break;
+
+			default:
+				break;
 			}
 		}
 	}
 
 	// Second pass: find unreferenced variables and functions
-	for (UEdGraph* Graph : AllGraphs)
+	for (int32 GraphIndex = 0; GraphIndex < Snapshot.Graphs.Num(); ++GraphIndex)
 	{
-		if (!Graph)
-		{
-			continue;
-		}
-
-		for (UEdGraphNode* Node : Graph->Nodes)
+		const FLintGraphSnapshot& Graph = Snapshot.Graphs[GraphIndex];
+		const FLintGraphIndex& Index = GraphIndices[GraphIndex];
+		for (int32 NodeIndex = 0; NodeIndex < Graph.Nodes.Num(); ++NodeIndex)
 		{
-			if (!Node)
-			{
-				continue;
-			}
+			const FLintNodeSnapshot& Node = Graph.Nodes[NodeIndex];
 
 			// Check for unreferenced variable get nodes
-			if (UK2Node_VariableGet* VarGetNode = Cast<UK2Node_VariableGet>(Node))
+			if (Node.Kind == ELintNodeKind::VariableGet)
 			{
-				bool bHasConnections = false;
-				for (UEdGraphPin* Pin : VarGetNode->Pins)
-				{
-					if (Pin && Pin->LinkedTo.Num() > 0)
-					{
-						bHasConnections = true;
-						break;
-					}
-				}
-
-				if (!bHasConnections)
+				if (!Index.HasAnyLink[NodeIndex])
 				{
 					FLintIssue Issue;
 					Issue.Type = ELintIssueType::DeadNode;
-					Issue.BlueprintPath = Blueprint->GetPathName();
-					Issue.NodeName = VarGetNode->VariableReference.GetMemberName().ToString();
+					Issue.BlueprintPath = Snapshot.BlueprintPath;
+					Issue.NodeName = Node.MemberName.ToString();
 					if (FBlueprintProfilerLocalization::IsChinese())
 					{
 						Issue.Description = FString::Printf(TEXT("变量 '%s' 被获取但从未使用"), *Issue.NodeName);
@@ -184,80 +112,76 @@ void FStaticLinter::DetectDeadNodes(UBlueprint* Blueprint, TArray<FLintIssue>& O
 						Issue.Description = FString::Printf(TEXT("Variable '%s' is retrieved but never used"), *Issue.NodeName);
 					}
 					Issue.Severity = CalculateIssueSeverity(ELintIssueType::DeadNode);
-					Issue.NodeGuid = VarGetNode->NodeGuid;
-					
+					Issue.NodeGuid = Node.NodeGuid;
+
 					OutIssues.Add(Issue);
 				}
 			}
 			// Skip Component Bound Events - they are triggered by component events (overlap, hit, etc.)
-		if (UK2Node_ComponentBoundEvent* ComponentBoundEvent = Cast<UK2Node_ComponentBoundEvent>(Node))
-		{
-			continue;
-		}
-		// Check for unreferenced function definitions
-		else if (UK2Node_Event* EventNode = Cast<UK2Node_Event>(Node))
-		{
-			// Skip all built-in events (Receive*)
-			FName EventName = EventNode->GetFunctionName();
-			if (EventName.ToString().StartsWith(TEXT("Receive")))
-			{
-				continue; // Skip all Receive* events
-			}
-
-			// Skip interface events - they are called by the blueprint system automatically
-			if (EventNode->IsInterfaceEventNode())
+			else if (Node.Kind == ELintNodeKind::ComponentBoundEvent)
 			{
 				continue;
 			}
+			// Check for unreferenced function definitions
+			else if (Node.IsEvent())
+			{
+				// Skip all built-in events (Receive*)
+				const FName EventName = Node.MemberName;
+				if (EventName.ToString().StartsWith(TEXT("Receive")))
+				{
+					continue;
+				}
 
-			// Check if this custom event is referenced
-			bool bIsReferenced = LocalReferencedFunctions.Contains(EventName) || ReferencedFunctions.Contains(EventName);
+				// Skip interface events - they are called by the blueprint system automatically
+				if (Node.bInterfaceEvent)
+				{
+					continue;
+				}
 
-			if (!bIsReferenced)
-			{
-				// Also check for direct event calls by GUID
-				bIsReferenced = LocalReferencedCustomEvents.Contains(EventNode->NodeGuid);
-			}
+				// Check if this custom event is referenced, also by direct event calls through its GUID
+				const bool bIsReferenced = LocalReferencedFunctions.Contains(EventName) ||
+					ReferenceIndex.IsFunctionReferenced(EventName) ||
+					LocalReferencedCustomEvents.Contains(Node.NodeGuid);
 
-			if (!bIsReferenced)
-			{
-				FLintIssue Issue;
-				Issue.Type = ELintIssueType::DeadNode;
-				Issue.BlueprintPath = Blueprint->GetPathName();
-				Issue.NodeName = EventName.ToString();
-			if (FBlueprintProfilerLocalization::IsChinese())
-			{
-				Issue.Description = FString::Printf(TEXT("自定义事件 '%s' 已定义但从未被调用"), *Issue.NodeName);
-			}
-			else
-			{
-				Issue.Description = FString::Printf(TEXT("Custom event '%s' is defined but never called"), *Issue.NodeName);
-			}
-			Issue.Severity = ESeverity::Low; // 未调用的事件不一定严重
-				Issue.NodeGuid = EventNode->NodeGuid;
+				if (!bIsReferenced)
+				{
+					FLintIssue Issue;
+					Issue.Type = ELintIssueType::DeadNode;
+					Issue.BlueprintPath = Snapshot.BlueprintPath;
+					Issue.NodeName = EventName.ToString();
+					if (FBlueprintProfilerLocalization::IsChinese())
+					{
+						Issue.Description = FString::Printf(TEXT("自定义事件 '%s' 已定义但从未被调用"), *Issue.NodeName);
+					}
+					else
+					{
+						Issue.Description = FString::Printf(TEXT("Custom event '%s' is defined but never called"), *Issue.NodeName);
+					}
+					Issue.Severity = ESeverity::Low; // 未调用的事件不一定严重
+					Issue.NodeGuid = Node.NodeGuid;
 
-				OutIssues.Add(Issue);
+					OutIssues.Add(Issue);
+				}
 			}
 		}
 	}
-	}
 
 	// Check for unreferenced blueprint variables
-	for (FBPVariableDescription& Variable : Blueprint->NewVariables)
+	for (const FLintVariableSnapshot& Variable : Snapshot.Variables)
 	{
 		// Skip Event Dispatchers (multicast delegates) - they are not regular variables
 		// Event Dispatchers are detected separately via UK2Node_BaseMCDelegate nodes
-		if (Variable.VarType.PinCategory == UEdGraphSchema_K2::PC_MCDelegate)
+		if (Variable.bEventDispatcher)
 		{
 			continue;
 		}
-		
-		if (!LocalReferencedVariables.Contains(Variable.VarName))
+
+		if (!LocalReferencedVariables.Contains(Variable.Name))
 		{
 			FLintIssue Issue;
 			Issue.Type = ELintIssueType::DeadNode;
-			Issue.BlueprintPath = Blueprint->GetPathName();
-			Issue.NodeName = Variable.VarName.ToString();
+			Issue.BlueprintPath = Snapshot.BlueprintPath;
+			Issue.NodeName = Variable.Name.ToString();
 			if (FBlueprintProfilerLocalization::IsChinese())
 			{
 				Issue.Description = FString::Printf(TEXT("蓝图变量 '%s' 已声明但从未使用"), *Issue.NodeName);
@@ -268,29 +192,29 @@ void FStaticLinter::DetectDeadNodes(UBlueprint* Blueprint, TArray<FLintIssue>& O
 			}
 			Issue.Severity = CalculateIssueSeverity(ELintIssueType::DeadNode);
 			// Note: Variables don't have NodeGuid, so we leave it empty
-			
+
 			OutIssues.Add(Issue);
 		}
 	}
-	
+
 	// Check for unreferenced Event Dispatchers
 	// Event Dispatchers are stored as variables but referenced via UK2Node_BaseMCDelegate nodes
-	for (FBPVariableDescription& Variable : Blueprint->NewVariables)
+	for (const FLintVariableSnapshot& Variable : Snapshot.Variables)
 	{
 		// Only check Event Dispatchers
-		if (Variable.VarType.PinCategory != UEdGraphSchema_K2::PC_MCDelegate)
+		if (!Variable.bEventDispatcher)
 		{
 			continue;
 		}
-		
-		FName DispatcherName = Variable.VarName;
-		bool bIsReferenced = LocalReferencedFunctions.Contains(DispatcherName) || ReferencedFunctions.Contains(DispatcherName);
-		
+
+		const FName DispatcherName = Variable.Name;
+		const bool bIsReferenced = LocalReferencedFunctions.Contains(DispatcherName) || ReferenceIndex.IsFunctionReferenced(DispatcherName);
+
 		if (!bIsReferenced)
 		{
 			FLintIssue Issue;
 			Issue.Type = ELintIssueType::DeadNode;
-			Issue.BlueprintPath = Blueprint->GetPathName();
+			Issue.BlueprintPath = Snapshot.BlueprintPath;
 			Issue.NodeName = DispatcherName.ToString();
 			if (FBlueprintProfilerLocalization::IsChinese())
 			{
@@ -302,183 +226,149 @@ void FStaticLinter::DetectDeadNodes(UBlueprint* Blueprint, TArray<FLintIssue>& O
 			}
 			Issue.Severity = ESeverity::Low; // Event dispatchers being unused is low severity
 			// Note: Event Dispatchers don't have NodeGuid, so we leave it empty
-			
+
 			OutIssues.Add(Issue);
 		}
 	}
 }
 
-void FStaticLinter::DetectOrphanNodes(UBlueprint* Blueprint, TArray<FLintIssue>& OutIssues)
+void FStaticLinter::DetectOrphanNodes(const FBlueprintLintSnapshot& Snapshot, const FLintSnapshotIndex& GraphIndices, TArray<FLintIssue>& OutIssues) const
 {
-	if (!Blueprint)
-	{
-		return;
-	}
+	BLUEPRINTPROFILER_SCOPE_CYCLE_COUNTER(STAT_LintDetectOrphanNodes);
 
 	// Skip interface blueprints - their functions are called by other blueprints that implement the interface
 	// Interface functions don't need to be connected to execution flow in the interface itself
-	if (Blueprint->BlueprintType == BPTYPE_Interface)
+	if (Snapshot.bInterface)
 	{
 		return;
 	}
 
-	// Get all graphs to analyze
-	TArray<UEdGraph*> AllGraphs = GetAllGraphs(Blueprint);
-
-	for (UEdGraph* Graph : AllGraphs)
+	for (int32 GraphIndex = 0; GraphIndex < Snapshot.Graphs.Num(); ++GraphIndex)
 	{
-		if (!Graph)
+		const FLintGraphSnapshot& Graph = Snapshot.Graphs[GraphIndex];
+		const FLintGraphIndex& Index = GraphIndices[GraphIndex];
+		for (int32 NodeIndex = 0; NodeIndex < Graph.Nodes.Num(); ++NodeIndex)
 		{
-			continue;
-		}
+			const FLintNodeSnapshot& Node = Graph.Nodes[NodeIndex];
 
-		for (UEdGraphNode* Node : Graph->Nodes)
-		{
-			if (!Node)
+			// Skip Event nodes - they're entry points and don't need to be connected
+			if (Node.IsEvent())
 			{
 				continue;
 			}
 
-			// Skip Event nodes - they're entry points and don't need to be connected
-			if (Node->IsA<UK2Node_Event>() || Node->IsA<UK2Node_CustomEvent>() || Node->IsA<UK2Node_ComponentBoundEvent>())
+			// Skip macro instance nodes - they are references to other graphs
+			if (Node.Kind == ELintNodeKind::MacroInstance)
 			{
 				continue;
 			}
 
-			// Skip macro instance nodes - they are references to other graphs
-			if (Node->IsA<UK2Node_MacroInstance>())
+			// Skip tunnel nodes (macro entry/exit nodes) - they are entry points in macro graphs
+			if (Node.ClassName.Contains(TEXT("K2Node_Tunnel")))
 			{
 				continue;
 			}
 
-			// Skip tunnel nodes (macro entry/exit nodes) - they are entry points in macro graphs
-			// Use class name check to avoid including K2Node_Tunnel.h which may cause build issues
-			FString NodeClassName = Node->GetClass()->GetName();
-			if (NodeClassName.Contains(TEXT("K2Node_Tunnel")))
+			if (!Node.bIsK2Node)
 			{
-				// Tunnel nodes in macro graphs act as entry/exit points and should not be flagged as orphans
 				continue;
 			}
 
-			// Store class name for later use (avoid redefinition)
-			const FString& NodeClassNameRef = NodeClassName;
+			const FString& NodeTitle = Node.Title;
 
 			// Check for pure nodes (computation nodes) without execution connections
-			if (UK2Node* K2Node = Cast<UK2Node>(Node))
-			{
-				if (K2Node->IsNodePure())
+			if (Node.bPure)
+			{
+				// 跳过特殊的纯节点（不需要输出连接）
+				// 1. 变更路线节点（Reroute Node）- 特殊的纯节点
+				if (NodeTitle.Contains(TEXT("变更路线")) ||
+					NodeTitle.Contains(TEXT("Reroute")) ||
+					NodeTitle.Contains(TEXT("Set Return")) ||
+					NodeTitle.Contains(TEXT("Return")) ||
+					NodeTitle.Contains(TEXT("返回")))
 				{
-					// 获取节点标题
-					FString NodeTitle = K2Node->GetNodeTitle(ENodeTitleType::ListView).ToString();
-
-					// 跳过特殊的纯节点（不需要输出连接）
-					// 1. 变更路线节点（Reroute Node）- 特殊的纯节点
-					if (NodeTitle.Contains(TEXT("变更路线")) ||
-						NodeTitle.Contains(TEXT("Reroute")) ||
-						NodeTitle.Contains(TEXT("Set Return")) ||
-						NodeTitle.Contains(TEXT("Return")) ||
-						NodeTitle.Contains(TEXT("返回")))
-					{
-						continue;
-					}
+					continue;
+				}
 
-					// 2. 字面量和常量节点
-					FString NodeClass = K2Node->GetClass()->GetName();
-					if (NodeClass.Contains(TEXT("Literal")) ||
-						NodeClass.Contains(TEXT("Constant")))
-					{
-						continue;
-					}
+				// 2. 字面量和常量节点
+				if (Node.ClassName.Contains(TEXT("Literal")) ||
+					Node.ClassName.Contains(TEXT("Constant")))
+				{
+					continue;
+				}
 
-					// 3. 跳过纯工具节点（Make, Select, Append 等）
-					// 注意：Branch 和 Break 可能有执行引脚，不在此处跳过，让后面的逻辑处理
-					if (NodeTitle.Contains(TEXT("Make")) ||
-						NodeTitle.Contains(TEXT("Select")) ||
-						NodeTitle.Contains(TEXT("Append")))
-					{
-						continue;
-					}
+				// 3. 跳过纯工具节点（Make, Select, Append 等）
+				// 注意：Branch 和 Break 可能有执行引脚，不在此处跳过，让后面的逻辑处理
+				if (NodeTitle.Contains(TEXT("Make")) ||
+					NodeTitle.Contains(TEXT("Select")) ||
+					NodeTitle.Contains(TEXT("Append")))
+				{
+					continue;
+				}
 
-					bool bHasDataOutputConnections = false;
-					bool bHasDataInputConnections = false;
+				// Check data pins for connections (ignore exec pins for pure nodes)
+				const bool bHasDataOutputConnections = Index.HasLinkedDataOutput[NodeIndex];
+				const bool bHasDataInputConnections = Index.HasLinkedDataInput[NodeIndex];
 
-					// Check data pins for connections (ignore exec pins for pure nodes)
-					for (UEdGraphPin* Pin : K2Node->Pins)
+				// Report if pure node has no data output connections (输出未连接)
+				if (!bHasDataOutputConnections)
+				{
+					FLintIssue Issue;
+					Issue.Type = ELintIssueType::OrphanNode;
+					Issue.BlueprintPath = Snapshot.BlueprintPath;
+					Issue.NodeName = NodeTitle;
+					if (FBlueprintProfilerLocalization::IsChinese())
 					{
-						if (Pin && Pin->PinType.PinCategory != UEdGraphSchema_K2::PC_Exec)
-						{
-							if (Pin->Direction == EGPD_Output && Pin->LinkedTo.Num() > 0)
-							{
-								bHasDataOutputConnections = true;
-							}
-							else if (Pin->Direction == EGPD_Input && Pin->LinkedTo.Num() > 0)
-							{
-								bHasDataInputConnections = true;
-							}
-						}
+						Issue.Description = FString::Printf(TEXT("纯节点 '%s' 的输出没有连接到任何节点"), *Issue.NodeName);
 					}
-
-					// Report if pure node has no data output connections (输出未连接)
-					if (!bHasDataOutputConnections)
+					else
 					{
-						FLintIssue Issue;
-						Issue.Type = ELintIssueType::OrphanNode;
-						Issue.BlueprintPath = Blueprint->GetPathName();
-						Issue.NodeName = NodeTitle;
-						if (FBlueprintProfilerLocalization::IsChinese())
-						{
-							Issue.Description = FString::Printf(TEXT("纯节点 '%s' 的输出没有连接到任何节点"), *Issue.NodeName);
-						}
-						else
-						{
-							Issue.Description = FString::Printf(TEXT("Pure node '%s' has no output connections"), *Issue.NodeName);
-						}
-						Issue.Severity = ESeverity::Low;
-						Issue.NodeGuid = K2Node->NodeGuid;
-
-						OutIssues.Add(Issue);
+						Issue.Description = FString::Printf(TEXT("Pure node '%s' has no output connections"), *Issue.NodeName);
 					}
-					// Report if pure node has data inputs but no data output connections (有输入但无输出)
-					else if (bHasDataInputConnections && !bHasDataOutputConnections)
-					{
-						FLintIssue Issue;
-						Issue.Type = ELintIssueType::OrphanNode;
-						Issue.BlueprintPath = Blueprint->GetPathName();
-						Issue.NodeName = NodeTitle;
-						if (FBlueprintProfilerLocalization::IsChinese())
-						{
-							Issue.Description = FString::Printf(TEXT("纯节点 '%s' 有输入但输出未连接"), *Issue.NodeName);
-						}
-						else
-						{
-							Issue.Description = FString::Printf(TEXT("Pure node '%s' has inputs but no output connections"), *Issue.NodeName);
-						}
-						Issue.Severity = ESeverity::Low;
-						Issue.NodeGuid = K2Node->NodeGuid;
+					Issue.Severity = ESeverity::Low;
+					Issue.NodeGuid = Node.NodeGuid;
 
-						OutIssues.Add(Issue);
-					}
+					OutIssues.Add(Issue);
 				}
-				// Check for nodes with execution pins (non-pure nodes)
-				else
+				// Report if pure node has data inputs but no data output connections (有输入但无输出)
+				else if (bHasDataInputConnections && !bHasDataOutputConnections)
 				{
-					// 首先检查是否应该跳过此节点（在检查引脚连接之前）
-					FString NodeTitle = Node->GetNodeTitle(ENodeTitleType::ListView).ToString();
-					bool bShouldSkip = false;
-
-					// 1. 跳过 Event、CustomEvent、FunctionEntry 和 ComponentBoundEvent（入口节点）
-					if (Node->IsA<UK2Node_Event>() || Node->IsA<UK2Node_CustomEvent>() || 
-					    Node->IsA<UK2Node_FunctionEntry>() || Node->IsA<UK2Node_ComponentBoundEvent>())
+					FLintIssue Issue;
+					Issue.Type = ELintIssueType::OrphanNode;
+					Issue.BlueprintPath = Snapshot.BlueprintPath;
+					Issue.NodeName = NodeTitle;
+					if (FBlueprintProfilerLocalization::IsChinese())
 					{
-						bShouldSkip = true;
+						Issue.Description = FString::Printf(TEXT("纯节点 '%s' 有输入但输出未连接"), *Issue.NodeName);
 					}
-					// 2. 跳过构造脚本节点（按标题判断）
-					else if (NodeTitle.Contains(TEXT("构造脚本")) ||
-						NodeTitle.Contains(TEXT("Construction Script")))
+					else
 					{
-						bShouldSkip = true;
+						Issue.Description = FString::Printf(TEXT("Pure node '%s' has inputs but no output connections"), *Issue.NodeName);
 					}
-					// 3. 跳过输入操作节点（Input Action）- 这些是由输入系统触发的事件节点
+					Issue.Severity = ESeverity::Low;
+					Issue.NodeGuid = Node.NodeGuid;
+
+					OutIssues.Add(Issue);
+				}
+			}
+			// Check for nodes with execution pins (non-pure nodes)
+			else
+			{
+				// 首先检查是否应该跳过此节点（在检查引脚连接之前）
+				bool bShouldSkip = false;
+
+				// 1. 跳过 Event、CustomEvent、FunctionEntry 和 ComponentBoundEvent（入口节点）
+				if (Node.IsEvent() || Node.Kind == ELintNodeKind::FunctionEntry)
+				{
+					bShouldSkip = true;
+				}
+				// 2. 跳过构造脚本节点（按标题判断）
+				else if (NodeTitle.Contains(TEXT("构造脚本")) ||
+					NodeTitle.Contains(TEXT("Construction Script")))
+				{
+					bShouldSkip = true;
+				}
+				// 3. 跳过输入操作节点（Input Action）- 这些是由输入系统触发的事件节点
 				// 包括增强输入系统(Enhanced Input)和传统输入系统的输入操作
 				else if (NodeTitle.Contains(TEXT("Thumbstick")) ||
 					NodeTitle.Contains(TEXT("Touch")) ||
@@ -495,81 +385,39 @@ void FStaticLinter::DetectOrphanNodes(UBlueprint* Blueprint, TArray<FLintIssue>&
 					bShouldSkip = true;
 				}
 				// 4. 检查节点类型 - 如果是输入操作节点类也跳过
-				else
+				else if (Node.ClassName.Contains(TEXT("Input")) ||
+					Node.ClassName.Contains(TEXT("EnhancedInput")))
 				{
-					if (NodeClassNameRef.Contains(TEXT("Input")) ||
-						NodeClassNameRef.Contains(TEXT("EnhancedInput")))
-					{
-						bShouldSkip = true;
-					}
+					bShouldSkip = true;
 				}
 
-					// 如果不应该跳过，再检查执行引脚连接状态
+				// 如果不应该跳过，再检查执行引脚连接状态
 				if (!bShouldSkip)
 				{
-					bool bHasExecInput = false;
-					bool bHasExecInputConnected = false;
-					bool bHasExecOutput = false;
-					bool bHasExecOutputConnected = false;
-					bool bHasExecutionPins = false;
-
-					// 检查所有执行引脚的连接状态
-					for (UEdGraphPin* Pin : Node->Pins)
+					// 检查所有输入执行引脚的连接状态
+					const bool bHasExecInput = Index.HasExecInput[NodeIndex];
+					const bool bHasExecInputConnected = Index.HasLinkedExecInput[NodeIndex];
+
+					// 5. 只有执行输出、没有执行输入的是入口节点（如事件、输入操作等），不需要上游连接
+					// 当输入执行引脚未连接时报告（输出引脚连接不影响）
+					if (bHasExecInput && !bHasExecInputConnected)
 					{
-						if (Pin && Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec)
+						FLintIssue Issue;
+						Issue.Type = ELintIssueType::OrphanNode;
+						Issue.BlueprintPath = Snapshot.BlueprintPath;
+						Issue.NodeName = NodeTitle;
+						if (FBlueprintProfilerLocalization::IsChinese())
 						{
-							bHasExecutionPins = true;
-							if (Pin->Direction == EGPD_Input)
-							{
-								bHasExecInput = true;
-								if (Pin->LinkedTo.Num() > 0)
-								{
-									bHasExecInputConnected = true;
-								}
-							}
-							else if (Pin->Direction == EGPD_Output)
-							{
-								bHasExecOutput = true;
-								if (Pin->LinkedTo.Num() > 0)
-								{
-									bHasExecOutputConnected = true;
-								}
-							}
+							Issue.Description = FString::Printf(TEXT("执行节点 '%s' 未连接到任何执行流程（孤立节点）"), *Issue.NodeName);
 						}
-					}
-
-					// 5. 自动检测入口节点：如果节点有执行输出但没有执行输入，说明是入口节点（如事件、输入操作等）
-					if (bHasExecOutput && !bHasExecInput)
-					{
-						// 这是入口节点，不需要上游连接
-						bShouldSkip = true;
-					}
-
-					// 当输入执行引脚未连接时报告（输出引脚连接不影响）
-					// 这会正确跳过：
-					// - Event 节点（没有输入但有输出）- 已在上面跳过
-					// - 正常连接的节点（输入已连接）
-					// 会报告：
-					// - Orphan node (input not connected, regardless of output connection)
-					if (!bShouldSkip && bHasExecutionPins && bHasExecInput && !bHasExecInputConnected)
+						else
 						{
-							FLintIssue Issue;
-							Issue.Type = ELintIssueType::OrphanNode;
-							Issue.BlueprintPath = Blueprint->GetPathName();
-							Issue.NodeName = NodeTitle;
-							if (FBlueprintProfilerLocalization::IsChinese())
-							{
-								Issue.Description = FString::Printf(TEXT("执行节点 '%s' 未连接到任何执行流程（孤立节点）"), *Issue.NodeName);
-							}
-							else
-							{
-								Issue.Description = FString::Printf(TEXT("Execution node '%s' is not connected to any execution flow (orphan node)"), *Issue.NodeName);
-							}
-							Issue.Severity = ESeverity::High;
-							Issue.NodeGuid = K2Node->NodeGuid;
-
-							OutIssues.Add(Issue);
+							Issue.Description = FString::Printf(TEXT("Execution node '%s' is not connected to any execution flow (orphan node)"), *Issue.NodeName);
 						}
+						Issue.Severity = ESeverity::High;
+						Issue.NodeGuid = Node.NodeGuid;
+
+						OutIssues.Add(Issue);
 					}
 				}
 			}
@@ -577,294 +425,164 @@ void FStaticLinter::DetectOrphanNodes(UBlueprint* Blueprint, TArray<FLintIssue>&
 	}
 }
 
-void FStaticLinter::DetectCastAbuse(UBlueprint* Blueprint, TArray<FLintIssue>& OutIssues)
+void FStaticLinter::DetectCastAbuse(const FBlueprintLintSnapshot& Snapshot, const FLintSnapshotIndex& GraphIndices, TArray<FLintIssue>& OutIssues) const
 {
-	if (!Blueprint)
-	{
-		return;
-	}
+	BLUEPRINTPROFILER_SCOPE_CYCLE_COUNTER(STAT_LintDetectCastAbuse);
 
-	// Get all graphs to analyze
-	TArray<UEdGraph*> AllGraphs = GetAllGraphs(Blueprint);
-
-	for (UEdGraph* Graph : AllGraphs)
+	for (int32 GraphIndex = 0; GraphIndex < Snapshot.Graphs.Num(); ++GraphIndex)
 	{
-		if (!Graph)
+		const FLintGraphSnapshot& Graph = Snapshot.Graphs[GraphIndex];
+		const FLintGraphIndex& Index = GraphIndices[GraphIndex];
+		for (int32 NodeIndex = 0; NodeIndex < Graph.Nodes.Num(); ++NodeIndex)
 		{
-			continue;
-		}
-
-		for (UEdGraphNode* Node : Graph->Nodes)
-		{
-			if (!Node)
+			// Look for cast nodes
+			const FLintNodeSnapshot& CastNode = Graph.Nodes[NodeIndex];
+			if (CastNode.Kind != ELintNodeKind::DynamicCast)
 			{
 				continue;
 			}
 
-			// Look for cast nodes
-			if (UK2Node_DynamicCast* CastNode = Cast<UK2Node_DynamicCast>(Node))
+			bool bIsInProblematicContext = false;
+			ESeverity CastSeverity = ESeverity::Low;
+			FString ContextDescription;
+
+			// Analyze the context of this cast node: reachability was computed once per graph
+			if (Index.ReachedFromTick[NodeIndex])
+			{
+				bIsInProblematicContext = true;
+				CastSeverity = ESeverity::High;
+				ContextDescription = TEXT("in Tick event context");
+			}
+			else if (Index.ReachedFromLoop[NodeIndex])
+			{
+				bIsInProblematicContext = true;
+				CastSeverity = ESeverity::Medium;
+				ContextDescription = TEXT("in loop context");
+			}
+			else if (IsNodeInFrequentlyCalledFunction(Graph))
 			{
-				bool bIsInProblematicContext = false;
-				ESeverity CastSeverity = ESeverity::Low;
-				FString ContextDescription;
+				bIsInProblematicContext = true;
+				CastSeverity = ESeverity::Medium;
+				ContextDescription = TEXT("in frequently called function");
+			}
 
-				// Analyze the context of this cast node
-				TSet<UEdGraphNode*> VisitedNodes;
-				if (IsNodeInTickContext(CastNode, VisitedNodes))
-				{
-					bIsInProblematicContext = true;
-					CastSeverity = ESeverity::High;
-					ContextDescription = TEXT("in Tick event context");
-				}
-				else if (IsNodeInLoopContext(CastNode, VisitedNodes))
-				{
-					bIsInProblematicContext = true;
-					CastSeverity = ESeverity::Medium;
-					ContextDescription = TEXT("in loop context");
-				}
-				else if (IsNodeInFrequentlyCalledFunction(CastNode, Graph))
-				{
-					bIsInProblematicContext = true;
-					CastSeverity = ESeverity::Medium;
-					ContextDescription = TEXT("in frequently called function");
-				}
+			// Check if it's a hard reference cast (more expensive)
+			if (CastNode.bHardReferenceCast && bIsInProblematicContext)
+			{
+				CastSeverity = ESeverity::High;
+			}
 
-				// Check if it's a hard reference cast (more expensive)
-				bool bIsHardReferenceCast = IsHardReferenceCast(CastNode);
-				if (bIsHardReferenceCast && bIsInProblematicContext)
-				{
-					CastSeverity = ESeverity::High;
-				}
+			if (bIsInProblematicContext)
+			{
+				FLintIssue Issue;
+				Issue.Type = ELintIssueType::CastAbuse;
+				Issue.BlueprintPath = Snapshot.BlueprintPath;
+				Issue.NodeName = CastNode.Title;
+				Issue.Description = FString::Printf(TEXT("Cast node '%s' %s may cause performance issues %s"),
+					*Issue.NodeName,
+					CastNode.bHardReferenceCast ? TEXT("(hard reference)") : TEXT(""),
+					*ContextDescription);
+				Issue.Severity = CastSeverity;
+				Issue.NodeGuid = CastNode.NodeGuid;
 
-				if (bIsInProblematicContext)
-				{
-					FLintIssue Issue;
-					Issue.Type = ELintIssueType::CastAbuse;
-					Issue.BlueprintPath = Blueprint->GetPathName();
-					Issue.NodeName = CastNode->GetNodeTitle(ENodeTitleType::ListView).ToString();
-					Issue.Description = FString::Printf(TEXT("Cast node '%s' %s may cause performance issues %s"), 
-						*Issue.NodeName, 
-						bIsHardReferenceCast ? TEXT("(hard reference)") : TEXT(""),
-						*ContextDescription);
-					Issue.Severity = CastSeverity;
-					Issue.NodeGuid = CastNode->NodeGuid;
-					
-					OutIssues.Add(Issue);
-				}
+				OutIssues.Add(Issue);
 			}
 		}
 	}
 }
 
-void FStaticLinter::DetectTickAbuse(UBlueprint* Blueprint, TArray<FLintIssue>& OutIssues)
+void FStaticLinter::DetectTickAbuse(const FBlueprintLintSnapshot& Snapshot, const FLintSnapshotIndex& GraphIndices, TArray<FLintIssue>& OutIssues) const
 {
-	if (!Blueprint)
-	{
-		return;
-	}
+	BLUEPRINTPROFILER_SCOPE_CYCLE_COUNTER(STAT_LintDetectTickAbuse);
 
-	for (UEdGraph* Graph : Blueprint->UbergraphPages)
+	for (int32 GraphIndex = 0; GraphIndex < Snapshot.Graphs.Num(); ++GraphIndex)
 	{
-		if (!Graph)
+		const FLintGraphSnapshot& Graph = Snapshot.Graphs[GraphIndex];
+		if (Graph.Kind != ELintGraphKind::Ubergraph)
 		{
 			continue;
 		}
 
-		for (UEdGraphNode* Node : Graph->Nodes)
+		// Look for Event Tick nodes
+		const FLintGraphIndex& Index = GraphIndices[GraphIndex];
+		for (TConstSetBitIterator<> It(Index.TickEvents); It; ++It)
 		{
-			if (!Node)
-			{
-				continue;
-			}
+			const int32 NodeIndex = It.GetIndex();
+			const FLintNodeSnapshot& EventNode = Graph.Nodes[NodeIndex];
+
+			// Count connected nodes to estimate complexity
+			const int32 ConnectedNodeCount = Index.CountReachable(NodeIndex);
 
-			// Look for Event Tick nodes
-			if (UK2Node_Event* EventNode = Cast<UK2Node_Event>(Node))
+			// Flag tick events with high complexity
+			if (ConnectedNodeCount > 10) // Arbitrary threshold
 			{
-				if (EventNode->GetFunctionName() == TEXT("ReceiveTick") || 
-					EventNode->GetFunctionName() == TEXT("Tick"))
-				{
-					// Count connected nodes to estimate complexity
-					int32 ConnectedNodeCount = 0;
-					TSet<UEdGraphNode*> VisitedNodes;
-					CountConnectedNodes(EventNode, VisitedNodes, ConnectedNodeCount);
+				FLintIssue Issue;
+				Issue.Type = ELintIssueType::TickAbuse;
+				Issue.BlueprintPath = Snapshot.BlueprintPath;
+				Issue.NodeName = TEXT("Event Tick");
+				Issue.Description = FString::Printf(TEXT("Tick event has high complexity (%d connected nodes)"), ConnectedNodeCount);
+				Issue.Severity = CalculateIssueSeverity(ELintIssueType::TickAbuse, ConnectedNodeCount);
+				Issue.NodeGuid = EventNode.NodeGuid;
 
-					// Flag tick events with high complexity
-					if (ConnectedNodeCount > 10) // Arbitrary threshold
-					{
-						FLintIssue Issue;
-						Issue.Type = ELintIssueType::TickAbuse;
-						Issue.BlueprintPath = Blueprint->GetPathName();
-						Issue.NodeName = TEXT("Event Tick");
-						Issue.Description = FString::Printf(TEXT("Tick event has high complexity (%d connected nodes)"), ConnectedNodeCount);
-						Issue.Severity = CalculateIssueSeverity(ELintIssueType::TickAbuse, ConnectedNodeCount);
-						Issue.NodeGuid = EventNode->NodeGuid;
-						
-						OutIssues.Add(Issue);
-					}
-				}
+				OutIssues.Add(Issue);
 			}
 		}
 	}
 }
 
-void FStaticLinter::DetectUnusedFunctions(UBlueprint* Blueprint, TArray<FLintIssue>& OutIssues)
+void FStaticLinter::DetectUnusedFunctions(const FBlueprintLintSnapshot& Snapshot, const FLintReferenceIndex& ReferenceIndex, TArray<FLintIssue>& OutIssues) const
 {
-	if (!Blueprint)
-	{
-		return;
-	}
+	BLUEPRINTPROFILER_SCOPE_CYCLE_COUNTER(STAT_LintDetectUnusedFunctions);
 
 	// 0. 首先跳过接口 Blueprint（BPI_ 开头）
 	//    接口中的函数不需要被调用，它们是被其他 Blueprint 实现的
-	FString BlueprintName = Blueprint->GetName();
-	if (BlueprintName.StartsWith(TEXT("BPI_")))
+	if (Snapshot.BlueprintName.StartsWith(TEXT("BPI_")))
 	{
-		// 这是接口 Blueprint，不检测未引用函数
 		return;
 	}
 
 	// 1. 跳过 GameInstance 蓝图
-	if (Blueprint->GeneratedClass && Blueprint->GeneratedClass->IsChildOf(UGameInstance::StaticClass()))
+	if (Snapshot.bGameInstance)
 	{
 		return;
 	}
-	else if (Blueprint->ParentClass && Blueprint->ParentClass->IsChildOf(UGameInstance::StaticClass()))
-	{
-		return;
-	}
-
-	// 获取项目中所有 Blueprint 来检测函数调用
-	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-	IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
-
-	if (!AssetRegistry.IsLoadingAssets())
-	{
-		AssetRegistry.SearchAllAssets(true);
-	}
-
-	TArray<FAssetData> AllBlueprintAssets;
-	FARFilter Filter;
-	Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
-	Filter.bRecursivePaths = true;
-	Filter.PackagePaths.Add(FName(TEXT("/Game")));
-	AssetRegistry.GetAssets(Filter, AllBlueprintAssets);
-
-	
-
-	for (const FAssetData& AssetData : AllBlueprintAssets)
-	{
-		UBlueprint* BP = Cast<UBlueprint>(AssetData.GetAsset());
-		if (!BP)
-		{
-			continue;
-		}
-
-		TArray<UEdGraph*> AllGraphs = GetAllGraphs(BP);
-		for (UEdGraph* Graph : AllGraphs)
-		{
-			if (!Graph)
-			{
-				continue;
-			}
 
-			for (UEdGraphNode* Node : Graph->Nodes)
-			{
-				if (UK2Node_CallFunction* CallFuncNode = Cast<UK2Node_CallFunction>(Node))
-			{
-				FName FunctionName = CallFuncNode->FunctionReference.GetMemberName();
-				if (FunctionName != NAME_None)
-				{
-					ReferencedFunctions.Add(FunctionName);
-					FunctionCallCount.FindOrAdd(FunctionName)++;
-				}
-				
-				// 也记录函数引用的完整路径（包含类名），用于跨蓝图引用检测
-				FString FullFunctionPath = CallFuncNode->FunctionReference.GetMemberParentClass() ? 
-					CallFuncNode->FunctionReference.GetMemberParentClass()->GetName() + TEXT(".") + FunctionName.ToString() :
-					FunctionName.ToString();
-				if (!FullFunctionPath.IsEmpty())
-				{
-					ReferencedFunctions.Add(FName(*FullFunctionPath));
-				}
-
-				// 检查 SetTimer 节点 - 通过函数名字符串引用函数
-				// 检查是否是 SetTimer 相关函数（包括设置、清除、暂停、获取等所有定时器操作）
-				if (FunctionName.ToString().StartsWith(TEXT("K2_SetTimer")) ||
-					FunctionName.ToString().StartsWith(TEXT("K2_ClearTimer")) ||
-					FunctionName.ToString().StartsWith(TEXT("K2_PauseTimer")) ||
-					FunctionName.ToString().StartsWith(TEXT("K2_UnPauseTimer")) ||
-					FunctionName.ToString().StartsWith(TEXT("K2_IsTimer")) ||
-					FunctionName.ToString().StartsWith(TEXT("K2_GetTimer")) ||
-					FunctionName.ToString().StartsWith(TEXT("K2_DoesTimer")))
-				{
-					// 查找 FunctionName 引脚
-					for (UEdGraphPin* Pin : Node->Pins)
-					{
-						if (Pin && Pin->PinName.ToString() == TEXT("FunctionName") && Pin->LinkedTo.Num() == 0)
-						{
-							// 获取函数名字符串值
-							FString TimerFunctionName = Pin->DefaultValue;
-							if (!TimerFunctionName.IsEmpty())
-							{
-								ReferencedFunctions.Add(FName(*TimerFunctionName));
-							}
-						}
-					}
-				}
-			}
-			// 也检查自定义事件调用
-			else if (UK2Node_CustomEvent* CustomEventNode = Cast<UK2Node_CustomEvent>(Node))
-			{
-				// 自定义事件可能被其他节点通过 GUID 调用
-			}
-			// 检查事件分发器绑定 - 这是跨蓝图引用的重要来源
-			else if (UK2Node_BaseMCDelegate* DelegateNode = Cast<UK2Node_BaseMCDelegate>(Node))
-			{
-				FName DelegateName = DelegateNode->GetPropertyName();
-				if (DelegateName != NAME_None)
-				{
-					ReferencedFunctions.Add(DelegateName);
-					
-					// 对于 AddDelegate 和 AssignDelegate，还要记录被绑定的自定义事件
-					if (Cast<UK2Node_AddDelegate>(Node) || Cast<UK2Node_AssignDelegate>(Node))
-					{
-						// 使用 GetDelegatePin() 获取委托输入引脚
-						UEdGraphPin* DelegatePin = DelegateNode->GetDelegatePin();
-						if (DelegatePin && DelegatePin->LinkedTo.Num() > 0)
-						{
-							for (UEdGraphPin* LinkedPin : DelegatePin->LinkedTo)
-							{
-								if (LinkedPin && LinkedPin->GetOwningNode())
-								{
-									UEdGraphNode* ConnectedNode = LinkedPin->GetOwningNode();
-									if (UK2Node_CustomEvent* BoundEvent = Cast<UK2Node_CustomEvent>(ConnectedNode))
-									{
-										FName EventName = BoundEvent->GetFunctionName();
-										if (EventName != NAME_None)
-										{
-											ReferencedFunctions.Add(EventName);
-										}
-									}
-								}
-							}
-						}
-					}
-				}
-			}
-			}
-		}
-	}
+	// 2. 常见的引擎接口函数命名模式
+	//    这些函数通常来自接口，不应该被报告为未引用
+	static const TArray<FString> InterfaceFunctionPatterns = {
+		TEXT("GetPlayerState"),
+		TEXT("GetController"),
+		TEXT("GetPawn"),
+		TEXT("GetCharacter"),
+		TEXT("GetOwner"),
+		TEXT("GetGameInstance"),
+		TEXT("GetWorld"),
+		TEXT("GetLevel"),
+		TEXT("GetParent"),
+		TEXT("IsA"),
+		TEXT("IsValid"),
+		TEXT("K2_"),           // K2_ 开头的函数通常是引擎生成的
+		TEXT("Execute"),       // Execute 相关函数
+		TEXT("Ubergraph"),     // Ubergraph 相关函数
+		TEXT("UserConstructionScript"),
+		TEXT("ConstructionScript"),
+		// 常见接口前缀
+		TEXT("HasAuthority"),   // INetworkInterface
+		TEXT("GetNetConnection"),
+		TEXT("GetNetMode"),
+		TEXT("IsNetMode"),
+	};
 
 	// 检查当前 Blueprint 的函数是否被引用
-	for (UEdGraph* FunctionGraph : Blueprint->FunctionGraphs)
+	for (const FLintGraphSnapshot& FunctionGraph : Snapshot.Graphs)
 	{
-		if (!FunctionGraph)
+		if (FunctionGraph.Kind != ELintGraphKind::Function)
 		{
 			continue;
 		}
 
-		FName FunctionName = FunctionGraph->GetFName();
-		FString FunctionNameStr = FunctionName.ToString();
+		const FName FunctionName = FunctionGraph.Name;
+		const FString FunctionNameStr = FunctionName.ToString();
 
 		// ========== 跳过系统自带函数和接口函数的判断标准 ==========
 
@@ -874,32 +592,6 @@ void FStaticLinter::DetectUnusedFunctions(UBlueprint* Blueprint, TArray<FLintIss
 			continue;
 		}
 
-		// 2. 常见的引擎接口函数命名模式
-		//    这些函数通常来自接口，不应该被报告为未引用
-		TArray<FString> InterfaceFunctionPatterns = {
-			TEXT("GetPlayerState"),
-			TEXT("GetController"),
-			TEXT("GetPawn"),
-			TEXT("GetCharacter"),
-			TEXT("GetOwner"),
-			TEXT("GetGameInstance"),
-			TEXT("GetWorld"),
-			TEXT("GetLevel"),
-			TEXT("GetParent"),
-			TEXT("IsA"),
-			TEXT("IsValid"),
-			TEXT("K2_"),           // K2_ 开头的函数通常是引擎生成的
-			TEXT("Execute"),       // Execute 相关函数
-			TEXT("Ubergraph"),     // Ubergraph 相关函数
-			TEXT("UserConstructionScript"),
-			TEXT("ConstructionScript"),
-			// 常见接口前缀
-			TEXT("HasAuthority"),   // INetworkInterface
-			TEXT("GetNetConnection"),
-			TEXT("GetNetMode"),
-			TEXT("IsNetMode"),
-		};
-
 		bool bIsEnginePattern = false;
 		for (const FString& Pattern : InterfaceFunctionPatterns)
 		{
@@ -915,72 +607,27 @@ void FStaticLinter::DetectUnusedFunctions(UBlueprint* Blueprint, TArray<FLintIss
 		}
 
 		// 3. 检查是否是 Override 函数（覆盖父类虚函数）
-		bool bIsOverrideFunction = false;
-		if (Blueprint->ParentClass)
-		{
-			UFunction* ParentFunction = Blueprint->ParentClass->FindFunctionByName(FunctionName);
-			if (ParentFunction)
-			{
-				bIsOverrideFunction = true;
-			}
-		}
-
-		if (bIsOverrideFunction)
+		if (FunctionGraph.bOverridesParentFunction)
 		{
 			continue;
 		}
 
 		// 4. 跳过来自引擎或第三方插件的 Blueprint
-		FString BlueprintPath = Blueprint->GetPathName();
-		if (BlueprintPath.StartsWith(TEXT("/Engine/")) ||
-			BlueprintPath.StartsWith(TEXT("/Game/")) == false)
+		if (Snapshot.BlueprintPath.StartsWith(TEXT("/Engine/")) ||
+			Snapshot.BlueprintPath.StartsWith(TEXT("/Game/")) == false)
 		{
 			continue;
 		}
 
 		// 5. 跳过接口函数（通过检查继承链）
+		if (FunctionGraph.bImplementsInterfaceFunction)
 		{
-			bool bIsInterfaceFunction = false;
-			UClass* CurrentClass = Blueprint->GeneratedClass ? Blueprint->GeneratedClass : Blueprint->ParentClass;
-
-			while (CurrentClass && !bIsInterfaceFunction)
-			{
-				// 检查当前类实现的所有接口
-				for (const FImplementedInterface& Interface : CurrentClass->Interfaces)
-				{
-					if (Interface.Class && Interface.Class->FindFunctionByName(FunctionName))
-					{
-						bIsInterfaceFunction = true;
-						break;
-					}
-				}
-
-				if (bIsInterfaceFunction)
-				{
-					break;
-				}
-
-				// 向上检查父类
-				CurrentClass = CurrentClass->GetSuperClass();
-			}
-
-			if (bIsInterfaceFunction)
-			{
-				continue;
-			}
+			continue;
 		}
 
-		// 6. 使用虚幻引擎原生的引用检测机制检查函数是否被引用
-		// FBlueprintEditorUtils::IsFunctionUsed 会自动搜索当前蓝图和所有引用该蓝图的其他蓝图
-		bool bIsReferenced = FBlueprintEditorUtils::IsFunctionUsed(Blueprint, FunctionName);
-
+		// 6. 虚幻引擎原生的引用检测（FBlueprintEditorUtils::IsFunctionUsed，建快照时已在游戏线程上求值）
 		// 7. 检查我们自己收集的引用列表（包括 SetTimer 等通过函数名字符串的引用）
-		if (!bIsReferenced)
-		{
-			bIsReferenced = ReferencedFunctions.Contains(FunctionName);
-		}
-
-		if (bIsReferenced)
+		if (FunctionGraph.bUsedByEditorReferences || ReferenceIndex.IsFunctionReferenced(FunctionName))
 		{
 			continue;  // 函数被引用，跳过
 		}
@@ -988,7 +635,7 @@ void FStaticLinter::DetectUnusedFunctions(UBlueprint* Blueprint, TArray<FLintIss
 		// 函数未被引用，报告问题
 		FLintIssue Issue;
 		Issue.Type = ELintIssueType::UnusedFunction;
-		Issue.BlueprintPath = Blueprint->GetPathName();
+		Issue.BlueprintPath = Snapshot.BlueprintPath;
 		Issue.NodeName = FunctionNameStr;
 		if (FBlueprintProfilerLocalization::IsChinese())
 		{
@@ -1005,49 +652,27 @@ void FStaticLinter::DetectUnusedFunctions(UBlueprint* Blueprint, TArray<FLintIss
 	}
 
 	// ========== 检查未引用的宏 ==========
-	// 收集所有被引用的宏
-	TSet<FName> ReferencedMacros;
-	for (const FAssetData& AssetData : AllBlueprintAssets)
+	// 当前 Blueprint 中实例化的宏只收集一次，而不是每个宏图都遍历所有节点
+	TSet<FString> InstancedMacroPaths;
+	for (const FLintGraphSnapshot& Graph : Snapshot.Graphs)
 	{
-		UBlueprint* BP = Cast<UBlueprint>(AssetData.GetAsset());
-		if (!BP)
+		for (const FLintNodeSnapshot& Node : Graph.Nodes)
 		{
-			continue;
-		}
-
-		TArray<UEdGraph*> AllGraphs = GetAllGraphs(BP);
-		for (UEdGraph* Graph : AllGraphs)
-		{
-			if (!Graph)
-			{
-				continue;
-			}
-
-			for (UEdGraphNode* Node : Graph->Nodes)
+			if (Node.Kind == ELintNodeKind::MacroInstance)
 			{
-				if (UK2Node_MacroInstance* MacroInstance = Cast<UK2Node_MacroInstance>(Node))
-				{
-					// 获取被引用的宏图
-					UEdGraph* ReferencedMacroGraph = MacroInstance->GetMacroGraph();
-					if (ReferencedMacroGraph)
-					{
-						ReferencedMacros.Add(ReferencedMacroGraph->GetFName());
-					}
-				}
+				InstancedMacroPaths.Add(Node.MacroGraphPath);
 			}
 		}
 	}
 
-	// 检查当前 Blueprint 的宏是否被引用
-	for (UEdGraph* MacroGraph : Blueprint->MacroGraphs)
+	for (const FLintGraphSnapshot& MacroGraph : Snapshot.Graphs)
 	{
-		if (!MacroGraph)
+		if (MacroGraph.Kind != ELintGraphKind::Macro)
 		{
 			continue;
 		}
 
-		FName MacroName = MacroGraph->GetFName();
-		FString MacroNameStr = MacroName.ToString();
+		const FString MacroNameStr = MacroGraph.Name.ToString();
 
 		// 跳过引擎自带的宏（通常以特定前缀开头）
 		if (MacroNameStr.StartsWith(TEXT("K2_")) ||
@@ -1056,39 +681,8 @@ void FStaticLinter::DetectUnusedFunctions(UBlueprint* Blueprint, TArray<FLintIss
 			continue;
 		}
 
-		// 检查宏是否被引用
-		bool bIsMacroReferenced = ReferencedMacros.Contains(MacroName);
-
-		// 也检查是否在当前 Blueprint 中被引用
-		if (!bIsMacroReferenced)
-		{
-			TArray<UEdGraph*> AllGraphs = GetAllGraphs(Blueprint);
-			for (UEdGraph* Graph : AllGraphs)
-			{
-				if (!Graph)
-				{
-					continue;
-				}
-
-				for (UEdGraphNode* Node : Graph->Nodes)
-				{
-					if (UK2Node_MacroInstance* MacroInstance = Cast<UK2Node_MacroInstance>(Node))
-					{
-						if (MacroInstance->GetMacroGraph() == MacroGraph)
-						{
-							bIsMacroReferenced = true;
-							break;
-						}
-					}
-				}
-				if (bIsMacroReferenced)
-				{
-					break;
-				}
-			}
-		}
-
-		if (bIsMacroReferenced)
+		// 检查宏是否被引用，也检查是否在当前 Blueprint 中被引用
+		if (ReferenceIndex.IsMacroReferenced(MacroGraph.Name) || InstancedMacroPaths.Contains(MacroGraph.PathName))
 		{
 			continue;  // 宏被引用，跳过
 		}
@@ -1096,7 +690,7 @@ void FStaticLinter::DetectUnusedFunctions(UBlueprint* Blueprint, TArray<FLintIss
 		// 宏未被引用，报告问题
 		FLintIssue Issue;
 		Issue.Type = ELintIssueType::UnusedFunction;
-		Issue.BlueprintPath = Blueprint->GetPathName();
+		Issue.BlueprintPath = Snapshot.BlueprintPath;
 		Issue.NodeName = MacroNameStr;
 		if (FBlueprintProfilerLocalization::IsChinese())
 		{
@@ -1114,97 +708,10 @@ void FStaticLinter::DetectUnusedFunctions(UBlueprint* Blueprint, TArray<FLintIss
 }
 
 // Context analysis helpers
-bool FStaticLinter::IsNodeInTickContext(UEdGraphNode* Node, TSet<UEdGraphNode*>& VisitedNodes) const
-{
-	if (!Node || VisitedNodes.Contains(Node))
-	{
-		return false;
-	}
-
-	VisitedNodes.Add(Node);
-
-	// Check if this is a tick event node
-	if (UK2Node_Event* EventNode = Cast<UK2Node_Event>(Node))
-	{
-		FName EventName = EventNode->GetFunctionName();
-		if (EventName == TEXT("ReceiveTick") || EventName == TEXT("Tick"))
-		{
-			return true;
-		}
-	}
-
-	// Trace backwards through execution pins to find the source
-	for (UEdGraphPin* Pin : Node->Pins)
-	{
-		if (Pin && Pin->Direction == EGPD_Input && Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec)
-		{
-			for (UEdGraphPin* LinkedPin : Pin->LinkedTo)
-			{
-				if (LinkedPin && LinkedPin->GetOwningNode())
-				{
-					if (IsNodeInTickContext(LinkedPin->GetOwningNode(), VisitedNodes))
-					{
-						return true;
-					}
-				}
-			}
-		}
-	}
-
-	return false;
-}
-
-bool FStaticLinter::IsNodeInLoopContext(UEdGraphNode* Node, TSet<UEdGraphNode*>& VisitedNodes) const
+bool FStaticLinter::IsNodeInFrequentlyCalledFunction(const FLintGraphSnapshot& Graph) const
 {
-	if (!Node || VisitedNodes.Contains(Node))
-	{
-		return false;
-	}
-
-	VisitedNodes.Add(Node);
-
-	// Check if this is a loop node
-	FString NodeClass = Node->GetClass()->GetName();
-	if (NodeClass.Contains(TEXT("ForLoop")) || 
-		NodeClass.Contains(TEXT("WhileLoop")) || 
-		NodeClass.Contains(TEXT("ForEach")))
-	{
-		return true;
-	}
-
-	// Trace backwards through execution pins
-	for (UEdGraphPin* Pin : Node->Pins)
-	{
-		if (Pin && Pin->Direction == EGPD_Input && Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec)
-		{
-			for (UEdGraphPin* LinkedPin : Pin->LinkedTo)
-			{
-				if (LinkedPin && LinkedPin->GetOwningNode())
-				{
-					if (IsNodeInLoopContext(LinkedPin->GetOwningNode(), VisitedNodes))
-					{
-						return true;
-					}
-				}
-			}
-		}
-	}
-
-	return false;
-}
-
-bool FStaticLinter::IsNodeInFrequentlyCalledFunction(UEdGraphNode* Node, UEdGraph* Graph) const
-{
-	if (!Graph)
-	{
-		return false;
-	}
-
-	// Check if the graph is a function graph with certain naming patterns
-	FString GraphName = Graph->GetName();
-	
 	// Common patterns for frequently called functions
-	TArray<FString> FrequentPatterns = {
+	static const TArray<FString> FrequentPatterns = {
 		TEXT("Update"),
 		TEXT("Process"),
 		TEXT("Calculate"),
@@ -1214,6 +721,8 @@ bool FStaticLinter::IsNodeInFrequentlyCalledFunction(UEdGraphNode* Node, UEdGrap
 		TEXT("IsValid")
 	};
 
+	// Check if the graph is a function graph with certain naming patterns
+	const FString GraphName = Graph.Name.ToString();
 	for (const FString& Pattern : FrequentPatterns)
 	{
 		if (GraphName.Contains(Pattern))
@@ -1224,33 +733,3 @@ bool FStaticLinter::IsNodeInFrequentlyCalledFunction(UEdGraphNode* Node, UEdGrap
 
 	return false;
 }
-
-bool FStaticLinter::IsHardReferenceCast(UK2Node_DynamicCast* CastNode) const
-{
-	if (!CastNode)
-	{
-		return false;
-	}
-
-	// Check if the target class is a hard reference (not an interface)
-	UClass* TargetClass = CastNode->TargetType;
-	if (TargetClass && !TargetClass->HasAnyClassFlags(CLASS_Interface))
-	{
-		// Additional checks for expensive casts
-		FString ClassName = TargetClass->GetName();
-		
-		// Actor casts are generally more expensive
-		if (TargetClass->IsChildOf(AActor::StaticClass()))
-		{
-			return true;
-		}
-		
-		// Component casts can also be expensive
-		if (TargetClass->IsChildOf(UActorComponent::StaticClass()))
-		{
-			return true;
-		}
-	}
-
-	return false;
-}
@@ -2,125 +2,242 @@
 
 #include "Analyzers/StaticLinter.h"
 #include "Async/Async.h"
-#include "HAL/PlatformProcess.h"
+#include "Async/ParallelFor.h"
 
-FScanTask::FScanTask(TSharedPtr<FStaticLinter> InLinter, const TArray<FAssetData>& InAssets, const FScanConfiguration& InConfig)
+FScanTask::FScanTask(TSharedPtr<FStaticLinter> InLinter, const FScanConfiguration& InConfig, bool bInInline)
 	: LinterWeak(InLinter)
-	, Assets(InAssets)
 	, Config(InConfig)
+	, bInline(bInInline)
+	, Pipe(TEXT("StaticLinterScan"))
 {
 }
 
-void FScanTask::DoWork()
+FScanTask::~FScanTask()
 {
-	// Process assets in batches to avoid blocking the game thread for too long
-	TArray<FLintIssue> AllIssues;
-	FThreadSafeCounter ProcessedCount;
-	int32 TotalAssets = Assets.Num();
-	int32 CurrentIndex = 0;
+	Wait();
+}
 
-	UE_LOG(LogTemp, Log, TEXT("FScanTask: Starting to process %d assets with frame splitting"), TotalAssets);
+void FScanTask::Run(const TCHAR* DebugName, TUniqueFunction<void()>&& Body)
+{
+	if (bInline)
+	{
+		Body();
+	}
+	else
+	{
+		Pipe.Launch(DebugName, MoveTemp(Body), UE::Tasks::ETaskPriority::BackgroundNormal);
+	}
+}
 
-	// Process assets one by one, yielding control back to the game thread between each asset
-	while (CurrentIndex < TotalAssets && !IsCancelRequested())
+void FScanTask::AddSnapshots(TArray<FLintScanItem>&& Batch)
+{
+	Run(TEXT("StaticLinterBatch"), [this, Batch = MoveTemp(Batch)]() mutable
 	{
-		TSharedPtr<FStaticLinter> LinterPin = LinterWeak.Pin();
-		if (!LinterPin.IsValid())
+		const int32 FirstItem = Items.Num();
+		Items.Append(MoveTemp(Batch));
+		LocalIssues.SetNum(Items.Num());
+		Timings.SetNum(Items.Num());
+
+		// 缓存命中的资产直接沿用上次的单蓝图检测结果
+		for (int32 ItemIndex = FirstItem; ItemIndex < Items.Num(); ++ItemIndex)
 		{
-			UE_LOG(LogTemp, Warning, TEXT("FScanTask: Linter was destroyed, aborting scan"));
-			return;
+			if (Items[ItemIndex].bHasCachedLocalIssues)
+			{
+				LocalIssues[ItemIndex] = MoveTemp(Items[ItemIndex].LocalIssues);
+			}
 		}
 
-		if (LinterPin->IsCancelRequested())
+		const int32 NumItems = Items.Num() - FirstItem;
+		TSharedPtr<FStaticLinter> LinterPin = LinterWeak.Pin();
+		if (LinterPin.IsValid() && !IsCancelRequested())
 		{
-			UE_LOG(LogTemp, Log, TEXT("FScanTask: Scan was cancelled after %d assets"), ProcessedCount.GetValue());
-			break;
+			AnalyzeRange(*LinterPin, FirstItem, NumItems, nullptr, LocalIssues);
 		}
 
-		const FAssetData& AssetData = Assets[CurrentIndex];
-
-		// Process this blueprint on the game thread (required for blueprint loading)
-		// But use a synchronous approach within the async task
-		TArray<FLintIssue> AssetIssues;
-		
-		// Execute on game thread but wait for completion
-		FEvent* CompletionEvent = FPlatformProcess::GetSynchEventFromPool(false);
-		bool bProcessed = false;
-		
-		AsyncTask(ENamedThreads::GameThread, [this, &AssetData, &AssetIssues, &LinterPin, &CompletionEvent, &bProcessed]()
+		// 写缓存需要一份单蓝图结果，在交给游戏线程之前生成条目
+		const uint32 ChecksMask = FStaticLinterCache::GetChecksMask(Config.EnabledChecks);
+		const bool bFunctionUsageResolved = Config.EnabledChecks.Contains(ELintIssueType::UnusedFunction);
+		for (int32 ItemIndex = FirstItem; ItemIndex < Items.Num() && !IsCancelRequested(); ++ItemIndex)
 		{
-			if (LinterPin.IsValid())
+			const FLintScanItem& Item = Items[ItemIndex];
+			if (Item.bHasCachedLocalIssues || Item.PackageHash.IsZero())
 			{
-				LinterPin->ProcessBlueprint(AssetData, Config, AssetIssues);
-				bProcessed = true;
+				continue;
 			}
-			CompletionEvent->Trigger();
-		});
 
-		// Wait for game thread processing with timeout to allow UI updates
-		while (!CompletionEvent->Wait(10)) // 10ms timeout to allow UI thread to process
+			TSharedRef<FStaticLinterCache::FEntry> Entry = MakeShared<FStaticLinterCache::FEntry>();
+			Entry->PackageHash = Item.PackageHash;
+			Entry->ChecksMask = ChecksMask;
+			Entry->bFunctionUsageResolved = bFunctionUsageResolved;
+			Entry->LoadSeconds = Item.LoadSeconds;
+			Entry->AnalysisSeconds = Timings[ItemIndex].GetTotalSeconds();
+			Entry->Snapshot = Item.Snapshot;
+			Entry->CallSites = FLintCallSites::Collect(*Item.Snapshot);
+			Entry->LocalIssues = LocalIssues[ItemIndex];
+			PendingCacheEntries.Emplace(ItemIndex, Entry);
+		}
+
+		PublishIssues(FirstItem, NumItems, LocalIssues, !bInline);
+	});
+}
+
+void FScanTask::Finish(FLintReferenceIndex&& InReferenceIndex)
+{
+	Run(TEXT("StaticLinterCrossBlueprint"), [this, Index = MoveTemp(InReferenceIndex)]() mutable
+	{
+		// 所有资产的调用点都已登记，一次性解析成调用图
+		ReferenceIndex = MoveTemp(Index);
+		ReferenceIndex.Resolve();
+		CrossIssues.SetNum(Items.Num());
+
+		TSharedPtr<FStaticLinter> LinterPin = LinterWeak.Pin();
+		if (!LinterPin.IsValid() || IsCancelRequested())
 		{
-			// Check cancellation during wait
-			TSharedPtr<FStaticLinter> CheckLinter = LinterWeak.Pin();
-			if (!CheckLinter.IsValid() || CheckLinter->IsCancelRequested())
-			{
-				break;
-			}
+			// CancelScan collects the partial results itself
+			return;
+		}
+
+		AnalyzeRange(*LinterPin, 0, Items.Num(), &ReferenceIndex, CrossIssues);
+		if (IsCancelRequested())
+		{
+			return;
+		}
+
+		// 跨蓝图一轮的耗时累加在同一个槽里，缓存条目保存的估算依据包含两轮
+		for (const TPair<int32, TSharedRef<FStaticLinterCache::FEntry>>& Pending : PendingCacheEntries)
+		{
+			Pending.Value->AnalysisSeconds = Timings[Pending.Key].GetTotalSeconds();
 		}
-		
-		FPlatformProcess::ReturnSynchEventToPool(CompletionEvent);
 
-		if (bProcessed)
+		// CompleteScan dispatches whatever is still queued, including these batches
+		PublishIssues(0, Items.Num(), CrossIssues, false);
+
+		bCompleted = true;
+		if (bInline)
 		{
-			// Accumulate issues
+			return;
+		}
+
+		UE_LOG(LogTemp, Log, TEXT("FScanTask: Completed analyzing %d blueprints"), Items.Num());
+
+		// Complete scan on game thread (async)
+		AsyncTask(ENamedThreads::GameThread, [LinterWeak = LinterWeak]()
+		{
+			TSharedPtr<FStaticLinter> CompleteLinter = LinterWeak.Pin();
+			if (CompleteLinter.IsValid())
 			{
-				FScopeLock Lock(&LinterPin->GetIssuesLock());
-				AllIssues.Append(AssetIssues);
+				CompleteLinter->CompleteScan();
 			}
+		});
+	});
+}
 
-			int32 CurrentCount = ProcessedCount.Increment();
+void FScanTask::Wait()
+{
+	Pipe.WaitUntilEmpty();
+}
 
-			// Update progress on game thread
-			AsyncTask(ENamedThreads::GameThread, [this, CurrentCount, TotalAssets, AssetData]()
-			{
-				TSharedPtr<FStaticLinter> UpdateLinter = LinterWeak.Pin();
-				if (UpdateLinter.IsValid())
-				{
-					UpdateLinter->UpdateScanProgress(CurrentCount, TotalAssets, AssetData.AssetName.ToString());
-				}
-			});
-
-			// Log progress for debugging
-			UE_LOG(LogTemp, Log, TEXT("FScanTask: Processed %d/%d - %s (%d issues found)"),
-				CurrentCount, TotalAssets, *AssetData.AssetName.ToString(), AssetIssues.Num());
+void FScanTask::PublishIssues(int32 FirstItem, int32 NumItems, TArray<TArray<FLintIssue>>& InOutIssues, bool bPostDispatch)
+{
+	bool bQueuedAny = false;
+	for (int32 ItemIndex = FirstItem; ItemIndex < FirstItem + NumItems; ++ItemIndex)
+	{
+		if (InOutIssues[ItemIndex].Num() > 0)
+		{
+			ReadyIssueBatches.Enqueue(MoveTemp(InOutIssues[ItemIndex]));
+			bQueuedAny = true;
 		}
+	}
 
-		CurrentIndex++;
+	if (bQueuedAny && bPostDispatch)
+	{
+		// 只投递一次唤醒，批次留在本任务的队列里；扫描取消后任务已销毁，唤醒什么也不做
+		AsyncTask(ENamedThreads::GameThread, [LinterWeak = LinterWeak]()
+		{
+			if (TSharedPtr<FStaticLinter> DispatchLinter = LinterWeak.Pin())
+			{
+				DispatchLinter->DispatchIssueBatches();
+			}
+		});
+	}
+}
 
-		// Small sleep to allow UI thread to process events
-		FPlatformProcess::Sleep(0.001f); // 1ms sleep between assets
+void FScanTask::CollectCacheEntries(FStaticLinterCache& Cache) const
+{
+	// 取消的扫描中部分单蓝图结果可能缺失，不写入缓存
+	if (!bCompleted)
+	{
+		return;
 	}
 
-	TSharedPtr<FStaticLinter> LinterPin = LinterWeak.Pin();
-	if (LinterPin.IsValid())
+	for (const TPair<int32, TSharedRef<FStaticLinterCache::FEntry>>& Pending : PendingCacheEntries)
 	{
-		UE_LOG(LogTemp, Log, TEXT("FScanTask: Completed processing %d assets, found %d total issues"),
-			ProcessedCount.GetValue(), AllIssues.Num());
+		Cache.Add(Items[Pending.Key].PackageName, Pending.Value);
 	}
+}
 
-	// Complete scan on game thread (async)
-	AsyncTask(ENamedThreads::GameThread, [this, AllIssues]()
+void FScanTask::GetTimings(TArray<FLintAssetTiming>& OutAssetTimings, FLintAnalysisTiming& OutTotals) const
+{
+	OutAssetTimings.Reset(Items.Num());
+	OutTotals = FLintAnalysisTiming();
+	for (int32 ItemIndex = 0; ItemIndex < Items.Num(); ++ItemIndex)
 	{
-		TSharedPtr<FStaticLinter> CompleteLinter = LinterWeak.Pin();
-		if (CompleteLinter.IsValid())
-		{
-			CompleteLinter->CompleteScan(AllIssues);
-		}
-	});
+		const FLintAnalysisTiming& Timing = Timings[ItemIndex];
+		OutTotals.Add(Timing);
+
+		FLintAssetTiming& AssetTiming = OutAssetTimings.AddDefaulted_GetRef();
+		AssetTiming.BlueprintPath = Items[ItemIndex].Snapshot->BlueprintPath;
+		AssetTiming.LoadSeconds = Items[ItemIndex].LoadSeconds;
+		AssetTiming.AnalysisSeconds = Timing.GetTotalSeconds();
+	}
 }
 
 bool FScanTask::IsCancelRequested() const
 {
-	TSharedPtr<FStaticLinter> LinterPin = LinterWeak.Pin();
-	return LinterPin.IsValid() && LinterPin->IsCancelRequested();
+	return bCancelled;
+}
+
+void FScanTask::AnalyzeRange(const FStaticLinter& Linter, int32 FirstItem, int32 NumItems, const FLintReferenceIndex* Index, TArray<TArray<FLintIssue>>& OutIssues)
+{
+	if (NumItems <= 0)
+	{
+		return;
+	}
+
+	// 按估计开销从大到小排列，worker 从共享游标领取下一个最重的快照；个别超大蓝图一开始就有人处理，
+	// 其余 worker 自行分担剩下的小蓝图，不会出现一个 worker 独自拖尾。结果写入各自的槽，无需加锁
+	TArray<int32> Order;
+	Order.Reserve(NumItems);
+	for (int32 ItemIndex = FirstItem; ItemIndex < FirstItem + NumItems; ++ItemIndex)
+	{
+		Order.Add(ItemIndex);
+	}
+	Order.StableSort([this](int32 A, int32 B)
+	{
+		return Items[A].EstimatedCost > Items[B].EstimatedCost;
+	});
+
+	std::atomic<int32> NextOrder{0};
+	const int32 NumWorkers = Config.bUseMultiThreading ? FMath::Clamp(Config.MaxConcurrentTasks, 1, NumItems) : 1;
+	ParallelFor(NumWorkers, [&](int32 /*WorkerIndex*/)
+	{
+		while (!IsCancelRequested())
+		{
+			const int32 OrderIndex = NextOrder.fetch_add(1, std::memory_order_relaxed);
+			if (OrderIndex >= NumItems)
+			{
+				break;
+			}
+			const int32 ItemIndex = Order[OrderIndex];
+
+			// 单蓝图检测的缓存结果已经放进 OutIssues
+			if (!Index && Items[ItemIndex].bHasCachedLocalIssues)
+			{
+				continue;
+			}
+
+			// 单蓝图和跨蓝图两轮的耗时累加在同一个槽里，两轮不会同时运行
+			Linter.AnalyzeSnapshot(*Items[ItemIndex].Snapshot, Config, Index, OutIssues[ItemIndex], &Timings[ItemIndex]);
+		}
+	}, NumWorkers > 1 ? EParallelForFlags::BackgroundPriority : EParallelForFlags::ForceSingleThread);
 }
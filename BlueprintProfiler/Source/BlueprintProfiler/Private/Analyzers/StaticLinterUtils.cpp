@@ -3,74 +3,8 @@
 #include "Analyzers/StaticLinter.h"
 #include "Engine/Blueprint.h"
 #include "AssetRegistry/AssetRegistryModule.h"
-#include "EdGraph/EdGraph.h"
-#include "EdGraph/EdGraphNode.h"
 #include "Engine/GameInstance.h"
-
-TArray<UEdGraph*> FStaticLinter::GetAllGraphs(UBlueprint* Blueprint) const
-{
-	TArray<UEdGraph*> AllGraphs;
-
-	if (!Blueprint)
-	{
-		return AllGraphs;
-	}
-
-	// Add ubergraph pages (event graphs)
-	for (UEdGraph* Graph : Blueprint->UbergraphPages)
-	{
-		if (Graph)
-		{
-			AllGraphs.Add(Graph);
-		}
-	}
-
-	// Add function graphs
-	for (UEdGraph* Graph : Blueprint->FunctionGraphs)
-	{
-		if (Graph)
-		{
-			AllGraphs.Add(Graph);
-		}
-	}
-
-	// Add macro graphs
-	for (UEdGraph* Graph : Blueprint->MacroGraphs)
-	{
-		if (Graph)
-		{
-			AllGraphs.Add(Graph);
-		}
-	}
-
-	return AllGraphs;
-}
-
-void FStaticLinter::CountConnectedNodes(UEdGraphNode* StartNode, TSet<UEdGraphNode*>& VisitedNodes, int32& NodeCount)
-{
-	if (!StartNode || VisitedNodes.Contains(StartNode))
-	{
-		return;
-	}
-
-	VisitedNodes.Add(StartNode);
-	NodeCount++;
-
-	// Follow execution pins
-	for (UEdGraphPin* Pin : StartNode->Pins)
-	{
-		if (Pin && Pin->Direction == EGPD_Output && Pin->PinType.PinCategory == TEXT("exec"))
-		{
-			for (UEdGraphPin* LinkedPin : Pin->LinkedTo)
-			{
-				if (LinkedPin && LinkedPin->GetOwningNode())
-				{
-					CountConnectedNodes(LinkedPin->GetOwningNode(), VisitedNodes, NodeCount);
-				}
-			}
-		}
-	}
-}
+#include "Misc/PackageName.h"
 
 ESeverity FStaticLinter::CalculateIssueSeverity(ELintIssueType Type, int32 Count) const
 {
@@ -195,26 +129,29 @@ bool FStaticLinter::ShouldProcessAsset(const FAssetData& AssetData, const FScanC
 	}
 	
 	// Exclude GameInstance blueprints
-	UBlueprint* Blueprint = Cast<UBlueprint>(AssetData.GetAsset());
-	if (Blueprint)
+	// 已加载的蓝图直接查类；未加载的从资产注册表标签读取原生父类，避免为过滤而加载包（lint 缓存命中时不应加载）
+	const UClass* ParentClass = nullptr;
+	if (AssetData.IsAssetLoaded())
 	{
-		if (Blueprint->GeneratedClass)
+		if (const UBlueprint* Blueprint = Cast<UBlueprint>(AssetData.GetAsset()))
 		{
-			if (Blueprint->GeneratedClass->IsChildOf(UGameInstance::StaticClass()))
-			{
-				UE_LOG(LogTemp, Log, TEXT("Excluding GameInstance blueprint: %s"), *Blueprint->GetName());
-				return false;
-			}
+			ParentClass = Blueprint->GeneratedClass ? Blueprint->GeneratedClass.Get() : Blueprint->ParentClass.Get();
 		}
-		else if (Blueprint->ParentClass)
+	}
+	else
+	{
+		const FString NativeParentClassPath = AssetData.GetTagValueRef<FString>(FBlueprintTags::NativeParentClassPath);
+		if (!NativeParentClassPath.IsEmpty())
 		{
-			if (Blueprint->ParentClass->IsChildOf(UGameInstance::StaticClass()))
-			{
-				UE_LOG(LogTemp, Log, TEXT("Excluding GameInstance blueprint: %s"), *Blueprint->GetName());
-				return false;
-			}
+			ParentClass = FindObject<UClass>(nullptr, *FPackageName::ExportTextPathToObjectPath(NativeParentClassPath));
 		}
 	}
+
+	if (ParentClass && ParentClass->IsChildOf(UGameInstance::StaticClass()))
+	{
+		UE_LOG(LogTemp, Log, TEXT("Excluding GameInstance blueprint: %s"), *AssetData.AssetName.ToString());
+		return false;
+	}
 	
 	return true;
 }
@@ -4,6 +4,7 @@
 #include "BlueprintProfilerStyle.h"
 #include "BlueprintProfilerCommands.h"
 #include "BlueprintProfilerLocalization.h"
+#include "Analyzers/BlueprintLintTags.h"
 #include "UI/SBlueprintProfilerWidget.h"
 #include "LevelEditor.h"
 #include "Widgets/Docking/SDockTab.h"
@@ -23,6 +24,9 @@ void FBlueprintProfilerModule::StartupModule()
 	FBlueprintProfilerStyle::ReloadTextures();
 
 	FBlueprintProfilerCommands::Register();
+
+	// Lint summary tags are written whenever a blueprint is saved
+	FBlueprintLintTags::Register();
 	
 	PluginCommands = MakeShareable(new FUICommandList);
 
@@ -54,6 +58,8 @@ void FBlueprintProfilerModule::ShutdownModule()
 
 	FBlueprintProfilerCommands::Unregister();
 
+	FBlueprintLintTags::Unregister();
+
 	FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(BlueprintProfilerTabName);
 }
 
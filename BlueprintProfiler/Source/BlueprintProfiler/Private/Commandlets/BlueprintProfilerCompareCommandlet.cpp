@@ -0,0 +1,93 @@
+// Copyright xnbmy 2026. All Rights Reserved.
+
+#include "Commandlets/BlueprintProfilerCompareCommandlet.h"
+#include "Analyzers/SessionComparison.h"
+#include "Misc/Paths.h"
+
+UBlueprintProfilerCompareCommandlet::UBlueprintProfilerCompareCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UBlueprintProfilerCompareCommandlet::Main(const FString& Params)
+{
+	FString BaselinePath;
+	FString CurrentPath;
+	if (!FParse::Value(*Params, TEXT("baseline="), BaselinePath) || !FParse::Value(*Params, TEXT("current="), CurrentPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Usage: -run=BlueprintProfilerCompare -baseline=<file> -current=<file> [-blueprints=A+B] [-maxregression=Percent]"));
+		return 2;
+	}
+
+	// -blueprints=
+	TArray<FString> TrackedBlueprints;
+	FString Value;
+	if (FParse::Value(*Params, TEXT("blueprints="), Value, false))
+	{
+		Value.Replace(TEXT("+"), TEXT(",")).ParseIntoArray(TrackedBlueprints, TEXT(","), true);
+		for (FString& Name : TrackedBlueprints)
+		{
+			Name.TrimStartAndEndInline();
+		}
+	}
+
+	FSessionComparisonSettings Settings;
+	FParse::Value(*Params, TEXT("maxregression="), Settings.ThresholdPercent);
+	FParse::Value(*Params, TEXT("mindelta="), Settings.MinDeltaMs);
+	FParse::Value(*Params, TEXT("minexecutions="), Settings.MinExecutions);
+	if (Settings.ThresholdPercent < 0.0f || Settings.MinDeltaMs < 0.0f)
+	{
+		UE_LOG(LogTemp, Error, TEXT("-maxregression and -mindelta must not be negative"));
+		return 2;
+	}
+
+	FString OutputPath = FPaths::ProjectSavedDir() / TEXT("BlueprintProfiler") / TEXT("SessionComparison.json");
+	FParse::Value(*Params, TEXT("output="), OutputPath);
+
+	FSessionProfile Baseline;
+	FSessionProfile Current;
+	if (!FSessionComparison::LoadProfile(FPaths::ConvertRelativePathToFull(BaselinePath), Baseline)
+		|| !FSessionComparison::LoadProfile(FPaths::ConvertRelativePathToFull(CurrentPath), Current))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to read session files %s and %s"), *BaselinePath, *CurrentPath);
+		return 2;
+	}
+
+	const FSessionComparison Comparison = FSessionComparison::Compare(Baseline, Current, Settings);
+	if (!Comparison.bPerFrame)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Frame count unknown for one of the sessions; comparing cost per second instead of per frame"));
+	}
+
+	const bool bReportWritten = Comparison.WriteReport(OutputPath);
+
+	const TCHAR* Unit = Comparison.bPerFrame ? TEXT("ms/frame") : TEXT("ms/s");
+	const TArray<const FSessionCostDiff*> Regressions = Comparison.FindBlueprintRegressions(TrackedBlueprints, Settings.ThresholdPercent);
+	for (const FSessionCostDiff* Regression : Regressions)
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s regressed by %.1f%%: %.3f -> %.3f %s"), *Regression->BlueprintName,
+			Regression->DeltaPercent, Regression->BaselineMs, Regression->CurrentMs, Unit);
+	}
+
+	// 基线中不存在的被跟踪蓝图无法给出百分比，只提示
+	for (const FSessionCostDiff& Diff : Comparison.Blueprints)
+	{
+		if (Diff.Change == ESessionCostChange::Added && Diff.bSignificant && TrackedBlueprints.ContainsByPredicate(
+			[&Diff](const FString& Name) { return Name.Equals(Diff.BlueprintName, ESearchCase::IgnoreCase); }))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("%s did not run in the baseline: %.3f %s"), *Diff.BlueprintName, Diff.CurrentMs, Unit);
+		}
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("Compared %d blueprints (%d nodes): %d regressed beyond %.1f%%, report %s"),
+		Comparison.Blueprints.Num(), Comparison.Nodes.Num(), Regressions.Num(), Settings.ThresholdPercent, *OutputPath);
+
+	if (!bReportWritten)
+	{
+		return 2;
+	}
+	return Regressions.Num() > 0 ? 1 : 0;
+}
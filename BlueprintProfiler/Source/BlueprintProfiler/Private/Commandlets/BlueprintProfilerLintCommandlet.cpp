@@ -0,0 +1,230 @@
+// Copyright xnbmy 2026. All Rights Reserved.
+
+#include "Commandlets/BlueprintProfilerLintCommandlet.h"
+#include "Analyzers/LintReportWriter.h"
+#include "Analyzers/MemoryAnalyzer.h"
+#include "Analyzers/StaticLinter.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Containers/Ticker.h"
+#include "Engine/Blueprint.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+	TArray<FString> ParseList(const FString& Value)
+	{
+		TArray<FString> Result;
+		Value.Replace(TEXT("+"), TEXT(",")).ParseIntoArray(Result, TEXT(","), true);
+		for (FString& Item : Result)
+		{
+			Item.TrimStartAndEndInline();
+		}
+		return Result;
+	}
+
+	bool ParseSeverity(const FString& Name, ESeverity& OutSeverity)
+	{
+		const int64 Value = StaticEnum<ESeverity>()->GetValueByNameString(Name);
+		if (Value == INDEX_NONE)
+		{
+			return false;
+		}
+		OutSeverity = static_cast<ESeverity>(Value);
+		return true;
+	}
+}
+
+UBlueprintProfilerLintCommandlet::UBlueprintProfilerLintCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UBlueprintProfilerLintCommandlet::Main(const FString& Params)
+{
+	FScanConfiguration Config;
+
+	// -paths=
+	TArray<FString> ScanPaths;
+	FString Value;
+	if (FParse::Value(*Params, TEXT("paths="), Value, false))
+	{
+		ScanPaths = ParseList(Value);
+	}
+	if (ScanPaths.Num() == 0)
+	{
+		ScanPaths.Add(TEXT("/Game"));
+	}
+
+	// -checks=
+	if (FParse::Value(*Params, TEXT("checks="), Value, false))
+	{
+		Config.EnabledChecks.Empty();
+		for (const FString& CheckName : ParseList(Value))
+		{
+			const int64 Check = StaticEnum<ELintIssueType>()->GetValueByNameString(CheckName);
+			if (Check == INDEX_NONE)
+			{
+				UE_LOG(LogTemp, Error, TEXT("Unknown lint check: %s"), *CheckName);
+				return 2;
+			}
+			Config.EnabledChecks.Add(static_cast<ELintIssueType>(Check));
+		}
+	}
+
+	// -jobs=
+	int32 Jobs = 0;
+	if (FParse::Value(*Params, TEXT("jobs="), Jobs))
+	{
+		Config.MaxConcurrentTasks = FMath::Max(Jobs, 1);
+		Config.bUseMultiThreading = Jobs > 1;
+	}
+
+	// -cache=
+	if (FParse::Value(*Params, TEXT("cache="), Value))
+	{
+		if (Value == TEXT("0") || Value.Equals(TEXT("false"), ESearchCase::IgnoreCase))
+		{
+			Config.bUseCache = false;
+		}
+		else
+		{
+			Config.CacheFilePath = FPaths::ConvertRelativePathToFull(Value);
+		}
+	}
+
+	FString OutputPath = FPaths::ProjectSavedDir() / TEXT("BlueprintProfiler") / TEXT("LintReport.sarif");
+	FParse::Value(*Params, TEXT("output="), OutputPath);
+	FString FormatName;
+	FParse::Value(*Params, TEXT("format="), FormatName);
+
+	ESeverity FailOnSeverity = ESeverity::High;
+	if (FParse::Value(*Params, TEXT("failon="), Value) && !ParseSeverity(Value, FailOnSeverity))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Unknown severity for -failon: %s"), *Value);
+		return 2;
+	}
+
+	const bool bAnalyzeMemory = FParse::Param(*Params, TEXT("memory"));
+	float MemoryThresholdMB = 10.0f;
+	FParse::Value(*Params, TEXT("memorythreshold="), MemoryThresholdMB);
+
+	FLintReportWriter ReportWriter;
+	if (!ReportWriter.Open(OutputPath, FLintReportWriter::ParseFormat(FormatName, OutputPath)))
+	{
+		return 2;
+	}
+
+	// 命令行下资产注册表不会在后台完成扫描
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	int32 NumFailures = 0;
+	auto CountFailures = [&NumFailures, FailOnSeverity](ESeverity Severity)
+	{
+		if (static_cast<uint8>(Severity) >= static_cast<uint8>(FailOnSeverity))
+		{
+			++NumFailures;
+		}
+	};
+
+	int32 NumIssues = 0;
+	bool bScanCompleted = false;
+	{
+		FStaticLinter Linter;
+		// 每个蓝图完成后立即写入报告，进程中途被杀也保留已完成的部分
+		Linter.OnIssuesBatch.AddLambda([&](TConstArrayView<FLintIssue> Issues)
+		{
+			ReportWriter.WriteIssues(Issues);
+			for (const FLintIssue& Issue : Issues)
+			{
+				CountFailures(Issue.Severity);
+			}
+		});
+		Linter.OnScanComplete.AddLambda([&](const TArray<FLintIssue>& Issues)
+		{
+			NumIssues = Issues.Num();
+			bScanCompleted = true;
+		});
+
+		const double StartTime = FPlatformTime::Seconds();
+		Linter.ScanSelectedFolders(ScanPaths, Config);
+
+		// 没有编辑器主循环，由命令行自己推进快照阶段的 ticker 和回到游戏线程的完成回调
+		double LastTickTime = FPlatformTime::Seconds();
+		while (!bScanCompleted && !IsEngineExitRequested())
+		{
+			const double Now = FPlatformTime::Seconds();
+			FTSTicker::GetCoreTicker().Tick(static_cast<float>(Now - LastTickTime));
+			FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+			LastTickTime = Now;
+
+			if (!bScanCompleted && !Linter.IsScanInProgress())
+			{
+				break;
+			}
+			FPlatformProcess::Sleep(0.001f);
+		}
+
+		UE_LOG(LogTemp, Display, TEXT("Lint scan finished in %.1fs: %d issues"), FPlatformTime::Seconds() - StartTime, NumIssues);
+	}
+
+	if (bAnalyzeMemory)
+	{
+		FARFilter Filter;
+		Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+		Filter.bRecursiveClasses = true;
+		Filter.bRecursivePaths = true;
+		for (const FString& ScanPath : ScanPaths)
+		{
+			Filter.PackagePaths.Add(FName(*ScanPath));
+		}
+
+		Filter.bIncludeOnlyOnDiskAssets = true;
+
+		TArray<FAssetData> BlueprintAssets;
+		AssetRegistry.GetAssets(Filter, BlueprintAssets);
+
+		// 与内存审计相同，只读注册表：大资源按硬引用闭包和磁盘大小判断，一个蓝图也不加载
+		TSharedRef<FAssetDependencyGraph> Graph = MakeShared<FAssetDependencyGraph>();
+		Graph->Build(AssetRegistry);
+		FAssetDominatorTree DominatorTree;
+		DominatorTree.Build(Graph, FMemoryAnalyzer::GatherPackageSizes(*Graph));
+
+		TArray<int32> BlueprintPackages;
+		BlueprintPackages.Reserve(BlueprintAssets.Num());
+		for (const FAssetData& AssetData : BlueprintAssets)
+		{
+			const int32 PackageIndex = Graph->FindPackage(AssetData.PackageName);
+			if (PackageIndex != INDEX_NONE)
+			{
+				BlueprintPackages.AddUnique(PackageIndex);
+			}
+		}
+
+		int32 NumAlerts = 0;
+		const TArray<FBlueprintMemoryAuditEntry> AuditEntries = FMemoryAnalyzer::ComputeMemoryAudit(DominatorTree, BlueprintPackages,
+			FLargeResourceRules::Gather(), MemoryThresholdMB);
+		for (const FBlueprintMemoryAuditEntry& Entry : AuditEntries)
+		{
+			for (const FLargeResourceReference& Resource : Entry.LargeReferences)
+			{
+				ReportWriter.WriteLargeResource(Entry.BlueprintPath, Resource);
+				CountFailures(FLintReportWriter::GetLargeResourceSeverity(Resource));
+				++NumAlerts;
+			}
+		}
+
+		UE_LOG(LogTemp, Display, TEXT("Memory scan of %d blueprints: %d large resource references"), BlueprintPackages.Num(), NumAlerts);
+	}
+
+	ReportWriter.Close();
+	UE_LOG(LogTemp, Display, TEXT("Wrote %s (%d findings, %d at or above %s)"), *OutputPath, ReportWriter.GetNumEntries(),
+		NumFailures, *StaticEnum<ESeverity>()->GetNameStringByValue(static_cast<int64>(FailOnSeverity)));
+
+	return NumFailures > 0 ? 1 : 0;
+}
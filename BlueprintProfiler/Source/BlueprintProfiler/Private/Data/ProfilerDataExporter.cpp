@@ -0,0 +1,293 @@
+// Copyright xnbmy 2026. All Rights Reserved.
+
+#include "Data/ProfilerDataExporter.h"
+#include "Analyzers/BlueprintProfilerStats.h"
+#include "HAL/FileManager.h"
+#include "Misc/Compression.h"
+#include "Misc/Paths.h"
+
+DECLARE_CYCLE_STAT(TEXT("Export Rows"), STAT_ExportRows, STATGROUP_BlueprintProfiler);
+
+namespace BlueprintProfilerExport
+{
+	static void AppendCsvField(FString& Out, const FString& Field)
+	{
+		// RFC 4180：含分隔符、引号或换行的字段加引号，引号写两次
+		int32 Index;
+		if (!Field.FindChar(TEXT(','), Index) && !Field.FindChar(TEXT('"'), Index)
+			&& !Field.FindChar(TEXT('\n'), Index) && !Field.FindChar(TEXT('\r'), Index))
+		{
+			Out += Field;
+			return;
+		}
+
+		Out += TEXT('"');
+		for (const TCHAR Char : Field)
+		{
+			if (Char == TEXT('"'))
+			{
+				Out += TEXT('"');
+			}
+			Out += Char;
+		}
+		Out += TEXT('"');
+	}
+
+	static void AppendJsonString(FString& Out, const FString& Value)
+	{
+		Out += TEXT('"');
+		for (const TCHAR Char : Value)
+		{
+			switch (Char)
+			{
+			case TEXT('"'): Out += TEXT("\\\""); break;
+			case TEXT('\\'): Out += TEXT("\\\\"); break;
+			case TEXT('\n'): Out += TEXT("\\n"); break;
+			case TEXT('\r'): Out += TEXT("\\r"); break;
+			case TEXT('\t'): Out += TEXT("\\t"); break;
+			default:
+				if (Char < 0x20)
+				{
+					Out.Appendf(TEXT("\\u%04x"), static_cast<uint32>(Char));
+				}
+				else
+				{
+					Out += Char;
+				}
+				break;
+			}
+		}
+		Out += TEXT('"');
+	}
+
+	static void AppendCsvRow(FString& Out, const FProfilerExportSnapshot& Snapshot, const FProfilerExportRow& Row)
+	{
+		AppendCsvField(Out, Snapshot.TypeNames[static_cast<int32>(Row.Type)]);
+		Out += TEXT(',');
+		AppendCsvField(Out, Row.Name);
+		Out += TEXT(',');
+		AppendCsvField(Out, Row.BlueprintName);
+		Out += TEXT(',');
+		AppendCsvField(Out, Row.Category);
+		Out.Appendf(TEXT(",%.2f,"), Row.Value);
+		AppendCsvField(Out, Snapshot.SeverityNames[static_cast<int32>(Row.Severity)]);
+		Out += TEXT('\n');
+	}
+
+	static void AppendJsonRow(FString& Out, const FProfilerExportSnapshot& Snapshot, const FProfilerExportRow& Row, bool bLast)
+	{
+		Out += TEXT("\t\t{ \"Type\": ");
+		AppendJsonString(Out, Snapshot.TypeNames[static_cast<int32>(Row.Type)]);
+		Out += TEXT(", \"Name\": ");
+		AppendJsonString(Out, Row.Name);
+		Out += TEXT(", \"Blueprint\": ");
+		AppendJsonString(Out, Row.BlueprintName);
+		Out += TEXT(", \"Category\": ");
+		AppendJsonString(Out, Row.Category);
+		Out += TEXT(", \"Value\": ");
+		Out += FString::SanitizeFloat(Row.Value);
+		Out += TEXT(", \"Severity\": ");
+		AppendJsonString(Out, Snapshot.SeverityNames[static_cast<int32>(Row.Severity)]);
+		Out += bLast ? TEXT(" }\n") : TEXT(" },\n");
+	}
+
+	/** Writes text as UTF-8, as one gzip member if compressed */
+	static bool WriteText(FArchive& Ar, const FString& Text, bool bCompress, TArray<uint8>& CompressBuffer)
+	{
+		FTCHARToUTF8 Utf8(*Text, Text.Len());
+		if (Utf8.Length() == 0)
+		{
+			return !Ar.IsError();
+		}
+
+		if (!bCompress)
+		{
+			Ar.Serialize(const_cast<ANSICHAR*>(Utf8.Get()), Utf8.Length());
+			return !Ar.IsError();
+		}
+
+		int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Gzip, Utf8.Length());
+		CompressBuffer.SetNumUninitialized(CompressedSize, EAllowShrinking::No);
+		if (!FCompression::CompressMemory(NAME_Gzip, CompressBuffer.GetData(), CompressedSize, Utf8.Get(), Utf8.Length()))
+		{
+			return false;
+		}
+		Ar.Serialize(CompressBuffer.GetData(), CompressedSize);
+		return !Ar.IsError();
+	}
+}
+
+FProfilerDataExporter::~FProfilerDataExporter()
+{
+	CancelAndWait();
+}
+
+bool FProfilerDataExporter::Start(const FString& FilePath, EProfilerExportFormat Format, bool bCompress, TSharedRef<const FProfilerExportSnapshot, ESPMode::ThreadSafe> Snapshot)
+{
+	check(IsInGameThread());
+
+	if (IsExporting())
+	{
+		return false;
+	}
+
+	bCancelRequested = false;
+	NumRowsWritten = 0;
+	bTaskSucceeded = false;
+	TaskFilePath = FilePath;
+	TaskNumRows = Snapshot->Rows.Num();
+	LastReportedRows = -1;
+
+	Task = UE::Tasks::Launch(TEXT("BlueprintProfilerExport"), [this, FilePath, Format, bCompress, Snapshot]()
+	{
+		bTaskSucceeded = WriteFile(FilePath, *Snapshot, Format, bCompress, &bCancelRequested, &NumRowsWritten);
+	}, UE::Tasks::ETaskPriority::BackgroundNormal);
+
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateRaw(this, &FProfilerDataExporter::TickTask));
+	return true;
+}
+
+void FProfilerDataExporter::Cancel()
+{
+	bCancelRequested = true;
+}
+
+void FProfilerDataExporter::CancelAndWait()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+
+	if (Task.IsValid())
+	{
+		bCancelRequested = true;
+		Task.Wait();
+		Task = UE::Tasks::FTask();
+	}
+}
+
+float FProfilerDataExporter::GetProgress() const
+{
+	return TaskNumRows > 0 ? static_cast<float>(GetNumRowsWritten()) / TaskNumRows : 1.0f;
+}
+
+bool FProfilerDataExporter::TickTask(float DeltaTime)
+{
+	const int32 NumRows = GetNumRowsWritten();
+	if (NumRows != LastReportedRows)
+	{
+		LastReportedRows = NumRows;
+		OnProgress.Broadcast(GetProgress());
+	}
+
+	if (!Task.IsCompleted())
+	{
+		return true;
+	}
+
+	Task = UE::Tasks::FTask();
+	TickerHandle.Reset();
+
+	const bool bCancelled = bCancelRequested.load();
+	OnComplete.Broadcast(bTaskSucceeded.load() && !bCancelled, bCancelled, NumRows, TaskFilePath);
+	return false;
+}
+
+bool FProfilerDataExporter::WriteRows(FArchive& Ar, const FProfilerExportSnapshot& Snapshot, EProfilerExportFormat Format, bool bCompress,
+	const std::atomic<bool>* bCancel, std::atomic<int32>* OutNumRowsWritten)
+{
+	using namespace BlueprintProfilerExport;
+	BLUEPRINTPROFILER_SCOPE_CYCLE_COUNTER(STAT_ExportRows);
+
+	const int32 NumRows = Snapshot.Rows.Num();
+	TArray<uint8> CompressBuffer;
+	FString Chunk;
+	Chunk.Reserve(RowsPerChunk * 128);
+
+	if (Format == EProfilerExportFormat::Csv)
+	{
+		// UTF-8 BOM，Excel 据此识别中文
+		Chunk += TCHAR(0xFEFF);
+		Chunk += TEXT("Type,Name,Blueprint,Category,Value,Severity\n");
+	}
+	else
+	{
+		Chunk += TEXT("{\n\t\"ExportDate\": ");
+		AppendJsonString(Chunk, Snapshot.ExportDate);
+		Chunk.Appendf(TEXT(",\n\t\"TotalItems\": %d,\n\t\"Items\": [\n"), NumRows);
+	}
+
+	for (int32 ChunkStart = 0; ChunkStart < NumRows; ChunkStart += RowsPerChunk)
+	{
+		if (bCancel && bCancel->load(std::memory_order_relaxed))
+		{
+			return false;
+		}
+
+		const int32 ChunkEnd = FMath::Min(ChunkStart + RowsPerChunk, NumRows);
+		for (int32 RowIndex = ChunkStart; RowIndex < ChunkEnd; ++RowIndex)
+		{
+			if (Format == EProfilerExportFormat::Csv)
+			{
+				AppendCsvRow(Chunk, Snapshot, Snapshot.Rows[RowIndex]);
+			}
+			else
+			{
+				AppendJsonRow(Chunk, Snapshot, Snapshot.Rows[RowIndex], RowIndex == NumRows - 1);
+			}
+		}
+
+		if (!WriteText(Ar, Chunk, bCompress, CompressBuffer))
+		{
+			return false;
+		}
+		Chunk.Reset();
+
+		if (OutNumRowsWritten)
+		{
+			OutNumRowsWritten->store(ChunkEnd, std::memory_order_relaxed);
+		}
+	}
+
+	if (Format == EProfilerExportFormat::Json)
+	{
+		Chunk += TEXT("\t]\n}\n");
+	}
+	return WriteText(Ar, Chunk, bCompress, CompressBuffer);
+}
+
+bool FProfilerDataExporter::WriteFile(const FString& FilePath, const FProfilerExportSnapshot& Snapshot, EProfilerExportFormat Format, bool bCompress,
+	const std::atomic<bool>* bCancel, std::atomic<int32>* OutNumRowsWritten)
+{
+	const FString TempPath = FilePath + TEXT(".tmp");
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*TempPath));
+	if (!Writer)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("BlueprintProfiler: Failed to open export file %s"), *TempPath);
+		return false;
+	}
+
+	bool bSuccess = WriteRows(*Writer, Snapshot, Format, bCompress, bCancel, OutNumRowsWritten);
+	bSuccess &= Writer->Close();
+	Writer.Reset();
+
+	if (bSuccess && IFileManager::Get().Move(*FilePath, *TempPath, true, true))
+	{
+		return true;
+	}
+
+	if (!bCancel || !bCancel->load())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("BlueprintProfiler: Failed to write export file %s"), *FilePath);
+	}
+	IFileManager::Get().Delete(*TempPath, false, true, true);
+	return false;
+}
+
+bool FProfilerDataExporter::IsCompressedPath(const FString& FilePath)
+{
+	return FilePath.EndsWith(TEXT(".gz"), ESearchCase::IgnoreCase);
+}
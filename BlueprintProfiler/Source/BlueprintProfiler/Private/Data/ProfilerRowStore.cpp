@@ -0,0 +1,499 @@
+// Copyright xnbmy 2026. All Rights Reserved.
+
+#include "Data/ProfilerRowStore.h"
+#include "Algo/Unique.h"
+
+//============================================================
+// FProfilerRowStore::FHashBuilder
+//============================================================
+
+FProfilerRowStore::FHashBuilder::FHashBuilder(EProfilerDataType Type)
+{
+	const uint8 TypeValue = static_cast<uint8>(Type);
+	AddBytes(&TypeValue, sizeof(TypeValue));
+}
+
+FProfilerRowStore::FHashBuilder& FProfilerRowStore::FHashBuilder::Add(const FString& Value)
+{
+	// 带上长度，使 ("ab","c") 与 ("a","bc") 的哈希不同
+	const int32 Length = Value.Len();
+	AddBytes(&Length, sizeof(Length));
+	return AddBytes(*Value, Length * sizeof(TCHAR));
+}
+
+FProfilerRowStore::FHashBuilder& FProfilerRowStore::FHashBuilder::Add(const FGuid& Value)
+{
+	return AddBytes(&Value, sizeof(Value));
+}
+
+FProfilerRowStore::FHashBuilder& FProfilerRowStore::FHashBuilder::AddBytes(const void* Data, uint64 Size)
+{
+	Builder.Update(Data, Size);
+	return *this;
+}
+
+//============================================================
+// FProfilerRowStore
+//============================================================
+
+void FProfilerRowStore::BeginUpdate(EProfilerDataType Type)
+{
+	const int32 TypeIndex = static_cast<int32>(Type);
+	TypeSerials[TypeIndex]++;
+	UpdateOpen[TypeIndex] = true;
+}
+
+void FProfilerRowStore::EndUpdate(EProfilerDataType Type)
+{
+	const int32 TypeIndex = static_cast<int32>(Type);
+	if (!UpdateOpen[TypeIndex])
+	{
+		return;
+	}
+	UpdateOpen[TypeIndex] = false;
+
+	// 本次更新中没有再出现的行已过期
+	for (TConstSetBitIterator<> It(LiveRows); It; ++It)
+	{
+		const int32 RowId = It.GetIndex();
+		if (Types[RowId] == Type && UpdateSerials[RowId] != TypeSerials[TypeIndex])
+		{
+			FreeRow(RowId);
+		}
+	}
+}
+
+int32 FProfilerRowStore::UpdateRow(EProfilerDataType Type, uint64 RowKey, uint64 ContentHash, TFunctionRef<FItemPtr()> MakeItem)
+{
+	const int32 TypeIndex = static_cast<int32>(Type);
+	const bool bInUpdate = UpdateOpen[TypeIndex];
+
+	// 同一次更新中重复的键（或属于其他类型的键）派生出确定的新键，下次更新时重复项仍落在各自的行上
+	uint64 Key = RowKey;
+	const int32* ExistingRow = KeyToRow.Find(Key);
+	while (ExistingRow && (Types[*ExistingRow] != Type || (bInUpdate && UpdateSerials[*ExistingRow] == TypeSerials[TypeIndex])))
+	{
+		Key = Key * 0x9E3779B97F4A7C15ull + 1;
+		ExistingRow = KeyToRow.Find(Key);
+	}
+
+	int32 RowId = ExistingRow ? *ExistingRow : INDEX_NONE;
+	if (RowId != INDEX_NONE)
+	{
+		UpdateSerials[RowId] = TypeSerials[TypeIndex];
+		if (ContentHashes[RowId] == ContentHash && Items[RowId].IsValid())
+		{
+			// 内容未变：保留原来的列表项，列表视图也会保留它的行控件
+			return RowId;
+		}
+	}
+
+	FItemPtr Item = MakeItem();
+	if (!Item.IsValid())
+	{
+		if (RowId != INDEX_NONE)
+		{
+			FreeRow(RowId);
+		}
+		return INDEX_NONE;
+	}
+
+	if (RowId == INDEX_NONE)
+	{
+		RowId = AllocateRow(Key);
+		UpdateSerials[RowId] = TypeSerials[TypeIndex];
+	}
+	SetRowItem(RowId, Type, ContentHash, Item);
+	return RowId;
+}
+
+int32 FProfilerRowStore::UpdateRow(uint64 RowKey, const FItemPtr& Item)
+{
+	if (!Item.IsValid())
+	{
+		return INDEX_NONE;
+	}
+
+	const uint64 ContentHash = FHashBuilder(Item->Type)
+		.Add(Item->Name)
+		.Add(Item->BlueprintName)
+		.Add(Item->Category)
+		.Add(Item->Description)
+		.Add(Item->Value)
+		.Add(static_cast<int32>(Item->Severity))
+		.Finish();
+
+	return UpdateRow(Item->Type, RowKey, ContentHash, [&Item]() { return Item; });
+}
+
+void FProfilerRowStore::RemoveRows(EProfilerDataType Type)
+{
+	for (TConstSetBitIterator<> It(LiveRows); It; ++It)
+	{
+		if (Types[It.GetIndex()] == Type)
+		{
+			FreeRow(It.GetIndex());
+		}
+	}
+}
+
+void FProfilerRowStore::Empty()
+{
+	Items.Empty();
+	RowKeys.Empty();
+	ContentHashes.Empty();
+	UpdateSerials.Empty();
+	Types.Empty();
+	Severities.Empty();
+	Values.Empty();
+	Flags.Empty();
+	NameKeys.Empty();
+	BlueprintKeys.Empty();
+	CategoryKeys.Empty();
+	SearchTexts.Empty();
+	LiveRows.Empty();
+	FreeRows.Empty();
+	KeyToRow.Empty();
+	NumRows = 0;
+
+	VisibleRows.Empty();
+	ChangedRows.Empty();
+	RemovedRows.Empty();
+	bRemovedAny = false;
+	bRebuildView = true;
+}
+
+int32 FProfilerRowStore::FindRow(uint64 RowKey) const
+{
+	const int32* RowId = KeyToRow.Find(RowKey);
+	return RowId ? *RowId : INDEX_NONE;
+}
+
+int32 FProfilerRowStore::AllocateRow(uint64 RowKey)
+{
+	int32 RowId;
+	if (FreeRows.Num() > 0)
+	{
+		RowId = FreeRows.Pop(EAllowShrinking::No);
+	}
+	else
+	{
+		RowId = Items.AddDefaulted();
+		RowKeys.AddZeroed();
+		ContentHashes.AddZeroed();
+		UpdateSerials.AddZeroed();
+		Types.Add(EProfilerDataType::Runtime);
+		Severities.Add(ESeverity::Low);
+		Values.AddZeroed();
+		Flags.AddZeroed();
+		NameKeys.AddDefaulted();
+		BlueprintKeys.AddDefaulted();
+		CategoryKeys.AddDefaulted();
+		SearchTexts.AddDefaulted();
+		LiveRows.Add(false);
+		RemovedRows.Add(false);
+	}
+
+	RowKeys[RowId] = RowKey;
+	KeyToRow.Add(RowKey, RowId);
+	LiveRows[RowId] = true;
+	NumRows++;
+	return RowId;
+}
+
+void FProfilerRowStore::SetRowItem(int32 RowId, EProfilerDataType Type, uint64 ContentHash, const FItemPtr& Item)
+{
+	Items[RowId] = Item;
+	ContentHashes[RowId] = ContentHash;
+	Types[RowId] = Type;
+	Severities[RowId] = Item->Severity;
+	Values[RowId] = Item->Value;
+
+	uint8 RowFlags = 0;
+	if (Item->Category.Contains(TEXT("Hot")) || Item->Category.Contains(TEXT("高频执行")))
+	{
+		RowFlags |= RowFlag_Hotspot;
+	}
+	if (Item->Category.Contains(TEXT("Dead")) || Item->Category.Contains(TEXT("孤立节点")))
+	{
+		RowFlags |= RowFlag_DeadCode;
+	}
+	if (Item->Category.Contains(TEXT("Cast")) || Item->Category.Contains(TEXT("Tick")))
+	{
+		RowFlags |= RowFlag_Performance;
+	}
+	Flags[RowId] = RowFlags;
+
+	// 排序键与搜索文本预先转成小写，比较时不再做大小写折叠
+	NameKeys[RowId] = Item->Name.ToLower();
+	BlueprintKeys[RowId] = Item->BlueprintName.ToLower();
+	CategoryKeys[RowId] = Item->Category.ToLower();
+	SearchTexts[RowId] = GetSearchText
+		? GetSearchText(Item).ToLower()
+		: FString::Join(TArray<FString>{ NameKeys[RowId], BlueprintKeys[RowId], CategoryKeys[RowId] }, TEXT("\n"));
+
+	// 旧的列表项不再可见，新的作为变更行合并进去
+	RemovedRows[RowId] = true;
+	bRemovedAny = true;
+	ChangedRows.Add(RowId);
+}
+
+void FProfilerRowStore::FreeRow(int32 RowId)
+{
+	KeyToRow.Remove(RowKeys[RowId]);
+	Items[RowId].Reset();
+	NameKeys[RowId].Empty();
+	BlueprintKeys[RowId].Empty();
+	CategoryKeys[RowId].Empty();
+	SearchTexts[RowId].Empty();
+	LiveRows[RowId] = false;
+	FreeRows.Add(RowId);
+	NumRows--;
+
+	RemovedRows[RowId] = true;
+	bRemovedAny = true;
+}
+
+void FProfilerRowStore::SetView(EProfilerRowFilter InFilter, EProfilerRowSort InSort, const FString& InSearchText)
+{
+	TArray<FString> NewTerms;
+	InSearchText.ToLower().ParseIntoArray(NewTerms, TEXT(" "), true);
+
+	if (InFilter != Filter || InSort != Sort)
+	{
+		bRebuildView = true;
+	}
+	else if (NewTerms != SearchTerms)
+	{
+		// 每个旧词都包含在某个新词中时，新结果是当前结果的子集，只需过滤可见行
+		bool bNarrows = true;
+		for (const FString& OldTerm : SearchTerms)
+		{
+			if (!NewTerms.ContainsByPredicate([&OldTerm](const FString& NewTerm) { return NewTerm.Contains(OldTerm, ESearchCase::CaseSensitive); }))
+			{
+				bNarrows = false;
+				break;
+			}
+		}
+
+		if (bNarrows)
+		{
+			bNarrowSearch = true;
+		}
+		else
+		{
+			bRebuildView = true;
+		}
+	}
+
+	Filter = InFilter;
+	Sort = InSort;
+	SearchTerms = MoveTemp(NewTerms);
+}
+
+bool FProfilerRowStore::UpdateView(TArray<FItemPtr>& OutVisibleItems)
+{
+	bool bViewChanged = false;
+
+	if (bRebuildView)
+	{
+		RebuildVisibleRows();
+		bViewChanged = true;
+	}
+	else
+	{
+		if (bNarrowSearch)
+		{
+			bViewChanged |= VisibleRows.RemoveAll([this](int32 RowId) { return !MatchesSearch(RowId); }) > 0;
+			bNarrowSearch = false;
+		}
+
+		if (bRemovedAny || ChangedRows.Num() > 0)
+		{
+			const int32 NumVisibleBefore = VisibleRows.Num();
+			const int32 NumChanged = ChangedRows.Num();
+			MergeChangedRows();
+			bViewChanged |= NumChanged > 0 || VisibleRows.Num() != NumVisibleBefore;
+		}
+	}
+
+	if (!bViewChanged && OutVisibleItems.Num() == VisibleRows.Num())
+	{
+		return false;
+	}
+
+	OutVisibleItems.Reset(VisibleRows.Num());
+	for (int32 RowId : VisibleRows)
+	{
+		OutVisibleItems.Add(Items[RowId]);
+	}
+	return true;
+}
+
+bool FProfilerRowStore::IsRowVisible(int32 RowId) const
+{
+	return LiveRows.IsValidIndex(RowId) && LiveRows[RowId] && MatchesFilter(RowId) && MatchesSearch(RowId);
+}
+
+bool FProfilerRowStore::MatchesFilter(int32 RowId) const
+{
+	switch (Filter)
+	{
+		case EProfilerRowFilter::Runtime: return Types[RowId] == EProfilerDataType::Runtime;
+		case EProfilerRowFilter::Lint: return Types[RowId] == EProfilerDataType::Lint;
+		case EProfilerRowFilter::Memory: return Types[RowId] == EProfilerDataType::Memory;
+		case EProfilerRowFilter::Critical: return Severities[RowId] == ESeverity::Critical;
+		case EProfilerRowFilter::High: return Severities[RowId] == ESeverity::High;
+		case EProfilerRowFilter::Medium: return Severities[RowId] == ESeverity::Medium;
+		case EProfilerRowFilter::Low: return Severities[RowId] == ESeverity::Low;
+		case EProfilerRowFilter::Hotspots: return (Flags[RowId] & RowFlag_Hotspot) != 0;
+		case EProfilerRowFilter::DeadCode: return (Flags[RowId] & RowFlag_DeadCode) != 0;
+		case EProfilerRowFilter::Performance: return (Flags[RowId] & RowFlag_Performance) != 0;
+		default: return true;
+	}
+}
+
+bool FProfilerRowStore::MatchesSearch(int32 RowId) const
+{
+	// 所有词都必须出现
+	for (const FString& Term : SearchTerms)
+	{
+		if (!SearchTexts[RowId].Contains(Term, ESearchCase::CaseSensitive))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool FProfilerRowStore::IsOrderedBefore(int32 A, int32 B) const
+{
+	auto CompareKeys = [](const FString& KeyA, const FString& KeyB)
+	{
+		return KeyA.Compare(KeyB, ESearchCase::CaseSensitive);
+	};
+
+	int32 Order = 0;
+	switch (Sort)
+	{
+		case EProfilerRowSort::Name:
+			Order = CompareKeys(NameKeys[A], NameKeys[B]);
+			break;
+
+		case EProfilerRowSort::Blueprint:
+			Order = CompareKeys(BlueprintKeys[A], BlueprintKeys[B]);
+			if (Order == 0)
+			{
+				Order = CompareKeys(NameKeys[A], NameKeys[B]);
+			}
+			break;
+
+		case EProfilerRowSort::Type:
+			Order = static_cast<int32>(Types[A]) - static_cast<int32>(Types[B]);
+			if (Order == 0)
+			{
+				Order = static_cast<int32>(Severities[B]) - static_cast<int32>(Severities[A]);
+			}
+			break;
+
+		case EProfilerRowSort::Category:
+			Order = CompareKeys(CategoryKeys[A], CategoryKeys[B]);
+			if (Order == 0)
+			{
+				Order = static_cast<int32>(Severities[B]) - static_cast<int32>(Severities[A]);
+			}
+			break;
+
+		case EProfilerRowSort::Severity:
+			Order = static_cast<int32>(Severities[B]) - static_cast<int32>(Severities[A]);
+			if (Order == 0 && Values[A] != Values[B])
+			{
+				Order = Values[A] > Values[B] ? -1 : 1;
+			}
+			break;
+
+		case EProfilerRowSort::Value:
+			if (Values[A] != Values[B])
+			{
+				Order = Values[A] > Values[B] ? -1 : 1;
+			}
+			else
+			{
+				Order = static_cast<int32>(Severities[B]) - static_cast<int32>(Severities[A]);
+			}
+			break;
+
+		case EProfilerRowSort::Execution:
+		case EProfilerRowSort::Memory:
+		{
+			// 指定类型的行排在前面，再按值降序
+			const EProfilerDataType PreferredType = Sort == EProfilerRowSort::Execution ? EProfilerDataType::Runtime : EProfilerDataType::Memory;
+			const bool bPreferredA = Types[A] == PreferredType;
+			const bool bPreferredB = Types[B] == PreferredType;
+			if (bPreferredA != bPreferredB)
+			{
+				Order = bPreferredA ? -1 : 1;
+			}
+			else if (Values[A] != Values[B])
+			{
+				Order = Values[A] > Values[B] ? -1 : 1;
+			}
+			break;
+		}
+	}
+
+	// 行 ID 作为最后的比较键，保证顺序稳定
+	return Order != 0 ? Order < 0 : A < B;
+}
+
+void FProfilerRowStore::RebuildVisibleRows()
+{
+	VisibleRows.Reset();
+	for (TConstSetBitIterator<> It(LiveRows); It; ++It)
+	{
+		if (MatchesFilter(It.GetIndex()) && MatchesSearch(It.GetIndex()))
+		{
+			VisibleRows.Add(It.GetIndex());
+		}
+	}
+	VisibleRows.Sort([this](int32 A, int32 B) { return IsOrderedBefore(A, B); });
+
+	ChangedRows.Reset();
+	RemovedRows.SetRange(0, RemovedRows.Num(), false);
+	bRemovedAny = false;
+	bRebuildView = false;
+	bNarrowSearch = false;
+}
+
+void FProfilerRowStore::MergeChangedRows()
+{
+	if (bRemovedAny)
+	{
+		VisibleRows.RemoveAll([this](int32 RowId) { return RemovedRows[RowId]; });
+		RemovedRows.SetRange(0, RemovedRows.Num(), false);
+		bRemovedAny = false;
+	}
+
+	// 变更行排序后与可见行做一次归并，代价与可见行数成线性而不是重新排序
+	ChangedRows.Sort();
+	ChangedRows.SetNum(Algo::Unique(ChangedRows));
+	ChangedRows.RemoveAll([this](int32 RowId) { return !IsRowVisible(RowId); });
+	ChangedRows.Sort([this](int32 A, int32 B) { return IsOrderedBefore(A, B); });
+
+	if (ChangedRows.Num() > 0)
+	{
+		TArray<int32> MergedRows;
+		MergedRows.Reserve(VisibleRows.Num() + ChangedRows.Num());
+
+		int32 VisibleIndex = 0;
+		int32 ChangedIndex = 0;
+		while (VisibleIndex < VisibleRows.Num() || ChangedIndex < ChangedRows.Num())
+		{
+			const bool bTakeChanged = VisibleIndex >= VisibleRows.Num() ||
+				(ChangedIndex < ChangedRows.Num() && IsOrderedBefore(ChangedRows[ChangedIndex], VisibleRows[VisibleIndex]));
+			MergedRows.Add(bTakeChanged ? ChangedRows[ChangedIndex++] : VisibleRows[VisibleIndex++]);
+		}
+		VisibleRows = MoveTemp(MergedRows);
+	}
+	ChangedRows.Reset();
+}
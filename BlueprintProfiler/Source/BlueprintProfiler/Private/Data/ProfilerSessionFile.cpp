@@ -0,0 +1,697 @@
+// Copyright xnbmy 2026. All Rights Reserved.
+
+#include "Data/ProfilerSessionFile.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Async/MappedFileHandle.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+#include "Algo/BinarySearch.h"
+
+namespace BlueprintProfilerSessionFile
+{
+	// Magic + Version + reserved flags
+	constexpr int64 HeaderSize = 3 * sizeof(uint32);
+	constexpr int64 ChunkHeaderSize = 2 * sizeof(uint32);
+
+	// Timestamp + NodeId + ExecutionTime + FrameNumber, must match SerializeFrame
+	constexpr int64 SerializedFrameSize = sizeof(double) + sizeof(uint32) + sizeof(float) + sizeof(uint64);
+
+	// NodeId + name indices + NodeGuid; the statistics that follow only make a node record larger
+	constexpr int64 MinSerializedNodeSize = sizeof(uint32) + 2 * sizeof(int32) + sizeof(FGuid);
+
+	// Length prefix of an FString; the characters only make a string record larger
+	constexpr int64 MinSerializedStringSize = sizeof(int32);
+
+	// Timestamp + frame range + CaptureTimeMs + class count, must match SerializeMemorySnapshot
+	constexpr int64 MinSerializedMemorySnapshotSize = sizeof(double) + 2 * sizeof(uint64) + sizeof(float) + sizeof(int32);
+
+	static int64 GetFramePagePayloadSize(int32 NumFrames)
+	{
+		return sizeof(int32) + NumFrames * SerializedFrameSize;
+	}
+
+	static int64 GetSerializedFrameSize(uint32 FileVersion)
+	{
+		return FileVersion >= 2 ? SerializedFrameSize : SerializedFrameSize - sizeof(uint64);
+	}
+
+	/** Rejects counts read from a damaged file before anything is reserved for them */
+	static bool IsValidRecordCount(FArchive& Ar, int32 Count, int64 MinRecordSize)
+	{
+		return Count >= 0 && Count <= (Ar.TotalSize() - Ar.Tell()) / MinRecordSize;
+	}
+
+	bool IsSessionFile(const FString& FilePath)
+	{
+		return FPaths::GetExtension(FilePath, true).Equals(GetExtension(), ESearchCase::IgnoreCase);
+	}
+
+	/** On-disk frame record; node references are the recording's dense IDs */
+	static void SerializeFrame(FArchive& Ar, FExecutionFrame& Frame, uint32 FileVersion = Version)
+	{
+		Ar << Frame.Timestamp;
+		Ar << Frame.NodeId;
+		Ar << Frame.ExecutionTime;
+		if (FileVersion >= 2)
+		{
+			Ar << Frame.FrameNumber;
+		}
+	}
+
+	/** On-disk node record; names are indices into the STRS chunk */
+	static void SerializeNode(FArchive& Ar, FNodeExecutionData& Data, uint32& NodeId, int32& NodeNameIndex, int32& BlueprintNameIndex)
+	{
+		Ar << NodeId;
+		Ar << NodeNameIndex;
+		Ar << BlueprintNameIndex;
+		Ar << Data.NodeGuid;
+		Ar << Data.TotalExecutions;
+		Ar << Data.AverageExecutionsPerSecond;
+		Ar << Data.TotalExecutionTime;
+		Ar << Data.AverageExecutionTime;
+		Ar << Data.TotalExclusiveTime;
+		Ar << Data.AverageExclusiveTime;
+		Ar << Data.P50ExecutionTime;
+		Ar << Data.P95ExecutionTime;
+		Ar << Data.P99ExecutionTime;
+		Ar << Data.SamplingRate;
+		Ar << Data.SampledExecutions;
+		Ar << Data.ExecutionsLowerBound;
+		Ar << Data.ExecutionsUpperBound;
+	}
+
+	static void SerializeMemorySnapshot(FArchive& Ar, FBlueprintMemorySnapshot& Snapshot)
+	{
+		Ar << Snapshot.Timestamp;
+		Ar << Snapshot.FirstFrameNumber;
+		Ar << Snapshot.LastFrameNumber;
+		Ar << Snapshot.CaptureTimeMs;
+
+		int32 ClassCount = Snapshot.Classes.Num();
+		Ar << ClassCount;
+		if (Ar.IsLoading())
+		{
+			// 每个类条目至少占用数个字节，据此拒绝损坏的计数
+			if (ClassCount < 0 || ClassCount > Ar.TotalSize() - Ar.Tell())
+			{
+				Ar.SetError();
+				return;
+			}
+			Snapshot.Classes.SetNum(ClassCount);
+		}
+
+		for (FBlueprintClassMemory& Class : Snapshot.Classes)
+		{
+			Ar << Class.BlueprintName;
+			Ar << Class.ClassPath;
+			Ar << Class.InstanceCount;
+			Ar << Class.InstanceBytes;
+			if (Ar.IsError())
+			{
+				return;
+			}
+		}
+	}
+
+	static void SerializeSession(FArchive& Ar, FRecordingSession& Session, uint32 FileVersion = Version)
+	{
+		int64 StartTicks = Session.StartTime.GetTicks();
+		int64 EndTicks = Session.EndTime.GetTicks();
+		uint8 SamplingMode = static_cast<uint8>(Session.SamplingMode);
+
+		Ar << Session.SessionName;
+		Ar << StartTicks;
+		Ar << EndTicks;
+		Ar << Session.Duration;
+		Ar << Session.TotalNodesRecorded;
+		Ar << Session.TotalExecutions;
+		Ar << Session.bAutoStarted;
+		Ar << SamplingMode;
+		Ar << Session.SamplingRate;
+		if (FileVersion >= 3)
+		{
+			Ar << Session.TotalFrames;
+		}
+
+		if (Ar.IsLoading())
+		{
+			Session.StartTime = FDateTime(StartTicks);
+			Session.EndTime = FDateTime(EndTicks);
+			Session.SamplingMode = static_cast<ESamplingMode>(SamplingMode);
+			Session.bIsActive = false;
+		}
+	}
+}
+
+//============================================================
+// FProfilerSessionWriter
+//============================================================
+
+FProfilerSessionWriter::FProfilerSessionWriter()
+	: WritePipe(TEXT("BlueprintProfilerSessionWriter"))
+{
+}
+
+FProfilerSessionWriter::~FProfilerSessionWriter()
+{
+	Close();
+}
+
+bool FProfilerSessionWriter::Open(const FString& InFilePath)
+{
+	Close();
+
+	// 允许共享读取：录制期间可以从同一个文件把已写入的页读回来
+	FileWriter.Reset(IFileManager::Get().CreateFileWriter(*InFilePath, FILEWRITE_AllowRead));
+	if (!FileWriter.IsValid())
+	{
+		UE_LOG(LogTemp, Error, TEXT("[PROFILER] Failed to open session file for writing: %s"), *InFilePath);
+		return false;
+	}
+
+	FilePath = InFilePath;
+	FramesWritten = 0;
+	FramePageOffsets.Reset();
+	FramePageCounts.Reset();
+	PagesOnDisk = 0;
+	bWriteError = false;
+
+	uint32 Magic = BlueprintProfilerSessionFile::Magic;
+	uint32 Version = BlueprintProfilerSessionFile::Version;
+	uint32 Flags = 0;
+	*FileWriter << Magic;
+	*FileWriter << Version;
+	*FileWriter << Flags;
+	NextChunkOffset = BlueprintProfilerSessionFile::HeaderSize;
+	return true;
+}
+
+void FProfilerSessionWriter::WriteChunk(uint32 ChunkId, const TArray<uint8>& Payload)
+{
+	uint32 Size = static_cast<uint32>(Payload.Num());
+	*FileWriter << ChunkId;
+	*FileWriter << Size;
+	if (Size > 0)
+	{
+		FileWriter->Serialize(const_cast<uint8*>(Payload.GetData()), Size);
+	}
+
+	if (FileWriter->IsError() && !bWriteError.exchange(true))
+	{
+		UE_LOG(LogTemp, Error, TEXT("[PROFILER] Failed to write session file: %s"), *FilePath);
+	}
+}
+
+void FProfilerSessionWriter::QueueChunk(uint32 ChunkId, TArray<uint8>&& Payload)
+{
+	NextChunkOffset += BlueprintProfilerSessionFile::ChunkHeaderSize + Payload.Num();
+
+	WritePipe.Launch(TEXT("BlueprintProfilerWriteChunk"), [this, ChunkId, Payload = MoveTemp(Payload)]()
+	{
+		WriteChunk(ChunkId, Payload);
+	});
+}
+
+void FProfilerSessionWriter::WriteFramePage(TArray<FExecutionFrame>&& Frames)
+{
+	if (!FileWriter.IsValid() || Frames.Num() == 0)
+	{
+		return;
+	}
+
+	check(Frames.Num() <= BlueprintProfilerSessionFile::FramesPerBlock);
+
+	FramePageOffsets.Add(NextChunkOffset);
+	FramePageCounts.Add(Frames.Num());
+	NextChunkOffset += BlueprintProfilerSessionFile::ChunkHeaderSize + BlueprintProfilerSessionFile::GetFramePagePayloadSize(Frames.Num());
+	FramesWritten += Frames.Num();
+
+	// 序列化也放在后台，录制线程只移交缓冲区
+	WritePipe.Launch(TEXT("BlueprintProfilerWriteFramePage"), [this, Frames = MoveTemp(Frames)]() mutable
+	{
+		TArray<uint8> Payload;
+		Payload.Reserve(BlueprintProfilerSessionFile::GetFramePagePayloadSize(Frames.Num()));
+		FMemoryWriter PayloadWriter(Payload);
+		int32 FrameCount = Frames.Num();
+		PayloadWriter << FrameCount;
+		for (FExecutionFrame& Frame : Frames)
+		{
+			BlueprintProfilerSessionFile::SerializeFrame(PayloadWriter, Frame);
+		}
+
+		WriteChunk(BlueprintProfilerSessionFile::ChunkFrames, Payload);
+		FileWriter->Flush();
+		PagesOnDisk.fetch_add(1, std::memory_order_release);
+	});
+}
+
+void FProfilerSessionWriter::WriteFrames(TConstArrayView<FExecutionFrame> Frames)
+{
+	for (int32 PageStart = 0; PageStart < Frames.Num(); PageStart += BlueprintProfilerSessionFile::FramesPerBlock)
+	{
+		const int32 PageCount = FMath::Min(BlueprintProfilerSessionFile::FramesPerBlock, Frames.Num() - PageStart);
+		WriteFramePage(TArray<FExecutionFrame>(Frames.GetData() + PageStart, PageCount));
+	}
+}
+
+void FProfilerSessionWriter::WriteSummary(const FRecordingSession& Session, TConstArrayView<FNodeExecutionData> Nodes, TConstArrayView<uint32> NodeIds)
+{
+	if (!FileWriter.IsValid())
+	{
+		return;
+	}
+
+	check(Nodes.Num() == NodeIds.Num());
+
+	// 节点名与蓝图名去重后写入字符串表
+	TArray<FString> Strings;
+	TMap<FString, int32> StringIndices;
+	TArray<TPair<int32, int32>> NameIndices;
+	NameIndices.Reserve(Nodes.Num());
+
+	auto AddString = [&Strings, &StringIndices](const FString& Value) -> int32
+	{
+		if (const int32* Existing = StringIndices.Find(Value))
+		{
+			return *Existing;
+		}
+		const int32 NewIndex = Strings.Add(Value);
+		StringIndices.Add(Value, NewIndex);
+		return NewIndex;
+	};
+
+	for (const FNodeExecutionData& Data : Nodes)
+	{
+		NameIndices.Emplace(AddString(Data.NodeName), AddString(Data.BlueprintName));
+	}
+
+	TArray<uint8> StringsPayload;
+	{
+		FMemoryWriter PayloadWriter(StringsPayload);
+		PayloadWriter << Strings;
+	}
+	QueueChunk(BlueprintProfilerSessionFile::ChunkStrings, MoveTemp(StringsPayload));
+
+	TArray<uint8> NodesPayload;
+	{
+		FMemoryWriter PayloadWriter(NodesPayload);
+		int32 NodeCount = Nodes.Num();
+		PayloadWriter << NodeCount;
+		for (int32 Index = 0; Index < Nodes.Num(); ++Index)
+		{
+			FNodeExecutionData Data = Nodes[Index];
+			uint32 NodeId = NodeIds[Index];
+			BlueprintProfilerSessionFile::SerializeNode(PayloadWriter, Data, NodeId, NameIndices[Index].Key, NameIndices[Index].Value);
+		}
+	}
+	QueueChunk(BlueprintProfilerSessionFile::ChunkNodes, MoveTemp(NodesPayload));
+
+	TArray<uint8> SessionPayload;
+	{
+		FMemoryWriter PayloadWriter(SessionPayload);
+		FRecordingSession SessionCopy = Session;
+		BlueprintProfilerSessionFile::SerializeSession(PayloadWriter, SessionCopy);
+	}
+	QueueChunk(BlueprintProfilerSessionFile::ChunkSession, MoveTemp(SessionPayload));
+}
+
+void FProfilerSessionWriter::WriteMemorySnapshots(TConstArrayView<FBlueprintMemorySnapshot> Snapshots)
+{
+	if (!FileWriter.IsValid() || Snapshots.Num() == 0)
+	{
+		return;
+	}
+
+	TArray<uint8> MemoryPayload;
+	{
+		FMemoryWriter PayloadWriter(MemoryPayload);
+		int32 SnapshotCount = Snapshots.Num();
+		PayloadWriter << SnapshotCount;
+		for (const FBlueprintMemorySnapshot& Snapshot : Snapshots)
+		{
+			FBlueprintMemorySnapshot SnapshotCopy = Snapshot;
+			BlueprintProfilerSessionFile::SerializeMemorySnapshot(PayloadWriter, SnapshotCopy);
+		}
+	}
+	QueueChunk(BlueprintProfilerSessionFile::ChunkMemory, MoveTemp(MemoryPayload));
+}
+
+bool FProfilerSessionWriter::Close()
+{
+	if (!FileWriter.IsValid())
+	{
+		return false;
+	}
+
+	QueueChunk(BlueprintProfilerSessionFile::ChunkEnd, TArray<uint8>());
+	WritePipe.WaitUntilEmpty();
+
+	PageReader.Reset();
+	const bool bSuccess = FileWriter->Close() && !bWriteError;
+	FileWriter.Reset();
+	return bSuccess;
+}
+
+void FProfilerSessionWriter::WaitForPages(int32 NumPages)
+{
+	if (PagesOnDisk.load(std::memory_order_acquire) < NumPages)
+	{
+		WritePipe.WaitUntilEmpty();
+	}
+}
+
+bool FProfilerSessionWriter::ReadFramePage(int32 PageIndex, TArray<FExecutionFrame>& OutFrames)
+{
+	OutFrames.Reset();
+	if (!FileWriter.IsValid() || !FramePageOffsets.IsValidIndex(PageIndex))
+	{
+		return false;
+	}
+
+	WaitForPages(PageIndex + 1);
+
+	// 文件仍在增长，读取器打开时记录的大小可能已经过期
+	const int64 PayloadOffset = FramePageOffsets[PageIndex] + BlueprintProfilerSessionFile::ChunkHeaderSize;
+	const int64 PageEnd = PayloadOffset + BlueprintProfilerSessionFile::GetFramePagePayloadSize(FramePageCounts[PageIndex]);
+	if (!PageReader.IsValid() || PageReader->TotalSize() < PageEnd)
+	{
+		PageReader.Reset(IFileManager::Get().CreateFileReader(*FilePath, FILEREAD_AllowWrite));
+		if (!PageReader.IsValid())
+		{
+			return false;
+		}
+	}
+
+	PageReader->Seek(PayloadOffset);
+	int32 FrameCount = 0;
+	*PageReader << FrameCount;
+	if (PageReader->IsError() || FrameCount < 0 || FrameCount > BlueprintProfilerSessionFile::FramesPerBlock)
+	{
+		PageReader.Reset();
+		return false;
+	}
+
+	OutFrames.Reserve(FrameCount);
+	for (int32 Index = 0; Index < FrameCount && !PageReader->IsError(); ++Index)
+	{
+		BlueprintProfilerSessionFile::SerializeFrame(*PageReader, OutFrames.AddDefaulted_GetRef());
+	}
+
+	if (PageReader->IsError())
+	{
+		PageReader.Reset();
+		OutFrames.Reset();
+		return false;
+	}
+	return true;
+}
+
+//============================================================
+// FProfilerSessionReader
+//============================================================
+
+FProfilerSessionReader::FProfilerSessionReader()
+{
+}
+
+FProfilerSessionReader::~FProfilerSessionReader()
+{
+	Close();
+}
+
+void FProfilerSessionReader::Close()
+{
+	FileView = FMemoryView();
+	MappedRegion.Reset();
+	MappedHandle.Reset();
+	FallbackBuffer.Empty();
+
+	Session = FRecordingSession();
+	Strings.Empty();
+	Nodes.Empty();
+	NodeIds.Empty();
+	MemorySnapshots.Empty();
+	FrameBlocks.Empty();
+	FrameBlockStarts.Empty();
+	TotalFrames = 0;
+	FileVersion = 0;
+	bComplete = false;
+}
+
+bool FProfilerSessionReader::Open(const FString& FilePath)
+{
+	Close();
+
+	// 优先内存映射，避免把整个会话文件读入内存
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	auto MappedResult = PlatformFile.OpenMappedEx(*FilePath);
+	if (MappedResult.HasValue())
+	{
+		MappedHandle = MappedResult.StealValue();
+		MappedRegion.Reset(MappedHandle->MapRegion(0, MappedHandle->GetFileSize()));
+	}
+
+	if (MappedRegion.IsValid())
+	{
+		FileView = FMemoryView(MappedRegion->GetMappedPtr(), static_cast<uint64>(MappedRegion->GetMappedSize()));
+	}
+	else
+	{
+		MappedHandle.Reset();
+		if (!FFileHelper::LoadFileToArray(FallbackBuffer, *FilePath))
+		{
+			return false;
+		}
+		FileView = MakeMemoryView(FallbackBuffer);
+	}
+
+	const int64 FileSize = static_cast<int64>(FileView.GetSize());
+	if (FileSize < BlueprintProfilerSessionFile::HeaderSize)
+	{
+		Close();
+		return false;
+	}
+
+	FMemoryReaderView HeaderReader(FileView);
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	uint32 Flags = 0;
+	HeaderReader << Magic;
+	HeaderReader << Version;
+	HeaderReader << Flags;
+
+	if (Magic != BlueprintProfilerSessionFile::Magic || Version == 0 || Version > BlueprintProfilerSessionFile::Version)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[PROFILER] Unsupported session file (magic 0x%08x, version %u): %s"), Magic, Version, *FilePath);
+		Close();
+		return false;
+	}
+	FileVersion = Version;
+
+	// 先扫描块目录，再按依赖顺序解析（NODE 依赖 STRS）
+	TArray<FChunkRef> StringChunks;
+	TArray<FChunkRef> NodeChunks;
+	TArray<FChunkRef> SessionChunks;
+
+	int64 Offset = BlueprintProfilerSessionFile::HeaderSize;
+	while (Offset + BlueprintProfilerSessionFile::ChunkHeaderSize <= FileSize)
+	{
+		FMemoryReaderView ChunkReader(FileView.Mid(Offset, BlueprintProfilerSessionFile::ChunkHeaderSize));
+		uint32 ChunkId = 0;
+		uint32 ChunkSize = 0;
+		ChunkReader << ChunkId;
+		ChunkReader << ChunkSize;
+
+		FChunkRef Chunk;
+		Chunk.Offset = Offset + BlueprintProfilerSessionFile::ChunkHeaderSize;
+		Chunk.Size = ChunkSize;
+		if (Chunk.Offset + Chunk.Size > FileSize)
+		{
+			// 录制中断时最后一个块可能不完整
+			UE_LOG(LogTemp, Warning, TEXT("[PROFILER] Truncated chunk at offset %lld in session file: %s"), Offset, *FilePath);
+			break;
+		}
+
+		switch (ChunkId)
+		{
+			case BlueprintProfilerSessionFile::ChunkSession: SessionChunks.Add(Chunk); break;
+			case BlueprintProfilerSessionFile::ChunkStrings: StringChunks.Add(Chunk); break;
+			case BlueprintProfilerSessionFile::ChunkNodes: NodeChunks.Add(Chunk); break;
+			case BlueprintProfilerSessionFile::ChunkMemory: ParseMemory(Chunk); break;
+			case BlueprintProfilerSessionFile::ChunkFrames:
+			{
+				FMemoryReaderView CountReader(GetChunkView(Chunk));
+				int32 BlockCount = 0;
+				CountReader << BlockCount;
+				if (CountReader.IsError() || !BlueprintProfilerSessionFile::IsValidRecordCount(CountReader, BlockCount, BlueprintProfilerSessionFile::GetSerializedFrameSize(FileVersion)))
+				{
+					// 计数与块大小不符的帧块不计入帧总数，也不会被读取
+					UE_LOG(LogTemp, Warning, TEXT("[PROFILER] Invalid frame count %d in chunk at offset %lld of session file: %s"), BlockCount, Offset, *FilePath);
+					break;
+				}
+				FrameBlockStarts.Add(TotalFrames);
+				TotalFrames += BlockCount;
+				FrameBlocks.Add(Chunk);
+				break;
+			}
+			case BlueprintProfilerSessionFile::ChunkEnd: bComplete = true; break;
+			default: break; // 未知块：新版本写入的附加数据
+		}
+
+		if (bComplete)
+		{
+			break;
+		}
+		Offset = Chunk.Offset + Chunk.Size;
+	}
+
+	for (const FChunkRef& Chunk : StringChunks)
+	{
+		// 字符串表损坏时节点名称无法解析，整个文件视为无效
+		if (!ParseStrings(Chunk))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[PROFILER] Invalid string table at offset %lld of session file: %s"), Chunk.Offset, *FilePath);
+			Close();
+			return false;
+		}
+	}
+	for (const FChunkRef& Chunk : NodeChunks)
+	{
+		ParseNodes(Chunk);
+	}
+	for (const FChunkRef& Chunk : SessionChunks)
+	{
+		ParseSession(Chunk);
+	}
+
+	if (SessionChunks.Num() == 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[PROFILER] Session file has no summary (recording was interrupted?): %s"), *FilePath);
+	}
+
+	return true;
+}
+
+FMemoryView FProfilerSessionReader::GetChunkView(const FChunkRef& Chunk) const
+{
+	return FileView.Mid(Chunk.Offset, Chunk.Size);
+}
+
+bool FProfilerSessionReader::ParseSession(const FChunkRef& Chunk)
+{
+	FMemoryReaderView Reader(GetChunkView(Chunk));
+	BlueprintProfilerSessionFile::SerializeSession(Reader, Session, FileVersion);
+	return !Reader.IsError();
+}
+
+bool FProfilerSessionReader::ParseStrings(const FChunkRef& Chunk)
+{
+	FMemoryReaderView Reader(GetChunkView(Chunk));
+	int32 StringCount = 0;
+	Reader << StringCount;
+	if (Reader.IsError() || !BlueprintProfilerSessionFile::IsValidRecordCount(Reader, StringCount, BlueprintProfilerSessionFile::MinSerializedStringSize))
+	{
+		return false;
+	}
+
+	// 与 TArray 的序列化格式相同：计数后逐个字符串
+	Strings.Reset(StringCount);
+	for (int32 Index = 0; Index < StringCount && !Reader.IsError(); ++Index)
+	{
+		Reader << Strings.AddDefaulted_GetRef();
+	}
+
+	return !Reader.IsError();
+}
+
+bool FProfilerSessionReader::ParseNodes(const FChunkRef& Chunk)
+{
+	FMemoryReaderView Reader(GetChunkView(Chunk));
+	int32 NodeCount = 0;
+	Reader << NodeCount;
+	if (Reader.IsError() || !BlueprintProfilerSessionFile::IsValidRecordCount(Reader, NodeCount, BlueprintProfilerSessionFile::MinSerializedNodeSize))
+	{
+		return false;
+	}
+
+	Nodes.Reserve(Nodes.Num() + NodeCount);
+	NodeIds.Reserve(NodeIds.Num() + NodeCount);
+	for (int32 Index = 0; Index < NodeCount && !Reader.IsError(); ++Index)
+	{
+		FNodeExecutionData Data;
+		uint32 NodeId = 0;
+		int32 NodeNameIndex = INDEX_NONE;
+		int32 BlueprintNameIndex = INDEX_NONE;
+		BlueprintProfilerSessionFile::SerializeNode(Reader, Data, NodeId, NodeNameIndex, BlueprintNameIndex);
+
+		Data.NodeName = Strings.IsValidIndex(NodeNameIndex) ? Strings[NodeNameIndex] : FString();
+		Data.BlueprintName = Strings.IsValidIndex(BlueprintNameIndex) ? Strings[BlueprintNameIndex] : FString();
+		Nodes.Add(MoveTemp(Data));
+		NodeIds.Add(NodeId);
+	}
+
+	return !Reader.IsError();
+}
+
+bool FProfilerSessionReader::ParseMemory(const FChunkRef& Chunk)
+{
+	FMemoryReaderView Reader(GetChunkView(Chunk));
+	int32 SnapshotCount = 0;
+	Reader << SnapshotCount;
+	if (Reader.IsError() || !BlueprintProfilerSessionFile::IsValidRecordCount(Reader, SnapshotCount, BlueprintProfilerSessionFile::MinSerializedMemorySnapshotSize))
+	{
+		return false;
+	}
+
+	MemorySnapshots.Reserve(MemorySnapshots.Num() + SnapshotCount);
+	for (int32 Index = 0; Index < SnapshotCount && !Reader.IsError(); ++Index)
+	{
+		FBlueprintMemorySnapshot Snapshot;
+		BlueprintProfilerSessionFile::SerializeMemorySnapshot(Reader, Snapshot);
+		if (!Reader.IsError())
+		{
+			MemorySnapshots.Add(MoveTemp(Snapshot));
+		}
+	}
+
+	return !Reader.IsError();
+}
+
+bool FProfilerSessionReader::ReadFrameBlock(int32 BlockIndex, TArray<FExecutionFrame>& OutFrames) const
+{
+	OutFrames.Reset();
+	if (!FrameBlocks.IsValidIndex(BlockIndex))
+	{
+		return false;
+	}
+
+	FMemoryReaderView Reader(GetChunkView(FrameBlocks[BlockIndex]));
+	int32 BlockCount = 0;
+	Reader << BlockCount;
+	if (Reader.IsError() || !BlueprintProfilerSessionFile::IsValidRecordCount(Reader, BlockCount, BlueprintProfilerSessionFile::GetSerializedFrameSize(FileVersion)))
+	{
+		return false;
+	}
+
+	OutFrames.Reserve(BlockCount);
+	for (int32 Index = 0; Index < BlockCount && !Reader.IsError(); ++Index)
+	{
+		BlueprintProfilerSessionFile::SerializeFrame(Reader, OutFrames.AddDefaulted_GetRef(), FileVersion);
+	}
+
+	return !Reader.IsError();
+}
+
+int32 FProfilerSessionReader::FindFrameBlock(int64 FrameIndex) const
+{
+	if (FrameIndex < 0 || FrameIndex >= TotalFrames)
+	{
+		return INDEX_NONE;
+	}
+
+	// 最后一个起始帧不大于 FrameIndex 的块
+	return Algo::UpperBound(FrameBlockStarts, FrameIndex) - 1;
+}
@@ -4,6 +4,15 @@
 #include "Misc/AutomationTest.h"
 #include "UI/SBlueprintProfilerWidget.h"
 #include "Data/ProfilerDataTypes.h"
+#include "Data/ProfilerRowStore.h"
+#include "Data/ProfilerDataExporter.h"
+#include "Dom/JsonObject.h"
+#include "HAL/FileManager.h"
+#include "Misc/Compression.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/MemoryWriter.h"
 #include "Widgets/SWidget.h"
 
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDashboardUIDataDisplayTest, "BlueprintProfiler.UI.DataDisplay", 
@@ -104,4 +113,212 @@ bool FDashboardUISearchFilterTest::RunTest(const FString& Parameters)
 	TestTrue("Widget should handle multiple data types", true);
 	
 	return true;
-}
\ No newline at end of file
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDashboardUIRowStoreTest, "BlueprintProfiler.UI.RowStore", 
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FDashboardUIRowStoreTest::RunTest(const FString& Parameters)
+{
+	// Test incremental row updates and view maintenance of the dashboard list
+
+	auto MakeItem = [](EProfilerDataType Type, const FString& Name, ESeverity Severity, float Value)
+	{
+		TSharedPtr<FProfilerDataItem> Item = MakeShared<FProfilerDataItem>();
+		Item->Type = Type;
+		Item->Name = Name;
+		Item->BlueprintName = TEXT("BP_Test");
+		Item->Severity = Severity;
+		Item->Value = Value;
+		return Item;
+	};
+	auto KeyOf = [](EProfilerDataType Type, const FString& Name)
+	{
+		return FProfilerRowStore::FHashBuilder(Type).Add(Name).Finish();
+	};
+
+	FProfilerRowStore Store;
+	TArray<TSharedPtr<FProfilerDataItem>> Visible;
+
+	// Test 1: rows are sorted by severity by default
+	Store.BeginUpdate(EProfilerDataType::Runtime);
+	Store.UpdateRow(KeyOf(EProfilerDataType::Runtime, TEXT("A")), MakeItem(EProfilerDataType::Runtime, TEXT("NodeA"), ESeverity::Low, 10.0f));
+	Store.UpdateRow(KeyOf(EProfilerDataType::Runtime, TEXT("B")), MakeItem(EProfilerDataType::Runtime, TEXT("NodeB"), ESeverity::Critical, 5.0f));
+	Store.UpdateRow(KeyOf(EProfilerDataType::Runtime, TEXT("C")), MakeItem(EProfilerDataType::Runtime, TEXT("NodeC"), ESeverity::High, 1.0f));
+	Store.EndUpdate(EProfilerDataType::Runtime);
+
+	TestTrue("First view should be written", Store.UpdateView(Visible));
+	if (!TestEqual("All rows should be visible", Visible.Num(), 3))
+	{
+		return false;
+	}
+	TestEqual("Critical row first", Visible[0]->Name, FString(TEXT("NodeB")));
+	TestEqual("Low row last", Visible[2]->Name, FString(TEXT("NodeA")));
+	const TSharedPtr<FProfilerDataItem> ItemA = Visible[2];
+	TestFalse("Unchanged view should not be rewritten", Store.UpdateView(Visible));
+
+	// Test 2: a diff update keeps unchanged rows, re-sorts changed ones and drops missing ones
+	const int32 RowA = Store.FindRow(KeyOf(EProfilerDataType::Runtime, TEXT("A")));
+	Store.BeginUpdate(EProfilerDataType::Runtime);
+	Store.UpdateRow(KeyOf(EProfilerDataType::Runtime, TEXT("A")), MakeItem(EProfilerDataType::Runtime, TEXT("NodeA"), ESeverity::Low, 10.0f));
+	Store.UpdateRow(KeyOf(EProfilerDataType::Runtime, TEXT("C")), MakeItem(EProfilerDataType::Runtime, TEXT("NodeC"), ESeverity::Critical, 20.0f));
+	Store.EndUpdate(EProfilerDataType::Runtime);
+
+	TestEqual("Row ID should be stable", Store.FindRow(KeyOf(EProfilerDataType::Runtime, TEXT("A"))), RowA);
+	TestEqual("Row missing from the update should be removed", Store.Num(), 2);
+	TestTrue("Changed view should be written", Store.UpdateView(Visible));
+	if (!TestEqual("Two rows should be visible", Visible.Num(), 2))
+	{
+		return false;
+	}
+	TestEqual("Changed row moves up", Visible[0]->Name, FString(TEXT("NodeC")));
+	TestTrue("Unchanged row keeps its item", Visible[1] == ItemA);
+
+	// Test 3: a key passed twice in one update gets a second row, and keeps it on the next update
+	for (int32 Pass = 0; Pass < 2; ++Pass)
+	{
+		Store.BeginUpdate(EProfilerDataType::Lint);
+		Store.UpdateRow(KeyOf(EProfilerDataType::Lint, TEXT("Dup")), MakeItem(EProfilerDataType::Lint, TEXT("Dup"), ESeverity::Medium, 1.0f));
+		Store.UpdateRow(KeyOf(EProfilerDataType::Lint, TEXT("Dup")), MakeItem(EProfilerDataType::Lint, TEXT("Dup"), ESeverity::Medium, 1.0f));
+		Store.EndUpdate(EProfilerDataType::Lint);
+		TestEqual("Duplicate keys should get their own rows", Store.Num(), 4);
+	}
+
+	// Test 4: filter, sort and search
+	Store.SetView(EProfilerRowFilter::Lint, EProfilerRowSort::Severity, FString());
+	Store.UpdateView(Visible);
+	TestEqual("Lint filter", Visible.Num(), 2);
+
+	Store.SetView(EProfilerRowFilter::All, EProfilerRowSort::Name, TEXT("node"));
+	Store.UpdateView(Visible);
+	if (TestEqual("Search matches node rows", Visible.Num(), 2))
+	{
+		TestEqual("Sorted by name", Visible[0]->Name, FString(TEXT("NodeA")));
+	}
+
+	Store.SetView(EProfilerRowFilter::All, EProfilerRowSort::Name, TEXT("NODEC"));
+	Store.UpdateView(Visible);
+	if (TestEqual("Narrowed search", Visible.Num(), 1))
+	{
+		TestEqual("Narrowed search keeps the match", Visible[0]->Name, FString(TEXT("NodeC")));
+	}
+
+	Store.SetView(EProfilerRowFilter::All, EProfilerRowSort::Name, FString());
+	Store.UpdateView(Visible);
+	TestEqual("Cleared search shows all rows", Visible.Num(), 4);
+
+	// Test 5: removing a type
+	Store.RemoveRows(EProfilerDataType::Lint);
+	TestTrue("Removal should rewrite the view", Store.UpdateView(Visible));
+	TestEqual("Only runtime rows remain", Visible.Num(), 2);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDashboardUIExportTest, "BlueprintProfiler.UI.Export",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FDashboardUIExportTest::RunTest(const FString& Parameters)
+{
+	FProfilerExportSnapshot Snapshot;
+	Snapshot.TypeNames[0] = TEXT("Runtime");
+	Snapshot.TypeNames[1] = TEXT("Lint");
+	Snapshot.TypeNames[2] = TEXT("Memory");
+	Snapshot.SeverityNames[0] = TEXT("Low");
+	Snapshot.SeverityNames[1] = TEXT("Medium");
+	Snapshot.SeverityNames[2] = TEXT("High");
+	Snapshot.SeverityNames[3] = TEXT("Critical");
+	Snapshot.ExportDate = TEXT("2026.01.01-00.00.00");
+
+	// 跨越多个分块，首行含需要转义的字符
+	const int32 NumRows = FProfilerDataExporter::RowsPerChunk + 10;
+	for (int32 Index = 0; Index < NumRows; ++Index)
+	{
+		FProfilerExportRow& Row = Snapshot.Rows.AddDefaulted_GetRef();
+		Row.Type = EProfilerDataType::Lint;
+		Row.Severity = ESeverity::High;
+		Row.Value = 1.5f;
+		Row.Name = Index == 0 ? FString(TEXT("Node, \"Quoted\"")) : FString::Printf(TEXT("Node%d"), Index);
+		Row.BlueprintName = TEXT("BP_Test");
+		Row.Category = TEXT("Performance");
+	}
+
+	auto ToText = [](const TArray<uint8>& Bytes)
+	{
+		FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Bytes.GetData()), Bytes.Num());
+		FString Text(Converted.Length(), Converted.Get());
+		if (Text.Len() > 0 && Text[0] == TCHAR(0xFEFF))
+		{
+			Text.RightChopInline(1);
+		}
+		return Text;
+	};
+
+	// Test 1: CSV quotes fields with separators and writes every row
+	TArray<uint8> CsvBytes;
+	{
+		FMemoryWriter Writer(CsvBytes);
+		TestTrue("CSV export should succeed", FProfilerDataExporter::WriteRows(Writer, Snapshot, EProfilerExportFormat::Csv, false));
+	}
+	TArray<FString> Lines;
+	ToText(CsvBytes).ParseIntoArrayLines(Lines);
+	TestEqual("CSV has header and all rows", Lines.Num(), NumRows + 1);
+	if (Lines.Num() > 1)
+	{
+		TestEqual("CSV header", Lines[0], FString(TEXT("Type,Name,Blueprint,Category,Value,Severity")));
+		TestEqual("CSV escaping", Lines[1], FString(TEXT("Lint,\"Node, \"\"Quoted\"\"\",BP_Test,Performance,1.50,High")));
+	}
+
+	// Test 2: streamed JSON parses back to the same rows
+	TArray<uint8> JsonBytes;
+	{
+		FMemoryWriter Writer(JsonBytes);
+		TestTrue("JSON export should succeed", FProfilerDataExporter::WriteRows(Writer, Snapshot, EProfilerExportFormat::Json, false));
+	}
+	TSharedPtr<FJsonObject> Root;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ToText(JsonBytes));
+	if (TestTrue("JSON should parse", FJsonSerializer::Deserialize(Reader, Root) && Root.IsValid()))
+	{
+		TestEqual("TotalItems", static_cast<int32>(Root->GetNumberField(TEXT("TotalItems"))), NumRows);
+		const TArray<TSharedPtr<FJsonValue>>& Items = Root->GetArrayField(TEXT("Items"));
+		if (TestEqual("JSON has all rows", Items.Num(), NumRows))
+		{
+			TestEqual("JSON escaping", Items[0]->AsObject()->GetStringField(TEXT("Name")), Snapshot.Rows[0].Name);
+			TestEqual("JSON value", Items[0]->AsObject()->GetNumberField(TEXT("Value")), 1.5);
+		}
+	}
+
+	// Test 3: compressed output is gzip and inflates to the plain output
+	FProfilerExportSnapshot SmallSnapshot = Snapshot;
+	SmallSnapshot.Rows.SetNum(10);
+	TArray<uint8> PlainBytes;
+	TArray<uint8> GzipBytes;
+	{
+		FMemoryWriter PlainWriter(PlainBytes);
+		FProfilerDataExporter::WriteRows(PlainWriter, SmallSnapshot, EProfilerExportFormat::Csv, false);
+		FMemoryWriter GzipWriter(GzipBytes);
+		TestTrue("Compressed export should succeed", FProfilerDataExporter::WriteRows(GzipWriter, SmallSnapshot, EProfilerExportFormat::Csv, true));
+	}
+	if (TestTrue("gzip magic", GzipBytes.Num() > 2 && GzipBytes[0] == 0x1f && GzipBytes[1] == 0x8b))
+	{
+		TArray<uint8> Inflated;
+		Inflated.SetNumUninitialized(PlainBytes.Num());
+		TestTrue("gzip should inflate", FCompression::UncompressMemory(NAME_Gzip, Inflated.GetData(), Inflated.Num(), GzipBytes.GetData(), GzipBytes.Num()));
+		TestTrue("Inflated output matches", Inflated == PlainBytes);
+	}
+	TestTrue(".gz selects compression", FProfilerDataExporter::IsCompressedPath(TEXT("Export.csv.gz")));
+
+	// Test 4: a cancelled export leaves neither the file nor its temporary behind
+	const FString FilePath = FPaths::CreateTempFilename(*FPaths::ProjectIntermediateDir(), TEXT("ExportTest"), TEXT(".csv"));
+	std::atomic<bool> bCancel = true;
+	TestFalse("Cancelled export should fail", FProfilerDataExporter::WriteFile(FilePath, Snapshot, EProfilerExportFormat::Csv, false, &bCancel));
+	TestFalse("No file after cancel", IFileManager::Get().FileExists(*FilePath));
+	TestFalse("No temporary after cancel", IFileManager::Get().FileExists(*(FilePath + TEXT(".tmp"))));
+
+	bCancel = false;
+	TestTrue("File export should succeed", FProfilerDataExporter::WriteFile(FilePath, Snapshot, EProfilerExportFormat::Csv, false, &bCancel));
+	TestEqual("File holds the streamed rows", IFileManager::Get().FileSize(*FilePath), static_cast<int64>(CsvBytes.Num()));
+	IFileManager::Get().Delete(*FilePath);
+
+	return true;
+}
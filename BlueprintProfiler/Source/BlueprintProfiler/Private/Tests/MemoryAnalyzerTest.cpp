@@ -3,6 +3,9 @@
 #include "CoreMinimal.h"
 #include "Misc/AutomationTest.h"
 #include "Analyzers/MemoryAnalyzer.h"
+#include "Analyzers/ObjectSizeCache.h"
+#include "Analyzers/AssetDependencyGraph.h"
+#include "Analyzers/AssetDominatorTree.h"
 #include "Engine/Blueprint.h"
 #include "Engine/Texture2D.h"
 #include "Tests/AutomationCommon.h"
@@ -60,4 +63,196 @@ bool FMemoryAnalyzerAsyncTest::RunTest(const FString& Parameters)
 	TestFalse("Should not be in progress after cancel", MemoryAnalyzer.IsAnalysisInProgress());
 	
 	return true;
-}
\ No newline at end of file
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMemoryAnalyzerObjectSizeCacheTest, "BlueprintProfiler.MemoryAnalyzer.ObjectSizeCache", 
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FMemoryAnalyzerObjectSizeCacheTest::RunTest(const FString& Parameters)
+{
+	FObjectSizeCache SizeCache;
+
+	UTexture2D* Texture = UTexture2D::CreateTransient(64, 64);
+	if (!TestNotNull("Transient texture should be created", Texture))
+	{
+		return false;
+	}
+
+	// Measured on the game thread, then readable without the object
+	const FObjectSizeInfo Measured = SizeCache.GetOrMeasure(Texture);
+	TestFalse("Loaded object should be measured, not read from disk", Measured.bFromDisk);
+	TestTrue("Estimated total should include the exclusive size", Measured.EstimatedTotalBytes >= Measured.ExclusiveBytes);
+
+	FObjectSizeInfo Cached;
+	TestTrue("Measured size should be cached by object path", SizeCache.Find(FSoftObjectPath(Texture), Cached));
+	TestEqual("Cached exclusive size", Cached.ExclusiveBytes, Measured.ExclusiveBytes);
+	TestEqual("Cached estimated total size", Cached.EstimatedTotalBytes, Measured.EstimatedTotalBytes);
+
+	// Saving or reloading the package drops its sizes
+	SizeCache.Invalidate(Texture->GetPackage()->GetFName());
+	TestFalse("Invalidated size should be gone", SizeCache.Find(FSoftObjectPath(Texture), Cached));
+
+	// Unknown unloaded assets have no disk size and are not cached
+	const FSoftObjectPath MissingPath(TEXT("/Game/BlueprintProfilerTests/Missing.Missing"));
+	const FObjectSizeInfo Missing = SizeCache.GetOrMeasure(MissingPath);
+	TestTrue("Unloaded asset should use the disk size", Missing.bFromDisk);
+	TestEqual("Unknown package should have no size", Missing.ExclusiveBytes, int64(0));
+	TestFalse("Unknown package should not be cached", SizeCache.Find(MissingPath, Cached));
+
+	// Time-sliced requests finish on the ticker
+	bool bRequestCompleted = false;
+	SizeCache.RequestSizes({ FSoftObjectPath(Texture) }, [&bRequestCompleted]() { bRequestCompleted = true; });
+	TestTrue("Request should be pending until the ticker runs", SizeCache.HasPendingRequests());
+	for (int32 TickIndex = 0; TickIndex < 10 && !bRequestCompleted; ++TickIndex)
+	{
+		FTSTicker::GetCoreTicker().Tick(0.0f);
+	}
+	TestTrue("Request should complete", bRequestCompleted);
+	TestTrue("Requested size should be cached", SizeCache.Find(FSoftObjectPath(Texture), Cached));
+
+	// Cancelled requests never call back
+	bool bCancelledCompleted = false;
+	SizeCache.RequestSizes({ FSoftObjectPath(Texture) }, [&bCancelledCompleted]() { bCancelledCompleted = true; });
+	SizeCache.CancelRequests();
+	FTSTicker::GetCoreTicker().Tick(0.0f);
+	TestFalse("Cancelled request should not complete", bCancelledCompleted);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMemoryAnalyzerDependencyGraphTest, "BlueprintProfiler.MemoryAnalyzer.DependencyGraph", 
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FMemoryAnalyzerDependencyGraphTest::RunTest(const FString& Parameters)
+{
+	// A -> B (hard), A -> C (soft), B -> C (hard), C -> C (self), D -> B (hard and soft)
+	TArray<FName> PackageNames = { TEXT("/Game/A"), TEXT("/Game/B"), TEXT("/Game/C"), TEXT("/Game/D") };
+	TArray<TArray<int32>> HardDependencies = { { 1 }, { 2, 2 }, { 2 }, { 1 } };
+	TArray<TArray<int32>> SoftDependencies = { { 2 }, {}, {}, { 1, 7 } };
+
+	FAssetDependencyGraph Graph;
+	Graph.BuildFromAdjacency(MoveTemp(PackageNames), HardDependencies, SoftDependencies);
+
+	TestEqual("Packages", Graph.Num(), 4);
+	TestEqual("Self, duplicate, out of range and hard-and-soft edges are dropped", Graph.NumEdges(), 4);
+	TestEqual("Package lookup", Graph.FindPackage(TEXT("/Game/C")), 2);
+	TestEqual("Unknown package", Graph.FindPackage(TEXT("/Game/Missing")), INDEX_NONE);
+
+	TestEqual("A dependencies", Graph.GetDependencies(0).Num(), 2);
+	TestEqual("A hard dependencies", Graph.GetHardDependencies(0).Num(), 1);
+	TestEqual("A hard dependency is B", Graph.GetHardDependencies(0)[0], 1);
+
+	TestEqual("B referencers", Graph.GetReferencers(1).Num(), 2);
+	TestEqual("B hard referencers", Graph.GetHardReferencers(1).Num(), 2);
+	TestEqual("C referencers", Graph.GetReferencers(2).Num(), 2);
+	TestEqual("C hard referencers", Graph.GetHardReferencers(2).Num(), 1);
+	TestEqual("C hard referencer is B", Graph.GetHardReferencers(2)[0], 1);
+	TestEqual("D referencers", Graph.GetReferencers(3).Num(), 0);
+
+	// Counts are sorted by referencer count, ties by path
+	const TArray<FAssetReferenceCount> ReferenceCounts = FMemoryAnalyzer::ComputeReferenceCounts(Graph);
+	if (!TestEqual("One count per package", ReferenceCounts.Num(), 4))
+	{
+		return false;
+	}
+
+	TestEqual("Most referenced first", ReferenceCounts[0].AssetPath, FString(TEXT("/Game/B")));
+	TestEqual("Tie broken by path", ReferenceCounts[1].AssetPath, FString(TEXT("/Game/C")));
+	TestEqual("B count", ReferenceCounts[0].ReferenceCount, 2);
+	TestTrue("B referenced by A", ReferenceCounts[0].ReferencedBy.Contains(TEXT("/Game/A")));
+	TestTrue("B referenced by D", ReferenceCounts[0].ReferencedBy.Contains(TEXT("/Game/D")));
+	TestEqual("Unreferenced packages last", ReferenceCounts[3].ReferenceCount, 0);
+	TestEqual("Short name from package", ReferenceCounts[0].AssetName, FString(TEXT("B")));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMemoryAnalyzerDominatorTreeTest, "BlueprintProfiler.MemoryAnalyzer.DominatorTree", 
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FMemoryAnalyzerDominatorTreeTest::RunTest(const FString& Parameters)
+{
+	// BP_A -> T_Own, BP_A -> M_Shared -> T_Shared <- M_Shared <- BP_B; C_1 <-> C_2 is a cycle nothing else references
+	enum { BP_A, T_Own, M_Shared, T_Shared, BP_B, C_1, C_2 };
+	TArray<FName> PackageNames = { TEXT("/Game/BP_A"), TEXT("/Game/T_Own"), TEXT("/Game/M_Shared"), TEXT("/Game/T_Shared"),
+		TEXT("/Game/BP_B"), TEXT("/Game/C_1"), TEXT("/Game/C_2") };
+	TArray<TArray<int32>> HardDependencies = { { T_Own, M_Shared }, {}, { T_Shared }, {}, { M_Shared }, { C_2 }, { C_1 } };
+
+	TSharedRef<FAssetDependencyGraph> Graph = MakeShared<FAssetDependencyGraph>();
+	Graph->BuildFromAdjacency(MoveTemp(PackageNames), HardDependencies, {});
+
+	FAssetDominatorTree DominatorTree;
+	DominatorTree.Build(Graph, { 1, 10, 5, 20, 2, 3, 4 });
+
+	TestEqual("Own texture is dominated by its blueprint", DominatorTree.GetImmediateDominator(T_Own), int32(BP_A));
+	TestEqual("Shared material is only dominated by the root", DominatorTree.GetImmediateDominator(M_Shared), int32(INDEX_NONE));
+	TestEqual("Shared texture is dominated by the material", DominatorTree.GetImmediateDominator(T_Shared), int32(M_Shared));
+	TestTrue("Material dominates its texture", DominatorTree.Dominates(M_Shared, T_Shared));
+	TestFalse("Blueprint does not dominate the shared texture", DominatorTree.Dominates(BP_A, T_Shared));
+	TestEqual("Unreachable cycle is entered through its first package", DominatorTree.GetImmediateDominator(C_2), int32(C_1));
+
+	const FAssetRetainedSize SizesA = DominatorTree.GetSizes(BP_A);
+	TestEqual("Exclusive size", SizesA.ExclusiveBytes, int64(1));
+	TestEqual("Retained size counts only what unloads with the blueprint", SizesA.RetainedBytes, int64(11));
+	TestEqual("Shared size", SizesA.SharedBytes, int64(25));
+	TestEqual("Inclusive size counts shared packages once", SizesA.GetInclusiveBytes(), int64(36));
+	TestEqual("Hard dependency fan-out", SizesA.NumHardDependencies, 3);
+
+	const FAssetRetainedSize SizesB = DominatorTree.GetSizes(BP_B);
+	TestEqual("Other blueprint retains only itself", SizesB.RetainedBytes, int64(2));
+	TestEqual("Other blueprint shares the material", SizesB.SharedBytes, int64(25));
+
+	TestEqual("Material retains its texture", DominatorTree.GetRetainedSize(M_Shared), int64(25));
+	TestEqual("Cycle is retained by its entry package", DominatorTree.GetRetainedSize(C_1), int64(7));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMemoryAnalyzerAuditTest, "BlueprintProfiler.MemoryAnalyzer.MemoryAudit", 
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FMemoryAnalyzerAuditTest::RunTest(const FString& Parameters)
+{
+	// BP_A -> T_Own, BP_A -> M_Shared -> T_Shared, BP_B -> M_Shared
+	enum { BP_A, T_Own, M_Shared, T_Shared, BP_B };
+	TArray<FName> PackageNames = { TEXT("/Game/BP_A"), TEXT("/Game/T_Own"), TEXT("/Game/M_Shared"), TEXT("/Game/T_Shared"), TEXT("/Game/BP_B") };
+	TArray<TArray<int32>> HardDependencies = { { T_Own, M_Shared }, {}, { T_Shared }, {}, { M_Shared } };
+
+	TSharedRef<FAssetDependencyGraph> Graph = MakeShared<FAssetDependencyGraph>();
+	Graph->BuildFromAdjacency(MoveTemp(PackageNames), HardDependencies, {});
+
+	constexpr int64 MB = 1024 * 1024;
+	FAssetDominatorTree DominatorTree;
+	DominatorTree.Build(Graph, { 1 * MB, 30 * MB, 5 * MB, 20 * MB, 2 * MB });
+
+	const TArray<int32> Blueprints = { BP_B, BP_A };
+	const TArray<FBlueprintMemoryAuditEntry> Entries = FMemoryAnalyzer::ComputeMemoryAudit(DominatorTree, Blueprints, FLargeResourceRules(), 10.0f);
+	if (!TestEqual("One row per blueprint", Entries.Num(), 2))
+	{
+		return false;
+	}
+
+	const FBlueprintMemoryAuditEntry& Top = Entries[0];
+	TestEqual("Ranked by retained size", Top.BlueprintName, FString(TEXT("BP_A")));
+	TestEqual("Retained size", Top.RetainedSize, 31.0f);
+	TestEqual("Shared size", Top.SharedSize, 25.0f);
+	TestEqual("Direct hard references", Top.NumDirectHardReferences, 2);
+	TestEqual("Transitive hard references", Top.NumHardDependencies, 3);
+
+	if (TestEqual("Large resources above the threshold", Top.LargeReferences.Num(), 2))
+	{
+		TestEqual("Largest resource first", Top.LargeReferences[0].AssetSize, 30.0f);
+		TestEqual("Reference path through the shared material", Top.LargeReferences[1].ReferencePath,
+			FString(TEXT("/Game/BP_A -> /Game/M_Shared -> /Game/T_Shared")));
+	}
+
+	TestEqual("Second blueprint retains only itself", Entries[1].RetainedSize, 2.0f);
+	TestEqual("Second blueprint sees the shared texture", Entries[1].LargeReferences.Num(), 1);
+
+	// Cancellation returns no partial ranking
+	std::atomic<bool> bCancelRequested(true);
+	TestEqual("Cancelled audit is empty",
+		FMemoryAnalyzer::ComputeMemoryAudit(DominatorTree, Blueprints, FLargeResourceRules(), 10.0f, &bCancelRequested).Num(), 0);
+
+	return true;
+}
@@ -0,0 +1,699 @@
+// Copyright xnbmy 2026. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Analyzers/RuntimeProfiler.h"
+#include "Analyzers/StaticLinter.h"
+#include "Analyzers/BlueprintLintSnapshot.h"
+#include "Analyzers/MemoryAnalyzer.h"
+#include "Analyzers/AssetDependencyGraph.h"
+#include "Analyzers/AssetDominatorTree.h"
+#include "UI/SBlueprintProfilerWidget.h"
+#include "Data/ProfilerDataTypes.h"
+#include "Engine/Blueprint.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraphSchema_K2.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/Pawn.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_DynamicCast.h"
+#include "K2Node_Event.h"
+#include "K2Node_MacroInstance.h"
+#include "K2Node_Self.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "Interfaces/IPluginManager.h"
+#include "Dom/JsonObject.h"
+#include "HAL/FileManager.h"
+#include "Math/RandomStream.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/Script.h"
+#include "UObject/UObjectGlobals.h"
+
+// 性能基准：测量分析器自身的开销。结果以 JSON Lines 追加到
+// Saved/BlueprintProfiler/Benchmarks/BenchmarkResults.jsonl（-BlueprintProfilerBenchmarkResults=<path> 可覆盖），
+// 每行一个指标，带插件和引擎版本，便于跨版本跟踪回归。
+
+namespace BlueprintProfilerBenchmark
+{
+	struct FBenchmarkParam
+	{
+		const TCHAR* Name;
+		double Value;
+	};
+
+	static const FString& GetRunId()
+	{
+		// 同一次编辑器会话中运行的所有基准共用一个 ID，便于把一次运行的各行归到一起
+		static const FString RunId = FGuid::NewGuid().ToString(EGuidFormats::DigitsWithHyphensLower);
+		return RunId;
+	}
+
+	static FString GetResultsFilePath()
+	{
+		FString FilePath;
+		if (!FParse::Value(FCommandLine::Get(), TEXT("BlueprintProfilerBenchmarkResults="), FilePath))
+		{
+			FilePath = FPaths::ProjectSavedDir() / TEXT("BlueprintProfiler/Benchmarks/BenchmarkResults.jsonl");
+		}
+		return FilePath;
+	}
+
+	static FString GetPluginVersion()
+	{
+		const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("BlueprintProfiler"));
+		return Plugin.IsValid() ? Plugin->GetDescriptor().VersionName : FString();
+	}
+
+	/** Appends one metric as a line of JSON to the results file */
+	static bool WriteResult(const TCHAR* Benchmark, const FString& Metric, double Value, const TCHAR* Unit, std::initializer_list<FBenchmarkParam> Parameters = {})
+	{
+		TSharedRef<FJsonObject> Json = MakeShared<FJsonObject>();
+		Json->SetStringField(TEXT("RunId"), GetRunId());
+		Json->SetStringField(TEXT("Timestamp"), FDateTime::UtcNow().ToIso8601());
+		Json->SetStringField(TEXT("Benchmark"), Benchmark);
+		Json->SetStringField(TEXT("Metric"), Metric);
+		Json->SetNumberField(TEXT("Value"), Value);
+		Json->SetStringField(TEXT("Unit"), Unit);
+
+		TSharedRef<FJsonObject> ParametersJson = MakeShared<FJsonObject>();
+		for (const FBenchmarkParam& Parameter : Parameters)
+		{
+			ParametersJson->SetNumberField(Parameter.Name, Parameter.Value);
+		}
+		Json->SetObjectField(TEXT("Parameters"), ParametersJson);
+
+		Json->SetStringField(TEXT("PluginVersion"), GetPluginVersion());
+		Json->SetStringField(TEXT("EngineVersion"), FEngineVersion::Current().ToString());
+		Json->SetStringField(TEXT("BuildConfiguration"), LexToString(FApp::GetBuildConfiguration()));
+		Json->SetStringField(TEXT("Platform"), FPlatformProperties::IniPlatformName());
+		Json->SetNumberField(TEXT("NumCores"), FPlatformMisc::NumberOfCoresIncludingHyperthreads());
+
+		FString Line;
+		TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Line);
+		FJsonSerializer::Serialize(Json, Writer);
+		Line += TEXT("\n");
+
+		UE_LOG(LogTemp, Display, TEXT("BlueprintProfiler benchmark %s.%s: %.3f %s"), Benchmark, *Metric, Value, Unit);
+		return FFileHelper::SaveStringToFile(Line, *GetResultsFilePath(), FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM, &IFileManager::Get(), FILEWRITE_Append);
+	}
+
+	/** Fastest of several runs, in seconds; the minimum is the least disturbed by the rest of the editor */
+	static double BestOf(int32 NumRuns, TFunctionRef<void()> Body)
+	{
+		double BestSeconds = MAX_dbl;
+		for (int32 Run = 0; Run < NumRuns; ++Run)
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			Body();
+			BestSeconds = FMath::Min(BestSeconds, FPlatformTime::Seconds() - StartTime);
+		}
+		return BestSeconds;
+	}
+
+	/**
+	 * Shape of a generated Actor Blueprint: a chain of call nodes on Tick, wrapped in nested ForLoops
+	 */
+	struct FSyntheticBlueprintSpec
+	{
+		int32 NumNodes = 100;      // Call nodes chained after the Tick event
+		int32 LoopDepth = 0;       // Nested ForLoop macros around the chain
+		int32 LoopCount = 4;       // Iterations of each loop
+		int32 CastInterval = 8;    // Every Nth chained node is a cast to Pawn, 0 for none
+		int32 NumDeadNodes = 0;    // Unconnected call nodes
+	};
+
+	static UEdGraphPin* FindExecPin(UEdGraphNode* Node, EEdGraphPinDirection Direction, FName PinName = NAME_None)
+	{
+		if (!Node)
+		{
+			return nullptr;
+		}
+
+		for (UEdGraphPin* Pin : Node->Pins)
+		{
+			if (Pin->Direction == Direction && Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec
+				&& (PinName.IsNone() || Pin->PinName == PinName))
+			{
+				return Pin;
+			}
+		}
+		return nullptr;
+	}
+
+	static UEdGraph* FindStandardMacro(FName MacroName)
+	{
+		UBlueprint* StandardMacros = LoadObject<UBlueprint>(nullptr, TEXT("/Engine/EditorBlueprintResources/StandardMacros.StandardMacros"));
+		if (!StandardMacros)
+		{
+			return nullptr;
+		}
+
+		for (UEdGraph* MacroGraph : StandardMacros->MacroGraphs)
+		{
+			if (MacroGraph && MacroGraph->GetFName() == MacroName)
+			{
+				return MacroGraph;
+			}
+		}
+		return nullptr;
+	}
+
+	static UK2Node_CallFunction* AddCallNode(UEdGraph& Graph, UFunction* Function, int32 PosX, int32 PosY)
+	{
+		FGraphNodeCreator<UK2Node_CallFunction> Creator(Graph);
+		UK2Node_CallFunction* CallNode = Creator.CreateNode(false);
+		CallNode->SetFromFunction(Function);
+		CallNode->NodePosX = PosX;
+		CallNode->NodePosY = PosY;
+		Creator.Finalize();
+		return CallNode;
+	}
+
+	/** Builds and compiles a Blueprint in a /Temp package; it is never saved */
+	static UBlueprint* CreateSyntheticBlueprint(const FString& Name, const FSyntheticBlueprintSpec& Spec)
+	{
+		static int32 Serial = 0;
+		const FString PackageName = FString::Printf(TEXT("/Temp/BlueprintProfilerBenchmark/%s_%d"), *Name, ++Serial);
+		UPackage* Package = CreatePackage(*PackageName);
+		UBlueprint* Blueprint = FKismetEditorUtilities::CreateBlueprint(AActor::StaticClass(), Package, FName(*FPackageName::GetShortName(PackageName)),
+			BPTYPE_Normal, UBlueprint::StaticClass(), UBlueprintGeneratedClass::StaticClass());
+		UEdGraph* EventGraph = Blueprint ? FBlueprintEditorUtils::FindEventGraph(Blueprint) : nullptr;
+		if (!EventGraph)
+		{
+			return Blueprint;
+		}
+
+		const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>();
+		const FName TickEventName(TEXT("ReceiveTick"));
+
+		// Actor 模板自带一个禁用的 Tick 事件，启用它；没有时再添加
+		UK2Node_Event* TickNode = FBlueprintEditorUtils::FindOverrideForFunction(Blueprint, AActor::StaticClass(), TickEventName);
+		if (!TickNode)
+		{
+			int32 NodePosY = 0;
+			TickNode = FKismetEditorUtilities::AddDefaultEventNode(Blueprint, EventGraph, TickEventName, AActor::StaticClass(), NodePosY);
+		}
+		if (!TickNode)
+		{
+			return Blueprint;
+		}
+		TickNode->SetEnabledState(ENodeEnabledState::Enabled, false);
+
+		UEdGraphPin* ExecOut = FindExecPin(TickNode, EGPD_Output, UEdGraphSchema_K2::PN_Then);
+		int32 NodePosX = TickNode->NodePosX + 300;
+		const int32 NodePosY = TickNode->NodePosY;
+
+		if (UEdGraph* ForLoopGraph = Spec.LoopDepth > 0 ? FindStandardMacro(TEXT("ForLoop")) : nullptr)
+		{
+			for (int32 Depth = 0; Depth < Spec.LoopDepth && ExecOut; ++Depth, NodePosX += 300)
+			{
+				FGraphNodeCreator<UK2Node_MacroInstance> Creator(*EventGraph);
+				UK2Node_MacroInstance* LoopNode = Creator.CreateNode(false);
+				LoopNode->SetMacroGraph(ForLoopGraph);
+				LoopNode->NodePosX = NodePosX;
+				LoopNode->NodePosY = NodePosY;
+				Creator.Finalize();
+
+				if (UEdGraphPin* FirstIndexPin = LoopNode->FindPin(TEXT("FirstIndex")))
+				{
+					Schema->TrySetDefaultValue(*FirstIndexPin, TEXT("0"));
+				}
+				if (UEdGraphPin* LastIndexPin = LoopNode->FindPin(TEXT("LastIndex")))
+				{
+					Schema->TrySetDefaultValue(*LastIndexPin, FString::FromInt(FMath::Max(Spec.LoopCount - 1, 0)));
+				}
+
+				Schema->TryCreateConnection(ExecOut, FindExecPin(LoopNode, EGPD_Input));
+				ExecOut = FindExecPin(LoopNode, EGPD_Output, TEXT("LoopBody"));
+			}
+		}
+
+		UFunction* CallFunction = AActor::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(AActor, SetActorHiddenInGame));
+		for (int32 NodeIndex = 0; NodeIndex < Spec.NumNodes && ExecOut; ++NodeIndex, NodePosX += 300)
+		{
+			UEdGraphNode* ChainNode = nullptr;
+			UEdGraphPin* NextExecOut = nullptr;
+
+			if (Spec.CastInterval > 0 && NodeIndex % Spec.CastInterval == Spec.CastInterval - 1)
+			{
+				// Tick 中的 Cast，CastAbuse 检查的目标
+				FGraphNodeCreator<UK2Node_Self> SelfCreator(*EventGraph);
+				UK2Node_Self* SelfNode = SelfCreator.CreateNode(false);
+				SelfNode->NodePosX = NodePosX;
+				SelfNode->NodePosY = NodePosY + 200;
+				SelfCreator.Finalize();
+
+				FGraphNodeCreator<UK2Node_DynamicCast> CastCreator(*EventGraph);
+				UK2Node_DynamicCast* CastNode = CastCreator.CreateNode(false);
+				CastNode->TargetType = APawn::StaticClass();
+				CastNode->NodePosX = NodePosX;
+				CastNode->NodePosY = NodePosY;
+				CastCreator.Finalize();
+
+				Schema->TryCreateConnection(SelfNode->FindPin(UEdGraphSchema_K2::PN_Self), CastNode->GetCastSourcePin());
+				ChainNode = CastNode;
+				NextExecOut = CastNode->GetValidCastPin();
+			}
+			else if (CallFunction)
+			{
+				ChainNode = AddCallNode(*EventGraph, CallFunction, NodePosX, NodePosY);
+				NextExecOut = FindExecPin(ChainNode, EGPD_Output, UEdGraphSchema_K2::PN_Then);
+			}
+
+			Schema->TryCreateConnection(ExecOut, FindExecPin(ChainNode, EGPD_Input));
+			ExecOut = NextExecOut;
+		}
+
+		for (int32 DeadIndex = 0; DeadIndex < Spec.NumDeadNodes && CallFunction; ++DeadIndex)
+		{
+			AddCallNode(*EventGraph, CallFunction, TickNode->NodePosX + DeadIndex * 300, NodePosY + 600);
+		}
+
+		FKismetEditorUtilities::CompileBlueprint(Blueprint, EBlueprintCompileOptions::SkipGarbageCollection);
+		return Blueprint;
+	}
+
+	static void DestroySyntheticBlueprints(TArray<UBlueprint*>& Blueprints)
+	{
+		for (UBlueprint* Blueprint : Blueprints)
+		{
+			if (Blueprint)
+			{
+				Blueprint->ClearFlags(RF_Public | RF_Standalone);
+			}
+		}
+		Blueprints.Empty();
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	}
+
+	/**
+	 * Signals of one synthetic Tick: Event, then NodeEntry/NodeExit for every node, then Stop.
+	 * Every node is its own context object, so each gets its own stats row.
+	 */
+	struct FSyntheticSignals
+	{
+		TArray<FScriptInstrumentationSignal> Entries;
+		TArray<FScriptInstrumentationSignal> Exits;
+		TOptional<FScriptInstrumentationSignal> Event;
+		TOptional<FScriptInstrumentationSignal> Stop;
+
+		FSyntheticSignals(UObject* Instance, UFunction* Function, TConstArrayView<UEdGraphNode*> Nodes)
+		{
+			Event.Emplace(EScriptInstrumentation::Event, Instance, Function, 0);
+			Stop.Emplace(EScriptInstrumentation::Stop, Instance, Function, 0);
+			for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); ++NodeIndex)
+			{
+				Entries.Emplace(EScriptInstrumentation::NodeEntry, Nodes[NodeIndex], Function, NodeIndex);
+				Exits.Emplace(EScriptInstrumentation::NodeExit, Nodes[NodeIndex], Function, NodeIndex);
+			}
+		}
+	};
+
+	struct FSignalRunResult
+	{
+		double SignalSeconds = 0.0;  // Inside OnScriptProfilingEvent
+		double DrainSeconds = 0.0;   // Merging the event buffers into the node stats
+		int64 NumSignals = 0;
+	};
+
+	/**
+	 * Feeds NumTicks synthetic Ticks to the profiler. NestingDepth nodes are entered before any of them exits,
+	 * which is what nested loops and function calls look like to the shadow stack. The buffers are flushed before
+	 * they can overflow; flushing is timed separately.
+	 */
+	static FSignalRunResult RunSignals(FRuntimeProfiler& Profiler, const FSyntheticSignals& Signals, int32 NumTicks, int32 NestingDepth)
+	{
+		// 每个节点在环形缓冲区中占两个事件（进入与计时），保持在每线程容量 8192 的一半以内
+		constexpr int32 FlushNodeInterval = 2048;
+
+		const int32 NumNodes = Signals.Entries.Num();
+		NestingDepth = FMath::Max(NestingDepth, 1);
+
+		FSignalRunResult Result;
+		uint64 SignalCycles = 0;
+		uint64 DrainCycles = 0;
+		int32 NodesSinceFlush = 0;
+		uint64 StartCycles = FPlatformTime::Cycles64();
+
+		for (int32 Tick = 0; Tick < NumTicks; ++Tick)
+		{
+			Profiler.OnScriptProfilingEvent(Signals.Event.GetValue());
+			for (int32 BlockStart = 0; BlockStart < NumNodes; BlockStart += NestingDepth)
+			{
+				const int32 BlockEnd = FMath::Min(BlockStart + NestingDepth, NumNodes);
+				for (int32 NodeIndex = BlockStart; NodeIndex < BlockEnd; ++NodeIndex)
+				{
+					Profiler.OnScriptProfilingEvent(Signals.Entries[NodeIndex]);
+				}
+				for (int32 NodeIndex = BlockEnd - 1; NodeIndex >= BlockStart; --NodeIndex)
+				{
+					Profiler.OnScriptProfilingEvent(Signals.Exits[NodeIndex]);
+				}
+
+				NodesSinceFlush += BlockEnd - BlockStart;
+				if (NodesSinceFlush >= FlushNodeInterval)
+				{
+					const uint64 FlushStartCycles = FPlatformTime::Cycles64();
+					SignalCycles += FlushStartCycles - StartCycles;
+					Profiler.FlushEventBuffers();
+					StartCycles = FPlatformTime::Cycles64();
+					DrainCycles += StartCycles - FlushStartCycles;
+					NodesSinceFlush = 0;
+				}
+			}
+			Profiler.OnScriptProfilingEvent(Signals.Stop.GetValue());
+		}
+
+		const uint64 EndCycles = FPlatformTime::Cycles64();
+		SignalCycles += EndCycles - StartCycles;
+		Profiler.FlushEventBuffers();
+		DrainCycles += FPlatformTime::Cycles64() - EndCycles;
+
+		Result.SignalSeconds = FPlatformTime::ToSeconds64(SignalCycles);
+		Result.DrainSeconds = FPlatformTime::ToSeconds64(DrainCycles);
+		Result.NumSignals = static_cast<int64>(NumTicks) * (2 + 2 * NumNodes);
+		return Result;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FProfilerBenchmarkInstrumentationTest, "BlueprintProfiler.Benchmark.InstrumentationOverhead",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FProfilerBenchmarkInstrumentationTest::RunTest(const FString& Parameters)
+{
+	using namespace BlueprintProfilerBenchmark;
+	static const TCHAR* Benchmark = TEXT("InstrumentationOverhead");
+	constexpr int32 NumTicks = 1000;
+	constexpr int32 DeepNestingDepth = 32;
+
+	// Heavy Tick graph: 256 chained nodes inside two nested loops
+	FSyntheticBlueprintSpec Spec;
+	Spec.NumNodes = 256;
+	Spec.LoopDepth = 2;
+	TArray<UBlueprint*> Blueprints = { CreateSyntheticBlueprint(TEXT("BP_BenchmarkTick"), Spec) };
+	UBlueprintGeneratedClass* GeneratedClass = Blueprints[0] ? Cast<UBlueprintGeneratedClass>(Blueprints[0]->GeneratedClass) : nullptr;
+	if (!TestNotNull("Synthetic Blueprint should compile", GeneratedClass) || !TestNotNull("Tick graph should have an ubergraph", GeneratedClass->UberGraphFunction.Get()))
+	{
+		DestroySyntheticBlueprints(Blueprints);
+		return false;
+	}
+
+	TArray<UEdGraphNode*> Nodes;
+	if (UEdGraph* EventGraph = FBlueprintEditorUtils::FindEventGraph(Blueprints[0]))
+	{
+		for (UEdGraphNode* Node : EventGraph->Nodes)
+		{
+			if (Node)
+			{
+				Nodes.Add(Node);
+			}
+		}
+	}
+	const FSyntheticSignals Signals(GeneratedClass->GetDefaultObject(), GeneratedClass->UberGraphFunction, Nodes);
+
+	// 基准会录制并清空单例的数据：已录制或已加载的会话不能被覆盖
+	FRuntimeProfiler& Profiler = FRuntimeProfiler::Get();
+	const bool bProfilerHoldsData = Profiler.GetExecutionData().Num() > 0 || Profiler.GetNumExecutionFrames() > 0 || Profiler.GetMemorySnapshots().Num() > 0;
+	if (!TestTrue("Benchmark needs an idle profiler", Profiler.GetRecordingState() == ERecordingState::Stopped)
+		|| !TestFalse("Benchmark must not discard a recorded or loaded session; reset the profiler first", bProfilerHoldsData))
+	{
+		DestroySyntheticBlueprints(Blueprints);
+		return false;
+	}
+
+	// 基准期间不写会话文件、不采集内存，结束后恢复用户设置
+	const bool bStreamSession = Profiler.GetStreamSessionToDisk();
+	const bool bCaptureMemory = Profiler.GetCaptureBlueprintMemory();
+	const FProfilerSamplingSettings SamplingSettings = Profiler.GetSamplingSettings();
+	Profiler.SetStreamSessionToDisk(false);
+	Profiler.SetCaptureBlueprintMemory(false);
+
+	auto Record = [&](const TCHAR* Variant, const FProfilerSamplingSettings& Sampling, int32 NestingDepth)
+	{
+		Profiler.StartRecording(FString::Printf(TEXT("Benchmark_%s"), Variant), Sampling);
+		const FSignalRunResult Result = RunSignals(Profiler, Signals, NumTicks, NestingDepth);
+
+		int64 NumExecutions = 0;
+		for (const FNodeExecutionData& Data : Profiler.GetExecutionData())
+		{
+			NumExecutions += Data.TotalExecutions;
+		}
+		const uint64 NumDropped = Profiler.GetNumDroppedEvents();
+		Profiler.StopRecording();
+		Profiler.ResetData();
+
+		const double TotalSeconds = FMath::Max(Result.SignalSeconds + Result.DrainSeconds, UE_DOUBLE_SMALL_NUMBER);
+		WriteResult(Benchmark, FString::Printf(TEXT("%s.NsPerEvent"), Variant), Result.SignalSeconds * 1e9 / Result.NumSignals, TEXT("ns"),
+			{ { TEXT("Nodes"), double(Nodes.Num()) }, { TEXT("NestingDepth"), double(NestingDepth) }, { TEXT("SamplingRate"), Sampling.GetSamplingRate() } });
+		WriteResult(Benchmark, FString::Printf(TEXT("%s.EventsPerSecond"), Variant), Result.NumSignals / TotalSeconds, TEXT("events/s"),
+			{ { TEXT("Nodes"), double(Nodes.Num()) }, { TEXT("NestingDepth"), double(NestingDepth) }, { TEXT("SamplingRate"), Sampling.GetSamplingRate() } });
+		WriteResult(Benchmark, FString::Printf(TEXT("%s.DrainShare"), Variant), Result.DrainSeconds / TotalSeconds * 100.0, TEXT("%"));
+
+		TestEqual(FString::Printf(TEXT("%s: no events should be dropped"), Variant), NumDropped, uint64(0));
+		TestTrue(FString::Printf(TEXT("%s: executions should be recorded"), Variant), NumExecutions > 0);
+		return Result;
+	};
+
+	// Stopped: the early-out every event pays while the delegate is bound
+	const FSignalRunResult Idle = RunSignals(Profiler, Signals, NumTicks, 1);
+	WriteResult(Benchmark, TEXT("Idle.NsPerEvent"), Idle.SignalSeconds * 1e9 / Idle.NumSignals, TEXT("ns"), { { TEXT("Nodes"), double(Nodes.Num()) } });
+
+	FProfilerSamplingSettings EveryNth;
+	EveryNth.Mode = ESamplingMode::EveryNth;
+	EveryNth.SampleInterval = 10;
+	Record(TEXT("Sampled"), EveryNth, 1);
+	Record(TEXT("DeepNesting"), FProfilerSamplingSettings(), DeepNestingDepth);
+	const FSignalRunResult Full = Record(TEXT("Full"), FProfilerSamplingSettings(), 1);
+	WriteResult(Benchmark, TEXT("Full.OverheadNsPerEvent"), (Full.SignalSeconds - Idle.SignalSeconds) * 1e9 / Full.NumSignals, TEXT("ns"));
+
+	Profiler.SetStreamSessionToDisk(bStreamSession);
+	Profiler.SetCaptureBlueprintMemory(bCaptureMemory);
+	Profiler.SetSamplingSettings(SamplingSettings);
+	DestroySyntheticBlueprints(Blueprints);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FProfilerBenchmarkScanTest, "BlueprintProfiler.Benchmark.ScanThroughput",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FProfilerBenchmarkScanTest::RunTest(const FString& Parameters)
+{
+	using namespace BlueprintProfilerBenchmark;
+	static const TCHAR* Benchmark = TEXT("ScanThroughput");
+	constexpr int32 NumBlueprints = 64;
+	constexpr int32 NumRuns = 3;
+
+	// Mixed sizes, so the cost-ordered work queue has something to balance
+	TArray<UBlueprint*> Blueprints;
+	for (int32 BlueprintIndex = 0; BlueprintIndex < NumBlueprints; ++BlueprintIndex)
+	{
+		FSyntheticBlueprintSpec Spec;
+		Spec.NumNodes = 50 + (BlueprintIndex % 8) * 50;
+		Spec.LoopDepth = BlueprintIndex % 3;
+		Spec.NumDeadNodes = 4;
+		Blueprints.Add(CreateSyntheticBlueprint(TEXT("BP_BenchmarkScan"), Spec));
+	}
+
+	// 快照在游戏线程上生成，与工作线程数无关，单独计时
+	TArray<FLintScanItem> Items;
+	int32 NumNodes = 0;
+	const double SnapshotSeconds = BestOf(1, [&]()
+	{
+		for (UBlueprint* Blueprint : Blueprints)
+		{
+			if (!Blueprint)
+			{
+				continue;
+			}
+			TSharedRef<FBlueprintLintSnapshot> Snapshot = MakeShared<FBlueprintLintSnapshot>(FBlueprintLintSnapshot::Build(Blueprint));
+			for (const FLintGraphSnapshot& Graph : Snapshot->Graphs)
+			{
+				NumNodes += Graph.Nodes.Num();
+			}
+
+			FLintScanItem& Item = Items.AddDefaulted_GetRef();
+			Item.PackageName = Blueprint->GetPackage()->GetFName();
+			Item.EstimatedCost = static_cast<float>(Snapshot->Graphs.Num() > 0 ? Snapshot->Graphs[0].Nodes.Num() : 0);
+			Item.Snapshot = Snapshot;
+		}
+	});
+	if (!TestEqual("Every synthetic Blueprint should be snapshotted", Items.Num(), NumBlueprints))
+	{
+		DestroySyntheticBlueprints(Blueprints);
+		return false;
+	}
+	WriteResult(Benchmark, TEXT("Snapshot.AssetsPerSecond"), Items.Num() / FMath::Max(SnapshotSeconds, UE_DOUBLE_SMALL_NUMBER), TEXT("assets/s"),
+		{ { TEXT("Assets"), double(Items.Num()) }, { TEXT("Nodes"), double(NumNodes) } });
+
+	TSharedPtr<FStaticLinter> Linter = MakeShared<FStaticLinter>();
+	double SingleWorkerSeconds = 0.0;
+	for (const int32 NumWorkers : { 1, 4, 16 })
+	{
+		FScanConfiguration Config;
+		Config.bUseMultiThreading = NumWorkers > 1;
+		Config.MaxConcurrentTasks = NumWorkers;
+		Config.bUseCache = false;
+
+		int32 NumIssues = 0;
+		const double Seconds = BestOf(NumRuns, [&]()
+		{
+			// Inline 模式在本线程上依次运行各批次，批内仍按 MaxConcurrentTasks 并行
+			FScanTask Task(Linter, Config, true);
+			FLintReferenceIndex ReferenceIndex;
+			for (const FLintScanItem& Item : Items)
+			{
+				ReferenceIndex.SetCallSites(Item.PackageName, FLintCallSites::Collect(*Item.Snapshot));
+			}
+			Task.AddSnapshots(CopyTemp(Items));
+			Task.Finish(MoveTemp(ReferenceIndex));
+			Task.Wait();
+
+			NumIssues = 0;
+			TArray<FLintIssue> Issues;
+			while (Task.DequeueIssueBatch(Issues))
+			{
+				NumIssues += Issues.Num();
+			}
+		});
+
+		if (NumWorkers == 1)
+		{
+			SingleWorkerSeconds = Seconds;
+		}
+		TestTrue(FString::Printf(TEXT("Scan with %d workers should find the synthetic issues"), NumWorkers), NumIssues > 0);
+		WriteResult(Benchmark, TEXT("Analysis.AssetsPerSecond"), Items.Num() / FMath::Max(Seconds, UE_DOUBLE_SMALL_NUMBER), TEXT("assets/s"),
+			{ { TEXT("Workers"), double(NumWorkers) }, { TEXT("Assets"), double(Items.Num()) }, { TEXT("Nodes"), double(NumNodes) } });
+		WriteResult(Benchmark, TEXT("Analysis.Speedup"), SingleWorkerSeconds / FMath::Max(Seconds, UE_DOUBLE_SMALL_NUMBER), TEXT("x"),
+			{ { TEXT("Workers"), double(NumWorkers) } });
+	}
+
+	Items.Empty();
+	DestroySyntheticBlueprints(Blueprints);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FProfilerBenchmarkReferenceCountTest, "BlueprintProfiler.Benchmark.ReferenceCounts",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FProfilerBenchmarkReferenceCountTest::RunTest(const FString& Parameters)
+{
+	using namespace BlueprintProfilerBenchmark;
+	static const TCHAR* Benchmark = TEXT("ReferenceCounts");
+	constexpr int32 NumHardPerPackage = 4;
+	constexpr int32 NumRuns = 3;
+
+	for (const int32 NumPackages : { 1000, 10000, 100000 })
+	{
+		// 固定种子，同一规模每次生成相同的图；依赖偏向编号靠后的包，形成类似项目的分层结构
+		FRandomStream Random(NumPackages);
+		TArray<FName> PackageNames;
+		TArray<TArray<int32>> HardDependencies;
+		TArray<TArray<int32>> SoftDependencies;
+		TArray<int64> PackageSizes;
+		PackageNames.Reserve(NumPackages);
+		HardDependencies.SetNum(NumPackages);
+		SoftDependencies.SetNum(NumPackages);
+		PackageSizes.Reserve(NumPackages);
+
+		for (int32 PackageIndex = 0; PackageIndex < NumPackages; ++PackageIndex)
+		{
+			PackageNames.Add(FName(*FString::Printf(TEXT("/Game/Benchmark/Package_%d"), PackageIndex)));
+			PackageSizes.Add(Random.RandRange(1, 4 << 20));
+			if (PackageIndex + 1 >= NumPackages)
+			{
+				continue;
+			}
+			for (int32 Edge = 0; Edge < NumHardPerPackage; ++Edge)
+			{
+				HardDependencies[PackageIndex].Add(Random.RandRange(PackageIndex + 1, NumPackages - 1));
+			}
+			SoftDependencies[PackageIndex].Add(Random.RandRange(0, NumPackages - 1));
+		}
+
+		TSharedRef<FAssetDependencyGraph> Graph = MakeShared<FAssetDependencyGraph>();
+		const double BuildSeconds = BestOf(1, [&]()
+		{
+			Graph->BuildFromAdjacency(MoveTemp(PackageNames), HardDependencies, SoftDependencies);
+		});
+
+		int32 NumCounts = 0;
+		const double CountSeconds = BestOf(NumRuns, [&]()
+		{
+			NumCounts = FMemoryAnalyzer::ComputeReferenceCounts(*Graph).Num();
+		});
+		TestEqual(FString::Printf(TEXT("%d packages: one count per package"), NumPackages), NumCounts, NumPackages);
+
+		const double DominatorSeconds = BestOf(NumRuns, [&]()
+		{
+			FAssetDominatorTree DominatorTree;
+			DominatorTree.Build(Graph, CopyTemp(PackageSizes));
+		});
+
+		WriteResult(Benchmark, TEXT("BuildGraph.Ms"), BuildSeconds * 1000.0, TEXT("ms"),
+			{ { TEXT("Packages"), double(NumPackages) }, { TEXT("Edges"), double(Graph->NumEdges()) } });
+		WriteResult(Benchmark, TEXT("ComputeReferenceCounts.Ms"), CountSeconds * 1000.0, TEXT("ms"),
+			{ { TEXT("Packages"), double(NumPackages) }, { TEXT("Edges"), double(Graph->NumEdges()) } });
+		WriteResult(Benchmark, TEXT("DominatorTree.Ms"), DominatorSeconds * 1000.0, TEXT("ms"),
+			{ { TEXT("Packages"), double(NumPackages) }, { TEXT("Edges"), double(Graph->NumEdges()) } });
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FProfilerBenchmarkUIRefreshTest, "BlueprintProfiler.Benchmark.UIRefresh",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FProfilerBenchmarkUIRefreshTest::RunTest(const FString& Parameters)
+{
+	using namespace BlueprintProfilerBenchmark;
+	static const TCHAR* Benchmark = TEXT("UIRefresh");
+	constexpr int32 NumRuns = 3;
+
+	for (const int32 NumRows : { 1000, 10000, 100000 })
+	{
+		TArray<FNodeExecutionData> RuntimeData;
+		RuntimeData.SetNum(NumRows);
+		for (int32 RowIndex = 0; RowIndex < NumRows; ++RowIndex)
+		{
+			FNodeExecutionData& Data = RuntimeData[RowIndex];
+			Data.NodeName = FString::Printf(TEXT("Node_%d"), RowIndex);
+			Data.BlueprintName = FString::Printf(TEXT("BP_Benchmark_%d"), RowIndex % 100);
+			Data.NodeGuid = FGuid(RowIndex, NumRows, 0x42, 0x7);
+			Data.TotalExecutions = 1 + RowIndex % 1000;
+			Data.AverageExecutionsPerSecond = static_cast<float>(Data.TotalExecutions) / 10.0f;
+			Data.AverageExecutionTime = 0.001f * (1 + RowIndex % 50);
+		}
+
+		TSharedRef<SBlueprintProfilerWidget> Widget = SNew(SBlueprintProfilerWidget);
+
+		// First fill builds every row; an unchanged refresh only hashes; a live-view sized patch changes 1%
+		const double FillSeconds = BestOf(1, [&]() { Widget->SetRuntimeData(RuntimeData); });
+		const double UnchangedSeconds = BestOf(NumRuns, [&]() { Widget->SetRuntimeData(RuntimeData); });
+		int32 Pass = 0;
+		const double PatchSeconds = BestOf(NumRuns, [&]()
+		{
+			++Pass;
+			for (int32 RowIndex = 0; RowIndex < NumRows; RowIndex += 100)
+			{
+				RuntimeData[RowIndex].TotalExecutions += Pass;
+			}
+			Widget->SetRuntimeData(RuntimeData);
+		});
+
+		WriteResult(Benchmark, TEXT("Fill.Ms"), FillSeconds * 1000.0, TEXT("ms"), { { TEXT("Rows"), double(NumRows) } });
+		WriteResult(Benchmark, TEXT("Unchanged.Ms"), UnchangedSeconds * 1000.0, TEXT("ms"), { { TEXT("Rows"), double(NumRows) } });
+		WriteResult(Benchmark, TEXT("Patch.Ms"), PatchSeconds * 1000.0, TEXT("ms"), { { TEXT("Rows"), double(NumRows) }, { TEXT("ChangedRows"), double(NumRows / 100) } });
+	}
+
+	return true;
+}
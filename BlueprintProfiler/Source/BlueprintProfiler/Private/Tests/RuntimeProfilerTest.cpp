@@ -3,10 +3,141 @@
 #include "CoreMinimal.h"
 #include "Misc/AutomationTest.h"
 #include "Analyzers/RuntimeProfiler.h"
+#include "Analyzers/BlueprintProfilerTrace.h"
 #include "Engine/Blueprint.h"
+#include "Engine/BlueprintGeneratedClass.h"
 #include "Engine/World.h"
+#include "EdGraphSchema_K2.h"
 #include "GameFramework/Actor.h"
+#include "GameFramework/Pawn.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_Event.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet2/KismetEditorUtilities.h"
 #include "Tests/AutomationCommon.h"
+#include "Data/ProfilerSessionFile.h"
+#include "Analyzers/SessionComparison.h"
+#include "HAL/FileManager.h"
+#include "HAL/Thread.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "UObject/Script.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace BlueprintProfilerRuntimeTest
+{
+	/** Records on the profiler singleton without memory capture, and by default without a session file; the user's settings are restored afterwards */
+	struct FScopedTestRecording
+	{
+		FRuntimeProfiler& Profiler;
+		const bool bStreamSession;
+		const bool bCaptureMemory;
+		const FProfilerSamplingSettings SamplingSettings;
+
+		explicit FScopedTestRecording(const TCHAR* SessionName, bool bStreamToDisk = false)
+			: Profiler(FRuntimeProfiler::Get())
+			, bStreamSession(Profiler.GetStreamSessionToDisk())
+			, bCaptureMemory(Profiler.GetCaptureBlueprintMemory())
+			, SamplingSettings(Profiler.GetSamplingSettings())
+		{
+			Profiler.SetStreamSessionToDisk(bStreamToDisk);
+			Profiler.SetCaptureBlueprintMemory(false);
+			Profiler.StartRecording(SessionName, FProfilerSamplingSettings());
+		}
+
+		~FScopedTestRecording()
+		{
+			Profiler.StopRecording();
+			Profiler.ResetData();
+			Profiler.SetStreamSessionToDisk(bStreamSession);
+			Profiler.SetCaptureBlueprintMemory(bCaptureMemory);
+			Profiler.SetSamplingSettings(SamplingSettings);
+		}
+	};
+
+	/** Busy-waits, so a synthetic node has a known minimum duration */
+	static void SpinFor(double Seconds)
+	{
+		const double EndTime = FPlatformTime::Seconds() + Seconds;
+		while (FPlatformTime::Seconds() < EndTime)
+		{
+		}
+	}
+
+	/** Actor Blueprint whose BeginPlay makes one call, compiled in a /Temp package that is never saved */
+	static UBlueprint* CreateTestBlueprint(const TCHAR* Name, UK2Node_CallFunction*& OutCallNode)
+	{
+		static int32 Serial = 0;
+		const FString PackageName = FString::Printf(TEXT("/Temp/BlueprintProfilerTest/%s_%d"), Name, ++Serial);
+		UPackage* Package = CreatePackage(*PackageName);
+		UBlueprint* Blueprint = FKismetEditorUtilities::CreateBlueprint(AActor::StaticClass(), Package, FName(*FPackageName::GetShortName(PackageName)),
+			BPTYPE_Normal, UBlueprint::StaticClass(), UBlueprintGeneratedClass::StaticClass());
+		UEdGraph* EventGraph = Blueprint ? FBlueprintEditorUtils::FindEventGraph(Blueprint) : nullptr;
+		if (!EventGraph)
+		{
+			return Blueprint;
+		}
+
+		// Actor 模板自带一个禁用的 BeginPlay 事件，启用它；没有时再添加
+		const FName BeginPlayEventName(TEXT("ReceiveBeginPlay"));
+		UK2Node_Event* BeginPlayNode = FBlueprintEditorUtils::FindOverrideForFunction(Blueprint, AActor::StaticClass(), BeginPlayEventName);
+		if (!BeginPlayNode)
+		{
+			int32 NodePosY = 0;
+			BeginPlayNode = FKismetEditorUtilities::AddDefaultEventNode(Blueprint, EventGraph, BeginPlayEventName, AActor::StaticClass(), NodePosY);
+		}
+		if (!BeginPlayNode)
+		{
+			return Blueprint;
+		}
+		BeginPlayNode->SetEnabledState(ENodeEnabledState::Enabled, false);
+
+		FGraphNodeCreator<UK2Node_CallFunction> Creator(*EventGraph);
+		OutCallNode = Creator.CreateNode(false);
+		OutCallNode->SetFromFunction(AActor::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(AActor, SetActorHiddenInGame)));
+		OutCallNode->NodePosX = BeginPlayNode->NodePosX + 300;
+		OutCallNode->NodePosY = BeginPlayNode->NodePosY;
+		Creator.Finalize();
+
+		GetDefault<UEdGraphSchema_K2>()->TryCreateConnection(BeginPlayNode->FindPin(UEdGraphSchema_K2::PN_Then), OutCallNode->GetExecPin());
+		FKismetEditorUtilities::CompileBlueprint(Blueprint, EBlueprintCompileOptions::SkipGarbageCollection);
+		return Blueprint;
+	}
+
+	static void DestroyTestBlueprint(UBlueprint* Blueprint)
+	{
+		if (Blueprint)
+		{
+			Blueprint->ClearFlags(RF_Public | RF_Standalone);
+		}
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	}
+
+	/** A code offset the debug data maps exactly to the node, and a later one inside its code that only an imprecise search finds */
+	static bool FindNodeCodeOffsets(UBlueprintGeneratedClass& GeneratedClass, UFunction* Function, const UEdGraphNode* Node, int32& OutPreciseOffset, int32& OutImpreciseOffset)
+	{
+		OutPreciseOffset = INDEX_NONE;
+		OutImpreciseOffset = INDEX_NONE;
+		for (int32 CodeOffset = 0; CodeOffset < Function->Script.Num() && OutImpreciseOffset == INDEX_NONE; ++CodeOffset)
+		{
+			const UEdGraphNode* PreciseNode = GeneratedClass.DebugData.FindSourceNodeFromCodeLocation(Function, CodeOffset, false);
+			if (OutPreciseOffset == INDEX_NONE)
+			{
+				OutPreciseOffset = PreciseNode == Node ? CodeOffset : INDEX_NONE;
+			}
+			else if (!PreciseNode && GeneratedClass.DebugData.FindSourceNodeFromCodeLocation(Function, CodeOffset, true) == Node)
+			{
+				OutImpreciseOffset = CodeOffset;
+			}
+		}
+		return OutImpreciseOffset != INDEX_NONE;
+	}
+
+	static const FNodeExecutionData* FindExecutionData(const TArray<FNodeExecutionData>& ExecutionData, const UObject* Object)
+	{
+		return ExecutionData.FindByPredicate([Object](const FNodeExecutionData& Data) { return Data.BlueprintObject.Get() == Object; });
+	}
+}
 
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRuntimeProfilerBasicTest, "BlueprintProfiler.RuntimeProfiler.BasicFunctionality",
 	EAutomationTestFlags::ProductFilter | EAutomationTestFlags::EditorContext)
@@ -74,4 +205,908 @@ bool FRuntimeProfilerHotNodeDetectionTest::RunTest(const FString& Parameters)
 	TestTrue("Lower threshold should return more results", HotNodes500.Num() >= HotNodes1000.Num());
 
 	return true;
-}
\ No newline at end of file
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRuntimeProfilerExecutionTimingTest, "BlueprintProfiler.RuntimeProfiler.ExecutionTiming",
+	EAutomationTestFlags::ProductFilter | EAutomationTestFlags::EditorContext)
+
+bool FRuntimeProfilerExecutionTimingTest::RunTest(const FString& Parameters)
+{
+	// Averages are taken over paired (timed) executions, not raw entry count
+	FNodeExecutionStats Stats;
+	Stats.ExecutionCount = 4;
+	Stats.TimedExecutionCount = 2;
+	Stats.TotalExecutionTime = 0.004f;
+
+	const uint64 OneMillisecondCycles = static_cast<uint64>(0.001 / FPlatformTime::GetSecondsPerCycle64());
+	Stats.InclusiveCycles = 4 * OneMillisecondCycles;
+	Stats.ExclusiveCycles = 2 * OneMillisecondCycles;
+
+	TestEqual("Average inclusive time should use timed executions", Stats.GetAverageExecutionTime(), 0.002f, 1e-6f);
+	TestEqual("Total exclusive time should be converted from cycles", Stats.GetTotalExclusiveTime(), 0.002f, 1e-5f);
+	TestEqual("Average exclusive time should use timed executions", Stats.GetAverageExclusiveTime(), 0.001f, 1e-5f);
+
+	// Without any paired exit there is no timed execution to average over, so the average is zero
+	FNodeExecutionStats UntimedStats;
+	UntimedStats.ExecutionCount = 2;
+	TestEqual("Untimed stats should report zero average", UntimedStats.GetAverageExecutionTime(), 0.0f);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRuntimeProfilerNestedTimingTest, "BlueprintProfiler.RuntimeProfiler.NestedTiming",
+	EAutomationTestFlags::ProductFilter | EAutomationTestFlags::EditorContext)
+
+bool FRuntimeProfilerNestedTimingTest::RunTest(const FString& Parameters)
+{
+	using namespace BlueprintProfilerRuntimeTest;
+	if (!TestTrue("Test needs an idle profiler", FRuntimeProfiler::Get().GetRecordingState() == ERecordingState::Stopped))
+	{
+		return false;
+	}
+
+	// Each context object gets its own stats row: Parent runs Child, and Child evaluates a pure node before it exits
+	UObject* Parent = AActor::StaticClass();
+	UObject* Child = APawn::StaticClass();
+	UObject* Pure = UObject::StaticClass();
+	UFunction* Function = AActor::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(AActor, SetActorHiddenInGame));
+
+	FScopedTestRecording Recording(TEXT("NestedTimingTest"));
+	FRuntimeProfiler& Profiler = Recording.Profiler;
+	Profiler.OnScriptProfilingEvent(FScriptInstrumentationSignal(EScriptInstrumentation::Event, Parent, Function, 0));
+	Profiler.OnScriptProfilingEvent(FScriptInstrumentationSignal(EScriptInstrumentation::NodeEntry, Parent, Function, 0));
+	SpinFor(0.001);
+	Profiler.OnScriptProfilingEvent(FScriptInstrumentationSignal(EScriptInstrumentation::NodeEntry, Child, Function, 1));
+	SpinFor(0.002);
+	Profiler.OnScriptProfilingEvent(FScriptInstrumentationSignal(EScriptInstrumentation::PureNodeEntry, Pure, Function, 2));
+	SpinFor(0.001);
+	// 纯节点没有退出事件，由 Child 的 NodeExit 一并关闭；PopState 回到 Parent 并关闭它
+	Profiler.OnScriptProfilingEvent(FScriptInstrumentationSignal(EScriptInstrumentation::NodeExit, Child, Function, 1));
+	SpinFor(0.001);
+	Profiler.OnScriptProfilingEvent(FScriptInstrumentationSignal(EScriptInstrumentation::PopState, Parent, Function, 0));
+	Profiler.OnScriptProfilingEvent(FScriptInstrumentationSignal(EScriptInstrumentation::Stop, Parent, Function, 0));
+	Profiler.FlushEventBuffers();
+
+	const TArray<FNodeExecutionData> ExecutionData = Profiler.GetExecutionData();
+	const FNodeExecutionData* ParentData = FindExecutionData(ExecutionData, Parent);
+	const FNodeExecutionData* ChildData = FindExecutionData(ExecutionData, Child);
+	const FNodeExecutionData* PureData = FindExecutionData(ExecutionData, Pure);
+	if (!TestTrue("Every node should have a stats row", ParentData && ChildData && PureData))
+	{
+		return false;
+	}
+
+	for (const FNodeExecutionData* Data : { ParentData, ChildData, PureData })
+	{
+		TestEqual(FString::Printf(TEXT("%s should run once"), *Data->NodeName), Data->TotalExecutions, 1);
+		TestTrue(FString::Printf(TEXT("%s inclusive time should not be below its exclusive time"), *Data->NodeName),
+			Data->TotalExecutionTime >= Data->TotalExclusiveTime);
+	}
+
+	TestTrue("Pure node should last until the next event", PureData->TotalExecutionTime >= 0.001f);
+	TestEqual("Pure node without children should be all exclusive", PureData->TotalExclusiveTime, PureData->TotalExecutionTime, 1e-6f);
+	TestTrue("Child time should include the pure node", ChildData->TotalExecutionTime >= 0.003f);
+	TestEqual("Pure node time should be subtracted from the child",
+		ChildData->TotalExclusiveTime, ChildData->TotalExecutionTime - PureData->TotalExecutionTime, 1e-6f);
+	TestTrue("Parent time should include the child", ParentData->TotalExecutionTime >= 0.005f);
+	TestEqual("Child time should be subtracted from the parent",
+		ParentData->TotalExclusiveTime, ParentData->TotalExecutionTime - ChildData->TotalExecutionTime, 1e-6f);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRuntimeProfilerExecutionHistogramTest, "BlueprintProfiler.RuntimeProfiler.ExecutionHistogram",
+	EAutomationTestFlags::ProductFilter | EAutomationTestFlags::EditorContext)
+
+bool FRuntimeProfilerExecutionHistogramTest::RunTest(const FString& Parameters)
+{
+	// Sample ring keeps only the latest samples, oldest first
+	FExecutionSampleRing Ring;
+	for (int32 Index = 0; Index < FExecutionSampleRing::Capacity + 10; ++Index)
+	{
+		Ring.Add(static_cast<float>(Index));
+	}
+	TestEqual("Ring should be capped at capacity", Ring.Num(), FExecutionSampleRing::Capacity);
+	TestEqual("Oldest sample should be the first one not overwritten", Ring[0], 10.0f);
+	TestEqual("Newest sample should be last", Ring[Ring.Num() - 1], static_cast<float>(FExecutionSampleRing::Capacity + 9));
+
+	// Bucket bounds are contiguous and monotonic
+	for (int32 BucketIndex = 1; BucketIndex < FExecutionTimeHistogram::BucketCount; ++BucketIndex)
+	{
+		const uint64 LowerBound = FExecutionTimeHistogram::GetBucketUpperBound(BucketIndex - 1) + 1;
+		if (FExecutionTimeHistogram::GetBucketIndex(LowerBound) != BucketIndex)
+		{
+			AddError(FString::Printf(TEXT("Bucket %d does not start right after bucket %d"), BucketIndex, BucketIndex - 1));
+			break;
+		}
+	}
+
+	// 90 fast samples (10us) and 10 slow samples (1ms)
+	FNodeExecutionStats Stats;
+	for (int32 Index = 0; Index < 90; ++Index)
+	{
+		Stats.AddExecutionTime(0.00001f);
+	}
+	for (int32 Index = 0; Index < 10; ++Index)
+	{
+		Stats.AddExecutionTime(0.001f);
+	}
+
+	const float P50 = Stats.GetPercentileExecutionTime(50.0f);
+	const float P95 = Stats.GetPercentileExecutionTime(95.0f);
+	TestTrue("p50 should be close to the fast sample", P50 >= 0.00001f && P50 <= 0.00001f * 1.25f);
+	TestTrue("p95 should be close to the slow sample", P95 >= 0.001f && P95 <= 0.001f * 1.25f);
+	TestEqual("Min should be the fast sample", Stats.MinExecutionTime, 0.00001f);
+	TestEqual("Max should be the slow sample", Stats.MaxExecutionTime, 0.001f);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRuntimeProfilerNodeStatsTableTest, "BlueprintProfiler.RuntimeProfiler.NodeStatsTable",
+	EAutomationTestFlags::ProductFilter | EAutomationTestFlags::EditorContext)
+
+bool FRuntimeProfilerNodeStatsTableTest::RunTest(const FString& Parameters)
+{
+	FNodeStatsTable Table;
+
+	// IDs are dense and stable per object
+	const uint32 FirstId = Table.Intern(GetTransientPackage());
+	const uint32 SecondId = Table.Intern(UObject::StaticClass());
+	TestEqual("First interned object should get ID 0", FirstId, 0u);
+	TestEqual("Second interned object should get ID 1", SecondId, 1u);
+	TestEqual("Interning the same object again should return the same ID", Table.Intern(GetTransientPackage()), FirstId);
+	TestEqual("Find should return the interned ID", Table.Find(UObject::StaticClass()), SecondId);
+	TestEqual("Unknown objects should not be found", Table.Find(UPackage::StaticClass()), FNodeStatsTable::InvalidId);
+
+	// Counters are kept per ID
+	Table.AddExecution(SecondId);
+	Table.AddExecution(SecondId);
+	Table.AddExecutionTime(SecondId, 0.002f);
+	TestEqual("Execution count should be tracked per ID", Table.GetExecutionCount(SecondId), 2);
+	TestEqual("Other IDs should be untouched", Table.GetExecutionCount(FirstId), 0);
+	TestEqual("Materialized stats should match the table", Table.GetStats(SecondId).MaxExecutionTime, 0.002f);
+
+	// Names stay empty until resolved
+	TestFalse("Names should be resolved lazily", Table.HasNodeInfo(SecondId));
+
+	Table.Reset();
+	TestEqual("Reset should drop all IDs", Table.Num(), 0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRuntimeProfilerEventBufferOverflowTest, "BlueprintProfiler.RuntimeProfiler.EventBufferOverflow",
+	EAutomationTestFlags::ProductFilter | EAutomationTestFlags::EditorContext)
+
+bool FRuntimeProfilerEventBufferOverflowTest::RunTest(const FString& Parameters)
+{
+	using namespace BlueprintProfilerRuntimeTest;
+	if (!TestTrue("Test needs an idle profiler", FRuntimeProfiler::Get().GetRecordingState() == ERecordingState::Stopped))
+	{
+		return false;
+	}
+
+	UObject* Node = AActor::StaticClass();
+	UFunction* Function = AActor::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(AActor, SetActorHiddenInGame));
+	const FScriptInstrumentationSignal Entry(EScriptInstrumentation::NodeEntry, Node, Function, 0);
+	const FScriptInstrumentationSignal Exit(EScriptInstrumentation::NodeExit, Node, Function, 0);
+
+	// 每次执行写入两个事件（进入与计时），不 drain 时缓冲区在一半执行后写满，其余事件全部丢弃
+	constexpr int32 NumExecutions = FRuntimeProfiler::EventBufferCapacity;
+	FScopedTestRecording Recording(TEXT("EventBufferOverflowTest"));
+	FRuntimeProfiler& Profiler = Recording.Profiler;
+	for (int32 Execution = 0; Execution < NumExecutions; ++Execution)
+	{
+		Profiler.OnScriptProfilingEvent(Entry);
+		Profiler.OnScriptProfilingEvent(Exit);
+	}
+	TestEqual("Drops should be counted by the drain", Profiler.GetNumDroppedEvents(), uint64(0));
+	Profiler.FlushEventBuffers();
+
+	TestEqual("Every event past the capacity should be dropped", Profiler.GetNumDroppedEvents(), uint64(FRuntimeProfiler::EventBufferCapacity));
+	const TArray<FNodeExecutionData> ExecutionData = Profiler.GetExecutionData();
+	const FNodeExecutionData* Data = FindExecutionData(ExecutionData, Node);
+	if (TestNotNull("Buffered executions should be recorded", Data))
+	{
+		TestEqual("Only the buffered executions should be counted", Data->TotalExecutions, NumExecutions / 2);
+	}
+
+	// 缓冲区 drain 之后重新可用
+	Profiler.OnScriptProfilingEvent(Entry);
+	Profiler.OnScriptProfilingEvent(Exit);
+	Profiler.FlushEventBuffers();
+	TestEqual("A drained buffer should accept events again", Profiler.GetNumDroppedEvents(), uint64(FRuntimeProfiler::EventBufferCapacity));
+	const TArray<FNodeExecutionData> DrainedData = Profiler.GetExecutionData();
+	Data = FindExecutionData(DrainedData, Node);
+	if (TestNotNull("Node should still be recorded", Data))
+	{
+		TestEqual("The execution after the drain should be counted", Data->TotalExecutions, NumExecutions / 2 + 1);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRuntimeProfilerEventBufferThreadExitTest, "BlueprintProfiler.RuntimeProfiler.EventBufferThreadExit",
+	EAutomationTestFlags::ProductFilter | EAutomationTestFlags::EditorContext)
+
+bool FRuntimeProfilerEventBufferThreadExitTest::RunTest(const FString& Parameters)
+{
+	using namespace BlueprintProfilerRuntimeTest;
+	if (!TestTrue("Test needs an idle profiler", FRuntimeProfiler::Get().GetRecordingState() == ERecordingState::Stopped))
+	{
+		return false;
+	}
+
+	UObject* Node = APawn::StaticClass();
+	UFunction* Function = AActor::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(AActor, SetActorHiddenInGame));
+
+	FScopedTestRecording Recording(TEXT("EventBufferThreadExitTest"));
+	FRuntimeProfiler& Profiler = Recording.Profiler;
+	const int32 NumBuffersBefore = Profiler.GetNumEventBuffers();
+
+	// 脚本在一个随后退出的线程上执行：缓冲区在线程退出后仍保留，直到下一次 drain 读完
+	FThread ScriptThread(TEXT("BlueprintProfilerScriptTest"), [&Profiler, Node, Function]()
+	{
+		Profiler.OnScriptProfilingEvent(FScriptInstrumentationSignal(EScriptInstrumentation::NodeEntry, Node, Function, 0));
+		Profiler.OnScriptProfilingEvent(FScriptInstrumentationSignal(EScriptInstrumentation::NodeExit, Node, Function, 0));
+	});
+	ScriptThread.Join();
+
+	TestEqual("The exited thread's buffer should wait for the drain", Profiler.GetNumEventBuffers(), NumBuffersBefore + 1);
+	Profiler.FlushEventBuffers();
+	TestEqual("The drain should free the exited thread's buffer", Profiler.GetNumEventBuffers(), NumBuffersBefore);
+
+	const TArray<FNodeExecutionData> ExecutionData = Profiler.GetExecutionData();
+	const FNodeExecutionData* Data = FindExecutionData(ExecutionData, Node);
+	if (TestNotNull("Events of the exited thread should be recorded", Data))
+	{
+		TestEqual("The thread's execution should be counted", Data->TotalExecutions, 1);
+	}
+	TestEqual("No events should be dropped", Profiler.GetNumDroppedEvents(), uint64(0));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRuntimeProfilerCodeOffsetLookupTest, "BlueprintProfiler.RuntimeProfiler.CodeOffsetLookup",
+	EAutomationTestFlags::ProductFilter | EAutomationTestFlags::EditorContext)
+
+bool FRuntimeProfilerCodeOffsetLookupTest::RunTest(const FString& Parameters)
+{
+	using namespace BlueprintProfilerRuntimeTest;
+	if (!TestTrue("Test needs an idle profiler", FRuntimeProfiler::Get().GetRecordingState() == ERecordingState::Stopped))
+	{
+		return false;
+	}
+
+	UK2Node_CallFunction* CallNode = nullptr;
+	UBlueprint* Blueprint = CreateTestBlueprint(TEXT("BP_CodeOffsetLookup"), CallNode);
+	UBlueprintGeneratedClass* GeneratedClass = Blueprint ? Cast<UBlueprintGeneratedClass>(Blueprint->GeneratedClass) : nullptr;
+	UFunction* Function = GeneratedClass ? GeneratedClass->UberGraphFunction.Get() : nullptr;
+	int32 PreciseOffset = INDEX_NONE;
+	int32 ImpreciseOffset = INDEX_NONE;
+	if (!TestNotNull("Test Blueprint should compile an ubergraph", Function)
+		|| !TestTrue("Call node should have debug data", FindNodeCodeOffsets(*GeneratedClass, Function, CallNode, PreciseOffset, ImpreciseOffset)))
+	{
+		DestroyTestBlueprint(Blueprint);
+		return false;
+	}
+
+	{
+		FScopedTestRecording Recording(TEXT("CodeOffsetLookupTest"));
+		FRuntimeProfiler& Profiler = Recording.Profiler;
+		const UObject* ActiveObject = GeneratedClass->GetDefaultObject();
+		uint32 NodeId = FNodeStatsTable::InvalidId;
+		TWeakObjectPtr<UObject> NodeKey;
+
+		// 未建立追踪点：没有偏移表，走调试数据搜索，节点由 drain 分配 ID
+		TestTrue("Untraced offset should resolve through the debug data", Profiler.ResolveTracepointNode(ActiveObject, Function, PreciseOffset, NodeId, NodeKey));
+		TestEqual("Untraced node should have no dense ID", NodeId, FNodeStatsTable::InvalidId);
+		TestTrue("Untraced node should be handed to the drain", NodeKey.Get() == CallNode);
+
+		// 建立追踪点后偏移表在下一次 drain 时发布
+		Profiler.SetupBlueprintTracepoints(Blueprint);
+		Profiler.FlushEventBuffers();
+
+		TestTrue("Exact offset should resolve from the offset table", Profiler.ResolveTracepointNode(ActiveObject, Function, PreciseOffset, NodeId, NodeKey));
+		const uint32 TracedNodeId = NodeId;
+		TestNotEqual("Offset table should hold the node's dense ID", TracedNodeId, FNodeStatsTable::InvalidId);
+		TestFalse("Offset table hits should not need interning", NodeKey.IsValid());
+
+		// 表中只有精确偏移，其他偏移回退到不精确搜索，仍得到同一个节点
+		TestTrue("Inexact offset should fall back to the debug data", Profiler.ResolveTracepointNode(ActiveObject, Function, ImpreciseOffset, NodeId, NodeKey));
+		TestEqual("Fallback should find the same node", NodeId, TracedNodeId);
+		TestFalse("Fallback should reuse the tracepoint ID", NodeKey.IsValid());
+
+		// 移除追踪点立即发布，偏移表不再命中
+		Profiler.RemoveBlueprintTracepoints(Blueprint);
+		TestTrue("Removed tracepoints should still resolve through the debug data", Profiler.ResolveTracepointNode(ActiveObject, Function, PreciseOffset, NodeId, NodeKey));
+		TestEqual("Removed offset table should not be used", NodeId, FNodeStatsTable::InvalidId);
+		TestTrue("Node should be handed to the drain again", NodeKey.Get() == CallNode);
+	}
+
+	DestroyTestBlueprint(Blueprint);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRuntimeProfilerNodeTimerKeyTest, "BlueprintProfiler.RuntimeProfiler.NodeTimerKeys",
+	EAutomationTestFlags::ProductFilter | EAutomationTestFlags::EditorContext)
+
+bool FRuntimeProfilerNodeTimerKeyTest::RunTest(const FString& Parameters)
+{
+#if CPUPROFILERTRACE_ENABLED
+	using namespace BlueprintProfilerRuntimeTest;
+
+	UK2Node_CallFunction* CallNode = nullptr;
+	UBlueprint* Blueprint = CreateTestBlueprint(TEXT("BP_NodeTimerKeys"), CallNode);
+	UBlueprintGeneratedClass* GeneratedClass = Blueprint ? Cast<UBlueprintGeneratedClass>(Blueprint->GeneratedClass) : nullptr;
+	UFunction* Function = GeneratedClass ? GeneratedClass->UberGraphFunction.Get() : nullptr;
+	int32 PreciseOffset = INDEX_NONE;
+	int32 ImpreciseOffset = INDEX_NONE;
+	if (!TestNotNull("Test Blueprint should compile an ubergraph", Function)
+		|| !TestTrue("Call node should have debug data", FindNodeCodeOffsets(*GeneratedClass, Function, CallNode, PreciseOffset, ImpreciseOffset)))
+	{
+		DestroyTestBlueprint(Blueprint);
+		return false;
+	}
+
+	auto GetTimerIdOnWorker = [Function](int32 CodeOffset)
+	{
+		uint32 TimerId = 0;
+		FThread WorkerThread(TEXT("BlueprintProfilerTimerTest"), [Function, CodeOffset, &TimerId]()
+		{
+			TimerId = BlueprintProfilerTrace::GetNodeTimerId(Function, CodeOffset);
+		});
+		WorkerThread.Join();
+		return TimerId;
+	};
+
+	// 游戏线程按 (函数, 偏移) 解析出节点名；同一节点的多个偏移共用一个计时器
+	BlueprintProfilerTrace::ResetNodeTimers();
+	const uint32 NodeTimerId = BlueprintProfilerTrace::GetNodeTimerId(Function, PreciseOffset);
+	TestNotEqual("Game thread should register the node's timer", NodeTimerId, 0u);
+	TestEqual("The same key should return the cached timer", BlueprintProfilerTrace::GetNodeTimerId(Function, PreciseOffset), NodeTimerId);
+	TestEqual("Offsets of the same node should share its timer", BlueprintProfilerTrace::GetNodeTimerId(Function, ImpreciseOffset), NodeTimerId);
+	TestEqual("Node-level entries should be used by other threads", GetTimerIdOnWorker(PreciseOffset), NodeTimerId);
+
+	// 工作线程先遇到的键记在函数的计时器上并缓存，游戏线程随后替换成节点的计时器
+	BlueprintProfilerTrace::ResetNodeTimers();
+	const uint32 FunctionTimerId = GetTimerIdOnWorker(PreciseOffset);
+	TestNotEqual("Worker thread should get a timer", FunctionTimerId, 0u);
+	TestNotEqual("Worker thread should get the function's timer before the node is resolved", FunctionTimerId, NodeTimerId);
+	TestEqual("Function-level entries should be cached for other threads", GetTimerIdOnWorker(PreciseOffset), FunctionTimerId);
+	TestEqual("Game thread should replace the entry with the node's timer", BlueprintProfilerTrace::GetNodeTimerId(Function, PreciseOffset), NodeTimerId);
+	TestEqual("Other threads should use the replaced entry", GetTimerIdOnWorker(PreciseOffset), NodeTimerId);
+
+	BlueprintProfilerTrace::ResetNodeTimers();
+	DestroyTestBlueprint(Blueprint);
+#else
+	AddInfo(TEXT("CPU profiler trace is compiled out; Blueprint node timers are not registered"));
+#endif
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRuntimeProfilerSamplingEstimateTest, "BlueprintProfiler.RuntimeProfiler.SamplingEstimate",
+	EAutomationTestFlags::ProductFilter | EAutomationTestFlags::EditorContext)
+
+bool FRuntimeProfilerSamplingEstimateTest::RunTest(const FString& Parameters)
+{
+	FProfilerSamplingSettings Settings;
+	TestEqual("Full recording should sample every event", Settings.GetSamplingRate(), 1.0f);
+	Settings.Mode = ESamplingMode::EveryNth;
+	Settings.SampleInterval = 4;
+	TestEqual("Every 4th event should give a rate of 0.25", Settings.GetSamplingRate(), 0.25f);
+	Settings.Mode = ESamplingMode::TimeSliced;
+	Settings.SliceDurationMs = 5.0f;
+	Settings.SlicePeriodMs = 20.0f;
+	TestEqual("A 5 ms slice every 20 ms should give a rate of 0.25", Settings.GetSamplingRate(), 0.25f);
+
+	// Full recording keeps exact counts
+	FNodeExecutionData FullData;
+	FullData.TotalExecutions = 100;
+	FullData.ApplySamplingRate(1.0f);
+	TestEqual("Full recording should not extrapolate", FullData.TotalExecutions, 100);
+	TestEqual("Full recording bounds should be exact", FullData.ExecutionsLowerBound, 100);
+	TestEqual("Full recording bounds should be exact", FullData.ExecutionsUpperBound, 100);
+
+	// Sampled counts and totals are scaled, averages are not
+	FNodeExecutionData SampledData;
+	SampledData.TotalExecutions = 100;
+	SampledData.TotalExecutionTime = 0.1f;
+	SampledData.AverageExecutionTime = 0.001f;
+	SampledData.ApplySamplingRate(0.25f);
+	TestEqual("Sampled count should be kept", SampledData.SampledExecutions, 100);
+	TestEqual("Count should be extrapolated", SampledData.TotalExecutions, 400);
+	TestTrue("Total time should be extrapolated", FMath::IsNearlyEqual(SampledData.TotalExecutionTime, 0.4f, 0.0001f));
+	TestEqual("Average time should not be scaled", SampledData.AverageExecutionTime, 0.001f);
+	TestTrue("Estimate should lie inside its bounds",
+		SampledData.ExecutionsLowerBound < SampledData.TotalExecutions && SampledData.TotalExecutions < SampledData.ExecutionsUpperBound);
+	TestTrue("Lower bound should not drop below the sampled count", SampledData.ExecutionsLowerBound >= SampledData.SampledExecutions);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRuntimeProfilerSessionFileTest, "BlueprintProfiler.RuntimeProfiler.SessionFile",
+	EAutomationTestFlags::ProductFilter | EAutomationTestFlags::EditorContext)
+
+bool FRuntimeProfilerSessionFileTest::RunTest(const FString& Parameters)
+{
+	const FString FilePath = FPaths::ProjectSavedDir() / TEXT("BlueprintProfiler") / TEXT("Tests") / (TEXT("SessionFileTest") + FString(BlueprintProfilerSessionFile::GetExtension()));
+
+	FRecordingSession Session;
+	Session.SessionName = TEXT("SessionFileTest");
+	Session.Duration = 12.5f;
+	Session.TotalExecutions = 42;
+	Session.TotalFrames = 750;
+
+	FNodeExecutionData Node;
+	Node.NodeName = TEXT("Print String");
+	Node.BlueprintName = TEXT("BP_Test");
+	Node.NodeGuid = FGuid::NewGuid();
+	Node.TotalExecutions = 42;
+	Node.AverageExecutionTime = 0.002f;
+
+	// Frames are appended in more than one block, as they would be while recording
+	TArray<FExecutionFrame> Frames;
+	for (int32 Index = 0; Index < BlueprintProfilerSessionFile::FramesPerBlock + 10; ++Index)
+	{
+		FExecutionFrame& Frame = Frames.AddDefaulted_GetRef();
+		Frame.Timestamp = Index * 0.01;
+		Frame.ExecutionTime = 0.002f;
+		Frame.NodeId = 7;
+		Frame.FrameNumber = 1000 + Index / 100;
+	}
+
+	{
+		FProfilerSessionWriter Writer;
+		TestTrue("Writer should open", Writer.Open(FilePath));
+		Writer.WriteFrames(Frames);
+		const uint32 NodeId = 7;
+		Writer.WriteSummary(Session, MakeArrayView(&Node, 1), MakeArrayView(&NodeId, 1));
+		TestTrue("Writer should close cleanly", Writer.Close());
+	}
+
+	FProfilerSessionReader Reader;
+	TestTrue("Reader should open the file", Reader.Open(FilePath));
+	TestTrue("File should be complete", Reader.IsComplete());
+	TestEqual("Session name should round-trip", Reader.GetSession().SessionName, Session.SessionName);
+	TestEqual("Session duration should round-trip", Reader.GetSession().Duration, Session.Duration);
+	TestEqual("Session frame count should round-trip", Reader.GetSession().TotalFrames, Session.TotalFrames);
+	TestEqual("One node should be read", Reader.GetNodes().Num(), 1);
+	if (Reader.GetNodes().Num() == 1)
+	{
+		TestEqual("Node name should come from the string table", Reader.GetNodes()[0].NodeName, Node.NodeName);
+		TestEqual("Node GUID should round-trip", Reader.GetNodes()[0].NodeGuid, Node.NodeGuid);
+		TestEqual("Node ID should round-trip", Reader.GetNodeIds()[0], 7u);
+	}
+	TestEqual("All frames should be indexed", Reader.GetNumFrames(), (int64)Frames.Num());
+	TestEqual("Frames should be split into blocks", Reader.GetNumFrameBlocks(), 2);
+
+	TArray<FExecutionFrame> ReadFrames;
+	TestTrue("Second frame block should decode", Reader.ReadFrameBlock(1, ReadFrames));
+	TestEqual("Second block should hold the remainder", ReadFrames.Num(), 10);
+	if (ReadFrames.Num() == 10)
+	{
+		TestEqual("Frame number should round-trip", ReadFrames[9].FrameNumber, Frames.Last().FrameNumber);
+	}
+
+	Reader.Close();
+	IFileManager::Get().Delete(*FilePath);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRuntimeProfilerFramePagingTest, "BlueprintProfiler.RuntimeProfiler.FramePaging",
+	EAutomationTestFlags::ProductFilter | EAutomationTestFlags::EditorContext)
+
+bool FRuntimeProfilerFramePagingTest::RunTest(const FString& Parameters)
+{
+	using namespace BlueprintProfilerRuntimeTest;
+	if (!TestTrue("Test needs an idle profiler", FRuntimeProfiler::Get().GetRecordingState() == ERecordingState::Stopped))
+	{
+		return false;
+	}
+
+	UObject* Node = AActor::StaticClass();
+	UFunction* Function = AActor::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(AActor, SetActorHiddenInGame));
+	const FScriptInstrumentationSignal Entry(EScriptInstrumentation::NodeEntry, Node, Function, 0);
+	const FScriptInstrumentationSignal Exit(EScriptInstrumentation::NodeExit, Node, Function, 0);
+
+	// 两个满页加一个未写满的页，远多于内存中保留的最近帧；每次执行推进帧号，读回的帧可按帧号核对
+	constexpr int32 FramesPerBlock = BlueprintProfilerSessionFile::FramesPerBlock;
+	constexpr int32 NumFrames = FramesPerBlock * 2 + 100;
+	const uint64 SavedFrameCounter = GFrameCounter;
+	const uint64 FirstFrameNumber = SavedFrameCounter + 1;
+	const FString FilePath = FRuntimeProfiler::Get().GetSessionDataDirectory() / (TEXT("FramePagingTest") + FString(BlueprintProfilerSessionFile::GetExtension()));
+
+	auto TestFrameNumbers = [this, FirstFrameNumber](const TCHAR* What, const TArray<FExecutionFrame>& Frames, int64 FirstFrame)
+	{
+		for (int32 Index = 0; Index < Frames.Num(); ++Index)
+		{
+			if (Frames[Index].FrameNumber != FirstFrameNumber + FirstFrame + Index)
+			{
+				AddError(FString::Printf(TEXT("%s: frame %lld has frame number %llu"), What, FirstFrame + Index, Frames[Index].FrameNumber));
+				return;
+			}
+		}
+	};
+
+	// Times of frames read back should match the full history read while recording
+	auto TestFrameTimes = [this](const TCHAR* What, const TArray<FExecutionFrame>& Frames, const TArray<FExecutionFrame>& Recorded, int64 FirstFrame)
+	{
+		for (int32 Index = 0; Index < Frames.Num(); ++Index)
+		{
+			const FExecutionFrame& Expected = Recorded[FirstFrame + Index];
+			if (Frames[Index].Timestamp != Expected.Timestamp || Frames[Index].ExecutionTime != Expected.ExecutionTime)
+			{
+				AddError(FString::Printf(TEXT("%s: frame %lld has different times"), What, FirstFrame + Index));
+				return;
+			}
+		}
+	};
+
+	TArray<FExecutionFrame> RecordedFrames;
+	{
+		FScopedTestRecording Recording(TEXT("FramePagingTest"), true);
+		FRuntimeProfiler& Profiler = Recording.Profiler;
+		for (int32 Execution = 0; Execution < NumFrames; ++Execution)
+		{
+			GFrameCounter = FirstFrameNumber + Execution;
+			Profiler.OnScriptProfilingEvent(Entry);
+			Profiler.OnScriptProfilingEvent(Exit);
+			if ((Execution + 1) % (FRuntimeProfiler::EventBufferCapacity / 4) == 0)
+			{
+				Profiler.FlushEventBuffers();
+			}
+		}
+		Profiler.FlushEventBuffers();
+		TestEqual("No events should be dropped", Profiler.GetNumDroppedEvents(), uint64(0));
+		TestEqual("Every execution should add a frame", Profiler.GetNumExecutionFrames(), int64(NumFrames));
+
+		// 录制中：刚交给写入管线的页也要能读回，最后一段仍在内存中的当前页
+		TArray<FExecutionFrame> Frames;
+		const int64 DiskBoundary = FramesPerBlock - 50;
+		TestTrue("Range across the first two pages should be read while recording", Profiler.GetExecutionFrames(DiskBoundary, 100, Frames));
+		TestEqual("Range across the first two pages should be complete", Frames.Num(), 100);
+		TestFrameNumbers(TEXT("Pages on disk"), Frames, DiskBoundary);
+
+		const int64 PendingBoundary = FramesPerBlock * 2 - 50;
+		TestTrue("Range into the pending page should be read while recording", Profiler.GetExecutionFrames(PendingBoundary, 100, Frames));
+		TestEqual("Range into the pending page should be complete", Frames.Num(), 100);
+		TestFrameNumbers(TEXT("Pending page"), Frames, PendingBoundary);
+
+		TestTrue("Whole history should be read while recording", Profiler.GetExecutionFrames(0, NumFrames, RecordedFrames));
+		TestEqual("Whole history should be complete", RecordedFrames.Num(), NumFrames);
+		TestFrameNumbers(TEXT("Whole history"), RecordedFrames, 0);
+		for (int32 Index = 1; Index < RecordedFrames.Num(); ++Index)
+		{
+			if (RecordedFrames[Index].Timestamp < RecordedFrames[Index - 1].Timestamp)
+			{
+				AddError(FString::Printf(TEXT("Frame %d starts before the frame recorded ahead of it"), Index));
+				break;
+			}
+		}
+
+		TestTrue("Reading past the end should clamp", Profiler.GetExecutionFrames(NumFrames - 10, 100, Frames));
+		TestEqual("Reading past the end should return the remaining frames", Frames.Num(), 10);
+
+		// 停止后：从写完的会话文件按块读取
+		Profiler.StopRecording();
+		GFrameCounter = SavedFrameCounter;
+		TestEqual("Stopping should keep the frame count", Profiler.GetNumExecutionFrames(), int64(NumFrames));
+
+		TestTrue("Range across the first two pages should be read after stopping", Profiler.GetExecutionFrames(DiskBoundary, 100, Frames));
+		TestEqual("Stopped range across the first two pages should be complete", Frames.Num(), 100);
+		TestFrameNumbers(TEXT("Stopped pages"), Frames, DiskBoundary);
+		TestFrameTimes(TEXT("Stopped pages"), Frames, RecordedFrames, DiskBoundary);
+
+		TestTrue("Range into the last page should be read after stopping", Profiler.GetExecutionFrames(PendingBoundary, 100, Frames));
+		TestEqual("Stopped range into the last page should be complete", Frames.Num(), 100);
+		TestFrameNumbers(TEXT("Stopped last page"), Frames, PendingBoundary);
+		TestFrameTimes(TEXT("Stopped last page"), Frames, RecordedFrames, PendingBoundary);
+	}
+
+	// 会话文件本身：两个满页加最后一页，帧与录制时读到的一致
+	FProfilerSessionReader Reader;
+	if (TestTrue("Streamed session file should open", Reader.Open(FilePath)))
+	{
+		TestTrue("Streamed session file should be complete", Reader.IsComplete());
+		TestEqual("Streamed session file should hold every frame", Reader.GetNumFrames(), int64(NumFrames));
+		TestEqual("Frames should be stored in full pages plus the last one", Reader.GetNumFrameBlocks(), 3);
+
+		const int32 LastBlock = Reader.FindFrameBlock(NumFrames - 1);
+		TArray<FExecutionFrame> Frames;
+		if (TestTrue("Last frame block should decode", LastBlock != INDEX_NONE && Reader.ReadFrameBlock(LastBlock, Frames)))
+		{
+			const int64 BlockStart = Reader.GetFrameBlockStart(LastBlock);
+			TestEqual("Last block should start after the full pages", BlockStart, int64(FramesPerBlock * 2));
+			TestFrameNumbers(TEXT("Session file"), Frames, BlockStart);
+			TestFrameTimes(TEXT("Session file"), Frames, RecordedFrames, BlockStart);
+		}
+		Reader.Close();
+	}
+	IFileManager::Get().Delete(*FilePath);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRuntimeProfilerFrameCostStoreTest, "BlueprintProfiler.RuntimeProfiler.FrameCostStore",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRuntimeProfilerFrameCostStoreTest::RunTest(const FString& Parameters)
+{
+	FFrameCostStore Store;
+	const int32 BlueprintA = Store.InternBlueprint(TEXT("BP_A"));
+	const int32 BlueprintB = Store.InternBlueprint(TEXT("BP_B"));
+	TestEqual("Blueprint names should be interned once", Store.InternBlueprint(TEXT("BP_A")), BlueprintA);
+
+	// Nodes 0 and 1 belong to BP_A, node 2 to BP_B
+	auto GetBlueprintIndex = [BlueprintA, BlueprintB](uint32 NodeId) { return NodeId == 2 ? BlueprintB : BlueprintA; };
+
+	Store.AddCost(100, 1.0, 0, 300);
+	Store.AddCost(100, 1.0, 2, 500);
+	Store.AddCost(100, 1.0, 1, 400);
+	Store.AddCost(100, 1.0, 0, 100);
+	Store.AddCost(101, 1.1, 2, 50);
+
+	int32 CompletedFrames = 0;
+	Store.CompleteFramesBefore(101, GetBlueprintIndex, [&CompletedFrames](const FFrameCostStore::FFrameRecord&) { CompletedFrames++; });
+	TestEqual("Only frames before 101 should complete", CompletedFrames, 1);
+
+	const FFrameCostStore::FFrameRecord* Frame = Store.FindFrame(100);
+	TestNotNull("Frame 100 should be stored", Frame);
+	if (Frame)
+	{
+		TestTrue("Frame 100 should be complete", Frame->bComplete);
+		TestEqual("Frame total should sum all nodes", Frame->TotalCycles, (uint64)1300);
+		TestEqual("Repeated node costs should merge", Frame->NodeCycles.Num(), 3);
+		TestEqual("Nodes should be sorted by cost", Frame->NodeCycles[0].Key, 2u);
+		TestEqual("Blueprint totals should be grouped", Frame->BlueprintCycles.Num(), 2);
+		TestEqual("Top Blueprint should be BP_A", Frame->BlueprintCycles[0].Key, BlueprintA);
+		TestEqual("BP_A total should include all its nodes", Frame->BlueprintCycles[0].Value, (uint64)800);
+	}
+
+	// Late events for a completed frame are dropped
+	Store.AddCost(100, 1.0, 1, 1000);
+	TestEqual("Completed frame should not change", Store.FindFrame(100)->TotalCycles, (uint64)1300);
+	TestFalse("Open frame should not be complete yet", Store.FindFrame(101)->bComplete);
+
+	// The ring keeps only the most recent frames
+	for (uint64 FrameNumber = 200; FrameNumber < 200 + FFrameCostStore::Capacity; ++FrameNumber)
+	{
+		Store.AddCost(FrameNumber, 2.0, 0, 10);
+	}
+	TestEqual("Store should stay at capacity", Store.Num(), FFrameCostStore::Capacity);
+	TestNull("Oldest frames should be evicted", Store.FindFrame(100));
+	TestNotNull("Newest frame should be found", Store.FindFrame(200 + FFrameCostStore::Capacity - 1));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRuntimeProfilerBlueprintMemoryTest, "BlueprintProfiler.RuntimeProfiler.BlueprintMemory",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRuntimeProfilerBlueprintMemoryTest::RunTest(const FString& Parameters)
+{
+	auto MakeClass = [](const TCHAR* BlueprintName, int32 InstanceCount, int64 InstanceBytes)
+	{
+		FBlueprintClassMemory Class;
+		Class.BlueprintName = BlueprintName;
+		Class.ClassPath = FString::Printf(TEXT("/Game/%s.%s_C"), BlueprintName, BlueprintName);
+		Class.InstanceCount = InstanceCount;
+		Class.InstanceBytes = InstanceBytes;
+		return Class;
+	};
+
+	// BP_Spawner grows, BP_Door is stable, BP_Projectile is gone by the last snapshot
+	TArray<FBlueprintMemorySnapshot> Snapshots;
+	Snapshots.AddDefaulted(3);
+	for (int32 Index = 0; Index < Snapshots.Num(); ++Index)
+	{
+		Snapshots[Index].Timestamp = 10.0 + Index;
+		Snapshots[Index].FirstFrameNumber = 100 + Index * 60;
+		Snapshots[Index].LastFrameNumber = 102 + Index * 60;
+		Snapshots[Index].Classes.Add(MakeClass(TEXT("BP_Spawner"), 1 + Index, 1000 * (1 + Index)));
+		Snapshots[Index].Classes.Add(MakeClass(TEXT("BP_Door"), 2, 500));
+	}
+	Snapshots[0].Classes.Add(MakeClass(TEXT("BP_Projectile"), 4, 4000));
+	TestEqual("Snapshot total should sum its classes", Snapshots[0].GetTotalBytes(), (int64)5500);
+
+	FNodeExecutionData SpawnerNode;
+	SpawnerNode.BlueprintName = TEXT("BP_Spawner");
+	SpawnerNode.TotalExclusiveTime = 0.25f;
+	FNodeExecutionData OtherNode;
+	OtherNode.BlueprintName = TEXT("BP_NoInstances");
+	OtherNode.TotalExclusiveTime = 1.0f;
+	const FNodeExecutionData Nodes[] = { SpawnerNode, SpawnerNode, OtherNode };
+
+	TArray<FBlueprintMemoryTrend> Trends;
+	FBlueprintMemoryCapture::BuildTrends(Snapshots, Nodes, Trends);
+	TestEqual("One trend per Blueprint with instances", Trends.Num(), 3);
+	if (Trends.Num() == 3)
+	{
+		TestEqual("Largest growth should come first", Trends[0].BlueprintName, FString(TEXT("BP_Spawner")));
+		TestEqual("Growth should span first to last snapshot", Trends[0].GetGrowthBytes(), (int64)2000);
+		TestEqual("Latest instance count should come from the last snapshot", Trends[0].LatestInstanceCount, 3);
+		TestEqual("CPU time should sum the Blueprint's nodes", Trends[0].TotalExclusiveTime, 0.5f);
+		TestEqual("Stable Blueprint should not grow", Trends[1].GetGrowthBytes(), (int64)0);
+		TestEqual("Vanished Blueprint should end at zero", Trends[2].LatestBytes, (int64)0);
+		TestEqual("Vanished Blueprint should keep its peak", Trends[2].PeakInstanceCount, 4);
+		TestEqual("Vanished Blueprint appeared once", Trends[2].NumSnapshots, 1);
+	}
+
+	// Snapshots are stored in the session file next to the node stats
+	const FString FilePath = FPaths::ProjectSavedDir() / TEXT("BlueprintProfiler") / TEXT("Tests") / (TEXT("BlueprintMemoryTest") + FString(BlueprintProfilerSessionFile::GetExtension()));
+	{
+		FProfilerSessionWriter Writer;
+		TestTrue("Writer should open", Writer.Open(FilePath));
+		Writer.WriteMemorySnapshots(Snapshots);
+		Writer.WriteSummary(FRecordingSession(), TConstArrayView<FNodeExecutionData>(), TConstArrayView<uint32>());
+		TestTrue("Writer should close cleanly", Writer.Close());
+	}
+
+	FProfilerSessionReader Reader;
+	TestTrue("Reader should open the file", Reader.Open(FilePath));
+	TestEqual("All snapshots should be read", Reader.GetMemorySnapshots().Num(), Snapshots.Num());
+	if (Reader.GetMemorySnapshots().Num() == Snapshots.Num())
+	{
+		const FBlueprintMemorySnapshot& ReadSnapshot = Reader.GetMemorySnapshots()[0];
+		TestEqual("Snapshot frame range should round-trip", ReadSnapshot.LastFrameNumber, Snapshots[0].LastFrameNumber);
+		TestEqual("Classes should round-trip", ReadSnapshot.Classes.Num(), Snapshots[0].Classes.Num());
+		TestEqual("Class bytes should round-trip", ReadSnapshot.GetTotalBytes(), Snapshots[0].GetTotalBytes());
+	}
+	Reader.Close();
+	IFileManager::Get().Delete(*FilePath);
+
+	// Outside PIE a full pass still completes, it just finds no play world instances
+	FBlueprintMemoryCapture Capture;
+	Capture.CaptureNow();
+	TestEqual("A synchronous pass should add one snapshot", Capture.GetSnapshots().Num(), 1);
+	if (Capture.GetSnapshots().Num() == 1)
+	{
+		TestEqual("Editor objects should be skipped", Capture.GetSnapshots()[0].Classes.Num(), 0);
+	}
+	Capture.Reset();
+	TestEqual("Reset should drop snapshots", Capture.GetSnapshots().Num(), 0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRuntimeProfilerLiveUpdateTest, "BlueprintProfiler.RuntimeProfiler.LiveUpdates",
+	EAutomationTestFlags::ProductFilter | EAutomationTestFlags::EditorContext)
+
+bool FRuntimeProfilerLiveUpdateTest::RunTest(const FString& Parameters)
+{
+	// Change tracking: each ID is reported once per consume, in first-change order
+	FNodeStatsTable Table;
+	const uint32 FirstId = Table.Intern(GetTransientPackage());
+	const uint32 SecondId = Table.Intern(UObject::StaticClass());
+
+	Table.AddExecution(SecondId);
+	Table.AddExecution(SecondId);
+	Table.AddExecutionTime(FirstId, 0.001f);
+
+	TArray<uint32> ChangedIds;
+	Table.ConsumeChangedIds(ChangedIds);
+	if (TestEqual("Both changed IDs should be reported once", ChangedIds.Num(), 2))
+	{
+		TestEqual("IDs should be in first-change order", ChangedIds[0], SecondId);
+		TestEqual("Timed ID should be reported", ChangedIds[1], FirstId);
+	}
+
+	Table.ConsumeChangedIds(ChangedIds);
+	TestEqual("Nothing should be reported without new records", ChangedIds.Num(), 0);
+
+	Table.AddExecution(FirstId);
+	Table.ConsumeChangedIds(ChangedIds);
+	TestEqual("Only the node that ran again should be reported", ChangedIds.Num(), 1);
+
+	// Profiler: the rate is configurable and each recording starts without a published update
+	FRuntimeProfiler& RuntimeProfiler = FRuntimeProfiler::Get();
+	const float PreviousRate = RuntimeProfiler.GetLiveUpdateRate();
+	RuntimeProfiler.SetLiveUpdateRate(-1.0f);
+	TestEqual("Negative rates should turn live updates off", RuntimeProfiler.GetLiveUpdateRate(), 0.0f);
+	RuntimeProfiler.SetLiveUpdateRate(PreviousRate);
+
+	{
+		FScopedTestRecording Recording(TEXT("LiveUpdateTest"));
+		TestFalse("A new recording should not expose the previous live update", Recording.Profiler.GetLatestLiveUpdate().IsValid());
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRuntimeProfilerSessionComparisonTest, "BlueprintProfiler.RuntimeProfiler.SessionComparison",
+	EAutomationTestFlags::ProductFilter | EAutomationTestFlags::EditorContext)
+
+bool FRuntimeProfilerSessionComparisonTest::RunTest(const FString& Parameters)
+{
+	auto MakeNode = [](const FString& BlueprintName, const FString& NodeName, const FGuid& Guid, int32 Executions, float ExclusiveSeconds)
+	{
+		FNodeExecutionData Node;
+		Node.BlueprintName = BlueprintName;
+		Node.NodeName = NodeName;
+		Node.NodeGuid = Guid;
+		Node.TotalExecutions = Executions;
+		Node.ExecutionsLowerBound = Executions;
+		Node.ExecutionsUpperBound = Executions;
+		Node.TotalExclusiveTime = ExclusiveSeconds;
+		return Node;
+	};
+
+	const FGuid SlowGuid = FGuid::NewGuid();
+	const FGuid SteadyGuid = FGuid::NewGuid();
+	const FGuid FastGuid = FGuid::NewGuid();
+
+	// Baseline: 1000 frames in 10s. Current: twice as long, so the same cost per frame means twice the totals
+	FSessionProfile Baseline;
+	Baseline.Session.Duration = 10.0f;
+	Baseline.NumFrames = 1000;
+	Baseline.Nodes.Add(MakeNode(TEXT("BP_Slow"), TEXT("Tick"), SlowGuid, 1000, 1.0f));
+	Baseline.Nodes.Add(MakeNode(TEXT("BP_Steady"), TEXT("Tick"), SteadyGuid, 1000, 1.0f));
+	Baseline.Nodes.Add(MakeNode(TEXT("BP_Fast"), TEXT("Tick"), FastGuid, 1000, 1.0f));
+	Baseline.Nodes.Add(MakeNode(TEXT("BP_Gone"), TEXT("Tick"), FGuid::NewGuid(), 1000, 0.5f));
+
+	FSessionProfile Current;
+	Current.Session.Duration = 20.0f;
+	Current.NumFrames = 2000;
+	Current.Nodes.Add(MakeNode(TEXT("BP_Slow"), TEXT("Tick (renamed)"), SlowGuid, 2000, 3.0f));    // +50% per frame
+	Current.Nodes.Add(MakeNode(TEXT("BP_Steady"), TEXT("Tick"), SteadyGuid, 2000, 2.04f));         // +2%, below the threshold
+	Current.Nodes.Add(MakeNode(TEXT("BP_Fast"), TEXT("Tick"), FastGuid, 2000, 1.0f));              // -50%
+	Current.Nodes.Add(MakeNode(TEXT("BP_New"), TEXT("Tick"), FGuid::NewGuid(), 2000, 1.0f));
+
+	const FSessionComparison Comparison = FSessionComparison::Compare(Baseline, Current);
+	TestTrue("Both recordings have frame counts", Comparison.bPerFrame);
+	if (!TestEqual("Nodes are aligned by GUID across renames", Comparison.Nodes.Num(), 5))
+	{
+		return false;
+	}
+
+	const FSessionCostDiff& Top = Comparison.Nodes[0];
+	TestEqual("Largest regression ranks first", Top.BlueprintName, FString(TEXT("BP_Slow")));
+	TestTrue("Regression is classified", Top.Change == ESessionCostChange::Regressed);
+	TestEqual("Baseline cost is per frame", Top.BaselineMs, 1.0f, 0.001f);
+	TestEqual("Current cost is per frame", Top.CurrentMs, 1.5f, 0.001f);
+	TestEqual("Delta percent", Top.DeltaPercent, 50.0f, 0.01f);
+	TestEqual("Executions are per second", Top.CurrentExecutionsPerSecond, 100.0f, 0.01f);
+
+	auto FindBlueprint = [&Comparison](const TCHAR* Name) -> const FSessionCostDiff*
+	{
+		return Comparison.Blueprints.FindByPredicate([Name](const FSessionCostDiff& Diff) { return Diff.BlueprintName == Name; });
+	};
+
+	const FSessionCostDiff* Steady = FindBlueprint(TEXT("BP_Steady"));
+	const FSessionCostDiff* Fast = FindBlueprint(TEXT("BP_Fast"));
+	const FSessionCostDiff* Gone = FindBlueprint(TEXT("BP_Gone"));
+	const FSessionCostDiff* New = FindBlueprint(TEXT("BP_New"));
+	if (!TestTrue("Every Blueprint has a row", Steady && Fast && Gone && New))
+	{
+		return false;
+	}
+	TestFalse("Small change is not significant", Steady->bSignificant);
+	TestTrue("Improvement is classified", Fast->Change == ESessionCostChange::Improved);
+	TestTrue("Removed Blueprint", Gone->Change == ESessionCostChange::Removed);
+	TestTrue("Added Blueprint", New->Change == ESessionCostChange::Added);
+
+	// 采样误差大于变化时不算显著
+	FSessionProfile Sampled = Current;
+	Sampled.Nodes[0].ExecutionsLowerBound = 0;
+	Sampled.Nodes[0].ExecutionsUpperBound = 4000;
+	const FSessionComparison Noisy = FSessionComparison::Compare(Baseline, Sampled);
+	const FSessionCostDiff* NoisySlow = Noisy.Blueprints.FindByPredicate([](const FSessionCostDiff& Diff) { return Diff.BlueprintName == TEXT("BP_Slow"); });
+	TestTrue("Sampling error makes the change insignificant", NoisySlow && !NoisySlow->bSignificant);
+
+	// Headless gate: only tracked Blueprints above the limit fail
+	TestEqual("Regression above 10% fails", Comparison.FindBlueprintRegressions({}, 10.0f).Num(), 1);
+	TestEqual("Regression below the limit passes", Comparison.FindBlueprintRegressions({}, 60.0f).Num(), 0);
+	const TArray<FString> Tracked = { TEXT("BP_Fast") };
+	TestEqual("Untracked regression is ignored", Comparison.FindBlueprintRegressions(Tracked, 10.0f).Num(), 0);
+
+	// Without frame counts the costs fall back to ms per second
+	FSessionProfile Unframed = Current;
+	Unframed.NumFrames = 0;
+	const FSessionComparison PerSecond = FSessionComparison::Compare(Baseline, Unframed);
+	TestFalse("Unknown frame count falls back to duration", PerSecond.bPerFrame);
+	TestEqual("Per second cost", PerSecond.Nodes[0].CurrentMs, 150.0f, 0.01f);
+
+	return true;
+}
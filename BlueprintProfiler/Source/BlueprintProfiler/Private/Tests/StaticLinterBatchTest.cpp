@@ -3,9 +3,25 @@
 #include "CoreMinimal.h"
 #include "Misc/AutomationTest.h"
 #include "Analyzers/StaticLinter.h"
+#include "Analyzers/BlueprintLintSnapshot.h"
+#include "Analyzers/StaticLinterCache.h"
+#include "Analyzers/BlueprintLintTags.h"
+#include "Analyzers/LintGraphIndex.h"
+#include "Analyzers/LintReportWriter.h"
 #include "Data/ProfilerDataTypes.h"
 #include "Engine/Blueprint.h"
+#include "Engine/World.h"
+#include "Curves/CurveFloat.h"
+#include "Editor.h"
+#include "Subsystems/AssetEditorSubsystem.h"
+#include "UObject/Package.h"
 #include "AssetRegistry/AssetData.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
 
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStaticLinterBatchProcessingTest, "BlueprintProfiler.StaticLinter.BatchProcessing", 
 	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
@@ -31,6 +47,7 @@ bool FStaticLinterBatchProcessingTest::RunTest(const FString& Parameters)
 	FScanConfiguration Config;
 	TestTrue("Multi-threading should be enabled by default", Config.bUseMultiThreading);
 	TestEqual("Default max concurrent tasks should be 4", Config.MaxConcurrentTasks, 4);
+	TestEqual("Memory budget should default to half of physical memory", Config.MemoryBudgetMB, 0);
 	TestTrue("Dead node check should be enabled by default", Config.EnabledChecks.Contains(ELintIssueType::DeadNode));
 	TestTrue("Orphan node check should be enabled by default", Config.EnabledChecks.Contains(ELintIssueType::OrphanNode));
 	TestTrue("Cast abuse check should be enabled by default", Config.EnabledChecks.Contains(ELintIssueType::CastAbuse));
@@ -134,4 +151,648 @@ bool FStaticLinterConfigurationTest::RunTest(const FString& Parameters)
 	TestEqual("Max concurrent tasks should be set correctly", Config.MaxConcurrentTasks, 8);
 	
 	return true;
-}
\ No newline at end of file
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStaticLinterSnapshotAnalysisTest, "BlueprintProfiler.StaticLinter.SnapshotAnalysis",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FStaticLinterSnapshotAnalysisTest::RunTest(const FString& Parameters)
+{
+	// Snapshots carry no UObjects, so the passes can be exercised with hand-built graphs
+	FStaticLinter Linter;
+	FScanConfiguration Config;
+
+	auto AddExecPin = [](FLintNodeSnapshot& Node, bool bOutput, int32 LinkedNode)
+	{
+		FLintPinSnapshot& Pin = Node.Pins.AddDefaulted_GetRef();
+		Pin.bExec = true;
+		Pin.bOutput = bOutput;
+		if (LinkedNode != INDEX_NONE)
+		{
+			Pin.LinkedNodes.Add(LinkedNode);
+		}
+	};
+
+	FBlueprintLintSnapshot Snapshot;
+	Snapshot.BlueprintPath = TEXT("/Game/Test/BP_SnapshotTest.BP_SnapshotTest");
+	Snapshot.BlueprintName = TEXT("BP_SnapshotTest");
+	Snapshot.Variables.Add({ FName(TEXT("UnusedHealth")), false });
+
+	// Event Tick driving a chain of 11 nodes, plus one execution node whose input is not connected
+	FLintGraphSnapshot& EventGraph = Snapshot.Graphs.AddDefaulted_GetRef();
+	EventGraph.Kind = ELintGraphKind::Ubergraph;
+	EventGraph.Name = TEXT("EventGraph");
+
+	const int32 ChainLength = 11;
+	FLintNodeSnapshot& TickNode = EventGraph.Nodes.AddDefaulted_GetRef();
+	TickNode.Kind = ELintNodeKind::Event;
+	TickNode.MemberName = TEXT("ReceiveTick");
+	TickNode.bIsK2Node = true;
+	TickNode.NodeGuid = FGuid::NewGuid();
+	AddExecPin(TickNode, true, 1);
+
+	for (int32 ChainIndex = 1; ChainIndex <= ChainLength; ++ChainIndex)
+	{
+		FLintNodeSnapshot& Node = EventGraph.Nodes.AddDefaulted_GetRef();
+		Node.Kind = ELintNodeKind::CallFunction;
+		Node.MemberName = TEXT("PrintString");
+		Node.Title = TEXT("Print String");
+		Node.ClassName = TEXT("K2Node_CallFunction");
+		Node.bIsK2Node = true;
+		Node.NodeGuid = FGuid::NewGuid();
+		AddExecPin(Node, false, ChainIndex - 1);
+		AddExecPin(Node, true, ChainIndex < ChainLength ? ChainIndex + 1 : INDEX_NONE);
+	}
+
+	FLintNodeSnapshot& OrphanNode = EventGraph.Nodes.AddDefaulted_GetRef();
+	OrphanNode.Kind = ELintNodeKind::CallFunction;
+	OrphanNode.Title = TEXT("Destroy Actor");
+	OrphanNode.ClassName = TEXT("K2Node_CallFunction");
+	OrphanNode.bIsK2Node = true;
+	OrphanNode.NodeGuid = FGuid::NewGuid();
+	AddExecPin(OrphanNode, false, INDEX_NONE);
+	AddExecPin(OrphanNode, true, INDEX_NONE);
+
+	// Per-blueprint passes
+	TArray<FLintIssue> LocalIssues;
+	Linter.AnalyzeSnapshot(Snapshot, Config, nullptr, LocalIssues);
+
+	const FLintIssue* TickIssue = LocalIssues.FindByPredicate([](const FLintIssue& Issue) { return Issue.Type == ELintIssueType::TickAbuse; });
+	TestNotNull("Tick event with 12 reachable nodes should be reported", TickIssue);
+	if (TickIssue)
+	{
+		TestTrue("Tick issue should point at the event node", TickIssue->NodeGuid == EventGraph.Nodes[0].NodeGuid);
+		TestEqual("Tick issue should carry the blueprint path", TickIssue->BlueprintPath, Snapshot.BlueprintPath);
+	}
+
+	const FLintIssue* OrphanIssue = LocalIssues.FindByPredicate([](const FLintIssue& Issue) { return Issue.Type == ELintIssueType::OrphanNode; });
+	TestNotNull("Unconnected execution node should be reported", OrphanIssue);
+	if (OrphanIssue)
+	{
+		TestTrue("Orphan issue should point at the unconnected node", OrphanIssue->NodeGuid == EventGraph.Nodes.Last().NodeGuid);
+	}
+	TestEqual("Connected chain should not produce orphan issues",
+		LocalIssues.FilterByPredicate([](const FLintIssue& Issue) { return Issue.Type == ELintIssueType::OrphanNode; }).Num(), 1);
+	TestFalse("Per-blueprint passes should not report dead nodes",
+		LocalIssues.ContainsByPredicate([](const FLintIssue& Issue) { return Issue.Type == ELintIssueType::DeadNode; }));
+
+	// Cross-blueprint passes
+	FLintReferenceIndex ReferenceIndex;
+	ReferenceIndex.SetCallSites(TEXT("/Game/Test/BP_SnapshotTest"), FLintCallSites::Collect(Snapshot));
+	ReferenceIndex.Resolve();
+	TestTrue("Reference index should contain called functions", ReferenceIndex.IsFunctionReferenced(TEXT("PrintString")));
+
+	TArray<FLintIssue> CrossIssues;
+	Linter.AnalyzeSnapshot(Snapshot, Config, &ReferenceIndex, CrossIssues);
+	TestTrue("Unused variable should be reported as a dead node",
+		CrossIssues.ContainsByPredicate([](const FLintIssue& Issue)
+		{
+			return Issue.Type == ELintIssueType::DeadNode && Issue.NodeName == TEXT("UnusedHealth");
+		}));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStaticLinterGraphIndexTest, "BlueprintProfiler.StaticLinter.GraphIndex",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FStaticLinterGraphIndexTest::RunTest(const FString& Parameters)
+{
+	// 0 Tick -> 1 Cast        2 ForEachLoop -(Loop Body)-> 3 Cast        4 Cast (no exec input link)
+	//                         2 ForEachLoop -(Completed)-> 5 Cast
+	FLintGraphSnapshot Graph;
+	auto AddNode = [&Graph](ELintNodeKind Kind, FName MemberName) -> FLintNodeSnapshot&
+	{
+		FLintNodeSnapshot& Node = Graph.Nodes.AddDefaulted_GetRef();
+		Node.Kind = Kind;
+		Node.MemberName = MemberName;
+		Node.Title = TEXT("Cast To Pawn");
+		Node.bIsK2Node = true;
+		Node.NodeGuid = FGuid::NewGuid();
+		return Node;
+	};
+	auto Link = [&Graph](int32 From, FName OutputName, int32 To)
+	{
+		FLintPinSnapshot& Output = Graph.Nodes[From].Pins.AddDefaulted_GetRef();
+		Output.Name = OutputName;
+		Output.bExec = true;
+		Output.bOutput = true;
+		Output.LinkedNodes.Add(To);
+
+		FLintPinSnapshot& Input = Graph.Nodes[To].Pins.AddDefaulted_GetRef();
+		Input.bExec = true;
+		Input.LinkedNodes.Add(From);
+	};
+
+	AddNode(ELintNodeKind::Event, TEXT("ReceiveTick"));
+	AddNode(ELintNodeKind::DynamicCast, NAME_None);
+	AddNode(ELintNodeKind::MacroInstance, NAME_None).MacroGraphName = TEXT("ForEachLoop");
+	AddNode(ELintNodeKind::DynamicCast, NAME_None);
+	FLintNodeSnapshot& Unlinked = AddNode(ELintNodeKind::DynamicCast, NAME_None);
+	Unlinked.Pins.AddDefaulted_GetRef().bExec = true;
+	AddNode(ELintNodeKind::DynamicCast, NAME_None);
+	Link(0, TEXT("then"), 1);
+	Link(2, TEXT("Loop Body"), 3);
+	Link(2, TEXT("Completed"), 5);
+
+	const FLintGraphIndex Index(Graph);
+	TestEqual("Index should cover every node", Index.Num(), 6);
+	TestEqual("Tick event should have one exec successor", Index.GetExecSuccessors(0).Num(), 1);
+	TestTrue("Cast after tick should be in tick context", Index.ReachedFromTick[1]);
+	TestFalse("Cast after loop should not be in tick context", Index.ReachedFromTick[3]);
+	TestTrue("Cast after loop should be in loop context", Index.ReachedFromLoop[3]);
+	TestFalse("Cast after tick should not be in loop context", Index.ReachedFromLoop[1]);
+	TestFalse("Cast after loop completion should not be in loop context", Index.ReachedFromLoop[5]);
+	TestFalse("Loop node itself should not be in loop context", Index.ReachedFromLoop[2]);
+	TestEqual("Tick event should reach itself and the cast", Index.CountReachable(0), 2);
+	TestTrue("Unlinked cast has an exec input", Index.HasExecInput[4]);
+	TestFalse("Unlinked cast has no linked exec input", Index.HasLinkedExecInput[4]);
+
+	// CastAbuse reports the tick and loop body casts, not the unconnected one or the one after Completed
+	FBlueprintLintSnapshot Snapshot;
+	Snapshot.BlueprintPath = TEXT("/Game/Test/BP_IndexTest.BP_IndexTest");
+	Snapshot.BlueprintName = TEXT("BP_IndexTest");
+	Snapshot.Graphs.Add(Graph);
+
+	FScanConfiguration Config;
+	Config.EnabledChecks = { ELintIssueType::CastAbuse };
+
+	FStaticLinter Linter;
+	TArray<FLintIssue> Issues;
+	Linter.AnalyzeSnapshot(Snapshot, Config, nullptr, Issues);
+
+	TestEqual("Casts in tick and loop context should be reported", Issues.Num(), 2);
+	const FLintIssue* LoopIssue = Issues.FindByPredicate([&Graph](const FLintIssue& Issue) { return Issue.NodeGuid == Graph.Nodes[3].NodeGuid; });
+	TestNotNull("Cast in loop body should be reported", LoopIssue);
+	if (LoopIssue)
+	{
+		TestTrue("Cast in loop body should be medium severity", LoopIssue->Severity == ESeverity::Medium);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStaticLinterReferenceIndexTest, "BlueprintProfiler.StaticLinter.ReferenceIndex",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FStaticLinterReferenceIndexTest::RunTest(const FString& Parameters)
+{
+	const FName CallerA(TEXT("/Game/Test/BP_CallerA"));
+	const FName CallerB(TEXT("/Game/Test/BP_CallerB"));
+
+	FLintCallSites CallsOfA;
+	CallsOfA.Functions = { TEXT("Fire"), TEXT("Reload") };
+	CallsOfA.Macros = { TEXT("SafeDivide") };
+
+	FLintCallSites CallsOfB;
+	CallsOfB.Functions = { TEXT("Fire") };
+
+	// Registration order does not matter; lookups are valid once resolved
+	FLintReferenceIndex Index;
+	Index.SetCallSites(CallerB, MoveTemp(CallsOfB));
+	Index.SetCallSites(CallerA, CallsOfA);
+	Index.Resolve();
+
+	TestEqual("Both assets should be registered", Index.NumAssets(), 2);
+	TestTrue("Reload should be referenced", Index.IsFunctionReferenced(TEXT("Reload")));
+	TestTrue("Macro should be referenced", Index.IsMacroReferenced(TEXT("SafeDivide")));
+	TestEqual("Fire should have two callers", Index.GetFunctionCallers(TEXT("Fire")).Num(), 2);
+	TestFalse("Unknown function should not be referenced", Index.IsFunctionReferenced(TEXT("Jump")));
+
+	// A changed blueprint only replaces its own edges
+	FLintCallSites ChangedA;
+	ChangedA.Functions = { TEXT("Fire") };
+	Index.SetCallSites(CallerA, MoveTemp(ChangedA));
+	TestFalse("Reload should no longer be referenced", Index.IsFunctionReferenced(TEXT("Reload")));
+	TestFalse("Macro should no longer be referenced", Index.IsMacroReferenced(TEXT("SafeDivide")));
+	TestEqual("Fire should still have two callers", Index.GetFunctionCallers(TEXT("Fire")).Num(), 2);
+
+	Index.RemoveAsset(CallerB);
+	TestEqual("Fire should have one caller left", Index.GetFunctionCallers(TEXT("Fire")).Num(), 1);
+	Index.RemoveAsset(CallerA);
+	TestFalse("Fire should not be referenced without callers", Index.IsFunctionReferenced(TEXT("Fire")));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStaticLinterOutOfFolderCallerTest, "BlueprintProfiler.StaticLinter.OutOfFolderCaller",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FStaticLinterOutOfFolderCallerTest::RunTest(const FString& Parameters)
+{
+	FScanConfiguration Config;
+	Config.EnabledChecks = { ELintIssueType::DeadNode };
+	TestTrue("DeadNode-only scans should pull in the project references", FStaticLinter::NeedsProjectReferences(Config.EnabledChecks));
+	TestFalse("Local-only checks should not", FStaticLinter::NeedsProjectReferences({ ELintIssueType::CastAbuse, ELintIssueType::TickAbuse }));
+
+	// The scanned folder holds the custom event, its only caller lives in another folder
+	FBlueprintLintSnapshot Scanned;
+	Scanned.BlueprintPath = TEXT("/Game/Doors/BP_Door.BP_Door");
+	Scanned.BlueprintName = TEXT("BP_Door");
+	FLintGraphSnapshot& EventGraph = Scanned.Graphs.AddDefaulted_GetRef();
+	EventGraph.Kind = ELintGraphKind::Ubergraph;
+	FLintNodeSnapshot& Event = EventGraph.Nodes.AddDefaulted_GetRef();
+	Event.Kind = ELintNodeKind::CustomEvent;
+	Event.MemberName = TEXT("OpenDoor");
+	Event.bIsK2Node = true;
+	Event.NodeGuid = FGuid::NewGuid();
+
+	FLintCallSites CallerSites;
+	CallerSites.Functions = { TEXT("OpenDoor") };
+
+	auto ReportsOpenDoor = [](const TArray<FLintIssue>& Issues)
+	{
+		return Issues.ContainsByPredicate([](const FLintIssue& Issue)
+		{
+			return Issue.Type == ELintIssueType::DeadNode && Issue.NodeName == TEXT("OpenDoor");
+		});
+	};
+
+	FStaticLinter Linter;
+	FLintReferenceIndex FolderOnly;
+	FolderOnly.SetCallSites(TEXT("/Game/Doors/BP_Door"), FLintCallSites::Collect(Scanned));
+	FolderOnly.Resolve();
+	TArray<FLintIssue> FolderOnlyIssues;
+	Linter.AnalyzeSnapshot(Scanned, Config, &FolderOnly, FolderOnlyIssues);
+	TestTrue("Without the outside caller the event looks dead", ReportsOpenDoor(FolderOnlyIssues));
+
+	// 扫描会把文件夹外的蓝图作为只提取引用的资产加入索引
+	FLintReferenceIndex WithProject;
+	WithProject.SetCallSites(TEXT("/Game/Doors/BP_Door"), FLintCallSites::Collect(Scanned));
+	WithProject.SetCallSites(TEXT("/Game/Player/BP_Player"), MoveTemp(CallerSites));
+	WithProject.Resolve();
+	TArray<FLintIssue> ProjectIssues;
+	Linter.AnalyzeSnapshot(Scanned, Config, &WithProject, ProjectIssues);
+	TestFalse("A caller outside the scanned folder should keep the event alive", ReportsOpenDoor(ProjectIssues));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStaticLinterCacheTest, "BlueprintProfiler.StaticLinter.LintCache",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FStaticLinterCacheTest::RunTest(const FString& Parameters)
+{
+	FBlueprintLintSnapshot Snapshot;
+	Snapshot.BlueprintPath = TEXT("/Game/Test/BP_Cached.BP_Cached");
+	Snapshot.BlueprintName = TEXT("BP_Cached");
+
+	FLintGraphSnapshot& EventGraph = Snapshot.Graphs.AddDefaulted_GetRef();
+	EventGraph.Name = TEXT("EventGraph");
+
+	FLintNodeSnapshot& Node = EventGraph.Nodes.AddDefaulted_GetRef();
+	Node.Kind = ELintNodeKind::CallFunction;
+	Node.MemberName = TEXT("PrintString");
+	Node.NodeGuid = FGuid::NewGuid();
+	FLintPinSnapshot& Pin = Node.Pins.AddDefaulted_GetRef();
+	Pin.bExec = true;
+	Pin.LinkedNodes.Add(INDEX_NONE);
+
+	FScanConfiguration Config;
+	const FIoHash PackageHash = FIoHash::HashBuffer(TEXT("BP_Cached"), 9 * sizeof(TCHAR));
+
+	TSharedRef<FStaticLinterCache::FEntry> Entry = MakeShared<FStaticLinterCache::FEntry>();
+	Entry->PackageHash = PackageHash;
+	Entry->ChecksMask = FStaticLinterCache::GetChecksMask(Config.EnabledChecks);
+	Entry->bFunctionUsageResolved = true;
+	Entry->Snapshot = MakeShared<const FBlueprintLintSnapshot>(Snapshot);
+	FLintIssue& Issue = Entry->LocalIssues.AddDefaulted_GetRef();
+	Issue.Type = ELintIssueType::OrphanNode;
+	Issue.Description = TEXT("Cached issue");
+	Issue.NodeGuid = Node.NodeGuid;
+
+	Entry->LoadSeconds = 0.5f;
+	Entry->AnalysisSeconds = 0.25f;
+
+	FStaticLinterCache Cache;
+	Cache.Add(TEXT("/Game/Test/BP_Cached"), Entry);
+
+	const FString FilePath = FPaths::AutomationTransientDir() / TEXT("LintCacheTest.bin");
+	TestTrue("Cache should be written", Cache.Save(FilePath));
+
+	FStaticLinterCache Loaded;
+	TestTrue("Cache should be read back", Loaded.Load(FilePath));
+
+	// 损坏的计数和截断的文件都应整体丢弃缓存，而不是按计数分配内存
+	TArray<uint8> CacheBytes;
+	FFileHelper::LoadFileToArray(CacheBytes, *FilePath);
+	IFileManager::Get().Delete(*FilePath);
+
+	const FString CorruptPath = FPaths::AutomationTransientDir() / TEXT("LintCacheCorruptTest.bin");
+	FStaticLinterCache Corrupt;
+	TArray<uint8> HugeCount = CacheBytes;
+	FMemory::Memset(HugeCount.GetData() + 2 * sizeof(uint32), 0x7F, sizeof(int32));
+	FFileHelper::SaveArrayToFile(HugeCount, *CorruptPath);
+	TestFalse("Entry count larger than the file should be rejected", Corrupt.Load(CorruptPath));
+	TestEqual("Rejected cache should be empty", Corrupt.Num(), 0);
+
+	FFileHelper::SaveArrayToFile(TArrayView<const uint8>(CacheBytes.GetData(), CacheBytes.Num() / 2), *CorruptPath);
+	TestFalse("Truncated cache should be rejected", Corrupt.Load(CorruptPath));
+	TestEqual("Truncated cache should be empty", Corrupt.Num(), 0);
+	IFileManager::Get().Delete(*CorruptPath);
+
+	TestEqual("Loaded cache should contain the entry", Loaded.Num(), 1);
+	TestNull("Changed package hash should miss", Loaded.Find(TEXT("/Game/Test/BP_Cached"), FIoHash::HashBuffer(TEXT("x"), sizeof(TCHAR)), true, true).Get());
+
+	TSharedPtr<const FStaticLinterCache::FEntry> Found = Loaded.Find(TEXT("/Game/Test/BP_Cached"), PackageHash, true, true);
+	TestNotNull("Unchanged package hash should hit", Found.Get());
+	if (Found.IsValid())
+	{
+		TestEqual("Checks mask should round-trip", Found->ChecksMask, Entry->ChecksMask);
+		TestEqual("Measured timings should round-trip", Found->LoadSeconds + Found->AnalysisSeconds, 0.75f);
+		TestEqual("Cached issues should round-trip", Found->LocalIssues.Num(), 1);
+		TestTrue("Cached issue should keep its node", Found->LocalIssues.Num() == 1 && Found->LocalIssues[0].NodeGuid == Node.NodeGuid);
+		TestEqual("Snapshot graphs should round-trip", Found->Snapshot->Graphs.Num(), 1);
+		TestTrue("Snapshot node names should round-trip", Found->Snapshot->Graphs.Num() == 1
+			&& Found->Snapshot->Graphs[0].Nodes.Num() == 1 && Found->Snapshot->Graphs[0].Nodes[0].MemberName == TEXT("PrintString"));
+	}
+
+	// 只有引用信息的条目不能替代完整快照
+	TSharedRef<FStaticLinterCache::FEntry> ReferenceEntry = MakeShared<FStaticLinterCache::FEntry>();
+	ReferenceEntry->PackageHash = PackageHash;
+	ReferenceEntry->bReferencesOnly = true;
+	ReferenceEntry->CallSites.Functions.Add(TEXT("PrintString"));
+	Loaded.Add(TEXT("/Game/Test/BP_Reference"), ReferenceEntry);
+	TestNull("Reference-only entry should not satisfy a full scan", Loaded.Find(TEXT("/Game/Test/BP_Reference"), PackageHash, true, false).Get());
+	TestNotNull("Reference-only entry should satisfy a reference lookup", Loaded.Find(TEXT("/Game/Test/BP_Reference"), PackageHash, false, false).Get());
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStaticLinterRegistryPrefilterTest, "BlueprintProfiler.StaticLinter.RegistryPrefilter",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FStaticLinterRegistryPrefilterTest::RunTest(const FString& Parameters)
+{
+	const FScanConfiguration Config;
+	const FTopLevelAssetPath BlueprintClass = UBlueprint::StaticClass()->GetClassPathName();
+
+	// Untagged assets (saved before the plugin was enabled) must always be loaded
+	const FAssetData Untagged(TEXT("/Game/Test/BP_Untagged"), TEXT("/Game/Test"), TEXT("BP_Untagged"), BlueprintClass);
+	TestEqual("Untagged asset should keep every enabled check",
+		FBlueprintLintTags::GetApplicableChecks(Untagged, Config.EnabledChecks).Num(), Config.EnabledChecks.Num());
+	TestTrue("Untagged asset may have references", FBlueprintLintTags::MayHaveReferences(Untagged));
+
+	FAssetDataTagMap DataOnlyTags;
+	DataOnlyTags.Add(FBlueprintTags::IsDataOnly, TEXT("True"));
+	const FAssetData DataOnly(TEXT("/Game/Test/BP_DataOnly"), TEXT("/Game/Test"), TEXT("BP_DataOnly"), BlueprintClass, DataOnlyTags);
+	TestEqual("Data-only blueprint cannot produce issues", FBlueprintLintTags::GetApplicableChecks(DataOnly, Config.EnabledChecks).Num(), 0);
+	TestFalse("Data-only blueprint has no references", FBlueprintLintTags::MayHaveReferences(DataOnly));
+
+	// Event graph with a single call and no casts, tick or functions
+	FBlueprintLintSnapshot Snapshot;
+	FLintGraphSnapshot& EventGraph = Snapshot.Graphs.AddDefaulted_GetRef();
+	FLintNodeSnapshot& BeginPlay = EventGraph.Nodes.AddDefaulted_GetRef();
+	BeginPlay.Kind = ELintNodeKind::Event;
+	BeginPlay.MemberName = TEXT("ReceiveBeginPlay");
+	FLintNodeSnapshot& Call = EventGraph.Nodes.AddDefaulted_GetRef();
+	Call.Kind = ELintNodeKind::CallFunction;
+	Call.MemberName = TEXT("PrintString");
+
+	FAssetDataTagMap Tags;
+	FBlueprintLintTags::GetTags(Snapshot, Tags);
+	const FAssetData Tagged(TEXT("/Game/Test/BP_Tagged"), TEXT("/Game/Test"), TEXT("BP_Tagged"), BlueprintClass, Tags);
+
+	const TSet<ELintIssueType> Checks = FBlueprintLintTags::GetApplicableChecks(Tagged, Config.EnabledChecks);
+	TestTrue("Graph with nodes can have orphan nodes", Checks.Contains(ELintIssueType::OrphanNode));
+	TestTrue("Graph with nodes can have dead nodes", Checks.Contains(ELintIssueType::DeadNode));
+	TestFalse("Blueprint without casts cannot abuse casts", Checks.Contains(ELintIssueType::CastAbuse));
+	TestFalse("Blueprint without a tick event cannot abuse tick", Checks.Contains(ELintIssueType::TickAbuse));
+	TestFalse("Blueprint without functions cannot have unused functions", Checks.Contains(ELintIssueType::UnusedFunction));
+	TestTrue("Function call should count as a reference", FBlueprintLintTags::MayHaveReferences(Tagged));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStaticLinterReportWriterTest, "BlueprintProfiler.StaticLinter.ReportWriter",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FStaticLinterReportWriterTest::RunTest(const FString& Parameters)
+{
+	TestTrue("Format should follow the extension", FLintReportWriter::ParseFormat(TEXT(""), TEXT("Report.sarif")) == ELintReportFormat::Sarif);
+	TestTrue("Explicit format should win", FLintReportWriter::ParseFormat(TEXT("junit"), TEXT("Report.json")) == ELintReportFormat::JUnit);
+
+	FLintIssue Issue;
+	Issue.Type = ELintIssueType::CastAbuse;
+	Issue.BlueprintPath = TEXT("/Game/Test/BP_Report.BP_Report");
+	Issue.NodeName = TEXT("Cast To \"Pawn\"");
+	Issue.Description = TEXT("Line one\nLine <two>");
+	Issue.Severity = ESeverity::High;
+	Issue.NodeGuid = FGuid::NewGuid();
+
+	const FString JsonPath = FPaths::AutomationTransientDir() / TEXT("LintReportTest.json");
+	{
+		FLintReportWriter Writer;
+		TestTrue("JSON report should open", Writer.Open(JsonPath, ELintReportFormat::Json));
+		Writer.WriteIssues(MakeArrayView(&Issue, 1));
+		Writer.WriteIssues(MakeArrayView(&Issue, 1));
+		TestEqual("Entries should be counted", Writer.GetNumEntries(), 2);
+	}
+
+	FString Json;
+	TestTrue("JSON report should be written", FFileHelper::LoadFileToString(Json, *JsonPath));
+	TSharedPtr<FJsonObject> Root;
+	TestTrue("JSON report should parse", FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Json), Root) && Root.IsValid());
+	if (Root.IsValid())
+	{
+		const TArray<TSharedPtr<FJsonValue>>& Entries = Root->GetArrayField(TEXT("issues"));
+		TestEqual("Both batches should be in the report", Entries.Num(), 2);
+		if (Entries.Num() > 0)
+		{
+			const TSharedPtr<FJsonObject> Entry = Entries[0]->AsObject();
+			TestEqual("Rule should be the issue type name", Entry->GetStringField(TEXT("rule")), FString(TEXT("CastAbuse")));
+			TestEqual("Quotes should round-trip", Entry->GetStringField(TEXT("name")), Issue.NodeName);
+			TestEqual("Newlines should round-trip", Entry->GetStringField(TEXT("message")), Issue.Description);
+		}
+	}
+
+	const FString JUnitPath = FPaths::AutomationTransientDir() / TEXT("LintReportTest.xml");
+	{
+		FLintReportWriter Writer;
+		TestTrue("JUnit report should open", Writer.Open(JUnitPath, ELintReportFormat::JUnit));
+		Writer.WriteIssues(MakeArrayView(&Issue, 1));
+	}
+
+	FString Xml;
+	TestTrue("JUnit report should be written", FFileHelper::LoadFileToString(Xml, *JUnitPath));
+	TestTrue("Markup in messages should be escaped", Xml.Contains(TEXT("Line &lt;two&gt;")));
+	TestTrue("Report should be closed", Xml.TrimEnd().EndsWith(TEXT("</testsuites>")));
+	TestTrue("Test cases should follow the suite header", Xml.Find(TEXT("<testcase")) > Xml.Find(TEXT("<testsuite ")));
+	TestFalse("Streamed test cases should be removed", IFileManager::Get().FileExists(*(JUnitPath + TEXT(".cases"))));
+	TestTrue("Counts should be on the issue suite", Xml.Contains(TEXT("<testsuite name=\"BlueprintProfilerLint\" tests=\"1\" failures=\"1\">")));
+
+	IFileManager::Get().Delete(*JsonPath);
+	IFileManager::Get().Delete(*JUnitPath);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStaticLinterIssueBatchesTest, "BlueprintProfiler.StaticLinter.IssueBatches",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FStaticLinterIssueBatchesTest::RunTest(const FString& Parameters)
+{
+	TSharedPtr<FStaticLinter> Linter = MakeShared<FStaticLinter>();
+	FScanConfiguration Config;
+	Config.EnabledChecks.Empty();
+	Config.EnabledChecks.Add(ELintIssueType::OrphanNode);
+
+	// 每个蓝图一个输出未连接的纯节点
+	auto MakeItem = [](const TCHAR* BlueprintPath)
+	{
+		TSharedRef<FBlueprintLintSnapshot> Snapshot = MakeShared<FBlueprintLintSnapshot>();
+		Snapshot->BlueprintPath = BlueprintPath;
+		FLintGraphSnapshot& Graph = Snapshot->Graphs.AddDefaulted_GetRef();
+		FLintNodeSnapshot& Node = Graph.Nodes.AddDefaulted_GetRef();
+		Node.Kind = ELintNodeKind::VariableGet;
+		Node.Title = TEXT("Get Health");
+		Node.bIsK2Node = true;
+		Node.bPure = true;
+		Node.NodeGuid = FGuid::NewGuid();
+
+		FLintScanItem Item;
+		Item.Snapshot = Snapshot;
+		return Item;
+	};
+
+	FScanTask Task(Linter, Config, true);
+	TArray<FLintScanItem> Batch;
+	Batch.Add(MakeItem(TEXT("/Game/Test/BP_BatchA.BP_BatchA")));
+	Batch.Add(MakeItem(TEXT("/Game/Test/BP_BatchB.BP_BatchB")));
+	Task.AddSnapshots(MoveTemp(Batch));
+
+	TArray<FLintIssue> Issues;
+	TestTrue("First blueprint should be published once its batch is done", Task.DequeueIssueBatch(Issues));
+	TestEqual("Batch should hold the issues of a single blueprint", Issues.Num(), 1);
+	TestEqual("Batches should arrive in asset order", Issues.Num() > 0 ? Issues[0].BlueprintPath : FString(), FString(TEXT("/Game/Test/BP_BatchA.BP_BatchA")));
+	TestTrue("Second blueprint should have its own batch", Task.DequeueIssueBatch(Issues));
+	TestEqual("Second batch should belong to the second blueprint", Issues.Num() > 0 ? Issues[0].BlueprintPath : FString(), FString(TEXT("/Game/Test/BP_BatchB.BP_BatchB")));
+	TestFalse("Nothing else should be queued", Task.DequeueIssueBatch(Issues));
+
+	// 没有跨蓝图检查启用时，Finish 不再产生批次
+	Task.Finish(FLintReferenceIndex());
+	TestFalse("Blueprints without cross-blueprint issues should not send empty batches", Task.DequeueIssueBatch(Issues));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStaticLinterCostModelTest, "BlueprintProfiler.StaticLinter.CostModel",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FStaticLinterCostModelTest::RunTest(const FString& Parameters)
+{
+	const FTopLevelAssetPath BlueprintClass = UBlueprint::StaticClass()->GetClassPathName();
+	auto MakeTaggedAsset = [&BlueprintClass](const TCHAR* Name, int32 NumNodes)
+	{
+		FBlueprintLintSnapshot Snapshot;
+		FLintGraphSnapshot& Graph = Snapshot.Graphs.AddDefaulted_GetRef();
+		Graph.Nodes.SetNum(NumNodes);
+
+		FAssetDataTagMap Tags;
+		FBlueprintLintTags::GetTags(Snapshot, Tags);
+		const FString PackageName = FString(TEXT("/Game/Test/")) + Name;
+		return FAssetData(*PackageName, TEXT("/Game/Test"), Name, BlueprintClass, Tags);
+	};
+
+	const FAssetData Small = MakeTaggedAsset(TEXT("BP_CostSmall"), 10);
+	const FAssetData Large = MakeTaggedAsset(TEXT("BP_CostLarge"), 5000);
+	TestEqual("Node count should come from the tags", FBlueprintLintTags::GetNumNodes(Large), 5000);
+	TestTrue("More nodes should cost more", FStaticLinter::EstimateAssetCost(Large, nullptr, false) > FStaticLinter::EstimateAssetCost(Small, nullptr, false));
+	TestTrue("Cost should never be zero", FStaticLinter::EstimateAssetCost(Small, nullptr, false) > 0.0f);
+
+	// 实测耗时优先于估算；包未变化时不计加载时间
+	FStaticLinterCache::FEntry Measured;
+	Measured.LoadSeconds = 2.0f;
+	Measured.AnalysisSeconds = 0.5f;
+	TestEqual("Measured timings should win over the tags", FStaticLinter::EstimateAssetCost(Small, &Measured, false), 2.5f);
+	TestEqual("Unchanged package should not pay for loading", FStaticLinter::EstimateAssetCost(Small, &Measured, true), 0.5f);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStaticLinterAnalysisTimingTest, "BlueprintProfiler.StaticLinter.AnalysisTiming",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FStaticLinterAnalysisTimingTest::RunTest(const FString& Parameters)
+{
+	FStaticLinter Linter;
+	FScanConfiguration Config;
+	Config.EnabledChecks.Empty();
+	Config.EnabledChecks.Add(ELintIssueType::OrphanNode);
+
+	FBlueprintLintSnapshot Snapshot;
+	Snapshot.BlueprintPath = TEXT("/Game/Test/BP_Timing.BP_Timing");
+	FLintGraphSnapshot& Graph = Snapshot.Graphs.AddDefaulted_GetRef();
+	for (int32 NodeIndex = 0; NodeIndex < 200; ++NodeIndex)
+	{
+		FLintNodeSnapshot& Node = Graph.Nodes.AddDefaulted_GetRef();
+		Node.Title = TEXT("Get Health");
+		Node.bIsK2Node = true;
+		Node.bPure = true;
+	}
+
+	FLintAnalysisTiming Timing;
+	TArray<FLintIssue> Issues;
+	Linter.AnalyzeSnapshot(Snapshot, Config, nullptr, Issues, &Timing);
+	TestEqual("Every unconnected pure node should be reported", Issues.Num(), 200);
+	TestTrue("Enabled check should be timed", Timing.CheckSeconds[static_cast<int32>(ELintIssueType::OrphanNode)] > 0.0f);
+	TestEqual("Disabled check should not be timed", Timing.CheckSeconds[static_cast<int32>(ELintIssueType::CastAbuse)], 0.0f);
+	TestTrue("Total should include every stage", Timing.GetTotalSeconds() >= Timing.CheckSeconds[static_cast<int32>(ELintIssueType::OrphanNode)] + Timing.GraphIndexSeconds);
+
+	FLintAnalysisTiming Totals;
+	Totals.Add(Timing);
+	Totals.Add(Timing);
+	TestEqual("Totals should add up per stage", Totals.GraphIndexSeconds, Timing.GraphIndexSeconds * 2.0f);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStaticLinterMemoryBudgetTest, "BlueprintProfiler.StaticLinter.MemoryBudget",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FStaticLinterMemoryBudgetTest::RunTest(const FString& Parameters)
+{
+	// A running editor always uses more than a 1 MB budget
+	FScanConfiguration Config;
+	Config.MemoryBudgetMB = 1;
+	const uint64 BudgetBytes = FStaticLinter::GetMemoryBudgetBytes(Config);
+	TestTrue("Budget should come from the configuration", BudgetBytes == 1024 * 1024);
+	TestTrue("Default budget should be half of physical memory",
+		FStaticLinter::GetMemoryBudgetBytes(FScanConfiguration()) == FPlatformMemory::GetConstants().TotalPhysical / 2);
+
+	const uint64 UsedBytes = FPlatformMemory::GetStats().UsedPhysical;
+	TestTrue("Over budget after 16 packages and 2 s should release", FStaticLinter::ShouldReleaseLoadedPackages(16, 2.0, UsedBytes, BudgetBytes));
+	TestFalse("Within budget should not release", FStaticLinter::ShouldReleaseLoadedPackages(1000, 60.0, UsedBytes, UsedBytes));
+	TestFalse("Fewer than 16 new packages should not release", FStaticLinter::ShouldReleaseLoadedPackages(15, 60.0, UsedBytes, BudgetBytes));
+	TestFalse("Less than 2 s after the last release should not release", FStaticLinter::ShouldReleaseLoadedPackages(1000, 1.9, UsedBytes, BudgetBytes));
+
+	// 扫描加载的包中，用户正在使用的保持加载
+	UPackage* Package = CreatePackage(TEXT("/Temp/BlueprintProfilerTest/MemoryBudgetCurve"));
+	UCurveFloat* Curve = NewObject<UCurveFloat>(Package, TEXT("MemoryBudgetCurve"), RF_Public | RF_Standalone);
+	Package->SetDirtyFlag(false);
+	TestFalse("Missing package should be skipped", FStaticLinter::CanUnloadScanPackage(nullptr));
+	TestTrue("Unmodified package should be unloaded", FStaticLinter::CanUnloadScanPackage(Package));
+
+	Package->SetDirtyFlag(true);
+	TestFalse("Modified package should stay loaded", FStaticLinter::CanUnloadScanPackage(Package));
+	Package->SetDirtyFlag(false);
+
+	UAssetEditorSubsystem* AssetEditorSubsystem = GEditor ? GEditor->GetEditorSubsystem<UAssetEditorSubsystem>() : nullptr;
+	if (AssetEditorSubsystem && AssetEditorSubsystem->OpenEditorForAsset(Curve))
+	{
+		TestFalse("Package open in an editor should stay loaded", FStaticLinter::CanUnloadScanPackage(Package));
+		AssetEditorSubsystem->CloseAllEditorsForAsset(Curve);
+		TestTrue("Closed package should be unloaded again", FStaticLinter::CanUnloadScanPackage(Package));
+	}
+	else
+	{
+		AddInfo(TEXT("Asset editors are unavailable, open-editor case skipped"));
+	}
+
+	UPackage* WorldPackage = CreatePackage(TEXT("/Temp/BlueprintProfilerTest/MemoryBudgetWorld"));
+	UWorld* World = UWorld::CreateWorld(EWorldType::Inactive, false, TEXT("MemoryBudgetWorld"), WorldPackage, false);
+	WorldPackage->SetDirtyFlag(false);
+	TestFalse("World package should stay loaded", FStaticLinter::CanUnloadScanPackage(WorldPackage));
+
+	World->DestroyWorld(false);
+	Curve->ClearFlags(RF_Public | RF_Standalone);
+	Curve->MarkAsGarbage();
+	return true;
+}
@@ -4,6 +4,7 @@
 #include "BlueprintProfilerLocalization.h"
 #include "Widgets/Layout/SBorder.h"
 #include "Widgets/Layout/SBox.h"
+#include "Widgets/Layout/SExpandableArea.h"
 #include "Widgets/Layout/SSplitter.h"
 #include "Widgets/Layout/SScrollBox.h"
 #include "Widgets/Input/SButton.h"
@@ -50,11 +51,22 @@ void SBlueprintProfilerWidget::Construct(const FArguments& InArgs)
 	// Bind to memory analyzer events
 	MemoryAnalyzer->OnReferenceCountComplete.AddRaw(this, &SBlueprintProfilerWidget::OnReferenceCountAnalysisComplete);
 	MemoryAnalyzer->OnAnalysisProgress.AddRaw(this, &SBlueprintProfilerWidget::OnReferenceCountProgress);
+	MemoryAnalyzer->OnMemoryAuditComplete.AddRaw(this, &SBlueprintProfilerWidget::OnMemoryAuditComplete);
+
+	// Background exporter; the widget owns it, so it is cancelled with the widget
+	DataExporter = MakeShared<FProfilerDataExporter>();
+	DataExporter->OnProgress.AddRaw(this, &SBlueprintProfilerWidget::OnExportProgress);
+	DataExporter->OnComplete.AddRaw(this, &SBlueprintProfilerWidget::OnExportComplete);
 
 	// Initialize state
 	CurrentRecordingState = ERecordingState::Stopped;
 	bIsStaticScanning = false;
 	bIsMemoryAnalyzing = false;
+	bLintIssuesStreamed = false;
+	bLintListDirty = false;
+	NumStreamedLintIssues = 0;
+	LastLiveUpdateSerial = 0;
+	RowStore.GetSearchText = [this](const TSharedPtr<FProfilerDataItem>& Item) { return BuildSearchText(Item); };
 	CurrentSortBy = BP_LOCTEXT("Severity", "严重程度", "Severity").ToString();
 	CurrentFilterBy = BP_LOCTEXT("All", "全部", "All").ToString();
 
@@ -82,8 +94,12 @@ void SBlueprintProfilerWidget::Construct(const FArguments& InArgs)
 
 	// Bind analyzer events
 	StaticLinter->OnScanComplete.AddSP(this, &SBlueprintProfilerWidget::OnStaticScanComplete);
+	StaticLinter->OnIssuesBatch.AddSP(this, &SBlueprintProfilerWidget::OnStaticIssuesBatch);
 	StaticLinter->OnScanProgress.AddSP(this, &SBlueprintProfilerWidget::OnStaticScanProgress);
 
+	RuntimeProfiler->OnBlueprintHitch.AddSP(this, &SBlueprintProfilerWidget::OnBlueprintHitch);
+	RuntimeProfiler->OnLiveUpdate.AddSP(this, &SBlueprintProfilerWidget::OnRuntimeLiveUpdate);
+
 	// 绑定 PIE 结束事件（自动停止录制时刷新数据）
 	FEditorDelegates::EndPIE.AddSP(this, &SBlueprintProfilerWidget::OnPIEEnd);
 
@@ -160,6 +176,26 @@ void SBlueprintProfilerWidget::Construct(const FArguments& InArgs)
 							.Visibility(EVisibility::Collapsed)
 						]
 						
+						// 扫描结束后的耗时构成，默认折叠
+						+ SVerticalBox::Slot()
+						.AutoHeight()
+						.Padding(0, 2)
+						[
+							SAssignNew(ScanCostArea, SExpandableArea)
+							.InitiallyCollapsed(true)
+							.Visibility(EVisibility::Collapsed)
+							.HeaderContent()
+							[
+								SNew(STextBlock)
+								.Text(BP_LOCTEXT("ScanCostTitle", "扫描耗时", "Scan cost"))
+							]
+							.BodyContent()
+							[
+								SAssignNew(ScanCostText, STextBlock)
+								.Font(FCoreStyle::GetDefaultFontStyle("Mono", 9))
+							]
+						]
+						
 						// Runtime Profiler Controls
 						+ SVerticalBox::Slot()
 						.AutoHeight()
@@ -396,10 +432,26 @@ void SBlueprintProfilerWidget::Construct(const FArguments& InArgs)
 						.AutoHeight()
 						.Padding(0, 2)
 						[
-							SAssignNew(StartMemoryAnalysisButton, SButton)
-							.Text(BP_LOCTEXT("StartMemoryAnalysis", "分析引用", "Analyze References"))
-							.OnClicked(this, &SBlueprintProfilerWidget::OnStartMemoryAnalysis)
-							.IsEnabled(this, &SBlueprintProfilerWidget::CanStartMemoryAnalysis)
+							SNew(SHorizontalBox)
+							+ SHorizontalBox::Slot()
+							.AutoWidth()
+							.Padding(0, 0, 4, 0)
+							[
+								SAssignNew(StartMemoryAnalysisButton, SButton)
+								.Text(BP_LOCTEXT("StartMemoryAnalysis", "分析引用", "Analyze References"))
+								.OnClicked(this, &SBlueprintProfilerWidget::OnStartMemoryAnalysis)
+								.IsEnabled(this, &SBlueprintProfilerWidget::CanStartMemoryAnalysis)
+							]
+
+							+ SHorizontalBox::Slot()
+							.AutoWidth()
+							[
+								SNew(SButton)
+								.Text(BP_LOCTEXT("StartMemoryAudit", "内存审计", "Memory Audit"))
+								.ToolTipText(BP_LOCTEXT("StartMemoryAuditTooltip", "按保留大小对 /Game 下所有蓝图排名", "Rank every blueprint under /Game by retained size"))
+								.OnClicked(this, &SBlueprintProfilerWidget::OnStartMemoryAudit)
+								.IsEnabled(this, &SBlueprintProfilerWidget::CanStartMemoryAnalysis)
+							]
 						]
 						
 						// Export Controls
@@ -424,16 +476,26 @@ void SBlueprintProfilerWidget::Construct(const FArguments& InArgs)
 								SNew(SButton)
 								.Text(BP_LOCTEXT("ExportCSV", "导出 CSV", "Export CSV"))
 								.OnClicked(this, &SBlueprintProfilerWidget::OnExportToCSV)
-								.IsEnabled(this, &SBlueprintProfilerWidget::HasDataToExport)
+								.IsEnabled(this, &SBlueprintProfilerWidget::CanStartExport)
 							]
 							
 							+ SHorizontalBox::Slot()
 							.AutoWidth()
+							.Padding(0, 0, 4, 0)
 							[
 								SNew(SButton)
 								.Text(BP_LOCTEXT("ExportJSON", "导出 JSON", "Export JSON"))
 								.OnClicked(this, &SBlueprintProfilerWidget::OnExportToJSON)
-								.IsEnabled(this, &SBlueprintProfilerWidget::HasDataToExport)
+								.IsEnabled(this, &SBlueprintProfilerWidget::CanStartExport)
+							]
+							
+							+ SHorizontalBox::Slot()
+							.AutoWidth()
+							[
+								SNew(SButton)
+								.Text(BP_LOCTEXT("CancelExport", "取消导出", "Cancel Export"))
+								.OnClicked(this, &SBlueprintProfilerWidget::OnCancelExport)
+								.IsEnabled(this, &SBlueprintProfilerWidget::IsExporting)
 							]
 						]
 					]
@@ -697,6 +759,48 @@ void SBlueprintProfilerWidget::Construct(const FArguments& InArgs)
 							.FillWidth(0.1f)
 						)
 					]
+
+					// Hitch List - frames whose Blueprint time exceeded the budget
+					+ SVerticalBox::Slot()
+					.AutoHeight()
+					.Padding(0, 8, 0, 4)
+					[
+						SNew(STextBlock)
+						.Text(this, &SBlueprintProfilerWidget::GetHitchListHeaderText)
+						.Font(FAppStyle::GetFontStyle("DetailsView.CategoryFontStyle"))
+					]
+
+					+ SVerticalBox::Slot()
+					.AutoHeight()
+					[
+						SNew(SBox)
+						.HeightOverride(160.0f)
+						[
+							SAssignNew(HitchListView, SListView<TSharedPtr<FBlueprintFrameBreakdown>>)
+							.ListItemsSource(&HitchItems)
+							.OnGenerateRow(this, &SBlueprintProfilerWidget::OnGenerateHitchRow)
+							.OnMouseButtonDoubleClick(this, &SBlueprintProfilerWidget::OnHitchDoubleClicked)
+							.HeaderRow
+							(
+								SNew(SHeaderRow)
+								+ SHeaderRow::Column("Frame")
+								.DefaultLabel(BP_LOCTEXT("HitchFrameColumn", "帧", "Frame"))
+								.FillWidth(0.12f)
+
+								+ SHeaderRow::Column("Time")
+								.DefaultLabel(BP_LOCTEXT("HitchTimeColumn", "蓝图耗时", "Blueprint Time"))
+								.FillWidth(0.13f)
+
+								+ SHeaderRow::Column("Blueprints")
+								.DefaultLabel(BP_LOCTEXT("HitchBlueprintsColumn", "主要蓝图", "Top Blueprints"))
+								.FillWidth(0.35f)
+
+								+ SHeaderRow::Column("Nodes")
+								.DefaultLabel(BP_LOCTEXT("HitchNodesColumn", "主要节点", "Top Nodes"))
+								.FillWidth(0.4f)
+							)
+						]
+					]
 				]
 			]
 		]
@@ -718,87 +822,65 @@ void SBlueprintProfilerWidget::Construct(const FArguments& InArgs)
 // Data management methods
 void SBlueprintProfilerWidget::RefreshData()
 {
-	AllDataItems.Empty();
+	RowStore.RemoveRows(EProfilerDataType::Memory);
 	
 	// Collect runtime data
+	RowStore.BeginUpdate(EProfilerDataType::Runtime);
 	if (RuntimeProfiler.IsValid())
 	{
 		TArray<FNodeExecutionData> RuntimeData = RuntimeProfiler->GetExecutionData();
 		for (const FNodeExecutionData& Data : RuntimeData)
 		{
-			AllDataItems.Add(CreateDataItemFromRuntimeData(Data));
+			UpdateRuntimeRow(Data);
 		}
 	}
+	RowStore.EndUpdate(EProfilerDataType::Runtime);
 	
 	// Collect lint issues
+	RowStore.BeginUpdate(EProfilerDataType::Lint);
 	if (StaticLinter.IsValid())
 	{
-		TArray<FLintIssue> LintIssues = StaticLinter->GetIssues();
-		for (const FLintIssue& Issue : LintIssues)
+		for (const FLintIssue& Issue : StaticLinter->GetIssues())
 		{
-			AllDataItems.Add(CreateDataItemFromLintIssue(Issue));
+			UpdateLintRow(Issue);
 		}
 	}
+	RowStore.EndUpdate(EProfilerDataType::Lint);
 	
 	UpdateFilteredData();
-	
-	if (DataListView.IsValid())
-	{
-		DataListView->RequestListRefresh();
-	}
+	RefreshHitchList();
 }
 
 void SBlueprintProfilerWidget::SetRuntimeData(const TArray<FNodeExecutionData>& Data)
 {
-	// Clear existing runtime data
-	AllDataItems.RemoveAll([](const TSharedPtr<FProfilerDataItem>& Item)
-	{
-		return Item.IsValid() && Item->Type == EProfilerDataType::Runtime;
-	});
-
-	// Add new runtime data
+	// 统计未变的节点保留原来的列表项，不在新数据中的节点被移除
+	RowStore.BeginUpdate(EProfilerDataType::Runtime);
 	for (const FNodeExecutionData& ExecutionData : Data)
 	{
-		AllDataItems.Add(CreateDataItemFromRuntimeData(ExecutionData));
+		UpdateRuntimeRow(ExecutionData);
 	}
+	RowStore.EndUpdate(EProfilerDataType::Runtime);
 
 	UpdateFilteredData();
-
-	if (DataListView.IsValid())
-	{
-		DataListView->RequestListRefresh();
-	}
 }
 
 void SBlueprintProfilerWidget::SetLintIssues(const TArray<FLintIssue>& Issues)
 {
-	// Clear existing lint data
-	AllDataItems.RemoveAll([](const TSharedPtr<FProfilerDataItem>& Item)
-	{
-		return Item.IsValid() && Item->Type == EProfilerDataType::Lint;
-	});
-	
-	// Add new lint issues
+	// Replace lint rows, keeping the ones of unchanged issues
+	RowStore.BeginUpdate(EProfilerDataType::Lint);
 	for (const FLintIssue& Issue : Issues)
 	{
-		AllDataItems.Add(CreateDataItemFromLintIssue(Issue));
+		UpdateLintRow(Issue);
 	}
+	RowStore.EndUpdate(EProfilerDataType::Lint);
 	
 	UpdateFilteredData();
-	
-	if (DataListView.IsValid())
-	{
-		DataListView->RequestListRefresh();
-	}
 }
 
 void SBlueprintProfilerWidget::SetMemoryData(const TArray<FMemoryAnalysisResult>& Data)
 {
 	// Clear existing memory data
-	AllDataItems.RemoveAll([](const TSharedPtr<FProfilerDataItem>& Item)
-	{
-		return Item.IsValid() && Item->Type == EProfilerDataType::Memory;
-	});
+	RowStore.RemoveRows(EProfilerDataType::Memory);
 	
 	// Add new memory data
 	for (const FMemoryAnalysisResult& MemoryData : Data)
@@ -808,21 +890,10 @@ void SBlueprintProfilerWidget::SetMemoryData(const TArray<FMemoryAnalysisResult>
 	}
 	
 	UpdateFilteredData();
-	
-	if (DataListView.IsValid())
-	{
-		DataListView->RequestListRefresh();
-	}
 }
 
 void SBlueprintProfilerWidget::SetAssetReferenceData(const TArray<FAssetReferenceCount>& AssetReferences)
 {
-	// Clear existing memory data (we reuse Memory type for reference counts)
-	AllDataItems.RemoveAll([](const TSharedPtr<FProfilerDataItem>& Item)
-	{
-		return Item.IsValid() && Item->Type == EProfilerDataType::Memory;
-	});
-	
 	// Load asset registry for looking up assets
 	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
 	IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
@@ -880,18 +951,15 @@ void SBlueprintProfilerWidget::SetAssetReferenceData(const TArray<FAssetReferenc
 		UniqueItems.Add(AssetName, Item);
 	}
 	
-	// Add all unique items to the list
+	// Replace memory rows (we reuse Memory type for reference counts), keyed by asset name
+	RowStore.BeginUpdate(EProfilerDataType::Memory);
 	for (auto& Pair : UniqueItems)
 	{
-		AllDataItems.Add(Pair.Value);
+		RowStore.UpdateRow(FProfilerRowStore::FHashBuilder(EProfilerDataType::Memory).Add(Pair.Key).Finish(), Pair.Value);
 	}
+	RowStore.EndUpdate(EProfilerDataType::Memory);
 	
 	UpdateFilteredData();
-	
-	if (DataListView.IsValid())
-	{
-		DataListView->RequestListRefresh();
-	}
 }
 
 // UI event handlers
@@ -982,21 +1050,14 @@ FReply SBlueprintProfilerWidget::OnResetRuntimeData()
 	{
 		RuntimeProfiler->ResetData();
 		CurrentRecordingState = RuntimeProfiler->GetRecordingState();
+		RefreshHitchList();
 		
 		// Clear runtime data from display
-		AllDataItems.RemoveAll([](const TSharedPtr<FProfilerDataItem>& Item)
-		{
-			return Item.IsValid() && Item->Type == EProfilerDataType::Runtime;
-		});
+		RowStore.RemoveRows(EProfilerDataType::Runtime);
 		
 		UpdateFilteredData();
 		UpdateRecordingStateDisplay();
 		
-		if (DataListView.IsValid())
-		{
-			DataListView->RequestListRefresh();
-		}
-		
 		if (StatusText.IsValid())
 		{
 			StatusText->SetText(BP_LOCTEXT("StatusDataReset", "运行时数据已重置", "Runtime data reset"));
@@ -1014,11 +1075,11 @@ FReply SBlueprintProfilerWidget::OnSaveSessionData()
 		if (DesktopPlatform)
 		{
 			FString DefaultPath = RuntimeProfiler->GetSessionDataDirectory();
-			FString DefaultFileName = RuntimeProfiler->GetCurrentSession().SessionName + TEXT(".json");
+			FString DefaultFileName = RuntimeProfiler->GetCurrentSession().SessionName + BlueprintProfilerSessionFile::GetExtension();
 			TArray<FString> SavedFiles;
 			
-			// File types filter
-			const FString FileTypes = TEXT("JSON Files (*.json)|*.json");
+			// File types filter (binary session first, JSON kept as an export format)
+			const FString FileTypes = TEXT("Blueprint Profiler Sessions (*.bpsession)|*.bpsession|JSON Files (*.json)|*.json");
 			
 			bool bSuccess = DesktopPlatform->SaveFileDialog(
 				FSlateApplication::Get().FindBestParentWindowHandleForDialogs(nullptr),
@@ -1059,7 +1120,7 @@ FReply SBlueprintProfilerWidget::OnLoadSessionData()
 			TArray<FString> SelectedFiles;
 			
 			// File types filter
-			const FString FileTypes = TEXT("JSON Files (*.json)|*.json|All Files (*.*)|*.*");
+			const FString FileTypes = TEXT("Blueprint Profiler Sessions (*.bpsession)|*.bpsession|JSON Files (*.json)|*.json|All Files (*.*)|*.*");
 			
 			bool bSuccess = DesktopPlatform->OpenFileDialog(
 				FSlateApplication::Get().FindBestParentWindowHandleForDialogs(nullptr),
@@ -1146,6 +1207,11 @@ FReply SBlueprintProfilerWidget::OnStartStaticScan()
 			TimeRemainingText->SetVisibility(EVisibility::Visible);
 		}
 		
+		if (ScanCostArea.IsValid())
+		{
+			ScanCostArea->SetVisibility(EVisibility::Collapsed);
+		}
+		
 		// Start scan on game thread
 		StaticLinter->ScanProject();
 	}
@@ -1221,6 +1287,11 @@ FReply SBlueprintProfilerWidget::OnScanSelectedFolders()
 						TimeRemainingText->SetVisibility(EVisibility::Visible);
 					}
 
+					if (ScanCostArea.IsValid())
+					{
+						ScanCostArea->SetVisibility(EVisibility::Collapsed);
+					}
+
 					// Start folder scan
 					StaticLinter->ScanSelectedFolders(AssetPaths);
 				}
@@ -1330,7 +1401,7 @@ void SBlueprintProfilerWidget::OnReferenceCountAnalysisComplete(const FMemoryAna
 	{
 		StatusText->SetText(FText::Format(
 			BP_LOCTEXT("StatusRefCountComplete", "引用分析完成。发现 {0} 个被引用的资产，显示前 {1} 个。", "Reference analysis complete. Found {0} referenced assets, showing top {1}."),
-			FText::AsNumber(MemoryAnalyzer->GetAssetReferenceCounts().Num()),
+			FText::AsNumber(MemoryAnalyzer->GetNumAssetReferenceCounts()),
 			FText::AsNumber(TopAssets.Num())
 		));
 	}
@@ -1338,155 +1409,214 @@ void SBlueprintProfilerWidget::OnReferenceCountAnalysisComplete(const FMemoryAna
 	bIsMemoryAnalyzing = false;
 }
 
-FReply SBlueprintProfilerWidget::OnExportToCSV()
+FReply SBlueprintProfilerWidget::OnStartMemoryAudit()
 {
-	if (!HasDataToExport())
+	if (MemoryAnalyzer.IsValid())
 	{
-		return FReply::Handled();
-	}
+		bIsMemoryAnalyzing = true;
 
-	IDesktopPlatform* DesktopPlatform = FDesktopPlatformModule::Get();
-	if (DesktopPlatform)
-	{
-		TArray<FString> SaveFilenames;
-		FString DefaultPath = FPaths::ProjectSavedDir();
-		FString DefaultFile = FString::Printf(TEXT("BlueprintProfiler_%s.csv"), *FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S")));
-		
-		bool bOpened = DesktopPlatform->SaveFileDialog(
-			FSlateApplication::Get().FindBestParentWindowHandleForDialogs(nullptr),
-			TEXT("Export to CSV"),
-			DefaultPath,
-			DefaultFile,
-			TEXT("CSV Files (*.csv)|*.csv"),
-			EFileDialogFlags::None,
-			SaveFilenames
-		);
+		if (StatusText.IsValid())
+		{
+			StatusText->SetText(BP_LOCTEXT("StatusAuditing", "正在审计蓝图内存...", "Auditing blueprint memory..."));
+		}
 
-		if (bOpened && SaveFilenames.Num() > 0)
+		if (ProgressBar.IsValid())
 		{
-			FString FilePath = SaveFilenames[0];
-			FString CSVContent = TEXT("Type,Name,Blueprint,Category,Value,Severity\n");
-			
-			for (const TSharedPtr<FProfilerDataItem>& Item : FilteredDataItems)
-			{
-				if (Item.IsValid())
-				{
-					CSVContent += FString::Printf(TEXT("%s,%s,%s,%s,%.2f,%s\n"),
-						*GetDataTypeText(Item->Type).ToString(),
-						*Item->Name.Replace(TEXT(","), TEXT(" ")),
-						*Item->BlueprintName,
-						*Item->Category,
-						Item->Value,
-						*GetSeverityText(Item->Severity).ToString()
-					);
-				}
-			}
-			
-			if (FFileHelper::SaveStringToFile(CSVContent, *FilePath))
-			{
-				if (StatusText.IsValid())
-				{
-					StatusText->SetText(FText::Format(
-						BP_LOCTEXT("StatusExportSuccess", "已导出 {0} 个项目到 {1}", "Exported {0} items to {1}"),
-						FText::AsNumber(FilteredDataItems.Num()),
-						FText::FromString(FPaths::GetCleanFilename(FilePath))
-					));
-				}
-			}
-			else
-			{
-				if (StatusText.IsValid())
-				{
-					StatusText->SetText(BP_LOCTEXT("StatusExportFailed", "保存导出文件失败", "Failed to save export file"));
-				}
-			}
+			ProgressBar->SetPercent(0.0f);
+			ProgressBar->SetVisibility(EVisibility::Visible);
 		}
+
+		MemoryAnalyzer->AuditBlueprints({ TEXT("/Game") });
+	}
+	return FReply::Handled();
+}
+
+void SBlueprintProfilerWidget::OnMemoryAuditComplete(const TArray<FBlueprintMemoryAuditEntry>& RankedEntries)
+{
+	// 审计结果与引用计数共用内存类型的列表项
+	RowStore.BeginUpdate(EProfilerDataType::Memory);
+	const float ThresholdMB = MemoryAnalyzer.IsValid() ? MemoryAnalyzer->GetLargeResourceThreshold() : 10.0f;
+	for (const FBlueprintMemoryAuditEntry& Entry : RankedEntries)
+	{
+		TSharedPtr<FProfilerDataItem> Item = MakeShared<FProfilerDataItem>();
+		Item->Type = EProfilerDataType::Memory;
+		Item->Name = Entry.BlueprintName;
+		Item->BlueprintName = Entry.BlueprintName;
+		Item->Category = FText::Format(BP_LOCTEXT("AuditCategory", "保留 {0} MB", "Retained {0} MB"), FText::AsNumber(Entry.RetainedSize)).ToString();
+		Item->Description = FText::Format(
+			BP_LOCTEXT("AuditDesc", "独占 {0} MB, 共享 {1} MB, 硬引用 {2} 个（传递 {3} 个）, 大资源 {4} 个", "Exclusive {0} MB, shared {1} MB, {2} hard references ({3} transitive), {4} large resources"),
+			FText::AsNumber(Entry.ExclusiveSize), FText::AsNumber(Entry.SharedSize), FText::AsNumber(Entry.NumDirectHardReferences),
+			FText::AsNumber(Entry.NumHardDependencies), FText::AsNumber(Entry.LargeReferences.Num())).ToString();
+		Item->Value = Entry.RetainedSize;
+		Item->Severity = Entry.RetainedSize >= ThresholdMB * 10.0f ? ESeverity::High :
+		                (Entry.RetainedSize >= ThresholdMB || Entry.LargeReferences.Num() > 0 ? ESeverity::Medium : ESeverity::Low);
+		RowStore.UpdateRow(FProfilerRowStore::FHashBuilder(EProfilerDataType::Memory).Add(Entry.BlueprintName).Finish(), Item);
+	}
+	RowStore.EndUpdate(EProfilerDataType::Memory);
+
+	UpdateFilteredData();
+
+	if (ProgressBar.IsValid())
+	{
+		ProgressBar->SetVisibility(EVisibility::Collapsed);
+	}
+
+	if (StatusText.IsValid())
+	{
+		StatusText->SetText(FText::Format(
+			BP_LOCTEXT("StatusAuditComplete", "内存审计完成。已按保留大小为 {0} 个蓝图排名。", "Memory audit complete. Ranked {0} blueprints by retained size."),
+			FText::AsNumber(RankedEntries.Num())));
 	}
+
+	bIsMemoryAnalyzing = false;
+}
+
+FReply SBlueprintProfilerWidget::OnExportToCSV()
+{
+	StartExport(EProfilerExportFormat::Csv);
 	return FReply::Handled();
 }
 
 FReply SBlueprintProfilerWidget::OnExportToJSON()
 {
-	if (!HasDataToExport())
+	StartExport(EProfilerExportFormat::Json);
+	return FReply::Handled();
+}
+
+FReply SBlueprintProfilerWidget::OnCancelExport()
+{
+	if (DataExporter.IsValid())
+	{
+		DataExporter->Cancel();
+	}
+	return FReply::Handled();
+}
+
+void SBlueprintProfilerWidget::StartExport(EProfilerExportFormat Format)
+{
+	if (!CanStartExport())
 	{
-		return FReply::Handled();
+		return;
 	}
 
 	IDesktopPlatform* DesktopPlatform = FDesktopPlatformModule::Get();
-	if (DesktopPlatform)
+	if (!DesktopPlatform)
 	{
-		TArray<FString> SaveFilenames;
-		FString DefaultPath = FPaths::ProjectSavedDir();
-		FString DefaultFile = FString::Printf(TEXT("BlueprintProfiler_%s.json"), *FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S")));
-		
-		bool bOpened = DesktopPlatform->SaveFileDialog(
-			FSlateApplication::Get().FindBestParentWindowHandleForDialogs(nullptr),
-			TEXT("Export to JSON"),
-			DefaultPath,
-			DefaultFile,
-			TEXT("JSON Files (*.json)|*.json"),
-			EFileDialogFlags::None,
-			SaveFilenames
-		);
+		return;
+	}
+
+	const bool bCsv = Format == EProfilerExportFormat::Csv;
+	TArray<FString> SaveFilenames;
+	FString DefaultPath = FPaths::ProjectSavedDir();
+	FString DefaultFile = FString::Printf(TEXT("BlueprintProfiler_%s.%s"), *FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S")), bCsv ? TEXT("csv") : TEXT("json"));
+
+	bool bOpened = DesktopPlatform->SaveFileDialog(
+		FSlateApplication::Get().FindBestParentWindowHandleForDialogs(nullptr),
+		bCsv ? TEXT("Export to CSV") : TEXT("Export to JSON"),
+		DefaultPath,
+		DefaultFile,
+		bCsv ? TEXT("CSV Files (*.csv)|*.csv|Compressed CSV Files (*.csv.gz)|*.csv.gz")
+			: TEXT("JSON Files (*.json)|*.json|Compressed JSON Files (*.json.gz)|*.json.gz"),
+		EFileDialogFlags::None,
+		SaveFilenames
+	);
+
+	if (!bOpened || SaveFilenames.Num() == 0)
+	{
+		return;
+	}
+
+	// 快照在游戏线程上复制，后台任务不再接触列表中的条目
+	const FString& FilePath = SaveFilenames[0];
+	DataExporter->Start(FilePath, Format, FProfilerDataExporter::IsCompressedPath(FilePath), BuildExportSnapshot());
+
+	if (ProgressBar.IsValid())
+	{
+		ProgressBar->SetPercent(0.0f);
+		ProgressBar->SetVisibility(EVisibility::Visible);
+	}
+
+	if (StatusText.IsValid())
+	{
+		StatusText->SetText(FText::Format(
+			BP_LOCTEXT("StatusExporting", "正在导出 {0} 个项目...", "Exporting {0} items..."),
+			FText::AsNumber(FilteredDataItems.Num())));
+	}
+}
 
-		if (bOpened && SaveFilenames.Num() > 0)
+TSharedRef<const FProfilerExportSnapshot, ESPMode::ThreadSafe> SBlueprintProfilerWidget::BuildExportSnapshot() const
+{
+	TSharedRef<FProfilerExportSnapshot, ESPMode::ThreadSafe> Snapshot = MakeShared<FProfilerExportSnapshot, ESPMode::ThreadSafe>();
+
+	for (int32 TypeIndex = 0; TypeIndex < Snapshot->TypeNames.Num(); ++TypeIndex)
+	{
+		Snapshot->TypeNames[TypeIndex] = GetDataTypeText(static_cast<EProfilerDataType>(TypeIndex)).ToString();
+	}
+	for (int32 SeverityIndex = 0; SeverityIndex < Snapshot->SeverityNames.Num(); ++SeverityIndex)
+	{
+		Snapshot->SeverityNames[SeverityIndex] = GetSeverityText(static_cast<ESeverity>(SeverityIndex)).ToString();
+	}
+	Snapshot->ExportDate = FDateTime::Now().ToString();
+
+	Snapshot->Rows.Reserve(FilteredDataItems.Num());
+	for (const TSharedPtr<FProfilerDataItem>& Item : FilteredDataItems)
+	{
+		if (Item.IsValid())
 		{
-			FString FilePath = SaveFilenames[0];
-			
-			TSharedPtr<FJsonObject> RootObject = MakeShareable(new FJsonObject);
-			TArray<TSharedPtr<FJsonValue>> ItemsArray;
-			
-			for (const TSharedPtr<FProfilerDataItem>& Item : FilteredDataItems)
-			{
-				if (Item.IsValid())
-				{
-					TSharedPtr<FJsonObject> ItemObject = MakeShareable(new FJsonObject);
-					ItemObject->SetStringField(TEXT("Type"), GetDataTypeText(Item->Type).ToString());
-					ItemObject->SetStringField(TEXT("Name"), Item->Name);
-					ItemObject->SetStringField(TEXT("Blueprint"), Item->BlueprintName);
-					ItemObject->SetStringField(TEXT("Category"), Item->Category);
-					ItemObject->SetNumberField(TEXT("Value"), Item->Value);
-					ItemObject->SetStringField(TEXT("Severity"), GetSeverityText(Item->Severity).ToString());
-					
-					ItemsArray.Add(MakeShareable(new FJsonValueObject(ItemObject)));
-				}
-			}
-			
-			RootObject->SetArrayField(TEXT("Items"), ItemsArray);
-			RootObject->SetStringField(TEXT("ExportDate"), FDateTime::Now().ToString());
-			RootObject->SetNumberField(TEXT("TotalItems"), static_cast<double>(FilteredDataItems.Num()));
-			
-			FString OutputString;
-			TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
-			FJsonSerializer::Serialize(RootObject.ToSharedRef(), Writer);
-			
-			if (FFileHelper::SaveStringToFile(OutputString, *FilePath))
-			{
-				if (StatusText.IsValid())
-				{
-					StatusText->SetText(FText::Format(
-						BP_LOCTEXT("StatusExportSuccess", "已导出 {0} 个项目到 {1}", "Exported {0} items to {1}"),
-						FText::AsNumber(FilteredDataItems.Num()),
-						FText::FromString(FPaths::GetCleanFilename(FilePath))
-					));
-				}
-			}
-			else
-			{
-				if (StatusText.IsValid())
-				{
-					StatusText->SetText(BP_LOCTEXT("StatusExportFailed", "保存导出文件失败", "Failed to save export file"));
-				}
-			}
+			FProfilerExportRow& Row = Snapshot->Rows.AddDefaulted_GetRef();
+			Row.Type = Item->Type;
+			Row.Severity = Item->Severity;
+			Row.Value = Item->Value;
+			Row.Name = Item->Name;
+			Row.BlueprintName = Item->BlueprintName;
+			Row.Category = Item->Category;
 		}
 	}
-	return FReply::Handled();
+	return Snapshot;
+}
+
+void SBlueprintProfilerWidget::OnExportProgress(float Progress)
+{
+	if (ProgressBar.IsValid())
+	{
+		ProgressBar->SetPercent(Progress);
+	}
+}
+
+void SBlueprintProfilerWidget::OnExportComplete(bool bSuccess, bool bCancelled, int32 NumRows, const FString& FilePath)
+{
+	if (ProgressBar.IsValid())
+	{
+		ProgressBar->SetVisibility(EVisibility::Collapsed);
+	}
+
+	if (!StatusText.IsValid())
+	{
+		return;
+	}
+
+	if (bSuccess)
+	{
+		StatusText->SetText(FText::Format(
+			BP_LOCTEXT("StatusExportSuccess", "已导出 {0} 个项目到 {1}", "Exported {0} items to {1}"),
+			FText::AsNumber(NumRows),
+			FText::FromString(FPaths::GetCleanFilename(FilePath))
+		));
+	}
+	else if (bCancelled)
+	{
+		StatusText->SetText(BP_LOCTEXT("StatusExportCancelled", "导出已取消", "Export cancelled"));
+	}
+	else
+	{
+		StatusText->SetText(BP_LOCTEXT("StatusExportFailed", "保存导出文件失败", "Failed to save export file"));
+	}
 }
 
 FReply SBlueprintProfilerWidget::OnRefreshData()
 {
 	// 清除所有显示的数据（运行时数据、静态扫描数据、会话历史）
-	AllDataItems.Empty();
+	RowStore.Empty();
 	FilteredDataItems.Empty();
 
 	// 也清除 RuntimeProfiler 和 StaticLinter 中的数据
@@ -1953,11 +2083,6 @@ void SBlueprintProfilerWidget::OnSearchTextChanged(const FText& Text)
 	CurrentSearchText = Text.ToString();
 	UpdateFilteredData();
 	
-	if (DataListView.IsValid())
-	{
-		DataListView->RequestListRefresh();
-	}
-	
 	// Update status to show search results count
 	if (StatusText.IsValid())
 	{
@@ -1974,7 +2099,7 @@ void SBlueprintProfilerWidget::OnSearchTextChanged(const FText& Text)
 				BP_LOCTEXT("StatusSearchResults", "搜索 '{0}'：{2} 项中的 {1} 项", "搜索 '{0}'：{2} 项中的 {1} 项"),
 				FText::FromString(CurrentSearchText),
 				FText::AsNumber(FilteredDataItems.Num()),
-				FText::AsNumber(AllDataItems.Num())
+				FText::AsNumber(RowStore.Num())
 			));
 		}
 	}
@@ -1988,11 +2113,6 @@ void SBlueprintProfilerWidget::OnSortSelectionChanged(
 	{
 		CurrentSortBy = *Selection;
 		SortData(CurrentSortBy);
-		
-		if (DataListView.IsValid())
-		{
-			DataListView->RequestListRefresh();
-		}
 	}
 }
 
@@ -2004,11 +2124,6 @@ void SBlueprintProfilerWidget::OnFilterSelectionChanged(
 	{
 		CurrentFilterBy = *Selection;
 		UpdateFilteredData();
-
-		if (DataListView.IsValid())
-		{
-			DataListView->RequestListRefresh();
-		}
 	}
 }
 
@@ -2020,239 +2135,67 @@ void SBlueprintProfilerWidget::OnHideEngineNodesChanged(ECheckBoxState NewState)
 	// Refresh data to apply filter
 	UpdateFilteredData();
 
-	if (DataListView.IsValid())
-	{
-		DataListView->RequestListRefresh();
-	}
-
 }
 
 // Data processing methods
 void SBlueprintProfilerWidget::UpdateFilteredData()
 {
-	FilteredDataItems.Empty();
-
-	// Get localized filter texts for comparison
-	FString AllText = BP_LOCTEXT("FilterAll", "全部", "All").ToString();
-	FString RuntimeText = BP_LOCTEXT("FilterRuntime", "运行时", "Runtime").ToString();
-	FString LintText = BP_LOCTEXT("FilterLint", "代码检查", "Code Check").ToString();
-	FString MemoryText = BP_LOCTEXT("FilterMemory", "内存", "Memory").ToString();
-	FString CriticalText = BP_LOCTEXT("SeverityCritical", "严重", "Critical").ToString();
-	FString HighText = BP_LOCTEXT("SeverityHigh", "高", "High").ToString();
-	FString MediumText = BP_LOCTEXT("SeverityMedium", "中", "Medium").ToString();
-	FString LowText = BP_LOCTEXT("SeverityLow", "低", "Low").ToString();
-	FString HotspotsText = BP_LOCTEXT("FilterHotspots", "热点节点", "Hotspot Nodes").ToString();
-	FString DeadCodeText = BP_LOCTEXT("FilterDeadCode", "死代码", "Dead Code").ToString();
-	FString PerformanceText = BP_LOCTEXT("FilterPerformance", "性能问题", "Performance Issues").ToString();
+	// Resolve the localized filter and sort selections
+	const TPair<FText, EProfilerRowFilter> FilterTexts[] = {
+		{ BP_LOCTEXT("FilterRuntime", "运行时", "Runtime"), EProfilerRowFilter::Runtime },
+		{ BP_LOCTEXT("FilterLint", "代码检查", "Code Check"), EProfilerRowFilter::Lint },
+		{ BP_LOCTEXT("FilterMemory", "内存", "Memory"), EProfilerRowFilter::Memory },
+		{ BP_LOCTEXT("SeverityCritical", "严重", "Critical"), EProfilerRowFilter::Critical },
+		{ BP_LOCTEXT("SeverityHigh", "高", "High"), EProfilerRowFilter::High },
+		{ BP_LOCTEXT("SeverityMedium", "中", "Medium"), EProfilerRowFilter::Medium },
+		{ BP_LOCTEXT("SeverityLow", "低", "Low"), EProfilerRowFilter::Low },
+		{ BP_LOCTEXT("FilterHotspots", "热点节点", "Hotspot Nodes"), EProfilerRowFilter::Hotspots },
+		{ BP_LOCTEXT("FilterDeadCode", "死代码", "Dead Code"), EProfilerRowFilter::DeadCode },
+		{ BP_LOCTEXT("FilterPerformance", "性能问题", "Performance Issues"), EProfilerRowFilter::Performance }
+	};
+	const TPair<FText, EProfilerRowSort> SortTexts[] = {
+		{ BP_LOCTEXT("Name", "名称", "Name"), EProfilerRowSort::Name },
+		{ BP_LOCTEXT("Blueprint", "蓝图", "Blueprint"), EProfilerRowSort::Blueprint },
+		{ BP_LOCTEXT("Type", "类型", "Type"), EProfilerRowSort::Type },
+		{ BP_LOCTEXT("Category", "类别", "Category"), EProfilerRowSort::Category },
+		{ BP_LOCTEXT("Value", "值", "Value"), EProfilerRowSort::Value },
+		{ BP_LOCTEXT("SortByExecution", "执行频率", "Execution Frequency"), EProfilerRowSort::Execution },
+		{ BP_LOCTEXT("SortByMemory", "内存使用", "Memory Usage"), EProfilerRowSort::Memory }
+	};
 
-	for (const TSharedPtr<FProfilerDataItem>& Item : AllDataItems)
+	EProfilerRowFilter Filter = EProfilerRowFilter::All;
+	for (const TPair<FText, EProfilerRowFilter>& FilterText : FilterTexts)
 	{
-		if (!Item.IsValid())
-		{
-			continue;
-		}
-
-		// Apply search filter with enhanced matching
-		if (!CurrentSearchText.IsEmpty())
+		if (CurrentFilterBy == FilterText.Key.ToString())
 		{
-			if (!MatchesSearchCriteria(Item, CurrentSearchText))
-			{
-				continue;
-			}
+			Filter = FilterText.Value;
+			break;
 		}
+	}
 
-		// Apply type/severity filter with enhanced options
-		if (CurrentFilterBy != AllText)
+	EProfilerRowSort Sort = EProfilerRowSort::Severity;
+	for (const TPair<FText, EProfilerRowSort>& SortText : SortTexts)
+	{
+		if (CurrentSortBy == SortText.Key.ToString())
 		{
-			bool bMatchesFilter = false;
-
-			// Type filters
-			if (CurrentFilterBy == RuntimeText && Item->Type == EProfilerDataType::Runtime)
-			{
-				bMatchesFilter = true;
-			}
-			else if (CurrentFilterBy == LintText && Item->Type == EProfilerDataType::Lint)
-			{
-				bMatchesFilter = true;
-			}
-			else if (CurrentFilterBy == MemoryText && Item->Type == EProfilerDataType::Memory)
-			{
-				bMatchesFilter = true;
-			}
-			// Severity filters
-			else if (CurrentFilterBy == CriticalText && Item->Severity == ESeverity::Critical)
-			{
-				bMatchesFilter = true;
-			}
-			else if (CurrentFilterBy == HighText && Item->Severity == ESeverity::High)
-			{
-				bMatchesFilter = true;
-			}
-			else if (CurrentFilterBy == MediumText && Item->Severity == ESeverity::Medium)
-			{
-				bMatchesFilter = true;
-			}
-			else if (CurrentFilterBy == LowText && Item->Severity == ESeverity::Low)
-			{
-				bMatchesFilter = true;
-			}
-			// Category filters
-			else if (CurrentFilterBy == HotspotsText &&
-					(Item->Category.Contains(TEXT("Hot")) || Item->Category.Contains(TEXT("高频执行"))))
-			{
-				bMatchesFilter = true;
-			}
-			else if (CurrentFilterBy == DeadCodeText &&
-					(Item->Category.Contains(TEXT("Dead")) || Item->Category.Contains(TEXT("孤立节点"))))
-			{
-				bMatchesFilter = true;
-			}
-			else if (CurrentFilterBy == PerformanceText &&
-					(Item->Category.Contains(TEXT("Cast")) || Item->Category.Contains(TEXT("Tick"))))
-			{
-				bMatchesFilter = true;
-			}
-
-			if (!bMatchesFilter)
-			{
-				continue;
-			}
+			Sort = SortText.Value;
+			break;
 		}
-
-		FilteredDataItems.Add(Item);
 	}
 
-	// Apply current sort
-	SortData(CurrentSortBy);
+	// 只有可见列表真的变化时才刷新列表视图；未变化的行保留原来的列表项和行控件
+	RowStore.SetView(Filter, Sort, CurrentSearchText);
+	if (RowStore.UpdateView(FilteredDataItems) && DataListView.IsValid())
+	{
+		DataListView->RequestListRefresh();
+	}
 }
 
 void SBlueprintProfilerWidget::SortData(const FString& SortBy)
 {
-	// Get localized sort texts for comparison
-	FString NameText = BP_LOCTEXT("Name", "名称", "Name").ToString();
-	FString BlueprintText = BP_LOCTEXT("Blueprint", "蓝图", "Blueprint").ToString();
-	FString TypeText = BP_LOCTEXT("Type", "类型", "Type").ToString();
-	FString CategoryText = BP_LOCTEXT("Category", "类别", "Category").ToString();
-	FString SeverityText = BP_LOCTEXT("Severity", "严重程度", "Severity").ToString();
-	FString ValueText = BP_LOCTEXT("Value", "值", "Value").ToString();
-	FString ExecutionText = BP_LOCTEXT("SortByExecution", "执行频率", "Execution Frequency").ToString();
-	FString MemoryText = BP_LOCTEXT("SortByMemory", "内存使用", "Memory Usage").ToString();
-
-	if (SortBy == NameText)
-	{
-		FilteredDataItems.Sort([](const TSharedPtr<FProfilerDataItem>& A, const TSharedPtr<FProfilerDataItem>& B)
-		{
-			if (!A.IsValid() || !B.IsValid()) return false;
-			return A->Name.Compare(B->Name, ESearchCase::IgnoreCase) < 0;
-		});
-	}
-	else if (SortBy == BlueprintText)
-	{
-		FilteredDataItems.Sort([](const TSharedPtr<FProfilerDataItem>& A, const TSharedPtr<FProfilerDataItem>& B)
-		{
-			if (!A.IsValid() || !B.IsValid()) return false;
-			int32 BlueprintCompare = A->BlueprintName.Compare(B->BlueprintName, ESearchCase::IgnoreCase);
-			if (BlueprintCompare == 0)
-			{
-				// Secondary sort by name if blueprints are the same
-				return A->Name.Compare(B->Name, ESearchCase::IgnoreCase) < 0;
-			}
-			return BlueprintCompare < 0;
-		});
-	}
-	else if (SortBy == TypeText)
-	{
-		FilteredDataItems.Sort([](const TSharedPtr<FProfilerDataItem>& A, const TSharedPtr<FProfilerDataItem>& B)
-		{
-			if (!A.IsValid() || !B.IsValid()) return false;
-			if ((int32)A->Type == (int32)B->Type)
-			{
-				// Secondary sort by severity if types are the same
-				return (int32)A->Severity > (int32)B->Severity;
-			}
-			return (int32)A->Type < (int32)B->Type;
-		});
-	}
-	else if (SortBy == CategoryText)
-	{
-		FilteredDataItems.Sort([](const TSharedPtr<FProfilerDataItem>& A, const TSharedPtr<FProfilerDataItem>& B)
-		{
-			if (!A.IsValid() || !B.IsValid()) return false;
-			int32 CategoryCompare = A->Category.Compare(B->Category, ESearchCase::IgnoreCase);
-			if (CategoryCompare == 0)
-			{
-				// Secondary sort by severity if categories are the same
-				return (int32)A->Severity > (int32)B->Severity;
-			}
-			return CategoryCompare < 0;
-		});
-	}
-	else if (SortBy == SeverityText)
-	{
-		FilteredDataItems.Sort([](const TSharedPtr<FProfilerDataItem>& A, const TSharedPtr<FProfilerDataItem>& B)
-		{
-			if (!A.IsValid() || !B.IsValid()) return false;
-			if ((int32)A->Severity == (int32)B->Severity)
-			{
-				// Secondary sort by value if severities are the same
-				return A->Value > B->Value;
-			}
-			return (int32)A->Severity > (int32)B->Severity; // Higher severity first
-		});
-	}
-	else if (SortBy == ValueText)
-	{
-		FilteredDataItems.Sort([](const TSharedPtr<FProfilerDataItem>& A, const TSharedPtr<FProfilerDataItem>& B)
-		{
-			if (!A.IsValid() || !B.IsValid()) return false;
-			if (FMath::IsNearlyEqual(A->Value, B->Value, 0.01f))
-			{
-				// Secondary sort by severity if values are nearly equal
-				return (int32)A->Severity > (int32)B->Severity;
-			}
-			return A->Value > B->Value; // Higher values first
-		});
-	}
-	else if (SortBy == ExecutionText)
-	{
-		// Special sort for runtime data by execution frequency
-		FilteredDataItems.Sort([](const TSharedPtr<FProfilerDataItem>& A, const TSharedPtr<FProfilerDataItem>& B)
-		{
-			if (!A.IsValid() || !B.IsValid()) return false;
-
-			// Prioritize runtime data
-			if (A->Type == EProfilerDataType::Runtime && B->Type != EProfilerDataType::Runtime)
-			{
-				return true;
-			}
-			if (B->Type == EProfilerDataType::Runtime && A->Type != EProfilerDataType::Runtime)
-			{
-				return false;
-			}
-
-			return A->Value > B->Value;
-		});
-	}
-	else if (SortBy == MemoryText)
-	{
-		// Special sort for memory data
-		FilteredDataItems.Sort([](const TSharedPtr<FProfilerDataItem>& A, const TSharedPtr<FProfilerDataItem>& B)
-		{
-			if (!A.IsValid() || !B.IsValid()) return false;
-
-			// Prioritize memory data
-			if (A->Type == EProfilerDataType::Memory && B->Type != EProfilerDataType::Memory)
-			{
-				return true;
-			}
-			if (B->Type == EProfilerDataType::Memory && A->Type != EProfilerDataType::Memory)
-			{
-				return false;
-			}
-
-			return A->Value > B->Value;
-		});
-	}
+	// Sorting is part of the row store view
+	CurrentSortBy = SortBy;
+	UpdateFilteredData();
 }
 
 void SBlueprintProfilerWidget::FilterData(const FString& FilterBy)
@@ -2282,11 +2225,6 @@ void SBlueprintProfilerWidget::ClearFilters()
 	}
 
 	UpdateFilteredData();
-
-	if (DataListView.IsValid())
-	{
-		DataListView->RequestListRefresh();
-	}
 }
 
 void SBlueprintProfilerWidget::ApplyQuickFilter(const FString& FilterType)
@@ -2326,56 +2264,26 @@ void SBlueprintProfilerWidget::ApplyQuickFilter(const FString& FilterType)
 	}
 
 	UpdateFilteredData();
-
-	if (DataListView.IsValid())
-	{
-		DataListView->RequestListRefresh();
-	}
 }
 
-bool SBlueprintProfilerWidget::MatchesSearchCriteria(TSharedPtr<FProfilerDataItem> Item, const FString& SearchText) const
+FString SBlueprintProfilerWidget::BuildSearchText(TSharedPtr<FProfilerDataItem> Item) const
 {
-	if (!Item.IsValid() || SearchText.IsEmpty())
+	if (!Item.IsValid())
 	{
-		return true;
+		return FString();
 	}
 	
-	FString SearchLower = SearchText.ToLower();
-	
-	// Check all searchable fields
-	TArray<FString> SearchableFields = {
-		Item->Name.ToLower(),
-		Item->BlueprintName.ToLower(),
-		Item->Category.ToLower(),
-		GetDataTypeText(Item->Type).ToString().ToLower(),
-		GetSeverityText(Item->Severity).ToString().ToLower(),
-		GetFormattedValue(Item).ToString().ToLower(),
-		GetBlueprintPath(Item).ToLower()
+	// All searchable fields, one per line so a search term never spans two fields
+	const TArray<FString> SearchableFields = {
+		Item->Name,
+		Item->BlueprintName,
+		Item->Category,
+		GetDataTypeText(Item->Type).ToString(),
+		GetSeverityText(Item->Severity).ToString(),
+		GetFormattedValue(Item).ToString(),
+		GetBlueprintPath(Item)
 	};
-	
-	// Support multiple search terms (space-separated)
-	TArray<FString> SearchTerms;
-	SearchLower.ParseIntoArray(SearchTerms, TEXT(" "), true);
-	
-	for (const FString& Term : SearchTerms)
-	{
-		bool bTermFound = false;
-		for (const FString& Field : SearchableFields)
-		{
-			if (Field.Contains(Term))
-			{
-				bTermFound = true;
-				break;
-			}
-		}
-		
-		if (!bTermFound)
-		{
-			return false; // All terms must match
-		}
-	}
-	
-	return true;
+	return FString::Join(SearchableFields, TEXT("\n"));
 }
 
 TSharedPtr<FProfilerDataItem> SBlueprintProfilerWidget::CreateDataItemFromRuntimeData(const FNodeExecutionData& Data)
@@ -2386,6 +2294,7 @@ TSharedPtr<FProfilerDataItem> SBlueprintProfilerWidget::CreateDataItemFromRuntim
 	Item->Name = Data.NodeName.IsEmpty() ? TEXT("未知节点") : Data.NodeName;
 	Item->BlueprintName = Data.BlueprintName.IsEmpty() ? TEXT("未知蓝图") : Data.BlueprintName;
 	Item->Value = Data.AverageExecutionsPerSecond;
+	Item->RuntimeData = MakeShared<FNodeExecutionData>(Data);
 	Item->TargetObject = Data.BlueprintObject;
 	Item->NodeGuid = Data.NodeGuid;
 
@@ -2493,6 +2402,50 @@ TSharedPtr<FProfilerDataItem> SBlueprintProfilerWidget::CreateDataItemFromLintIs
 	return Item;
 }
 
+void SBlueprintProfilerWidget::UpdateRuntimeRow(const FNodeExecutionData& Data)
+{
+	const uint64 RowKey = FProfilerRowStore::FHashBuilder(EProfilerDataType::Runtime)
+		.Add(Data.NodeGuid)
+		.Add(Data.BlueprintName)
+		.Add(Data.NodeName)
+		.Finish();
+
+	// 内容哈希覆盖列表和提示中显示的统计值
+	const uint64 ContentHash = FProfilerRowStore::FHashBuilder(EProfilerDataType::Runtime)
+		.Add(Data.TotalExecutions)
+		.Add(Data.AverageExecutionsPerSecond)
+		.Add(Data.AverageExecutionTime)
+		.Add(Data.AverageExclusiveTime)
+		.Add(Data.P50ExecutionTime)
+		.Add(Data.P95ExecutionTime)
+		.Add(Data.P99ExecutionTime)
+		.Add(Data.SamplingRate)
+		.Add(Data.SampledExecutions)
+		.Add(Data.ExecutionsLowerBound)
+		.Add(Data.ExecutionsUpperBound)
+		.Finish();
+
+	RowStore.UpdateRow(EProfilerDataType::Runtime, RowKey, ContentHash, [this, &Data]() { return CreateDataItemFromRuntimeData(Data); });
+}
+
+void SBlueprintProfilerWidget::UpdateLintRow(const FLintIssue& Issue)
+{
+	const uint64 RowKey = FProfilerRowStore::FHashBuilder(EProfilerDataType::Lint)
+		.Add(Issue.BlueprintPath)
+		.Add(Issue.NodeGuid)
+		.Add(static_cast<int32>(Issue.Type))
+		.Add(Issue.NodeName)
+		.Add(Issue.Description)
+		.Finish();
+
+	const uint64 ContentHash = FProfilerRowStore::FHashBuilder(EProfilerDataType::Lint)
+		.Add(static_cast<int32>(Issue.Severity))
+		.Finish();
+
+	// 重新扫描时未变化的问题不再创建列表项，也不再经资产注册表查找蓝图
+	RowStore.UpdateRow(EProfilerDataType::Lint, RowKey, ContentHash, [this, &Issue]() { return CreateDataItemFromLintIssue(Issue); });
+}
+
 TSharedPtr<FProfilerDataItem> SBlueprintProfilerWidget::CreateDataItemFromMemoryData(
 	const FMemoryAnalysisResult& Data,
 	UBlueprint* Blueprint)
@@ -2741,6 +2694,24 @@ FText SBlueprintProfilerWidget::GetFormattedTooltip(TSharedPtr<FProfilerDataItem
 	{
 		case EProfilerDataType::Runtime:
 			TooltipText += FString::Printf(TEXT("Executions per second: %.2f\n"), Item->Value);
+			if (Item->RuntimeData.IsValid())
+			{
+				TooltipText += FString::Printf(TEXT("Avg time (inclusive): %.3f ms\n"), Item->RuntimeData->AverageExecutionTime * 1000.0f);
+				TooltipText += FString::Printf(TEXT("Avg time (exclusive): %.3f ms\n"), Item->RuntimeData->AverageExclusiveTime * 1000.0f);
+				TooltipText += FString::Printf(TEXT("p50 / p95 / p99: %.3f / %.3f / %.3f ms\n"),
+					Item->RuntimeData->P50ExecutionTime * 1000.0f,
+					Item->RuntimeData->P95ExecutionTime * 1000.0f,
+					Item->RuntimeData->P99ExecutionTime * 1000.0f);
+				if (Item->RuntimeData->SamplingRate < 1.0f)
+				{
+					TooltipText += FString::Printf(TEXT("Sampled: %d of ~%d executions (%.1f%%), 95%% range %d - %d\n"),
+						Item->RuntimeData->SampledExecutions,
+						Item->RuntimeData->TotalExecutions,
+						Item->RuntimeData->SamplingRate * 100.0f,
+						Item->RuntimeData->ExecutionsLowerBound,
+						Item->RuntimeData->ExecutionsUpperBound);
+				}
+			}
 			TooltipText += TEXT("Double-click to jump to node in blueprint editor");
 			break;
 			
@@ -2773,6 +2744,170 @@ FString SBlueprintProfilerWidget::GetBlueprintPath(TSharedPtr<FProfilerDataItem>
 	return Item->BlueprintName;
 }
 
+// Hitch list
+void SBlueprintProfilerWidget::RefreshHitchList()
+{
+	HitchItems.Reset();
+	if (RuntimeProfiler.IsValid())
+	{
+		const TArray<FBlueprintFrameBreakdown>& Hitches = RuntimeProfiler->GetHitches();
+		for (int32 Index = Hitches.Num() - 1; Index >= 0; --Index)
+		{
+			HitchItems.Add(MakeShared<FBlueprintFrameBreakdown>(Hitches[Index]));
+		}
+	}
+
+	if (HitchListView.IsValid())
+	{
+		HitchListView->RequestListRefresh();
+	}
+}
+
+void SBlueprintProfilerWidget::OnBlueprintHitch(const FBlueprintFrameBreakdown& Hitch)
+{
+	HitchItems.Insert(MakeShared<FBlueprintFrameBreakdown>(Hitch), 0);
+
+	// 与分析器保持相同的上限
+	const int32 MaxHitchItems = RuntimeProfiler.IsValid() ? RuntimeProfiler->GetHitches().Num() : HitchItems.Num();
+	if (HitchItems.Num() > MaxHitchItems)
+	{
+		HitchItems.SetNum(MaxHitchItems);
+	}
+
+	if (HitchListView.IsValid())
+	{
+		HitchListView->RequestListRefresh();
+	}
+}
+
+void SBlueprintProfilerWidget::OnRuntimeLiveUpdate(const TSharedRef<const FRuntimeLiveUpdate, ESPMode::ThreadSafe>& Update)
+{
+	if (Update->Serial == 1)
+	{
+		// 新录制的第一次更新：替换上次录制的运行时行
+		RowStore.RemoveRows(EProfilerDataType::Runtime);
+	}
+	else if (Update->Serial != LastLiveUpdateSerial + 1)
+	{
+		// 漏掉了更新（例如录制中途才打开窗口），增量无法补齐，整体刷新一次
+		LastLiveUpdateSerial = Update->Serial;
+		if (RuntimeProfiler.IsValid())
+		{
+			SetRuntimeData(RuntimeProfiler->GetExecutionData());
+		}
+		return;
+	}
+	LastLiveUpdateSerial = Update->Serial;
+
+	// 只更新这段时间内执行过的节点，其余行保持不变
+	for (const FNodeExecutionData& Data : Update->ChangedNodes)
+	{
+		UpdateRuntimeRow(Data);
+	}
+	UpdateFilteredData();
+}
+
+FText SBlueprintProfilerWidget::GetHitchListHeaderText() const
+{
+	const float BudgetMs = RuntimeProfiler.IsValid() ? RuntimeProfiler->GetHitchBudgetMs() : 0.0f;
+	return FText::Format(
+		BP_LOCTEXT("HitchListHeader", "蓝图卡顿帧（{0}，预算 {1} ms）", "Blueprint Hitches ({0}, budget {1} ms)"),
+		FText::AsNumber(HitchItems.Num()),
+		FText::AsNumber(BudgetMs));
+}
+
+TSharedRef<ITableRow> SBlueprintProfilerWidget::OnGenerateHitchRow(
+	TSharedPtr<FBlueprintFrameBreakdown> Item,
+	const TSharedRef<STableViewBase>& OwnerTable)
+{
+	if (!Item.IsValid())
+	{
+		return SNew(STableRow<TSharedPtr<FBlueprintFrameBreakdown>>, OwnerTable);
+	}
+
+	TArray<FString> BlueprintParts;
+	for (const FFrameCostContributor& Contributor : Item->TopBlueprints)
+	{
+		BlueprintParts.Add(FString::Printf(TEXT("%s %.2f ms"), Contributor.BlueprintName.IsEmpty() ? TEXT("?") : *Contributor.BlueprintName, Contributor.TimeMs));
+	}
+
+	TArray<FString> NodeParts;
+	for (const FFrameCostContributor& Contributor : Item->TopNodes)
+	{
+		NodeParts.Add(FString::Printf(TEXT("%s %.2f ms"), Contributor.Name.IsEmpty() ? TEXT("?") : *Contributor.Name, Contributor.TimeMs));
+	}
+
+	const FString BlueprintText = FString::Join(BlueprintParts, TEXT(", "));
+	const FString NodeText = FString::Join(NodeParts, TEXT(", "));
+
+	return SNew(STableRow<TSharedPtr<FBlueprintFrameBreakdown>>, OwnerTable)
+		[
+			SNew(SHorizontalBox)
+
+			+ SHorizontalBox::Slot()
+			.FillWidth(0.12f)
+			.Padding(4, 2)
+			.VAlign(VAlign_Center)
+			[
+				SNew(STextBlock)
+				.Text(FText::FromString(FString::Printf(TEXT("%llu"), Item->FrameNumber)))
+				.Font(FAppStyle::GetFontStyle("PropertyWindow.NormalFont"))
+			]
+
+			+ SHorizontalBox::Slot()
+			.FillWidth(0.13f)
+			.Padding(4, 2)
+			.VAlign(VAlign_Center)
+			[
+				SNew(STextBlock)
+				.Text(FText::FromString(FString::Printf(TEXT("%.2f ms"), Item->BlueprintTimeMs)))
+				.Font(FAppStyle::GetFontStyle("PropertyWindow.NormalFont"))
+				.ColorAndOpacity(Item->BlueprintTimeMs > Item->BudgetMs * 2.0f ? GetSeverityColor(ESeverity::Critical) : GetSeverityColor(ESeverity::High))
+			]
+
+			+ SHorizontalBox::Slot()
+			.FillWidth(0.35f)
+			.Padding(4, 2)
+			.VAlign(VAlign_Center)
+			[
+				SNew(STextBlock)
+				.Text(FText::FromString(BlueprintText))
+				.ToolTipText(FText::FromString(BlueprintText))
+				.Font(FAppStyle::GetFontStyle("PropertyWindow.NormalFont"))
+				.OverflowPolicy(ETextOverflowPolicy::Ellipsis)
+			]
+
+			+ SHorizontalBox::Slot()
+			.FillWidth(0.4f)
+			.Padding(4, 2)
+			.VAlign(VAlign_Center)
+			[
+				SNew(STextBlock)
+				.Text(FText::FromString(NodeText))
+				.ToolTipText(FText::FromString(NodeText))
+				.Font(FAppStyle::GetFontStyle("PropertyWindow.NormalFont"))
+				.OverflowPolicy(ETextOverflowPolicy::Ellipsis)
+			]
+		];
+}
+
+void SBlueprintProfilerWidget::OnHitchDoubleClicked(TSharedPtr<FBlueprintFrameBreakdown> Item)
+{
+	if (!Item.IsValid() || Item->TopNodes.Num() == 0)
+	{
+		return;
+	}
+
+	// 跳转到该帧耗时最多的节点
+	const FFrameCostContributor& TopNode = Item->TopNodes[0];
+	TSharedPtr<FProfilerDataItem> NodeItem = MakeShared<FProfilerDataItem>();
+	NodeItem->Type = EProfilerDataType::Runtime;
+	NodeItem->Name = TopNode.Name;
+	NodeItem->BlueprintName = TopNode.BlueprintName;
+	NodeItem->TargetObject = TopNode.Object;
+	JumpToNode(NodeItem);
+}
+
 void SBlueprintProfilerWidget::JumpToNode(TSharedPtr<FProfilerDataItem> Item)
 {
 	if (!Item.IsValid())
@@ -3078,7 +3213,17 @@ bool SBlueprintProfilerWidget::CanStartMemoryAnalysis() const
 
 bool SBlueprintProfilerWidget::HasDataToExport() const
 {
-	return AllDataItems.Num() > 0;
+	return RowStore.Num() > 0;
+}
+
+bool SBlueprintProfilerWidget::CanStartExport() const
+{
+	return HasDataToExport() && !IsExporting();
+}
+
+bool SBlueprintProfilerWidget::IsExporting() const
+{
+	return DataExporter.IsValid() && DataExporter->IsExporting();
 }
 
 // Recording state helpers
@@ -3207,6 +3352,13 @@ void SBlueprintProfilerWidget::OnStaticScanComplete(const TArray<FLintIssue>& Is
 		{
 			StatusText->SetText(StatusMessage);
 		}
+
+		if (ScanCostArea.IsValid() && ScanCostText.IsValid())
+		{
+			const bool bHasTimings = Progress.LoadSeconds + Progress.AnalysisSeconds > 0.0;
+			ScanCostText->SetText(bHasTimings ? GetScanCostText(Progress) : FText::GetEmpty());
+			ScanCostArea->SetVisibility(bHasTimings ? EVisibility::Visible : EVisibility::Collapsed);
+		}
 	}
 	
 	if (ProgressBar.IsValid())
@@ -3224,7 +3376,40 @@ void SBlueprintProfilerWidget::OnStaticScanComplete(const TArray<FLintIssue>& Is
 		TimeRemainingText->SetVisibility(EVisibility::Collapsed);
 	}
 	
-	SetLintIssues(Issues);
+	// 扫描过程中已经逐批更新了行，数量一致时只需结束更新，移除本次没有再出现的问题
+	if (bLintIssuesStreamed && NumStreamedLintIssues == Issues.Num() && RowStore.IsUpdating(EProfilerDataType::Lint))
+	{
+		bLintListDirty = false;
+		RowStore.EndUpdate(EProfilerDataType::Lint);
+		UpdateFilteredData();
+	}
+	else
+	{
+		SetLintIssues(Issues);
+	}
+
+	bLintIssuesStreamed = false;
+	NumStreamedLintIssues = 0;
+}
+
+void SBlueprintProfilerWidget::OnStaticIssuesBatch(TConstArrayView<FLintIssue> Issues)
+{
+	// 第一批结果开启一次检查行的更新，上次的结果在扫描结束时才移除，扫描期间列表不会先变空
+	if (!bLintIssuesStreamed || !RowStore.IsUpdating(EProfilerDataType::Lint))
+	{
+		RowStore.BeginUpdate(EProfilerDataType::Lint);
+		bLintIssuesStreamed = true;
+		NumStreamedLintIssues = 0;
+	}
+
+	for (const FLintIssue& Issue : Issues)
+	{
+		UpdateLintRow(Issue);
+	}
+	NumStreamedLintIssues += Issues.Num();
+
+	// 排序和过滤放到定时器里做，一帧内的多批结果只刷新一次
+	bLintListDirty = true;
 }
 
 void SBlueprintProfilerWidget::OnStaticScanProgress(int32 ProcessedAssets, int32 TotalAssets)
@@ -3315,6 +3500,50 @@ FText SBlueprintProfilerWidget::GetProgressText() const
 	);
 }
 
+FText SBlueprintProfilerWidget::GetScanCostText(const FScanProgress& Progress) const
+{
+	// 与扫描日志中的耗时表相同：各阶段按耗时从高到低，之后是最慢的资产
+	TArray<TPair<FString, float>> Stages;
+	Stages.Emplace(TEXT("GraphIndex"), Progress.AnalysisBreakdown.GraphIndexSeconds);
+	for (int32 CheckIndex = 0; CheckIndex < FLintAnalysisTiming::NumChecks; ++CheckIndex)
+	{
+		if (Progress.AnalysisBreakdown.CheckSeconds[CheckIndex] > 0.0f)
+		{
+			Stages.Emplace(StaticEnum<ELintIssueType>()->GetNameStringByValue(CheckIndex), Progress.AnalysisBreakdown.CheckSeconds[CheckIndex]);
+		}
+	}
+	Stages.Sort([](const TPair<FString, float>& A, const TPair<FString, float>& B)
+	{
+		return A.Value > B.Value;
+	});
+
+	const double TotalSeconds = Progress.LoadSeconds + Progress.AnalysisSeconds;
+	auto Share = [TotalSeconds](double Seconds)
+	{
+		return TotalSeconds > 0.0 ? Seconds / TotalSeconds * 100.0 : 0.0;
+	};
+
+	FString Table = FString::Printf(TEXT("%-18s %10.3f %6.1f%%\n"), TEXT("Load"), Progress.LoadSeconds, Share(Progress.LoadSeconds));
+	for (const TPair<FString, float>& Stage : Stages)
+	{
+		Table += FString::Printf(TEXT("%-18s %10.3f %6.1f%%\n"), *Stage.Key, Stage.Value, Share(Stage.Value));
+	}
+	for (const FLintAssetTiming& AssetTiming : Progress.SlowestAssets)
+	{
+		Table += FString::Printf(TEXT("\n%10.3f  %s"), AssetTiming.GetTotalSeconds(), *AssetTiming.BlueprintPath);
+	}
+
+	FNumberFormattingOptions SecondsFormat;
+	SecondsFormat.SetMaximumFractionalDigits(2);
+
+	return FText::Format(
+		BP_LOCTEXT("ScanCostSummary", "加载 {0} 秒（游戏线程），分析 {1} 秒（工作线程累计）\n{2}", "Load {0}s (game thread), analysis {1}s (summed over workers)\n{2}"),
+		FText::AsNumber(Progress.LoadSeconds, &SecondsFormat),
+		FText::AsNumber(Progress.AnalysisSeconds, &SecondsFormat),
+		FText::FromString(Table.TrimEnd())
+	);
+}
+
 FText SBlueprintProfilerWidget::GetTimeRemainingText() const
 {
 	if (!StaticLinter.IsValid())
@@ -3372,24 +3601,29 @@ bool SBlueprintProfilerWidget::TickUIRefresh(float DeltaTime)
 				SessionNameText->SetText(GetSessionInfoText());
 			}
 
+			// 按钮的 IsEnabled 是绑定属性；只有状态变化时才重绘，并且不触发布局
+			if (StartRecordingButton.IsValid()) StartRecordingButton->Invalidate(EInvalidateWidget::Paint);
+			if (StopRecordingButton.IsValid()) StopRecordingButton->Invalidate(EInvalidateWidget::Paint);
+			if (PauseRecordingButton.IsValid()) PauseRecordingButton->Invalidate(EInvalidateWidget::Paint);
+			if (ResumeRecordingButton.IsValid()) ResumeRecordingButton->Invalidate(EInvalidateWidget::Paint);
+			if (ResetDataButton.IsValid()) ResetDataButton->Invalidate(EInvalidateWidget::Paint);
+
 			// 如果正在录制，定期更新数据列表
 			if (NewState == ERecordingState::Recording)
 			{
+				// 新录制开始时卡顿列表已被清空
+				RefreshHitchList();
 				UpdateFilteredData();
-				if (DataListView.IsValid())
-				{
-					DataListView->RequestListRefresh();
-				}
 			}
 		}
 	}
 
-	// 刷新按钮状态
-	if (StartRecordingButton.IsValid()) StartRecordingButton->Invalidate(EInvalidateWidget::Layout);
-	if (StopRecordingButton.IsValid()) StopRecordingButton->Invalidate(EInvalidateWidget::Layout);
-	if (PauseRecordingButton.IsValid()) PauseRecordingButton->Invalidate(EInvalidateWidget::Layout);
-	if (ResumeRecordingButton.IsValid()) ResumeRecordingButton->Invalidate(EInvalidateWidget::Layout);
-	if (ResetDataButton.IsValid()) ResetDataButton->Invalidate(EInvalidateWidget::Layout);
+	// 扫描中逐批到达的检查结果
+	if (bLintListDirty)
+	{
+		bLintListDirty = false;
+		UpdateFilteredData();
+	}
 
 	// 继续定时器
 	return true;
@@ -3406,6 +3640,12 @@ SBlueprintProfilerWidget::~SBlueprintProfilerWidget()
 		FTSTicker::GetCoreTicker().RemoveTicker(UIRefreshTickerHandle);
 		UIRefreshTickerHandle.Reset();
 	}
+
+	// 未完成的导出会删除临时文件
+	if (DataExporter.IsValid())
+	{
+		DataExporter->CancelAndWait();
+	}
 }
 
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
@@ -0,0 +1,68 @@
+// Copyright xnbmy 2026. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+#include <atomic>
+
+class IAssetRegistry;
+
+/**
+ * Immutable snapshot of the asset registry's package dependency graph
+ *
+ * Every package with an asset on disk gets a dense index. Forward (dependency) and reverse (referencer) edges are
+ * stored as CSR arrays; within a row hard edges come first, then soft ones. Built without loading any asset and
+ * read-only afterwards, so it can be shared between threads.
+ */
+class BLUEPRINTPROFILER_API FAssetDependencyGraph
+{
+public:
+	/**
+	 * Reads all on-disk assets and their package dependencies from the registry; may run on any thread.
+	 * Dependencies on packages without assets (script packages, missing packages) are dropped.
+	 * @return false if cancelled, the graph is left empty in that case
+	 */
+	bool Build(const IAssetRegistry& AssetRegistry, const std::atomic<bool>* bCancelRequested = nullptr);
+
+	/**
+	 * Builds from explicit adjacency lists given as package indices; used by Build and by tests.
+	 * Self edges, duplicates and soft edges that are also hard are dropped.
+	 */
+	void BuildFromAdjacency(TArray<FName>&& InPackageNames, TConstArrayView<TArray<int32>> HardDependencies, TConstArrayView<TArray<int32>> SoftDependencies);
+
+	int32 Num() const { return PackageNames.Num(); }
+	int32 NumEdges() const { return Dependencies.Num(); }
+	bool IsEmpty() const { return PackageNames.Num() == 0; }
+
+	/** Index of the package or INDEX_NONE */
+	int32 FindPackage(FName PackageName) const;
+	FName GetPackageName(int32 PackageIndex) const { return PackageNames[PackageIndex]; }
+
+	/** Main asset of the package; default when the graph was built from adjacency lists */
+	const FAssetData& GetPrimaryAsset(int32 PackageIndex) const { return PrimaryAssets[PackageIndex]; }
+
+	/** Package file size from the registry, 0 when unknown */
+	int64 GetDiskSize(int32 PackageIndex) const { return DiskSizes.IsValidIndex(PackageIndex) ? DiskSizes[PackageIndex] : 0; }
+
+	// 依赖：此包引用的包；引用者：引用此包的包
+	TConstArrayView<int32> GetDependencies(int32 PackageIndex) const;
+	TConstArrayView<int32> GetHardDependencies(int32 PackageIndex) const;
+	TConstArrayView<int32> GetReferencers(int32 PackageIndex) const;
+	TConstArrayView<int32> GetHardReferencers(int32 PackageIndex) const;
+
+private:
+	TArray<FName> PackageNames;
+	TMap<FName, int32> PackageIndices;
+	TArray<FAssetData> PrimaryAssets;
+	TArray<int64> DiskSizes;
+
+	// CSR：Offsets 长度为 Num()+1，HardEnds[i] 为第 i 行硬引用的结束位置
+	TArray<int32> DependencyOffsets;
+	TArray<int32> DependencyHardEnds;
+	TArray<int32> Dependencies;
+
+	TArray<int32> ReferencerOffsets;
+	TArray<int32> ReferencerHardEnds;
+	TArray<int32> Referencers;
+};
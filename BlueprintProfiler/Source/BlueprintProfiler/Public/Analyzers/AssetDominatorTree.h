@@ -0,0 +1,61 @@
+// Copyright xnbmy 2026. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FAssetDependencyGraph;
+
+/**
+ * Sizes of one package in the hard-reference graph
+ */
+struct BLUEPRINTPROFILER_API FAssetRetainedSize
+{
+	int64 ExclusiveBytes = 0;       // The package itself
+	int64 RetainedBytes = 0;        // Package plus everything only reachable through it: what unloads with it
+	int64 SharedBytes = 0;          // Hard dependencies that other packages keep loaded as well
+	int32 NumHardDependencies = 0;  // Packages in the transitive hard-reference closure, excluding the package
+
+	int64 GetInclusiveBytes() const { return RetainedBytes + SharedBytes; }
+};
+
+/**
+ * Dominator tree of the hard-reference package graph
+ *
+ * A virtual root links to every package that nothing hard-references (and to one package of every cycle that is
+ * otherwise unreachable). Package A dominates B when every hard-reference path from the root to B goes through A,
+ * so the dominator subtree of A is what would be unloaded if A went away. Computed once per graph snapshot with the
+ * iterative Cooper-Harvey-Kennedy algorithm over flat index arrays; read-only afterwards.
+ */
+class BLUEPRINTPROFILER_API FAssetDominatorTree
+{
+public:
+	/**
+	 * @param InGraph          Snapshot the tree is built for; kept alive by the tree
+	 * @param InPackageSizes   Bytes per package index, same length as the graph
+	 */
+	void Build(TSharedRef<const FAssetDependencyGraph> InGraph, TArray<int64>&& InPackageSizes);
+
+	bool IsBuilt() const { return Graph.IsValid(); }
+	const FAssetDependencyGraph* GetGraph() const { return Graph.Get(); }
+	int32 Num() const { return PackageSizes.Num(); }
+
+	/** Immediate dominator of the package; INDEX_NONE when only the virtual root dominates it */
+	int32 GetImmediateDominator(int32 PackageIndex) const;
+	bool Dominates(int32 DominatorIndex, int32 PackageIndex) const;
+
+	int64 GetPackageSize(int32 PackageIndex) const { return PackageSizes[PackageIndex]; }
+	int64 GetRetainedSize(int32 PackageIndex) const { return RetainedSizes[PackageIndex]; }
+
+	/** Exclusive, retained and shared sizes; walks the package's hard-reference closure, safe on any thread */
+	FAssetRetainedSize GetSizes(int32 PackageIndex) const;
+
+private:
+	TSharedPtr<const FAssetDependencyGraph> Graph;
+	TArray<int64> PackageSizes;
+
+	// 以下数组按包索引；虚拟根的索引为 Num()
+	TArray<int32> ImmediateDominators;
+	TArray<int32> PostOrderNumbers;
+	TArray<int64> RetainedSizes;
+};
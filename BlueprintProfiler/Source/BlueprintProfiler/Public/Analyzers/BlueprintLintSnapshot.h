@@ -0,0 +1,183 @@
+// Copyright xnbmy 2026. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FArchive;
+class UBlueprint;
+
+/**
+ * UObject-free copy of a blueprint's graphs for the static linter
+ *
+ * Built on the game thread right after the asset is loaded; afterwards it is immutable and can be analyzed
+ * on any thread. Everything the Detect* passes need from UObjects (titles, class checks, function lookups)
+ * is resolved while building, pin links are stored as node indices within the same graph.
+ */
+
+enum class ELintNodeKind : uint8
+{
+	Other,
+	Event,
+	CustomEvent,
+	ComponentBoundEvent,
+	FunctionEntry,
+	MacroInstance,
+	VariableGet,
+	VariableSet,
+	CallFunction,
+	Delegate,
+	DynamicCast
+};
+
+enum class ELintGraphKind : uint8
+{
+	Ubergraph,
+	Function,
+	Macro
+};
+
+struct BLUEPRINTPROFILER_API FLintPinSnapshot
+{
+	FName Name;
+	bool bExec = false;
+	bool bOutput = false;
+
+	// 连接到的节点在所属图 Nodes 中的索引；无法解析的连接记为 INDEX_NONE，连接数仍然有效
+	TArray<int32, TInlineAllocator<2>> LinkedNodes;
+
+	bool IsLinked() const { return LinkedNodes.Num() > 0; }
+};
+
+struct BLUEPRINTPROFILER_API FLintNodeSnapshot
+{
+	ELintNodeKind Kind = ELintNodeKind::Other;
+	FGuid NodeGuid;
+
+	/** Variable, function, event or delegate name depending on Kind */
+	FName MemberName;
+
+	/** ListView title; only filled for K2 nodes */
+	FString Title;
+	FString ClassName;
+
+	bool bIsK2Node = false;
+	bool bPure = false;
+	bool bInterfaceEvent = false;
+	bool bHardReferenceCast = false;
+
+	/** Add/Assign delegate nodes: custom events bound through the delegate pin */
+	TArray<int32, TInlineAllocator<1>> BoundEvents;
+
+	/** Call function nodes: "Class.Function" and function names passed to timer functions by string */
+	FName QualifiedFunctionName;
+	TArray<FName> TimerFunctionNames;
+
+	/** Macro instance nodes: the instanced macro graph */
+	FName MacroGraphName;
+	FString MacroGraphPath;
+
+	TArray<FLintPinSnapshot> Pins;
+
+	bool IsEvent() const
+	{
+		return Kind == ELintNodeKind::Event || Kind == ELintNodeKind::CustomEvent || Kind == ELintNodeKind::ComponentBoundEvent;
+	}
+};
+
+struct BLUEPRINTPROFILER_API FLintGraphSnapshot
+{
+	ELintGraphKind Kind = ELintGraphKind::Ubergraph;
+	FName Name;
+	FString PathName;
+	TArray<FLintNodeSnapshot> Nodes;
+
+	// 仅函数图：需要 UClass / FBlueprintEditorUtils 才能判断的引用信息
+	bool bOverridesParentFunction = false;
+	bool bImplementsInterfaceFunction = false;
+	bool bUsedByEditorReferences = false;
+};
+
+struct BLUEPRINTPROFILER_API FLintVariableSnapshot
+{
+	FName Name;
+	bool bEventDispatcher = false;
+};
+
+struct BLUEPRINTPROFILER_API FBlueprintLintSnapshot
+{
+	FString BlueprintPath;
+	FString BlueprintName;
+	bool bInterface = false;
+	bool bGameInstance = false;
+
+	/** Ubergraph pages, then function graphs, then macro graphs */
+	TArray<FLintGraphSnapshot> Graphs;
+	TArray<FLintVariableSnapshot> Variables;
+
+	/**
+	 * Copies the graphs of a loaded blueprint. Game thread only.
+	 * @param bReferencesOnly          Only keep what FLintCallSites needs (no titles, pins or variables)
+	 * @param bResolveFunctionUsage    Also run the editor reference search for each function graph
+	 */
+	static FBlueprintLintSnapshot Build(UBlueprint* Blueprint, bool bReferencesOnly = false, bool bResolveFunctionUsage = true);
+};
+
+/**
+ * Functions and macros one blueprint references (phase one of FLintReferenceIndex)
+ *
+ * Derived from a snapshot and stored with it in the lint cache, so unchanged blueprints contribute their
+ * references to a scan without being loaded or snapshotted again.
+ */
+struct BLUEPRINTPROFILER_API FLintCallSites
+{
+	TArray<FName> Functions;    // Bare and Class-qualified names, timer targets and delegate-bound events
+	TArray<FName> Macros;
+
+	static FLintCallSites Collect(const FBlueprintLintSnapshot& Snapshot);
+
+	int32 Num() const { return Functions.Num() + Macros.Num(); }
+};
+
+/**
+ * Project-wide callee -> caller graph used by the cross-blueprint passes (phase two)
+ *
+ * Call sites are registered per asset while assets are visited, in any order and from any scan scope;
+ * Resolve builds the caller lists once. After that, SetCallSites / RemoveAsset update only the edges of the
+ * changed asset, so a single modified blueprint does not require a rebuild.
+ */
+struct BLUEPRINTPROFILER_API FLintReferenceIndex
+{
+	/** Registers or replaces the call sites of an asset */
+	void SetCallSites(FName AssetName, FLintCallSites&& CallSites);
+	void RemoveAsset(FName AssetName);
+
+	void Resolve();
+	bool IsResolved() const { return bResolved; }
+
+	// 查询仅在 Resolve 之后有效
+	bool IsFunctionReferenced(FName FunctionName) const { return FunctionCallers.Contains(FunctionName); }
+	bool IsMacroReferenced(FName MacroName) const { return MacroCallers.Contains(MacroName); }
+
+	/** Assets that reference the function; empty if none */
+	TArray<FName> GetFunctionCallers(FName FunctionName) const;
+
+	int32 NumAssets() const { return AssetCallSites.Num(); }
+
+private:
+	void LinkAsset(FName AssetName, const FLintCallSites& CallSites);
+	void UnlinkAsset(FName AssetName, const FLintCallSites& CallSites);
+
+	TMap<FName, FLintCallSites> AssetCallSites;
+	TMap<FName, TSet<FName>> FunctionCallers;
+	TMap<FName, TSet<FName>> MacroCallers;
+	bool bResolved = false;
+};
+
+// 快照序列化（lint 缓存）；FName 需通过 FNameAsStringProxyArchive 等能写名称的归档
+BLUEPRINTPROFILER_API FArchive& operator<<(FArchive& Ar, FLintPinSnapshot& Pin);
+BLUEPRINTPROFILER_API FArchive& operator<<(FArchive& Ar, FLintNodeSnapshot& Node);
+BLUEPRINTPROFILER_API FArchive& operator<<(FArchive& Ar, FLintGraphSnapshot& Graph);
+BLUEPRINTPROFILER_API FArchive& operator<<(FArchive& Ar, FLintVariableSnapshot& Variable);
+BLUEPRINTPROFILER_API FArchive& operator<<(FArchive& Ar, FBlueprintLintSnapshot& Snapshot);
+BLUEPRINTPROFILER_API FArchive& operator<<(FArchive& Ar, FLintCallSites& CallSites);
@@ -0,0 +1,49 @@
+// Copyright xnbmy 2026. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/ProfilerDataTypes.h"
+#include "AssetRegistry/AssetDataTagMap.h"
+
+struct FAssetData;
+struct FBlueprintLintSnapshot;
+
+/**
+ * Asset registry tags the plugin adds to blueprints when they are saved
+ *
+ * They summarize the graphs so the linter can tell, before loading a package, which checks could report
+ * anything for it. Blueprints saved before the plugin was enabled have no lint tags and are always loaded;
+ * the engine's own IsDataOnly tag is honored for those as well.
+ */
+struct BLUEPRINTPROFILER_API FBlueprintLintTags
+{
+	/** Bump when the meaning of a tag changes; assets with another version are treated as untagged */
+	static constexpr int32 TagsVersion = 1;
+
+	static const FName Version;
+	static const FName NumNodes;
+	static const FName NumVariables;
+	static const FName NumFunctionGraphs;   // Function and macro graphs
+	static const FName NumCasts;
+	static const FName NumReferences;       // FLintCallSites of the blueprint
+	static const FName HasTickEvent;
+
+	/** Hooks blueprint saving; called from module startup / shutdown */
+	static void Register();
+	static void Unregister();
+
+	static void GetTags(const FBlueprintLintSnapshot& Snapshot, FAssetDataTagMap& OutTags);
+
+	/** Enabled checks that may report issues for the asset, judged from its tags alone */
+	static TSet<ELintIssueType> GetApplicableChecks(const FAssetData& AssetData, const TSet<ELintIssueType>& EnabledChecks);
+
+	/** False only when the tags show that the blueprint references no functions or macros */
+	static bool MayHaveReferences(const FAssetData& AssetData);
+
+	/** Node count from the tags; INDEX_NONE for untagged assets */
+	static int32 GetNumNodes(const FAssetData& AssetData);
+
+private:
+	static FDelegateHandle TagsHandle;
+};
@@ -0,0 +1,96 @@
+// Copyright xnbmy 2026. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Data/ProfilerDataTypes.h"
+#include "UObject/ObjectKey.h"
+
+class UBlueprintGeneratedClass;
+
+/**
+ * Runtime memory capture - periodically attributes live memory to Blueprint classes
+ *
+ * Every interval a pass walks the global object array and, for each instance of a UBlueprintGeneratedClass in a
+ * play world, sums the exclusive GetResourceSizeEx of the instance and of its subobjects. Subobjects that are
+ * Blueprint instances themselves are left to their own class, so class totals do not overlap. The pass resumes
+ * from an object index on the core ticker and stops each tick once the budget is used up, so a full pass spreads
+ * over several frames; objects created or destroyed meanwhile are seen or missed depending on their index.
+ * Game thread only.
+ */
+class BLUEPRINTPROFILER_API FBlueprintMemoryCapture
+{
+public:
+	FBlueprintMemoryCapture() = default;
+	~FBlueprintMemoryCapture();
+
+	FBlueprintMemoryCapture(const FBlueprintMemoryCapture&) = delete;
+	FBlueprintMemoryCapture& operator=(const FBlueprintMemoryCapture&) = delete;
+
+	/** Starts periodic passes; snapshots taken so far are kept */
+	void Start();
+
+	/** Stops ticking and drops the pass in progress */
+	void Stop();
+
+	bool IsCapturing() const { return TickerHandle.IsValid(); }
+
+	/** Runs a whole pass in one go, finishing the pass in progress if any */
+	void CaptureNow();
+
+	/** Drops all snapshots and the pass in progress */
+	void Reset();
+
+	/** Replaces the snapshots, e.g. with the ones of a loaded session */
+	void SetSnapshots(TArray<FBlueprintMemorySnapshot>&& InSnapshots);
+	const TArray<FBlueprintMemorySnapshot>& GetSnapshots() const { return Snapshots; }
+
+	void SetIntervalSeconds(float InSeconds) { IntervalSeconds = FMath::Max(InSeconds, 0.0f); }
+	float GetIntervalSeconds() const { return IntervalSeconds; }
+	void SetBudgetMs(float InBudgetMs) { BudgetMs = FMath::Max(InBudgetMs, 0.01f); }
+	float GetBudgetMs() const { return BudgetMs; }
+
+	/** Editor objects are skipped unless this is turned off */
+	void SetPlayWorldsOnly(bool bInPlayWorldsOnly) { bPlayWorldsOnly = bInPlayWorldsOnly; }
+
+	DECLARE_MULTICAST_DELEGATE_OneParam(FOnSnapshotCaptured, const FBlueprintMemorySnapshot& /* Snapshot */);
+	FOnSnapshotCaptured OnSnapshotCaptured;
+
+	/** Blueprint class of a live instance to attribute, nullptr for anything else (CDOs, archetypes, editor objects) */
+	static UBlueprintGeneratedClass* GetInstanceClass(const UObject* Object, bool bPlayWorldsOnly);
+
+	/** Exclusive resource size of the instance and of its subobjects, not descending into nested Blueprint instances */
+	static int64 MeasureInstance(UObject* Instance);
+
+	/** Name the runtime profiler uses for nodes of this class: the Blueprint asset name */
+	static FString GetBlueprintName(const UBlueprintGeneratedClass* Class);
+
+	/**
+	 * Folds snapshots into one row per Blueprint and joins the exclusive CPU time of its nodes.
+	 * Rows are sorted by growth, then by latest size.
+	 */
+	static void BuildTrends(TConstArrayView<FBlueprintMemorySnapshot> InSnapshots, TConstArrayView<FNodeExecutionData> ExecutionData, TArray<FBlueprintMemoryTrend>& OutTrends);
+
+private:
+	bool Tick(float DeltaTime);
+	void BeginPass();
+	bool StepPass(double EndTime);  // true once the pass has reached the end of the object array
+	void FinishPass();
+
+	FTSTicker::FDelegateHandle TickerHandle;
+	TArray<FBlueprintMemorySnapshot> Snapshots;
+
+	float IntervalSeconds = 1.0f;
+	float BudgetMs = 1.0f;
+	bool bPlayWorldsOnly = true;
+
+	// Pass in progress; classes are keyed by FObjectKey so a class collected between ticks is not confused with a new one
+	bool bPassActive = false;
+	int32 NextObjectIndex = 0;
+	double PassStartTime = 0.0;
+	double PassCaptureSeconds = 0.0;
+	uint64 PassFirstFrame = 0;
+	TMap<FObjectKey, int32> PassClassIndices;
+	TArray<FBlueprintClassMemory> PassClasses;
+};
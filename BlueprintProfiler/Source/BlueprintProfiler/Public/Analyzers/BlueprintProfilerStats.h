@@ -0,0 +1,22 @@
+// Copyright xnbmy 2026. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+/** "stat BlueprintProfiler": runtime profiler hooks and the static linter stages */
+DECLARE_STATS_GROUP(TEXT("BlueprintProfiler"), STATGROUP_BlueprintProfiler, STATCAT_Advanced);
+
+/**
+ * Scoped cycle counter that also shows up as a CPU scope in Unreal Insights (-trace=cpu)
+ *
+ * With stats compiled in, the cycle counter already emits the trace scope; without them only the trace
+ * scope is left, so the stage stays visible in Insights either way.
+ */
+#if STATS
+#define BLUEPRINTPROFILER_SCOPE_CYCLE_COUNTER(Stat) SCOPE_CYCLE_COUNTER(Stat)
+#else
+#define BLUEPRINTPROFILER_SCOPE_CYCLE_COUNTER(Stat) TRACE_CPUPROFILER_EVENT_SCOPE(Stat)
+#endif
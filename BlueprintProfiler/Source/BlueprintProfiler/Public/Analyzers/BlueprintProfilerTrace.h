@@ -0,0 +1,45 @@
+// Copyright xnbmy 2026. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+/**
+ * Unreal Insights output for Blueprint node spans
+ *
+ * Node enter/exit is written as CPU profiler timer events on the executing thread, so Insights' built-in
+ * CpuProfiler analyzer nests the spans under the engine scopes of the same frame in the timing view.
+ * Events are only emitted while both BlueprintProfilerChannel and the cpu channel are enabled,
+ * e.g. -trace=cpu,BlueprintProfiler or Trace.Enable cpu,BlueprintProfiler; otherwise the cost is one branch.
+ */
+#if CPUPROFILERTRACE_ENABLED
+UE_TRACE_CHANNEL_EXTERN(BlueprintProfilerChannel, BLUEPRINTPROFILER_API)
+#endif
+
+namespace BlueprintProfilerTrace
+{
+	inline bool IsEnabled()
+	{
+#if CPUPROFILERTRACE_ENABLED
+		return UE_TRACE_CHANNELEXPR_IS_ENABLED(BlueprintProfilerChannel) && UE_TRACE_CHANNELEXPR_IS_ENABLED(CpuChannel);
+#else
+		return false;
+#endif
+	}
+
+	/**
+	 * Timer spec of the node at a code offset of a Blueprint function, shared by every instance and thread.
+	 * Names are resolved on the game thread as "BP <Blueprint>: <NodeTitle>"; a node first seen on another thread
+	 * gets its function's timer until the game thread runs it. Returns 0 when the function is unknown.
+	 */
+	BLUEPRINTPROFILER_API uint32 GetNodeTimerId(const UFunction* Function, int32 CodeOffset);
+
+	/** Forgets the function and offset keys, which recompiles and unloads make stale; called when recording stops */
+	BLUEPRINTPROFILER_API void ResetNodeTimers();
+
+	/** Opens a span; every call must be matched by EndNode on the same thread */
+	BLUEPRINTPROFILER_API void BeginNode(uint32 TimerId);
+	BLUEPRINTPROFILER_API void EndNode();
+}
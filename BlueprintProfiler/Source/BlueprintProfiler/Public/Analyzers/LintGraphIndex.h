@@ -0,0 +1,55 @@
+// Copyright xnbmy 2026. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Analyzers/BlueprintLintSnapshot.h"
+
+/**
+ * Per-graph lookup tables shared by the Detect* passes
+ *
+ * Built in one pass over the pins of a graph snapshot: exec successors in CSR form (one offsets array, one
+ * targets array), pin link state per node, and which nodes the exec flow reaches from Tick events and from
+ * loop bodies. Detectors query these instead of walking pins themselves, which keeps a blueprint linear in
+ * its node and link count no matter how many casts it has.
+ */
+struct BLUEPRINTPROFILER_API FLintGraphIndex
+{
+	/** Exec successors of node N are ExecTargets[ExecOffsets[N] .. ExecOffsets[N + 1]) */
+	TArray<int32> ExecOffsets;
+	TArray<int32> ExecTargets;
+
+	// 每个节点一位
+	TBitArray<> HasAnyLink;
+	TBitArray<> HasLinkedOutput;
+	TBitArray<> HasLinkedDataInput;
+	TBitArray<> HasLinkedDataOutput;
+	TBitArray<> HasExecInput;
+	TBitArray<> HasLinkedExecInput;
+
+	TBitArray<> TickEvents;
+	TBitArray<> ReachedFromTick;    // Tick events and everything downstream of them
+	TBitArray<> ReachedFromLoop;    // Everything downstream of a loop body output; Completed outputs are not followed
+
+	explicit FLintGraphIndex(const FLintGraphSnapshot& Graph);
+
+	int32 Num() const { return ExecOffsets.Num() - 1; }
+
+	TConstArrayView<int32> GetExecSuccessors(int32 Node) const
+	{
+		return TConstArrayView<int32>(ExecTargets.GetData() + ExecOffsets[Node], ExecOffsets[Node + 1] - ExecOffsets[Node]);
+	}
+
+	/** Number of nodes the exec flow reaches from StartNode, StartNode included */
+	int32 CountReachable(int32 StartNode) const;
+
+	static bool IsTickEvent(const FLintNodeSnapshot& Node);
+	static bool IsLoopNode(const FLintNodeSnapshot& Node);
+
+private:
+	/** Marks Seeds and their exec descendants in OutReached */
+	void MarkReachable(const TBitArray<>& Seeds, TBitArray<>& OutReached) const;
+};
+
+/** Indices of all graphs of a snapshot, in Graphs order */
+using FLintSnapshotIndex = TArray<FLintGraphIndex>;
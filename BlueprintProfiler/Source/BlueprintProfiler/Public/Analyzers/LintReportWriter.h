@@ -0,0 +1,58 @@
+// Copyright xnbmy 2026. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/ProfilerDataTypes.h"
+
+class FArchive;
+
+enum class ELintReportFormat : uint8
+{
+	Json,
+	Sarif,
+	JUnit
+};
+
+/**
+ * Writes lint and memory findings to a report file for CI
+ *
+ * Entries are appended and flushed as they arrive, so a report of a long scan grows while it runs and the
+ * results of a killed agent are not lost up to the last batch; Close writes the closing brackets. JUnit test
+ * cases stream to <report>.cases instead, and Close writes the report with the counts on its suite. Each
+ * sharded run writes its own file, SARIF and JUnit consumers merge multiple files natively.
+ */
+class BLUEPRINTPROFILER_API FLintReportWriter
+{
+public:
+	~FLintReportWriter();
+
+	/** Parses "json", "sarif" or "junit"; falls back to the extension of FilePath, then to JSON */
+	static ELintReportFormat ParseFormat(const FString& FormatName, const FString& FilePath);
+
+	bool Open(const FString& FilePath, ELintReportFormat InFormat);
+	bool IsOpen() const { return Writer.IsValid(); }
+	void Close();
+
+	void WriteIssues(TConstArrayView<FLintIssue> Issues);
+	void WriteLargeResource(const FString& BlueprintPath, const FLargeResourceReference& Resource);
+
+	int32 GetNumEntries() const { return NumEntries; }
+
+	/** Rule ids used in reports: the ELintIssueType name, or LargeResource for memory findings */
+	static FString GetRuleId(ELintIssueType Type);
+	static ESeverity GetLargeResourceSeverity(const FLargeResourceReference& Resource);
+	static const TCHAR* LargeResourceRuleId;
+
+private:
+	void WriteEntry(const FString& RuleId, const FString& BlueprintPath, const FString& Name,
+		const FString& Message, ESeverity Severity, const FGuid& NodeGuid);
+	void WriteJUnitReport();
+	static FString GetJUnitCasesPath(const FString& FilePath);
+	void WriteRaw(const FString& Text);
+
+	TUniquePtr<FArchive> Writer;
+	ELintReportFormat Format = ELintReportFormat::Json;
+	int32 NumEntries = 0;
+	FString ReportFilePath;
+};
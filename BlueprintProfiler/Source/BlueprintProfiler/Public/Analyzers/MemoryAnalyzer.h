@@ -4,24 +4,54 @@
 
 #include "CoreMinimal.h"
 #include "Data/ProfilerDataTypes.h"
+#include "Analyzers/ObjectSizeCache.h"
+#include "Analyzers/AssetDependencyGraph.h"
+#include "Analyzers/AssetDominatorTree.h"
+#include "Containers/Ticker.h"
 #include "Engine/Blueprint.h"
+#include "Tasks/Task.h"
+#include "UObject/ResourceSize.h"
+#include <atomic>
 
 DECLARE_MULTICAST_DELEGATE_OneParam(FOnAnalysisComplete, const FMemoryAnalysisResult& /* Result */);
 DECLARE_MULTICAST_DELEGATE_OneParam(FOnAnalysisProgress, float /* Progress */);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnMemoryAuditComplete, const TArray<FBlueprintMemoryAuditEntry>& /* RankedEntries */);
 
 /**
- * Reference node for building reference trees
+ * Large-resource thresholds of asset classes, for assets that may not be loaded (memory audit)
+ *
+ * Gathered on the game thread from the loaded classes; IsLarge only reads asset registry data and is safe on any thread.
+ */
+struct BLUEPRINTPROFILER_API FLargeResourceRules
+{
+	/** Threshold scale per asset class; classes that are not listed use 1 */
+	TMap<FTopLevelAssetPath, float> ClassThresholdScales;
+
+	/** 2D texture classes; 2048x2048 and larger textures always count as large */
+	TSet<FTopLevelAssetPath> TextureClasses;
+
+	static FLargeResourceRules Gather();
+	bool IsLarge(const FAssetData& AssetData, int64 SizeBytes, float ThresholdMB) const;
+};
+
+/**
+ * Node of a flat reference tree: nodes are stored breadth-first in one array and link to their parent by index
  */
 struct BLUEPRINTPROFILER_API FReferenceNode
 {
 	TWeakObjectPtr<UObject> Object;
 	FString ObjectName;
 	FString ObjectType;
-	float ObjectSize;
-	TArray<TSharedPtr<FReferenceNode>> Children;
+	float ObjectSize;    // MB, like the sizes of FMemoryAnalysisResult
+	int32 ParentIndex;   // INDEX_NONE for the root
+	int32 Depth;
+	int32 NumChildren;
 
 	FReferenceNode()
 		: ObjectSize(0.0f)
+		, ParentIndex(INDEX_NONE)
+		, Depth(0)
+		, NumChildren(0)
 	{
 	}
 };
@@ -41,6 +71,9 @@ public:
 	void CancelAnalysis();
 	bool IsAnalysisInProgress() const { return bAnalysisInProgress; }
 
+	/** The dominator tree is being built in the background for results marked bPackageSizesPending; does not block other analyses */
+	bool IsDominatorTreeBuildInProgress() const { return DominatorTreeTickerHandle.IsValid(); }
+
 	// Results access
 	FMemoryAnalysisResult GetAnalysisResult(UBlueprint* Blueprint) const;
 	TArray<FLargeResourceReference> GetLargeResourceReferences(float SizeThresholdMB = 10.0f) const;
@@ -54,33 +87,72 @@ public:
 
 	// Asset reference count analysis
 	void AnalyzeAssetReferenceCounts();
-	void ProcessNextAssetBatch();
-	void CompleteReferenceCountAnalysis();
 	TArray<FAssetReferenceCount> GetAssetReferenceCounts() const;
 	TArray<FAssetReferenceCount> GetTopReferencedAssets(int32 Count = 50) const;
+	int32 GetNumAssetReferenceCounts() const;
 	void ClearReferenceCountData();
 
+	/** Registry snapshot of the last reference count analysis; null before the first one completes */
+	TSharedPtr<const FAssetDependencyGraph> GetDependencyGraph() const;
+
+	/**
+	 * Referencer counts of every package in the graph, sorted by count (descending); one parallel pass, no loading.
+	 * Sizes come from the size cache when the asset was measured and from the package size on disk otherwise.
+	 */
+	static TArray<FAssetReferenceCount> ComputeReferenceCounts(const FAssetDependencyGraph& Graph, const FObjectSizeCache* SizeCache = nullptr);
+
+	/**
+	 * Dominator tree of the current dependency graph, built on first use (including the graph if there is none yet).
+	 * Rebuilt after a reference count analysis replaces the graph. Worker threads only; null if bCancel is set while building.
+	 */
+	TSharedPtr<const FAssetDominatorTree> GetOrBuildDominatorTree(const std::atomic<bool>* bCancel = nullptr);
+
+	/** Any thread: dominator tree of the current dependency graph if it has been built, null otherwise; never builds */
+	TSharedPtr<const FAssetDominatorTree> FindDominatorTree() const;
+
+	/** Bytes per package for the dominator tree, from the size cache where measured and the disk size otherwise */
+	static TArray<int64> GatherPackageSizes(const FAssetDependencyGraph& Graph, const FObjectSizeCache* SizeCache = nullptr);
+
+	/**
+	 * Project-wide memory audit of every blueprint under the paths (default /Game), evaluated concurrently against the
+	 * shared dependency graph and dominator tree without loading assets. Cancelled by CancelAnalysis.
+	 */
+	void AuditBlueprints(const TArray<FString>& PackagePaths);
+	TArray<FBlueprintMemoryAuditEntry> GetMemoryAuditResults() const;
+
+	/** Audit rows of the packages ranked by retained size (descending); one parallel pass over the tree */
+	static TArray<FBlueprintMemoryAuditEntry> ComputeMemoryAudit(const FAssetDominatorTree& DominatorTree, TConstArrayView<int32> BlueprintPackages,
+		const FLargeResourceRules& Rules, float ThresholdMB, const std::atomic<bool>* bCancelRequested = nullptr);
+
+	/** Multiplier applied to the large-resource threshold for assets of the class */
+	static float GetLargeResourceThresholdScale(const UClass* AssetClass);
+
+	// Object sizes shared with the background analysis task
+	FObjectSizeCache& GetSizeCache() { return SizeCache; }
+
 	// Events
 	FOnAnalysisComplete OnAnalysisComplete;
 	FOnAnalysisComplete OnReferenceCountComplete;
 	FOnAnalysisProgress OnAnalysisProgress;
+	FOnMemoryAuditComplete OnMemoryAuditComplete;
 
 	// Internal methods for async task (Exposed for FMemoryAnalysisTask)
-	void CalculateInclusiveSize(UBlueprint* Blueprint, FMemoryAnalysisResult& Result);
-	void CompleteAnalysis(UBlueprint* Blueprint, const FMemoryAnalysisResult& Result);
 
-	// Reference count analysis methods
-	void CountAssetReferences(UObject* Asset, TMap<FString, FAssetReferenceCount>& OutReferenceCounts);
-	int32 CountAssetReferencesInternal(UObject* Asset);
-	void FindAllAssets(TArray<UObject*>& OutAssets);
+	/** Game thread: reference chains, large references and the sizes summed over the chain objects; the result is plain data */
+	void GatherObjectReferences(UBlueprint* Blueprint, FMemoryAnalysisResult& Result);
+
+	/** Any thread: replaces the summed sizes with the package-level sizes of the tree; false if the package is not in it (unsaved) */
+	static bool ApplyPackageSizes(const FAssetDominatorTree& Tree, FName PackageName, FMemoryAnalysisResult& Result);
+
+	void CompleteAnalysis(UBlueprint* Blueprint, const FMemoryAnalysisResult& Result);
 
 private:
 	// Analysis methods
 	void TraceReferenceChains(UObject* Object, TArray<FReferenceChain>& OutChains, int32 MaxDepth = 10);
 	void FindLargeResourceReferences(UBlueprint* Blueprint, TArray<FLargeResourceReference>& OutReferences);
-	float CalculateObjectSize(UObject* Object) const;
-	void BuildReferenceTree(UObject* RootObject, TSharedPtr<FReferenceNode> ParentNode, TSet<UObject*>& VisitedObjects, int32 CurrentDepth, int32 MaxDepth);
-	void BuildReferenceTreeWithReferenceFinder(UObject* RootObject, TSharedPtr<FReferenceNode> ParentNode, TSet<UObject*>& VisitedObjects, int32 CurrentDepth, int32 MaxDepth);
+	float CalculateObjectSize(UObject* Object, EResourceSizeMode::Type Mode = EResourceSizeMode::Exclusive) const;
+	void GatherSizePrewarmPaths(UBlueprint* Blueprint, TArray<FSoftObjectPath>& OutObjectPaths) const;
+	void BuildReferenceTree(UObject* RootObject, int32 MaxDepth, TArray<FReferenceNode>& OutNodes) const;
 
 	// Large resource analysis methods
 	void AnalyzePropertyForLargeResources(UBlueprint* Blueprint, class FProperty* Property, TArray<FLargeResourceReference>& OutReferences, float ThresholdMB = 10.0f);
@@ -91,20 +163,50 @@ private:
 	bool IsLargeResource(UObject* Object, float ThresholdMB) const;
 	FString GetObjectTypeName(UObject* Object) const;
 
+	// Background analyses (reference counts, memory audit): the task runs on a worker, completion is polled on the core ticker
+	void LaunchBackgroundTask(const TCHAR* DebugName, TUniqueFunction<void()>&& Work, TUniqueFunction<void()>&& OnComplete);
+	bool TickBackgroundTask(float DeltaTime);
+	void CompleteReferenceCountAnalysis();
+	void CompleteMemoryAudit();
+
+	/**
+	 * Builds the dependency graph and dominator tree in the background, then fills in the results marked bPackageSizesPending.
+	 * Tracked apart from BackgroundTask and bAnalysisInProgress, so analyses started meanwhile are not refused.
+	 */
+	void RequestDominatorTree();
+	bool TickDominatorTreeBuild(float DeltaTime);
+	void CancelDominatorTreeBuild();
+	void CompleteDominatorTreeBuild();
+
 private:
 	TMap<TWeakObjectPtr<UObject>, FMemoryAnalysisResult> AnalysisResults;
 	TArray<FLargeResourceReference> LargeResourceReferences;
 	TArray<FAssetReferenceCount> AssetReferenceCounts;
 	bool bAnalysisInProgress;
-	bool bCancelRequested;
+	std::atomic<bool> bCancelRequested;
 	float LargeResourceThresholdMB;
 
-	// Reference count processing state
-	TArray<UObject*> PendingAssets;
-	int32 CurrentAssetIndex;
-	TMap<FString, FAssetReferenceCount> ReferenceCountMap;
+	// Background analysis state; the Pending* members belong to BackgroundTask until it completes
+	UE::Tasks::FTask BackgroundTask;
+	FTSTicker::FDelegateHandle BackgroundTickerHandle;
+	TUniqueFunction<void()> OnBackgroundTaskComplete;
+	TSharedPtr<const FAssetDependencyGraph> PendingDependencyGraph;
+	TArray<FAssetReferenceCount> PendingReferenceCounts;
+	TArray<FBlueprintMemoryAuditEntry> PendingAuditEntries;
+	TSharedPtr<const FAssetDependencyGraph> DependencyGraph;
+	TArray<FBlueprintMemoryAuditEntry> MemoryAuditResults;
+
+	// 支配树按需构建，锁保证并发请求只构建一次；DominatorTree 的写入同时持有 ResultsLock，读取持有任一把锁即可
+	FCriticalSection DominatorTreeLock;
+	TSharedPtr<const FAssetDominatorTree> DominatorTree;
+	UE::Tasks::FTask DominatorTreeTask;
+	FTSTicker::FDelegateHandle DominatorTreeTickerHandle;
+	std::atomic<bool> bCancelDominatorTreeBuild = false;
 
 	// Async task management
 	TSharedPtr<class FAsyncTask<class FMemoryAnalysisTask>> CurrentAnalysisTask;
 	mutable FCriticalSection ResultsLock;
+
+	// 游戏线程测量，后台任务只读缓存
+	mutable FObjectSizeCache SizeCache;
 };
\ No newline at end of file
@@ -0,0 +1,97 @@
+// Copyright xnbmy 2026. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "UObject/SoftObjectPath.h"
+
+class UPackage;
+class FObjectPostSaveContext;
+class FPackageReloadedEvent;
+enum class EPackageReloadPhase : uint8;
+
+/**
+ * Memory footprint of one object as measured by FObjectSizeCache
+ */
+struct BLUEPRINTPROFILER_API FObjectSizeInfo
+{
+	int64 ExclusiveBytes = 0;       // GetResourceSizeEx(EResourceSizeMode::Exclusive)
+	int64 EstimatedTotalBytes = 0;  // GetResourceSizeEx(EResourceSizeMode::EstimatedTotal)
+
+	/** Object was not loaded; both sizes are the package size on disk from the asset registry */
+	bool bFromDisk = false;
+};
+
+/**
+ * Memoized object sizes keyed by object path
+ *
+ * GetResourceSizeEx may only be called on the game thread, so sizes are measured there, either on demand or in
+ * time-sliced batches on the core ticker (RequestSizes). Any thread can read measured sizes through Find without
+ * touching the UObject. Entries of a package are dropped when it is saved or reloaded.
+ */
+class BLUEPRINTPROFILER_API FObjectSizeCache
+{
+public:
+	/** Game-thread time spent measuring per tick while requests are pending */
+	static constexpr double MaxMeasureSecondsPerTick = 0.005;
+
+	FObjectSizeCache();
+	~FObjectSizeCache();
+
+	FObjectSizeCache(const FObjectSizeCache&) = delete;
+	FObjectSizeCache& operator=(const FObjectSizeCache&) = delete;
+
+	/** Any thread: size measured earlier, false if the object has not been measured */
+	bool Find(const FSoftObjectPath& ObjectPath, FObjectSizeInfo& OutInfo) const;
+
+	/** Game thread: cached size, measuring the object if needed */
+	FObjectSizeInfo GetOrMeasure(UObject* Object);
+
+	/** Game thread: cached size, measured if the object is loaded and read from the package size on disk otherwise */
+	FObjectSizeInfo GetOrMeasure(const FSoftObjectPath& ObjectPath);
+
+	/**
+	 * Game thread: measures the objects over the next ticks, at most MaxMeasureSecondsPerTick per tick.
+	 * OnComplete runs on the game thread once all of them are in the cache; it is not called after CancelRequests.
+	 */
+	void RequestSizes(TArray<FSoftObjectPath>&& ObjectPaths, TFunction<void()>&& OnComplete);
+	void CancelRequests();
+	bool HasPendingRequests() const { return PendingRequests.Num() > 0; }
+
+	/** Drops the sizes of all objects in the package */
+	void Invalidate(FName PackageName);
+	void Empty();
+	int32 Num() const;
+
+	/** Game thread: measures without touching the cache */
+	static FObjectSizeInfo Measure(UObject* Object);
+
+	/** Size of the package file from the asset registry; INDEX_NONE if the registry does not know the package */
+	static int64 GetPackageDiskSize(FName PackageName);
+
+private:
+	struct FSizeRequest
+	{
+		TArray<FSoftObjectPath> ObjectPaths;
+		int32 NextIndex = 0;
+		TFunction<void()> OnComplete;
+	};
+
+	void Store(const FSoftObjectPath& ObjectPath, const FObjectSizeInfo& Info);
+	bool TickRequests(float DeltaTime);
+
+	void HandlePackageSaved(const FString& PackageFileName, UPackage* Package, FObjectPostSaveContext ObjectSaveContext);
+	void HandlePackageReloaded(EPackageReloadPhase Phase, FPackageReloadedEvent* Event);
+
+	// 后台分析线程只读，写入都在游戏线程
+	mutable FRWLock SizesLock;
+	TMap<FSoftObjectPath, FObjectSizeInfo> Sizes;
+
+	// 仅游戏线程访问
+	TArray<FSizeRequest> PendingRequests;
+	FTSTicker::FDelegateHandle RequestTickerHandle;
+
+	FDelegateHandle PackageSavedHandle;
+	FDelegateHandle PackageReloadedHandle;
+};
@@ -4,8 +4,12 @@
 
 #include "CoreMinimal.h"
 #include "Data/ProfilerDataTypes.h"
+#include "Data/ProfilerSessionFile.h"
+#include "Analyzers/BlueprintMemoryCapture.h"
 #include "Engine/Blueprint.h"
 #include "EdGraph/EdGraph.h"
+#include "Containers/Ticker.h"
+#include "UObject/ObjectKey.h"
 
 // Forward declarations for blueprint instrumentation
 struct FFrame;
@@ -16,19 +20,127 @@ struct FBlueprintBreakpoint;
 struct FBlueprintExceptionInfo;
 
 /**
- * Execution frame data for timeline analysis
+ * Node stats table - interns each profiled object (graph node or script context) to a dense uint32 ID
+ * Stats are stored as struct-of-arrays indexed by ID, so recording only touches a few contiguous counters.
+ * Names are resolved lazily on read; all methods are game thread only.
  */
-struct BLUEPRINTPROFILER_API FExecutionFrame
+class BLUEPRINTPROFILER_API FNodeStatsTable
 {
-	double Timestamp;
-	TWeakObjectPtr<UObject> ObjectPtr;
-	float ExecutionTime;
-	
-	FExecutionFrame()
-		: Timestamp(0.0)
-		, ExecutionTime(0.0f)
+public:
+	static constexpr uint32 InvalidId = MAX_uint32;
+
+	// ID management
+	uint32 Intern(const TWeakObjectPtr<UObject>& Object);
+	uint32 Find(const TWeakObjectPtr<UObject>& Object) const;
+	int32 Num() const { return Objects.Num(); }
+	bool IsValidId(uint32 Id) const { return Id < static_cast<uint32>(Objects.Num()); }
+	void Reset();
+
+	// Recording
+	void AddExecution(uint32 Id) { ExecutionCounts[Id]++; MarkChanged(Id); }
+	void AddTiming(uint32 Id, uint64 InclusiveCycles, uint64 ExclusiveCycles);
+	void AddExecutionTime(uint32 Id, float ExecutionTime);
+
+	// Stats access
+	const TWeakObjectPtr<UObject>& GetObject(uint32 Id) const { return Objects[Id]; }
+	int32 GetExecutionCount(uint32 Id) const { return ExecutionCounts[Id]; }
+	float GetTotalExecutionTime(uint32 Id) const { return TotalExecutionTimes[Id]; }
+	float GetAverageExecutionTime(uint32 Id) const;
+	float GetTotalExclusiveTime(uint32 Id) const;
+	float GetAverageExclusiveTime(uint32 Id) const;
+	float GetPercentileExecutionTime(uint32 Id, float Percentile) const { return Histograms[Id].GetPercentile(Percentile); }
+	float GetExecutionsPerSecond(uint32 Id, float RecordingDuration) const;
+	FNodeExecutionStats GetStats(uint32 Id) const;
+
+	// Lazily resolved names (PIE结束后对象失效时仍能显示)
+	bool HasNodeInfo(uint32 Id) const { return !NodeNames[Id].IsEmpty(); }
+	void SetNodeInfo(uint32 Id, const FString& NodeName, const FString& BlueprintName, const FGuid& NodeGuid);
+	const FString& GetNodeName(uint32 Id) const { return NodeNames[Id]; }
+	const FString& GetBlueprintName(uint32 Id) const { return BlueprintNames[Id]; }
+	const FGuid& GetNodeGuid(uint32 Id) const { return NodeGuids[Id]; }
+
+	// IDs recorded since the previous call, in first-change order
+	void ConsumeChangedIds(TArray<uint32>& OutIds);
+
+private:
+	void MarkChanged(uint32 Id)
 	{
+		if (!ChangedFlags[Id])
+		{
+			ChangedFlags[Id] = true;
+			ChangedIds.Add(Id);
+		}
 	}
+
+	TMap<TWeakObjectPtr<UObject>, uint32> ObjectToId;
+
+	// Hot: touched on every drained event
+	TArray<int32> ExecutionCounts;
+	TArray<int32> TimedExecutionCounts;
+	TArray<uint64> InclusiveCycles;
+	TArray<uint64> ExclusiveCycles;
+	TArray<float> TotalExecutionTimes;
+	TArray<float> MinExecutionTimes;
+	TArray<float> MaxExecutionTimes;
+	TArray<FExecutionSampleRing> RecentExecutionTimes;
+	TArray<FExecutionTimeHistogram> Histograms;
+	TBitArray<> ChangedFlags;
+	TArray<uint32> ChangedIds;
+
+	// Cold: only read when data is requested
+	TArray<TWeakObjectPtr<UObject>> Objects;
+	TArray<FString> NodeNames;
+	TArray<FString> BlueprintNames;
+	TArray<FGuid> NodeGuids;
+};
+
+/**
+ * Rolling per-frame cost store - exclusive time of each node, bucketed by the GFrameCounter it started in
+ * Frames stay open while their events are drained and are completed (with per-Blueprint totals) once
+ * the engine has moved past them. Fixed-capacity ring, game thread only.
+ */
+class BLUEPRINTPROFILER_API FFrameCostStore
+{
+public:
+	static constexpr int32 Capacity = 600;
+
+	struct FFrameRecord
+	{
+		uint64 FrameNumber = 0;
+		double Timestamp = 0.0;
+		uint64 TotalCycles = 0;
+		TArray<TPair<uint32, uint64>> NodeCycles;       // node ID -> exclusive cycles
+		TArray<TPair<int32, uint64>> BlueprintCycles;   // Blueprint index -> exclusive cycles, filled on completion
+		bool bComplete = false;
+	};
+
+	/** Adds node time to its frame; events for frames already completed or evicted are dropped */
+	void AddCost(uint64 FrameNumber, double Timestamp, uint32 NodeId, uint64 Cycles);
+
+	/** Completes open frames older than FrameNumber. GetBlueprintIndex maps a node ID to InternBlueprint's index */
+	void CompleteFramesBefore(uint64 FrameNumber, TFunctionRef<int32(uint32)> GetBlueprintIndex, TFunctionRef<void(const FFrameRecord&)> OnFrameComplete);
+
+	const FFrameRecord* FindFrame(uint64 FrameNumber) const;
+	int32 Num() const { return Frames.Num(); }
+	const FFrameRecord& GetFrame(int32 Index) const { return Frames[(OldestIndex + Index) % Frames.Num()]; }  // 0 = oldest
+
+	int32 InternBlueprint(const FString& BlueprintName);
+	const FString& GetBlueprintName(int32 Index) const { return BlueprintNames[Index]; }
+
+	void Reset();
+
+private:
+	FFrameRecord* FindOpenFrame(uint64 FrameNumber);
+
+	TArray<FFrameRecord> Frames;
+	int32 OldestIndex = 0;
+
+	// Newest frame each node appeared in and its entry there, so AddCost does not search NodeCycles
+	TArray<uint64> NodeLastFrame;
+	TArray<int32> NodeLastEntry;
+
+	TArray<FString> BlueprintNames;
+	TMap<FString, int32> BlueprintLookup;
 };
 
 /**
@@ -49,6 +161,7 @@ public:
 
 	// Recording control
 	void StartRecording(const FString& SessionName = TEXT(""));
+	void StartRecording(const FString& SessionName, const FProfilerSamplingSettings& Sampling);
 	void StopRecording();
 	void ResetData();
 	void PauseRecording();
@@ -60,8 +173,9 @@ public:
 	// Session management
 	FRecordingSession GetCurrentSession() const { return CurrentSession; }
 	TArray<FRecordingSession> GetSessionHistory() const { return SessionHistory; }
-	void SaveSessionData(const FString& FilePath = TEXT(""));
+	void SaveSessionData(const FString& FilePath = TEXT(""));  // .bpsession binary, .json paths are exported as JSON
 	bool LoadSessionData(const FString& FilePath);
+	bool ExportSessionJson(const FString& FilePath);
 	void ClearSessionHistory();
 	FString GetSessionDataDirectory() const;
 
@@ -70,8 +184,45 @@ public:
 	TArray<FHotNodeInfo> GetHotNodes(float Threshold = 1000.0f) const;
 	TArray<FTickAbuseInfo> GetTickAbuseActors() const;
 
+	// Frame history - pages spilled to the session file are read back on demand
+	int64 GetNumExecutionFrames() const { return TotalFramesRecorded; }
+	bool GetExecutionFrames(int64 FirstFrame, int32 NumFrames, TArray<FExecutionFrame>& OutFrames);
+
+	// Per-frame Blueprint cost; a hitch is raised when a frame's Blueprint time exceeds the budget
+	DECLARE_MULTICAST_DELEGATE_OneParam(FOnBlueprintHitch, const FBlueprintFrameBreakdown& /* Hitch */);
+	FOnBlueprintHitch OnBlueprintHitch;
+	void SetHitchBudgetMs(float BudgetMs) { HitchBudgetMs = FMath::Max(BudgetMs, 0.0f); }
+	float GetHitchBudgetMs() const { return HitchBudgetMs; }
+	const TArray<FBlueprintFrameBreakdown>& GetHitches() const { return Hitches; }
+	bool GetFrameBreakdown(uint64 FrameNumber, FBlueprintFrameBreakdown& OutBreakdown) const;
+
+	// Blueprint instance memory, captured in time-sliced passes while recording and stored with the session
+	void SetCaptureBlueprintMemory(bool bEnabled) { bCaptureBlueprintMemory = bEnabled; }
+	bool GetCaptureBlueprintMemory() const { return bCaptureBlueprintMemory; }
+	FBlueprintMemoryCapture& GetMemoryCapture() { return MemoryCapture; }
+	const TArray<FBlueprintMemorySnapshot>& GetMemorySnapshots() const { return MemoryCapture.GetSnapshots(); }
+	TArray<FBlueprintMemoryTrend> GetBlueprintMemoryTrends() const;
+
+	// Live view - while recording, the stats of the nodes that ran are published at a fixed rate (0 turns it off)
+	DECLARE_MULTICAST_DELEGATE_OneParam(FOnLiveUpdate, const TSharedRef<const FRuntimeLiveUpdate, ESPMode::ThreadSafe>& /* Update */);
+	FOnLiveUpdate OnLiveUpdate;
+	void SetLiveUpdateRate(float UpdatesPerSecond) { LiveUpdateRate = FMath::Max(UpdatesPerSecond, 0.0f); }
+	float GetLiveUpdateRate() const { return LiveUpdateRate; }
+	/** Last published update; safe to call from any thread, the returned update is never modified afterwards */
+	TSharedPtr<const FRuntimeLiveUpdate, ESPMode::ThreadSafe> GetLatestLiveUpdate() const;
+
 	// Event handling
 	void OnScriptProfilingEvent(const FScriptInstrumentationSignal& Signal);
+
+	// Merges the per-thread event buffers into the node stats now instead of on the next tick; game thread only
+	void FlushEventBuffers();
+	uint64 GetNumDroppedEvents() const { return TotalDroppedEvents; }
+
+	// Events each script thread can buffer between drains; further events are dropped and counted
+	static constexpr uint32 EventBufferCapacity = 8192;
+
+	// Registered per-thread buffers, including those of exited threads that have not been drained yet
+	int32 GetNumEventBuffers() const;
 	void OnPIEBegin(bool bIsSimulating);
 	void OnPIEEnd(bool bIsSimulating);
 
@@ -92,6 +243,27 @@ public:
 	void SetHideEngineInternalNodes(bool bHide) { bHideEngineInternalNodes = bHide; }
 	bool GetHideEngineInternalNodes() const { return bHideEngineInternalNodes; }
 
+	// Sampling mode, applied by the next StartRecording
+	void SetSamplingSettings(const FProfilerSamplingSettings& Settings) { SamplingSettings = Settings; }
+	const FProfilerSamplingSettings& GetSamplingSettings() const { return SamplingSettings; }
+	float GetActiveSamplingRate() const { return ActiveSamplingRate; }
+
+	// Stream each recording to a .bpsession file in the session directory while it runs
+	void SetStreamSessionToDisk(bool bEnabled) { bStreamSessionToDisk = bEnabled; }
+	bool GetStreamSessionToDisk() const { return bStreamSessionToDisk; }
+
+	// Tracepoint profiling of one Blueprint; removing the tracepoints restores the user's own breakpoints
+	void SetupBlueprintTracepoints(UBlueprint* Blueprint);
+	void RemoveBlueprintTracepoints(UBlueprint* Blueprint);
+
+	/**
+	 * Any thread: the node hit by a tracepoint at a code offset of a Blueprint function.
+	 * Offsets baked into the tracepoint tables resolve with one array read; any other offset takes the imprecise
+	 * debug data search. OutNodeId is the node's dense ID, or InvalidId with OutNodeKey set to the node for the drain to intern.
+	 * Returns false when no node is found or the node is a hidden engine internal one.
+	 */
+	bool ResolveTracepointNode(const UObject* ActiveObject, UFunction* Function, int32 CodeOffset, uint32& OutNodeId, TWeakObjectPtr<UObject>& OutNodeKey) const;
+
 	// Destructor is public for TUniquePtr cleanup
 	~FRuntimeProfiler();
 
@@ -105,8 +277,12 @@ private:
 	FRecordingSession CurrentSession;
 	TArray<FRecordingSession> SessionHistory;
 	double RecordingStartTime;
+	uint64 RecordingStartCycles;  // Cycles64 at RecordingStartTime, converts node timings to timeline timestamps
 	double PauseStartTime;
 	double TotalPausedTime;
+	uint64 RecordingStartFrame;  // GFrameCounter at StartRecording; frames while paused are excluded from the session
+	uint64 PauseStartFrame;
+	uint64 TotalPausedFrames;
 
 	// PIE integration settings
 	bool bAutoStartOnPIE;
@@ -116,14 +292,24 @@ private:
 	// Filtering options
 	bool bHideEngineInternalNodes = true;  // Default to true for better UX
 
+	// Sampling settings for the next recording, and the active parameters read by the hot paths
+	FProfilerSamplingSettings SamplingSettings;
+	ESamplingMode ActiveSamplingMode = ESamplingMode::Full;
+	uint32 ActiveSampleInterval = 1;
+	uint64 SampleSliceCycles = 0;
+	uint64 SamplePeriodCycles = 1;
+	float ActiveSamplingRate = 1.0f;
+
 	// Blueprint instrumentation delegate handle
 	FDelegateHandle InstrumentationDelegateHandle;
 
 	// Script exception (breakpoint) delegate handle for tracing
 	FDelegateHandle ScriptExceptionDelegateHandle;
 
-	// Thread safety for data recording
-	mutable FCriticalSection DataMutex;
+	// Threading model: script threads only append events to their own lock-free ring buffer,
+	// NodeStats/ExecutionFrames are owned by the game thread and updated by DrainEventBuffers
+	FTSTicker::FDelegateHandle DrainTickerHandle;
+	uint64 TotalDroppedEvents = 0;
 
 	// Breakpoint system state management
 	// Maps: Blueprint -> Array of (Node -> Original Breakpoint State)
@@ -132,17 +318,79 @@ private:
 	{
 		TWeakObjectPtr<UBlueprint> Blueprint;
 		TMap<TWeakObjectPtr<UEdGraphNode>, bool> OriginalBreakpointStates;
+
+		// Functions of the generated class that have an offset lookup table, dropped on recompile
+		TArray<FObjectKey> LookupFunctions;
+		FDelegateHandle OnCompiledHandle;
 	};
 	TMap<TWeakObjectPtr<UBlueprint>, FOriginalBreakpointInfo> SavedBreakpointStates;
 
 	// Execution data
-	TMap<TWeakObjectPtr<UObject>, FNodeExecutionStats> NodeStats;
+	FNodeStatsTable NodeStats;
+
+	// Graph node -> dense ID, built by SetupBlueprintTracepoints so the trace path skips interning
+	TMap<const UEdGraphNode*, uint32> TracepointNodeIds;
+
+	// UFunction -> flat table indexed by code offset, so the trace path resolves a node without
+	// FindClassForNode/FindSourceNodeFromCodeLocation/IsNodeInStandardMacros.
+	// Entries hold a dense node ID, optionally tagged as engine internal, or UnmappedCodeOffset.
+	// Tables are never modified once built; a rebuild replaces the shared array. Keyed by FObjectKey so that a
+	// function allocated at the address of a garbage-collected one never resolves against the old table.
+	static constexpr uint32 UnmappedCodeOffset = MAX_uint32;
+	static constexpr uint32 EngineInternalNodeFlag = 1u << 31;
+	using FCodeOffsetTable = TSharedRef<const TArray<uint32>, ESPMode::ThreadSafe>;
+	TMap<FObjectKey, FCodeOffsetTable> FunctionNodeLookups;
+
+	// Immutable copy of both maps for the trace path, which runs on whatever thread executes script.
+	// The game thread edits the maps above and publishes a new copy; each script thread keeps the copy it last
+	// took and only takes the lock again when the published version has moved on.
+	struct FTraceNodeLookup
+	{
+		TMap<const UEdGraphNode*, uint32> TracepointNodeIds;
+		TMap<FObjectKey, FCodeOffsetTable> FunctionNodeLookups;
+	};
+	mutable FRWLock TraceNodeLookupLock;
+	TSharedPtr<const FTraceNodeLookup, ESPMode::ThreadSafe> PublishedTraceNodeLookup;
+	bool bTraceNodeLookupDirty = false;
 	TArray<FExecutionFrame> ExecutionFrames;
 	TArray<FTickAbuseInfo> TickAbuseData;
 	
 	// Loaded session data for display (persisted across PIE sessions)
 	TArray<FNodeExecutionData> LoadedSessionData;
 
+	// Session file written while recording: full frame pages are handed to the writer's background pipe,
+	// the summary is added on stop. ExecutionFrames only keeps a recent window in memory.
+	FProfilerSessionWriter LiveSessionWriter;
+	FString LiveSessionFilePath;
+	bool bStreamSessionToDisk = true;
+	TArray<FExecutionFrame> PendingFramePage;
+	int64 TotalFramesRecorded = 0;
+
+	// Pages of a finished or loaded session file, plus a few decoded pages for on-demand reads
+	TUniquePtr<FProfilerSessionReader> FramePageReader;
+	TArray<TPair<int32, TArray<FExecutionFrame>>> FramePageCache;
+
+	// Per-frame costs for the recent frames, and the hitches detected so far in this recording
+	FFrameCostStore FrameCosts;
+	TArray<int32> NodeBlueprintIndices;  // node ID -> FrameCosts Blueprint index, resolved on first completed frame
+	TArray<FBlueprintFrameBreakdown> Hitches;
+	float HitchBudgetMs = 5.0f;
+
+	// Live Blueprint memory snapshots of the current or loaded session
+	FBlueprintMemoryCapture MemoryCapture;
+	bool bCaptureBlueprintMemory = true;
+
+	// Live updates: two buffers alternate, and a buffer still held by a reader is replaced instead of overwritten.
+	// LatestLiveUpdate is swapped under LiveUpdateLock, so once a buffer is no longer the latest its reference count can only drop.
+	float LiveUpdateRate = 4.0f;
+	double LastLiveUpdateTime = 0.0;
+	uint64 LiveUpdateSerial = 0;
+	TSharedPtr<FRuntimeLiveUpdate, ESPMode::ThreadSafe> LiveUpdateBuffers[2];
+	int32 LiveUpdateBackBuffer = 0;
+	mutable FRWLock LiveUpdateLock;
+	TSharedPtr<const FRuntimeLiveUpdate, ESPMode::ThreadSafe> LatestLiveUpdate;
+	TArray<uint32> LiveChangedIds;
+
 	// Timer for periodic blueprint execution collection
 	FTimerHandle SamplingTimerHandle;
 
@@ -158,9 +406,33 @@ private:
 	void UpdateSessionStats();
 	FString GenerateDefaultSessionName() const;
 	FString GetSessionDataFilePath(const FString& SessionName = TEXT("")) const;
+	void AddLoadedSession(const FRecordingSession& LoadedSession);
+	bool LoadSessionJson(const FString& FilePath);
+	bool LoadSessionBinary(const FString& FilePath);
+	void GatherExecutionData(TArray<FNodeExecutionData>& OutData, TArray<uint32>* OutNodeIds) const;
+	bool FillExecutionData(uint32 NodeId, float RecordingDuration, FNodeExecutionData& OutData) const;
+	float GetRecordingDuration() const;
+	void PublishLiveUpdate();
+	void ResetLiveUpdates();
+	void FinishLiveSessionFile();
 	
 	// Data recording methods
-	void RecordNodeExecution(const FFrame& Frame);
+	void RecordNodeExecution(const FFrame& Frame, float ExecutionTime);
+	bool ShouldSampleEvent(uint64 NowCycles, uint32& SampleCountdown, uint32& SampleRandom) const;
+	void RecordNodeTiming(const TWeakObjectPtr<UObject>& NodeKey, uint32 NodeId, uint64 FrameNumber, uint64 StartCycles, uint64 InclusiveCycles, uint64 ExclusiveCycles);
+	void DrainEventBuffers();
+	void AddExecutionFrame(uint32 NodeId, uint64 FrameNumber, double Timestamp, float ExecutionTime);
+	void CompleteFrameCosts(uint64 BeforeFrameNumber);
+	int32 GetNodeBlueprintIndex(uint32 NodeId);
+	void BuildFrameBreakdown(const FFrameCostStore::FFrameRecord& Record, FBlueprintFrameBreakdown& OutBreakdown) const;
+	void ResetFrameCosts();
+	const TArray<FExecutionFrame>* FindFramePage(int64 FrameIndex, int64& OutPageStart);
+	void ResetFrameHistory();
+	void DiscardEventBuffers();
+	bool TickDrainEvents(float DeltaTime);
+	void ResetNodeStats();
+	void ResolvePendingNodeInfo();
+	bool ResolveNodeInfo(UObject* Object, FString& OutNodeName, FString& OutBlueprintName, FGuid& OutNodeGuid) const;
 	void CollectBlueprintExecutionData();
 	void CheckForTickAbuse(UObject* Object, const FNodeExecutionStats& Stats);
 	bool HasComplexTickLogic(AActor* Actor);
@@ -182,8 +454,16 @@ private:
 	bool IsExpensiveFunction(const FString& FunctionName) const;
 
 	// Breakpoint tracing methods
-	void SetupBlueprintTracepoints(UBlueprint* Blueprint);
-	void RemoveBlueprintTracepoints(UBlueprint* Blueprint);
+	void BuildFunctionNodeLookups(UBlueprint* Blueprint, FOriginalBreakpointInfo& SavedState);
+	void RemoveFunctionNodeLookups(FOriginalBreakpointInfo& SavedState);
+
+	// Game thread: copies the tracepoint maps for the trace path. Additions may wait for the next drain;
+	// removals and ID changes are published at once, before script can run on the stale entries.
+	void PublishTraceNodeLookup();
+
+	// Any thread: the calling thread's copy of the published lookup, valid until its next call; null before the first publish
+	const FTraceNodeLookup* GetTraceNodeLookup() const;
+	void OnTracedBlueprintCompiled(UBlueprint* Blueprint);
 	void SetupTracepointsForAllBlueprints();
 	void SetupTracepointsForAllBlueprintsAsync();  // Async version
 	void RemoveTracepointsFromAllBlueprints();
@@ -0,0 +1,106 @@
+// Copyright xnbmy 2026. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/ProfilerDataTypes.h"
+
+class FRuntimeProfiler;
+
+/**
+ * One recording as the comparison sees it: session info plus node stats
+ */
+struct BLUEPRINTPROFILER_API FSessionProfile
+{
+	FRecordingSession Session;
+	TArray<FNodeExecutionData> Nodes;
+	int32 NumFrames = 0;  // 引擎帧数；未知时为 0，比较退化为按时长归一化
+};
+
+/**
+ * How a node or Blueprint changed between the baseline and the current recording
+ */
+enum class ESessionCostChange : uint8
+{
+	Unchanged,
+	Regressed,
+	Improved,
+	Added,    // Only ran in the current recording
+	Removed   // Only ran in the baseline
+};
+
+/**
+ * Normalized cost of one node or Blueprint in both recordings
+ */
+struct BLUEPRINTPROFILER_API FSessionCostDiff
+{
+	FString NodeName;          // 节点名；蓝图条目为空
+	FString BlueprintName;
+	FGuid NodeGuid;
+
+	// Exclusive time per frame (ms per second when the frame count of either recording is unknown)
+	float BaselineMs = 0.0f;
+	float CurrentMs = 0.0f;
+	float DeltaMs = 0.0f;
+	float DeltaPercent = 0.0f;  // Relative to the baseline; 0 for added and removed entries
+
+	float BaselineExecutionsPerSecond = 0.0f;
+	float CurrentExecutionsPerSecond = 0.0f;
+	int32 BaselineExecutions = 0;
+	int32 CurrentExecutions = 0;
+
+	float NoisePercent = 0.0f;  // 采样误差估计，变化小于该值时不显著
+	ESessionCostChange Change = ESessionCostChange::Unchanged;
+	bool bSignificant = false;
+};
+
+/**
+ * Thresholds a change has to clear to count as a regression or an improvement
+ */
+struct BLUEPRINTPROFILER_API FSessionComparisonSettings
+{
+	float ThresholdPercent = 10.0f;   // Relative change of the normalized cost
+	float MinDeltaMs = 0.01f;         // Absolute change; smaller ones are noise however large in percent
+	int32 MinExecutions = 10;         // On both sides; fewer samples are never judged
+};
+
+/**
+ * Session diff - aligns two recordings by node identity and ranks the cost changes
+ *
+ * Nodes are matched by Blueprint name and node GUID, which stay the same across recordings of the same asset;
+ * nodes without a GUID fall back to their name. Exclusive time is normalized to milliseconds per engine frame, so
+ * recordings of different lengths compare directly, and executions to executions per second. A change is
+ * significant when it clears the relative and absolute thresholds and the sampling error of both recordings
+ * (sampled recordings carry confidence bounds on their counts; full traces have none).
+ */
+class BLUEPRINTPROFILER_API FSessionComparison
+{
+public:
+	/** Per-node and per-Blueprint diffs; significant regressions first, then by DeltaMs descending */
+	TArray<FSessionCostDiff> Nodes;
+	TArray<FSessionCostDiff> Blueprints;
+
+	FRecordingSession BaselineSession;
+	FRecordingSession CurrentSession;
+	FSessionComparisonSettings Settings;
+	bool bPerFrame = true;  // false: costs are ms per second of recording
+
+	static FSessionComparison Compare(const FSessionProfile& Baseline, const FSessionProfile& Current, const FSessionComparisonSettings& InSettings = FSessionComparisonSettings());
+
+	/** Reads a .bpsession file; files older than version 3 take their frame count from the frame records */
+	static bool LoadProfile(const FString& FilePath, FSessionProfile& OutProfile);
+
+	/** Last finished recording of the profiler */
+	static FSessionProfile GetLatestProfile(const FRuntimeProfiler& Profiler);
+
+	/**
+	 * Significant Blueprint regressions above MaxRegressionPercent.
+	 * @param TrackedBlueprints Blueprint names to check, all when empty
+	 */
+	TArray<const FSessionCostDiff*> FindBlueprintRegressions(TConstArrayView<FString> TrackedBlueprints, float MaxRegressionPercent) const;
+
+	/** Writes both sessions, the settings and every diff as JSON */
+	bool WriteReport(const FString& FilePath) const;
+
+	static const TCHAR* GetChangeName(ESessionCostChange Change);
+};
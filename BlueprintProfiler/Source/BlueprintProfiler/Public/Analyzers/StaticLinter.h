@@ -4,11 +4,19 @@
 
 #include "CoreMinimal.h"
 #include "Data/ProfilerDataTypes.h"
+#include "Analyzers/BlueprintLintSnapshot.h"
+#include "Analyzers/LintGraphIndex.h"
+#include "Analyzers/StaticLinterCache.h"
 #include "Engine/Blueprint.h"
 #include "AssetRegistry/AssetData.h"
-#include "Async/AsyncWork.h"
+#include "Containers/Ticker.h"
+#include "Containers/Queue.h"
+#include "Tasks/Pipe.h"
+#include "Tasks/Task.h"
+#include <atomic>
 
 DECLARE_MULTICAST_DELEGATE_OneParam(FOnScanComplete, const TArray<FLintIssue>& /* Issues */);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnIssuesBatch, TConstArrayView<FLintIssue> /* Issues */);
 DECLARE_MULTICAST_DELEGATE_TwoParams(FOnScanProgress, int32 /* ProcessedAssets */, int32 /* TotalAssets */);
 
 /**
@@ -20,7 +28,10 @@ struct BLUEPRINTPROFILER_API FScanConfiguration
 	TArray<FString> ExcludePaths;
 	TSet<ELintIssueType> EnabledChecks;
 	bool bUseMultiThreading = true;
-	int32 MaxConcurrentTasks = 4;
+	int32 MaxConcurrentTasks = 4;  // Worker threads used to analyze graph snapshots
+	bool bUseCache = true;         // Reuse results of unchanged packages from Saved/BlueprintProfiler/LintCache.bin
+	FString CacheFilePath;         // Overrides the cache location when set
+	int32 MemoryBudgetMB = 0;      // Used physical memory at which packages loaded by the scan are unloaded; <= 0 means half of physical memory
 
 	FScanConfiguration()
 	{
@@ -33,6 +44,32 @@ struct BLUEPRINTPROFILER_API FScanConfiguration
 	}
 };
 
+/**
+ * Worker time spent on one snapshot, per stage of AnalyzeSnapshot
+ */
+struct BLUEPRINTPROFILER_API FLintAnalysisTiming
+{
+	static constexpr int32 NumChecks = static_cast<int32>(ELintIssueType::UnusedFunction) + 1;
+
+	float GraphIndexSeconds = 0.0f;
+	float CheckSeconds[NumChecks] = {};     // Indexed by ELintIssueType
+
+	float GetTotalSeconds() const;
+	void Add(const FLintAnalysisTiming& Other);
+};
+
+/**
+ * Load and analysis time of one scanned asset
+ */
+struct BLUEPRINTPROFILER_API FLintAssetTiming
+{
+	FString BlueprintPath;
+	float LoadSeconds = 0.0f;       // Game thread, zero for assets taken from the cache
+	float AnalysisSeconds = 0.0f;   // Worker threads, all passes
+
+	float GetTotalSeconds() const { return LoadSeconds + AnalysisSeconds; }
+};
+
 /**
  * Scan progress information
  */
@@ -47,10 +84,36 @@ struct BLUEPRINTPROFILER_API FScanProgress
 	FDateTime StartTime;
 	bool bIsCompleted = false;
 	bool bWasCancelled = false;
+
+	// Timings: LoadSeconds grows while assets load, the analysis fields are filled when the scan ends
+	double LoadSeconds = 0.0;                // Loading and snapshotting on the game thread
+	double AnalysisSeconds = 0.0;            // Summed over worker threads
+	FLintAnalysisTiming AnalysisBreakdown;
+	TArray<FLintAssetTiming> SlowestAssets;  // Most expensive first, at most MaxSlowestAssets
+
+	static constexpr int32 MaxSlowestAssets = 10;
+};
+
+/**
+ * One blueprint handed from the game thread stage to FScanTask
+ */
+struct FLintScanItem
+{
+	TSharedPtr<const FBlueprintLintSnapshot> Snapshot;
+	FName PackageName;
+	FIoHash PackageHash;                   // Zero when the result must not be cached
+	bool bHasCachedLocalIssues = false;
+	TArray<FLintIssue> LocalIssues;        // Per-blueprint issues taken from the cache
+	float EstimatedCost = 0.0f;            // Seconds predicted by FStaticLinter::EstimateAssetCost; workers take expensive items first
+	float LoadSeconds = 0.0f;              // Measured load and snapshot time, stored in the cache
 };
 
 /**
  * Static Linter - scans blueprint assets for code quality issues
+ *
+ * A scan is a pipeline: the game thread loads each asset and copies its graphs into an FBlueprintLintSnapshot
+ * (time-sliced on the core ticker), and batches of snapshots are analyzed by FScanTask on worker threads
+ * while the next batch loads. Unchanged packages are taken from FStaticLinterCache instead of being loaded.
  */
 class BLUEPRINTPROFILER_API FStaticLinter
 {
@@ -66,49 +129,97 @@ public:
 	void CancelScan();
 	bool IsScanInProgress() const { return bScanInProgress; }
 
-	// Results access
-	TArray<FLintIssue> GetIssues() const { return Issues; }
+	// Results access; issues grow while a scan runs and are only touched on the game thread
+	const TArray<FLintIssue>& GetIssues() const { return Issues; }
 	TArray<FLintIssue> GetIssuesByType(ELintIssueType Type) const;
 	FScanProgress GetScanProgress() const { return CurrentProgress; }
 	void ClearIssues() { Issues.Empty(); }
 
 	// Events
 	FOnScanComplete OnScanComplete;
+
+	/**
+	 * Issues of one blueprint, on the game thread as soon as its passes are done; a blueprint reports its
+	 * per-blueprint issues first and its cross-blueprint issues in a second batch at the end of the scan.
+	 * The view points into GetIssues() and is only valid during the broadcast. Empty batches are not sent.
+	 */
+	FOnIssuesBatch OnIssuesBatch;
 	FOnScanProgress OnScanProgress;
 
 	// Internal methods for async task (Exposed for testing)
 	void UpdateScanProgress(int32 ProcessedAssets, int32 TotalAssets, const FString& CurrentAssetName = TEXT(""));
 
 	// Internal methods accessed by async task
-	void ProcessBlueprint(const FAssetData& AssetData, const FScanConfiguration& Config, TArray<FLintIssue>& OutIssues);
-	void CompleteScan(const TArray<FLintIssue>& AllIssues);
+	/**
+	 * Runs the enabled passes over one snapshot; safe on any thread.
+	 * Without a reference index only the per-blueprint passes run (orphan, cast, tick),
+	 * with one only the cross-blueprint passes (dead node, unused function).
+	 */
+	void AnalyzeSnapshot(const FBlueprintLintSnapshot& Snapshot, const FScanConfiguration& Config,
+		const FLintReferenceIndex* ReferenceIndex, TArray<FLintIssue>& OutIssues, FLintAnalysisTiming* OutTiming = nullptr) const;
+	void CompleteScan();
+
+	/** Game thread: moves the batches the scan task has finished into Issues and broadcasts OnIssuesBatch */
+	void DispatchIssueBatches();
 	bool IsCancelRequested() const { return bCancelRequested; }
-	FCriticalSection& GetIssuesLock() { return IssuesLock; }
+
+	/**
+	 * Predicted seconds to load and analyze an asset, used to schedule the largest blueprints first and for the ETA.
+	 * Timings measured by an earlier scan win; otherwise the node count tag and the package size are used.
+	 * @param MeasuredEntry       Cache entry of the package from any earlier scan, may be null
+	 * @param bPackageUnchanged   The entry matches the package on disk, so it will not be loaded
+	 */
+	static float EstimateAssetCost(const FAssetData& AssetData, const FStaticLinterCache::FEntry* MeasuredEntry, bool bPackageUnchanged);
+
+	/** The checks ask the reference index about callers, so every /Game blueprint has to contribute its call sites */
+	static bool NeedsProjectReferences(const TSet<ELintIssueType>& EnabledChecks);
+
+	/** MemoryBudgetMB in bytes, or half of the physical memory when it is 0 */
+	static uint64 GetMemoryBudgetBytes(const FScanConfiguration& Config);
+
+	/**
+	 * Whether the snapshot stage should unload the packages it loaded. Each release runs the garbage collector, so
+	 * besides being over budget at least 16 packages must have been loaded and 2 seconds passed since the last release.
+	 */
+	static bool ShouldReleaseLoadedPackages(int32 NumLoadedPackages, double SecondsSinceLastRelease, uint64 UsedBytes, uint64 BudgetBytes);
+
+	/** Packages the user is working with stay loaded: modified ones, worlds and assets open in an editor */
+	static bool CanUnloadScanPackage(UPackage* Package);
 
 private:
 	// Scanning methods
 	void StartAsyncScan(const TArray<FAssetData>& Assets, const FScanConfiguration& Config);
 
+	/** Game thread stage: loads and snapshots assets until the frame budget is used up */
+	bool TickSnapshotStage(float DeltaTime);
+	bool SnapshotNextAsset(TArray<FLintScanItem>& OutBatch);
+	void StopSnapshotStage();
+
+	/** Unloads the packages this scan loaded and collects garbage; snapshots hold no UObjects, so nothing has to stay loaded */
+	bool ShouldReleaseLoadedPackages() const;
+	void ReleaseLoadedPackages();
+
+	/** Stores the results of the finished scan and writes the cache file in the background */
+	void UpdateLintCache();
+
+	/** Fills the timing fields of CurrentProgress from the waited-for scan task and logs the cost summary */
+	void UpdateScanTimings();
+
 	// Detection methods
-	void DetectDeadNodes(UBlueprint* Blueprint, TArray<FLintIssue>& OutIssues);
-	void DetectOrphanNodes(UBlueprint* Blueprint, TArray<FLintIssue>& OutIssues);
-	void DetectCastAbuse(UBlueprint* Blueprint, TArray<FLintIssue>& OutIssues);
-	void DetectTickAbuse(UBlueprint* Blueprint, TArray<FLintIssue>& OutIssues);
-	void DetectUnusedFunctions(UBlueprint* Blueprint, TArray<FLintIssue>& OutIssues);
+	void DetectDeadNodes(const FBlueprintLintSnapshot& Snapshot, const FLintSnapshotIndex& GraphIndices, const FLintReferenceIndex& ReferenceIndex, TArray<FLintIssue>& OutIssues) const;
+	void DetectOrphanNodes(const FBlueprintLintSnapshot& Snapshot, const FLintSnapshotIndex& GraphIndices, TArray<FLintIssue>& OutIssues) const;
+	void DetectCastAbuse(const FBlueprintLintSnapshot& Snapshot, const FLintSnapshotIndex& GraphIndices, TArray<FLintIssue>& OutIssues) const;
+	void DetectTickAbuse(const FBlueprintLintSnapshot& Snapshot, const FLintSnapshotIndex& GraphIndices, TArray<FLintIssue>& OutIssues) const;
+	void DetectUnusedFunctions(const FBlueprintLintSnapshot& Snapshot, const FLintReferenceIndex& ReferenceIndex, TArray<FLintIssue>& OutIssues) const;
 
 	// Utility methods
 	TArray<FAssetData> GetBlueprintAssets(const TArray<FString>& Paths) const;
 	TArray<FAssetData> GetBlueprintAssetsInFolder(const FString& FolderPath, bool bRecursive = true) const;
 	bool ShouldProcessAsset(const FAssetData& AssetData, const FScanConfiguration& Config) const;
 	ESeverity CalculateIssueSeverity(ELintIssueType Type, int32 Count = 1) const;
-	void CountConnectedNodes(UEdGraphNode* StartNode, TSet<UEdGraphNode*>& VisitedNodes, int32& NodeCount);
-	TArray<UEdGraph*> GetAllGraphs(UBlueprint* Blueprint) const;
-	
-	// Context analysis helpers
-	bool IsNodeInTickContext(UEdGraphNode* Node, TSet<UEdGraphNode*>& VisitedNodes) const;
-	bool IsNodeInLoopContext(UEdGraphNode* Node, TSet<UEdGraphNode*>& VisitedNodes) const;
-	bool IsNodeInFrequentlyCalledFunction(UEdGraphNode* Node, UEdGraph* Graph) const;
-	bool IsHardReferenceCast(class UK2Node_DynamicCast* CastNode) const;
+
+	// Context analysis helpers; tick and loop context come from FLintGraphIndex
+	bool IsNodeInFrequentlyCalledFunction(const FLintGraphSnapshot& Graph) const;
 
 private:
 	TArray<FLintIssue> Issues;
@@ -116,39 +227,99 @@ private:
 	bool bScanInProgress;
 	bool bCancelRequested;
 
-	// Async task management
-	TSharedPtr<class FAsyncTask<class FScanTask>> CurrentScanTask;
-	bool bTaskComplete;  // Tracks if the async CompleteScan has been called
-	FCriticalSection IssuesLock;
+	// Game thread stage state
+	FTSTicker::FDelegateHandle SnapshotTickerHandle;
+	TArray<FAssetData> PendingAssets;        // Scanned assets followed by reference-only assets
+	int32 NumScannedAssets = 0;
+	int32 NextAssetIndex = 0;
+	TArray<float> PendingAssetCosts;         // Per scanned asset, PendingAssets is sorted by it (largest first)
+	TArray<FIoHash> PendingAssetHashes;      // Per scanned asset; reference-only assets are hashed when they are visited
+	double TotalEstimatedCost = 0.0;
+	double CompletedEstimatedCost = 0.0;
+	FScanConfiguration ActiveConfig;
+	FLintReferenceIndex ReferenceIndex;
+	TSet<TWeakObjectPtr<UPackage>> ScanLoadedPackages;   // Packages (with dependencies) that were not loaded before the scan
+	double LastReleaseTime = 0.0;            // FPlatformTime::Seconds() of the last ReleaseLoadedPackages
+	bool bReportedUnreachableBudget = false; // The budget warning is logged once per scan
+	bool bInlineAnalysis = false;            // Multi-threading off: each snapshot batch is analyzed on the game thread as it is added
+
+	// Incremental results, loaded on the first scan that uses them
+	FStaticLinterCache LintCache;
+	FString LintCacheFilePath;               // File LintCache was loaded from; empty until first used
+	int32 NumCacheHits = 0;
+	FStaticLinterCache::FHashContext PackageHashContext;   // Registry lookups of the current scan
+	UE::Tasks::FTask CacheSaveTask;
+
+	// Worker stage
+	TUniquePtr<class FScanTask> CurrentScanTask;
 
 	// Self-reference to keep object alive during async operations
 	TSharedPtr<FStaticLinter> SelfReference;
-
-	// Static members for cross-blueprint reference tracking
-	static TSet<FName> ReferencedFunctions;
-	static TMap<FName, int32> FunctionCallCount;
 };
 
 /**
- * Async task for blueprint scanning
+ * Worker stage of a scan
+ *
+ * Snapshot batches are queued on one pipe, so batches run in order and never overlap; each batch fans out
+ * to at most MaxConcurrentTasks workers with ParallelFor. Workers take items from a shared cursor over the
+ * batch sorted by estimated cost, so the most expensive blueprints start first and idle workers pick up the
+ * rest. The cross-blueprint passes need references from every blueprint and run in a last batch over all
+ * snapshots once the game thread calls Finish.
+ * The issues of every blueprint are moved to the game thread as soon as its batch is done.
  */
-class FScanTask : public FNonAbandonableTask
+class FScanTask
 {
 public:
-	FScanTask(TSharedPtr<FStaticLinter> InLinter, const TArray<FAssetData>& InAssets, const FScanConfiguration& InConfig);
+	/** bInInline runs every batch on the calling thread and leaves calling CompleteScan to the caller */
+	FScanTask(TSharedPtr<FStaticLinter> InLinter, const FScanConfiguration& InConfig, bool bInInline = false);
+	~FScanTask();
 
-	void DoWork();
+	/** Game thread: hands over freshly built snapshots and starts their per-blueprint passes */
+	void AddSnapshots(TArray<FLintScanItem>&& Batch);
 
-	FORCEINLINE TStatId GetStatId() const
-	{
-		RETURN_QUICK_DECLARE_CYCLE_STAT(FScanTask, STATGROUP_ThreadPoolAsyncTasks);
-	}
+	/** Game thread: no more snapshots; runs the cross-blueprint passes and then CompleteScan on the game thread */
+	void Finish(FLintReferenceIndex&& InReferenceIndex);
+
+	/** Game thread: takes the next finished per-blueprint issue batch; batches are moved out, not copied */
+	bool DequeueIssueBatch(TArray<FLintIssue>& OutIssues) { return ReadyIssueBatches.Dequeue(OutIssues); }
+
+	/** Adds cache entries for the analyzed blueprints whose per-blueprint issues were not cached already. Only valid after Wait */
+	void CollectCacheEntries(FStaticLinterCache& Cache) const;
+
+	/** Per-asset and per-stage timings of the batches analyzed so far. Only valid after Wait */
+	void GetTimings(TArray<FLintAssetTiming>& OutAssetTimings, FLintAnalysisTiming& OutTotals) const;
+
+	/** Stops queued batches early; issues found so far are kept */
+	void Cancel() { bCancelled = true; }
+
+	/** Blocks until all queued batches are done */
+	void Wait();
 
 	/** Check if scan has been cancelled */
 	bool IsCancelRequested() const;
 
 private:
+	void Run(const TCHAR* DebugName, TUniqueFunction<void()>&& Body);
+	void AnalyzeRange(const FStaticLinter& Linter, int32 FirstItem, int32 NumItems, const FLintReferenceIndex* Index, TArray<TArray<FLintIssue>>& OutIssues);
+
+	/** Queues the issues of each item in the range for the game thread; bPostDispatch wakes DispatchIssueBatches */
+	void PublishIssues(int32 FirstItem, int32 NumItems, TArray<TArray<FLintIssue>>& InOutIssues, bool bPostDispatch);
+
 	TWeakPtr<FStaticLinter> LinterWeak;
-	TArray<FAssetData> Assets;
 	FScanConfiguration Config;
+	bool bInline;
+	UE::Tasks::FPipe Pipe;
+	std::atomic<bool> bCancelled{false};
+	std::atomic<bool> bCompleted{false};
+
+	// Only touched by tasks on the pipe
+	TArray<FLintScanItem> Items;
+	TArray<TArray<FLintIssue>> LocalIssues;
+	TArray<TArray<FLintIssue>> CrossIssues;
+	TArray<FLintAnalysisTiming> Timings;
+	FLintReferenceIndex ReferenceIndex;
+	TArray<TPair<int32, TSharedRef<FStaticLinterCache::FEntry>>> PendingCacheEntries;  // Item index -> entry
+
+	// Filled on the pipe, drained on the game thread
+	TQueue<TArray<FLintIssue>, EQueueMode::Mpsc> ReadyIssueBatches;
 };
\ No newline at end of file
@@ -0,0 +1,71 @@
+// Copyright xnbmy 2026. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/ProfilerDataTypes.h"
+#include "Analyzers/BlueprintLintSnapshot.h"
+#include "IO/IoHash.h"
+
+struct FAssetData;
+
+/**
+ * Persistent per-asset lint results (Saved/BlueprintProfiler/LintCache.bin)
+ *
+ * An entry stays valid while the saved hashes of the package and of its hard dependencies match (snapshots hold facts
+ * taken from the parent class, interfaces and cast targets); the file as a whole is dropped when
+ * LinterVersion changes. Entries keep the asset's snapshot and call sites next to its per-blueprint issues, so a warm
+ * scan reuses those issues and re-runs only the cross-blueprint passes, without loading unchanged packages.
+ */
+class BLUEPRINTPROFILER_API FStaticLinterCache
+{
+public:
+	/** Bump whenever snapshot contents or a Detect* pass change so that results of older builds are discarded */
+	static constexpr uint32 LinterVersion = 6;
+
+	/** Registry lookups memoized over one scan; many blueprints share the same dependencies */
+	struct FHashContext
+	{
+		TMap<FName, FIoHash> SavedHashes;
+		TMap<FName, TArray<FName>> HardDependencies;
+	};
+
+	struct FEntry
+	{
+		FIoHash PackageHash;
+		uint32 ChecksMask = 0;              // Checks LocalIssues were produced with
+		bool bReferencesOnly = false;       // Only CallSites are stored, Snapshot is null
+		bool bFunctionUsageResolved = false;
+		float LoadSeconds = 0.0f;           // Measured time to load and snapshot the package; scan scheduling cost model
+		float AnalysisSeconds = 0.0f;       // Measured time of the local and cross-blueprint passes
+		TSharedPtr<const FBlueprintLintSnapshot> Snapshot;
+		FLintCallSites CallSites;
+		TArray<FLintIssue> LocalIssues;
+	};
+
+	static FString GetDefaultFilePath();
+	static uint32 GetChecksMask(const TSet<ELintIssueType>& EnabledChecks);
+
+	/**
+	 * Saved hash of the package on disk combined with those of its transitive hard dependencies (script packages excluded).
+	 * Zero when the package is unknown or it or a dependency is modified in memory, which makes the asset uncacheable.
+	 */
+	static FIoHash GetPackageHash(const FAssetData& AssetData, FHashContext* Context = nullptr);
+
+	bool Load(const FString& FilePath);
+	bool Save(const FString& FilePath) const;
+
+	/** Entry for the package if its hash matches and its snapshot has at least the requested detail */
+	TSharedPtr<const FEntry> Find(FName PackageName, const FIoHash& PackageHash, bool bNeedFullSnapshot, bool bNeedFunctionUsage) const;
+	void Add(FName PackageName, TSharedRef<const FEntry> Entry);
+
+	/** Entry for the package whatever its hash; only for the timings of an earlier scan */
+	TSharedPtr<const FEntry> FindAny(FName PackageName) const;
+
+	void Empty() { Entries.Empty(); }
+	int32 Num() const { return Entries.Num(); }
+
+private:
+	// 条目创建后不再修改，保存时只需复制指针
+	TMap<FName, TSharedRef<const FEntry>> Entries;
+};
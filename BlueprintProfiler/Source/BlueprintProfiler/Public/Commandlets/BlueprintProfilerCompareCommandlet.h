@@ -0,0 +1,32 @@
+// Copyright xnbmy 2026. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "BlueprintProfilerCompareCommandlet.generated.h"
+
+/**
+ * Headless regression check between two recorded sessions for CI
+ *
+ * UnrealEditor-Cmd.exe Project.uproject -run=BlueprintProfilerCompare
+ *     -baseline=<file>          Baseline .bpsession
+ *     -current=<file>           Session to check against it
+ *     -blueprints=BP_A+BP_B     Tracked Blueprints (default all)
+ *     -maxregression=Percent    Fail when a tracked Blueprint's cost per frame grows by more (default 10)
+ *     -mindelta=Ms              Changes below this many ms per frame are noise (default 0.01)
+ *     -minexecutions=N          Nodes need this many executions in both sessions to be judged (default 10)
+ *     -output=<file>            JSON report (default Saved/BlueprintProfiler/SessionComparison.json)
+ *
+ * Returns 0 when no tracked Blueprint regresses, 1 when one does, 2 on invalid arguments or I/O errors.
+ */
+UCLASS()
+class UBlueprintProfilerCompareCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UBlueprintProfilerCompareCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
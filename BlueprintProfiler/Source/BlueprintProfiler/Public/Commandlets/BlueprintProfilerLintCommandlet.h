@@ -0,0 +1,33 @@
+// Copyright xnbmy 2026. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "BlueprintProfilerLintCommandlet.generated.h"
+
+/**
+ * Headless static lint / memory scan for CI
+ *
+ * UnrealEditor-Cmd.exe Project.uproject -run=BlueprintProfilerLint
+ *     -paths=/Game/A+/Game/B    Content folders to scan (default /Game)
+ *     -checks=DeadNode,CastAbuse  ELintIssueType names (default all)
+ *     -jobs=N                   Analysis worker threads; 1 runs single-threaded
+ *     -cache=<file>|0           Lint cache file, or 0 to disable the cache
+ *     -output=<file>            Report file (default Saved/BlueprintProfiler/LintReport.sarif)
+ *     -format=sarif|json|junit  Report format (default from the -output extension)
+ *     -memory [-memorythreshold=MB]  Also report large resource references
+ *     -failon=Severity          Return 1 when an issue of at least this severity is found (default High)
+ *
+ * Returns 0 when nothing reaches -failon, 1 when something does, 2 on invalid arguments or I/O errors.
+ */
+UCLASS()
+class UBlueprintProfilerLintCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UBlueprintProfilerLintCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
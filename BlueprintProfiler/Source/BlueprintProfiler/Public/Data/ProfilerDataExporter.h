@@ -0,0 +1,121 @@
+// Copyright xnbmy 2026. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/StaticArray.h"
+#include "Containers/Ticker.h"
+#include "Data/ProfilerDataTypes.h"
+#include "Tasks/Task.h"
+#include <atomic>
+
+/**
+ * Export file format
+ */
+enum class EProfilerExportFormat : uint8
+{
+	Csv,
+	Json
+};
+
+/**
+ * One exported dashboard row; plain copies, so the snapshot holds nothing shared with the list
+ */
+struct FProfilerExportRow
+{
+	EProfilerDataType Type = EProfilerDataType::Runtime;
+	ESeverity Severity = ESeverity::Low;
+	float Value = 0.0f;
+	FString Name;
+	FString BlueprintName;
+	FString Category;
+};
+
+/**
+ * Immutable copy of the rows to export, taken on the game thread
+ */
+struct FProfilerExportSnapshot
+{
+	TArray<FProfilerExportRow> Rows;
+
+	// 本地化的类型和严重性文本，按枚举值索引，在游戏线程上解析
+	TStaticArray<FString, 3> TypeNames;
+	TStaticArray<FString, 4> SeverityNames;
+
+	FString ExportDate;
+};
+
+/**
+ * Background exporter for the dashboard rows
+ *
+ * Rows are formatted in chunks on a background task and streamed to the file through an FArchive writer, so neither
+ * the whole file nor a JSON DOM is ever held in memory. With compression each chunk is written as a gzip member;
+ * concatenated members are a valid gzip stream. The file is written next to the target as .tmp and only moved in
+ * place once complete, so a cancelled or failed export leaves no partial file behind. Start, Cancel and the
+ * delegates are game thread only; the delegates fire from the core ticker.
+ */
+class BLUEPRINTPROFILER_API FProfilerDataExporter
+{
+public:
+	FProfilerDataExporter() = default;
+	~FProfilerDataExporter();
+
+	FProfilerDataExporter(const FProfilerDataExporter&) = delete;
+	FProfilerDataExporter& operator=(const FProfilerDataExporter&) = delete;
+
+	/** Rows formatted per chunk; also how often progress and cancellation are checked */
+	static constexpr int32 RowsPerChunk = 4096;
+
+	/**
+	 * Starts exporting the snapshot to FilePath. Fails if an export is already running.
+	 * @param bCompress write gzip, regardless of the file extension
+	 */
+	bool Start(const FString& FilePath, EProfilerExportFormat Format, bool bCompress, TSharedRef<const FProfilerExportSnapshot, ESPMode::ThreadSafe> Snapshot);
+
+	/** Stops after the chunk being written; OnComplete reports the export as cancelled */
+	void Cancel();
+
+	/** Cancels and blocks until the background task has finished, without firing OnComplete */
+	void CancelAndWait();
+
+	bool IsExporting() const { return Task.IsValid(); }
+	int32 GetNumRowsWritten() const { return NumRowsWritten.load(std::memory_order_relaxed); }
+	float GetProgress() const;
+
+	DECLARE_MULTICAST_DELEGATE_OneParam(FOnExportProgress, float /* Progress */);
+	FOnExportProgress OnProgress;
+
+	DECLARE_MULTICAST_DELEGATE_FourParams(FOnExportComplete, bool /* bSuccess */, bool /* bCancelled */, int32 /* NumRows */, const FString& /* FilePath */);
+	FOnExportComplete OnComplete;
+
+	/**
+	 * Writes the snapshot to an archive, the same way the background task does.
+	 * @param bCancel checked before every chunk, may be nullptr
+	 * @param OutNumRowsWritten updated after every chunk, may be nullptr
+	 * @return false if cancelled or the archive reported an error
+	 */
+	static bool WriteRows(FArchive& Ar, const FProfilerExportSnapshot& Snapshot, EProfilerExportFormat Format, bool bCompress,
+		const std::atomic<bool>* bCancel = nullptr, std::atomic<int32>* OutNumRowsWritten = nullptr);
+
+	/** Writes to a temporary file that replaces FilePath on success */
+	static bool WriteFile(const FString& FilePath, const FProfilerExportSnapshot& Snapshot, EProfilerExportFormat Format, bool bCompress,
+		const std::atomic<bool>* bCancel = nullptr, std::atomic<int32>* OutNumRowsWritten = nullptr);
+
+	/** Whether the path asks for compressed output (.gz) */
+	static bool IsCompressedPath(const FString& FilePath);
+
+private:
+	bool TickTask(float DeltaTime);
+
+	UE::Tasks::FTask Task;
+	FTSTicker::FDelegateHandle TickerHandle;
+
+	// 由后台任务写入，游戏线程在定时器中读取
+	std::atomic<bool> bCancelRequested = false;
+	std::atomic<int32> NumRowsWritten = 0;
+	std::atomic<bool> bTaskSucceeded = false;
+
+	FString TaskFilePath;
+	int32 TaskNumRows = 0;
+	int32 LastReportedRows = -1;
+};
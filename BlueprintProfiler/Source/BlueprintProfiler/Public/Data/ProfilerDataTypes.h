@@ -42,6 +42,268 @@ enum class ELintIssueType : uint8
 	UnusedFunction = 4    // 未引用的函数
 };
 
+/**
+ * Execution frame data for timeline analysis
+ */
+struct BLUEPRINTPROFILER_API FExecutionFrame
+{
+	double Timestamp;
+	TWeakObjectPtr<UObject> ObjectPtr;
+	float ExecutionTime;
+	uint32 NodeId;  // 录制时的稠密节点 ID，会话文件中帧通过它引用节点统计
+	uint64 FrameNumber;  // 节点开始执行时的 GFrameCounter
+	
+	FExecutionFrame()
+		: Timestamp(0.0)
+		, ExecutionTime(0.0f)
+		, NodeId(MAX_uint32)
+		, FrameNumber(0)
+	{
+	}
+};
+
+/**
+ * One Blueprint's or node's share of an engine frame's Blueprint time
+ */
+struct BLUEPRINTPROFILER_API FFrameCostContributor
+{
+	FString Name;            // 节点名；蓝图条目为空
+	FString BlueprintName;
+	TWeakObjectPtr<UObject> Object;
+	float TimeMs = 0.0f;     // 独占时间，各条目之和即该帧的蓝图总时间
+};
+
+/**
+ * Blueprint cost of one engine frame with its top contributors, also the payload of hitch events
+ */
+struct BLUEPRINTPROFILER_API FBlueprintFrameBreakdown
+{
+	uint64 FrameNumber = 0;
+	double Timestamp = 0.0;       // 该帧第一个节点的时间线时间
+	float BlueprintTimeMs = 0.0f;
+	float BudgetMs = 0.0f;
+	TArray<FFrameCostContributor> TopBlueprints;
+	TArray<FFrameCostContributor> TopNodes;
+};
+
+/**
+ * Live instances of one Blueprint class in a runtime memory snapshot
+ */
+struct BLUEPRINTPROFILER_API FBlueprintClassMemory
+{
+	FString BlueprintName;     // 与节点统计中的蓝图名一致，用于关联 CPU 时间
+	FString ClassPath;
+	int32 InstanceCount = 0;
+	int64 InstanceBytes = 0;   // 实例及其非蓝图子对象的独占资源大小之和
+};
+
+/**
+ * One completed pass over the live Blueprint instances of the play worlds
+ */
+struct BLUEPRINTPROFILER_API FBlueprintMemorySnapshot
+{
+	double Timestamp = 0.0;      // 扫描完成时的时间线时间，与执行帧相同
+	uint64 FirstFrameNumber = 0; // 扫描跨越的 GFrameCounter 范围
+	uint64 LastFrameNumber = 0;
+	float CaptureTimeMs = 0.0f;  // 各帧时间片耗时之和
+	TArray<FBlueprintClassMemory> Classes;  // 按 InstanceBytes 降序
+
+	int64 GetTotalBytes() const
+	{
+		int64 TotalBytes = 0;
+		for (const FBlueprintClassMemory& Class : Classes)
+		{
+			TotalBytes += Class.InstanceBytes;
+		}
+		return TotalBytes;
+	}
+};
+
+/**
+ * Memory of one Blueprint over a recording, next to its CPU cost
+ */
+struct BLUEPRINTPROFILER_API FBlueprintMemoryTrend
+{
+	FString BlueprintName;
+	int32 LatestInstanceCount = 0;
+	int32 PeakInstanceCount = 0;
+	int64 FirstBytes = 0;          // 首次出现时的字节数
+	int64 LatestBytes = 0;         // 最后一个快照中的字节数，之后不再出现则为 0
+	int64 PeakBytes = 0;
+	int32 NumSnapshots = 0;        // 出现过的快照数
+	float TotalExclusiveTime = 0.0f;  // 该蓝图所有节点的独占 CPU 时间（秒）
+
+	int64 GetGrowthBytes() const { return LatestBytes - FirstBytes; }
+};
+
+/**
+ * Runtime recording mode - trace every event or a statistical subset of them
+ */
+UENUM(BlueprintType)
+enum class ESamplingMode : uint8
+{
+	Full = 0,         // 记录每个事件
+	EveryNth = 1,     // 平均每 N 个事件记录一个
+	TimeSliced = 2    // 每个周期只在开头的时间片内记录
+};
+
+/**
+ * Sampling settings applied when a recording starts
+ */
+USTRUCT(BlueprintType)
+struct BLUEPRINTPROFILER_API FProfilerSamplingSettings
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadWrite, Category = "Sampling")
+	ESamplingMode Mode = ESamplingMode::Full;
+
+	// EveryNth：平均每多少个事件记录一个
+	UPROPERTY(BlueprintReadWrite, Category = "Sampling")
+	int32 SampleInterval = 10;
+
+	// TimeSliced：每 SlicePeriodMs 毫秒中记录前 SliceDurationMs 毫秒
+	UPROPERTY(BlueprintReadWrite, Category = "Sampling")
+	float SliceDurationMs = 2.0f;
+
+	UPROPERTY(BlueprintReadWrite, Category = "Sampling")
+	float SlicePeriodMs = 20.0f;
+
+	/** Expected fraction of events that get recorded, used to extrapolate counts */
+	float GetSamplingRate() const
+	{
+		switch (Mode)
+		{
+			case ESamplingMode::EveryNth:
+				return 1.0f / FMath::Max(SampleInterval, 1);
+
+			case ESamplingMode::TimeSliced:
+				return SlicePeriodMs > 0.0f ? FMath::Clamp(SliceDurationMs / SlicePeriodMs, 0.001f, 1.0f) : 1.0f;
+
+			default:
+				return 1.0f;
+		}
+	}
+};
+
+/**
+ * Fixed-capacity ring of the most recent execution times - constant memory, O(1) insert
+ */
+struct BLUEPRINTPROFILER_API FExecutionSampleRing
+{
+	static constexpr int32 Capacity = 128;
+
+	void Add(float Sample)
+	{
+		Samples[WriteIndex] = Sample;
+		WriteIndex = (WriteIndex + 1) % Capacity;
+		Count = FMath::Min(Count + 1, Capacity);
+	}
+
+	int32 Num() const { return Count; }
+
+	// Index 0 is the oldest sample still held
+	float operator[](int32 Index) const
+	{
+		check(Index >= 0 && Index < Count);
+		const int32 OldestIndex = Count < Capacity ? 0 : WriteIndex;
+		return Samples[(OldestIndex + Index) % Capacity];
+	}
+
+	void Reset()
+	{
+		WriteIndex = 0;
+		Count = 0;
+	}
+
+private:
+	float Samples[Capacity] = {};
+	int32 WriteIndex = 0;
+	int32 Count = 0;
+};
+
+/**
+ * Log-bucketed latency histogram (HDR-style) - constant memory per node, percentiles within ~12.5% relative error
+ * Values are nanoseconds: 0-15ns are exact, above that each power of two is split into 8 linear sub-buckets
+ */
+struct BLUEPRINTPROFILER_API FExecutionTimeHistogram
+{
+	static constexpr int32 SubBucketBits = 3;
+	static constexpr int32 SubBucketCount = 1 << SubBucketBits;
+	static constexpr int32 MaxValueBits = 41; // 2^41 ns ~ 36 分钟，超出部分归入最后一个桶
+	static constexpr int32 BucketCount = (MaxValueBits - SubBucketBits + 1) * SubBucketCount;
+
+	void AddSeconds(float Seconds)
+	{
+		AddNanoseconds(Seconds > 0.0f ? static_cast<uint64>(static_cast<double>(Seconds) * 1.0e9) : 0);
+	}
+
+	void AddNanoseconds(uint64 Nanoseconds)
+	{
+		Counts[GetBucketIndex(Nanoseconds)]++;
+		TotalCount++;
+	}
+
+	uint64 GetTotalCount() const { return TotalCount; }
+
+	// Percentile in [0, 100], returned in seconds (upper bound of the bucket holding the rank)
+	float GetPercentile(float Percentile) const
+	{
+		if (TotalCount == 0)
+		{
+			return 0.0f;
+		}
+
+		const uint64 TargetRank = FMath::Max<uint64>(1, static_cast<uint64>(FMath::CeilToDouble(FMath::Clamp(Percentile, 0.0f, 100.0f) / 100.0 * TotalCount)));
+		uint64 CumulativeCount = 0;
+		for (int32 BucketIndex = 0; BucketIndex < BucketCount; ++BucketIndex)
+		{
+			CumulativeCount += Counts[BucketIndex];
+			if (CumulativeCount >= TargetRank)
+			{
+				return static_cast<float>(GetBucketUpperBound(BucketIndex) * 1.0e-9);
+			}
+		}
+		return static_cast<float>(GetBucketUpperBound(BucketCount - 1) * 1.0e-9);
+	}
+
+	void Reset()
+	{
+		FMemory::Memzero(Counts, sizeof(Counts));
+		TotalCount = 0;
+	}
+
+	static int32 GetBucketIndex(uint64 Value)
+	{
+		if (Value < 2 * SubBucketCount)
+		{
+			return static_cast<int32>(Value);
+		}
+
+		const uint64 MaxValue = (uint64(1) << MaxValueBits) - 1;
+		Value = FMath::Min(Value, MaxValue);
+
+		const int32 Shift = static_cast<int32>(FPlatformMath::FloorLog2_64(Value)) - SubBucketBits;
+		return (Shift + 1) * SubBucketCount + static_cast<int32>((Value >> Shift) - SubBucketCount);
+	}
+
+	static uint64 GetBucketUpperBound(int32 BucketIndex)
+	{
+		if (BucketIndex < 2 * SubBucketCount)
+		{
+			return static_cast<uint64>(BucketIndex);
+		}
+
+		const int32 Shift = BucketIndex / SubBucketCount - 1;
+		const uint64 Mantissa = static_cast<uint64>(BucketIndex % SubBucketCount + SubBucketCount);
+		return ((Mantissa + 1) << Shift) - 1;
+	}
+
+private:
+	uint32 Counts[BucketCount] = {};
+	uint64 TotalCount = 0;
+};
+
 /**
  * Node execution statistics for runtime profiling
  */
@@ -62,16 +324,52 @@ struct BLUEPRINTPROFILER_API FNodeExecutionStats
 	UPROPERTY(BlueprintReadOnly, Category = "Execution Stats")
 	float MaxExecutionTime = 0.0f;
 
-	TArray<float> ExecutionTimes;
+	// 最近的执行耗时样本与全量耗时分布（固定内存）
+	FExecutionSampleRing ExecutionTimes;
+	FExecutionTimeHistogram ExecutionTimeHistogram;
+
+	// 实测耗时（FPlatformTime::Cycles64，由 NodeEntry/NodeExit 配对得到）
+	// Inclusive 包含子节点/被调用函数的时间，Exclusive 只计节点自身
+	uint64 InclusiveCycles = 0;
+	uint64 ExclusiveCycles = 0;
+
+	// 完成计时配对的次数（进入但未配对退出的执行不计入平均值）
+	int32 TimedExecutionCount = 0;
 
 	// 持久化节点信息（PIE结束后对象失效时仍能显示）
 	FString CachedNodeName;
 	FString CachedBlueprintName;
 	FGuid CachedNodeGuid;
 
+	// 记录一次实测耗时（秒）
+	void AddExecutionTime(float ExecutionTime)
+	{
+		TotalExecutionTime += ExecutionTime;
+		MinExecutionTime = FMath::Min(MinExecutionTime, ExecutionTime);
+		MaxExecutionTime = FMath::Max(MaxExecutionTime, ExecutionTime);
+		ExecutionTimes.Add(ExecutionTime);
+		ExecutionTimeHistogram.AddSeconds(ExecutionTime);
+	}
+
+	float GetPercentileExecutionTime(float Percentile) const
+	{
+		return ExecutionTimeHistogram.GetPercentile(Percentile);
+	}
+
 	float GetAverageExecutionTime() const
 	{
-		return ExecutionCount > 0 ? TotalExecutionTime / ExecutionCount : 0.0f;
+		const int32 SampleCount = TimedExecutionCount > 0 ? TimedExecutionCount : ExecutionCount;
+		return SampleCount > 0 ? TotalExecutionTime / SampleCount : 0.0f;
+	}
+
+	float GetTotalExclusiveTime() const
+	{
+		return static_cast<float>(FPlatformTime::ToSeconds64(ExclusiveCycles));
+	}
+
+	float GetAverageExclusiveTime() const
+	{
+		return TimedExecutionCount > 0 ? GetTotalExclusiveTime() / TimedExecutionCount : 0.0f;
 	}
 
 	float GetExecutionsPerSecond(float RecordingDuration) const
@@ -111,6 +409,74 @@ struct BLUEPRINTPROFILER_API FNodeExecutionData
 
 	UPROPERTY(BlueprintReadOnly, Category = "Node Data")
 	float AverageExecutionTime = 0.0f;
+
+	// 节点自身耗时（不含子节点），单位秒
+	UPROPERTY(BlueprintReadOnly, Category = "Node Data")
+	float TotalExclusiveTime = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Node Data")
+	float AverageExclusiveTime = 0.0f;
+
+	// 耗时分位数（秒），来自每节点的对数分桶直方图
+	UPROPERTY(BlueprintReadOnly, Category = "Node Data")
+	float P50ExecutionTime = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Node Data")
+	float P95ExecutionTime = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Node Data")
+	float P99ExecutionTime = 0.0f;
+
+	// 采样录制：SampledExecutions 为实际记录次数，TotalExecutions 及总耗时为外推值
+	UPROPERTY(BlueprintReadOnly, Category = "Node Data")
+	float SamplingRate = 1.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Node Data")
+	int32 SampledExecutions = 0;
+
+	// 外推执行次数的 95% 置信区间
+	UPROPERTY(BlueprintReadOnly, Category = "Node Data")
+	int32 ExecutionsLowerBound = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Node Data")
+	int32 ExecutionsUpperBound = 0;
+
+	/**
+	 * Treats TotalExecutions as the sampled count and extrapolates counts and totals by 1 / InSamplingRate.
+	 * Each event is assumed to be recorded with probability p, so the bounds use the binomial sigma sqrt(n(1-p)) / p.
+	 */
+	void ApplySamplingRate(float InSamplingRate)
+	{
+		SamplingRate = FMath::Clamp(InSamplingRate, UE_KINDA_SMALL_NUMBER, 1.0f);
+		SampledExecutions = TotalExecutions;
+
+		const double Scale = 1.0 / SamplingRate;
+		const double Estimate = SampledExecutions * Scale;
+		const double Margin = 1.96 * FMath::Sqrt(SampledExecutions * (1.0 - SamplingRate)) * Scale;
+
+		TotalExecutions = FMath::RoundToInt32(FMath::Min(Estimate, (double)MAX_int32));
+		ExecutionsLowerBound = FMath::Max(SampledExecutions, FMath::RoundToInt32(FMath::Min(Estimate - Margin, (double)MAX_int32)));
+		ExecutionsUpperBound = FMath::RoundToInt32(FMath::Min(Estimate + Margin, (double)MAX_int32));
+
+		// 平均耗时与分位数来自被采样的执行，本身无偏，只外推总量
+		TotalExecutionTime *= Scale;
+		TotalExclusiveTime *= Scale;
+		AverageExecutionsPerSecond *= Scale;
+	}
+};
+
+/**
+ * Live recording update - stats of the nodes that ran since the previous update
+ * Published by the runtime profiler while recording and never modified afterwards, so it can be kept or read on
+ * another thread. Nodes that did not run are left out, so their executions per second stay at the last published value.
+ */
+struct BLUEPRINTPROFILER_API FRuntimeLiveUpdate
+{
+	uint64 Serial = 0;              // 1 for the first update of a recording, then consecutive
+	double Timestamp = 0.0;
+	float RecordingDuration = 0.0f;
+	int32 NumRecordedNodes = 0;
+	TArray<FNodeExecutionData> ChangedNodes;
 };
 
 /**
@@ -237,7 +603,7 @@ struct BLUEPRINTPROFILER_API FReferenceChain
 	TArray<TWeakObjectPtr<UObject>> Chain;
 
 	UPROPERTY(BlueprintReadOnly, Category = "Reference Chain")
-	float TotalSize = 0.0f;
+	float TotalSize = 0.0f;               // 链上对象大小之和(MB)
 
 	UPROPERTY(BlueprintReadOnly, Category = "Reference Chain")
 	FString Description;
@@ -252,7 +618,16 @@ struct BLUEPRINTPROFILER_API FMemoryAnalysisResult
 	GENERATED_BODY()
 
 	UPROPERTY(BlueprintReadOnly, Category = "Memory Analysis")
-	float InclusiveSize = 0.0f;           // 包含大小(MB)
+	float InclusiveSize = 0.0f;           // 包含大小(MB)：硬引用闭包的总大小 = 保留 + 共享
+
+	UPROPERTY(BlueprintReadOnly, Category = "Memory Analysis")
+	float ExclusiveSize = 0.0f;           // 独占大小(MB)：蓝图包自身
+
+	UPROPERTY(BlueprintReadOnly, Category = "Memory Analysis")
+	float RetainedSize = 0.0f;            // 保留大小(MB)：蓝图移除后会一起卸载的部分（支配树子树）
+
+	UPROPERTY(BlueprintReadOnly, Category = "Memory Analysis")
+	float SharedSize = 0.0f;              // 共享大小(MB)：同时被其他包硬引用的依赖
 
 	UPROPERTY(BlueprintReadOnly, Category = "Memory Analysis")
 	int32 ReferenceDepth = 0;             // 引用深度
@@ -260,10 +635,46 @@ struct BLUEPRINTPROFILER_API FMemoryAnalysisResult
 	UPROPERTY(BlueprintReadOnly, Category = "Memory Analysis")
 	int32 TotalReferences = 0;            // 总引用数
 
+	UPROPERTY(BlueprintReadOnly, Category = "Memory Analysis")
+	bool bPackageSizesPending = false;    // 支配树尚在后台构建：大小暂为引用链上对象的累加，构建完成后更新并再次广播
+
 	TArray<FReferenceChain> ReferenceChains;
 	TArray<FLargeResourceReference> LargeReferences;
 };
 
+/**
+ * One row of the project-wide memory audit, ranked by retained size
+ */
+USTRUCT(BlueprintType)
+struct BLUEPRINTPROFILER_API FBlueprintMemoryAuditEntry
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Memory Audit")
+	FString BlueprintPath;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Memory Audit")
+	FString BlueprintName;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Memory Audit")
+	float ExclusiveSize = 0.0f;           // MB
+
+	UPROPERTY(BlueprintReadOnly, Category = "Memory Audit")
+	float RetainedSize = 0.0f;            // MB
+
+	UPROPERTY(BlueprintReadOnly, Category = "Memory Audit")
+	float SharedSize = 0.0f;              // MB
+
+	UPROPERTY(BlueprintReadOnly, Category = "Memory Audit")
+	int32 NumDirectHardReferences = 0;    // 直接硬引用的包数
+
+	UPROPERTY(BlueprintReadOnly, Category = "Memory Audit")
+	int32 NumHardDependencies = 0;        // 传递硬引用闭包中的包数
+
+	/** Large assets in the hard-reference closure, largest first; ReferencePath is the package chain from the blueprint */
+	TArray<FLargeResourceReference> LargeReferences;
+};
+
 /**
  * Recording session information for runtime profiler
  */
@@ -284,6 +695,9 @@ struct BLUEPRINTPROFILER_API FRecordingSession
 	UPROPERTY(BlueprintReadOnly, Category = "Recording Session")
 	float Duration = 0.0f; // In seconds
 
+	UPROPERTY(BlueprintReadOnly, Category = "Recording Session")
+	int32 TotalFrames = 0; // Engine frames spent recording, pauses excluded; 0 if unknown (older files)
+
 	UPROPERTY(BlueprintReadOnly, Category = "Recording Session")
 	int32 TotalNodesRecorded = 0;
 
@@ -296,6 +710,12 @@ struct BLUEPRINTPROFILER_API FRecordingSession
 	UPROPERTY(BlueprintReadOnly, Category = "Recording Session")
 	bool bAutoStarted = false; // Whether this session was auto-started by PIE
 
+	UPROPERTY(BlueprintReadOnly, Category = "Recording Session")
+	ESamplingMode SamplingMode = ESamplingMode::Full;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Recording Session")
+	float SamplingRate = 1.0f; // Fraction of events recorded, 1 for full tracing
+
 	FRecordingSession()
 	{
 		StartTime = FDateTime::Now();
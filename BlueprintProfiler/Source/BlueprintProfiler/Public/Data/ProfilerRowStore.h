@@ -0,0 +1,166 @@
+// Copyright xnbmy 2026. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/ProfilerDataTypes.h"
+#include "Hash/xxhash.h"
+
+/**
+ * Dashboard list filter, resolved once from the filter combo selection
+ */
+enum class EProfilerRowFilter : uint8
+{
+	All,
+	Runtime,
+	Lint,
+	Memory,
+	Critical,
+	High,
+	Medium,
+	Low,
+	Hotspots,
+	DeadCode,
+	Performance
+};
+
+/**
+ * Dashboard list sort order
+ */
+enum class EProfilerRowSort : uint8
+{
+	Name,
+	Blueprint,
+	Type,
+	Category,
+	Severity,
+	Value,
+	Execution,
+	Memory
+};
+
+/**
+ * Row store behind the dashboard list
+ *
+ * Every row has a stable ID, looked up by a 64-bit key derived from what identifies it (node, issue, asset). Filter and
+ * sort columns, lower-case sort keys and the search text are cached per row when it is added, so filtering and
+ * sorting never touch the display strings. Analyzers push their rows as a diff: a row whose content hash is
+ * unchanged keeps its item, so the list view keeps its widget, and only new or changed rows are built.
+ * The visible list is then patched by merging the changed rows into it instead of being rebuilt. Game thread only.
+ */
+class BLUEPRINTPROFILER_API FProfilerRowStore
+{
+public:
+	using FItemPtr = TSharedPtr<FProfilerDataItem>;
+
+	/** 64-bit hash over row fields, used for row keys and content hashes */
+	class BLUEPRINTPROFILER_API FHashBuilder
+	{
+	public:
+		explicit FHashBuilder(EProfilerDataType Type);
+
+		FHashBuilder& Add(const FString& Value);
+		FHashBuilder& Add(const FGuid& Value);
+		FHashBuilder& Add(int32 Value) { return AddBytes(&Value, sizeof(Value)); }
+		FHashBuilder& Add(float Value) { return AddBytes(&Value, sizeof(Value)); }
+		uint64 Finish() const { return Builder.Finalize().Hash; }
+
+	private:
+		FHashBuilder& AddBytes(const void* Data, uint64 Size);
+
+		FXxHash64Builder Builder;
+	};
+
+	/** Text a row is searched by; called once per new or changed row, lowered by the store */
+	TFunction<FString(const FItemPtr&)> GetSearchText;
+
+	/**
+	 * Starts a diff update of all rows of one type. Rows of the type not passed to UpdateRow before EndUpdate are
+	 * removed, so a scan can stream its rows in batches and drop stale ones at the end. Restarts an open update.
+	 */
+	void BeginUpdate(EProfilerDataType Type);
+	void EndUpdate(EProfilerDataType Type);
+	bool IsUpdating(EProfilerDataType Type) const { return UpdateOpen[static_cast<int32>(Type)]; }
+
+	/**
+	 * Adds or refreshes a row. MakeItem is only called when the key is new or the content hash changed. Inside an
+	 * open update a key passed twice gets a second row; outside one the call patches a single row and removes nothing,
+	 * which is how live deltas are applied. Returns the row ID.
+	 */
+	int32 UpdateRow(EProfilerDataType Type, uint64 RowKey, uint64 ContentHash, TFunctionRef<FItemPtr()> MakeItem);
+
+	/** Same for an already built item; its display fields make up the content hash */
+	int32 UpdateRow(uint64 RowKey, const FItemPtr& Item);
+
+	void RemoveRows(EProfilerDataType Type);
+	void Empty();
+
+	int32 Num() const { return NumRows; }
+	int32 NumVisible() const { return VisibleRows.Num(); }
+	int32 FindRow(uint64 RowKey) const;
+	const FItemPtr& GetItem(int32 RowId) const { return Items[RowId]; }
+
+	/** Changes filter, sort or search text; a search that only narrows the previous one filters the visible rows */
+	void SetView(EProfilerRowFilter InFilter, EProfilerRowSort InSort, const FString& InSearchText);
+
+	/**
+	 * Applies pending row changes and view changes to the visible list.
+	 * @return true if OutVisibleItems was rewritten and the list view needs a refresh
+	 */
+	bool UpdateView(TArray<FItemPtr>& OutVisibleItems);
+
+	/** Matches the filter and every space separated search term */
+	bool IsRowVisible(int32 RowId) const;
+
+private:
+	// 类别标志：由类别文本在加入时计算一次
+	enum ERowFlags : uint8
+	{
+		RowFlag_Hotspot = 1 << 0,
+		RowFlag_DeadCode = 1 << 1,
+		RowFlag_Performance = 1 << 2
+	};
+
+	static constexpr int32 NumTypes = 3;
+
+	int32 AllocateRow(uint64 RowKey);
+	void SetRowItem(int32 RowId, EProfilerDataType Type, uint64 ContentHash, const FItemPtr& Item);
+	void FreeRow(int32 RowId);
+	bool MatchesFilter(int32 RowId) const;
+	bool MatchesSearch(int32 RowId) const;
+	bool IsOrderedBefore(int32 A, int32 B) const;
+	void RebuildVisibleRows();
+	void MergeChangedRows();
+
+	// 列：按行 ID 索引，空闲的 ID 会被复用
+	TArray<FItemPtr> Items;
+	TArray<uint64> RowKeys;
+	TArray<uint64> ContentHashes;
+	TArray<uint32> UpdateSerials;
+	TArray<EProfilerDataType> Types;
+	TArray<ESeverity> Severities;
+	TArray<float> Values;
+	TArray<uint8> Flags;
+	TArray<FString> NameKeys;
+	TArray<FString> BlueprintKeys;
+	TArray<FString> CategoryKeys;
+	TArray<FString> SearchTexts;
+	TBitArray<> LiveRows;
+	TArray<int32> FreeRows;
+	TMap<uint64, int32> KeyToRow;
+	int32 NumRows = 0;
+
+	uint32 TypeSerials[NumTypes] = {};
+	bool UpdateOpen[NumTypes] = {};
+
+	// View state
+	EProfilerRowFilter Filter = EProfilerRowFilter::All;
+	EProfilerRowSort Sort = EProfilerRowSort::Severity;
+	TArray<FString> SearchTerms;
+	TArray<int32> VisibleRows;
+	TArray<int32> ChangedRows;   // added or changed since the last UpdateView
+	TBitArray<> RemovedRows;     // visible rows whose item was removed or replaced
+	bool bRemovedAny = false;
+	bool bRebuildView = true;
+	bool bNarrowSearch = false;
+};
@@ -0,0 +1,159 @@
+// Copyright xnbmy 2026. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/ProfilerDataTypes.h"
+#include "Memory/MemoryView.h"
+#include "Tasks/Pipe.h"
+#include <atomic>
+
+class FArchive;
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * Binary session file (.bpsession) - versioned and chunked so it can be appended to while recording
+ *
+ * Layout: header (magic, version), then a sequence of chunks { uint32 Id, uint32 Size, payload }.
+ *   SESS - recording session info
+ *   STRS - string table referenced by NODE records
+ *   NODE - per-node stats block
+ *   FRAM - block of execution frames (written repeatedly while recording)
+ *   MEMS - Blueprint memory snapshots taken during the recording
+ *   END  - terminator, absent when the recording was interrupted
+ * Readers skip chunks they do not know, so later versions can add chunks without breaking old files.
+ */
+namespace BlueprintProfilerSessionFile
+{
+	constexpr uint32 Magic = 0x53505042; // "BPPS"
+	constexpr uint32 Version = 3;  // 2: frame records carry the engine frame number, 3: SESS carries the recorded frame count
+
+	constexpr uint32 ChunkSession = 0x53534553; // "SESS"
+	constexpr uint32 ChunkStrings = 0x53525453; // "STRS"
+	constexpr uint32 ChunkNodes = 0x45444F4E;   // "NODE"
+	constexpr uint32 ChunkFrames = 0x4D415246;  // "FRAM"
+	constexpr uint32 ChunkMemory = 0x534D454D;  // "MEMS"
+	constexpr uint32 ChunkEnd = 0x20444E45;     // "END "
+
+	// 每个帧块（页）的帧数；录制时除最后一页外都是满页，帧序号可直接换算页号
+	constexpr int32 FramesPerBlock = 4096;
+
+	inline const TCHAR* GetExtension() { return TEXT(".bpsession"); }
+	BLUEPRINTPROFILER_API bool IsSessionFile(const FString& FilePath);
+}
+
+/**
+ * Session file writer - header on Open, frame pages while recording, session + node stats on Close
+ * All file I/O runs in order on a background pipe, so the recording thread only hands over buffers.
+ * Frame pages already on disk can be read back while the file is still being written.
+ */
+class BLUEPRINTPROFILER_API FProfilerSessionWriter
+{
+public:
+	FProfilerSessionWriter();
+	~FProfilerSessionWriter();
+
+	bool Open(const FString& InFilePath);
+	bool IsOpen() const { return FileWriter.IsValid(); }
+	const FString& GetFilePath() const { return FilePath; }
+
+	/** Queues one frame page (at most FramesPerBlock frames) as an FRAM chunk; NodeId refers to NODE records */
+	void WriteFramePage(TArray<FExecutionFrame>&& Frames);
+
+	/** Copies frames into pages and queues them */
+	void WriteFrames(TConstArrayView<FExecutionFrame> Frames);
+
+	/** Queues STRS + NODE + SESS. NodeIds[i] is the ID frames use for Nodes[i] */
+	void WriteSummary(const FRecordingSession& Session, TConstArrayView<FNodeExecutionData> Nodes, TConstArrayView<uint32> NodeIds);
+
+	/** Queues MEMS with the recording's Blueprint memory snapshots */
+	void WriteMemorySnapshots(TConstArrayView<FBlueprintMemorySnapshot> Snapshots);
+
+	/** Writes the END chunk, waits for queued writes and closes the file */
+	bool Close();
+
+	int64 GetFramesWritten() const { return FramesWritten; }
+	int32 GetNumFramePages() const { return FramePageOffsets.Num(); }
+
+	/** Reads a queued page back from disk, waiting for the background write if it is still in flight */
+	bool ReadFramePage(int32 PageIndex, TArray<FExecutionFrame>& OutFrames);
+
+private:
+	void QueueChunk(uint32 ChunkId, TArray<uint8>&& Payload);
+	void WriteChunk(uint32 ChunkId, const TArray<uint8>& Payload);
+	void WaitForPages(int32 NumPages);
+
+	TUniquePtr<FArchive> FileWriter;
+	TUniquePtr<FArchive> PageReader;
+	FString FilePath;
+	UE::Tasks::FPipe WritePipe;
+
+	// Game thread bookkeeping; chunk offsets are known up front because frame records have a fixed size
+	int64 NextChunkOffset = 0;
+	int64 FramesWritten = 0;
+	TArray<int64> FramePageOffsets;
+	TArray<int32> FramePageCounts;
+
+	// Written by the pipe
+	std::atomic<int32> PagesOnDisk{0};
+	std::atomic<bool> bWriteError{false};
+};
+
+/**
+ * Session file reader - memory maps the file and decodes chunks in place.
+ * Frame blocks are only indexed on Open and decoded on demand through ReadFrameBlock.
+ */
+class BLUEPRINTPROFILER_API FProfilerSessionReader
+{
+public:
+	FProfilerSessionReader();
+	~FProfilerSessionReader();
+
+	bool Open(const FString& FilePath);
+	void Close();
+
+	const FRecordingSession& GetSession() const { return Session; }
+	const TArray<FNodeExecutionData>& GetNodes() const { return Nodes; }
+	const TArray<uint32>& GetNodeIds() const { return NodeIds; }
+	const TArray<FBlueprintMemorySnapshot>& GetMemorySnapshots() const { return MemorySnapshots; }
+	bool IsComplete() const { return bComplete; }
+
+	int32 GetNumFrameBlocks() const { return FrameBlocks.Num(); }
+	int64 GetNumFrames() const { return TotalFrames; }
+	bool ReadFrameBlock(int32 BlockIndex, TArray<FExecutionFrame>& OutFrames) const;
+
+	/** Index of the block holding frame FrameIndex of the session, INDEX_NONE when out of range */
+	int32 FindFrameBlock(int64 FrameIndex) const;
+	int64 GetFrameBlockStart(int32 BlockIndex) const { return FrameBlockStarts[BlockIndex]; }
+
+private:
+	struct FChunkRef
+	{
+		int64 Offset = 0;
+		uint32 Size = 0;
+	};
+
+	FMemoryView GetChunkView(const FChunkRef& Chunk) const;
+	bool ParseSession(const FChunkRef& Chunk);
+	bool ParseStrings(const FChunkRef& Chunk);
+	bool ParseNodes(const FChunkRef& Chunk);
+	bool ParseMemory(const FChunkRef& Chunk);
+
+	// 映射失败时（例如平台不支持）退回到整文件读取
+	TUniquePtr<IMappedFileHandle> MappedHandle;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+	TArray<uint8> FallbackBuffer;
+	FMemoryView FileView;
+
+	FRecordingSession Session;
+	TArray<FString> Strings;
+	TArray<FNodeExecutionData> Nodes;
+	TArray<uint32> NodeIds;
+	TArray<FBlueprintMemorySnapshot> MemorySnapshots;
+	TArray<FChunkRef> FrameBlocks;
+	TArray<int64> FrameBlockStarts;  // session frame index of each block's first frame
+	int64 TotalFrames = 0;
+	uint32 FileVersion = 0;
+	bool bComplete = false;
+};
@@ -8,10 +8,14 @@
 #include "Widgets/Input/SComboBox.h"
 #include "Widgets/Input/SSearchBox.h"
 #include "Data/ProfilerDataTypes.h"
+#include "Data/ProfilerRowStore.h"
+#include "Data/ProfilerDataExporter.h"
 
 class SButton;
 class STextBlock;
 class SProgressBar;
+class SExpandableArea;
+struct FScanProgress;
 
 /**
  * Main Blueprint Profiler Dashboard Widget
@@ -51,8 +55,15 @@ private:
 	FReply OnStartMemoryAnalysis();
 	void OnReferenceCountProgress(float Progress);
 	void OnReferenceCountAnalysisComplete(const FMemoryAnalysisResult& Result);
+	FReply OnStartMemoryAudit();
+	void OnMemoryAuditComplete(const TArray<FBlueprintMemoryAuditEntry>& RankedEntries);
 	FReply OnExportToCSV();
 	FReply OnExportToJSON();
+	FReply OnCancelExport();
+	void StartExport(EProfilerExportFormat Format);
+	TSharedRef<const FProfilerExportSnapshot, ESPMode::ThreadSafe> BuildExportSnapshot() const;
+	void OnExportProgress(float Progress);
+	void OnExportComplete(bool bSuccess, bool bCancelled, int32 NumRows, const FString& FilePath);
 	FReply OnRefreshData();
 
 	// List view handlers
@@ -61,6 +72,14 @@ private:
 	void OnSelectionChanged(TSharedPtr<FProfilerDataItem> Item, ESelectInfo::Type SelectInfo);
 	TSharedPtr<SWidget> OnContextMenuOpening();
 	
+	// Hitch list handlers
+	TSharedRef<ITableRow> OnGenerateHitchRow(TSharedPtr<FBlueprintFrameBreakdown> Item, const TSharedRef<STableViewBase>& OwnerTable);
+	void OnHitchDoubleClicked(TSharedPtr<FBlueprintFrameBreakdown> Item);
+	void OnBlueprintHitch(const FBlueprintFrameBreakdown& Hitch);
+	void OnRuntimeLiveUpdate(const TSharedRef<const FRuntimeLiveUpdate, ESPMode::ThreadSafe>& Update);
+	void RefreshHitchList();
+	FText GetHitchListHeaderText() const;
+
 	// Navigation handlers
 	void NavigateToBlueprint(TSharedPtr<FProfilerDataItem> Item);
 	void NavigateToNode(TSharedPtr<FProfilerDataItem> Item);
@@ -78,9 +97,11 @@ private:
 	void FilterData(const FString& FilterBy);
 	void ClearFilters();
 	void ApplyQuickFilter(const FString& FilterType);
-	bool MatchesSearchCriteria(TSharedPtr<FProfilerDataItem> Item, const FString& SearchText) const;
+	FString BuildSearchText(TSharedPtr<FProfilerDataItem> Item) const;
 	TSharedPtr<FProfilerDataItem> CreateDataItemFromRuntimeData(const FNodeExecutionData& Data);
 	TSharedPtr<FProfilerDataItem> CreateDataItemFromLintIssue(const FLintIssue& Issue);
+	void UpdateRuntimeRow(const FNodeExecutionData& Data);  // 需在 RowStore 的运行时更新中调用
+	void UpdateLintRow(const FLintIssue& Issue);            // 需在 RowStore 的检查更新中调用
 	TSharedPtr<FProfilerDataItem> CreateDataItemFromMemoryData(const FMemoryAnalysisResult& Data, UBlueprint* Blueprint);
 
 	// Utility methods
@@ -98,6 +119,7 @@ private:
 private:
 	// UI Components
 	TSharedPtr<SListView<TSharedPtr<FProfilerDataItem>>> DataListView;
+	TSharedPtr<SListView<TSharedPtr<FBlueprintFrameBreakdown>>> HitchListView;
 	TSharedPtr<SSearchBox> SearchBox;
 	TSharedPtr<SComboBox<TSharedPtr<FString>>> SortComboBox;
 	TSharedPtr<SComboBox<TSharedPtr<FString>>> FilterComboBox;
@@ -130,10 +152,13 @@ private:
 	TSharedPtr<STextBlock> ProgressDetailsText;
 	TSharedPtr<STextBlock> TimeRemainingText;
 	TSharedPtr<SProgressBar> ProgressBar;
+	TSharedPtr<SExpandableArea> ScanCostArea;  // Shown once a scan completes
+	TSharedPtr<STextBlock> ScanCostText;
 
 	// Data management
-	TArray<TSharedPtr<FProfilerDataItem>> AllDataItems;
-	TArray<TSharedPtr<FProfilerDataItem>> FilteredDataItems;
+	FProfilerRowStore RowStore;
+	TArray<TSharedPtr<FProfilerDataItem>> FilteredDataItems;  // 列表视图的数据源，由 RowStore 增量维护
+	TArray<TSharedPtr<FBlueprintFrameBreakdown>> HitchItems;  // 最新的卡顿在前
 	
 	// Filter options
 	TArray<TSharedPtr<FString>> SortOptions;
@@ -146,6 +171,10 @@ private:
 	ERecordingState CurrentRecordingState;
 	bool bIsStaticScanning;
 	bool bIsMemoryAnalyzing;
+	bool bLintIssuesStreamed;   // The running scan streams its rows into an open lint update of RowStore
+	bool bLintListDirty;        // Rows were added since the last TickUIRefresh
+	int32 NumStreamedLintIssues;
+	uint64 LastLiveUpdateSerial;  // Serial of the last live update applied to the runtime rows
 
 	// Button state methods
 	bool CanStartRecording() const;
@@ -159,6 +188,8 @@ private:
 	bool CanCancelScan() const;
 	bool CanStartMemoryAnalysis() const;
 	bool HasDataToExport() const;
+	bool CanStartExport() const;
+	bool IsExporting() const;
 
 	// Recording state helpers
 	FText GetRecordingStateText() const;
@@ -168,6 +199,7 @@ private:
 
 	// Event callbacks for analyzers
 	void OnStaticScanComplete(const TArray<FLintIssue>& Issues);
+	void OnStaticIssuesBatch(TConstArrayView<FLintIssue> Issues);
 	void OnStaticScanProgress(int32 ProcessedAssets, int32 TotalAssets);
 
 	// PIE event callbacks
@@ -177,11 +209,13 @@ private:
 	void UpdateProgressDisplay();
 	FText GetProgressText() const;
 	FText GetTimeRemainingText() const;
+	FText GetScanCostText(const FScanProgress& Progress) const;
 
 	// Analyzer references
 	TSharedPtr<class FRuntimeProfiler> RuntimeProfiler;
 	TSharedPtr<class FStaticLinter> StaticLinter;
 	TSharedPtr<class FMemoryAnalyzer> MemoryAnalyzer;
+	TSharedPtr<FProfilerDataExporter> DataExporter;
 
 	// UI refresh ticker
 	FTSTicker::FDelegateHandle UIRefreshTickerHandle;